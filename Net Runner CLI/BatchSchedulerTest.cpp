@@ -0,0 +1,383 @@
+//
+//  BatchSchedulerTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks the micro-batching scheduler with synthetic runners and load generators: full batches,
+// flushes at the shared and per-request deadlines, queueing behind a busy runner with a batch
+// size of one and its late requests, draining on stop, and that the batch size, queue depth and
+// queue latency histograms account for every request under concurrent load.
+//
+// usage: net-runner-batch-scheduler-test
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BatchScheduler.h"
+
+using namespace netrunner;
+
+namespace {
+
+using Scheduler = BatchScheduler<int, int>;
+using Clock = Scheduler::Clock;
+
+// Long enough that a batch waiting for it fails the check rather than the test timing out
+
+const auto kLongDelay = std::chrono::seconds(10);
+const auto kTimeout = std::chrono::seconds(2);
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+double Milliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Collects completions, in the order the worker delivers them, and checks each result
+
+class Completions {
+public:
+    Scheduler::Completion completion(int request) {
+        return [this, request](const int &result) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _correct = _correct && result == request * request;
+            _order.push_back(request);
+            _condition.notify_all();
+        };
+    }
+
+    bool wait(size_t count) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _condition.wait_for(lock, kTimeout, [&] { return _order.size() >= count; });
+    }
+
+    bool correct() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _correct;
+    }
+
+    std::vector<int> order() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _order;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<int> _order;
+    bool _correct = true;
+};
+
+// A runner that squares its requests, and holds the first batch until it is released
+
+class GatedRunner {
+public:
+    std::vector<int> operator()(const std::vector<int> &batch) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _entered = true;
+            _condition.notify_all();
+            _condition.wait(lock, [this] { return _released; });
+        }
+
+        std::vector<int> results;
+        for ( int request : batch ) {
+            results.push_back(request * request);
+        }
+        return results;
+    }
+
+    bool waitUntilEntered() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _condition.wait_for(lock, kTimeout, [this] { return _entered; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _released = true;
+        _condition.notify_all();
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _entered = false;
+    bool _released = false;
+};
+
+std::vector<int> Square(const std::vector<int> &batch) {
+    std::vector<int> results;
+    for ( int request : batch ) {
+        results.push_back(request * request);
+    }
+    return results;
+}
+
+Scheduler::Options Options(size_t maxBatchSize, Clock::duration maxDelay) {
+    Scheduler::Options options;
+    options.maxBatchSize = maxBatchSize;
+    options.maxDelay = maxDelay;
+    return options;
+}
+
+bool InOrder(const std::vector<int> &order) {
+    for ( size_t i = 0; i < order.size(); i++ ) {
+        if ( order[i] != static_cast<int>(i) ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Eight requests make two full batches of four long before the delay
+
+bool CheckFullBatches() {
+    Completions completions;
+    Scheduler scheduler(Options(4, kLongDelay), Square);
+
+    for ( int i = 0; i < 8; i++ ) {
+        scheduler.submit(i, completions.completion(i));
+    }
+
+    if ( !completions.wait(8) ) {
+        return Fail("Full batches were not run before the delay");
+    }
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+
+    if ( !completions.correct() || !InOrder(completions.order()) ) {
+        return Fail("Full batches returned the wrong results or out of order");
+    }
+    if ( statistics.batches != 2 || statistics.fullBatches != 2 || statistics.batchSizes[4] != 2 || statistics.deadlineBatches != 0 ) {
+        return Fail("Expected two full batches of four, found " + std::to_string(statistics.batches) + " batches, " + std::to_string(statistics.fullBatches) + " full");
+    }
+
+    return true;
+}
+
+// A partial batch waits for the delay and is then flushed, and a request with a tighter deadline
+// flushes the requests queued ahead of it at its own deadline
+
+bool CheckDeadlineFlush() {
+    {
+        Completions completions;
+        Scheduler scheduler(Options(8, std::chrono::milliseconds(40)), Square);
+        Clock::time_point start = Clock::now();
+
+        for ( int i = 0; i < 3; i++ ) {
+            scheduler.submit(i, completions.completion(i));
+        }
+
+        if ( !completions.wait(3) ) {
+            return Fail("A partial batch was not flushed at its delay");
+        }
+
+        double elapsed = Milliseconds(Clock::now() - start);
+        Scheduler::Statistics statistics = scheduler.statistics();
+
+        if ( elapsed < 39 || statistics.deadlineBatches != 1 || statistics.batchSizes[3] != 1 ) {
+            return Fail("Expected one batch of three flushed after 40ms, flushed after " + std::to_string(elapsed) + "ms");
+        }
+        if ( statistics.queueLatency.count != 3 || statistics.queueLatency.max < 39 ) {
+            return Fail("Queue latencies do not include the 40ms delay, max " + std::to_string(statistics.queueLatency.max) + "ms");
+        }
+    }
+
+    Completions completions;
+    Scheduler scheduler(Options(8, kLongDelay), Square);
+
+    scheduler.submit(0, completions.completion(0));
+    scheduler.submit(1, completions.completion(1), Clock::now() + std::chrono::milliseconds(20));
+
+    if ( !completions.wait(2) ) {
+        return Fail("A request's deadline did not flush its batch");
+    }
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+
+    if ( !InOrder(completions.order()) || statistics.deadlineBatches != 1 || statistics.batchSizes[2] != 1 ) {
+        return Fail("Expected the earlier request to be flushed with the one whose deadline was reached");
+    }
+
+    return true;
+}
+
+// With a batch size of one nothing is coalesced, but requests queue behind a busy runner, run in
+// order as soon as it returns, and are late if their deadlines passed while they waited
+
+bool CheckBatchSizeOfOne() {
+    Completions completions;
+    GatedRunner runner;
+    Scheduler scheduler(Options(1, kLongDelay), std::ref(runner));
+
+    scheduler.submit(0, completions.completion(0));
+
+    if ( !runner.waitUntilEntered() ) {
+        return Fail("The first request was not run");
+    }
+
+    for ( int i = 1; i < 5; i++ ) {
+        scheduler.submit(i, completions.completion(i), Clock::now() + std::chrono::milliseconds(10));
+    }
+
+    if ( scheduler.queueDepth() != 4 ) {
+        return Fail("Expected four requests queued behind the runner, found " + std::to_string(scheduler.queueDepth()));
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    runner.release();
+
+    if ( !completions.wait(5) ) {
+        return Fail("Queued requests were not run when the runner returned");
+    }
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+
+    if ( !completions.correct() || !InOrder(completions.order()) ) {
+        return Fail("Queued requests returned the wrong results or out of order");
+    }
+    if ( statistics.batches != 5 || statistics.fullBatches != 5 || statistics.batchSizes[1] != 5 ) {
+        return Fail("Expected five batches of one");
+    }
+    if ( statistics.maxQueueDepth != 4 || statistics.queueDepths[1] != 2 || statistics.queueDepths[2] != 1
+        || statistics.queueDepths[3] != 1 || statistics.queueDepths[4] != 1 ) {
+        return Fail("Queue depths do not match four requests queued behind the first");
+    }
+    if ( statistics.lateRequests != 4 ) {
+        return Fail("Expected four late requests, found " + std::to_string(statistics.lateRequests));
+    }
+    if ( statistics.queueLatency.count != 5 || statistics.queueLatency.max < 29 ) {
+        return Fail("Queue latencies do not include the wait behind the runner");
+    }
+
+    return true;
+}
+
+// Stopping runs what is queued rather than waiting for the delay
+
+bool CheckStopDrains() {
+    Completions completions;
+    Scheduler scheduler(Options(8, kLongDelay), Square);
+    Clock::time_point start = Clock::now();
+
+    for ( int i = 0; i < 3; i++ ) {
+        scheduler.submit(i, completions.completion(i));
+    }
+
+    scheduler.stop();
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+
+    if ( completions.order().size() != 3 || Clock::now() - start > kTimeout ) {
+        return Fail("Stopping did not run the queued requests");
+    }
+    if ( statistics.batches != 1 || statistics.drainedBatches != 1 ) {
+        return Fail("Expected one drained batch");
+    }
+
+    return true;
+}
+
+// Producers submit at random intervals to a runner with a fixed cost per batch and a smaller
+// cost per request. Every request completes with its own result, and the histograms account for
+// every batch and request.
+
+bool CheckSyntheticLoad() {
+    const int kProducers = 4;
+    const int kRequests = 500;
+
+    Completions completions;
+    Scheduler scheduler(Options(8, std::chrono::milliseconds(2)), [](const std::vector<int> &batch) {
+        std::this_thread::sleep_for(std::chrono::microseconds(200 + 20 * batch.size()));
+        return Square(batch);
+    });
+
+    std::vector<std::thread> producers;
+
+    for ( int p = 0; p < kProducers; p++ ) {
+        producers.emplace_back([&, p] {
+            std::mt19937 generator(p);
+            std::uniform_int_distribution<int> pause(0, 200);
+
+            for ( int i = 0; i < kRequests; i++ ) {
+                int request = p * kRequests + i;
+                scheduler.submit(request, completions.completion(request));
+                std::this_thread::sleep_for(std::chrono::microseconds(pause(generator)));
+            }
+        });
+    }
+
+    for ( std::thread &producer : producers ) {
+        producer.join();
+    }
+
+    scheduler.stop();
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+    uint64_t batched = 0, depths = 0;
+
+    for ( size_t n = 0; n < statistics.batchSizes.size(); n++ ) {
+        batched += n * statistics.batchSizes[n];
+    }
+    for ( uint64_t count : statistics.queueDepths ) {
+        depths += count;
+    }
+
+    if ( completions.order().size() != kProducers * kRequests || !completions.correct() ) {
+        return Fail("Not every request under load completed with its own result");
+    }
+    if ( statistics.requests != kProducers * kRequests || batched != statistics.requests || depths != statistics.batches
+        || statistics.queueLatency.count != statistics.requests || statistics.batchSizes[0] != 0 ) {
+        return Fail("Histograms do not account for every request and batch under load");
+    }
+    if ( statistics.fullBatches + statistics.deadlineBatches + statistics.drainedBatches != statistics.batches ) {
+        return Fail("Batches are not each counted once as full, flushed or drained");
+    }
+    if ( statistics.averageBatchSize() <= 1 ) {
+        return Fail("Requests under load were not coalesced, average batch size " + std::to_string(statistics.averageBatchSize()));
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool passed = CheckFullBatches()
+        && CheckDeadlineFlush()
+        && CheckBatchSizeOfOne()
+        && CheckStopDrains()
+        && CheckSyntheticLoad();
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Batch scheduler checks out" << std::endl;
+    return EXIT_SUCCESS;
+}
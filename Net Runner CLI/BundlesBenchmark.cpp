@@ -0,0 +1,565 @@
+//
+//  BundlesBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the bundle manifest and times model bundle discovery over a directory of synthetic
+// bundles, each with a 1000 line labels file and every tenth with 20000 lines. Compares a serial
+// load of every bundle, as `TIOModelBundleManager` performs, with a parallel scan without a
+// manifest, as on first launch, a scan with an up to date manifest, as on every other launch,
+// and a scan after one bundle has changed. Also compares identifier lookups by linear search
+// against the hash index.
+//
+// Compares the time and heap memory to list the bundles by loading every bundle, labels included,
+// against listing their headers from the manifest, and resolving labels by index from loaded
+// vocabularies against memory mapped label tables. Heap use is measured with the allocator's own
+// statistics, which unlike the resident set are not masked by memory freed earlier in the run.
+//
+// usage: net-runner-bundles-benchmark [bundles] [workers]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "BundleManifest.h"
+#include "LabelTable.h"
+#include "ModelBundle.h"
+
+using namespace netrunner::bundles;
+using netrunner::cli::ModelBundle;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double Megabytes(int64_t bytes) {
+    return static_cast<double>(bytes) / (1024 * 1024);
+}
+
+/**
+ * Bytes allocated and not yet freed, or -1 if the allocator does not report them.
+ */
+
+int64_t HeapInUse() {
+#if defined(__APPLE__)
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(nullptr, &statistics);
+    return static_cast<int64_t>(statistics.size_in_use);
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<int64_t>(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+std::string BundleName(size_t index) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "model-%03zu.tiobundle", index);
+    return name;
+}
+
+std::string Identifier(size_t index) {
+    return "synthetic-model-" + std::to_string(index);
+}
+
+void WriteModelJSON(const std::string &path, size_t index, const std::string &version) {
+    std::ofstream(path + "/model.json")
+        << "{\n"
+        << "  \"name\": \"Synthetic Model " << index << "\",\n"
+        << "  \"details\": \"A synthetic image classification model\",\n"
+        << "  \"id\": \"" << Identifier(index) << "\",\n"
+        << "  \"version\": \"" << version << "\",\n"
+        << "  \"author\": \"doc.ai\",\n"
+        << "  \"license\": \"Apache License. Version 2.0\",\n"
+        << "  \"model\": {\"file\": \"model.tflite\", \"quantized\": false, \"type\": \"image.classification\", \"backend\": \"tflite\"},\n"
+        << "  \"inputs\": [{\"name\": \"image\", \"type\": \"image\", \"shape\": [224,224,3], \"format\": \"RGB\", \"normalize\": {\"standard\": \"[-1,1]\"}}],\n"
+        << "  \"outputs\": [{\"name\": \"classification\", \"type\": \"array\", \"shape\": [1,1000], \"labels\": \"labels.txt\"}]\n"
+        << "}\n";
+}
+
+void WriteBundle(const std::string &directory, size_t index) {
+    std::string path = directory + "/" + BundleName(index);
+    ::mkdir(path.c_str(), 0755);
+    ::mkdir((path + "/assets").c_str(), 0755);
+
+    WriteModelJSON(path, index, "1");
+
+    std::ofstream labels(path + "/assets/labels.txt");
+    size_t lines = index % 10 == 0 ? 20000 : 1000;
+
+    for ( size_t i = 0; i < lines; i++ ) {
+        labels << "label " << i << " of synthetic model " << index << "\n";
+    }
+}
+
+void RemoveBundle(const std::string &directory, const std::string &name) {
+    std::string path = directory + "/" + name;
+    std::remove((path + "/assets/labels.txt").c_str());
+    ::rmdir((path + "/assets").c_str());
+    std::remove((path + "/model.json").c_str());
+    ::rmdir(path.c_str());
+}
+
+/**
+ * Parses a bundle the way the app does, reading its model.json and every labels file, and fills
+ * in the record's header.
+ */
+
+bool ParseModelBundle(const std::string &path, BundleRecord *record) {
+    std::string error;
+    std::shared_ptr<ModelBundle> bundle = ModelBundle::Load(path, &error);
+
+    if ( bundle == nullptr ) {
+        return false;
+    }
+
+    record->identifier = bundle->identifier();
+    record->name = bundle->name();
+    record->version = bundle->version();
+    record->backend = bundle->backend();
+    record->quantized = bundle->isQuantized();
+
+    for ( const auto &input : bundle->inputs() ) {
+        std::string shape;
+        for ( int dimension : input.shape ) {
+            shape += (shape.empty() ? "" : "x") + std::to_string(dimension);
+        }
+        record->inputs += (record->inputs.empty() ? "" : ", ") + input.type + " " + shape;
+    }
+
+    for ( const Json::Value &output : bundle->info()["outputs"] ) {
+        if ( output.isMember("labels") ) {
+            record->labels.emplace_back(output["name"].asString(), output["labels"].asString());
+        }
+    }
+
+    return true;
+}
+
+std::string LabelsPath(const std::string &directory, const BundleRecord &record) {
+    return directory + "/" + record.path + "/assets/" + record.labels[0].second;
+}
+
+bool CheckLabelTable(const std::string &directory) {
+    std::string path = directory + "/check-labels.txt";
+    std::string error;
+
+    // Lines are split at newlines as TensorIO splits them with componentsSeparatedByString:, so
+    // carriage returns and empty lines are kept, including one after the trailing newline
+
+    std::ofstream(path) << "cat\r\ndog\n\nbird\n\n";
+    std::shared_ptr<LabelTable> table = LabelTable::Open(path, &error);
+
+    if ( table == nullptr ) {
+        return Fail(error);
+    }
+
+    std::vector<std::string> labels;
+    for ( size_t i = 0; i < table->size(); i++ ) {
+        labels.push_back(table->at(i).str());
+    }
+
+    if ( labels != std::vector<std::string>({"cat\r", "dog", "", "bird", "", ""}) ) {
+        return Fail("Label table lines do not match the file");
+    }
+
+    if ( table->indexOf("bird") != 3 || table->indexOf("cat\r") != 0 || table->indexOf("cat") != -1 || table->indexOf("") != 2 ) {
+        return Fail("Label table reverse lookups are wrong");
+    }
+
+    // A last line without a newline is a label, and an empty file has one empty label
+
+    std::ofstream(path) << "only";
+    table = LabelTable::Open(path, &error);
+
+    if ( table == nullptr || table->size() != 1 || table->at(0).str() != "only" ) {
+        return Fail("A final label without a newline was not read");
+    }
+
+    std::ofstream(path, std::ios::trunc).close();
+    table = LabelTable::Open(path, &error);
+
+    if ( table == nullptr || table->size() != 1 || table->at(0).length != 0 ) {
+        return Fail("An empty labels file should have one empty label");
+    }
+
+    std::remove(path.c_str());
+
+    if ( LabelTable::Open(path, &error) != nullptr ) {
+        return Fail("A missing labels file was opened");
+    }
+
+    return true;
+}
+
+bool Scan(const std::string &directory, const BundleManifest &manifest, size_t workers, ScanResult *result) {
+    std::string error;
+    if ( !ScanBundles(directory, manifest, workers, ParseModelBundle, result, &error) ) {
+        return Fail("Unable to scan bundles: " + error);
+    }
+    return true;
+}
+
+bool CheckManifest(const std::string &directory) {
+    std::string modelsDirectory = directory + "/check-models";
+    std::string manifestPath = directory + "/check.manifest";
+    ::mkdir(modelsDirectory.c_str(), 0755);
+
+    for ( size_t i = 0; i < 4; i++ ) {
+        WriteBundle(modelsDirectory, i);
+    }
+
+    // An invalid bundle is recorded and not parsed again until it changes
+
+    std::string invalid = modelsDirectory + "/invalid.tiobundle";
+    ::mkdir(invalid.c_str(), 0755);
+    std::ofstream(invalid + "/model.json") << "{ not json";
+
+    ScanResult cold;
+
+    if ( !Scan(modelsDirectory, BundleManifest(), 2, &cold) ) {
+        return false;
+    }
+
+    if ( cold.records.size() != 5 || cold.parsed != 5 || cold.reused != 0 ) {
+        return Fail("Expected five parsed bundles without a manifest");
+    }
+
+    size_t valid = std::count_if(cold.records.begin(), cold.records.end(), [](const BundleRecord &record) { return record.valid; });
+
+    if ( valid != 4 || cold.records[4].path != "model-003.tiobundle" || cold.records[4].identifier != Identifier(3) ) {
+        return Fail("Bundle records do not match the bundles");
+    }
+
+    const BundleRecord &header = cold.records[4];
+
+    if ( header.version != "1" || header.backend != "tflite" || header.quantized || header.inputs != "image 224x224x3"
+        || header.labels != std::vector<std::pair<std::string, std::string>>({{"classification", "labels.txt"}}) ) {
+        return Fail("Bundle headers do not match the bundles");
+    }
+
+    BundleManifest manifest;
+    manifest.assign(cold.records);
+    std::string error;
+
+    if ( !manifest.save(manifestPath, &error) ) {
+        return Fail(error);
+    }
+
+    BundleManifest loaded = BundleManifest::Load(manifestPath);
+
+    if ( !(loaded == manifest) || loaded.find("invalid.tiobundle") == nullptr || loaded.find("invalid.tiobundle")->valid ) {
+        return Fail("The manifest did not round trip");
+    }
+
+    ScanResult warm;
+
+    if ( !Scan(modelsDirectory, loaded, 2, &warm) || warm.parsed != 0 || warm.reused != 5 ) {
+        return Fail("Expected every bundle to be reused with an up to date manifest");
+    }
+
+    // A changed bundle is parsed again, a removed one is dropped
+
+    WriteModelJSON(modelsDirectory + "/" + BundleName(1), 1, "1.0.1");
+    RemoveBundle(modelsDirectory, BundleName(2));
+
+    ScanResult changed;
+
+    if ( !Scan(modelsDirectory, loaded, 2, &changed) || changed.parsed != 1 || changed.reused != 3 || changed.records.size() != 4 ) {
+        return Fail("Expected only the changed bundle to be parsed");
+    }
+
+    // So is a bundle whose labels were replaced, though its model.json is unchanged
+
+    BundleManifest current;
+    current.assign(changed.records);
+    std::ofstream(modelsDirectory + "/" + BundleName(3) + "/assets/labels.txt") << "replaced\n";
+
+    ScanResult relabeled;
+
+    if ( !Scan(modelsDirectory, current, 2, &relabeled) || relabeled.parsed != 1 || relabeled.parsedRecords != std::vector<size_t>({3}) ) {
+        return Fail("Expected only the bundle with replaced labels to be parsed");
+    }
+
+    // Fields with separators are escaped, outdated or corrupt manifests load as empty
+
+    BundleRecord record;
+    record.path = "odd\tname\\.tiobundle";
+    record.name = "line\nbreak";
+    record.valid = true;
+    record.labels = {{"tab\tbed", "new\nline.txt"}, {"scores", "labels.txt"}};
+    manifest.assign({record});
+
+    if ( !manifest.save(manifestPath, &error) || !(BundleManifest::Load(manifestPath) == manifest) ) {
+        return Fail("Escaped manifest fields did not round trip");
+    }
+
+    std::ofstream(manifestPath) << "net-runner-bundle-manifest\t0\nmodel.tiobundle\t1\t1\t1\tid\tname\n";
+
+    if ( !BundleManifest::Load(manifestPath).records().empty() ) {
+        return Fail("An outdated manifest was loaded");
+    }
+
+    std::ofstream(manifestPath) << "net-runner-bundle-manifest\t" << BundleManifest::kVersion << "\nmodel.tiobundle\tx\t1\n";
+
+    if ( !BundleManifest::Load(manifestPath).records().empty() ) {
+        return Fail("A corrupt manifest was loaded");
+    }
+
+    for ( size_t i = 0; i < 4; i++ ) {
+        RemoveBundle(modelsDirectory, BundleName(i));
+    }
+    std::remove((invalid + "/model.json").c_str());
+    ::rmdir(invalid.c_str());
+    ::rmdir(modelsDirectory.c_str());
+    std::remove(manifestPath.c_str());
+
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long bundleCount = argc > 1 ? std::atol(argv[1]) : 100;
+    const long workerCount = argc > 2 ? std::atol(argv[2]) : std::max(2u, std::thread::hardware_concurrency());
+
+    if ( bundleCount <= 0 || workerCount <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [bundles] [workers]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string directory = std::string(P_tmpdir) + "/net-runner-bundles-benchmark";
+    std::string modelsDirectory = directory + "/models";
+    std::string manifestPath = directory + "/model-bundles.manifest";
+    ::mkdir(directory.c_str(), 0755);
+    ::mkdir(modelsDirectory.c_str(), 0755);
+
+    if ( !CheckManifest(directory) || !CheckLabelTable(directory) ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Manifest and label tables check out" << std::endl;
+
+    size_t bundles = static_cast<size_t>(bundleCount);
+    size_t workers = static_cast<size_t>(workerCount);
+
+    for ( size_t i = 0; i < bundles; i++ ) {
+        WriteBundle(modelsDirectory, i);
+    }
+
+    // Serial, every bundle parsed
+
+    std::string error;
+    int64_t heap = HeapInUse();
+    Clock::time_point start = Clock::now();
+    std::vector<std::shared_ptr<ModelBundle>> serial = ModelBundle::LoadAll(modelsDirectory, &error);
+    double serialMilliseconds = Milliseconds(start);
+    int64_t serialBytes = HeapInUse() - heap;
+
+    // First launch, no manifest
+
+    ScanResult cold;
+    start = Clock::now();
+
+    if ( !Scan(modelsDirectory, BundleManifest::Load(manifestPath), workers, &cold) ) {
+        return EXIT_FAILURE;
+    }
+
+    BundleManifest manifest;
+    manifest.assign(cold.records);
+
+    if ( !manifest.save(manifestPath, &error) ) {
+        std::cerr << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    double coldMilliseconds = Milliseconds(start);
+
+    // Every later launch, the manifest is up to date
+
+    ScanResult warm;
+    heap = HeapInUse();
+    start = Clock::now();
+
+    if ( !Scan(modelsDirectory, BundleManifest::Load(manifestPath), workers, &warm) ) {
+        return EXIT_FAILURE;
+    }
+
+    double warmMilliseconds = Milliseconds(start);
+    int64_t warmBytes = HeapInUse() - heap;
+
+    // A launch after one bundle was updated
+
+    WriteModelJSON(modelsDirectory + "/" + BundleName(bundles / 2), bundles / 2, "2.0");
+
+    ScanResult changed;
+    start = Clock::now();
+
+    if ( !Scan(modelsDirectory, BundleManifest::Load(manifestPath), workers, &changed) ) {
+        return EXIT_FAILURE;
+    }
+
+    double changedMilliseconds = Milliseconds(start);
+
+    if ( serial.size() != bundles || cold.parsed != bundles || warm.parsed != 0 || changed.parsed != 1 ) {
+        std::cerr << "Expected " << bundles << " bundles parsed serially and on the first scan, none on the second and one after a change" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    for ( size_t i = 0; i < bundles; i++ ) {
+        if ( !warm.records[i].valid || warm.records[i].identifier != serial[i]->identifier() || warm.records[i].name != serial[i]->name()
+            || warm.records[i].version != serial[i]->version() || warm.records[i].labels.size() != 1 ) {
+            std::cerr << "Manifest record " << i << " does not match its bundle" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Labels by index, from every bundle's loaded vocabulary and from label tables opened from the
+    // headers, which only index the files. Both resolve the same labels, so their lengths cancel.
+    // The synthetic labels files end in a newline, after which a table has an empty label, as
+    // TensorIO does, that the CLI's vocabulary drops
+
+    const size_t labelLookups = 1000000;
+    size_t matched = 0;
+
+    start = Clock::now();
+    for ( size_t i = 0; i < labelLookups; i++ ) {
+        const std::vector<std::string> &labels = serial[i % bundles]->outputs()[0].labels;
+        matched += labels[(i * 7919) % labels.size()].size();
+    }
+    double loadedLabelNanoseconds = Milliseconds(start) * 1e6 / labelLookups;
+
+    std::vector<std::shared_ptr<LabelTable>> tables;
+    heap = HeapInUse();
+    start = Clock::now();
+
+    for ( const BundleRecord &record : warm.records ) {
+        tables.push_back(LabelTable::Open(LabelsPath(modelsDirectory, record), &error));
+        if ( tables.back() == nullptr ) {
+            std::cerr << error << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    double tablesMilliseconds = Milliseconds(start);
+    int64_t tablesBytes = HeapInUse() - heap;
+
+    start = Clock::now();
+    for ( size_t i = 0; i < labelLookups; i++ ) {
+        const LabelTable &table = *tables[i % bundles];
+        matched -= table.at((i * 7919) % (table.size() - 1)).length;
+    }
+    double tableLabelNanoseconds = Milliseconds(start) * 1e6 / labelLookups;
+
+    for ( size_t i = 0; i < bundles; i++ ) {
+        const std::vector<std::string> &labels = serial[i]->outputs()[0].labels;
+        if ( tables[i]->size() != labels.size() + 1 || tables[i]->at(labels.size() - 1).str() != labels.back() || tables[i]->at(labels.size()).length != 0 ) {
+            matched += 1;
+        }
+    }
+
+    if ( matched != 0 ) {
+        std::cerr << "Label tables do not match the loaded labels" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Identifier lookups
+
+    std::unordered_map<std::string, size_t> index;
+    for ( size_t i = 0; i < serial.size(); i++ ) {
+        index.emplace(serial[i]->identifier(), i);
+    }
+
+    std::vector<std::string> identifiers;
+    for ( size_t i = 0; i < bundles; i++ ) {
+        identifiers.push_back(Identifier(i));
+    }
+
+    const size_t lookups = 1000000;
+    size_t found = 0;
+
+    start = Clock::now();
+    for ( size_t i = 0; i < lookups; i++ ) {
+        const std::string &identifier = identifiers[i % bundles];
+        found += std::find_if(serial.begin(), serial.end(), [&](const std::shared_ptr<ModelBundle> &bundle) { return bundle->identifier() == identifier; }) != serial.end();
+    }
+    double linearNanoseconds = Milliseconds(start) * 1e6 / lookups;
+
+    start = Clock::now();
+    for ( size_t i = 0; i < lookups; i++ ) {
+        found += index.count(identifiers[i % bundles]);
+    }
+    double indexedNanoseconds = Milliseconds(start) * 1e6 / lookups;
+
+    if ( found != 2 * lookups ) {
+        std::cerr << "Lookups did not find every bundle" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+        << bundles << " bundles, serial load: " << serialMilliseconds << " ms" << std::endl
+        << "parallel scan with " << workers << " workers, no manifest: " << coldMilliseconds << " ms" << std::endl
+        << "scan with an up to date manifest: " << warmMilliseconds << " ms" << std::endl
+        << "scan after one bundle changed: " << changedMilliseconds << " ms" << std::endl
+        << "lookup by identifier, linear: " << linearNanoseconds << " ns, indexed: " << indexedNanoseconds << " ns" << std::endl;
+
+    if ( HeapInUse() >= 0 ) {
+        std::cout << std::setprecision(2)
+            << "heap to list bundles, loaded: " << Megabytes(serialBytes) << " MB, headers from the manifest: " << Megabytes(warmBytes) << " MB" << std::endl
+            << "label tables for every bundle: " << Megabytes(tablesBytes) << " MB of index, opened in " << std::setprecision(1) << tablesMilliseconds << " ms" << std::endl;
+    }
+
+    std::cout << std::setprecision(1)
+        << "label by index, loaded vocabulary: " << loadedLabelNanoseconds << " ns, label table: " << tableLabelNanoseconds << " ns" << std::endl;
+
+    for ( size_t i = 0; i < bundles; i++ ) {
+        RemoveBundle(modelsDirectory, BundleName(i));
+    }
+    std::remove(manifestPath.c_str());
+    ::rmdir(modelsDirectory.c_str());
+    ::rmdir(directory.c_str());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+//
+//  DetectionBoxesTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks that non-maximum suppression against sets of kept boxes, tested four boxes at a time,
+// suppresses exactly what comparing every pair of boxes does, including boxes without area and
+// thresholds at and below 0.
+//
+// usage: net-runner-detection-boxes-test
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DetectionBoxes.h"
+#include "PostProcessor.h"
+
+using netrunner::BoxSet;
+using netrunner::PostProcessor;
+
+namespace {
+
+const float kThresholds[] = {-0.5f, 0.0f, 0.3f, 0.5f, 1.0f};
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+// Clustered boxes of which every third has no height and every fifth is inverted
+
+std::vector<float> Boxes(size_t count, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> center(0.3f, 0.7f), size(0.05f, 0.4f);
+    std::vector<float> boxes(count * 4);
+
+    for ( size_t i = 0; i < count; i++ ) {
+        float cy = center(generator), cx = center(generator), h = size(generator), w = size(generator);
+        if ( i % 3 == 0 ) {
+            h = 0;
+        }
+        if ( i % 5 == 0 ) {
+            w = -w;
+        }
+        float *box = boxes.data() + i * 4;
+        box[0] = cy - h / 2; box[1] = cx - w / 2; box[2] = cy + h / 2; box[3] = cx + w / 2;
+    }
+
+    return boxes;
+}
+
+// Every set size up to a few vectors' worth, so that both the vector and the remainder loops
+// see boxes without area
+
+bool CheckOverlaps() {
+    const size_t count = 64;
+    std::vector<float> boxes = Boxes(count, 1);
+    BoxSet set;
+
+    for ( size_t size = 0; size <= 13; size++ ) {
+        set.clear();
+        for ( size_t i = 0; i < size; i++ ) {
+            set.add(&boxes[i * 4]);
+        }
+
+        if ( set.size() != size ) {
+            return Fail("A box set holds " + std::to_string(set.size()) + " of " + std::to_string(size) + " boxes");
+        }
+
+        for ( size_t j = 0; j < count; j++ ) {
+            for ( float threshold : kThresholds ) {
+                bool expected = false;
+                for ( size_t i = 0; i < size && !expected; i++ ) {
+                    expected = PostProcessor::IntersectionOverUnion(&boxes[i * 4], &boxes[j * 4]) > threshold;
+                }
+                if ( set.overlaps(&boxes[j * 4], threshold) != expected ) {
+                    return Fail("Box " + std::to_string(j) + " against a set of " + std::to_string(size)
+                        + " boxes at threshold " + std::to_string(threshold) + " does not match pairwise overlap");
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+// A kept box without area suppresses what comparing pairs suppresses: nothing at a threshold of
+// 0 or more, and every later box of its class below 0
+
+bool CheckSuppression() {
+    const size_t rows = 40, classes = 3;
+    std::vector<float> boxes = Boxes(rows, 2);
+    std::vector<float> scores(rows * classes, 0);
+
+    for ( size_t row = 0; row < rows; row++ ) {
+        scores[row * classes + 1 + row % 2] = 1.0f - row / 100.0f;
+    }
+
+    for ( float threshold : kThresholds ) {
+        std::string error;
+        auto processor = PostProcessor::Compile({
+            {"scores", {1, static_cast<int>(rows), static_cast<int>(classes)}, {}},
+            {"boxes", {1, static_cast<int>(rows), 4}, {}}
+        }, "scores", {
+            {"nms", {{"score_threshold", 0.5}, {"iou_threshold", threshold}, {"background", 0}, {"max_detections", 100}}, {{"boxes", "boxes"}}, {}}
+        }, &error);
+
+        if ( processor == nullptr ) {
+            return Fail("Unable to compile the nms stage: " + error);
+        }
+
+        PostProcessor::Result result;
+        if ( !processor->run({{scores.data(), scores.size()}, {boxes.data(), boxes.size()}}, &result, &error) ) {
+            return Fail(error);
+        }
+
+        // Rows are already in score order
+
+        std::vector<size_t> kept;
+        for ( size_t row = 0; row < rows; row++ ) {
+            bool suppressed = false;
+            for ( size_t i = 0; i < kept.size() && !suppressed; i++ ) {
+                suppressed = kept[i] % 2 == row % 2
+                    && PostProcessor::IntersectionOverUnion(&boxes[kept[i] * 4], &boxes[row * 4]) > threshold;
+            }
+            if ( !suppressed ) {
+                kept.push_back(row);
+            }
+        }
+
+        bool matches = kept.size() == result.detections.size();
+        for ( size_t i = 0; matches && i < kept.size(); i++ ) {
+            matches = result.detections[i].box[0] == boxes[kept[i] * 4] && result.detections[i].box[1] == boxes[kept[i] * 4 + 1];
+        }
+
+        if ( !matches ) {
+            return Fail("Suppression at threshold " + std::to_string(threshold) + " keeps " + std::to_string(result.detections.size())
+                + " detections where pairwise suppression keeps " + std::to_string(kept.size()));
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool passed = CheckOverlaps()
+        && CheckSuppression();
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Detection box suppression checks out" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,342 @@
+//
+//  EvaluationMetric.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "EvaluationMetric.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "DetectionMetrics.h"
+#include "MetricTotals.h"
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+using metrics::DetectionAveragePrecision;
+using metrics::LabeledBox;
+using metrics::MatchDetections;
+using metrics::MetricTotals;
+
+const char * const kClassificationOutputKey = "classification";
+const char * const kDetectionsOutputKey = "detections";
+const char * const kGroundTruthKey = "ground_truth";
+const char * const kMeanAveragePrecisionKey = "mean_average_precision";
+const char * const kClassesKey = "classes";
+
+/**
+ * Mirrors EvaluationMetricMeanAccumulator: the count and sum of every numeric value, reduced to
+ * their means. Its state is a dictionary of {"count", "sum", "correct"} totals keyed by value
+ * name, without "correct" once a value was other than 0 or 1.
+ */
+
+class MeanAccumulator : public MetricAccumulator {
+public:
+    void add(const Json::Value &metric) override {
+        for ( const std::string &name : metric.getMemberNames() ) {
+            if ( metric[name].isNumeric() ) {
+                _totals.add(name, metric[name].asDouble());
+            }
+        }
+    }
+
+    Json::Value state() const override {
+        Json::Value state(Json::objectValue);
+
+        for ( const auto &entry : _totals.totals() ) {
+            Json::Value total(Json::objectValue);
+            total["count"] = static_cast<Json::UInt64>(entry.second.count);
+            total["sum"] = entry.second.sum;
+            if ( entry.second.binary ) {
+                total["correct"] = static_cast<Json::UInt64>(entry.second.correct);
+            }
+            state[entry.first] = total;
+        }
+
+        return state;
+    }
+
+    bool merge(const Json::Value &state) override {
+        if ( !state.isObject() ) {
+            return false;
+        }
+
+        MetricTotals merged = _totals;
+
+        for ( const std::string &name : state.getMemberNames() ) {
+            const Json::Value &dictionary = state[name];
+            MetricTotals::Total total;
+
+            if ( !dictionary.isObject() || !dictionary["count"].isUInt64() || !dictionary["sum"].isNumeric()
+                || (dictionary.isMember("correct") && !dictionary["correct"].isUInt64()) ) {
+                return false;
+            }
+
+            total.count = dictionary["count"].asUInt64();
+            total.sum = dictionary["sum"].asDouble();
+            total.binary = dictionary.isMember("correct");
+            total.correct = total.binary ? dictionary["correct"].asUInt64() : 0;
+
+            if ( !merged.merge(name, total) ) {
+                return false;
+            }
+        }
+
+        _totals = merged;
+        return true;
+    }
+
+    Json::Value reduce() const override {
+        Json::Value result(Json::objectValue);
+
+        for ( const auto &entry : _totals.totals() ) {
+            result[entry.first] = static_cast<float>(_totals.mean(entry.first));
+        }
+
+        return result;
+    }
+
+    Json::Value accuracyCounts() const override {
+        Json::Value counts(Json::objectValue);
+
+        for ( const auto &entry : _totals.totals() ) {
+            if ( entry.second.binary ) {
+                counts[entry.first]["correct"] = static_cast<Json::UInt64>(entry.second.correct);
+                counts[entry.first]["count"] = static_cast<Json::UInt64>(entry.second.count);
+            }
+        }
+
+        return counts;
+    }
+
+private:
+    MetricTotals _totals;
+};
+
+/**
+ * Mirrors EvaluationMetricMeanAveragePrecision's accumulator: the detections and true positives
+ * at each score of every class. Its state is {"classes": [{"label", "ground_truth", "scores"}]}
+ * with [score, detections, matches] entries in descending score order.
+ */
+
+class DetectionAccumulator : public MetricAccumulator {
+public:
+    void add(const Json::Value &metric) override {
+        for ( const Json::Value &detection : metric[kDetectionsOutputKey] ) {
+            _precision.addDetection(detection[0].asString(), detection[1].asFloat(), detection[2].asInt() != 0);
+        }
+
+        const Json::Value &truth = metric[kGroundTruthKey];
+
+        for ( const std::string &label : truth.getMemberNames() ) {
+            _precision.addTruth(label, truth[label].asUInt64());
+        }
+    }
+
+    Json::Value state() const override {
+        Json::Value classes(Json::arrayValue);
+
+        for ( const DetectionAveragePrecision::ClassState &state : _precision.states() ) {
+            Json::Value entry(Json::objectValue);
+            Json::Value scores(Json::arrayValue);
+
+            for ( const DetectionAveragePrecision::ScoreCount &score : state.scores ) {
+                Json::Value count(Json::arrayValue);
+                count.append(score.score);
+                count.append(static_cast<Json::UInt64>(score.detections));
+                count.append(static_cast<Json::UInt64>(score.matches));
+                scores.append(count);
+            }
+
+            entry["label"] = state.label;
+            entry[kGroundTruthKey] = static_cast<Json::UInt64>(state.truth);
+            entry["scores"] = scores;
+            classes.append(entry);
+        }
+
+        Json::Value state(Json::objectValue);
+        state[kClassesKey] = classes;
+        return state;
+    }
+
+    bool merge(const Json::Value &state) override {
+        if ( !state.isObject() || !state[kClassesKey].isArray() ) {
+            return false;
+        }
+
+        std::vector<DetectionAveragePrecision::ClassState> states;
+
+        for ( const Json::Value &entry : state[kClassesKey] ) {
+            if ( !entry.isObject() || !entry["label"].isString() || !entry[kGroundTruthKey].isUInt64() || !entry["scores"].isArray() ) {
+                return false;
+            }
+
+            DetectionAveragePrecision::ClassState classState;
+            classState.label = entry["label"].asString();
+            classState.truth = entry[kGroundTruthKey].asUInt64();
+
+            for ( const Json::Value &count : entry["scores"] ) {
+                if ( !count.isArray() || count.size() != 3 || !count[0].isNumeric() || !count[1].isUInt64() || !count[2].isUInt64() ) {
+                    return false;
+                }
+                classState.scores.push_back({count[0].asFloat(), count[1].asUInt64(), count[2].asUInt64()});
+            }
+
+            states.push_back(std::move(classState));
+        }
+
+        return _precision.mergeStates(states);
+    }
+
+    Json::Value reduce() const override {
+        double mean = _precision.meanAveragePrecision();
+
+        Json::Value result(Json::objectValue);
+        result[kMeanAveragePrecisionKey] = std::isnan(mean) ? 0.0 : mean;
+        return result;
+    }
+
+private:
+    DetectionAveragePrecision _precision;
+};
+
+/**
+ * Mirrors EvaluationMetricAccuracyTop5.
+ */
+
+class EvaluationMetricAccuracyTop5 : public EvaluationMetric {
+public:
+    Json::Value evaluate(const Json::Value &y, const Json::Value &yhat) const override {
+        const Json::Value &classifications = yhat[kClassificationOutputKey];
+        std::vector<std::pair<std::string, double>> entries;
+
+        if ( classifications.isObject() ) {
+            for ( const std::string &key : classifications.getMemberNames() ) {
+                entries.push_back({key, classifications[key].asDouble()});
+            }
+        }
+
+        std::stable_sort(entries.begin(), entries.end(), [](const std::pair<std::string, double> &a, const std::pair<std::string, double> &b) {
+            return a.second > b.second;
+        });
+
+        if ( entries.size() > 5 ) {
+            entries.resize(5);
+        }
+
+        std::vector<std::string> labels = y[kClassificationOutputKey].isObject()
+            ? y[kClassificationOutputKey].getMemberNames()
+            : std::vector<std::string>();
+
+        bool correct = !labels.empty() && std::any_of(entries.begin(), entries.end(), [&](const std::pair<std::string, double> &entry) {
+            return entry.first == labels.front();
+        });
+
+        Json::Value result(Json::objectValue);
+        result["classification_accuracy"] = correct ? 1 : 0;
+        return result;
+    }
+
+    std::unique_ptr<MetricAccumulator> accumulator() const override {
+        return std::unique_ptr<MetricAccumulator>(new MeanAccumulator());
+    }
+};
+
+/**
+ * Mirrors EvaluationMetricMeanAveragePrecision.
+ */
+
+class EvaluationMetricMeanAveragePrecision : public EvaluationMetric {
+public:
+    Json::Value evaluate(const Json::Value &y, const Json::Value &yhat) const override {
+        std::vector<LabeledBox> truth = Boxes(y[kDetectionsOutputKey]);
+        std::vector<LabeledBox> detections = Boxes(yhat[kDetectionsOutputKey]);
+        std::vector<bool> matched;
+
+        MatchDetections(truth, detections, 0.5f, &matched);
+
+        Json::Value result(Json::objectValue);
+        result[kDetectionsOutputKey] = Json::Value(Json::arrayValue);
+        result[kGroundTruthKey] = Json::Value(Json::objectValue);
+
+        for ( size_t i = 0; i < detections.size(); i++ ) {
+            Json::Value detection(Json::arrayValue);
+            detection.append(detections[i].label);
+            detection.append(detections[i].score);
+            detection.append(matched[i] ? 1 : 0);
+            result[kDetectionsOutputKey].append(detection);
+        }
+        for ( const LabeledBox &box : truth ) {
+            result[kGroundTruthKey][box.label] = result[kGroundTruthKey][box.label].asInt() + 1;
+        }
+
+        return result;
+    }
+
+    std::unique_ptr<MetricAccumulator> accumulator() const override {
+        return std::unique_ptr<MetricAccumulator>(new DetectionAccumulator());
+    }
+
+private:
+
+    // Classes are labels, or indexes when the model's stages do not apply labels
+
+    static std::vector<LabeledBox> Boxes(const Json::Value &list) {
+        std::vector<LabeledBox> boxes;
+
+        if ( !list.isArray() ) {
+            return boxes;
+        }
+
+        for ( const Json::Value &entry : list ) {
+            const Json::Value &box = entry["box"];
+            if ( !box.isArray() || box.size() != 4 ) {
+                continue;
+            }
+
+            LabeledBox labeled;
+            labeled.label = entry["class"].isString() ? entry["class"].asString() : std::to_string(entry["class"].asInt64());
+            labeled.score = entry["score"].asFloat();
+            for ( Json::ArrayIndex i = 0; i < 4; i++ ) {
+                labeled.box[i] = box[i].asFloat();
+            }
+            boxes.push_back(labeled);
+        }
+
+        return boxes;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<EvaluationMetric> EvaluationMetricForName(const std::string &name) {
+    if ( name == "EvaluationMetricAccuracyTop5" ) {
+        return std::unique_ptr<EvaluationMetric>(new EvaluationMetricAccuracyTop5());
+    }
+    if ( name == "EvaluationMetricMeanAveragePrecision" ) {
+        return std::unique_ptr<EvaluationMetric>(new EvaluationMetricMeanAveragePrecision());
+    }
+    return nullptr;
+}
+
+} // namespace cli
+} // namespace netrunner
@@ -0,0 +1,110 @@
+//
+//  EvaluationMetric.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef EvaluationMetric_h
+#define EvaluationMetric_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * The running state of a metric's values over a model's results, which replaces the results
+ * themselves. States are written to partial summaries and merge, so that the shards of a test
+ * bundle reduce to the values a single run would have, see ModelSummary.h.
+ */
+
+class MetricAccumulator {
+public:
+    virtual ~MetricAccumulator() = default;
+
+    /**
+     * Folds the values the metric's evaluate returned for one result into the state.
+     */
+
+    virtual void add(const Json::Value &metric) = 0;
+
+    /**
+     * The state, as a partial summary keeps it.
+     */
+
+    virtual Json::Value state() const = 0;
+
+    /**
+     * Merges a state written by an accumulator of the same metric. Returns false and merges
+     * nothing if the state is malformed.
+     */
+
+    virtual bool merge(const Json::Value &state) = 0;
+
+    /**
+     * Reduces the state to a dictionary of summary values.
+     */
+
+    virtual Json::Value reduce() const = 0;
+
+    /**
+     * The correct and total counts of every summary value that is an accuracy, keyed by name.
+     */
+
+    virtual Json::Value accuracyCounts() const {
+        return Json::Value(Json::objectValue);
+    }
+};
+
+/**
+ * The portable counterpart of the app's `EvaluationMetric` protocol. A metric compares a single
+ * model output with its expected value, and its accumulator reduces the per-image results to
+ * summary values.
+ */
+
+class EvaluationMetric {
+public:
+    virtual ~EvaluationMetric() = default;
+
+    /**
+     * Compares an expected output y with a model output yhat, returning a dictionary of values.
+     */
+
+    virtual Json::Value evaluate(const Json::Value &y, const Json::Value &yhat) const = 0;
+
+    /**
+     * An empty accumulator for the values returned by evaluate.
+     */
+
+    virtual std::unique_ptr<MetricAccumulator> accumulator() const = 0;
+};
+
+/**
+ * The metric with a given name, using the Objective-C class names that test bundles specify,
+ * e.g. "EvaluationMetricAccuracyTop5". Returns nullptr for unknown metrics.
+ */
+
+std::unique_ptr<EvaluationMetric> EvaluationMetricForName(const std::string &name);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* EvaluationMetric_h */
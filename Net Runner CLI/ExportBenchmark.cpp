@@ -0,0 +1,498 @@
+//
+//  ExportBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the zip writer and the ordered pipeline and times a labels export of synthetic 512x512
+// images. The streaming export fetches and encodes images on a pool of workers and writes them
+// straight into the archive, stored, with labels.json compressed as it is built. For comparison
+// it also times the previous export, which encoded each image on one thread, wrote it to a
+// temporary directory, and then compressed the whole directory into the archive. Fetching an
+// image is emulated by rendering it.
+//
+// usage: net-runner-export-benchmark [images] [workers]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include <jpeglib.h>
+#include <json/json.h>
+#include <zlib.h>
+
+#include "OrderedPipeline.h"
+#include "ZipWriter.h"
+
+using netrunner::DeflatedEntry;
+using netrunner::OrderedPipeline;
+using netrunner::ZipWriter;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int kImageSize = 512;
+
+struct Timing {
+    double seconds;
+    uint64_t peakBytes;
+};
+
+// Synthetic images: a smooth gradient with a little noise, so that they compress like photos
+
+std::vector<uint8_t> Render(size_t index) {
+    std::mt19937 generator(static_cast<uint32_t>(index));
+    std::uniform_int_distribution<int> noise(-12, 12);
+    std::vector<uint8_t> pixels(kImageSize * kImageSize * 3);
+    float phase = static_cast<float>(index) * 0.37f;
+
+    for ( int y = 0; y < kImageSize; y++ ) {
+        for ( int x = 0; x < kImageSize; x++ ) {
+            uint8_t *pixel = &pixels[(y * kImageSize + x) * 3];
+            float r = 127 + 100 * std::sin(x * 0.02f + phase);
+            float g = 127 + 100 * std::cos(y * 0.015f - phase);
+            float b = 127 + 100 * std::sin((x + y) * 0.01f);
+            pixel[0] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(r) + noise(generator))));
+            pixel[1] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(g) + noise(generator))));
+            pixel[2] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(b) + noise(generator))));
+        }
+    }
+
+    return pixels;
+}
+
+// Quality 100, as UIImageJPEGRepresentation(image, 1.0)
+
+std::vector<uint8_t> EncodeJPEG(const std::vector<uint8_t> &pixels) {
+    jpeg_compress_struct info;
+    jpeg_error_mgr errorManager;
+    unsigned char *buffer = nullptr;
+    unsigned long length = 0;
+
+    info.err = jpeg_std_error(&errorManager);
+    jpeg_create_compress(&info);
+    jpeg_mem_dest(&info, &buffer, &length);
+
+    info.image_width = kImageSize;
+    info.image_height = kImageSize;
+    info.input_components = 3;
+    info.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&info);
+    jpeg_set_quality(&info, 100, TRUE);
+    jpeg_start_compress(&info, TRUE);
+
+    while ( info.next_scanline < info.image_height ) {
+        JSAMPROW row = const_cast<JSAMPROW>(&pixels[info.next_scanline * kImageSize * 3]);
+        jpeg_write_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_compress(&info);
+    jpeg_destroy_compress(&info);
+
+    std::vector<uint8_t> jpeg(buffer, buffer + length);
+    std::free(buffer);
+    return jpeg;
+}
+
+std::string Identifier(size_t index) {
+    char identifier[64];
+    std::snprintf(identifier, sizeof(identifier), "%08zX-5E3A-4B1C-9D2F-%012zX-L0-001", index * 2654435761u % 0xFFFFFFFF, index);
+    return identifier;
+}
+
+std::string LabelsJSON(size_t index) {
+    return "{\"class\":\"class " + std::to_string(index % 100) + "\",\"id\":\"" + Identifier(index) + "\"}";
+}
+
+bool ReadFile(const std::string &path, std::vector<uint8_t> *bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if ( !file ) {
+        return false;
+    }
+    bytes->assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+// MARK: - Reading Archives
+
+uint64_t Get(const uint8_t *bytes, size_t size) {
+    uint64_t value = 0;
+    for ( size_t i = 0; i < size; i++ ) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+
+struct ZipEntry {
+    std::string name;
+    std::vector<uint8_t> data;
+};
+
+// Reads every entry of an archive through its central directory, checking local headers and
+// checksums, and following the zip64 end of central directory record when there is one
+
+bool ReadZip(const std::string &path, std::vector<ZipEntry> *entries) {
+    std::vector<uint8_t> zip;
+
+    if ( !ReadFile(path, &zip) || zip.size() < 22 || Get(&zip[zip.size() - 22], 4) != 0x06054b50 ) {
+        std::cerr << "Missing end of central directory in " << path << std::endl;
+        return false;
+    }
+
+    const uint8_t *end = &zip[zip.size() - 22];
+    uint64_t count = Get(end + 10, 2);
+    uint64_t directoryOffset = Get(end + 16, 4);
+
+    if ( count == 0xFFFF || directoryOffset == 0xFFFFFFFF ) {
+        const uint8_t *locator = end - 20;
+        if ( zip.size() < 42 || Get(locator, 4) != 0x07064b50 ) {
+            std::cerr << "Missing zip64 locator in " << path << std::endl;
+            return false;
+        }
+        const uint8_t *zip64End = &zip[Get(locator + 8, 8)];
+        if ( Get(zip64End, 4) != 0x06064b50 ) {
+            std::cerr << "Missing zip64 end of central directory in " << path << std::endl;
+            return false;
+        }
+        count = Get(zip64End + 32, 8);
+        directoryOffset = Get(zip64End + 48, 8);
+    }
+
+    const uint8_t *header = &zip[directoryOffset];
+    entries->clear();
+
+    for ( uint64_t i = 0; i < count; i++ ) {
+        if ( Get(header, 4) != 0x02014b50 ) {
+            std::cerr << "Corrupt central directory header " << i << std::endl;
+            return false;
+        }
+
+        uint64_t method = Get(header + 10, 2), crc = Get(header + 16, 4);
+        uint64_t compressedSize = Get(header + 20, 4), uncompressedSize = Get(header + 24, 4);
+        uint64_t nameLength = Get(header + 28, 2), extraLength = Get(header + 30, 2), commentLength = Get(header + 32, 2);
+        uint64_t offset = Get(header + 42, 4);
+        std::string name(reinterpret_cast<const char*>(header + 46), nameLength);
+
+        if ( offset == 0xFFFFFFFF && extraLength >= 12 && Get(header + 46 + nameLength, 2) == 0x0001 ) {
+            offset = Get(header + 46 + nameLength + 4, 8);
+        }
+
+        const uint8_t *local = &zip[offset];
+
+        if ( Get(local, 4) != 0x04034b50 || Get(local + 14, 4) != crc || Get(local + 26, 2) != nameLength
+            || std::memcmp(local + 30, name.data(), nameLength) != 0 ) {
+            std::cerr << "Local header of " << name << " does not match the central directory" << std::endl;
+            return false;
+        }
+
+        const uint8_t *data = local + 30 + nameLength + Get(local + 28, 2);
+        ZipEntry entry = {name, std::vector<uint8_t>(uncompressedSize)};
+
+        if ( method == 0 && compressedSize == uncompressedSize ) {
+            std::copy(data, data + compressedSize, entry.data.begin());
+        } else if ( method == 8 ) {
+            entry.data.resize(uncompressedSize + 1); // inflate needs room to finish an empty entry
+            z_stream stream = z_stream();
+            inflateInit2(&stream, -MAX_WBITS);
+            stream.next_in = const_cast<Bytef*>(data);
+            stream.avail_in = static_cast<uInt>(compressedSize);
+            stream.next_out = entry.data.data();
+            stream.avail_out = static_cast<uInt>(uncompressedSize + 1);
+            int status = inflate(&stream, Z_FINISH);
+            inflateEnd(&stream);
+            entry.data.resize(uncompressedSize);
+            if ( status != Z_STREAM_END || stream.total_out != uncompressedSize ) {
+                std::cerr << "Unable to inflate " << name << std::endl;
+                return false;
+            }
+        } else {
+            std::cerr << "Unexpected method for " << name << std::endl;
+            return false;
+        }
+
+        if ( crc32(0, entry.data.data(), static_cast<uInt>(entry.data.size())) != crc ) {
+            std::cerr << "Checksum mismatch for " << name << std::endl;
+            return false;
+        }
+
+        entries->push_back(std::move(entry));
+        header += 46 + nameLength + extraLength + commentLength;
+    }
+
+    return true;
+}
+
+// MARK: - Checks
+
+bool CheckPipeline() {
+    std::mt19937 generator(1);
+    std::vector<int> delays(500);
+    for ( int &delay : delays ) {
+        delay = std::uniform_int_distribution<int>(0, 200)(generator);
+    }
+
+    OrderedPipeline<size_t> pipeline({8, 12});
+    std::atomic<size_t> inFlight(0), maxInFlight(0);
+    size_t expected = 0;
+
+    bool completed = pipeline.run(delays.size(), [&](size_t index) {
+        size_t current = ++inFlight;
+        size_t previous = maxInFlight.load();
+        while ( current > previous && !maxInFlight.compare_exchange_weak(previous, current) ) {}
+        std::this_thread::sleep_for(std::chrono::microseconds(delays[index]));
+        --inFlight;
+        return index * 3;
+    }, [&](size_t index, size_t &output) {
+        bool ordered = index == expected && output == index * 3;
+        expected += 1;
+        return ordered;
+    });
+
+    if ( !completed || expected != delays.size() || pipeline.statistics().maxBuffered > 12 || maxInFlight > 8 ) {
+        std::cerr << "Pipeline did not deliver outputs in order within its window" << std::endl;
+        return false;
+    }
+
+    std::atomic<size_t> produced(0);
+    completed = pipeline.run(10000, [&](size_t index) {
+        produced++;
+        return index;
+    }, [&](size_t index, size_t&) {
+        return index < 99;
+    });
+
+    if ( completed || pipeline.statistics().consumed != 99 || produced > 100 + 12 ) {
+        std::cerr << "Pipeline did not stop when the consumer did" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckZip(const std::string &directory) {
+    std::string path = directory + "/net-runner-export-check.zip";
+    std::string error;
+    std::vector<ZipEntry> entries;
+
+    // Stored and deflated entries, including empty ones
+
+    {
+        auto writer = ZipWriter::Create(path, &error);
+        std::string text = "stored entry";
+        DeflatedEntry deflated, empty;
+        for ( int i = 0; i < 10000; i++ ) {
+            deflated.append("line " + std::to_string(i) + "\n");
+        }
+        if ( !writer->add("stored.txt", text.data(), text.size(), &error) || !writer->add("empty.txt", nullptr, 0, &error)
+            || !writer->add("deflated.txt", deflated, &error) || !writer->add("empty.json", empty, &error)
+            || !writer->close(&error) ) {
+            std::cerr << error << std::endl;
+            return false;
+        }
+    }
+
+    if ( !ReadZip(path, &entries) || entries.size() != 4 || entries[0].name != "stored.txt"
+        || std::string(entries[0].data.begin(), entries[0].data.end()) != "stored entry"
+        || !entries[1].data.empty() || entries[2].data.size() != 98890 || !entries[3].data.empty() ) {
+        std::cerr << "Archive entries do not round trip" << std::endl;
+        return false;
+    }
+
+    // More entries than the classic end of central directory can count
+
+    {
+        auto writer = ZipWriter::Create(path, &error);
+        for ( size_t i = 0; i < 70000; i++ ) {
+            std::string name = std::to_string(i);
+            if ( !writer->add(name, name.data(), name.size(), &error) ) {
+                std::cerr << error << std::endl;
+                return false;
+            }
+        }
+    }
+
+    bool zip64 = ReadZip(path, &entries) && entries.size() == 70000 && entries.back().name == "69999";
+    std::remove(path.c_str());
+
+    if ( !zip64 ) {
+        std::cerr << "Zip64 archive does not round trip" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckExport(const std::string &path, size_t images) {
+    std::vector<ZipEntry> entries;
+
+    if ( !ReadZip(path, &entries) || entries.size() != images + 1 || entries.back().name != "labels.json" ) {
+        std::cerr << "Export has the wrong entries" << std::endl;
+        return false;
+    }
+
+    Json::Value labels;
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    const char *json = reinterpret_cast<const char*>(entries.back().data.data());
+    std::string error;
+
+    if ( !reader->parse(json, json + entries.back().data.size(), &labels, &error) || labels.size() != images ) {
+        std::cerr << "Unable to read exported labels: " << error << std::endl;
+        return false;
+    }
+
+    for ( size_t i = 0; i < images; i++ ) {
+        if ( entries[i].name != Identifier(i) + ".jpg" || labels[static_cast<int>(i)]["id"].asString() != Identifier(i) ) {
+            std::cerr << "Export is out of order at " << i << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// MARK: - Exports
+
+// One image at a time into a temporary directory, then the directory into a deflated archive
+
+Timing ExportSerial(size_t images, const std::string &directory, const std::string &path) {
+    Clock::time_point start = Clock::now();
+    std::string staging = directory + "/net-runner-export-staging";
+    std::string labels = "[";
+    uint64_t stagedBytes = 0;
+
+    ::mkdir(staging.c_str(), 0755);
+
+    for ( size_t i = 0; i < images; i++ ) {
+        std::vector<uint8_t> jpeg = EncodeJPEG(Render(i));
+        std::ofstream(staging + "/" + Identifier(i) + ".jpg", std::ios::binary).write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+        labels += (i == 0 ? "\n" : ",\n") + LabelsJSON(i);
+        stagedBytes += jpeg.size();
+    }
+
+    labels += "\n]\n";
+    std::ofstream(staging + "/labels.json", std::ios::binary) << labels;
+    stagedBytes += labels.size();
+
+    std::string error;
+    auto writer = ZipWriter::Create(path, &error);
+    std::vector<uint8_t> bytes;
+
+    for ( size_t i = 0; i <= images; i++ ) {
+        std::string name = i < images ? Identifier(i) + ".jpg" : "labels.json";
+        DeflatedEntry entry;
+        ReadFile(staging + "/" + name, &bytes);
+        entry.append(bytes.data(), bytes.size());
+        writer->add(name, entry, &error);
+    }
+
+    writer->close(&error);
+    uint64_t zipBytes = writer->size();
+
+    for ( size_t i = 0; i < images; i++ ) {
+        std::remove((staging + "/" + Identifier(i) + ".jpg").c_str());
+    }
+    std::remove((staging + "/labels.json").c_str());
+    ::rmdir(staging.c_str());
+
+    return {std::chrono::duration<double>(Clock::now() - start).count(), stagedBytes + zipBytes};
+}
+
+// Workers render and encode, the calling thread streams into the archive
+
+Timing ExportStreaming(size_t images, size_t workers, const std::string &path, OrderedPipeline<std::vector<uint8_t>>::Statistics *statistics) {
+    Clock::time_point start = Clock::now();
+    std::string error;
+    auto writer = ZipWriter::Create(path, &error);
+    DeflatedEntry labels;
+    labels.append("[");
+
+    OrderedPipeline<std::vector<uint8_t>> pipeline({workers, workers * 2});
+
+    pipeline.run(images, [](size_t index) {
+        return EncodeJPEG(Render(index));
+    }, [&](size_t index, std::vector<uint8_t> &jpeg) {
+        labels.append((index == 0 ? "\n" : ",\n") + LabelsJSON(index));
+        return writer->add(Identifier(index) + ".jpg", jpeg.data(), jpeg.size(), &error);
+    });
+
+    labels.append("\n]\n");
+    writer->add("labels.json", labels, &error);
+    writer->close(&error);
+
+    *statistics = pipeline.statistics();
+    return {std::chrono::duration<double>(Clock::now() - start).count(), writer->size()};
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long imageCount = argc > 1 ? std::atol(argv[1]) : 200;
+    const long workerCount = argc > 2 ? std::atol(argv[2]) : std::max(2u, std::thread::hardware_concurrency());
+
+    if ( imageCount <= 0 || workerCount <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [images] [workers]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string directory = P_tmpdir;
+
+    if ( !CheckPipeline() || !CheckZip(directory) ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Pipeline and archives check out" << std::endl;
+
+    size_t images = static_cast<size_t>(imageCount);
+    std::string serialPath = directory + "/net-runner-export-serial.zip";
+    std::string streamingPath = directory + "/net-runner-export-streaming.zip";
+    OrderedPipeline<std::vector<uint8_t>>::Statistics statistics;
+
+    Timing serial = ExportSerial(images, directory, serialPath);
+    Timing streaming = ExportStreaming(images, static_cast<size_t>(workerCount), streamingPath, &statistics);
+
+    bool valid = CheckExport(serialPath, images) && CheckExport(streamingPath, images);
+    std::remove(serialPath.c_str());
+    std::remove(streamingPath.c_str());
+
+    if ( !valid ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+        << images << " images, serial: " << serial.seconds << "s, peak disk " << serial.peakBytes / 1e6 << " MB" << std::endl
+        << images << " images, streaming with " << workerCount << " workers: " << streaming.seconds << "s"
+        << ", peak disk " << streaming.peakBytes / 1e6 << " MB"
+        << ", at most " << statistics.maxBuffered << " images buffered" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,120 @@
+//
+//  FrameSchedulerBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Runs the live frame scheduler against a synthetic camera and model. Frames arrive at a fixed
+// rate, and preprocessing and inference sleep for their given durations with some jitter. Reports
+// the drop rate and end-to-end latency with and without pipelined preprocessing.
+//
+// usage: net-runner-frame-scheduler-benchmark [fps] [preprocessing ms] [inference ms] [seconds]
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#include "FrameScheduler.h"
+
+using netrunner::FrameScheduler;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Frame {
+    uint64_t index = 0;
+};
+
+using Scheduler = FrameScheduler<Frame, Frame, Frame>;
+
+// Sleeps for about the given duration, give or take 20%
+
+void Work(std::mt19937 &generator, double milliseconds) {
+    std::uniform_real_distribution<double> jitter(0.8, 1.2);
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(milliseconds * jitter(generator)));
+}
+
+void Run(bool pipelined, double fps, double preprocessing, double inference, double seconds) {
+    std::mt19937 preprocessingGenerator(1), inferenceGenerator(2);
+    uint64_t latestIndex = 0;
+
+    Scheduler::Options options;
+    options.pipelined = pipelined;
+
+    Scheduler scheduler(options, [&](Frame &frame) {
+        Work(preprocessingGenerator, preprocessing);
+        return frame;
+    }, [&](Frame &input) {
+        Work(inferenceGenerator, inference);
+        return input;
+    }, [&](Frame &result, const Scheduler::Timing &timing) {
+        (void)timing;
+        latestIndex = result.index;
+    });
+
+    // The synthetic camera delivers frames on its own schedule, whether or not the model keeps up
+
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+    const Clock::time_point start = Clock::now();
+    Clock::time_point next = start;
+    uint64_t index = 0;
+
+    while ( Clock::now() - start < std::chrono::duration<double>(seconds) ) {
+        scheduler.submit(Frame{index++}, next);
+        next += interval;
+        std::this_thread::sleep_until(next);
+    }
+
+    scheduler.stop();
+
+    Scheduler::Statistics statistics = scheduler.statistics();
+    const netrunner::LatencyHistogram::Summary &latency = statistics.endToEndLatency;
+
+    std::cout << std::fixed << std::setprecision(1)
+        << (pipelined ? "pipelined  " : "sequential ")
+        << "frames " << statistics.frames
+        << ", completed " << statistics.completed
+        << ", dropped " << statistics.dropped << " (" << statistics.dropRate() * 100 << "%)"
+        << ", results/s " << statistics.completed / seconds
+        << ", end-to-end p50/p90/p99/max " << latency.p50 << "/" << latency.p90 << "/" << latency.p99 << "/" << latency.max << "ms"
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const double fps = argc > 1 ? std::atof(argv[1]) : 30;
+    const double preprocessing = argc > 2 ? std::atof(argv[2]) : 8;
+    const double inference = argc > 3 ? std::atof(argv[3]) : 25;
+    const double seconds = argc > 4 ? std::atof(argv[4]) : 5;
+
+    if ( fps <= 0 || preprocessing < 0 || inference < 0 || seconds <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [fps] [preprocessing ms] [inference ms] [seconds]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Camera at " << fps << " fps, preprocessing " << preprocessing << "ms, inference " << inference << "ms, for " << seconds << "s" << std::endl;
+
+    Run(false, fps, preprocessing, inference, seconds);
+    Run(true, fps, preprocessing, inference, seconds);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,292 @@
+//
+//  Image.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+#include <jpeglib.h>
+#include <png.h>
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+using File = std::unique_ptr<FILE, int(*)(FILE*)>;
+
+// MARK: - JPEG
+
+struct JPEGErrorManager {
+    jpeg_error_mgr manager;
+    jmp_buf jump;
+    char message[JMSG_LENGTH_MAX];
+};
+
+void JPEGErrorExit(j_common_ptr info) {
+    JPEGErrorManager *errorManager = reinterpret_cast<JPEGErrorManager*>(info->err);
+    (*info->err->format_message)(info, errorManager->message);
+    longjmp(errorManager->jump, 1);
+}
+
+bool DecodeJPEG(FILE *file, const std::string &path, Image *image, std::string *error) {
+    jpeg_decompress_struct info;
+    JPEGErrorManager errorManager;
+
+    info.err = jpeg_std_error(&errorManager.manager);
+    errorManager.manager.error_exit = JPEGErrorExit;
+
+    if ( setjmp(errorManager.jump) ) {
+        jpeg_destroy_decompress(&info);
+        SetError(error, "Unable to decode JPEG at " + path + ": " + errorManager.message);
+        return false;
+    }
+
+    jpeg_create_decompress(&info);
+    jpeg_stdio_src(&info, file);
+    jpeg_read_header(&info, TRUE);
+
+    info.out_color_space = JCS_RGB;
+    jpeg_start_decompress(&info);
+
+    image->width = static_cast<int>(info.output_width);
+    image->height = static_cast<int>(info.output_height);
+    image->pixels.resize(static_cast<size_t>(image->width) * image->height * Image::kChannels);
+
+    while ( info.output_scanline < info.output_height ) {
+        JSAMPROW row = image->pixels.data() + static_cast<size_t>(info.output_scanline) * image->width * Image::kChannels;
+        jpeg_read_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_decompress(&info);
+    jpeg_destroy_decompress(&info);
+
+    return true;
+}
+
+// MARK: - PNG
+
+bool DecodePNG(FILE *file, const std::string &path, Image *image, std::string *error) {
+    png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    png_infop info = png ? png_create_info_struct(png) : nullptr;
+
+    if ( png == nullptr || info == nullptr ) {
+        png_destroy_read_struct(&png, &info, nullptr);
+        SetError(error, "Unable to allocate PNG decoder for " + path);
+        return false;
+    }
+
+    if ( setjmp(png_jmpbuf(png)) ) {
+        png_destroy_read_struct(&png, &info, nullptr);
+        SetError(error, "Unable to decode PNG at " + path);
+        return false;
+    }
+
+    png_init_io(png, file);
+    png_read_info(png, info);
+
+    // Normalize every color type and bit depth to 8 bit RGB, discarding alpha
+
+    png_set_expand(png);
+    png_set_strip_16(png);
+    png_set_strip_alpha(png);
+    png_set_gray_to_rgb(png);
+    png_read_update_info(png, info);
+
+    image->width = static_cast<int>(png_get_image_width(png, info));
+    image->height = static_cast<int>(png_get_image_height(png, info));
+    image->pixels.resize(static_cast<size_t>(image->width) * image->height * Image::kChannels);
+
+    std::vector<png_bytep> rows(image->height);
+    for ( int y = 0; y < image->height; y++ ) {
+        rows[y] = image->pixels.data() + static_cast<size_t>(y) * image->width * Image::kChannels;
+    }
+
+    png_read_image(png, rows.data());
+    png_read_end(png, nullptr);
+    png_destroy_read_struct(&png, &info, nullptr);
+
+    return true;
+}
+
+// MARK: - Resampling
+
+const double kLanczosRadius = 3;
+
+double Lanczos(double x) {
+    x = std::fabs(x);
+    if ( x < 1e-8 ) {
+        return 1;
+    }
+    if ( x >= kLanczosRadius ) {
+        return 0;
+    }
+    double pix = M_PI * x;
+    return kLanczosRadius * std::sin(pix) * std::sin(pix / kLanczosRadius) / (pix * pix);
+}
+
+// Precomputed contributions of source pixels to each destination pixel along one axis. The
+// kernel is widened when downsampling so that every source pixel contributes.
+
+struct Contributions {
+    std::vector<int> first;
+    std::vector<int> count;
+    std::vector<float> weights;
+    int stride = 0;
+};
+
+Contributions ComputeContributions(int sourceLength, int destinationLength) {
+    Contributions contributions;
+
+    double scale = static_cast<double>(destinationLength) / sourceLength;
+    double filterScale = std::min(scale, 1.0);
+    double support = kLanczosRadius / filterScale;
+
+    contributions.stride = static_cast<int>(std::ceil(support * 2)) + 1;
+    contributions.first.resize(destinationLength);
+    contributions.count.resize(destinationLength);
+    contributions.weights.assign(static_cast<size_t>(destinationLength) * contributions.stride, 0);
+
+    for ( int i = 0; i < destinationLength; i++ ) {
+        double center = (i + 0.5) / scale;
+        int first = std::max(0, static_cast<int>(std::floor(center - support)));
+        int last = std::min(sourceLength - 1, static_cast<int>(std::ceil(center + support)));
+        int count = std::min(last - first + 1, contributions.stride);
+
+        float *weights = &contributions.weights[static_cast<size_t>(i) * contributions.stride];
+        double total = 0;
+
+        for ( int j = 0; j < count; j++ ) {
+            double weight = Lanczos((first + j + 0.5 - center) * filterScale);
+            weights[j] = static_cast<float>(weight);
+            total += weight;
+        }
+
+        if ( total != 0 ) {
+            for ( int j = 0; j < count; j++ ) {
+                weights[j] = static_cast<float>(weights[j] / total);
+            }
+        }
+
+        contributions.first[i] = first;
+        contributions.count[i] = count;
+    }
+
+    return contributions;
+}
+
+uint8_t ClampToByte(float value) {
+    return static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, std::round(value))));
+}
+
+} // namespace
+
+bool DecodeImageFile(const std::string &path, Image *image, std::string *error) {
+    File file(std::fopen(path.c_str(), "rb"), std::fclose);
+
+    if ( !file ) {
+        SetError(error, "Unable to open image at " + path);
+        return false;
+    }
+
+    unsigned char magic[8] = {0};
+    size_t length = std::fread(magic, 1, sizeof(magic), file.get());
+    std::rewind(file.get());
+
+    if ( length >= 3 && magic[0] == 0xFF && magic[1] == 0xD8 && magic[2] == 0xFF ) {
+        return DecodeJPEG(file.get(), path, image, error);
+    }
+
+    if ( length == 8 && png_sig_cmp(magic, 0, 8) == 0 ) {
+        return DecodePNG(file.get(), path, image, error);
+    }
+
+    SetError(error, "Image at " + path + " is not a JPEG or PNG");
+    return false;
+}
+
+Image CropAndResize(const Image &source, int width, int height) {
+    const int side = std::min(source.width, source.height);
+    const int cropX = (source.width - side) / 2;
+    const int cropY = (source.height - side) / 2;
+    const int channels = Image::kChannels;
+
+    Contributions horizontal = ComputeContributions(side, width);
+    Contributions vertical = ComputeContributions(side, height);
+
+    // Horizontal pass over the cropped rows into a float buffer, then the vertical pass
+
+    std::vector<float> intermediate(static_cast<size_t>(side) * width * channels);
+
+    for ( int y = 0; y < side; y++ ) {
+        const uint8_t *row = source.pixels.data() + (static_cast<size_t>(cropY + y) * source.width + cropX) * channels;
+        float *out = intermediate.data() + static_cast<size_t>(y) * width * channels;
+
+        for ( int x = 0; x < width; x++ ) {
+            const float *weights = &horizontal.weights[static_cast<size_t>(x) * horizontal.stride];
+            const uint8_t *in = row + static_cast<size_t>(horizontal.first[x]) * channels;
+            float r = 0, g = 0, b = 0;
+
+            for ( int j = 0; j < horizontal.count[x]; j++ ) {
+                r += in[j*channels+0] * weights[j];
+                g += in[j*channels+1] * weights[j];
+                b += in[j*channels+2] * weights[j];
+            }
+
+            out[x*channels+0] = r;
+            out[x*channels+1] = g;
+            out[x*channels+2] = b;
+        }
+    }
+
+    Image destination;
+    destination.width = width;
+    destination.height = height;
+    destination.pixels.resize(static_cast<size_t>(width) * height * channels);
+
+    for ( int y = 0; y < height; y++ ) {
+        const float *weights = &vertical.weights[static_cast<size_t>(y) * vertical.stride];
+        uint8_t *out = destination.pixels.data() + static_cast<size_t>(y) * width * channels;
+
+        for ( int x = 0; x < width * channels; x++ ) {
+            float value = 0;
+            for ( int j = 0; j < vertical.count[y]; j++ ) {
+                value += intermediate[static_cast<size_t>(vertical.first[y] + j) * width * channels + x] * weights[j];
+            }
+            out[x] = ClampToByte(value);
+        }
+    }
+
+    return destination;
+}
+
+} // namespace cli
+} // namespace netrunner
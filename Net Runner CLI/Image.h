@@ -0,0 +1,61 @@
+//
+//  Image.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Image_h
+#define Image_h
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * An 8 bit RGB image with interleaved channels and tightly packed rows.
+ */
+
+struct Image {
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+
+    static const int kChannels = 3;
+};
+
+/**
+ * Decodes a JPEG or PNG file into an RGB image. The format is detected from the file's contents.
+ * Returns false and sets error if the file cannot be read or decoded.
+ */
+
+bool DecodeImageFile(const std::string &path, Image *image, std::string *error);
+
+/**
+ * Crops the largest centered square from an image and scales it to width x height with a
+ * Lanczos kernel, matching the app's `TIOCVPixelBufferResizeToSquare`, which uses vImage.
+ * Results may differ from the device by a unit in the last place for some pixels.
+ */
+
+Image CropAndResize(const Image &source, int width, int height);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* Image_h */
@@ -0,0 +1,185 @@
+//
+//  Interpreter.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Interpreter.h"
+
+#include <tensorflow/lite/c/c_api.h>
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+size_t ElementCount(const TfLiteTensor *tensor) {
+    size_t count = 1;
+    for ( int32_t i = 0; i < TfLiteTensorNumDims(tensor); i++ ) {
+        count *= static_cast<size_t>(TfLiteTensorDim(tensor, i));
+    }
+    return count;
+}
+
+} // namespace
+
+std::unique_ptr<Interpreter> Interpreter::Create(std::shared_ptr<const ModelBundle> bundle, int threads, std::string *error) {
+    if ( bundle->backend() != "tflite" ) {
+        SetError(error, "Model " + bundle->identifier() + " uses the unsupported backend " + bundle->backend());
+        return nullptr;
+    }
+
+    std::unique_ptr<Interpreter> interpreter(new Interpreter());
+    interpreter->_bundle = bundle;
+    interpreter->_model = TfLiteModelCreateFromFile(bundle->modelFilePath().c_str());
+
+    if ( interpreter->_model == nullptr ) {
+        SetError(error, "Unable to load model file at " + bundle->modelFilePath());
+        return nullptr;
+    }
+
+    TfLiteInterpreterOptions *options = TfLiteInterpreterOptionsCreate();
+    TfLiteInterpreterOptionsSetNumThreads(options, threads);
+    interpreter->_interpreter = TfLiteInterpreterCreate(interpreter->_model, options);
+    TfLiteInterpreterOptionsDelete(options);
+
+    if ( interpreter->_interpreter == nullptr ) {
+        SetError(error, "Unable to create an interpreter for model " + bundle->identifier());
+        return nullptr;
+    }
+
+    if ( TfLiteInterpreterAllocateTensors(interpreter->_interpreter) != kTfLiteOk ) {
+        SetError(error, "Unable to allocate tensors for model " + bundle->identifier());
+        return nullptr;
+    }
+
+    if ( static_cast<size_t>(TfLiteInterpreterGetInputTensorCount(interpreter->_interpreter)) < bundle->inputs().size()
+        || static_cast<size_t>(TfLiteInterpreterGetOutputTensorCount(interpreter->_interpreter)) < bundle->outputs().size() ) {
+        SetError(error, "Model " + bundle->identifier() + " has fewer tensors than its model.json describes");
+        return nullptr;
+    }
+
+    return interpreter;
+}
+
+Interpreter::~Interpreter() {
+    if ( _interpreter != nullptr ) {
+        TfLiteInterpreterDelete(_interpreter);
+    }
+    if ( _model != nullptr ) {
+        TfLiteModelDelete(_model);
+    }
+}
+
+bool Interpreter::setImageInput(size_t index, const Image &image, std::string *error) {
+    const LayerDescription &layer = _bundle->inputs().at(index);
+    TfLiteTensor *tensor = TfLiteInterpreterGetInputTensor(_interpreter, static_cast<int32_t>(index));
+
+    if ( !layer.isImage() || image.width != layer.width() || image.height != layer.height() ) {
+        SetError(error, "Input " + layer.name + " is not an image input of the image's size");
+        return false;
+    }
+
+    const size_t pixels = static_cast<size_t>(image.width) * image.height;
+    const size_t elements = pixels * Image::kChannels;
+
+    if ( ElementCount(tensor) != elements ) {
+        SetError(error, "Input tensor " + layer.name + " does not match the size described in model.json");
+        return false;
+    }
+
+    const bool swapsChannels = layer.pixelFormat == LayerDescription::PixelFormat::BGR;
+    const uint8_t *source = image.pixels.data();
+
+    switch ( TfLiteTensorType(tensor) ) {
+    case kTfLiteUInt8: {
+        _byteInput.resize(elements);
+        for ( size_t i = 0; i < pixels; i++ ) {
+            _byteInput[i*3+0] = source[i*3 + (swapsChannels ? 2 : 0)];
+            _byteInput[i*3+1] = source[i*3+1];
+            _byteInput[i*3+2] = source[i*3 + (swapsChannels ? 0 : 2)];
+        }
+        TfLiteTensorCopyFromBuffer(tensor, _byteInput.data(), _byteInput.size());
+        return true;
+    }
+    case kTfLiteFloat32: {
+        const Normalization &n = layer.normalization;
+        const float scale = n.scale;
+        const float r = n.bias[0], g = n.bias[1], b = n.bias[2];
+
+        _floatInput.resize(elements);
+        for ( size_t i = 0; i < pixels; i++ ) {
+            float red = source[i*3+0] * scale + r;
+            float green = source[i*3+1] * scale + g;
+            float blue = source[i*3+2] * scale + b;
+            _floatInput[i*3+0] = swapsChannels ? blue : red;
+            _floatInput[i*3+1] = green;
+            _floatInput[i*3+2] = swapsChannels ? red : blue;
+        }
+        TfLiteTensorCopyFromBuffer(tensor, _floatInput.data(), _floatInput.size() * sizeof(float));
+        return true;
+    }
+    default:
+        SetError(error, "Input tensor " + layer.name + " has an unsupported type, only uint8 and float32 are supported");
+        return false;
+    }
+}
+
+bool Interpreter::invoke(std::string *error) {
+    if ( TfLiteInterpreterInvoke(_interpreter) != kTfLiteOk ) {
+        SetError(error, "Unable to invoke model " + _bundle->identifier());
+        return false;
+    }
+    return true;
+}
+
+bool Interpreter::readOutput(size_t index, std::vector<float> *values, std::string *error) const {
+    const LayerDescription &layer = _bundle->outputs().at(index);
+    const TfLiteTensor *tensor = TfLiteInterpreterGetOutputTensor(_interpreter, static_cast<int32_t>(index));
+    const size_t count = ElementCount(tensor);
+
+    values->resize(count);
+
+    switch ( TfLiteTensorType(tensor) ) {
+    case kTfLiteUInt8: {
+        const uint8_t *data = static_cast<const uint8_t*>(TfLiteTensorData(tensor));
+        const float scale = layer.dequantizes ? layer.dequantization.scale : 1;
+        const float bias = layer.dequantizes ? layer.dequantization.bias[0] : 0;
+        for ( size_t i = 0; i < count; i++ ) {
+            (*values)[i] = data[i] * scale + bias;
+        }
+        return true;
+    }
+    case kTfLiteFloat32: {
+        const float *data = static_cast<const float*>(TfLiteTensorData(tensor));
+        values->assign(data, data + count);
+        return true;
+    }
+    default:
+        SetError(error, "Output tensor " + layer.name + " has an unsupported type, only uint8 and float32 are supported");
+        return false;
+    }
+}
+
+} // namespace cli
+} // namespace netrunner
@@ -0,0 +1,95 @@
+//
+//  Interpreter.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Interpreter_h
+#define Interpreter_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Image.h"
+#include "ModelBundle.h"
+
+struct TfLiteModel;
+struct TfLiteInterpreter;
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * Runs a model bundle's TensorFlow Lite model with the TensorFlow Lite C API.
+ *
+ * Inputs and outputs are matched to the layers described in model.json by index, as they are in
+ * `TIOTFLiteModel`. Only uint8 and float32 tensors are supported. An interpreter is not safe to
+ * use from more than one thread at a time.
+ */
+
+class Interpreter {
+public:
+
+    /**
+     * Loads the bundle's model file and allocates its tensors. Returns nullptr and sets error if
+     * the bundle does not use the tflite backend or the model cannot be loaded.
+     */
+
+    static std::unique_ptr<Interpreter> Create(std::shared_ptr<const ModelBundle> bundle, int threads, std::string *error);
+
+    ~Interpreter();
+
+    Interpreter(const Interpreter&) = delete;
+    Interpreter& operator=(const Interpreter&) = delete;
+
+    /**
+     * Copies an image, already scaled to the layer's size, into an image input. Quantized inputs
+     * receive the raw pixel values and float inputs the normalized values. Channels are swapped
+     * for BGR layers.
+     */
+
+    bool setImageInput(size_t index, const Image &image, std::string *error);
+
+    bool invoke(std::string *error);
+
+    /**
+     * Reads an output as floats. Quantized outputs are dequantized when model.json describes a
+     * dequantization and are otherwise returned as their raw values.
+     */
+
+    bool readOutput(size_t index, std::vector<float> *values, std::string *error) const;
+
+    const ModelBundle &bundle() const { return *_bundle; }
+
+private:
+    Interpreter() = default;
+
+    std::shared_ptr<const ModelBundle> _bundle;
+    TfLiteModel *_model = nullptr;
+    TfLiteInterpreter *_interpreter = nullptr;
+
+    // Reused between inputs to avoid an allocation per evaluation
+
+    std::vector<float> _floatInput;
+    std::vector<uint8_t> _byteInput;
+};
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* Interpreter_h */
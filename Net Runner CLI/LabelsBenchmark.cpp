@@ -0,0 +1,391 @@
+//
+//  LabelsBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the label encoding and times inserting and scanning a labels database with 100,000 rows
+// for a model with a text output and a 16 value numeric output. The typed store is written the
+// way the app now writes it: WAL mode, one prepared upsert and a transaction per batch of rows,
+// with numeric labels packed as float32. For comparison it also times the previous store, which
+// serialized each row to JSON, prepared a fresh insert for each row and committed each row in
+// its own transaction with the default rollback journal. Because each of those commits syncs the
+// disk, the previous store is timed on the first 10,000 rows only.
+//
+// usage: net-runner-labels-benchmark [rows] [batch-size]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <json/json.h>
+#include <sqlite3.h>
+
+#include "LabelEncoding.h"
+
+namespace labels = netrunner::labels;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t kValueCount = 16;
+
+struct Row {
+    std::string identifier;
+    std::string text;
+    std::vector<float> values;
+};
+
+struct Timing {
+    double insertSeconds;
+    double scanSeconds;
+    size_t bytes;
+    double checksum;
+};
+
+// Photo library style identifiers with a text label and a numeric label
+
+std::vector<Row> Rows(size_t count) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> value(0, 1);
+    std::vector<Row> rows(count);
+
+    for ( size_t i = 0; i < count; i++ ) {
+        char identifier[64];
+        std::snprintf(identifier, sizeof(identifier), "%08zX-5E3A-4B1C-9D2F-%012zX/L0/001", i * 2654435761u % 0xFFFFFFFF, i);
+        rows[i].identifier = identifier;
+        rows[i].text = "class " + std::to_string(i % 1000);
+        rows[i].values.resize(kValueCount);
+        for ( float &v : rows[i].values ) {
+            v = value(generator);
+        }
+    }
+
+    return rows;
+}
+
+double Checksum(const std::string &text, const float *values, size_t count) {
+    double sum = static_cast<double>(text.size());
+    for ( size_t i = 0; i < count; i++ ) {
+        sum += values[i];
+    }
+    return sum;
+}
+
+double Checksum(const std::vector<Row> &rows) {
+    double sum = 0;
+    for ( const Row &row : rows ) {
+        sum += Checksum(row.text, row.values.data(), row.values.size());
+    }
+    return sum;
+}
+
+bool CheckEncoding() {
+    std::vector<float> values = {0.0f, -1.5f, 3.25e-8f, 1e30f, NAN};
+    std::vector<uint8_t> bytes;
+    std::vector<float> decoded;
+
+    labels::EncodeFloats(values.data(), values.size(), &bytes);
+
+    if ( bytes.size() != values.size() * 4 || bytes[4] != 0x00 || bytes[7] != 0xBF
+        || !labels::DecodeFloats(bytes.data(), bytes.size(), &decoded) || decoded.size() != values.size() ) {
+        std::cerr << "Floats do not round trip as little-endian float32" << std::endl;
+        return false;
+    }
+
+    for ( size_t i = 0; i < values.size(); i++ ) {
+        if ( std::memcmp(&values[i], &decoded[i], sizeof(float)) != 0 ) {
+            std::cerr << "Float " << i << " does not round trip" << std::endl;
+            return false;
+        }
+    }
+
+    if ( labels::DecodeFloats(bytes.data(), 7, &decoded) || !labels::DecodeFloats(nullptr, 0, &decoded) || !decoded.empty() ) {
+        std::cerr << "Float blobs of invalid length are not rejected" << std::endl;
+        return false;
+    }
+
+    std::vector<labels::Column> columns = {{"id", labels::LabelType::Text}, {"say \"cheese\"", labels::LabelType::Floats}};
+
+    if ( labels::CreateTableStatement(columns) != "CREATE TABLE labels (id TEXT PRIMARY KEY NOT NULL, \"label_id\" TEXT, \"label_say \"\"cheese\"\"\" BLOB) WITHOUT ROWID"
+        || labels::UpsertStatement(columns) != "INSERT OR REPLACE INTO labels (id, \"label_id\", \"label_say \"\"cheese\"\"\") VALUES (?, ?, ?)" ) {
+        std::cerr << "Unexpected labels statements" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// SQLite helpers
+
+struct Database {
+    sqlite3 *db = nullptr;
+    std::string path;
+
+    explicit Database(const std::string &path) : path(path) {
+        Remove();
+        if ( sqlite3_open(path.c_str(), &db) != SQLITE_OK ) {
+            std::cerr << "Unable to open " << path << ": " << sqlite3_errmsg(db) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    ~Database() {
+        sqlite3_close(db);
+        Remove();
+    }
+
+    void Remove() {
+        for ( const char *suffix : {"", "-wal", "-shm", "-journal"} ) {
+            ::unlink((path + suffix).c_str());
+        }
+    }
+
+    // The size on disk of the database and its write-ahead log
+
+    size_t Bytes() const {
+        size_t bytes = 0;
+        for ( const char *suffix : {"", "-wal"} ) {
+            struct stat st;
+            if ( ::stat((path + suffix).c_str(), &st) == 0 ) {
+                bytes += static_cast<size_t>(st.st_size);
+            }
+        }
+        return bytes;
+    }
+
+    void Execute(const std::string &sql) {
+        char *message = nullptr;
+        if ( sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &message) != SQLITE_OK ) {
+            std::cerr << "Unable to execute " << sql << ": " << (message ? message : "") << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+
+    sqlite3_stmt *Prepare(const std::string &sql) {
+        sqlite3_stmt *statement = nullptr;
+        if ( sqlite3_prepare_v2(db, sql.c_str(), -1, &statement, nullptr) != SQLITE_OK ) {
+            std::cerr << "Unable to prepare " << sql << ": " << sqlite3_errmsg(db) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        return statement;
+    }
+
+    void Step(sqlite3_stmt *statement) {
+        if ( sqlite3_step(statement) != SQLITE_DONE ) {
+            std::cerr << "Unable to write row: " << sqlite3_errmsg(db) << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+};
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Typed columns, WAL, a prepared upsert and batched transactions
+
+Timing TimeTyped(const std::vector<Row> &rows, size_t batchSize, const std::string &path) {
+    Database database(path);
+    Timing timing;
+
+    std::vector<labels::Column> columns = {{"class", labels::LabelType::Text}, {"scores", labels::LabelType::Floats}};
+
+    database.Execute("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;");
+    database.Execute(labels::CreateTableStatement(columns));
+
+    Clock::time_point start = Clock::now();
+    sqlite3_stmt *upsert = database.Prepare(labels::UpsertStatement(columns));
+    std::vector<uint8_t> bytes;
+
+    for ( size_t i = 0; i < rows.size(); i++ ) {
+        if ( i % batchSize == 0 ) {
+            database.Execute("BEGIN IMMEDIATE");
+        }
+
+        const Row &row = rows[i];
+        labels::EncodeFloats(row.values.data(), row.values.size(), &bytes);
+
+        sqlite3_bind_text(upsert, 1, row.identifier.data(), static_cast<int>(row.identifier.size()), SQLITE_STATIC);
+        sqlite3_bind_text(upsert, 2, row.text.data(), static_cast<int>(row.text.size()), SQLITE_STATIC);
+        sqlite3_bind_blob(upsert, 3, bytes.data(), static_cast<int>(bytes.size()), SQLITE_STATIC);
+        database.Step(upsert);
+        sqlite3_reset(upsert);
+
+        if ( i % batchSize == batchSize - 1 || i == rows.size() - 1 ) {
+            database.Execute("COMMIT");
+        }
+    }
+
+    sqlite3_finalize(upsert);
+    timing.insertSeconds = Seconds(start);
+
+    database.Execute("PRAGMA wal_checkpoint(TRUNCATE)");
+    timing.bytes = database.Bytes();
+
+    start = Clock::now();
+    sqlite3_stmt *select = database.Prepare(labels::SelectStatement(columns, false));
+    std::vector<float> values;
+    double checksum = 0;
+
+    while ( sqlite3_step(select) == SQLITE_ROW ) {
+        std::string text(reinterpret_cast<const char*>(sqlite3_column_text(select, 1)), static_cast<size_t>(sqlite3_column_bytes(select, 1)));
+        const void *blob = sqlite3_column_blob(select, 2);
+        if ( !labels::DecodeFloats(blob, static_cast<size_t>(sqlite3_column_bytes(select, 2)), &values) ) {
+            std::cerr << "Unable to decode scores" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+        checksum += Checksum(text, values.data(), values.size());
+    }
+
+    sqlite3_finalize(select);
+    timing.scanSeconds = Seconds(start);
+    timing.checksum = checksum;
+
+    return timing;
+}
+
+// A JSON blob per row, a fresh statement per row and a transaction per row
+
+Timing TimeJSON(const std::vector<Row> &rows, const std::string &path) {
+    Database database(path);
+    Timing timing;
+
+    database.Execute("CREATE TABLE labels (id TEXT PRIMARY KEY, labels BLOB NOT NULL)");
+
+    Json::StreamWriterBuilder writerBuilder;
+    writerBuilder["indentation"] = "";
+    std::unique_ptr<Json::StreamWriter> writer(writerBuilder.newStreamWriter());
+
+    Clock::time_point start = Clock::now();
+
+    for ( const Row &row : rows ) {
+        Json::Value labels(Json::objectValue);
+        labels["class"] = row.text;
+        labels["scores"] = Json::Value(Json::arrayValue);
+        for ( float value : row.values ) {
+            labels["scores"].append(value);
+        }
+
+        std::ostringstream stream;
+        writer->write(labels, &stream);
+        std::string data = stream.str();
+
+        sqlite3_stmt *insert = database.Prepare("INSERT INTO labels (id, labels) VALUES (?, ?)");
+        sqlite3_bind_text(insert, 1, row.identifier.data(), static_cast<int>(row.identifier.size()), SQLITE_STATIC);
+        sqlite3_bind_blob(insert, 2, data.data(), static_cast<int>(data.size()), SQLITE_STATIC);
+        database.Step(insert);
+        sqlite3_finalize(insert);
+    }
+
+    timing.insertSeconds = Seconds(start);
+    timing.bytes = database.Bytes();
+
+    start = Clock::now();
+    sqlite3_stmt *select = database.Prepare("SELECT * FROM labels");
+    Json::CharReaderBuilder readerBuilder;
+    std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+    std::vector<float> values;
+    double checksum = 0;
+
+    while ( sqlite3_step(select) == SQLITE_ROW ) {
+        const char *data = static_cast<const char*>(sqlite3_column_blob(select, 1));
+        int length = sqlite3_column_bytes(select, 1);
+        Json::Value labels;
+        std::string error;
+
+        if ( !reader->parse(data, data + length, &labels, &error) ) {
+            std::cerr << "Unable to parse labels: " << error << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+
+        values.clear();
+        for ( const Json::Value &value : labels["scores"] ) {
+            values.push_back(value.asFloat());
+        }
+        checksum += Checksum(labels["class"].asString(), values.data(), values.size());
+    }
+
+    sqlite3_finalize(select);
+    timing.scanSeconds = Seconds(start);
+    timing.checksum = checksum;
+
+    return timing;
+}
+
+void Print(const char *name, const Timing &timing, size_t rows) {
+    std::cout << std::fixed << std::setprecision(1)
+        << name << ": insert " << timing.insertSeconds * 1000 << "ms"
+        << " (" << std::setprecision(2) << timing.insertSeconds * 1e6 / rows << "us per row)"
+        << std::setprecision(1)
+        << ", scan " << timing.scanSeconds * 1000 << "ms"
+        << " (" << std::setprecision(2) << timing.scanSeconds * 1e6 / rows << "us per row)"
+        << ", " << timing.bytes / rows << " bytes per row on disk"
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long rowCount = argc > 1 ? std::atol(argv[1]) : 100000;
+    const long batchSize = argc > 2 ? std::atol(argv[2]) : 1000;
+
+    if ( rowCount <= 0 || batchSize <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [rows] [batch-size]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ( !CheckEncoding() ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Label encoding round trips" << std::endl;
+
+    std::vector<Row> rows = Rows(static_cast<size_t>(rowCount));
+    std::vector<Row> sample(rows.begin(), rows.begin() + std::min<size_t>(rows.size(), 10000));
+    std::string directory = P_tmpdir;
+
+    Timing typed = TimeTyped(rows, static_cast<size_t>(batchSize), directory + "/net-runner-labels-typed.db");
+    Timing json = TimeJSON(sample, directory + "/net-runner-labels-json.db");
+
+    // Float32 blobs are exact, JSON rounds floats to their shortest representation
+
+    double expected = Checksum(rows), sampleExpected = Checksum(sample);
+
+    if ( typed.checksum != expected || std::abs(json.checksum - sampleExpected) > 1e-6 * sampleExpected ) {
+        std::cerr << "Scans do not match the rows that were written" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Print("typed, batched", typed, rows.size());
+    Print("json, per row", json, sample.size());
+
+    return EXIT_SUCCESS;
+}
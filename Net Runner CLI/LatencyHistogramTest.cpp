@@ -0,0 +1,265 @@
+//
+//  LatencyHistogramTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks the latency histogram: that bucket indexes and values map onto each other across the
+// whole range, percentiles within the promised precision, warm-up, merging histograms and
+// exported states, and clamping values that are out of range.
+//
+// usage: net-runner-latency-histogram-test
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "LatencyHistogram.h"
+
+using namespace netrunner;
+
+namespace {
+
+const uint64_t kMaxMicros = (1ULL << LatencyHistogram::kMaxValueBits) - 1;
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+bool SameState(const LatencyHistogram::State &a, const LatencyHistogram::State &b) {
+    return a.minMicros == b.minMicros && a.maxMicros == b.maxMicros && a.buckets == b.buckets
+        && std::fabs(a.sum - b.sum) < 1e-6 && std::fabs(a.sumOfSquares - b.sumOfSquares) < 1e-3;
+}
+
+bool CheckBuckets() {
+    // Below the sub-bucket count every microsecond has its own bucket
+
+    for ( uint64_t micros = 0; micros < static_cast<uint64_t>(LatencyHistogram::kSubBucketCount); micros++ ) {
+        if ( LatencyHistogram::bucketIndex(micros) != micros || LatencyHistogram::bucketUpperBound(micros) != micros ) {
+            return Fail("Value " + std::to_string(micros) + " does not have its own bucket");
+        }
+    }
+
+    // Above it the buckets are contiguous, each value maps to the bucket whose range contains it,
+    // and no bucket is wider than 1/64th of its values
+
+    uint64_t lower = 0;
+
+    for ( size_t index = 0; index < LatencyHistogram::kBucketCount; index++ ) {
+        uint64_t upper = LatencyHistogram::bucketUpperBound(index);
+
+        if ( upper < lower ) {
+            return Fail("Bucket " + std::to_string(index) + " ends before it begins");
+        }
+
+        if ( LatencyHistogram::bucketIndex(lower) != index || LatencyHistogram::bucketIndex(upper) != index ) {
+            return Fail("The values of bucket " + std::to_string(index) + " do not map onto it");
+        }
+
+        if ( lower >= static_cast<uint64_t>(LatencyHistogram::kSubBucketCount) && (upper - lower + 1) * 64 > lower ) {
+            return Fail("Bucket " + std::to_string(index) + " is wider than 1/64th of its values");
+        }
+
+        lower = upper + 1;
+    }
+
+    // The last bucket ends at the largest value, and larger values are clamped into it
+
+    if ( lower - 1 != kMaxMicros ) {
+        return Fail("The buckets end at " + std::to_string(lower - 1) + " microseconds, expected " + std::to_string(kMaxMicros));
+    }
+
+    if ( LatencyHistogram::bucketIndex(kMaxMicros + 1) != LatencyHistogram::kBucketCount - 1 || LatencyHistogram::bucketIndex(UINT64_MAX) != LatencyHistogram::kBucketCount - 1 ) {
+        return Fail("Values beyond the range are not clamped into the last bucket");
+    }
+
+    return true;
+}
+
+bool CheckPercentiles() {
+    // Below 128 microseconds values are exact
+
+    LatencyHistogram small;
+    for ( int micros = 1; micros <= 100; micros++ ) {
+        small.record(micros / 1000.0);
+    }
+
+    if ( small.percentile(50) != 0.050 || small.percentile(90) != 0.090 || small.percentile(99) != 0.099 ) {
+        return Fail("Percentiles of exact values are not exact");
+    }
+
+    // Above it a percentile is the upper bound of its bucket, within 1/64th above the true value,
+    // clamped to the recorded maximum
+
+    LatencyHistogram histogram;
+    for ( int milliseconds = 1; milliseconds <= 1000; milliseconds++ ) {
+        histogram.record(milliseconds);
+    }
+
+    for ( double percent : {1.0, 25.0, 50.0, 90.0, 99.0, 99.9} ) {
+        double expected = std::ceil(percent * 10);
+        double value = histogram.percentile(percent);
+
+        if ( value < expected || value > expected * (1 + 1.0 / 64) ) {
+            return Fail("Percentile " + std::to_string(percent) + " is " + std::to_string(value) + ", expected " + std::to_string(expected) + " to within 1/64th");
+        }
+    }
+
+    if ( histogram.percentile(0) > 1 + 1.0 / 64 || histogram.percentile(-5) != histogram.percentile(0) || histogram.percentile(100) != 1000 || histogram.percentile(150) != 1000 ) {
+        return Fail("Extreme percentiles are not those of the recorded minimum and maximum");
+    }
+
+    LatencyHistogram::Summary summary = histogram.summary();
+
+    if ( summary.count != 1000 || summary.min != 1 || summary.max != 1000 || std::fabs(summary.mean - 500.5) > 1e-9 || std::fabs(summary.stddev - 288.8194360957494) > 1e-6 ) {
+        return Fail("Summary count, extremes, mean or standard deviation are wrong");
+    }
+
+    // An empty histogram reports zeros
+
+    LatencyHistogram empty;
+
+    if ( empty.percentile(50) != 0 || empty.min() != 0 || empty.mean() != 0 || empty.stddev() != 0 || !empty.state().buckets.empty() ) {
+        return Fail("An empty histogram does not report zeros");
+    }
+
+    return true;
+}
+
+bool CheckWarmup() {
+    LatencyHistogram histogram(3);
+
+    for ( double milliseconds : {500.0, 400.0, 300.0, 10.0, 12.0} ) {
+        histogram.record(milliseconds);
+    }
+
+    if ( histogram.count() != 2 || histogram.discarded() != 3 || histogram.max() != 12 || histogram.last() != 12 ) {
+        return Fail("Warm-up values were not discarded");
+    }
+
+    histogram.reset();
+    histogram.record(500);
+
+    if ( histogram.count() != 0 || histogram.discarded() != 1 ) {
+        return Fail("Reset did not restart the warm-up");
+    }
+
+    return true;
+}
+
+bool CheckMerge() {
+    // Merging two halves gives the same distribution as recording everything in one
+
+    LatencyHistogram whole, first, second;
+
+    for ( int i = 1; i <= 2000; i++ ) {
+        double milliseconds = i * 0.37;
+        whole.record(milliseconds);
+        (i % 2 == 0 ? first : second).record(milliseconds);
+    }
+
+    LatencyHistogram merged;
+    merged.merge(first);
+    merged.merge(second);
+
+    if ( merged.count() != whole.count() || !SameState(merged.state(), whole.state()) || merged.percentile(99) != whole.percentile(99) ) {
+        return Fail("Merged histograms differ from a single histogram");
+    }
+
+    // Merging an exported state is the same as merging the histogram
+
+    LatencyHistogram restored;
+
+    if ( !restored.merge(first.state()) || !restored.merge(second.state()) || !SameState(restored.state(), whole.state()) ) {
+        return Fail("Merged states differ from a single histogram");
+    }
+
+    // Warm-up values of a merged histogram are not counted again
+
+    LatencyHistogram warm(5);
+    warm.merge(whole);
+
+    if ( warm.count() != 2000 ) {
+        return Fail("Merged values were discarded as warm-up");
+    }
+
+    // Empty histograms and states merge as no-ops
+
+    LatencyHistogram empty;
+    restored.merge(empty);
+
+    if ( !restored.merge(LatencyHistogram::State()) || !SameState(restored.state(), whole.state()) ) {
+        return Fail("Merging an empty histogram changed the distribution");
+    }
+
+    // A state with a bucket out of range is rejected without changing the histogram
+
+    LatencyHistogram::State invalid = first.state();
+    invalid.buckets.push_back({static_cast<uint32_t>(LatencyHistogram::kBucketCount), 1});
+
+    LatencyHistogram rejected;
+    rejected.record(1);
+
+    if ( rejected.merge(invalid) || rejected.count() != 1 || rejected.state().buckets.size() != 1 ) {
+        return Fail("A state with a bucket out of range was merged");
+    }
+
+    return true;
+}
+
+bool CheckOutOfRange() {
+    // Negative values are recorded as zero and values beyond the range as the largest value
+
+    LatencyHistogram histogram;
+    histogram.record(-3);
+    histogram.record(1e12);
+
+    LatencyHistogram::State state = histogram.state();
+
+    if ( histogram.count() != 2 || state.minMicros != 0 || state.maxMicros != kMaxMicros ) {
+        return Fail("Values out of range were not clamped");
+    }
+
+    if ( state.buckets.size() != 2 || state.buckets.front().first != 0 || state.buckets.back().first != LatencyHistogram::kBucketCount - 1 ) {
+        return Fail("Values out of range were not recorded in the first and last buckets");
+    }
+
+    if ( histogram.percentile(100) != kMaxMicros / 1000.0 || histogram.percentile(50) != 0 ) {
+        return Fail("Percentiles of values out of range are not clamped");
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool passed = CheckBuckets()
+        && CheckPercentiles()
+        && CheckWarmup()
+        && CheckMerge()
+        && CheckOutOfRange();
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Latency histograms check out" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,188 @@
+//
+//  MetricsBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Benchmarks the classification metrics on synthetic predictions. Scores are a softmax over
+// random logits, with the true class boosted often enough to give an accuracy in the range of
+// an ImageNet classifier. Only the metrics' work is timed, not generating the predictions.
+//
+// usage: net-runner-metrics-benchmark [predictions] [classes] [shards]
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "ClassificationMetrics.h"
+
+using namespace netrunner::metrics;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t kChunkSize = 1024;
+
+void Generate(std::mt19937 &generator, size_t count, size_t classes, std::vector<int32_t> *labels, std::vector<float> *scores) {
+    std::uniform_int_distribution<int32_t> label(0, static_cast<int32_t>(classes) - 1);
+    std::normal_distribution<float> logit(0.0f, 1.0f);
+    std::normal_distribution<float> boost(6.0f, 2.0f);
+
+    labels->resize(count);
+    scores->resize(count * classes);
+
+    for ( size_t r = 0; r < count; r++ ) {
+        float *row = scores->data() + r * classes;
+        float sum = 0;
+
+        (*labels)[r] = label(generator);
+
+        for ( size_t j = 0; j < classes; j++ ) {
+            row[j] = logit(generator);
+        }
+
+        row[(*labels)[r]] += boost(generator);
+
+        for ( size_t j = 0; j < classes; j++ ) {
+            row[j] = std::exp(row[j]);
+            sum += row[j];
+        }
+        for ( size_t j = 0; j < classes; j++ ) {
+            row[j] /= sum;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const size_t predictions = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    const size_t classes = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    const size_t shards = argc > 3 ? std::max<size_t>(1, std::strtoul(argv[3], nullptr, 10)) : 4;
+
+    const std::vector<std::string> names = {
+        "accuracy_top1",
+        "accuracy_top5",
+        "confusion_matrix",
+        "calibration_error",
+        "mean_average_precision"
+    };
+
+    // One accumulator per metric per shard, as if each shard were evaluated separately
+
+    std::vector<std::vector<std::unique_ptr<ClassificationMetric>>> accumulators(shards);
+
+    for ( size_t s = 0; s < shards; s++ ) {
+        for ( const std::string &name : names ) {
+            accumulators[s].push_back(ClassificationMetricForName(name, classes));
+        }
+    }
+
+    // And a set of every metric, which shares each row's top-1 class between metrics
+
+    ClassificationMetricSet set(classes, names);
+
+    std::vector<double> seconds(names.size(), 0);
+    double setSeconds = 0;
+    std::vector<int32_t> labels;
+    std::vector<float> scores;
+    std::mt19937 generator(42);
+
+    for ( size_t offset = 0, chunk = 0; offset < predictions; offset += kChunkSize, chunk++ ) {
+        const size_t count = std::min(kChunkSize, predictions - offset);
+        Generate(generator, count, classes, &labels, &scores);
+
+        PredictionBatch batch;
+        batch.labels = labels.data();
+        batch.scores = scores.data();
+        batch.count = count;
+        batch.classes = classes;
+
+        for ( size_t m = 0; m < names.size(); m++ ) {
+            Clock::time_point start = Clock::now();
+            accumulators[chunk % shards][m]->add(batch);
+            seconds[m] += std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        Clock::time_point start = Clock::now();
+        set.add(batch);
+        setSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    // Merge the shards and report
+
+    Clock::time_point start = Clock::now();
+
+    for ( size_t s = 1; s < shards; s++ ) {
+        for ( size_t m = 0; m < names.size(); m++ ) {
+            accumulators[0][m]->merge(*accumulators[s][m]);
+        }
+    }
+
+    const double merge = std::chrono::duration<double>(Clock::now() - start).count();
+
+    MetricReport report;
+    start = Clock::now();
+
+    for ( const std::unique_ptr<ClassificationMetric> &metric : accumulators[0] ) {
+        metric->report(&report);
+    }
+
+    const double reporting = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << predictions << " predictions, " << classes << " classes, " << shards << " shards\n\n";
+    std::cout << std::fixed << std::setprecision(3);
+
+    for ( size_t m = 0; m < names.size(); m++ ) {
+        std::cout << std::left << std::setw(24) << names[m]
+            << std::right << std::setw(10) << seconds[m] * 1000 << " ms"
+            << std::setw(12) << predictions / seconds[m] / 1e6 << " M predictions/s\n";
+    }
+
+    std::cout << std::left << std::setw(24) << "all, as a set"
+        << std::right << std::setw(10) << setSeconds * 1000 << " ms"
+        << std::setw(12) << predictions / setSeconds / 1e6 << " M predictions/s\n";
+    std::cout << std::left << std::setw(24) << "merge" << std::right << std::setw(10) << merge * 1000 << " ms\n";
+    std::cout << std::left << std::setw(24) << "report" << std::right << std::setw(10) << reporting * 1000 << " ms\n\n";
+
+    std::cout << std::setprecision(4);
+
+    for ( const auto &value : report.values ) {
+        std::cout << std::left << std::setw(28) << value.first << value.second << "\n";
+    }
+
+    std::cout << std::left << std::setw(28) << "confusion_matrix cells" << report.confusion.size() << "\n";
+
+    // The merged shards and the set saw the same predictions and should agree exactly
+
+    MetricReport setReport = set.report();
+    bool agree = setReport.values.size() == report.values.size();
+
+    for ( size_t i = 0; agree && i < report.values.size(); i++ ) {
+        agree = std::abs(setReport.values[i].second - report.values[i].second) < 1e-9;
+    }
+
+    std::cout << "\nmerged shards " << (agree ? "match" : "DO NOT match") << " a single accumulator\n";
+
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+//
+//  ModelBundle.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ModelBundle.h"
+
+#include <algorithm>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+bool IsDirectory(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool HasSuffix(const std::string &string, const std::string &suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Mirrors TIOPixelNormalizerForDictionary
+
+bool ParseNormalization(const Json::Value &dict, Normalization *normalization, std::string *error) {
+    *normalization = Normalization();
+
+    if ( dict.isNull() ) {
+        return true;
+    }
+
+    if ( dict.isMember("standard") ) {
+        std::string standard = dict["standard"].asString();
+        if ( standard == "[0,1]" ) {
+            normalization->scale = 1.0f/255.0f;
+        } else if ( standard == "[-1,1]" ) {
+            normalization->scale = 2.0f/255.0f;
+            std::fill(normalization->bias, normalization->bias+3, -1.0f);
+        } else {
+            SetError(error, "Expected normalize.standard to be '[0,1]' or '[-1,1]', found " + standard);
+            return false;
+        }
+        return true;
+    }
+
+    if ( dict.isMember("scale") ) {
+        normalization->scale = dict["scale"].asFloat();
+    }
+
+    const Json::Value &bias = dict["bias"];
+
+    if ( bias.isObject() ) {
+        normalization->bias[0] = bias["r"].asFloat();
+        normalization->bias[1] = bias["g"].asFloat();
+        normalization->bias[2] = bias["b"].asFloat();
+    }
+
+    return true;
+}
+
+// Mirrors TIODataDequantizerForDict
+
+bool ParseDequantization(const Json::Value &dict, Normalization *dequantization, std::string *error) {
+    *dequantization = Normalization();
+
+    if ( dict.isMember("standard") ) {
+        std::string standard = dict["standard"].asString();
+        if ( standard == "[0,1]" ) {
+            dequantization->scale = 1.0f/255.0f;
+        } else if ( standard == "[-1,1]" ) {
+            dequantization->scale = 2.0f/255.0f;
+            std::fill(dequantization->bias, dequantization->bias+3, -1.0f);
+        } else {
+            SetError(error, "Expected dequantize.standard to be '[0,1]' or '[-1,1]', found " + standard);
+            return false;
+        }
+        return true;
+    }
+
+    if ( dict.isMember("scale") && dict.isMember("bias") ) {
+        dequantization->scale = dict["scale"].asFloat();
+        std::fill(dequantization->bias, dequantization->bias+3, dict["bias"].asFloat());
+        return true;
+    }
+
+    SetError(error, "Expected dequantize to have a standard or scale and bias values");
+    return false;
+}
+
+bool ReadLabels(const std::string &path, std::vector<std::string> *labels, std::string *error) {
+    std::ifstream file(path);
+
+    if ( !file ) {
+        SetError(error, "Unable to read labels at " + path);
+        return false;
+    }
+
+    std::string line;
+
+    while ( std::getline(file, line) ) {
+        if ( !line.empty() && line.back() == '\r' ) {
+            line.pop_back();
+        }
+        labels->push_back(line);
+    }
+
+    // A trailing newline does not introduce a label
+
+    while ( !labels->empty() && labels->back().empty() ) {
+        labels->pop_back();
+    }
+
+    return true;
+}
+
+bool ParseLayer(const Json::Value &dict, const std::string &bundlePath, bool isInput, LayerDescription *layer, std::string *error) {
+    layer->name = dict["name"].asString();
+    layer->type = dict["type"].asString();
+
+    for ( const Json::Value &dimension : dict["shape"] ) {
+        layer->shape.push_back(dimension.asInt());
+    }
+
+    if ( layer->name.empty() || layer->type.empty() || layer->shape.empty() ) {
+        SetError(error, "Every layer requires a name, type and shape");
+        return false;
+    }
+
+    if ( layer->isImage() ) {
+        std::string format = dict["format"].asString();
+
+        if ( format == "RGB" ) {
+            layer->pixelFormat = LayerDescription::PixelFormat::RGB;
+        } else if ( format == "BGR" ) {
+            layer->pixelFormat = LayerDescription::PixelFormat::BGR;
+        } else {
+            SetError(error, "Expected format to be 'RGB' or 'BGR', found " + format + " for layer " + layer->name);
+            return false;
+        }
+
+        if ( layer->channels() != 3 ) {
+            SetError(error, "Image layer " + layer->name + " must have three channels");
+            return false;
+        }
+
+        return ParseNormalization(dict[isInput ? "normalize" : "denormalize"], &layer->normalization, error);
+    }
+
+    if ( dict.isMember("labels") ) {
+        std::string labelsPath = JoinPath(JoinPath(bundlePath, "assets"), dict["labels"].asString());
+        if ( !ReadLabels(labelsPath, &layer->labels, error) ) {
+            return false;
+        }
+    }
+
+    if ( !isInput && dict.isMember("dequantize") ) {
+        layer->dequantizes = true;
+        return ParseDequantization(dict["dequantize"], &layer->dequantization, error);
+    }
+
+    return true;
+}
+
+} // namespace
+
+// MARK: - LayerDescription
+
+int LayerDescription::width() const {
+    return shape.size() >= 3 ? shape[shape.size()-2] : 0;
+}
+
+int LayerDescription::height() const {
+    return shape.size() >= 3 ? shape[shape.size()-3] : 0;
+}
+
+int LayerDescription::channels() const {
+    return shape.empty() ? 0 : shape.back();
+}
+
+// MARK: - ModelBundle
+
+std::shared_ptr<ModelBundle> ModelBundle::Load(const std::string &path, std::string *error) {
+    std::shared_ptr<ModelBundle> bundle(new ModelBundle());
+    bundle->_path = path;
+
+    if ( !ReadJSONFile(JoinPath(path, "model.json"), &bundle->_info, error) ) {
+        return nullptr;
+    }
+
+    const Json::Value &info = bundle->_info;
+    const Json::Value &model = info["model"];
+
+    bundle->_identifier = info["id"].asString();
+    bundle->_name = info["name"].asString();
+    bundle->_version = info["version"].asString();
+    bundle->_type = model["type"].asString();
+    bundle->_backend = model.isMember("backend") ? model["backend"].asString() : "tflite";
+    bundle->_file = model["file"].asString();
+    bundle->_quantized = model["quantized"].asBool();
+    bundle->_outputFormat = info["options"]["output_format"].asString();
+
+    if ( bundle->_identifier.empty() || bundle->_file.empty() ) {
+        SetError(error, "Model bundle at " + path + " requires an id and a model.file");
+        return nullptr;
+    }
+
+    for ( const Json::Value &input : info["inputs"] ) {
+        LayerDescription layer;
+        if ( !ParseLayer(input, path, true, &layer, error) ) {
+            SetError(error, "Model bundle at " + path + ": " + (error ? *error : ""));
+            return nullptr;
+        }
+        bundle->_inputs.push_back(layer);
+    }
+
+    for ( const Json::Value &output : info["outputs"] ) {
+        LayerDescription layer;
+        if ( !ParseLayer(output, path, false, &layer, error) ) {
+            SetError(error, "Model bundle at " + path + ": " + (error ? *error : ""));
+            return nullptr;
+        }
+        bundle->_outputs.push_back(layer);
+    }
+
+    if ( bundle->_inputs.empty() || bundle->_outputs.empty() ) {
+        SetError(error, "Model bundle at " + path + " requires at least one input and one output");
+        return nullptr;
+    }
+
+    return bundle;
+}
+
+std::vector<std::shared_ptr<ModelBundle>> ModelBundle::LoadAll(const std::string &directory, std::string *error) {
+    std::vector<std::shared_ptr<ModelBundle>> bundles;
+    std::vector<std::string> names;
+
+    DIR *dir = opendir(directory.c_str());
+
+    if ( dir == nullptr ) {
+        SetError(error, "Unable to read models directory " + directory);
+        return bundles;
+    }
+
+    while ( struct dirent *entry = readdir(dir) ) {
+        std::string name = entry->d_name;
+        if ( HasSuffix(name, ".tiobundle") && IsDirectory(JoinPath(directory, name)) ) {
+            names.push_back(name);
+        }
+    }
+
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for ( const std::string &name : names ) {
+        std::string bundleError;
+        std::shared_ptr<ModelBundle> bundle = Load(JoinPath(directory, name), &bundleError);
+
+        if ( bundle == nullptr ) {
+            SetError(error, bundleError);
+            continue;
+        }
+
+        bundles.push_back(bundle);
+    }
+
+    return bundles;
+}
+
+std::string ModelBundle::modelFilePath() const {
+    return JoinPath(_path, _file);
+}
+
+// MARK: - Utilities
+
+bool ReadJSONFile(const std::string &path, Json::Value *value, std::string *error) {
+    std::ifstream file(path);
+
+    if ( !file ) {
+        SetError(error, "Unable to read " + path);
+        return false;
+    }
+
+    Json::CharReaderBuilder builder;
+    std::string parseErrors;
+
+    if ( !Json::parseFromStream(builder, file, value, &parseErrors) ) {
+        SetError(error, "Unable to parse " + path + ": " + parseErrors);
+        return false;
+    }
+
+    return true;
+}
+
+std::string JoinPath(const std::string &directory, const std::string &component) {
+    if ( directory.empty() ) {
+        return component;
+    }
+    if ( directory.back() == '/' ) {
+        return directory + component;
+    }
+    return directory + "/" + component;
+}
+
+} // namespace cli
+} // namespace netrunner
@@ -0,0 +1,162 @@
+//
+//  ModelBundle.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ModelBundle_h
+#define ModelBundle_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * An affine transform applied to each value, `value * scale + bias`, with a separate bias for
+ * each color channel. Describes both pixel normalization and output dequantization, which
+ * model.json expresses as a "standard" string or as explicit scale and bias values.
+ */
+
+struct Normalization {
+    float scale = 1;
+    float bias[3] = {0, 0, 0};
+
+    bool isIdentity() const {
+        return scale == 1 && bias[0] == 0 && bias[1] == 0 && bias[2] == 0;
+    }
+};
+
+/**
+ * A single input or output layer as described in model.json.
+ */
+
+struct LayerDescription {
+    std::string name;
+    std::string type;
+    std::vector<int> shape;
+
+    // Image layers
+
+    enum class PixelFormat { RGB, BGR };
+    PixelFormat pixelFormat = PixelFormat::RGB;
+    Normalization normalization;
+
+    // Array layers
+
+    std::vector<std::string> labels;
+    bool dequantizes = false;
+    Normalization dequantization;
+
+    bool isImage() const { return type == "image"; }
+
+    /**
+     * The width, height and channels of an image layer, ignoring any leading batch dimension.
+     */
+
+    int width() const;
+    int height() const;
+    int channels() const;
+};
+
+/**
+ * The portable parts of a TensorIO model bundle: a .tiobundle directory containing a model.json
+ * description, the model file and an assets directory with label files.
+ *
+ * Only the fields needed to run a model the way the app's `CVPixelBufferEvaluator` does are
+ * parsed. Parsing mirrors TIOModelJSONParsing.
+ */
+
+class ModelBundle {
+public:
+
+    /**
+     * Loads and validates the model.json in the bundle at path. Returns nullptr and sets error
+     * if the description is missing or invalid.
+     */
+
+    static std::shared_ptr<ModelBundle> Load(const std::string &path, std::string *error);
+
+    /**
+     * Finds every .tiobundle directly inside a directory.
+     */
+
+    static std::vector<std::shared_ptr<ModelBundle>> LoadAll(const std::string &directory, std::string *error);
+
+    const std::string &path() const { return _path; }
+    const std::string &identifier() const { return _identifier; }
+    const std::string &name() const { return _name; }
+    const std::string &version() const { return _version; }
+    const std::string &type() const { return _type; }
+    const std::string &outputFormat() const { return _outputFormat; }
+    const std::string &backend() const { return _backend; }
+    bool isQuantized() const { return _quantized; }
+
+    /**
+     * The full path to the model file, e.g. the .tflite file.
+     */
+
+    std::string modelFilePath() const;
+
+    const std::vector<LayerDescription> &inputs() const { return _inputs; }
+    const std::vector<LayerDescription> &outputs() const { return _outputs; }
+
+    /**
+     * The deserialized model.json.
+     */
+
+    const Json::Value &info() const { return _info; }
+
+private:
+    ModelBundle() = default;
+
+    std::string _path;
+    std::string _identifier;
+    std::string _name;
+    std::string _version;
+    std::string _type;
+    std::string _outputFormat;
+    std::string _backend;
+    std::string _file;
+    bool _quantized = false;
+
+    std::vector<LayerDescription> _inputs;
+    std::vector<LayerDescription> _outputs;
+
+    Json::Value _info;
+};
+
+/**
+ * Reads and parses a JSON file. Returns false and sets error on failure.
+ */
+
+bool ReadJSONFile(const std::string &path, Json::Value *value, std::string *error);
+
+/**
+ * Joins two path components with a single separator.
+ */
+
+std::string JoinPath(const std::string &directory, const std::string &component);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* ModelBundle_h */
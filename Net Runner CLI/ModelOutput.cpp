@@ -0,0 +1,250 @@
+//
+//  ModelOutput.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ModelOutput.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+const char * const kClassificationOutputKey = "classification";
+
+using ModelOutputTransform = std::function<Json::Value(const Json::Value&)>;
+
+// Mirrors -[NSDictionary topN:threshold:] from TensorIO
+
+Json::Value TopN(const Json::Value &dictionary, size_t count, float threshold) {
+    std::vector<std::pair<std::string, double>> entries;
+
+    for ( const std::string &key : dictionary.getMemberNames() ) {
+        double value = dictionary[key].asDouble();
+        if ( value > threshold ) {
+            entries.push_back({key, value});
+        }
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const std::pair<std::string, double> &a, const std::pair<std::string, double> &b) {
+        return a.second > b.second;
+    });
+
+    Json::Value top(Json::objectValue);
+
+    for ( size_t i = 0; i < entries.size() && i < count; i++ ) {
+        top[entries[i].first] = entries[i].second;
+    }
+
+    return top;
+}
+
+// Add model output types here, matching the classes registered with ModelOutputManager
+
+const std::map<std::string, ModelOutputTransform> &ModelOutputTransforms() {
+    static const std::map<std::string, ModelOutputTransform> transforms = {
+        {"image.classification.imagenet", [](const Json::Value &outputs) {
+            Json::Value value(Json::objectValue);
+            value[kClassificationOutputKey] = TopN(outputs[kClassificationOutputKey], 5, 0.1f);
+            return value;
+        }},
+        {"image.classification.nodecay", [](const Json::Value &outputs) {
+            Json::Value value(Json::objectValue);
+            value[kClassificationOutputKey] = outputs[kClassificationOutputKey];
+            return value;
+        }}
+    };
+    return transforms;
+}
+
+} // namespace
+
+Json::Value PackageOutputs(const ModelBundle &bundle, const std::vector<std::vector<float>> &outputs) {
+    Json::Value packaged(Json::objectValue);
+
+    for ( size_t i = 0; i < bundle.outputs().size() && i < outputs.size(); i++ ) {
+        const LayerDescription &layer = bundle.outputs()[i];
+        const std::vector<float> &values = outputs[i];
+
+        if ( !layer.labels.empty() ) {
+            Json::Value labeled(Json::objectValue);
+            for ( size_t j = 0; j < values.size() && j < layer.labels.size(); j++ ) {
+                labeled[layer.labels[j]] = values[j];
+            }
+            packaged[layer.name] = labeled;
+        } else {
+            Json::Value array(Json::arrayValue);
+            for ( float value : values ) {
+                array.append(value);
+            }
+            packaged[layer.name] = array;
+        }
+    }
+
+    return packaged;
+}
+
+Json::Value ModelOutputValue(const ModelBundle &bundle, const Json::Value &outputs) {
+    const std::map<std::string, ModelOutputTransform> &transforms = ModelOutputTransforms();
+
+    // Same order as CVPixelBufferEvaluator passes the types to ModelOutputManager
+
+    for ( const std::string &type : {bundle.type(), bundle.outputFormat()} ) {
+        auto transform = transforms.find(type);
+        if ( transform != transforms.end() ) {
+            return transform->second(outputs);
+        }
+    }
+
+    return outputs;
+}
+
+// MARK: - Post-Processing
+
+bool DeclaresPostProcessing(const ModelBundle &bundle) {
+    const Json::Value &options = bundle.info()["options"];
+    return options.isObject() && options.isMember("post_processing");
+}
+
+std::unique_ptr<PostProcessor> CompilePostProcessor(const ModelBundle &bundle, std::string *error) {
+    const Json::Value &declaration = bundle.info()["options"]["post_processing"];
+
+    if ( !declaration.isObject() || !declaration["stages"].isArray()
+        || !(declaration["scores"].isNull() || declaration["scores"].isString()) ) {
+        SetError(error, "Expected a list of stages and an optional scores layer name");
+        return nullptr;
+    }
+
+    std::vector<PostProcessor::Stage> stages;
+
+    for ( const Json::Value &stage : declaration["stages"] ) {
+        if ( !stage.isObject() || !stage["stage"].isString() ) {
+            SetError(error, "Each stage must be an object with a stage name");
+            return nullptr;
+        }
+
+        PostProcessor::Stage compiled;
+        compiled.name = stage["stage"].asString();
+
+        for ( const std::string &key : stage.getMemberNames() ) {
+            if ( stage[key].isNumeric() || stage[key].isBool() ) {
+                compiled.numbers[key] = stage[key].asDouble();
+            } else if ( stage[key].isString() ) {
+                compiled.strings[key] = stage[key].asString();
+            } else if ( stage[key].isArray() ) {
+                std::vector<float> &array = compiled.arrays[key];
+                for ( const Json::Value &number : stage[key] ) {
+                    array.push_back(number.isNumeric() ? number.asFloat() : NAN);
+                }
+            }
+        }
+
+        // Anchors may be listed inline or named as an asset
+
+        if ( stage["anchors"].isString() ) {
+            std::string path = JoinPath(JoinPath(bundle.path(), "assets"), stage["anchors"].asString());
+            if ( !ReadAnchors(path, &compiled.arrays["anchors"], error) ) {
+                return nullptr;
+            }
+        }
+
+        stages.push_back(compiled);
+    }
+
+    // Image layers have no values to process
+
+    std::vector<PostProcessor::Layer> layers;
+
+    for ( const LayerDescription &output : bundle.outputs() ) {
+        if ( output.isImage() ) {
+            layers.push_back({output.name, {0}, {}});
+        } else {
+            layers.push_back({output.name, output.shape, output.labels});
+        }
+    }
+
+    return PostProcessor::Compile(layers, declaration["scores"].asString(), stages, error);
+}
+
+bool PostProcessOutputs(const PostProcessor &processor, const std::vector<std::vector<float>> &outputs, Json::Value *value, std::string *error) {
+    std::vector<PostProcessor::Tensor> tensors;
+
+    for ( const std::vector<float> &output : outputs ) {
+        tensors.push_back({output.data(), output.size()});
+    }
+
+    PostProcessor::Result result;
+
+    if ( !processor.run(tensors, &result, error) ) {
+        return false;
+    }
+
+    auto Name = [&processor](uint32_t index) {
+        return processor.labeled() ? Json::Value(processor.labels()[index]) : Json::Value(index);
+    };
+
+    *value = Json::Value(Json::objectValue);
+
+    if ( processor.detects() ) {
+        Json::Value detections(Json::arrayValue);
+
+        for ( const PostProcessor::Detection &detection : result.detections ) {
+            Json::Value entry(Json::objectValue);
+            entry["class"] = Name(detection.index);
+            entry["score"] = detection.score;
+            entry["box"] = Json::Value(Json::arrayValue);
+            for ( float coordinate : detection.box ) {
+                entry["box"].append(coordinate);
+            }
+            detections.append(entry);
+        }
+
+        (*value)["detections"] = detections;
+        return true;
+    }
+
+    Json::Value classifications(processor.labeled() ? Json::objectValue : Json::arrayValue);
+
+    for ( const PostProcessor::Classification &classification : result.classifications ) {
+        if ( processor.labeled() ) {
+            classifications[processor.labels()[classification.index]] = classification.score;
+        } else {
+            Json::Value entry(Json::objectValue);
+            entry["index"] = classification.index;
+            entry["score"] = classification.score;
+            classifications.append(entry);
+        }
+    }
+
+    (*value)[processor.scoresLayer().name] = classifications;
+    return true;
+}
+
+} // namespace cli
+} // namespace netrunner
@@ -0,0 +1,78 @@
+//
+//  ModelOutput.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ModelOutput_h
+#define ModelOutput_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "ModelBundle.h"
+#include "PostProcessor.h"
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * Packages a model's raw outputs the way `TIOTFLiteModel` does: one entry per output layer keyed
+ * by name, with labeled outputs as dictionaries from label to value and unlabeled outputs as
+ * arrays.
+ */
+
+Json::Value PackageOutputs(const ModelBundle &bundle, const std::vector<std::vector<float>> &outputs);
+
+/**
+ * Converts packaged outputs into the value of the app's `ModelOutput` class for the bundle, as
+ * chosen by `ModelOutputManager` from the model's type and output format. For example the
+ * "image.classification.imagenet" type keeps the top five classifications above 0.1. Outputs
+ * of unknown types are returned unchanged, like `DefaultModelOutput`.
+ */
+
+Json::Value ModelOutputValue(const ModelBundle &bundle, const Json::Value &outputs);
+
+/**
+ * Whether the bundle declares post-processing in the options.post_processing field of its
+ * model.json, in which case its outputs are processed rather than transformed by type.
+ */
+
+bool DeclaresPostProcessing(const ModelBundle &bundle);
+
+/**
+ * Compiles the bundle's post-processing declaration against its output layers, like
+ * `ModelPostProcessor`. Returns nullptr and sets error if the declaration is invalid.
+ */
+
+std::unique_ptr<PostProcessor> CompilePostProcessor(const ModelBundle &bundle, std::string *error);
+
+/**
+ * Runs a compiled post-processor on a model's raw outputs and packages the result the way
+ * `ModelPostProcessor` does. Returns false and sets error if the outputs do not match the
+ * model's output layers.
+ */
+
+bool PostProcessOutputs(const PostProcessor &processor, const std::vector<std::vector<float>> &outputs, Json::Value *value, std::string *error);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* ModelOutput_h */
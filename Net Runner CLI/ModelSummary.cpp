@@ -0,0 +1,616 @@
+//
+//  ModelSummary.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ModelSummary.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+// Summary keys, matching EvaluatorConstants and EvaluationSummaryAccumulator
+
+const char * const kEvaluatorResultsKeyModel = "model";
+const char * const kEvaluatorResultsKeyPreprocessingLatency = "preprocessor_latency";
+const char * const kEvaluatorResultsKeyInferenceLatency = "inference_latency";
+const char * const kEvaluatorResultsKeyConcurrentModels = "concurrent_models";
+const char * const kEvaluatorResultsKeyMemory = "process_memory";
+const char * const kEvaluatorResultsKeyMemoryModelLoad = "model_load";
+const char * const kEvaluatorResultsKeyMemoryArena = "arena";
+const char * const kEvaluatorResultsKeyMemoryPreprocessingFootprint = "preprocessing_footprint";
+const char * const kEvaluatorResultsKeyMemoryInferenceFootprint = "inference_footprint";
+const char * const kSummaryKeyTotalLatency = "total_latency";
+const char * const kSummaryKeyBenchmark = "benchmark";
+const char * const kSummaryKeyTestBundle = "test_bundle";
+const char * const kSummaryKeyHistogram = "histogram";
+const char * const kSummaryKeyAccuracyCounts = "accuracy_counts";
+const char * const kClassificationOutputKey = "classification";
+
+// Partial summary keys, matching EvaluationSummaryAccumulator's partialSummary
+
+const char * const kPartialKeyShard = "shard";
+const char * const kPartialKeyShards = "shards";
+const char * const kPartialKeyModels = "models";
+const char * const kPartialKeyMetric = "metric";
+const char * const kPartialKeyClassificationMetrics = "metrics";
+const char * const kPartialKeyClasses = "classes";
+const char * const kPartialKeyEvaluations = "evaluations";
+const char * const kPartialKeyErrors = "errors";
+const char * const kPartialKeyMetricState = "metric_state";
+const char * const kPartialKeyClassificationStates = "classification_metrics";
+
+// MARK: - States
+
+// Non-zero counters are written as [index, value] pairs, since confusion matrices and average
+// precision histograms are mostly empty
+
+Json::Value SparseCounters(const std::vector<uint64_t> &counters) {
+    Json::Value pairs(Json::arrayValue);
+
+    for ( size_t i = 0; i < counters.size(); i++ ) {
+        if ( counters[i] != 0 ) {
+            Json::Value pair(Json::arrayValue);
+            pair.append(static_cast<Json::UInt64>(i));
+            pair.append(static_cast<Json::UInt64>(counters[i]));
+            pairs.append(pair);
+        }
+    }
+
+    return pairs;
+}
+
+bool ReadPair(const Json::Value &pair, uint64_t *index, uint64_t *value) {
+    if ( !pair.isArray() || pair.size() != 2 || !pair[0].isUInt64() || !pair[1].isUInt64() ) {
+        return false;
+    }
+
+    *index = pair[0].asUInt64();
+    *value = pair[1].asUInt64();
+
+    return true;
+}
+
+Json::Value HistogramState(const LatencyHistogram &histogram) {
+    LatencyHistogram::State state = histogram.state();
+    Json::Value dictionary(Json::objectValue);
+    Json::Value buckets(Json::arrayValue);
+
+    for ( const auto &bucket : state.buckets ) {
+        Json::Value pair(Json::arrayValue);
+        pair.append(bucket.first);
+        pair.append(static_cast<Json::UInt64>(bucket.second));
+        buckets.append(pair);
+    }
+
+    dictionary["min"] = static_cast<Json::UInt64>(state.minMicros);
+    dictionary["max"] = static_cast<Json::UInt64>(state.maxMicros);
+    dictionary["sum"] = state.sum;
+    dictionary["sum_of_squares"] = state.sumOfSquares;
+    dictionary["buckets"] = buckets;
+
+    return dictionary;
+}
+
+// The histogram state lets a later run's latencies be tested against these, see RegressionGate.h
+
+Json::Value LatencyDictionary(const LatencyHistogram &histogram) {
+    LatencyHistogram::Summary summary = histogram.summary();
+    Json::Value dictionary(Json::objectValue);
+
+    dictionary["count"] = static_cast<Json::UInt64>(summary.count);
+    dictionary["mean"] = summary.mean;
+    dictionary["stddev"] = summary.stddev;
+    dictionary["min"] = summary.min;
+    dictionary["p50"] = summary.p50;
+    dictionary["p90"] = summary.p90;
+    dictionary["p99"] = summary.p99;
+    dictionary["max"] = summary.max;
+    dictionary[kSummaryKeyHistogram] = HistogramState(histogram);
+
+    return dictionary;
+}
+
+bool MergeHistogramState(const Json::Value &dictionary, LatencyHistogram &histogram) {
+    if ( !dictionary.isObject() || !dictionary["buckets"].isArray() ) {
+        return false;
+    }
+
+    LatencyHistogram::State state;
+    state.minMicros = dictionary.get("min", 0).asUInt64();
+    state.maxMicros = dictionary.get("max", 0).asUInt64();
+    state.sum = dictionary.get("sum", 0).asDouble();
+    state.sumOfSquares = dictionary.get("sum_of_squares", 0).asDouble();
+
+    for ( const Json::Value &pair : dictionary["buckets"] ) {
+        uint64_t index, count;
+        if ( !ReadPair(pair, &index, &count) || index >= LatencyHistogram::kBucketCount ) {
+            return false;
+        }
+        state.buckets.push_back({static_cast<uint32_t>(index), count});
+    }
+
+    return histogram.merge(state);
+}
+
+Json::Value MetricStateDictionary(const metrics::MetricState &state) {
+    Json::Value dictionary(Json::objectValue);
+    Json::Value reals(Json::arrayValue);
+
+    for ( double real : state.reals ) {
+        reals.append(real);
+    }
+
+    dictionary["count"] = static_cast<Json::UInt64>(state.count);
+    dictionary["size"] = static_cast<Json::UInt64>(state.counters.size());
+    dictionary["counters"] = SparseCounters(state.counters);
+    dictionary["reals"] = reals;
+
+    return dictionary;
+}
+
+bool ReadMetricState(const Json::Value &dictionary, metrics::MetricState *state) {
+    if ( !dictionary.isObject() || !dictionary["size"].isUInt64() || !dictionary["counters"].isArray() || !dictionary["reals"].isArray() ) {
+        return false;
+    }
+
+    state->count = dictionary.get("count", 0).asUInt64();
+    state->counters.assign(dictionary["size"].asUInt64(), 0);
+
+    for ( const Json::Value &pair : dictionary["counters"] ) {
+        uint64_t index, value;
+        if ( !ReadPair(pair, &index, &value) || index >= state->counters.size() ) {
+            return false;
+        }
+        state->counters[index] = value;
+    }
+
+    for ( const Json::Value &real : dictionary["reals"] ) {
+        state->reals.push_back(real.asDouble());
+    }
+
+    return true;
+}
+
+std::vector<std::string> StringArray(const Json::Value &array) {
+    std::vector<std::string> strings;
+
+    if ( array.isArray() ) {
+        for ( const Json::Value &string : array ) {
+            strings.push_back(string.asString());
+        }
+    }
+
+    return strings;
+}
+
+// MARK: - Classification Metrics
+
+// Matches EvaluationSummaryAccumulator: scalar values at the top level, per-class values keyed
+// by class name with undefined values omitted, and the non-zero confusion matrix cells
+
+void AppendMetricReport(const metrics::MetricReport &report, const std::vector<std::string> &classes, Json::Value *summary) {
+    for ( const auto &value : report.values ) {
+        (*summary)[value.first] = std::isnan(value.second) ? Json::Value::null : Json::Value(value.second);
+    }
+
+    for ( const auto &values : report.perClass ) {
+        Json::Value dictionary(Json::objectValue);
+
+        for ( size_t c = 0; c < values.second.size(); c++ ) {
+            if ( !std::isnan(values.second[c]) ) {
+                dictionary[classes[c]] = values.second[c];
+            }
+        }
+
+        (*summary)[values.first] = dictionary;
+    }
+
+    if ( !report.confusion.empty() ) {
+        Json::Value matrix(Json::arrayValue);
+
+        for ( const metrics::ConfusionEntry &entry : report.confusion ) {
+            Json::Value cell(Json::arrayValue);
+            cell.append(classes[entry.label]);
+            cell.append(classes[entry.predicted]);
+            cell.append(static_cast<Json::UInt64>(entry.count));
+            matrix.append(cell);
+        }
+
+        (*summary)["confusion_matrix"] = matrix;
+    }
+
+    for ( const metrics::AccuracyCount &accuracy : report.accuracies ) {
+        Json::Value counts(Json::objectValue);
+        counts["correct"] = static_cast<Json::UInt64>(accuracy.correct);
+        counts["count"] = static_cast<Json::UInt64>(accuracy.count);
+        (*summary)[kSummaryKeyAccuracyCounts][accuracy.name] = counts;
+    }
+}
+
+} // namespace
+
+ModelSummary::ModelSummary(const std::string &modelID, unsigned warmup, const std::string &metricName, const std::vector<std::string> &classificationMetrics, const std::vector<std::string> &classes, std::vector<std::string> *unknown)
+    : _modelID(modelID), _metricName(metricName), _metric(EvaluationMetricForName(metricName)),
+      _preprocessing(warmup), _inference(warmup), _total(warmup), _memory(Json::objectValue) {
+
+    if ( _metric != nullptr ) {
+        _metricAccumulator = _metric->accumulator();
+    }
+
+    if ( classificationMetrics.empty() || classes.empty() ) {
+        return;
+    }
+
+    _classes = classes;
+    _classificationMetrics.reset(new metrics::ClassificationMetricSet(classes.size(), classificationMetrics, unknown));
+
+    for ( size_t c = 0; c < classes.size(); c++ ) {
+        _classIndexes[classes[c]] = static_cast<int32_t>(c);
+    }
+}
+
+// Scatters the classification output into a dense row of scores. Classes the model output
+// omitted, such as those below an ImageNet output's threshold, score zero.
+
+void ModelSummary::add(const Json::Value &y, double preprocessingLatency, double inferenceLatency, const Json::Value &value) {
+    _preprocessing.record(preprocessingLatency);
+    _inference.record(inferenceLatency);
+    _total.record(preprocessingLatency + inferenceLatency);
+    _evaluations += 1;
+
+    if ( _metric != nullptr ) {
+        _metricAccumulator->add(_metric->evaluate(y, value));
+    }
+
+    if ( _classificationMetrics == nullptr ) {
+        return;
+    }
+
+    const Json::Value &expected = y[kClassificationOutputKey];
+    const Json::Value &classifications = value[kClassificationOutputKey];
+
+    int32_t label = -1;
+
+    if ( expected.isObject() && !expected.empty() ) {
+        auto entry = _classIndexes.find(expected.getMemberNames().front());
+        label = entry != _classIndexes.end() ? entry->second : -1;
+    }
+
+    _scores.assign(_classes.size(), 0.0f);
+
+    if ( classifications.isObject() ) {
+        for ( const std::string &name : classifications.getMemberNames() ) {
+            auto entry = _classIndexes.find(name);
+            if ( entry != _classIndexes.end() ) {
+                _scores[entry->second] = classifications[name].asFloat();
+            }
+        }
+    }
+
+    _classificationMetrics->add(label, _scores.data());
+}
+
+// Matches EvaluationSummaryAccumulator: the most recent load measurements and the largest footprints
+
+void ModelSummary::addMemory(const Json::Value &memory) {
+    for ( const char *key : {kEvaluatorResultsKeyMemoryModelLoad, kEvaluatorResultsKeyMemoryArena} ) {
+        if ( memory.isMember(key) ) {
+            _memory[key] = memory[key];
+        }
+    }
+
+    for ( const char *footprint : {kEvaluatorResultsKeyMemoryPreprocessingFootprint, kEvaluatorResultsKeyMemoryInferenceFootprint} ) {
+        if ( memory.isMember(footprint) && memory[footprint].asUInt64() > _memory.get(footprint, 0).asUInt64() ) {
+            _memory[footprint] = memory[footprint];
+        }
+    }
+}
+
+Json::Value ModelSummary::summary() {
+    Json::Value summary(Json::objectValue);
+
+    summary[kEvaluatorResultsKeyModel] = _modelID;
+    summary["latency"] = _inference.mean();
+    summary[kEvaluatorResultsKeyPreprocessingLatency] = LatencyDictionary(_preprocessing);
+    summary[kEvaluatorResultsKeyInferenceLatency] = LatencyDictionary(_inference);
+    summary[kSummaryKeyTotalLatency] = LatencyDictionary(_total);
+    summary[kEvaluatorResultsKeyConcurrentModels] = _concurrentModels;
+    summary[kEvaluatorResultsKeyMemory] = _memory;
+
+    // A metric value that is 0 or 1 for every evaluation is an accuracy, and its counts are
+    // reported alongside it, as they are for the classification metrics' accuracies
+
+    if ( _metric != nullptr && _evaluations > 0 ) {
+        Json::Value reduced = _metricAccumulator->reduce();
+        Json::Value counts = _metricAccumulator->accuracyCounts();
+        for ( const std::string &name : reduced.getMemberNames() ) {
+            summary[name] = reduced[name];
+        }
+        for ( const std::string &name : counts.getMemberNames() ) {
+            summary[kSummaryKeyAccuracyCounts][name] = counts[name];
+        }
+    }
+
+    if ( _classificationMetrics != nullptr ) {
+        AppendMetricReport(_classificationMetrics->report(), _classes, &summary);
+    }
+
+    if ( !_benchmark.isNull() ) {
+        summary[kSummaryKeyBenchmark] = _benchmark;
+    }
+
+    return summary;
+}
+
+// MARK: - Partial Summaries
+
+Json::Value ModelSummary::partial() {
+    Json::Value partial(Json::objectValue);
+
+    partial[kEvaluatorResultsKeyModel] = _modelID;
+    partial[kPartialKeyMetric] = _metricName;
+    partial[kPartialKeyEvaluations] = static_cast<Json::UInt64>(_evaluations);
+    partial[kPartialKeyErrors] = static_cast<Json::UInt64>(_errors);
+    partial[kEvaluatorResultsKeyConcurrentModels] = _concurrentModels;
+    partial[kEvaluatorResultsKeyMemory] = _memory;
+    partial[kEvaluatorResultsKeyPreprocessingLatency] = HistogramState(_preprocessing);
+    partial[kEvaluatorResultsKeyInferenceLatency] = HistogramState(_inference);
+    partial[kSummaryKeyTotalLatency] = HistogramState(_total);
+
+    if ( _metricAccumulator != nullptr ) {
+        partial[kPartialKeyMetricState] = _metricAccumulator->state();
+    }
+
+    if ( _classificationMetrics != nullptr ) {
+        Json::Value names(Json::arrayValue);
+        Json::Value classes(Json::arrayValue);
+        Json::Value states(Json::arrayValue);
+
+        for ( const std::string &name : _classificationMetrics->names() ) {
+            names.append(name);
+        }
+        for ( const std::string &name : _classes ) {
+            classes.append(name);
+        }
+        for ( const metrics::MetricState &state : _classificationMetrics->states() ) {
+            states.append(MetricStateDictionary(state));
+        }
+
+        partial[kPartialKeyClassificationMetrics] = names;
+        partial[kPartialKeyClasses] = classes;
+        partial[kPartialKeyClassificationStates] = states;
+    }
+
+    if ( !_benchmark.isNull() ) {
+        partial[kSummaryKeyBenchmark] = _benchmark;
+    }
+
+    return partial;
+}
+
+std::unique_ptr<ModelSummary> ModelSummary::ForPartial(const Json::Value &partial, std::string *error) {
+    if ( !partial.isObject() || !partial[kEvaluatorResultsKeyModel].isString() ) {
+        SetError(error, "Partial summary is missing its model");
+        return nullptr;
+    }
+
+    std::vector<std::string> unknown;
+    std::unique_ptr<ModelSummary> summary(new ModelSummary(
+        partial[kEvaluatorResultsKeyModel].asString(),
+        0,
+        partial.get(kPartialKeyMetric, "").asString(),
+        StringArray(partial[kPartialKeyClassificationMetrics]),
+        StringArray(partial[kPartialKeyClasses]),
+        &unknown));
+
+    if ( !unknown.empty() ) {
+        SetError(error, "Partial summary for model " + summary->_modelID + " has an unknown classification metric " + unknown.front());
+        return nullptr;
+    }
+
+    return summary;
+}
+
+bool ModelSummary::merge(const Json::Value &partial, std::string *error) {
+    const std::string description = "Partial summary for model " + _modelID;
+
+    if ( !partial.isObject() || partial.get(kEvaluatorResultsKeyModel, "").asString() != _modelID ) {
+        SetError(error, description + " is for a different model");
+        return false;
+    }
+
+    if ( partial.get(kPartialKeyMetric, "").asString() != _metricName
+        || StringArray(partial[kPartialKeyClasses]) != _classes
+        || (_classificationMetrics != nullptr && StringArray(partial[kPartialKeyClassificationMetrics]) != _classificationMetrics->names()) ) {
+        SetError(error, description + " was computed with different metrics or classes");
+        return false;
+    }
+
+    // Check everything that can fail before anything is merged
+
+    std::vector<metrics::MetricState> states;
+
+    if ( _classificationMetrics != nullptr ) {
+        if ( !partial[kPartialKeyClassificationStates].isArray() ) {
+            SetError(error, description + " is missing its classification metrics");
+            return false;
+        }
+        for ( const Json::Value &dictionary : partial[kPartialKeyClassificationStates] ) {
+            metrics::MetricState state;
+            if ( !ReadMetricState(dictionary, &state) ) {
+                SetError(error, description + " has a malformed classification metric");
+                return false;
+            }
+            states.push_back(state);
+        }
+    }
+
+    std::unique_ptr<MetricAccumulator> metricState;
+
+    if ( _metric != nullptr ) {
+        metricState = _metric->accumulator();
+        if ( !metricState->merge(partial[kPartialKeyMetricState]) ) {
+            SetError(error, description + " is missing its metric state or it is malformed");
+            return false;
+        }
+    }
+
+    LatencyHistogram preprocessing, inference, total;
+
+    if ( !MergeHistogramState(partial[kEvaluatorResultsKeyPreprocessingLatency], preprocessing)
+        || !MergeHistogramState(partial[kEvaluatorResultsKeyInferenceLatency], inference)
+        || !MergeHistogramState(partial[kSummaryKeyTotalLatency], total) ) {
+        SetError(error, description + " has a malformed latency histogram");
+        return false;
+    }
+
+    if ( _classificationMetrics != nullptr && !_classificationMetrics->mergeStates(states) ) {
+        SetError(error, description + " has classification metrics that do not match");
+        return false;
+    }
+
+    _preprocessing.merge(preprocessing);
+    _inference.merge(inference);
+    _total.merge(total);
+
+    if ( metricState != nullptr ) {
+        _metricAccumulator->merge(metricState->state());
+    }
+
+    // Shards load the model separately, keep the largest of every measurement
+
+    const Json::Value &memory = partial[kEvaluatorResultsKeyMemory];
+
+    if ( memory.isObject() ) {
+        for ( const std::string &key : memory.getMemberNames() ) {
+            if ( !_memory.isMember(key) || memory[key].asDouble() > _memory[key].asDouble() ) {
+                _memory[key] = memory[key];
+            }
+        }
+    }
+
+    _concurrentModels = std::max(_concurrentModels, partial.get(kEvaluatorResultsKeyConcurrentModels, 1).asUInt());
+
+    if ( partial.isMember(kSummaryKeyBenchmark) ) {
+        _benchmark = partial[kSummaryKeyBenchmark];
+    }
+
+    _evaluations += partial.get(kPartialKeyEvaluations, 0).asUInt64();
+    _errors += partial.get(kPartialKeyErrors, 0).asUInt64();
+
+    return true;
+}
+
+// MARK: - Merging
+
+bool MergePartialSummaries(const std::vector<Json::Value> &partials, Json::Value *summary, std::string *error) {
+
+    // Group by test bundle, in order of appearance, and index each bundle's shards
+
+    std::vector<std::string> testBundles;
+    std::map<std::string, std::map<uint32_t, const Json::Value*>> shards;
+    std::map<std::string, uint32_t> counts;
+
+    for ( const Json::Value &partial : partials ) {
+        if ( !partial.isObject() || !partial[kSummaryKeyTestBundle].isString() || !partial[kPartialKeyShard].isUInt()
+            || !partial[kPartialKeyShards].isUInt() || !partial[kPartialKeyModels].isArray() ) {
+            SetError(error, "Not a partial summary, expected a test bundle, shard, shards and models");
+            return false;
+        }
+
+        const std::string testBundleID = partial[kSummaryKeyTestBundle].asString();
+        const uint32_t shard = partial[kPartialKeyShard].asUInt();
+        const uint32_t count = partial[kPartialKeyShards].asUInt();
+
+        if ( counts.find(testBundleID) == counts.end() ) {
+            testBundles.push_back(testBundleID);
+            counts[testBundleID] = count;
+        }
+
+        if ( counts[testBundleID] != count || shard == 0 || shard > count ) {
+            SetError(error, "Test Bundle " + testBundleID + ": Shard " + std::to_string(shard) + "/" + std::to_string(count) + " does not match the bundle's other " + std::to_string(counts[testBundleID]) + " shards");
+            return false;
+        }
+
+        if ( !shards[testBundleID].insert({shard, &partial}).second ) {
+            SetError(error, "Test Bundle " + testBundleID + ": Shard " + std::to_string(shard) + "/" + std::to_string(count) + " appears more than once");
+            return false;
+        }
+    }
+
+    *summary = Json::Value(Json::arrayValue);
+
+    for ( const std::string &testBundleID : testBundles ) {
+        if ( shards[testBundleID].size() != counts[testBundleID] ) {
+            SetError(error, "Test Bundle " + testBundleID + ": Found " + std::to_string(shards[testBundleID].size()) + " of " + std::to_string(counts[testBundleID]) + " shards");
+            return false;
+        }
+
+        // Models in order of first appearance, shards in order
+
+        std::vector<std::unique_ptr<ModelSummary>> models;
+
+        for ( const auto &shard : shards[testBundleID] ) {
+            for ( const Json::Value &partial : (*shard.second)[kPartialKeyModels] ) {
+                const std::string modelID = partial.get(kEvaluatorResultsKeyModel, "").asString();
+
+                auto model = std::find_if(models.begin(), models.end(), [&](const std::unique_ptr<ModelSummary> &candidate) {
+                    return candidate->modelID() == modelID;
+                });
+
+                if ( model == models.end() ) {
+                    std::unique_ptr<ModelSummary> created = ModelSummary::ForPartial(partial, error);
+                    if ( created == nullptr ) {
+                        return false;
+                    }
+                    models.push_back(std::move(created));
+                    model = models.end() - 1;
+                }
+
+                std::string mergeError;
+                if ( !(*model)->merge(partial, &mergeError) ) {
+                    SetError(error, "Test Bundle " + testBundleID + ": " + mergeError);
+                    return false;
+                }
+            }
+        }
+
+        for ( const std::unique_ptr<ModelSummary> &model : models ) {
+            Json::Value modelSummary = model->summary();
+            modelSummary[kSummaryKeyTestBundle] = testBundleID;
+            summary->append(modelSummary);
+        }
+    }
+
+    return true;
+}
+
+} // namespace cli
+} // namespace netrunner
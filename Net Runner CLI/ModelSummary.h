@@ -0,0 +1,172 @@
+//
+//  ModelSummary.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ModelSummary_h
+#define ModelSummary_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <json/json.h>
+
+#include "ClassificationMetrics.h"
+#include "EvaluationMetric.h"
+#include "LatencyHistogram.h"
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * Accumulates the summary of a single model's evaluations, with the same entries as the app's
+ * `EvaluationSummaryAccumulator`.
+ *
+ * A summary keeps the metric's running state rather than each evaluation's metric values. It
+ * may also be exported as a partial summary, which keeps the latency histograms, metric state
+ * and classification metric counters rather than the statistics computed from them. Partial summaries of the shards of a test bundle, run in separate processes or on
+ * separate devices, merge into the summary a single run would have produced, see
+ * EvaluationShard.h and `MergePartialSummaries`.
+ *
+ * Each shard discards its own warm-up evaluations, since each process loads its models cold.
+ */
+
+class ModelSummary {
+public:
+
+    /**
+     * @param modelID The identifier of the model.
+     * @param warmup The number of initial evaluations excluded from the latency statistics.
+     * @param metricName The name of the test bundle's metric, may be empty.
+     * @param classificationMetrics The names of the classification metrics, may be empty.
+     * @param classes The model's class vocabulary. Classification metrics are skipped if empty.
+     * @param unknown Appended with any unknown classification metrics, may be nullptr.
+     */
+
+    ModelSummary(const std::string &modelID, unsigned warmup, const std::string &metricName, const std::vector<std::string> &classificationMetrics, const std::vector<std::string> &classes, std::vector<std::string> *unknown = nullptr);
+
+    ModelSummary(const ModelSummary&) = delete;
+    ModelSummary& operator=(const ModelSummary&) = delete;
+
+    const std::string &modelID() const { return _modelID; }
+
+    const LatencyHistogram &inferenceLatencies() const { return _inference; }
+
+    /**
+     * Folds a successful evaluation into the summary.
+     *
+     * @param y The expected output, null if the image is unlabeled.
+     * @param value The model's output.
+     */
+
+    void add(const Json::Value &y, double preprocessingLatency, double inferenceLatency, const Json::Value &value);
+
+    /**
+     * Counts a failed evaluation.
+     */
+
+    void addError() { _errors += 1; }
+
+    /**
+     * Folds memory measurements into the summary. Load and arena sizes replace earlier ones and
+     * the largest footprints are kept.
+     */
+
+    void addMemory(const Json::Value &memory);
+
+    /**
+     * Attaches a steady state benchmark's results, which are reported as they are.
+     */
+
+    void setBenchmark(const Json::Value &benchmark) { _benchmark = benchmark; }
+
+    /**
+     * The model's summary.
+     */
+
+    Json::Value summary();
+
+    /**
+     * The model's partial summary, which `merge` folds into another summary of the same model.
+     */
+
+    Json::Value partial();
+
+    /**
+     * Creates an empty summary for the model and metrics described by a partial summary, into
+     * which it and the model's other partial summaries may be merged. Returns nullptr and sets
+     * error if the partial summary is malformed.
+     */
+
+    static std::unique_ptr<ModelSummary> ForPartial(const Json::Value &partial, std::string *error);
+
+    /**
+     * Merges a partial summary of the same model and metrics. Histograms, counters and metric
+     * states are added, and the largest memory measurements are kept. Returns false
+     * and sets error if the partial summary is malformed or its metrics do not match.
+     */
+
+    bool merge(const Json::Value &partial, std::string *error);
+
+private:
+    const std::string _modelID;
+    const std::string _metricName;
+    const std::unique_ptr<EvaluationMetric> _metric;
+
+    LatencyHistogram _preprocessing;
+    LatencyHistogram _inference;
+    LatencyHistogram _total;
+
+    std::unique_ptr<MetricAccumulator> _metricAccumulator;
+    Json::Value _memory;
+    Json::Value _benchmark;
+    uint64_t _evaluations = 0;
+    uint64_t _errors = 0;
+    unsigned _concurrentModels = 1;
+
+    // Classification metrics consume dense columns of class indexes and scores
+
+    std::vector<std::string> _classes;
+    std::unordered_map<std::string, int32_t> _classIndexes;
+    std::unique_ptr<metrics::ClassificationMetricSet> _classificationMetrics;
+    std::vector<float> _scores;
+};
+
+/**
+ * Merges the partial summaries written by the shards of one or more test bundles. Partial
+ * summaries are grouped by test bundle, in the order each bundle first appears, and merged in
+ * shard order, so the result does not depend on the order in which shards finished. Returns one
+ * dictionary per model, as a single run's summary does.
+ *
+ * Counts and metrics match those of a single run over the same evaluations, and latency
+ * statistics are those of every shard's measurements together. Sums of floating point values
+ * may differ from a single run's in their last bits, since they are added in a different order.
+ *
+ * Returns false and sets error if a partial summary is malformed, or if a test bundle's shards
+ * disagree on their count, are duplicated or are missing.
+ */
+
+bool MergePartialSummaries(const std::vector<Json::Value> &partials, Json::Value *summary, std::string *error);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* ModelSummary_h */
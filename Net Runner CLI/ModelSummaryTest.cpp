@@ -0,0 +1,239 @@
+//
+//  ModelSummaryTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks that model summaries keep mergeable metric states rather than each evaluation's metric
+// values, and that merging the partial summaries of a test bundle's shards reproduces the metric
+// values and accuracy counts of a single run, for classification and detection metrics alike.
+//
+// usage: net-runner-model-summary-test
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "ModelSummary.h"
+
+using namespace netrunner::cli;
+
+namespace {
+
+const unsigned kEvaluations = 300;
+const unsigned kShards = 3;
+const char * const kClasses[] = {"cat", "dog", "bird", "fish", "frog", "horse", "mouse", "owl"};
+
+struct Evaluation {
+    Json::Value y;
+    Json::Value yhat;
+};
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+Json::Value Box(const char *label, double score, double ymin, double xmin) {
+    Json::Value box(Json::arrayValue);
+    box.append(ymin);
+    box.append(xmin);
+    box.append(ymin + 0.2);
+    box.append(xmin + 0.2);
+
+    Json::Value detection(Json::objectValue);
+    detection["class"] = label;
+    detection["score"] = score;
+    detection["box"] = box;
+    return detection;
+}
+
+// Classifications score every class, so that the label is in the top five about 5/8ths of the
+// time. Detections find each ground truth box, miss it or land beside it, with scores in steps of
+// 1/20th so that ties occur.
+
+std::vector<Evaluation> Evaluations(unsigned count) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> classes(0, 7);
+    std::uniform_int_distribution<int> steps(1, 20);
+    std::uniform_real_distribution<double> unit(0, 1);
+    std::vector<Evaluation> evaluations;
+
+    for ( unsigned i = 0; i < count; i++ ) {
+        Evaluation evaluation;
+        const char *label = kClasses[classes(generator)];
+
+        evaluation.y["classification"][label] = 1;
+        for ( const char *name : kClasses ) {
+            evaluation.yhat["classification"][name] = unit(generator);
+        }
+
+        evaluation.y["detections"] = Json::Value(Json::arrayValue);
+        evaluation.yhat["detections"] = Json::Value(Json::arrayValue);
+
+        for ( int box = 0; box < 3; box++ ) {
+            const char *truth = kClasses[classes(generator)];
+            const double ymin = 0.3 * box;
+            const double outcome = unit(generator);
+
+            evaluation.y["detections"].append(Box(truth, 0, ymin, 0.1));
+
+            if ( outcome < 0.6 ) {
+                evaluation.yhat["detections"].append(Box(truth, steps(generator) / 20.0, ymin, 0.1));
+            } else if ( outcome < 0.8 ) {
+                evaluation.yhat["detections"].append(Box(truth, steps(generator) / 20.0, ymin, 0.6));
+            }
+        }
+
+        evaluations.push_back(evaluation);
+    }
+
+    return evaluations;
+}
+
+Json::Value ShardPartial(const std::string &metric, const std::vector<Evaluation> &evaluations, unsigned shard) {
+    ModelSummary summary("model", 0, metric, {}, {});
+
+    for ( size_t i = 0; i < evaluations.size(); i++ ) {
+        if ( i % kShards == shard - 1 ) {
+            summary.add(evaluations[i].y, 1.0, 10.0 + i % 7, evaluations[i].yhat);
+        }
+    }
+
+    Json::Value partial(Json::objectValue);
+    partial["test_bundle"] = "bundle";
+    partial["shard"] = shard;
+    partial["shards"] = kShards;
+    partial["models"].append(summary.partial());
+    return partial;
+}
+
+bool CheckMetric(const std::string &metric, const std::string &value, bool accuracy) {
+    std::vector<Evaluation> evaluations = Evaluations(kEvaluations);
+    ModelSummary single("model", 0, metric, {}, {});
+
+    for ( size_t i = 0; i < evaluations.size(); i++ ) {
+        single.add(evaluations[i].y, 1.0, 10.0 + i % 7, evaluations[i].yhat);
+    }
+
+    Json::Value expected = single.summary();
+    Json::Value partial = single.partial();
+
+    if ( !expected[value].isNumeric() || expected[value].asDouble() <= 0 || expected[value].asDouble() >= 1 ) {
+        return Fail(metric + ": The summary is missing " + value + " or it is degenerate");
+    }
+
+    if ( partial.isMember("metric_results") || !partial["metric_state"].isObject() ) {
+        return Fail(metric + ": The partial summary keeps metric values rather than a metric state");
+    }
+
+    std::vector<Json::Value> partials;
+    for ( unsigned shard = 1; shard <= kShards; shard++ ) {
+        partials.push_back(ShardPartial(metric, evaluations, shard));
+    }
+
+    Json::Value merged;
+    std::string error;
+
+    if ( !MergePartialSummaries(partials, &merged, &error) ) {
+        return Fail(metric + ": Unable to merge partial summaries: " + error);
+    }
+
+    if ( merged.size() != 1 || merged[0][value] != expected[value] ) {
+        return Fail(metric + ": Merged " + value + " " + merged[0][value].toStyledString() + " does not match a single run's " + expected[value].toStyledString());
+    }
+
+    if ( merged[0].get("accuracy_counts", Json::Value()) != expected.get("accuracy_counts", Json::Value()) ) {
+        return Fail(metric + ": Merged accuracy counts do not match a single run's");
+    }
+
+    if ( accuracy ) {
+        const Json::Value &counts = expected["accuracy_counts"][value];
+        if ( counts["count"].asUInt() != kEvaluations
+            || static_cast<float>(counts["correct"].asDouble() / kEvaluations) != expected[value].asFloat() ) {
+            return Fail(metric + ": Accuracy counts do not match " + value);
+        }
+    }
+
+    // A state that cannot have been written by the metric is rejected, as is a missing one
+
+    Json::Value missing = partials[0];
+    missing["models"][0].removeMember("metric_state");
+
+    if ( MergePartialSummaries({missing, partials[1], partials[2]}, &merged, &error) ) {
+        return Fail(metric + ": Merged a partial summary without a metric state");
+    }
+
+    Json::Value malformed = partials[0];
+    malformed["models"][0]["metric_state"] = accuracy
+        ? Json::Value(Json::objectValue)
+        : Json::Value(Json::arrayValue);
+
+    if ( accuracy ) {
+        malformed["models"][0]["metric_state"][value]["count"] = 1;
+        malformed["models"][0]["metric_state"][value]["sum"] = 2;
+        malformed["models"][0]["metric_state"][value]["correct"] = 2;
+    }
+
+    if ( MergePartialSummaries({malformed, partials[1], partials[2]}, &merged, &error) ) {
+        return Fail(metric + ": Merged a malformed metric state");
+    }
+
+    return true;
+}
+
+// The detection state counts detections by score, and the scores step by 1/20th, so it stays the
+// same size however many images are evaluated
+
+bool CheckStateSize() {
+    std::vector<Evaluation> evaluations = Evaluations(kEvaluations * 10);
+    ModelSummary summary("model", 0, "EvaluationMetricMeanAveragePrecision", {}, {});
+    size_t scores = 0;
+
+    for ( const Evaluation &evaluation : evaluations ) {
+        summary.add(evaluation.y, 1.0, 10.0, evaluation.yhat);
+    }
+
+    for ( const Json::Value &entry : summary.partial()["metric_state"]["classes"] ) {
+        scores += entry["scores"].size();
+    }
+
+    if ( scores > 8 * 20 ) {
+        return Fail("The detection state keeps " + std::to_string(scores) + " scores for 160 distinct class scores");
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool passed = CheckMetric("EvaluationMetricAccuracyTop5", "classification_accuracy", true)
+        && CheckMetric("EvaluationMetricMeanAveragePrecision", "mean_average_precision", false)
+        && CheckStateSize();
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Model summaries check out" << std::endl;
+    return EXIT_SUCCESS;
+}
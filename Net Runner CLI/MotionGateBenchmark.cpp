@@ -0,0 +1,224 @@
+//
+//  MotionGateBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the motion gate's SIMD kernels against scalar references, times them on model and
+// camera sized frames, and runs the gate on a synthetic scene that is still for a while and then
+// pans. Reports the skip rate and the inference time that would be saved.
+//
+// usage: net-runner-motion-gate-benchmark [threshold] [inference ms]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "MotionGate.h"
+
+using netrunner::MotionGate;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Image {
+    size_t width;
+    size_t height;
+    size_t bytesPerRow;
+    std::vector<uint8_t> bytes;
+};
+
+Image RandomImage(std::mt19937 &generator, size_t width, size_t height, size_t padding) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    Image image{width, height, width * 4 + padding, {}};
+    image.bytes.resize(image.bytesPerRow * height);
+    for ( uint8_t &b : image.bytes ) {
+        b = static_cast<uint8_t>(byte(generator));
+    }
+    return image;
+}
+
+// MARK: - Scalar references
+
+void ReferenceThumbnail(const Image &image, uint8_t *thumbnail) {
+    const size_t side = MotionGate::kThumbnailSide;
+    for ( size_t y = 0; y < side; y++ ) {
+        for ( size_t x = 0; x < side; x++ ) {
+            size_t top = y * image.height / side, bottom = (y + 1) * image.height / side;
+            size_t left = x * image.width / side, right = (x + 1) * image.width / side;
+            uint64_t sum = 0;
+            for ( size_t row = top; row < bottom; row++ ) {
+                for ( size_t i = left * 4; i < right * 4; i++ ) {
+                    sum += image.bytes[row * image.bytesPerRow + i];
+                }
+            }
+            uint64_t count = (bottom - top) * (right - left) * 4;
+            thumbnail[y * side + x] = static_cast<uint8_t>((sum + count / 2) / count);
+        }
+    }
+}
+
+uint64_t ReferenceSumOfAbsoluteDifferences(const uint8_t *a, const uint8_t *b, size_t count) {
+    uint64_t sum = 0;
+    for ( size_t i = 0; i < count; i++ ) {
+        sum += static_cast<uint64_t>(std::abs(static_cast<int>(a[i]) - static_cast<int>(b[i])));
+    }
+    return sum;
+}
+
+bool CheckKernels(std::mt19937 &generator) {
+    const size_t sizes[][3] = {{32, 32, 0}, {224, 224, 0}, {299, 299, 12}, {33, 1000, 4}, {40, 9000, 0}, {1920, 1080, 64}};
+
+    for ( const auto &size : sizes ) {
+        Image image = RandomImage(generator, size[0], size[1], size[2]);
+        uint8_t expected[MotionGate::kThumbnailSize], actual[MotionGate::kThumbnailSize];
+
+        ReferenceThumbnail(image, expected);
+        MotionGate::Thumbnail(image.bytes.data(), image.width, image.height, image.bytesPerRow, actual);
+
+        if ( !std::equal(expected, expected + MotionGate::kThumbnailSize, actual) ) {
+            std::cerr << "Thumbnail mismatch at " << size[0] << "x" << size[1] << std::endl;
+            return false;
+        }
+    }
+
+    for ( size_t count : {0, 1, 15, 16, 17, 1024, 200705} ) {
+        Image a = RandomImage(generator, count, 1, 0), b = RandomImage(generator, count, 1, 0);
+        if ( MotionGate::SumOfAbsoluteDifferences(a.bytes.data(), b.bytes.data(), a.bytes.size())
+            != ReferenceSumOfAbsoluteDifferences(a.bytes.data(), b.bytes.data(), a.bytes.size()) ) {
+            std::cerr << "Sum of absolute differences mismatch at " << count * 4 << " bytes" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// MARK: - Timing
+
+template <typename F>
+double Microseconds(size_t iterations, F f) {
+    Clock::time_point start = Clock::now();
+    for ( size_t i = 0; i < iterations; i++ ) {
+        f();
+    }
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+}
+
+void Time(std::mt19937 &generator, size_t width, size_t height, size_t iterations) {
+    Image image = RandomImage(generator, width, height, 0);
+    uint8_t thumbnail[MotionGate::kThumbnailSize];
+    uint8_t reference[MotionGate::kThumbnailSize] = {0};
+    volatile uint64_t sink = 0;
+
+    double simd = Microseconds(iterations, [&] {
+        MotionGate::Thumbnail(image.bytes.data(), width, height, image.bytesPerRow, thumbnail);
+        sink = sink + MotionGate::SumOfAbsoluteDifferences(thumbnail, reference, MotionGate::kThumbnailSize);
+    });
+
+    double scalar = Microseconds(iterations, [&] {
+        ReferenceThumbnail(image, thumbnail);
+        sink = sink + ReferenceSumOfAbsoluteDifferences(thumbnail, reference, MotionGate::kThumbnailSize);
+    });
+
+    std::cout << std::fixed << std::setprecision(1)
+        << width << "x" << height << " frame: " << simd << "us, scalar " << scalar << "us ("
+        << scalar / simd << "x)" << std::endl;
+}
+
+// MARK: - Synthetic scene
+
+// A smooth gradient scene with per-pixel sensor noise, offset horizontally by the pan
+
+void RenderScene(std::mt19937 &generator, Image &image, size_t pan) {
+    std::uniform_int_distribution<int> noise(-4, 4);
+    for ( size_t y = 0; y < image.height; y++ ) {
+        uint8_t *row = image.bytes.data() + y * image.bytesPerRow;
+        for ( size_t x = 0; x < image.width; x++ ) {
+            int base = static_cast<int>(((x + pan) * 7 + y * 3) % 256);
+            for ( size_t c = 0; c < 3; c++ ) {
+                row[x * 4 + c] = static_cast<uint8_t>(std::min(255, std::max(0, base + noise(generator))));
+            }
+            row[x * 4 + 3] = 255;
+        }
+    }
+}
+
+void Simulate(std::mt19937 &generator, double threshold, double inference) {
+    const size_t stillFrames = 240, panningFrames = 60;
+    const auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / 30));
+
+    MotionGate::Options options;
+    options.threshold = threshold;
+    MotionGate gate(options);
+
+    Image image{224, 224, 224 * 4, std::vector<uint8_t>(224 * 224 * 4)};
+    Clock::time_point now = Clock::now();
+    uint64_t stillSkipped = 0, panningSkipped = 0;
+
+    for ( size_t i = 0; i < stillFrames + panningFrames; i++ ) {
+        size_t pan = i < stillFrames ? 0 : (i - stillFrames) * 2;
+        RenderScene(generator, image, pan);
+
+        if ( !gate.shouldRun(image.bytes.data(), image.width, image.height, image.bytesPerRow, now) ) {
+            (i < stillFrames ? stillSkipped : panningSkipped) += 1;
+        }
+        now += interval;
+    }
+
+    MotionGate::Statistics statistics = gate.statistics();
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "threshold " << std::setprecision(3) << threshold << std::setprecision(1)
+        << ": skipped " << statistics.skipped << " of " << statistics.frames << " (" << statistics.skipRate() * 100 << "%)"
+        << ", still " << stillSkipped << "/" << stillFrames
+        << ", panning " << panningSkipped << "/" << panningFrames
+        << ", saved inference " << statistics.skipped * inference << "ms of " << statistics.frames * inference << "ms"
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const double threshold = argc > 1 ? std::atof(argv[1]) : MotionGate::Options().threshold;
+    const double inference = argc > 2 ? std::atof(argv[2]) : 25;
+
+    if ( threshold < 0 || inference < 0 ) {
+        std::cerr << "usage: " << argv[0] << " [threshold] [inference ms]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 generator(1);
+
+    if ( !CheckKernels(generator) ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Kernels match the scalar references" << std::endl;
+
+    Time(generator, 224, 224, 2000);
+    Time(generator, 1920, 1080, 50);
+
+    Simulate(generator, threshold, inference);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,579 @@
+//
+//  PostProcessingBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the compiled post-processing stages against straightforward references and times them
+// on a 1,001 class classifier and on SSD detector outputs of 91 classes, from 1,917 boxes up to
+// 20,000 candidate boxes. For comparison it also times a string keyed emulation of packaging a
+// labeled output and taking its top 5, which is what the imagenet model output does with a
+// dictionary of every label, and suppression that tests every pair of candidates. It also checks
+// the detection mean average precision on matched and perturbed boxes.
+//
+// usage: net-runner-post-processing-benchmark [runs]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DetectionBoxes.h"
+#include "DetectionMetrics.h"
+#include "PostProcessor.h"
+
+using netrunner::BoxScales;
+using netrunner::BoxSet;
+using netrunner::PostProcessor;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+PostProcessor::Stage Stage(const std::string &name, const std::map<std::string, double> &numbers = {}, const std::map<std::string, std::string> &strings = {}, const std::map<std::string, std::vector<float>> &arrays = {}) {
+    return {name, numbers, strings, arrays};
+}
+
+std::vector<std::string> Labels(size_t count) {
+    std::vector<std::string> labels;
+    for ( size_t i = 0; i < count; i++ ) {
+        labels.push_back("n" + std::to_string(1000000 + i) + " label");
+    }
+    return labels;
+}
+
+std::vector<float> Logits(size_t count, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> logit(0, 3);
+    std::vector<float> logits(count);
+    for ( float &value : logits ) {
+        value = logit(generator);
+    }
+    return logits;
+}
+
+// Clustered boxes so that suppression has work to do
+
+std::vector<float> Boxes(size_t rows, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> center(0.1f, 0.9f), jitter(-0.02f, 0.02f), size(0.05f, 0.2f);
+    std::vector<float> boxes(rows * 4);
+    float y = 0.5f, x = 0.5f, h = 0.1f, w = 0.1f;
+
+    for ( size_t row = 0; row < rows; row++ ) {
+        if ( row % 8 == 0 ) {
+            y = center(generator); x = center(generator); h = size(generator); w = size(generator);
+        }
+        float cy = y + jitter(generator), cx = x + jitter(generator);
+        float *box = boxes.data() + row * 4;
+        box[0] = cy - h / 2; box[1] = cx - w / 2; box[2] = cy + h / 2; box[3] = cx + w / 2;
+    }
+
+    return boxes;
+}
+
+bool CheckRejects() {
+    const std::vector<PostProcessor::Layer> outputs = {
+        {"scores", {1, 10, 4}, {"a", "b", "c", "d"}},
+        {"boxes", {1, 10, 4}, {}},
+        {"anchors", {1, 9, 4}, {}}
+    };
+    const std::vector<std::vector<PostProcessor::Stage>> invalid = {
+        {Stage("unknown")},
+        {Stage("top_k", {{"k", 2}}), Stage("softmax")},
+        {Stage("top_k", {{"k", 0}})},
+        {Stage("threshold")},
+        {Stage("nms")},
+        {Stage("nms", {}, {{"boxes", "anchors"}})},
+        {Stage("labels")},
+        {Stage("nms", {}, {{"boxes", "boxes"}}), Stage("argmax")}
+    };
+
+    for ( const auto &stages : invalid ) {
+        std::string error;
+        if ( PostProcessor::Compile(outputs, "scores", stages, &error) != nullptr || error.empty() ) {
+            std::cerr << "An invalid declaration of " << stages.size() << " stages starting with " << stages.front().name << " was compiled" << std::endl;
+            return false;
+        }
+    }
+
+    std::string error;
+    if ( PostProcessor::Compile(outputs, "missing", {}, &error) != nullptr ) {
+        std::cerr << "A missing scores layer was compiled" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckClassification(size_t classes) {
+    std::string error;
+    auto processor = PostProcessor::Compile({{"classification", {1, static_cast<int>(classes)}, Labels(classes)}}, "classification", {
+        Stage("softmax"),
+        Stage("top_k", {{"k", 5}}),
+        Stage("threshold", {{"value", 0.01}}),
+        Stage("labels")
+    }, &error);
+
+    if ( processor == nullptr || !processor->labeled() ) {
+        std::cerr << "Unable to compile classification stages: " << error << std::endl;
+        return false;
+    }
+
+    std::vector<float> logits = Logits(classes, 1);
+    PostProcessor::Result result;
+
+    if ( !processor->run({{logits.data(), logits.size()}}, &result, &error) ) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    // Reference: double precision softmax, full sort, threshold
+
+    double max = *std::max_element(logits.begin(), logits.end()), sum = 0;
+    std::vector<std::pair<double, uint32_t>> reference;
+    for ( float logit : logits ) {
+        sum += std::exp(logit - max);
+    }
+    for ( size_t i = 0; i < classes; i++ ) {
+        reference.push_back({std::exp(logits[i] - max) / sum, static_cast<uint32_t>(i)});
+    }
+    std::sort(reference.begin(), reference.end(), [](const std::pair<double, uint32_t> &a, const std::pair<double, uint32_t> &b) {
+        return a.first > b.first;
+    });
+    reference.resize(5);
+    reference.erase(std::remove_if(reference.begin(), reference.end(), [](const std::pair<double, uint32_t> &entry) {
+        return entry.first <= 0.01;
+    }), reference.end());
+
+    bool matches = reference.size() == result.classifications.size();
+    for ( size_t i = 0; matches && i < reference.size(); i++ ) {
+        matches = reference[i].second == result.classifications[i].index
+            && std::abs(reference[i].first - result.classifications[i].score) < 1e-5;
+    }
+
+    if ( !matches ) {
+        std::cerr << "Classifications do not match a full sort at " << classes << " classes" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Reference: every candidate is compared against every higher scoring survivor of its class
+
+std::vector<PostProcessor::Detection> ReferenceNMS(const std::vector<float> &scores, const std::vector<float> &boxes, size_t classes, float scoreThreshold, float iouThreshold, size_t maxDetections) {
+    std::vector<PostProcessor::Detection> candidates;
+    const size_t rows = boxes.size() / 4;
+
+    for ( size_t row = 0; row < rows; row++ ) {
+        size_t best = 1;
+        for ( size_t c = 2; c < classes; c++ ) {
+            if ( scores[row * classes + c] > scores[row * classes + best] ) {
+                best = c;
+            }
+        }
+        float score = scores[row * classes + best];
+        if ( score > scoreThreshold ) {
+            PostProcessor::Detection detection{static_cast<uint32_t>(best), score, {0, 0, 0, 0}};
+            std::copy(&boxes[row * 4], &boxes[row * 4] + 4, detection.box);
+            candidates.push_back(detection);
+        }
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(), [](const PostProcessor::Detection &a, const PostProcessor::Detection &b) {
+        return a.score > b.score;
+    });
+
+    std::vector<bool> suppressed(candidates.size(), false);
+    std::vector<PostProcessor::Detection> detections;
+
+    for ( size_t i = 0; i < candidates.size() && detections.size() < maxDetections; i++ ) {
+        if ( suppressed[i] ) {
+            continue;
+        }
+        detections.push_back(candidates[i]);
+        for ( size_t j = i + 1; j < candidates.size(); j++ ) {
+            if ( candidates[j].index == candidates[i].index && PostProcessor::IntersectionOverUnion(candidates[i].box, candidates[j].box) > iouThreshold ) {
+                suppressed[j] = true;
+            }
+        }
+    }
+
+    return detections;
+}
+
+std::unique_ptr<PostProcessor> DetectionProcessor(size_t rows, size_t classes, std::string *error) {
+    return PostProcessor::Compile({
+        {"scores", {1, static_cast<int>(rows), static_cast<int>(classes)}, Labels(classes)},
+        {"boxes", {1, static_cast<int>(rows), 4}, {}}
+    }, "scores", {
+        Stage("sigmoid"),
+        Stage("nms", {{"score_threshold", 0.5}, {"iou_threshold", 0.5}, {"background", 0}, {"max_detections", 100}}, {{"boxes", "boxes"}}),
+        Stage("labels")
+    }, error);
+}
+
+bool CheckDetection(size_t rows, size_t classes) {
+    std::string error;
+    auto processor = DetectionProcessor(rows, classes, &error);
+
+    if ( processor == nullptr || !processor->detects() ) {
+        std::cerr << "Unable to compile detection stages: " << error << std::endl;
+        return false;
+    }
+
+    std::vector<float> logits = Logits(rows * classes, 2), boxes = Boxes(rows, 3);
+    PostProcessor::Result result;
+
+    if ( !processor->run({{logits.data(), logits.size()}, {boxes.data(), boxes.size()}}, &result, &error) ) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    std::vector<float> scores = logits;
+    PostProcessor::Sigmoid(scores.data(), scores.size());
+    std::vector<PostProcessor::Detection> reference = ReferenceNMS(scores, boxes, classes, 0.5f, 0.5f, 100);
+
+    bool matches = reference.size() == result.detections.size();
+    for ( size_t i = 0; matches && i < reference.size(); i++ ) {
+        matches = reference[i].index == result.detections[i].index
+            && reference[i].score == result.detections[i].score
+            && std::equal(reference[i].box, reference[i].box + 4, result.detections[i].box);
+    }
+
+    if ( !matches ) {
+        std::cerr << "Detections do not match the reference suppression: " << result.detections.size() << " of " << reference.size() << std::endl;
+        return false;
+    }
+
+    // A wrongly sized tensor is rejected rather than read past its end
+
+    if ( processor->run({{logits.data(), logits.size() - 1}, {boxes.data(), boxes.size()}}, &result, &error) ) {
+        std::cerr << "A short scores tensor was processed" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Anchors on a grid of cells with three shapes per cell, and encodings that nudge them
+
+std::vector<float> Anchors(size_t rows) {
+    std::vector<float> anchors(rows * 4);
+    const size_t cells = static_cast<size_t>(std::ceil(std::sqrt(rows / 3.0)));
+    const float shapes[3][2] = {{0.1f, 0.1f}, {0.14f, 0.07f}, {0.07f, 0.14f}};
+
+    for ( size_t row = 0; row < rows; row++ ) {
+        size_t cell = row / 3;
+        float *anchor = anchors.data() + row * 4;
+        anchor[0] = (static_cast<float>(cell / cells) + 0.5f) / cells;
+        anchor[1] = (static_cast<float>(cell % cells) + 0.5f) / cells;
+        anchor[2] = shapes[row % 3][0];
+        anchor[3] = shapes[row % 3][1];
+    }
+
+    return anchors;
+}
+
+std::vector<float> Encodings(size_t rows, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> encoding(0, 1);
+    std::vector<float> encodings(rows * 4);
+    for ( float &value : encodings ) {
+        value = encoding(generator);
+    }
+    return encodings;
+}
+
+bool CheckDecoding() {
+    const size_t rows = 1917;
+    std::vector<float> anchors = Anchors(rows), encodings = Encodings(rows, 7), boxes(rows * 4);
+    BoxScales scales;
+
+    netrunner::DecodeBoxes(encodings.data(), anchors.data(), rows, scales, boxes.data());
+
+    for ( size_t row = 0; row < rows; row++ ) {
+        const float *t = &encodings[row * 4], *a = &anchors[row * 4], *box = &boxes[row * 4];
+        const double cy = t[0] / scales.y * a[2] + a[0], cx = t[1] / scales.x * a[3] + a[1];
+        const double h = std::exp(t[2] / scales.height) * a[2], w = std::exp(t[3] / scales.width) * a[3];
+        const double reference[4] = {cy - h / 2, cx - w / 2, cy + h / 2, cx + w / 2};
+
+        for ( size_t i = 0; i < 4; i++ ) {
+            if ( std::abs(box[i] - reference[i]) > 1e-5 ) {
+                std::cerr << "Decoded box " << row << " does not match the reference" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // Decoding in place
+
+    netrunner::DecodeBoxes(encodings.data(), anchors.data(), rows, scales, encodings.data());
+
+    if ( encodings != boxes ) {
+        std::cerr << "Decoding in place does not match" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckOverlaps() {
+    std::vector<float> boxes = Boxes(1001, 8);
+
+    for ( size_t count : {0, 1, 3, 4, 5, 64, 1000} ) {
+        BoxSet set;
+        for ( size_t i = 0; i < count; i++ ) {
+            set.add(&boxes[i * 4]);
+        }
+
+        for ( float threshold : {0.0f, 0.3f, 0.5f, 0.9f} ) {
+            const float *box = &boxes[1000 * 4];
+            bool expected = false;
+            for ( size_t i = 0; i < count && !expected; i++ ) {
+                expected = PostProcessor::IntersectionOverUnion(&boxes[i * 4], box) > threshold;
+            }
+            if ( set.overlaps(box, threshold) != expected ) {
+                std::cerr << "Overlap test does not match the reference for " << count << " boxes at " << threshold << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+std::unique_ptr<PostProcessor> SSDProcessor(size_t rows, size_t classes, const std::vector<float> &anchors, std::string *error) {
+    return PostProcessor::Compile({
+        {"scores", {1, static_cast<int>(rows), static_cast<int>(classes)}, Labels(classes)},
+        {"encodings", {1, static_cast<int>(rows), 4}, {}}
+    }, "scores", {
+        Stage("sigmoid"),
+        Stage("ssd", {}, {{"boxes", "encodings"}}, {{"anchors", anchors}}),
+        Stage("nms", {{"score_threshold", 0.5}, {"iou_threshold", 0.5}, {"background", 0}, {"max_detections", 100}}),
+        Stage("labels")
+    }, error);
+}
+
+bool CheckSSD(size_t rows, size_t classes) {
+    std::string error;
+    std::vector<float> anchors = Anchors(rows);
+    auto processor = SSDProcessor(rows, classes, anchors, &error);
+
+    if ( processor == nullptr ) {
+        std::cerr << "Unable to compile ssd stages: " << error << std::endl;
+        return false;
+    }
+
+    std::vector<float> logits = Logits(rows * classes, 9), encodings = Encodings(rows, 10);
+    PostProcessor::Result result;
+
+    if ( !processor->run({{logits.data(), logits.size()}, {encodings.data(), encodings.size()}}, &result, &error) ) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    std::vector<float> scores = logits, boxes(rows * 4);
+    PostProcessor::Sigmoid(scores.data(), scores.size());
+    netrunner::DecodeBoxes(encodings.data(), anchors.data(), rows, BoxScales(), boxes.data());
+    std::vector<PostProcessor::Detection> reference = ReferenceNMS(scores, boxes, classes, 0.5f, 0.5f, 100);
+
+    bool matches = reference.size() == result.detections.size();
+    for ( size_t i = 0; matches && i < reference.size(); i++ ) {
+        matches = reference[i].index == result.detections[i].index && reference[i].score == result.detections[i].score;
+    }
+
+    if ( !matches ) {
+        std::cerr << "SSD detections do not match the reference at " << rows << " boxes" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckMeanAveragePrecision() {
+    using netrunner::metrics::DetectionAveragePrecision;
+    using netrunner::metrics::LabeledBox;
+
+    std::vector<LabeledBox> truth = {
+        {"cat", 0, {0.1f, 0.1f, 0.4f, 0.4f}},
+        {"dog", 0, {0.5f, 0.5f, 0.9f, 0.9f}}
+    };
+
+    // Exact detections score 1
+
+    DetectionAveragePrecision exact;
+    exact.add(truth, {{"cat", 0.9f, {0.1f, 0.1f, 0.4f, 0.4f}}, {"dog", 0.8f, {0.5f, 0.5f, 0.9f, 0.9f}}}, 0.5f);
+
+    // A cat found second after a false positive, a duplicate that does not count, and a dog
+    // that is missed: cat AP 1/2, dog AP 0
+
+    DetectionAveragePrecision partial;
+    partial.add(truth, {
+        {"cat", 0.9f, {0.6f, 0.1f, 0.8f, 0.3f}},
+        {"cat", 0.8f, {0.11f, 0.1f, 0.4f, 0.41f}},
+        {"cat", 0.7f, {0.1f, 0.1f, 0.4f, 0.4f}},
+        {"dog", 0.6f, {0.1f, 0.5f, 0.2f, 0.6f}}
+    }, 0.5f);
+
+    if ( std::abs(exact.meanAveragePrecision() - 1) > 1e-9
+        || std::abs(partial.averagePrecision("cat") - 0.5) > 1e-9
+        || partial.averagePrecision("dog") != 0
+        || std::abs(partial.meanAveragePrecision() - 0.25) > 1e-9 ) {
+        std::cerr << "Mean average precision does not match: " << exact.meanAveragePrecision() << ", " << partial.meanAveragePrecision() << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+double MicrosecondsPerRun(Clock::time_point start, size_t runs) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / runs;
+}
+
+double TimeProcessor(const PostProcessor &processor, const std::vector<PostProcessor::Tensor> &tensors, size_t runs) {
+    PostProcessor::Result result;
+    volatile size_t sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( size_t i = 0; i < runs; i++ ) {
+        processor.run(tensors, &result, nullptr);
+        sink = sink + result.classifications.size() + result.detections.size();
+    }
+    return MicrosecondsPerRun(start, runs);
+}
+
+double TimeStringKeyed(const std::vector<float> &probabilities, const std::vector<std::string> &labels, size_t runs) {
+    volatile size_t sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( size_t run = 0; run < runs; run++ ) {
+        std::map<std::string, double> labeled;
+        for ( size_t i = 0; i < labels.size(); i++ ) {
+            labeled[labels[i]] = probabilities[i];
+        }
+
+        std::vector<std::pair<std::string, double>> entries;
+        for ( const auto &entry : labeled ) {
+            if ( entry.second > 0.01 ) {
+                entries.push_back(entry);
+            }
+        }
+        std::stable_sort(entries.begin(), entries.end(), [](const std::pair<std::string, double> &a, const std::pair<std::string, double> &b) {
+            return a.second > b.second;
+        });
+        entries.resize(std::min<size_t>(entries.size(), 5));
+        sink = sink + entries.size();
+    }
+    return MicrosecondsPerRun(start, runs);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long runs = argc > 1 ? std::atol(argv[1]) : 1000;
+
+    if ( runs <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [runs]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ( !CheckRejects() || !CheckClassification(1001) || !CheckClassification(10) || !CheckDetection(1917, 91)
+        || !CheckDecoding() || !CheckOverlaps() || !CheckSSD(1917, 91) || !CheckSSD(20000, 91) || !CheckMeanAveragePrecision() ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Stages match the references" << std::endl;
+
+    // Classification
+
+    const size_t classes = 1001;
+    std::vector<std::string> labels = Labels(classes);
+    std::vector<float> logits = Logits(classes, 4);
+    std::string error;
+
+    auto classifier = PostProcessor::Compile({{"classification", {1, static_cast<int>(classes)}, labels}}, "classification", {
+        Stage("softmax"),
+        Stage("top_k", {{"k", 5}}),
+        Stage("threshold", {{"value", 0.01}}),
+        Stage("labels")
+    }, &error);
+
+    std::vector<float> probabilities = logits;
+    PostProcessor::Softmax(probabilities.data(), probabilities.size(), classes);
+
+    std::cout << std::fixed << std::setprecision(1)
+        << classes << " classes, per run: "
+        << "softmax, top 5 and threshold " << TimeProcessor(*classifier, {{logits.data(), logits.size()}}, static_cast<size_t>(runs)) << "us"
+        << ", string keyed top 5 " << TimeStringKeyed(probabilities, labels, static_cast<size_t>(runs)) << "us"
+        << std::endl;
+
+    // Detection
+
+    const size_t rows = 1917, detectorClasses = 91;
+    std::vector<float> scores = Logits(rows * detectorClasses, 5), boxes = Boxes(rows, 6);
+    auto detector = DetectionProcessor(rows, detectorClasses, &error);
+
+    std::cout << rows << " boxes of " << detectorClasses << " classes, per run: "
+        << "sigmoid and non-maximum suppression " << TimeProcessor(*detector, {{scores.data(), scores.size()}, {boxes.data(), boxes.size()}}, static_cast<size_t>(runs) / 10 + 1) << "us"
+        << std::endl;
+
+    // SSD decoding and suppression, with a low score threshold so that every box is a candidate
+
+    for ( size_t ssdRows : {1917, 5000, 20000} ) {
+        std::vector<float> anchors = Anchors(ssdRows);
+        std::vector<float> ssdScores = Logits(ssdRows * detectorClasses, 11), encodings = Encodings(ssdRows, 12);
+        auto ssd = SSDProcessor(ssdRows, detectorClasses, anchors, &error);
+        auto dense = PostProcessor::Compile({
+            {"scores", {1, static_cast<int>(ssdRows), static_cast<int>(detectorClasses)}, {}},
+            {"encodings", {1, static_cast<int>(ssdRows), 4}, {}}
+        }, "scores", {
+            Stage("ssd", {}, {{"boxes", "encodings"}}, {{"anchors", anchors}}),
+            Stage("nms", {{"score_threshold", -1e9}, {"iou_threshold", 0.5}, {"background", 0}, {"max_detections", 1e9}})
+        }, &error);
+
+        const std::vector<PostProcessor::Tensor> tensors = {{ssdScores.data(), ssdScores.size()}, {encodings.data(), encodings.size()}};
+        const size_t ssdRuns = static_cast<size_t>(runs) / 50 + 1;
+
+        // The pairwise reference on the same candidates
+
+        std::vector<float> boxes(ssdRows * 4);
+        netrunner::DecodeBoxes(encodings.data(), anchors.data(), ssdRows, BoxScales(), boxes.data());
+        Clock::time_point start = Clock::now();
+        size_t referenceCount = ReferenceNMS(ssdScores, boxes, detectorClasses, -1e9f, 0.5f, ssdRows).size();
+        double reference = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+        PostProcessor::Result result;
+        dense->run(tensors, &result, nullptr);
+
+        std::cout << ssdRows << " SSD boxes of " << detectorClasses << " classes, per run: "
+            << "decode and suppress, thresholded " << TimeProcessor(*ssd, tensors, ssdRuns) << "us"
+            << ", every box a candidate " << TimeProcessor(*dense, tensors, ssdRuns) << "us"
+            << " keeping " << result.detections.size()
+            << ", pairwise reference " << reference << "us keeping " << referenceCount
+            << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
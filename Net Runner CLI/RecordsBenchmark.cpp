@@ -0,0 +1,212 @@
+//
+//  RecordsBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Times writing and reading a 1 GB synthetic record file shaped like an image dataset: a 224x224x3
+// uint8 tensor, an int32 label and a compressed image payload of 2 to 20 KB per record. Reports
+// write throughput, the time to open and validate the file, a sequential pass and a shuffled pass
+// over every record, and the process's memory before and after the passes. The mapped pages are
+// shared with the page cache, so reading the whole dataset adds little to the private footprint,
+// whereas an in-memory data source would hold all of it.
+//
+// usage: net-runner-records-benchmark [megabytes]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "MemorySampler.h"
+#include "RecordFile.h"
+#include "RecordFileReader.h"
+#include "RecordFileWriter.h"
+
+using namespace netrunner::records;
+using netrunner::CurrentMemoryUsage;
+using netrunner::MemoryUsage;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int kImageSize = 224;
+const size_t kMinimumPayload = 2 * 1024;
+const size_t kMaximumPayload = 20 * 1024;
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double Megabytes(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024 * 1024);
+}
+
+Schema DatasetSchema() {
+    Schema schema;
+    schema.fields.push_back(FieldSpec::Tensor("image", DType::UInt8, {kImageSize, kImageSize, 3}));
+    schema.fields.push_back(FieldSpec::Tensor("label", DType::Int32, {1}));
+    schema.fields.push_back(FieldSpec::Blob("jpeg", "jpeg"));
+    return schema;
+}
+
+// Sums a sample of each field's bytes, so that every record's pages are touched without the
+// checksum dominating the pass
+
+uint64_t Checksum(const RecordFileReader &reader, size_t record) {
+    uint64_t sum = 0;
+
+    for ( size_t i = 0; i < reader.schema().fields.size(); i++ ) {
+        FieldView view = reader.field(record, i);
+        for ( size_t offset = 0; offset < view.length; offset += 4096 ) {
+            sum += view.data[offset];
+        }
+        sum += view.length;
+    }
+
+    return sum;
+}
+
+uint64_t FootprintBytes() {
+    MemoryUsage usage;
+    return CurrentMemoryUsage(&usage) ? usage.footprint : 0;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long megabytes = argc > 1 ? std::atol(argv[1]) : 1024;
+
+    if ( megabytes <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [megabytes]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string path = std::string(P_tmpdir) + "/net-runner-records-benchmark-" + std::to_string(getpid()) + ".records";
+    uint64_t target = static_cast<uint64_t>(megabytes) * 1024 * 1024;
+    std::string error;
+
+    // Write
+
+    auto writer = RecordFileWriter::Create(path, DatasetSchema(), &error);
+
+    if ( writer == nullptr ) {
+        std::cerr << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<size_t> payloadSize(kMinimumPayload, kMaximumPayload);
+    std::vector<uint8_t> image(kImageSize * kImageSize * 3);
+    std::vector<uint8_t> payload(kMaximumPayload);
+    uint64_t written = 0;
+
+    for ( size_t i = 0; i < payload.size(); i++ ) {
+        payload[i] = static_cast<uint8_t>(generator());
+    }
+
+    Clock::time_point start = Clock::now();
+
+    while ( writer->size() < target ) {
+        int32_t label = static_cast<int32_t>(writer->count() % 1000);
+        std::fill(image.begin(), image.end(), static_cast<uint8_t>(writer->count()));
+        size_t length = payloadSize(generator);
+
+        if ( !writer->write({FieldView(image.data(), image.size()), FieldView(&label, sizeof(label)), FieldView(payload.data(), length)}, &error) ) {
+            std::cerr << error << std::endl;
+            std::remove(path.c_str());
+            return EXIT_FAILURE;
+        }
+
+        written += image.size() + sizeof(label) + length;
+    }
+
+    size_t records = writer->count();
+
+    if ( !writer->close(&error) ) {
+        std::cerr << error << std::endl;
+        std::remove(path.c_str());
+        return EXIT_FAILURE;
+    }
+
+    double writeSeconds = Seconds(start);
+    uint64_t baseline = FootprintBytes();
+
+    // Open and validate
+
+    start = Clock::now();
+    auto reader = RecordFileReader::Open(path, &error);
+    double openSeconds = Seconds(start);
+
+    if ( reader == nullptr || reader->count() != records ) {
+        std::cerr << "Unable to open the record file: " << error << std::endl;
+        std::remove(path.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // Sequential and shuffled passes must visit the same data
+
+    uint64_t sequentialSum = 0;
+    start = Clock::now();
+
+    for ( size_t i = 0; i < records; i++ ) {
+        sequentialSum += Checksum(*reader, i);
+    }
+
+    double sequentialSeconds = Seconds(start);
+
+    std::vector<uint32_t> order(records);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), generator);
+
+    uint64_t shuffledSum = 0;
+    start = Clock::now();
+
+    for ( uint32_t i : order ) {
+        shuffledSum += Checksum(*reader, i);
+    }
+
+    double shuffledSeconds = Seconds(start);
+    uint64_t footprint = FootprintBytes();
+
+    std::remove(path.c_str());
+
+    if ( sequentialSum != shuffledSum ) {
+        std::cerr << "The shuffled pass did not read the same records as the sequential pass" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+        << records << " records, " << Megabytes(reader->size()) << " MB" << std::endl
+        << "write: " << writeSeconds << " s, " << Megabytes(written) / writeSeconds << " MB/s" << std::endl
+        << "open and validate: " << openSeconds * 1000 << " ms" << std::endl
+        << "sequential pass: " << sequentialSeconds * 1000 << " ms, " << sequentialSeconds * 1e6 / records << " us per record" << std::endl
+        << "shuffled pass: " << shuffledSeconds * 1000 << " ms, " << shuffledSeconds * 1e6 / records << " us per record" << std::endl
+        << "private footprint before the passes: " << Megabytes(baseline) << " MB, after: " << Megabytes(footprint) << " MB" << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,293 @@
+//
+//  RecordsTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the record file writer and reader: round trips of tensor and blob fields, appending to a
+// closed file, and rejecting files that were not closed, are truncated or have corrupt indexes or
+// blob lengths.
+//
+// usage: net-runner-records-test
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "RecordFile.h"
+#include "RecordFileReader.h"
+#include "RecordFileWriter.h"
+
+using namespace netrunner::records;
+
+namespace {
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+Schema TestSchema() {
+    Schema schema;
+    schema.fields.push_back(FieldSpec::Tensor("pixels", DType::UInt8, {4, 4, 3}));
+    schema.fields.push_back(FieldSpec::Tensor("label", DType::Int32, {1}));
+    schema.fields.push_back(FieldSpec::Blob("jpeg", "jpeg"));
+    return schema;
+}
+
+// Record i has pixels filled with i, label i and a blob of i bytes of 'a' + i
+
+bool WriteRecord(RecordFileWriter *writer, int32_t i, std::string *error) {
+    std::vector<uint8_t> pixels(4 * 4 * 3, static_cast<uint8_t>(i));
+    std::string blob(static_cast<size_t>(i), static_cast<char>('a' + i % 26));
+    return writer->write({FieldView(pixels.data(), pixels.size()), FieldView(&i, sizeof(i)), FieldView(blob.data(), blob.size())}, error);
+}
+
+bool CheckRecord(const RecordFileReader &reader, size_t record) {
+    int32_t i = static_cast<int32_t>(record);
+    FieldView pixels = reader.field(record, 0);
+    FieldView label = reader.field(record, 1);
+    FieldView blob = reader.field(record, 2);
+    int32_t value;
+    std::memcpy(&value, label.data, sizeof(value));
+
+    if ( pixels.length != 48 || pixels.data[0] != static_cast<uint8_t>(i) || pixels.data[47] != static_cast<uint8_t>(i) ) {
+        return Fail("Tensor field of record " + std::to_string(record) + " did not round trip");
+    }
+
+    if ( label.length != sizeof(int32_t) || value != i ) {
+        return Fail("Label of record " + std::to_string(record) + " did not round trip");
+    }
+
+    if ( blob.length != record || std::string(reinterpret_cast<const char*>(blob.data), blob.length) != std::string(record, static_cast<char>('a' + i % 26)) ) {
+        return Fail("Blob field of record " + std::to_string(record) + " did not round trip");
+    }
+
+    // Fields are aligned for zero copy access
+
+    if ( reinterpret_cast<uintptr_t>(pixels.data) % format::kFieldAlignment != 0 || reinterpret_cast<uintptr_t>(blob.data) % format::kFieldAlignment != 0 ) {
+        return Fail("Fields of record " + std::to_string(record) + " are not aligned");
+    }
+
+    return true;
+}
+
+std::vector<char> ReadFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void WriteFile(const std::string &path, const std::vector<char> &bytes) {
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool CheckRoundTrip(const std::string &path) {
+    std::string error;
+    auto writer = RecordFileWriter::Create(path, TestSchema(), &error);
+
+    if ( writer == nullptr ) {
+        return Fail(error);
+    }
+
+    for ( int32_t i = 0; i < 10; i++ ) {
+        if ( !WriteRecord(writer.get(), i, &error) ) {
+            return Fail(error);
+        }
+    }
+
+    // Tensor fields must match the schema
+
+    std::vector<uint8_t> shortPixels(10);
+    int32_t label = 0;
+
+    if ( writer->write({FieldView(shortPixels.data(), shortPixels.size()), FieldView(&label, sizeof(label)), FieldView()}, &error) ) {
+        return Fail("A tensor field of the wrong size was written");
+    }
+
+    if ( !writer->close(&error) ) {
+        return Fail(error);
+    }
+
+    // Reopen and append five more
+
+    writer = RecordFileWriter::Append(path, &error);
+
+    if ( writer == nullptr || writer->count() != 10 ) {
+        return Fail("Unable to append to a closed record file: " + error);
+    }
+
+    for ( int32_t i = 10; i < 15; i++ ) {
+        if ( !WriteRecord(writer.get(), i, &error) ) {
+            return Fail(error);
+        }
+    }
+
+    writer.reset();
+
+    auto reader = RecordFileReader::Open(path, &error);
+
+    if ( reader == nullptr ) {
+        return Fail(error);
+    }
+
+    if ( reader->count() != 15 || reader->schema() != TestSchema() ) {
+        return Fail("Record count or schema did not round trip");
+    }
+
+    // Visit records out of order
+
+    for ( size_t i : {14, 0, 7, 3, 10, 1, 13, 2, 12, 4, 11, 5, 9, 6, 8} ) {
+        if ( !CheckRecord(*reader, i) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CheckInvalidFiles(const std::string &path) {
+    std::string error;
+    std::string corruptPath = path + ".corrupt";
+    std::vector<char> bytes = ReadFile(path);
+
+    auto expectRejected = [&](const std::vector<char> &corrupt, const std::string &message) {
+        WriteFile(corruptPath, corrupt);
+        if ( RecordFileReader::Open(corruptPath, &error) != nullptr ) {
+            return Fail(message);
+        }
+        return true;
+    };
+
+    // Not closed, no footer
+
+    {
+        auto writer = RecordFileWriter::Create(corruptPath, TestSchema(), &error);
+        WriteRecord(writer.get(), 3, &error);
+        std::fflush(nullptr);
+
+        if ( RecordFileReader::Open(corruptPath, &error) != nullptr ) {
+            return Fail("A record file that was not closed was opened");
+        }
+    }
+
+    // Truncated
+
+    std::vector<char> truncated(bytes.begin(), bytes.begin() + static_cast<long>(bytes.size() / 2));
+
+    if ( !expectRejected(truncated, "A truncated record file was opened") ) {
+        return false;
+    }
+
+    // Locate the index and the first record through the footer
+
+    uint64_t indexOffset, count;
+    std::memcpy(&indexOffset, bytes.data() + bytes.size() - format::kFooterSize, sizeof(indexOffset));
+    std::memcpy(&count, bytes.data() + bytes.size() - format::kFooterSize + 8, sizeof(count));
+
+    std::vector<uint64_t> index(count);
+    std::memcpy(index.data(), bytes.data() + indexOffset, count * sizeof(uint64_t));
+
+    // An index entry past the records, and entries out of order
+
+    std::vector<char> corrupt = bytes;
+    uint64_t past = indexOffset + 64;
+    std::memcpy(corrupt.data() + indexOffset + 3 * sizeof(uint64_t), &past, sizeof(past));
+
+    if ( !expectRejected(corrupt, "A record file whose index points past the records was opened") ) {
+        return false;
+    }
+
+    corrupt = bytes;
+    std::memcpy(corrupt.data() + indexOffset + 3 * sizeof(uint64_t), &index[5], sizeof(uint64_t));
+
+    if ( !expectRejected(corrupt, "A record file whose index is out of order was opened") ) {
+        return false;
+    }
+
+    // A count whose index size wraps around to the real one would map an index far larger than
+    // the file
+
+    corrupt = bytes;
+    uint64_t wrapped = count + (uint64_t(1) << 61);
+    std::memcpy(corrupt.data() + corrupt.size() - format::kFooterSize + 8, &wrapped, sizeof(wrapped));
+
+    if ( !expectRejected(corrupt, "A record file with an overflowing index count was opened") ) {
+        return false;
+    }
+
+    // A blob length that runs past its record. The blob follows the 48 byte pixels and 4 byte
+    // label, each padded to 16 bytes
+
+    corrupt = bytes;
+    uint64_t length = 1 << 30;
+    std::memcpy(corrupt.data() + index[4] + 64, &length, sizeof(length));
+
+    if ( !expectRejected(corrupt, "A record file with a corrupt blob length was opened") ) {
+        return false;
+    }
+
+    // The last record's blob may not run into the index either
+
+    corrupt = bytes;
+    length = 64;
+    std::memcpy(corrupt.data() + index[count - 1] + 64, &length, sizeof(length));
+
+    if ( !expectRejected(corrupt, "A record file whose last blob overlaps the index was opened") ) {
+        return false;
+    }
+
+    // A file that is only a header is not a record file
+
+    std::vector<char> header(bytes.begin(), bytes.begin() + 64);
+
+    if ( !expectRejected(header, "A record file without records or footer was opened") ) {
+        return false;
+    }
+
+    std::remove(corruptPath.c_str());
+
+    // A file that cannot be created is reported
+
+    if ( RecordFileWriter::Create(path + ".missing/records", TestSchema(), &error) != nullptr ) {
+        return Fail("A record file was created in a missing directory");
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::string path = std::string(P_tmpdir) + "/net-runner-records-test-" + std::to_string(getpid()) + ".records";
+
+    bool passed = CheckRoundTrip(path) && CheckInvalidFiles(path);
+    std::remove(path.c_str());
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Record files check out" << std::endl;
+    return EXIT_SUCCESS;
+}
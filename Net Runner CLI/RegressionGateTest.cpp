@@ -0,0 +1,163 @@
+//
+//  RegressionGateTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks the regression gate's statistics against known answers: the Mann-Whitney U test's normal
+// approximation with tie and continuity corrections, and the tails of Fisher's exact test on 2x2
+// tables. The expected values were worked out independently, from pairwise U statistics and exact
+// hypergeometric sums.
+//
+// usage: net-runner-regression-gate-test
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+
+#include "LatencyHistogram.h"
+#include "RegressionGate.h"
+
+using namespace netrunner;
+
+namespace {
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+bool Near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance * std::max(1.0, std::fabs(expected));
+}
+
+// The test only depends on the order of buckets, so values are given as bucket index and count
+
+LatencyHistogram::State Histogram(const std::map<uint32_t, uint64_t> &buckets) {
+    LatencyHistogram::State state;
+    for ( const auto &bucket : buckets ) {
+        state.buckets.push_back(bucket);
+    }
+    return state;
+}
+
+bool CheckMannWhitney(const std::string &name, const LatencyHistogram::State &baseline, const LatencyHistogram::State &candidate, bool larger, double expected) {
+    double pValue = RegressionGate::MannWhitneyPValue(baseline, candidate, larger);
+
+    if ( !Near(pValue, expected, 1e-6) ) {
+        return Fail("Mann-Whitney p-value of " + name + " is " + std::to_string(pValue) + ", expected " + std::to_string(expected));
+    }
+
+    return true;
+}
+
+bool CheckMannWhitney() {
+    // Without ties: baseline 1-5, candidate 6-10. U = 25, mean 12.5, variance 25 * 11 / 12 = 22.917,
+    // z = (12.5 - 0.5) / 4.787 = 2.5067
+
+    LatencyHistogram::State low = Histogram({{1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}});
+    LatencyHistogram::State high = Histogram({{6, 1}, {7, 1}, {8, 1}, {9, 1}, {10, 1}});
+
+    if ( !CheckMannWhitney("separated samples", low, high, true, 0.006092890177672409) ) {
+        return false;
+    }
+
+    // With ties: baseline {1, 1, 1, 2, 2, 3}, candidate {2, 3, 3, 3, 4, 4}. U = 32.5 and mean 18, and
+    // tie groups of 3, 3, 4 and 2 values reduce the variance from 39 to 3 * (13 - 114 / 132) = 36.409,
+    // so z = (14.5 - 0.5) / 6.034 = 2.3202
+
+    LatencyHistogram::State tiedBaseline = Histogram({{1, 3}, {2, 2}, {3, 1}});
+    LatencyHistogram::State tiedCandidate = Histogram({{2, 1}, {3, 3}, {4, 2}});
+
+    if ( !CheckMannWhitney("tied samples", tiedBaseline, tiedCandidate, true, 0.010165363147928055) ) {
+        return false;
+    }
+
+    // The other tail: z = (-14.5 - 0.5) / 6.034 = -2.4859
+
+    if ( !CheckMannWhitney("tied samples, smaller", tiedBaseline, tiedCandidate, false, 0.9935390656473443) ) {
+        return false;
+    }
+
+    // Swapping the runs mirrors the test
+
+    if ( !CheckMannWhitney("swapped tied samples", tiedCandidate, tiedBaseline, false, 0.010165363147928055) ) {
+        return false;
+    }
+
+    // Every value tied leaves no variance, and an empty run has nothing to compare
+
+    LatencyHistogram::State tied = Histogram({{5, 20}});
+
+    if ( !CheckMannWhitney("identical samples", tied, tied, true, 1) || !CheckMannWhitney("an empty run", low, LatencyHistogram::State(), true, 1) ) {
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckFisher(const std::string &name, RegressionGate::Proportion baseline, RegressionGate::Proportion candidate, bool lower, double expected) {
+    double pValue = RegressionGate::FisherExactPValue(baseline, candidate, lower);
+
+    if ( !Near(pValue, expected, 1e-6) ) {
+        return Fail("Fisher exact p-value of " + name + " is " + std::to_string(pValue) + ", expected " + std::to_string(expected));
+    }
+
+    return true;
+}
+
+bool CheckFisher() {
+    // Fisher's tea tasting table, 3 of 4 against 1 of 4: P(X <= 1) = (1 + 16) / 70 and
+    // P(X >= 1) = 69 / 70
+
+    if ( !CheckFisher("3/4 against 1/4", {3, 4}, {1, 4}, true, 17.0 / 70.0) || !CheckFisher("3/4 against 1/4, higher", {3, 4}, {1, 4}, false, 69.0 / 70.0) ) {
+        return false;
+    }
+
+    // The most extreme table has a single term, 1 / C(20, 10)
+
+    if ( !CheckFisher("10/10 against 0/10", {10, 10}, {0, 10}, true, 1.0 / 184756.0) ) {
+        return false;
+    }
+
+    // Large counts are summed in log space without overflowing
+
+    if ( !CheckFisher("9000/10000 against 8900/10000", {9000, 10000}, {8900, 10000}, true, 0.011189437400240079) || !CheckFisher("9000/10000 against 8900/10000, higher", {9000, 10000}, {8900, 10000}, false, 0.9900977108442168) ) {
+        return false;
+    }
+
+    // An empty run has nothing to compare
+
+    if ( !CheckFisher("an empty run", {3, 4}, {0, 0}, true, 1) ) {
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    if ( !CheckMannWhitney() || !CheckFisher() ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Regression gate statistics check out" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,450 @@
+//
+//  ShardsBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks sharded record files and times training epochs over preprocessed shards against epochs
+// that decode and resize exported 512x512 JPEGs for every example. Shards are written as the app
+// prepares them for a quantized 224x224 image model, with a one-hot label and an identifier per
+// image, and epochs visit the examples in a new random order each time.
+//
+// usage: net-runner-shards-benchmark [images] [epochs]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include <jpeglib.h>
+
+#include "Image.h"
+#include "RecordFile.h"
+#include "RecordShards.h"
+
+using namespace netrunner::records;
+using netrunner::cli::CropAndResize;
+using netrunner::cli::DecodeImageFile;
+using netrunner::cli::Image;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int kExportSize = 512;
+const int kInputSize = 224;
+const int kClasses = 100;
+
+double Seconds(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Synthetic photos: a smooth gradient with a little noise, encoded at quality 100 like the
+// collect-data export
+
+std::vector<uint8_t> RenderJPEG(size_t index) {
+    std::mt19937 generator(static_cast<uint32_t>(index));
+    std::uniform_int_distribution<int> noise(-12, 12);
+    std::vector<uint8_t> pixels(kExportSize * kExportSize * 3);
+    float phase = static_cast<float>(index) * 0.37f;
+
+    for ( int y = 0; y < kExportSize; y++ ) {
+        for ( int x = 0; x < kExportSize; x++ ) {
+            uint8_t *pixel = &pixels[(y * kExportSize + x) * 3];
+            float r = 127 + 100 * std::sin(x * 0.02f + phase);
+            float g = 127 + 100 * std::cos(y * 0.015f - phase);
+            float b = 127 + 100 * std::sin((x + y) * 0.01f);
+            pixel[0] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(r) + noise(generator))));
+            pixel[1] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(g) + noise(generator))));
+            pixel[2] = static_cast<uint8_t>(std::min(255, std::max(0, static_cast<int>(b) + noise(generator))));
+        }
+    }
+
+    jpeg_compress_struct info;
+    jpeg_error_mgr errorManager;
+    unsigned char *buffer = nullptr;
+    unsigned long length = 0;
+
+    info.err = jpeg_std_error(&errorManager);
+    jpeg_create_compress(&info);
+    jpeg_mem_dest(&info, &buffer, &length);
+
+    info.image_width = kExportSize;
+    info.image_height = kExportSize;
+    info.input_components = 3;
+    info.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&info);
+    jpeg_set_quality(&info, 100, TRUE);
+    jpeg_start_compress(&info, TRUE);
+
+    while ( info.next_scanline < info.image_height ) {
+        JSAMPROW row = &pixels[info.next_scanline * kExportSize * 3];
+        jpeg_write_scanlines(&info, &row, 1);
+    }
+
+    jpeg_finish_compress(&info);
+    jpeg_destroy_compress(&info);
+
+    std::vector<uint8_t> jpeg(buffer, buffer + length);
+    std::free(buffer);
+    return jpeg;
+}
+
+std::string JPEGPath(const std::string &directory, size_t index) {
+    return directory + "/" + std::to_string(index) + ".jpg";
+}
+
+std::vector<float> OneHot(size_t index) {
+    std::vector<float> label(kClasses, 0);
+    label[index % kClasses] = 1;
+    return label;
+}
+
+Schema TrainingSchema() {
+    Schema schema;
+    schema.fields.push_back(FieldSpec::Tensor("image", DType::UInt8, {kInputSize, kInputSize, Image::kChannels}));
+    schema.fields.back().encoding = kPreprocessedEncoding;
+    schema.fields.push_back(FieldSpec::Tensor("class", DType::Float32, {kClasses}));
+    schema.fields.push_back(FieldSpec::Blob("id", "utf8"));
+    return schema;
+}
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+// Small records of varying length across several shards, read back as one sequence
+
+bool CheckShards(const std::string &directory) {
+    Schema schema;
+    schema.fields.push_back(FieldSpec::Tensor("x", DType::Float32, {3}));
+    schema.fields.push_back(FieldSpec::Blob("payload", "bytes"));
+
+    std::string error;
+    const size_t count = 1000;
+
+    for ( size_t maxRecords : {size_t(0), size_t(7), size_t(1)} ) {
+        // Rewriting with fewer shards must leave no stale shards behind
+
+        auto writer = ShardedRecordWriter::Create(directory, schema, {maxRecords == 0 ? 4096u : 0u, maxRecords}, &error);
+
+        if ( writer == nullptr ) {
+            return Fail("Unable to create shards: " + error);
+        }
+
+        for ( size_t i = 0; i < count; i++ ) {
+            float x[3] = {static_cast<float>(i), static_cast<float>(i) * 2, -1};
+            std::string payload(i % 37, static_cast<char>('a' + i % 26));
+            if ( !writer->write({FieldView(x, sizeof(x)), FieldView(payload.data(), payload.size())}, &error) ) {
+                return Fail("Unable to write record: " + error);
+            }
+        }
+
+        size_t shards = writer->shardCount();
+
+        if ( !writer->close(&error) ) {
+            return Fail("Unable to close shards: " + error);
+        }
+
+        auto reader = ShardedRecordReader::Open(directory, &error);
+
+        if ( reader == nullptr ) {
+            return Fail("Unable to open shards: " + error);
+        }
+
+        if ( reader->count() != count || reader->shardCount() != shards || shards < 2 ) {
+            return Fail("Expected " + std::to_string(count) + " records in " + std::to_string(shards) + " shards, read "
+                + std::to_string(reader->count()) + " in " + std::to_string(reader->shardCount()));
+        }
+
+        if ( maxRecords != 0 && shards != (count + maxRecords - 1) / maxRecords ) {
+            return Fail("Shards were not rolled over at " + std::to_string(maxRecords) + " records");
+        }
+
+        for ( size_t i = 0; i < count; i++ ) {
+            std::vector<FieldView> fields = reader->record(i);
+            float x[3];
+            std::memcpy(x, fields[0].data, sizeof(x));
+            std::string payload(reinterpret_cast<const char*>(fields[1].data), fields[1].length);
+
+            if ( x[0] != static_cast<float>(i) || x[1] != static_cast<float>(i) * 2 || payload != std::string(i % 37, static_cast<char>('a' + i % 26)) ) {
+                return Fail("Record " + std::to_string(i) + " did not round trip");
+            }
+        }
+    }
+
+    // A single shard may be opened on its own
+
+    auto single = ShardedRecordReader::Open(ShardPath(directory, 0), &error);
+
+    if ( single == nullptr || single->count() != 1 ) {
+        return Fail("Unable to open a single shard: " + error);
+    }
+
+    // Shards with different schemas are rejected
+
+    Schema other;
+    other.fields.push_back(FieldSpec::Tensor("y", DType::UInt8, {4}));
+    auto mismatched = RecordFileWriter::Create(ShardPath(directory, count), other, &error);
+    uint8_t y[4] = {0};
+
+    if ( mismatched == nullptr || !mismatched->write({FieldView(y, sizeof(y))}, &error) || !mismatched->close(&error) ) {
+        return Fail("Unable to write mismatched shard: " + error);
+    }
+
+    if ( ShardedRecordReader::Open(directory, &error) != nullptr ) {
+        return Fail("Shards with different schemas were opened");
+    }
+
+    for ( size_t shard = 0; shard <= count; shard++ ) {
+        std::remove(ShardPath(directory, shard).c_str());
+    }
+
+    if ( ShardedRecordReader::Open(directory, &error) != nullptr ) {
+        return Fail("An empty directory was opened as shards");
+    }
+
+    return true;
+}
+
+// The export the app performs: decode, crop and resize each image once and write the tensor
+
+bool WriteTrainingShards(const std::string &jpegs, const std::string &shards, size_t images, std::string *error) {
+    auto writer = ShardedRecordWriter::Create(shards, TrainingSchema(), ShardedRecordWriter::Options(), error);
+
+    if ( writer == nullptr ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < images; i++ ) {
+        Image image;
+
+        if ( !DecodeImageFile(JPEGPath(jpegs, i), &image, error) ) {
+            return false;
+        }
+
+        Image input = CropAndResize(image, kInputSize, kInputSize);
+        std::vector<float> label = OneHot(i);
+        std::string identifier = std::to_string(i);
+
+        if ( !writer->write({
+                FieldView(input.pixels.data(), input.pixels.size()),
+                FieldView(label.data(), label.size() * sizeof(float)),
+                FieldView(identifier.data(), identifier.size())}, error) ) {
+            return false;
+        }
+    }
+
+    return writer->close(error);
+}
+
+bool CheckTrainingShards(const ShardedRecordReader &reader, const std::string &jpegs, size_t images) {
+    if ( reader.count() != images || reader.schema() != TrainingSchema() ) {
+        return Fail("Training shards do not match the export");
+    }
+
+    std::string error;
+
+    for ( size_t i = 0; i < images; i += std::max<size_t>(1, images / 16) ) {
+        Image image;
+
+        if ( !DecodeImageFile(JPEGPath(jpegs, i), &image, &error) ) {
+            return Fail(error);
+        }
+
+        Image input = CropAndResize(image, kInputSize, kInputSize);
+        std::vector<float> label = OneHot(i);
+        FieldView tensor = reader.field(i, 0);
+        FieldView classes = reader.field(i, 1);
+        FieldView identifier = reader.field(i, 2);
+
+        if ( tensor.length != input.pixels.size() || std::memcmp(tensor.data, input.pixels.data(), tensor.length) != 0
+            || classes.length != label.size() * sizeof(float) || std::memcmp(classes.data, label.data(), classes.length) != 0
+            || std::string(reinterpret_cast<const char*>(identifier.data), identifier.length) != std::to_string(i) ) {
+            return Fail("Training record " + std::to_string(i) + " does not match its preprocessed image");
+        }
+    }
+
+    return true;
+}
+
+// An epoch copies every example's input and label into the model's tensors, in a random order
+
+double EpochFromJPEGs(const std::string &jpegs, const std::vector<size_t> &order, uint64_t *checksum) {
+    std::vector<uint8_t> input(kInputSize * kInputSize * Image::kChannels);
+    std::vector<float> classes(kClasses);
+    std::string error;
+
+    Clock::time_point start = Clock::now();
+
+    for ( size_t i : order ) {
+        Image image;
+
+        if ( !DecodeImageFile(JPEGPath(jpegs, i), &image, &error) ) {
+            std::cerr << error << std::endl;
+            return -1;
+        }
+
+        Image resized = CropAndResize(image, kInputSize, kInputSize);
+        std::vector<float> label = OneHot(i);
+        std::memcpy(input.data(), resized.pixels.data(), input.size());
+        std::memcpy(classes.data(), label.data(), classes.size() * sizeof(float));
+        *checksum += input[i % input.size()];
+    }
+
+    return Seconds(start);
+}
+
+double EpochFromShards(const ShardedRecordReader &reader, const std::vector<size_t> &order, uint64_t *checksum) {
+    std::vector<uint8_t> input(kInputSize * kInputSize * Image::kChannels);
+    std::vector<float> classes(kClasses);
+
+    Clock::time_point start = Clock::now();
+
+    for ( size_t i : order ) {
+        FieldView tensor = reader.field(i, 0);
+        FieldView label = reader.field(i, 1);
+        std::memcpy(input.data(), tensor.data, input.size());
+        std::memcpy(classes.data(), label.data, classes.size() * sizeof(float));
+        *checksum += input[i % input.size()];
+    }
+
+    return Seconds(start);
+}
+
+uint64_t DirectorySize(const std::string &directory, size_t images) {
+    uint64_t size = 0;
+    struct stat st;
+
+    for ( size_t i = 0; i < images; i++ ) {
+        if ( ::stat(JPEGPath(directory, i).c_str(), &st) == 0 ) {
+            size += static_cast<uint64_t>(st.st_size);
+        }
+    }
+
+    return size;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long imageCount = argc > 1 ? std::atol(argv[1]) : 1000;
+    const long epochCount = argc > 2 ? std::atol(argv[2]) : 3;
+
+    if ( imageCount <= 0 || epochCount <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [images] [epochs]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string directory = std::string(P_tmpdir) + "/net-runner-shards-benchmark";
+    std::string checks = directory + "/checks";
+    std::string jpegs = directory + "/jpegs";
+    std::string shards = directory + "/shards";
+
+    ::mkdir(directory.c_str(), 0755);
+    ::mkdir(jpegs.c_str(), 0755);
+
+    if ( !CheckShards(checks) ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Shards check out" << std::endl;
+
+    // Export the images as the collect-data flow does, then prepare shards from them
+
+    size_t images = static_cast<size_t>(imageCount);
+
+    for ( size_t i = 0; i < images; i++ ) {
+        std::vector<uint8_t> jpeg = RenderJPEG(i);
+        std::ofstream(JPEGPath(jpegs, i), std::ios::binary).write(reinterpret_cast<const char*>(jpeg.data()), static_cast<std::streamsize>(jpeg.size()));
+    }
+
+    std::string error;
+    Clock::time_point start = Clock::now();
+
+    if ( !WriteTrainingShards(jpegs, shards, images, &error) ) {
+        std::cerr << "Unable to write training shards: " << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    double exportSeconds = Seconds(start);
+    auto reader = ShardedRecordReader::Open(shards, &error);
+
+    if ( reader == nullptr ) {
+        std::cerr << "Unable to open training shards: " << error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ( !CheckTrainingShards(*reader, jpegs, images) ) {
+        return EXIT_FAILURE;
+    }
+
+    // Both sources see the same shuffles and must produce the same inputs
+
+    std::vector<size_t> order(images);
+    std::iota(order.begin(), order.end(), 0);
+    std::mt19937 generator(7);
+
+    double jpegSeconds = 0, shardSeconds = 0;
+    uint64_t jpegChecksum = 0, shardChecksum = 0;
+
+    for ( long epoch = 0; epoch < epochCount; epoch++ ) {
+        std::shuffle(order.begin(), order.end(), generator);
+        jpegSeconds += EpochFromJPEGs(jpegs, order, &jpegChecksum);
+        shardSeconds += EpochFromShards(*reader, order, &shardChecksum);
+    }
+
+    if ( jpegChecksum != shardChecksum ) {
+        std::cerr << "Epochs over JPEGs and shards produced different inputs" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << std::fixed << std::setprecision(2)
+        << images << " images, JPEGs: " << DirectorySize(jpegs, images) / 1e6 << " MB"
+        << ", shards: " << reader->size() / 1e6 << " MB in " << reader->shardCount() << " shards, prepared in " << exportSeconds << "s" << std::endl
+        << "epoch from JPEGs: " << jpegSeconds / epochCount * 1e3 << " ms"
+        << ", " << jpegSeconds / epochCount / images * 1e6 << " us/image" << std::endl
+        << "epoch from shards: " << shardSeconds / epochCount * 1e3 << " ms"
+        << ", " << shardSeconds / epochCount / images * 1e6 << " us/image" << std::endl;
+
+    reader.reset();
+
+    for ( size_t shard = 0; shard < images; shard++ ) {
+        std::remove(ShardPath(shards, shard).c_str());
+    }
+    for ( size_t i = 0; i < images; i++ ) {
+        std::remove(JPEGPath(jpegs, i).c_str());
+    }
+    ::rmdir(checks.c_str());
+    ::rmdir(shards.c_str());
+    ::rmdir(jpegs.c_str());
+    ::rmdir(directory.c_str());
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,308 @@
+//
+//  SmoothingBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+// Checks the score smoother's SIMD kernels against scalar references and times a frame of each
+// kind of smoothing at 1,000 and 20,000 classes. A frame copies the scores from a float or
+// quantized output tensor into the dense vector, as the app does, then updates the smoother and
+// takes the top 5. For comparison it also times filling the vector by label lookup, as the app
+// does when it cannot read the output tensor, and a string keyed emulation of the previous
+// dictionary based decay, which maps every label to its score, sorts the labels over the
+// threshold and decays the top 5. TensorIO boxes every score into a dictionary in all cases,
+// which is not timed.
+//
+// usage: net-runner-smoothing-benchmark [frames]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ScoreSmoother.h"
+
+using netrunner::ScoreSmoother;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Softmax-like frames in which a few classes dominate and the dominant classes drift
+
+std::vector<std::vector<float>> Frames(size_t classes, size_t count) {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> noise(0, 1);
+    std::uniform_int_distribution<size_t> pick(0, classes - 1);
+    std::vector<std::vector<float>> frames(count, std::vector<float>(classes));
+    size_t leader = pick(generator);
+
+    for ( auto &frame : frames ) {
+        if ( noise(generator) < 0.05f ) {
+            leader = pick(generator);
+        }
+        float sum = 0;
+        for ( size_t i = 0; i < classes; i++ ) {
+            frame[i] = std::pow(noise(generator), 8.0f);
+            sum += frame[i];
+        }
+        frame[leader] += sum;
+        for ( float &score : frame ) {
+            score /= 2 * sum;
+        }
+    }
+
+    return frames;
+}
+
+bool CheckKernels() {
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> value(0, 1);
+
+    for ( size_t count : {0, 1, 3, 4, 5, 1000, 1001} ) {
+        std::vector<float> state(count), scores(count), subtract(count);
+        for ( size_t i = 0; i < count; i++ ) {
+            state[i] = value(generator);
+            scores[i] = value(generator);
+            subtract[i] = value(generator);
+        }
+
+        std::vector<float> blended = state, summed = state, scaled(count);
+        ScoreSmoother::Blend(blended.data(), scores.data(), count, 0.7f);
+        ScoreSmoother::Accumulate(summed.data(), scores.data(), subtract.data(), count);
+        ScoreSmoother::Scale(scaled.data(), scores.data(), count, 0.25f);
+
+        for ( size_t i = 0; i < count; i++ ) {
+            if ( std::abs(blended[i] - (state[i] * 0.7f + scores[i] * 0.3f)) > 1e-6f
+                || std::abs(summed[i] - (state[i] + (scores[i] - subtract[i]))) > 1e-6f
+                || std::abs(scaled[i] - scores[i] * 0.25f) > 1e-6f ) {
+                std::cerr << "Kernel mismatch at " << i << " of " << count << std::endl;
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Checks top against a full sort of the smoothed scores
+
+bool CheckTop(const std::vector<std::vector<float>> &frames, size_t classes) {
+    ScoreSmoother smoother(classes);
+    std::vector<ScoreSmoother::Entry> top;
+
+    for ( const auto &frame : frames ) {
+        smoother.update(frame.data());
+    }
+
+    smoother.top(5, 0.01f, &top);
+
+    std::vector<ScoreSmoother::Entry> all;
+    for ( size_t i = 0; i < classes; i++ ) {
+        if ( smoother.scores()[i] > 0.01f ) {
+            all.push_back({static_cast<uint32_t>(i), smoother.scores()[i]});
+        }
+    }
+    std::sort(all.begin(), all.end(), [](const ScoreSmoother::Entry &a, const ScoreSmoother::Entry &b) {
+        return a.score > b.score || (a.score == b.score && a.index < b.index);
+    });
+    all.resize(std::min<size_t>(all.size(), 5));
+
+    if ( all.size() != top.size() || !std::equal(all.begin(), all.end(), top.begin(), [](const ScoreSmoother::Entry &a, const ScoreSmoother::Entry &b) {
+        return a.index == b.index && a.score == b.score;
+    }) ) {
+        std::cerr << "Top classes do not match a full sort at " << classes << " classes" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+double MicrosecondsPerFrame(Clock::time_point start, size_t frames) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / frames;
+}
+
+// Frames are float output tensors, copied into the dense vector before each update
+
+double TimeSmoother(const std::vector<std::vector<float>> &frames, ScoreSmoother::Mode mode) {
+    ScoreSmoother::Options options;
+    options.mode = mode;
+    ScoreSmoother smoother(frames.front().size(), options);
+    std::vector<float> scores(frames.front().size());
+    std::vector<ScoreSmoother::Entry> top;
+    volatile float sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( const auto &frame : frames ) {
+        std::memcpy(scores.data(), frame.data(), frame.size() * sizeof(float));
+        smoother.update(scores.data());
+        smoother.top(5, 0.1f, &top);
+        sink = sink + (top.empty() ? 0 : top.front().score);
+    }
+    return MicrosecondsPerFrame(start, frames.size());
+}
+
+// Frames are quantized output tensors, dequantized through a table built per frame
+
+double TimeQuantizedSmoother(const std::vector<std::vector<uint8_t>> &frames) {
+    ScoreSmoother smoother(frames.front().size());
+    std::vector<float> scores(frames.front().size());
+    std::vector<ScoreSmoother::Entry> top;
+    volatile float sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( const auto &frame : frames ) {
+        float table[256];
+        for ( int value = 0; value < 256; value++ ) {
+            table[value] = value / 255.0f;
+        }
+        for ( size_t i = 0; i < frame.size(); i++ ) {
+            scores[i] = table[frame[i]];
+        }
+        smoother.update(scores.data());
+        smoother.top(5, 0.1f, &top);
+        sink = sink + (top.empty() ? 0 : top.front().score);
+    }
+    return MicrosecondsPerFrame(start, frames.size());
+}
+
+// Frames are label keyed maps, as TensorIO returns them, whose scores are looked up by label
+
+double TimeLabelLookup(const std::vector<std::unordered_map<std::string, float>> &frames, const std::vector<std::string> &labels) {
+    std::unordered_map<std::string, size_t> indexes;
+    for ( size_t i = 0; i < labels.size(); i++ ) {
+        indexes[labels[i]] = i;
+    }
+
+    ScoreSmoother smoother(labels.size());
+    std::vector<float> scores(labels.size());
+    std::vector<ScoreSmoother::Entry> top;
+    volatile float sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( const auto &frame : frames ) {
+        std::fill(scores.begin(), scores.end(), 0.0f);
+        for ( const auto &score : frame ) {
+            scores[indexes.find(score.first)->second] = score.second;
+        }
+        smoother.update(scores.data());
+        smoother.top(5, 0.1f, &top);
+        sink = sink + (top.empty() ? 0 : top.front().score);
+    }
+    return MicrosecondsPerFrame(start, frames.size());
+}
+
+double TimeStringKeyed(const std::vector<std::vector<float>> &frames, const std::vector<std::string> &labels) {
+    std::unordered_map<std::string, float> previous;
+    volatile size_t sink = 0;
+
+    Clock::time_point start = Clock::now();
+    for ( const auto &frame : frames ) {
+        std::unordered_map<std::string, float> scores;
+        for ( size_t i = 0; i < labels.size(); i++ ) {
+            scores[labels[i]] = frame[i];
+        }
+
+        std::vector<std::pair<std::string, float>> sorted;
+        for ( const auto &score : scores ) {
+            if ( score.second > 0.1f ) {
+                sorted.push_back(score);
+            }
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<std::string, float> &a, const std::pair<std::string, float> &b) {
+            return a.second > b.second;
+        });
+        sorted.resize(std::min<size_t>(sorted.size(), 5));
+
+        std::unordered_map<std::string, float> decayed;
+        for ( const auto &score : previous ) {
+            decayed[score.first] = score.second * 0.7f;
+        }
+        for ( const auto &score : sorted ) {
+            decayed[score.first] += score.second * 0.3f;
+        }
+        for ( auto it = decayed.begin(); it != decayed.end(); ) {
+            it = it->second < 0.01f ? decayed.erase(it) : std::next(it);
+        }
+
+        previous.swap(decayed);
+        sink = sink + previous.size();
+    }
+    return MicrosecondsPerFrame(start, frames.size());
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const long frameCount = argc > 1 ? std::atol(argv[1]) : 500;
+
+    if ( frameCount <= 0 ) {
+        std::cerr << "usage: " << argv[0] << " [frames]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if ( !CheckKernels() ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Kernels match the scalar references" << std::endl;
+
+    for ( size_t classes : {1000, 20000} ) {
+        std::vector<std::vector<float>> frames = Frames(classes, static_cast<size_t>(frameCount));
+        std::vector<std::string> labels;
+        for ( size_t i = 0; i < classes; i++ ) {
+            labels.push_back("n" + std::to_string(1000000 + i) + " label");
+        }
+
+        if ( !CheckTop(frames, classes) ) {
+            return EXIT_FAILURE;
+        }
+
+        std::vector<std::vector<uint8_t>> quantizedFrames;
+        std::vector<std::unordered_map<std::string, float>> labeledFrames;
+        for ( const auto &frame : frames ) {
+            std::vector<uint8_t> quantized(classes);
+            std::unordered_map<std::string, float> labeled;
+            for ( size_t i = 0; i < classes; i++ ) {
+                quantized[i] = static_cast<uint8_t>(std::lround(frame[i] * 255));
+                labeled[labels[i]] = frame[i];
+            }
+            quantizedFrames.push_back(std::move(quantized));
+            labeledFrames.push_back(std::move(labeled));
+        }
+
+        std::cout << std::fixed << std::setprecision(1)
+            << classes << " classes, per frame from the output tensor: "
+            << "exponential " << TimeSmoother(frames, ScoreSmoother::Mode::Exponential) << "us"
+            << ", windowed mean " << TimeSmoother(frames, ScoreSmoother::Mode::WindowedMean) << "us"
+            << ", hysteresis " << TimeSmoother(frames, ScoreSmoother::Mode::Hysteresis) << "us"
+            << ", quantized exponential " << TimeQuantizedSmoother(quantizedFrames) << "us"
+            << "; from labeled scores: exponential " << TimeLabelLookup(labeledFrames, labels) << "us"
+            << ", string keyed " << TimeStringKeyed(frames, labels) << "us"
+            << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,392 @@
+//
+//  SteadyStateTest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+// Checks the steady state benchmark against a fake model and a fake clock: that warm-up runs are
+// discarded, the confidence interval of the mean against known answers, each stopping rule, and
+// the thermal wait and throttling analysis.
+//
+// usage: net-runner-steady-state-test
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "SteadyStateBenchmark.h"
+
+using namespace netrunner;
+
+namespace {
+
+bool Fail(const std::string &message) {
+    std::cerr << message << std::endl;
+    return false;
+}
+
+bool Near(double value, double expected, double tolerance) {
+    return std::fabs(value - expected) <= tolerance;
+}
+
+// Time only passes when the model runs or the benchmark sleeps
+
+class FakeClock : public BenchmarkClock {
+public:
+    double now() override { return time; }
+    void sleep(double milliseconds) override { time += milliseconds; }
+
+    double time = 0;
+};
+
+// Runs through a fixed sequence of latencies, repeating the last one, advancing the clock by each
+
+class FakeModel {
+public:
+    FakeModel(FakeClock *clock, std::vector<double> latencies) : _clock(clock), _latencies(latencies) {}
+
+    bool operator()(double *latency) {
+        *latency = _latencies[std::min(runs, _latencies.size() - 1)];
+        _clock->time += *latency;
+        runs += 1;
+        return true;
+    }
+
+    size_t runs = 0;
+
+private:
+    FakeClock *_clock;
+    std::vector<double> _latencies;
+};
+
+// Alternates between two latencies forever
+
+std::vector<double> Alternating(double a, double b, size_t count) {
+    std::vector<double> latencies;
+    for ( size_t i = 0; i < count; i++ ) {
+        latencies.push_back(i % 2 == 0 ? a : b);
+    }
+    return latencies;
+}
+
+SteadyStateBenchmark::Options TestOptions() {
+    SteadyStateBenchmark::Options options;
+    options.warmupRuns = 0;
+    options.minRuns = 2;
+    options.maxRuns = 1000;
+    options.maxDuration = 0;
+    options.window = 0;
+    return options;
+}
+
+bool CheckStudentT() {
+    // Two-sided 95% critical values from the standard tables
+
+    struct { unsigned df; double t; } table[] = {{1, 12.706}, {2, 4.303}, {5, 2.571}, {9, 2.262}, {30, 2.042}, {1000, 1.962}};
+
+    for ( auto row : table ) {
+        double t = SteadyStateBenchmark::StudentT(0.95, row.df);
+        if ( !Near(t, row.t, 0.002) ) {
+            return Fail("Student's t for " + std::to_string(row.df) + " degrees of freedom is " + std::to_string(t) + ", expected " + std::to_string(row.t));
+        }
+    }
+
+    if ( !Near(SteadyStateBenchmark::StudentT(0.99, 10), 3.169, 0.005) ) {
+        return Fail("Student's t at 99% for 10 degrees of freedom is wrong");
+    }
+
+    return true;
+}
+
+bool CheckWarmup() {
+    // Five slow first inferences followed by a steady 10ms
+
+    FakeClock clock;
+    FakeModel model(&clock, {80, 60, 40, 30, 20, 10});
+
+    SteadyStateBenchmark::Options options = TestOptions();
+    options.warmupRuns = 5;
+    options.minRuns = 10;
+
+    SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+    if ( result.warmupRuns != 5 || model.runs != 5 + result.runs ) {
+        return Fail("Warm-up runs were not performed exactly once each");
+    }
+
+    for ( double latency : result.latencies ) {
+        if ( latency != 10 ) {
+            return Fail("A warm-up latency was measured");
+        }
+    }
+
+    if ( result.timestamps.front() != 10 ) {
+        return Fail("Warm-up time was included in the measured time");
+    }
+
+    if ( result.steadyStateLatency != 10 || result.confidenceInterval != 0 ) {
+        return Fail("Steady state latency is " + std::to_string(result.steadyStateLatency) + ", expected 10");
+    }
+
+    // Without warm-up the slow runs skew the mean
+
+    FakeClock coldClock;
+    FakeModel coldModel(&coldClock, {80, 60, 40, 30, 20, 10});
+
+    SteadyStateBenchmark::Options coldOptions = options;
+    coldOptions.warmupRuns = 0;
+    coldOptions.maxRuns = 10;
+
+    SteadyStateBenchmark::Result cold = SteadyStateBenchmark(coldOptions, &coldClock).run(std::ref(coldModel));
+
+    if ( !Near(cold.steadyStateLatency, 28, 1e-9) ) {
+        return Fail("Latency without warm-up is " + std::to_string(cold.steadyStateLatency) + ", expected 28");
+    }
+
+    return true;
+}
+
+bool CheckConfidenceInterval() {
+    // 9, 11, ... over ten runs: mean 10, sample standard deviation sqrt(10/9), and a 95% half-width
+    // of t(9) * sd / sqrt(10) = 2.2622 * 1.0541 / 3.1623 = 0.7541
+
+    FakeClock clock;
+    FakeModel model(&clock, Alternating(9, 11, 10));
+
+    SteadyStateBenchmark::Options options = TestOptions();
+    options.relativeError = 0;
+    options.maxRuns = 10;
+
+    SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+    if ( result.steadyStateLatency != 10 ) {
+        return Fail("Mean latency is " + std::to_string(result.steadyStateLatency) + ", expected 10");
+    }
+
+    if ( !Near(result.confidenceInterval, 0.7541, 0.001) || !Near(result.relativeError, 0.07541, 0.0001) ) {
+        return Fail("Confidence interval is " + std::to_string(result.confidenceInterval) + ", expected 0.7541");
+    }
+
+    // Only the trailing window counts: five runs at 50 then ten runs at 9, 11, ...
+
+    std::vector<double> latencies(5, 50);
+    std::vector<double> alternating = Alternating(9, 11, 10);
+    latencies.insert(latencies.end(), alternating.begin(), alternating.end());
+
+    FakeClock windowClock;
+    FakeModel windowModel(&windowClock, latencies);
+
+    options.window = 10;
+    options.minRuns = 15;
+    options.maxRuns = 15;
+
+    SteadyStateBenchmark::Result windowed = SteadyStateBenchmark(options, &windowClock).run(std::ref(windowModel));
+
+    if ( windowed.runs != 15 || windowed.steadyStateLatency != 10 || !Near(windowed.confidenceInterval, 0.7541, 0.001) ) {
+        return Fail("Confidence interval did not use the trailing window");
+    }
+
+    return true;
+}
+
+bool CheckStoppingRules() {
+    // A constant latency converges as soon as the minimum number of runs is reached
+
+    {
+        FakeClock clock;
+        FakeModel model(&clock, {10});
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.minRuns = 12;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( result.stopReason != SteadyStateBenchmark::StopReason::Converged || result.runs != 12 ) {
+            return Fail("Constant latency stopped with " + SteadyStateBenchmark::StopReasonName(result.stopReason) + " after " + std::to_string(result.runs) + " runs, expected converged after 12");
+        }
+    }
+
+    // 9, 11, ... has a relative half-width of 0.18, 0.139, 0.115, 0.100 and 0.089 after four to
+    // eight runs, so it first falls within 9.5% after eight
+
+    {
+        FakeClock clock;
+        FakeModel model(&clock, Alternating(9, 11, 100));
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.minRuns = 4;
+        options.relativeError = 0.095;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( !result.converged() || result.runs != 8 || result.relativeError > 0.095 ) {
+            return Fail("Alternating latency converged after " + std::to_string(result.runs) + " runs, expected 8");
+        }
+    }
+
+    // Noisy latency that never converges stops at the run limit
+
+    {
+        FakeClock clock;
+        FakeModel model(&clock, Alternating(5, 15, 100));
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.relativeError = 0.001;
+        options.maxRuns = 50;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( result.stopReason != SteadyStateBenchmark::StopReason::MaxRuns || result.runs != 50 ) {
+            return Fail("Noisy latency did not stop at the run limit");
+        }
+    }
+
+    // Or at the time limit, which excludes warm-up but includes cooldowns: after three warm-up runs
+    // each measured run takes 15 or 5ms plus a 5ms cooldown, so 100ms is passed after seven runs
+
+    {
+        FakeClock clock;
+        FakeModel model(&clock, Alternating(5, 15, 100));
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.warmupRuns = 3;
+        options.relativeError = 0.001;
+        options.maxDuration = 100;
+        options.cooldown = 5;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( result.stopReason != SteadyStateBenchmark::StopReason::MaxDuration || result.runs != 7 || result.duration != 110 ) {
+            return Fail("Noisy latency stopped after " + std::to_string(result.runs) + " runs and " + std::to_string(result.duration) + "ms, expected the time limit after 7 runs");
+        }
+
+        if ( result.timestamps[1] - result.timestamps[0] != 10 ) {
+            return Fail("Cooldown was not included between runs");
+        }
+    }
+
+    // A model that keeps failing is given up on
+
+    {
+        FakeClock clock;
+        unsigned calls = 0;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(TestOptions(), &clock).run([&](double *) {
+            calls += 1;
+            return false;
+        });
+
+        if ( result.stopReason != SteadyStateBenchmark::StopReason::Failed || result.runs != 0 || result.failedRuns != SteadyStateBenchmark::kMaxConsecutiveFailures || calls != SteadyStateBenchmark::kMaxConsecutiveFailures ) {
+            return Fail("A failing model was not given up on");
+        }
+    }
+
+    // Occasional failures are skipped without being measured
+
+    {
+        FakeClock clock;
+        unsigned calls = 0;
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.minRuns = 10;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run([&](double *latency) {
+            *latency = 10;
+            return ++calls % 3 != 0;
+        });
+
+        if ( !result.converged() || result.runs != 10 || result.failedRuns != 4 ) {
+            return Fail("Occasional failures were measured or stopped the benchmark");
+        }
+    }
+
+    return true;
+}
+
+bool CheckThrottling() {
+    // A hot device is waited on in steps until it cools
+
+    {
+        FakeClock clock;
+        FakeModel model(&clock, {10});
+        unsigned polls = 0;
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.minRuns = 10;
+        options.thermalCooldownStep = 500;
+        options.thermalState = [&]() { return ++polls <= 3 ? 2 : 0; };
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( result.thermalWait != 1500 || result.maxThermalState != 2 || !result.throttled ) {
+            return Fail("Thermal wait was " + std::to_string(result.thermalWait) + "ms, expected 1500ms and a throttled result");
+        }
+    }
+
+    // Latency that rises over the run is flagged, steady latency is not
+
+    {
+        std::vector<double> latencies;
+        for ( int i = 0; i < 40; i++ ) {
+            latencies.push_back(10 + i * 0.25);
+        }
+
+        FakeClock clock;
+        FakeModel model(&clock, latencies);
+
+        SteadyStateBenchmark::Options options = TestOptions();
+        options.relativeError = 0;
+        options.maxRuns = 40;
+
+        SteadyStateBenchmark::Result result = SteadyStateBenchmark(options, &clock).run(std::ref(model));
+
+        if ( !result.throttled || result.trend <= 0 || result.throttlingRatio < 1.5 ) {
+            return Fail("Rising latency was not flagged as throttled");
+        }
+
+        FakeClock steadyClock;
+        FakeModel steadyModel(&steadyClock, Alternating(9, 11, 40));
+
+        SteadyStateBenchmark::Result steady = SteadyStateBenchmark(options, &steadyClock).run(std::ref(steadyModel));
+
+        if ( steady.throttled ) {
+            return Fail("Steady latency was flagged as throttled");
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+int main() {
+    bool passed = CheckStudentT()
+        && CheckWarmup()
+        && CheckConfidenceInterval()
+        && CheckStoppingRules()
+        && CheckThrottling();
+
+    if ( !passed ) {
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Steady state benchmark checks out" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,208 @@
+//
+//  SummaryRegressionGate.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "SummaryRegressionGate.h"
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+const char * const kSummaryKeyModel = "model";
+const char * const kSummaryKeyTestBundle = "test_bundle";
+const char * const kSummaryKeyHistogram = "histogram";
+const char * const kSummaryKeyAccuracyCounts = "accuracy_counts";
+
+bool ReadThresholds(const Json::Value &dictionary, RegressionGate::Thresholds *thresholds, std::string *error) {
+    if ( !dictionary.isObject() ) {
+        SetError(error, "Regression thresholds must be a dictionary");
+        return false;
+    }
+
+    for ( const char *key : {"alpha", "latency_increase", "accuracy_decrease", "minimum_samples"} ) {
+        if ( dictionary.isMember(key) && (!dictionary[key].isNumeric() || dictionary[key].asDouble() < 0) ) {
+            SetError(error, std::string("Regression threshold ") + key + " must be a non-negative number");
+            return false;
+        }
+    }
+
+    thresholds->alpha = dictionary.get("alpha", thresholds->alpha).asDouble();
+    thresholds->latencyIncrease = dictionary.get("latency_increase", thresholds->latencyIncrease).asDouble();
+    thresholds->accuracyDecrease = dictionary.get("accuracy_decrease", thresholds->accuracyDecrease).asDouble();
+    thresholds->minimumSamples = static_cast<uint64_t>(dictionary.get("minimum_samples", static_cast<Json::UInt64>(thresholds->minimumSamples)).asDouble());
+
+    return true;
+}
+
+bool ReadHistogram(const Json::Value &dictionary, LatencyHistogram::State *state) {
+    if ( !dictionary.isObject() || !dictionary["buckets"].isArray() ) {
+        return false;
+    }
+
+    state->minMicros = dictionary.get("min", 0).asUInt64();
+    state->maxMicros = dictionary.get("max", 0).asUInt64();
+    state->sum = dictionary.get("sum", 0).asDouble();
+    state->sumOfSquares = dictionary.get("sum_of_squares", 0).asDouble();
+
+    for ( const Json::Value &pair : dictionary["buckets"] ) {
+        if ( !pair.isArray() || pair.size() != 2 || !pair[0].isUInt() || !pair[1].isUInt64()
+            || pair[0].asUInt() >= LatencyHistogram::kBucketCount ) {
+            return false;
+        }
+        state->buckets.push_back({pair[0].asUInt(), pair[1].asUInt64()});
+    }
+
+    return true;
+}
+
+} // namespace
+
+bool ReadRegressionGate(const Json::Value &thresholds, RegressionGate *gate, std::string *error) {
+    RegressionGate::Thresholds defaults;
+
+    if ( !thresholds.isNull() && !ReadThresholds(thresholds, &defaults, error) ) {
+        return false;
+    }
+
+    *gate = RegressionGate(defaults);
+
+    const Json::Value &models = thresholds.isObject() ? thresholds["models"] : Json::Value::null;
+
+    if ( !models.isNull() && !models.isObject() ) {
+        SetError(error, "Regression thresholds for models must be a dictionary keyed by model id");
+        return false;
+    }
+
+    for ( const std::string &model : models.getMemberNames() ) {
+        RegressionGate::Thresholds overrides = defaults;
+        if ( !ReadThresholds(models[model], &overrides, error) ) {
+            return false;
+        }
+        gate->setThresholds(model, overrides);
+    }
+
+    return true;
+}
+
+bool ReadRegressionSamples(const Json::Value &summary, std::vector<RegressionGate::ModelSamples> *models, std::string *error) {
+    const Json::Value &entries = summary.isObject() ? summary["summary"] : summary;
+
+    if ( !entries.isArray() ) {
+        SetError(error, "A summary must be an array of model summaries or a dictionary with one under \"summary\"");
+        return false;
+    }
+
+    for ( const Json::Value &entry : entries ) {
+        if ( !entry.isObject() || !entry[kSummaryKeyModel].isString() ) {
+            SetError(error, "A model summary is missing its model");
+            return false;
+        }
+
+        RegressionGate::ModelSamples model;
+        model.model = entry[kSummaryKeyModel].asString();
+        model.testBundle = entry.get(kSummaryKeyTestBundle, "").asString();
+
+        for ( const std::string &name : entry.getMemberNames() ) {
+            const Json::Value &value = entry[name];
+
+            if ( !value.isObject() || !value.isMember(kSummaryKeyHistogram) ) {
+                continue;
+            }
+
+            LatencyHistogram::State state;
+
+            if ( !ReadHistogram(value[kSummaryKeyHistogram], &state) ) {
+                SetError(error, "The " + name + " histogram of model " + model.model + " is malformed");
+                return false;
+            }
+
+            model.latencies.push_back({name, state});
+        }
+
+        const Json::Value &accuracies = entry[kSummaryKeyAccuracyCounts];
+
+        for ( const std::string &name : accuracies.isObject() ? accuracies.getMemberNames() : std::vector<std::string>() ) {
+            const Json::Value &counts = accuracies[name];
+
+            if ( !counts.isObject() || !counts["correct"].isUInt64() || !counts["count"].isUInt64() ) {
+                SetError(error, "The " + name + " accuracy counts of model " + model.model + " are malformed");
+                return false;
+            }
+
+            RegressionGate::Proportion proportion;
+            proportion.correct = counts["correct"].asUInt64();
+            proportion.count = counts["count"].asUInt64();
+            model.accuracies.push_back({name, proportion});
+        }
+
+        models->push_back(model);
+    }
+
+    return true;
+}
+
+Json::Value RegressionVerdictDictionary(const RegressionGate::Result &result) {
+    Json::Value verdict(Json::objectValue);
+    Json::Value models(Json::arrayValue);
+
+    for ( const RegressionGate::ModelResult &model : result.models ) {
+        Json::Value dictionary(Json::objectValue);
+        Json::Value checks(Json::arrayValue);
+
+        for ( const RegressionGate::Check &check : model.checks ) {
+            Json::Value entry(Json::objectValue);
+            entry["name"] = check.name;
+            entry["kind"] = RegressionGate::KindName(check.kind);
+            entry["verdict"] = RegressionGate::VerdictName(check.verdict);
+            entry["baseline"] = check.baseline;
+            entry["candidate"] = check.candidate;
+            entry["change"] = check.change;
+            entry["p_value"] = check.pValue;
+            entry["threshold"] = check.threshold;
+            entry["baseline_count"] = static_cast<Json::UInt64>(check.baselineCount);
+            entry["candidate_count"] = static_cast<Json::UInt64>(check.candidateCount);
+            checks.append(entry);
+        }
+
+        if ( !model.testBundle.empty() ) {
+            dictionary[kSummaryKeyTestBundle] = model.testBundle;
+        }
+
+        dictionary[kSummaryKeyModel] = model.model;
+        dictionary["verdict"] = RegressionGate::VerdictName(model.verdict);
+        dictionary["checks"] = checks;
+        models.append(dictionary);
+    }
+
+    verdict["passed"] = result.passed;
+    verdict["regressions"] = static_cast<Json::UInt64>(result.regressions);
+    verdict["models"] = models;
+
+    return verdict;
+}
+
+} // namespace cli
+} // namespace netrunner
@@ -0,0 +1,62 @@
+//
+//  SummaryRegressionGate.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef SummaryRegressionGate_h
+#define SummaryRegressionGate_h
+
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "RegressionGate.h"
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * Reads a regression gate's thresholds from a dictionary with optional "alpha",
+ * "latency_increase", "accuracy_decrease" and "minimum_samples" entries, and a "models"
+ * dictionary overriding any of them for individual models by model id. Other entries, such as
+ * a test bundle's "baseline", are ignored. Returns false and sets error if an entry is not a
+ * non-negative number.
+ */
+
+bool ReadRegressionGate(const Json::Value &thresholds, RegressionGate *gate, std::string *error);
+
+/**
+ * Reads the models of a summary, either an array of model summaries or a dictionary with one
+ * under "summary" as the app shares and `--summary` writes, for comparison by a regression gate.
+ * Latencies are read from the "histogram" of each latency distribution and accuracies from
+ * "accuracy_counts". Returns false and sets error if the summary is malformed.
+ */
+
+bool ReadRegressionSamples(const Json::Value &summary, std::vector<RegressionGate::ModelSamples> *models, std::string *error);
+
+/**
+ * The regression gate's verdict as a dictionary, see the README for its entries.
+ */
+
+Json::Value RegressionVerdictDictionary(const RegressionGate::Result &result);
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* SummaryRegressionGate_h */
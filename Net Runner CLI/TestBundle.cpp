@@ -0,0 +1,99 @@
+//
+//  TestBundle.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "TestBundle.h"
+
+#include "ModelBundle.h"
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+std::shared_ptr<TestBundle> TestBundle::Load(const std::string &path, std::string *error) {
+    std::shared_ptr<TestBundle> bundle(new TestBundle());
+    bundle->_path = path;
+
+    Json::Value json;
+
+    if ( !ReadJSONFile(JoinPath(path, "test.json"), &json, error) ) {
+        return nullptr;
+    }
+
+    if ( !json.isMember("name") || !json.isMember("id") || !json.isMember("version")
+        || !json["models"].isArray() || !json["options"].isObject() || !json["images"].isArray() ) {
+        SetError(error, "Test bundle at " + path + " requires name, id, version, models, options and images");
+        return nullptr;
+    }
+
+    bundle->_name = json["name"].asString();
+    bundle->_identifier = json["id"].asString();
+    bundle->_version = json["version"].asString();
+
+    for ( const Json::Value &modelId : json["models"] ) {
+        bundle->_modelIds.push_back(modelId.asString());
+    }
+
+    for ( const Json::Value &image : json["images"] ) {
+        bundle->_images.push_back({image["type"].asString(), image["path"].asString()});
+
+        if ( bundle->_images.back().type != "file" ) {
+            SetError(error, "Test bundle at " + path + " contains an image of unsupported type " + bundle->_images.back().type);
+            return nullptr;
+        }
+    }
+
+    // Options
+
+    const Json::Value &options = json["options"];
+
+    bundle->_options = options;
+    bundle->_iterations = options["iterations"].asUInt();
+    bundle->_warmup = options["warmup"].asUInt();
+    bundle->_cachesPreprocessedInputs = options.isMember("cache_inputs") ? options["cache_inputs"].asBool() : true;
+    bundle->_metricName = options["metric"].asString();
+
+    for ( const Json::Value &name : options["metrics"] ) {
+        bundle->_classificationMetrics.push_back(name.asString());
+    }
+
+    // Labels
+
+    for ( const Json::Value &label : json["labels"] ) {
+        bundle->_labels[label["path"].asString()] = label["inference_results"];
+    }
+
+    return bundle;
+}
+
+std::string TestBundle::filePathForImage(const Image &image) const {
+    return JoinPath(_path, image.path);
+}
+
+} // namespace cli
+} // namespace netrunner
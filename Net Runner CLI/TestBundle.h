@@ -0,0 +1,133 @@
+//
+//  TestBundle.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef TestBundle_h
+#define TestBundle_h
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * A headless test bundle: a .testbundle directory containing a test.json description and the
+ * images it refers to. The format is the one read by the app's `HeadlessTestBundle` and is
+ * documented in the README.
+ */
+
+class TestBundle {
+public:
+
+    struct Image {
+        std::string type;
+        std::string path;
+    };
+
+    /**
+     * Loads and validates the test.json in the bundle at path. Returns nullptr and sets error if
+     * the description is missing or invalid.
+     */
+
+    static std::shared_ptr<TestBundle> Load(const std::string &path, std::string *error);
+
+    const std::string &path() const { return _path; }
+    const std::string &name() const { return _name; }
+    const std::string &identifier() const { return _identifier; }
+    const std::string &version() const { return _version; }
+
+    const std::vector<std::string> &modelIds() const { return _modelIds; }
+    const std::vector<Image> &images() const { return _images; }
+
+    /**
+     * The expected inference results keyed by image path.
+     */
+
+    const std::map<std::string, Json::Value> &labels() const { return _labels; }
+
+    const Json::Value &options() const { return _options; }
+
+    unsigned iterations() const { return _iterations; }
+    unsigned warmup() const { return _warmup; }
+    bool cachesPreprocessedInputs() const { return _cachesPreprocessedInputs; }
+    const std::string &metricName() const { return _metricName; }
+
+    /**
+     * The names of the classification metrics in the "metrics" option, see ClassificationMetrics.h.
+     */
+
+    const std::vector<std::string> &classificationMetrics() const { return _classificationMetrics; }
+
+    /**
+     * The "benchmark" option, null unless the bundle asks for a steady state benchmark.
+     */
+
+    const Json::Value &benchmarkOptions() const { return _options["benchmark"]; }
+    bool benchmarks() const { return benchmarkOptions().isObject(); }
+
+    /**
+     * The "resume" option: results are appended to the same file on every run and evaluations
+     * already in it are restored rather than repeated. Ignored when benchmarking.
+     */
+
+    bool resumes() const { return _options.get("resume", false).asBool() && !benchmarks(); }
+
+    /**
+     * The "regression" option, null unless the bundle's summary is compared with a baseline
+     * summary in the bundle, see RegressionGate.h. Holds the baseline's path relative to the
+     * bundle under "baseline" and any regression thresholds.
+     */
+
+    const Json::Value &regressionOptions() const { return _options["regression"]; }
+
+    /**
+     * The full path to a file image in the bundle.
+     */
+
+    std::string filePathForImage(const Image &image) const;
+
+private:
+    TestBundle() = default;
+
+    std::string _path;
+    std::string _name;
+    std::string _identifier;
+    std::string _version;
+
+    std::vector<std::string> _modelIds;
+    std::vector<Image> _images;
+    std::map<std::string, Json::Value> _labels;
+
+    Json::Value _options;
+    unsigned _iterations = 1;
+    unsigned _warmup = 0;
+    bool _cachesPreprocessedInputs = true;
+    std::string _metricName;
+    std::vector<std::string> _classificationMetrics;
+};
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* TestBundle_h */
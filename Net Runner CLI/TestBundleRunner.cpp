@@ -0,0 +1,610 @@
+//
+//  TestBundleRunner.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "TestBundleRunner.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "EvaluationMetric.h"
+#include "Image.h"
+#include "Interpreter.h"
+#include "MemorySampler.h"
+#include "ContentHash.h"
+#include "ModelOutput.h"
+#include "ModelSummary.h"
+#include "ResultsCheckpoint.h"
+#include "SteadyStateBenchmark.h"
+#include "Tracer.h"
+
+namespace netrunner {
+namespace cli {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+// Result keys, matching EvaluatorConstants
+
+const char * const kEvaluatorResultsKeySourceType = "type";
+const char * const kEvaluatorResultsKeyImage = "image";
+const char * const kEvaluatorResultsKeyModel = "model";
+const char * const kEvaluatorResultsKeyError = "error";
+const char * const kEvaluatorResultsKeyErrorDescription = "error_description";
+const char * const kEvaluatorResultsKeyEvaluation = "evaluation";
+const char * const kEvaluatorResultsKeySourceTypeFile = "file";
+const char * const kEvaluatorResultsKeyPreprocessingLatency = "preprocessor_latency";
+const char * const kEvaluatorResultsKeyPreprocessingCacheHit = "preprocessor_cache_hit";
+const char * const kEvaluatorResultsKeyInferenceLatency = "inference_latency";
+const char * const kEvaluatorResultsKeyInferenceResults = "inference_results";
+const char * const kEvaluatorResultsKeyConcurrentModels = "concurrent_models";
+const char * const kClassificationOutputKey = "classification";
+const char * const kEvaluatorResultsKeyMemory = "process_memory";
+const char * const kEvaluatorResultsKeyMemoryModelLoad = "model_load";
+const char * const kEvaluatorResultsKeyMemoryArena = "arena";
+const char * const kEvaluatorResultsKeyMemoryPreprocessingFootprint = "preprocessing_footprint";
+const char * const kEvaluatorResultsKeyMemoryInferenceFootprint = "inference_footprint";
+const char * const kEvaluatorResultsKeyUnit = "unit";
+
+using Clock = std::chrono::steady_clock;
+
+double MillisecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Matches the keys read by the app's HeadlessTestBundleRunner. Durations are in seconds.
+
+SteadyStateBenchmark::Options BenchmarkOptions(const Json::Value &dictionary) {
+    SteadyStateBenchmark::Options options;
+
+    if ( dictionary.isMember("warmup") ) {
+        options.warmupRuns = dictionary["warmup"].asUInt();
+    }
+    if ( dictionary.isMember("min_runs") ) {
+        options.minRuns = dictionary["min_runs"].asUInt();
+    }
+    if ( dictionary.isMember("max_runs") ) {
+        options.maxRuns = dictionary["max_runs"].asUInt();
+    }
+    if ( dictionary.isMember("max_duration") ) {
+        options.maxDuration = dictionary["max_duration"].asDouble() * 1000;
+    }
+    if ( dictionary.isMember("cooldown") ) {
+        options.cooldown = dictionary["cooldown"].asDouble() * 1000;
+    }
+    if ( dictionary.isMember("confidence") ) {
+        options.confidence = dictionary["confidence"].asDouble();
+    }
+    if ( dictionary.isMember("relative_error") ) {
+        options.relativeError = dictionary["relative_error"].asDouble();
+    }
+    if ( dictionary.isMember("window") ) {
+        options.window = dictionary["window"].asUInt();
+    }
+    if ( dictionary.isMember("throttle_threshold") ) {
+        options.throttleThreshold = dictionary["throttle_threshold"].asDouble();
+    }
+
+    return options;
+}
+
+Json::Value BenchmarkDictionary(const SteadyStateBenchmark::Result &result) {
+    Json::Value dictionary(Json::objectValue);
+
+    dictionary["stop_reason"] = SteadyStateBenchmark::StopReasonName(result.stopReason);
+    dictionary["converged"] = result.converged();
+    dictionary["runs"] = result.runs;
+    dictionary["warmup_runs"] = result.warmupRuns;
+    dictionary["failed_runs"] = result.failedRuns;
+    dictionary["steady_state_latency"] = result.steadyStateLatency;
+    dictionary["confidence_interval"] = result.confidenceInterval;
+    dictionary["relative_error"] = result.relativeError;
+    dictionary["trend"] = result.trend;
+    dictionary["throttling_ratio"] = result.throttlingRatio;
+    dictionary["throttled"] = result.throttled;
+    dictionary["max_thermal_state"] = result.maxThermalState;
+    dictionary["thermal_wait"] = result.thermalWait / 1000;
+    dictionary["duration"] = result.duration / 1000;
+
+    return dictionary;
+}
+
+// MARK: - Classification Metrics
+
+// The class vocabulary is the labels of the classification output, or of the first output with
+// labels, so that class indexes match the model's
+
+std::vector<std::string> ClassificationVocabulary(const ModelBundle &modelBundle) {
+    const std::vector<LayerDescription> &outputs = modelBundle.outputs();
+
+    for ( const LayerDescription &output : outputs ) {
+        if ( output.name == kClassificationOutputKey && !output.labels.empty() ) {
+            return output.labels;
+        }
+    }
+
+    for ( const LayerDescription &output : outputs ) {
+        if ( !output.labels.empty() ) {
+            return output.labels;
+        }
+    }
+
+    return std::vector<std::string>();
+}
+
+// Mirrors PreprocessedInputCache, which keys on the source and the input's size and format
+
+std::string CacheKey(const std::string &path, const LayerDescription &layer) {
+    return path + ":" + std::to_string(layer.width()) + "x" + std::to_string(layer.height()) + "x" + std::to_string(layer.channels());
+}
+
+} // namespace
+
+TestBundleRunner::TestBundleRunner(std::shared_ptr<const TestBundle> testBundle, std::vector<std::shared_ptr<const ModelBundle>> modelBundles, const Options &options)
+    : _testBundle(testBundle), _modelBundles(std::move(modelBundles)), _options(options), _summary(Json::arrayValue) {}
+
+bool TestBundleRunner::run(const std::string &resultsPath, std::string *error) {
+    const TestBundle &testBundle = *_testBundle;
+    const std::string &testBundleID = testBundle.identifier();
+    const EvaluationShard &shard = _options.shard;
+
+    _summary = Json::Value(Json::arrayValue);
+    _errorCount = 0;
+
+    _partial = Json::Value(Json::objectValue);
+    _partial["test_bundle"] = testBundleID;
+    _partial["shard"] = shard.index() + 1;
+    _partial["shards"] = shard.count();
+    _partial["models"] = Json::Value(Json::arrayValue);
+
+    // A benchmark measures latency rather than covering the images, so it is not split: the first
+    // shard runs it whole and the others skip it
+
+    if ( testBundle.benchmarks() && shard.index() != 0 ) {
+        std::cerr << "Test Bundle " << testBundleID << ": Benchmarks run in the first shard, skipping in shard " << shard.description() << std::endl;
+        return true;
+    }
+
+    // Units are keyed as in HeadlessTestBundleRunner: options that only affect the summary are
+    // left out and images are identified by their contents
+
+    const bool resumes = testBundle.resumes();
+    uint64_t optionsFingerprint = 0;
+    std::vector<uint64_t> inputs;
+
+    if ( resumes ) {
+        Json::Value options = testBundle.options();
+        for ( const char *key : {"resume", "iterations", "warmup", "metric", "metrics", "regression"} ) {
+            options.removeMember(key);
+        }
+
+        Json::StreamWriterBuilder canonical;
+        canonical["indentation"] = "";
+        optionsFingerprint = ContentHash().update(Json::writeString(canonical, options)).value();
+
+        for ( const TestBundle::Image &image : testBundle.images() ) {
+            const std::string path = testBundle.filePathForImage(image);
+            uint64_t input;
+            if ( !ContentHash::File(path, &input, nullptr) ) {
+                input = ContentHash().update(path).value();
+            }
+            inputs.push_back(input);
+        }
+    }
+
+    std::ofstream results(resultsPath, std::ios::out | (resumes ? std::ios::app : std::ios::trunc));
+
+    if ( !results ) {
+        SetError(error, "Unable to open results file at " + resultsPath);
+        return false;
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "";
+    std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+
+    if ( !testBundle.metricName().empty() && EvaluationMetricForName(testBundle.metricName()) == nullptr ) {
+        std::cerr << "Test Bundle " << testBundleID << ": Unknown metric " << testBundle.metricName() << std::endl;
+    }
+
+    std::map<std::string, Image> cache;
+    size_t cacheHits = 0, cacheMisses = 0;
+
+
+    for ( const std::string &modelID : testBundle.modelIds() ) {
+
+        // Convert model ids to bundles and instantiate each model
+
+        std::shared_ptr<const ModelBundle> modelBundle;
+
+        for ( const std::shared_ptr<const ModelBundle> &candidate : _modelBundles ) {
+            if ( candidate->identifier() == modelID ) {
+                modelBundle = candidate;
+                break;
+            }
+        }
+
+        if ( modelBundle == nullptr ) {
+            std::cerr << "Test Bundle " << testBundleID << ": Didn't load model " << modelID << std::endl;
+            continue;
+        }
+
+        // Creating the interpreter loads the model, note the memory it takes
+
+        MemorySampler::Scope loadScope;
+        Tracer &tracer = Tracer::Shared();
+        Tracer::Scope loadSpan(tracer, "load model", "model");
+
+        std::string interpreterError;
+        std::unique_ptr<Interpreter> interpreter = Interpreter::Create(modelBundle, _options.threads, &interpreterError);
+
+        loadSpan.finish();
+        loadScope.finish();
+
+        if ( interpreter == nullptr ) {
+            std::cerr << "Test Bundle " << testBundleID << ": Unable to instantiate model from model bundle " << modelID << ": " << interpreterError << std::endl;
+            continue;
+        }
+
+        // Models that declare post-processing have it compiled once, and fall back to their raw
+        // outputs if it cannot be, like ModelOutputManager
+
+        const bool declaresPostProcessing = DeclaresPostProcessing(*modelBundle);
+        std::unique_ptr<PostProcessor> postProcessor;
+
+        if ( declaresPostProcessing ) {
+            std::string postProcessingError;
+            postProcessor = CompilePostProcessor(*modelBundle, &postProcessingError);
+
+            if ( postProcessor == nullptr ) {
+                std::cerr << "Test Bundle " << testBundleID << ": Unable to compile post-processing for model " << modelID << ": " << postProcessingError << std::endl;
+            }
+        }
+
+        const LayerDescription &input = modelBundle->inputs().front();
+
+        if ( !input.isImage() ) {
+            std::cerr << "Test Bundle " << testBundleID << ": Model " << modelID << " does not contain an image input at index 0" << std::endl;
+            continue;
+        }
+
+        const std::vector<std::string> classes = ClassificationVocabulary(*modelBundle);
+        std::vector<std::string> unknown;
+
+        ModelSummary modelSummary(modelID, testBundle.warmup(), testBundle.metricName(), testBundle.classificationMetrics(), classes, &unknown);
+
+        for ( const std::string &name : unknown ) {
+            std::cerr << "Test Bundle " << testBundleID << ": Unknown classification metric " << name << std::endl;
+        }
+        if ( !testBundle.classificationMetrics().empty() && classes.empty() ) {
+            std::cerr << "Test Bundle " << testBundleID << ": Model " << modelID << " has no labeled output, skipping classification metrics" << std::endl;
+        }
+
+        std::vector<std::vector<float>> outputs(modelBundle->outputs().size());
+
+        Json::Value loadMemory(Json::objectValue);
+        loadMemory[kEvaluatorResultsKeyMemoryModelLoad] = static_cast<Json::Int64>(loadScope.end()) - static_cast<Json::Int64>(loadScope.start());
+        modelSummary.addMemory(loadMemory);
+        bool firstInference = true;
+
+        // Each evaluation is traced under the model's name, with its stages nested in it
+
+        const char *modelSpanName = tracer.intern(modelID);
+
+        // Folds a successful evaluation into the summary, whether it was just run or restored
+        // from the results of an interrupted run
+
+        auto fold = [&](const std::string &imagePath, double preprocessingLatency, double inferenceLatency, const Json::Value &value) {
+            auto label = testBundle.labels().find(imagePath);
+            Json::Value y = label != testBundle.labels().end() ? label->second : Json::Value();
+
+            modelSummary.add(y, preprocessingLatency, inferenceLatency, value);
+        };
+
+        // Evaluates a single image, writing its record and folding it into the summary unless
+        // it is a benchmark warm-up run. Returns false if the evaluation fails.
+
+        auto evaluate = [&](const TestBundle::Image &image, bool measured, double *latency, const std::string &unit) -> bool {
+            const std::string path = testBundle.filePathForImage(image);
+            const std::string key = CacheKey(path, input);
+
+            Json::Value record(Json::objectValue);
+            record[kEvaluatorResultsKeySourceType] = kEvaluatorResultsKeySourceTypeFile;
+            record[kEvaluatorResultsKeyImage] = image.path;
+            record[kEvaluatorResultsKeyModel] = modelID;
+
+            Tracer::Scope evaluationSpan(tracer, modelSpanName, "evaluation");
+            std::string evaluationError;
+            double preprocessingLatency = 0;
+            double inferenceLatency = 0;
+            bool cacheHit = false;
+
+            // Preprocessing: consult the cache, only counting the lookup on a hit
+
+            const Image *scaled = nullptr;
+            Image uncached;
+
+            Clock::time_point start = Clock::now();
+
+            if ( testBundle.cachesPreprocessedInputs() ) {
+                Tracer::Scope span(tracer, "cache lookup", "preprocessing");
+                auto entry = cache.find(key);
+                if ( entry != cache.end() ) {
+                    scaled = &entry->second;
+                    cacheHit = true;
+                }
+                preprocessingLatency = MillisecondsSince(start);
+            }
+
+            Json::Value evaluationMemory(Json::objectValue);
+
+            if ( !cacheHit ) {
+                MemorySampler::Scope preprocessingScope;
+                Image decoded;
+                Tracer::Scope decodeSpan(tracer, "decode", "preprocessing");
+                bool decodedImage = DecodeImageFile(path, &decoded, &evaluationError);
+                decodeSpan.finish();
+
+                if ( decodedImage ) {
+                    start = Clock::now();
+                    Tracer::Scope resizeSpan(tracer, "resize", "preprocessing");
+                    uncached = CropAndResize(decoded, input.width(), input.height());
+                    resizeSpan.finish();
+                    preprocessingLatency += MillisecondsSince(start);
+
+                    if ( testBundle.cachesPreprocessedInputs() ) {
+                        scaled = &(cache[key] = std::move(uncached));
+                    } else {
+                        scaled = &uncached;
+                    }
+                }
+
+                preprocessingScope.finish();
+                evaluationMemory[kEvaluatorResultsKeyMemoryPreprocessingFootprint] = static_cast<Json::UInt64>(preprocessingScope.end());
+
+                cacheMisses += 1;
+            } else {
+                cacheHits += 1;
+            }
+
+            // Inference: copy and normalize the input, invoke, read the outputs
+
+            Json::Value packaged;
+            bool succeeded = scaled != nullptr;
+
+            if ( succeeded ) {
+                // Memory is only sampled before and after inference, never while it is being timed
+
+                MemorySampler::Scope inferenceScope;
+                start = Clock::now();
+
+                Tracer::Scope copySpan(tracer, "tensor copy", "inference");
+                succeeded = interpreter->setImageInput(0, *scaled, &evaluationError);
+                copySpan.finish();
+
+                if ( succeeded ) {
+                    Tracer::Scope invokeSpan(tracer, "invoke", "inference");
+                    succeeded = interpreter->invoke(&evaluationError);
+                }
+
+                Tracer::Scope captureSpan(tracer, "output capture", "inference");
+
+                for ( size_t i = 0; succeeded && i < outputs.size(); i++ ) {
+                    succeeded = interpreter->readOutput(i, &outputs[i], &evaluationError);
+                }
+
+                captureSpan.finish();
+
+                if ( succeeded ) {
+                    Tracer::Scope span(tracer, "model output", "inference");
+                    std::string postProcessingError;
+
+                    if ( postProcessor == nullptr || !PostProcessOutputs(*postProcessor, outputs, &packaged, &postProcessingError) ) {
+                        if ( postProcessor != nullptr ) {
+                            std::cerr << "Test Bundle " << testBundleID << ": Unable to post-process outputs: " << postProcessingError << std::endl;
+                        }
+                        packaged = PackageOutputs(*modelBundle, outputs);
+                    }
+                }
+
+                inferenceLatency = MillisecondsSince(start);
+
+                inferenceScope.finish();
+                evaluationMemory[kEvaluatorResultsKeyMemoryInferenceFootprint] = static_cast<Json::UInt64>(inferenceScope.end());
+
+                if ( firstInference ) {
+                    Json::Value arenaMemory(Json::objectValue);
+                    arenaMemory[kEvaluatorResultsKeyMemoryArena] = static_cast<Json::UInt64>(inferenceScope.growth());
+                    modelSummary.addMemory(arenaMemory);
+                    firstInference = false;
+                }
+            }
+
+            modelSummary.addMemory(evaluationMemory);
+
+            if ( !succeeded ) {
+                std::cerr << "Test Bundle " << testBundleID << ": " << evaluationError << std::endl;
+                record[kEvaluatorResultsKeyError] = true;
+                record[kEvaluatorResultsKeyErrorDescription] = evaluationError;
+                record[kEvaluatorResultsKeyEvaluation] = Json::Value::null;
+                if ( measured ) {
+                    modelSummary.addError();
+                    _errorCount += 1;
+                }
+            } else {
+                Json::Value value = declaresPostProcessing ? packaged : ModelOutputValue(*modelBundle, packaged);
+                Json::Value evaluation(Json::objectValue);
+
+                evaluation[kEvaluatorResultsKeyPreprocessingLatency] = preprocessingLatency;
+                evaluation[kEvaluatorResultsKeyPreprocessingCacheHit] = cacheHit;
+                evaluation[kEvaluatorResultsKeyInferenceLatency] = inferenceLatency;
+                evaluation[kEvaluatorResultsKeyInferenceResults] = value;
+                evaluation[kEvaluatorResultsKeyMemory] = evaluationMemory;
+
+                record[kEvaluatorResultsKeyError] = false;
+                record[kEvaluatorResultsKeyEvaluation] = evaluation;
+
+                if ( latency ) {
+                    *latency = inferenceLatency;
+                }
+                if ( measured ) {
+                    fold(image.path, preprocessingLatency, inferenceLatency, value);
+                }
+            }
+
+            if ( !measured ) {
+                return succeeded;
+            }
+
+            record[kEvaluatorResultsKeyConcurrentModels] = 1;
+            record["test_bundle"] = testBundleID;
+
+            if ( !unit.empty() ) {
+                record[kEvaluatorResultsKeyUnit] = unit;
+            }
+
+            Tracer::Scope writeSpan(tracer, "write result", "results");
+            writer->write(record, &results);
+            results << '\n';
+
+            return succeeded;
+        };
+
+        size_t evaluations = 0;
+
+        if ( testBundle.benchmarks() && !testBundle.images().empty() ) {
+
+            // Cycle through the images until the inference latency reaches a steady state
+
+            SteadyStateBenchmark::Options benchmarkOptions = BenchmarkOptions(testBundle.benchmarkOptions());
+            unsigned warmupRuns = benchmarkOptions.warmupRuns;
+            size_t index = 0;
+
+            SteadyStateBenchmark::Result result = SteadyStateBenchmark(benchmarkOptions).run([&](double *latency) {
+                const TestBundle::Image &image = testBundle.images()[index++ % testBundle.images().size()];
+                bool measured = warmupRuns == 0;
+                warmupRuns -= measured ? 0 : 1;
+                return evaluate(image, measured, latency, std::string());
+            });
+
+            std::cerr << "Test Bundle " << testBundleID << ": Benchmark for model " << modelID << " stopped (" << SteadyStateBenchmark::StopReasonName(result.stopReason) << ") after " << result.runs << " runs, steady state latency " << result.steadyStateLatency << "ms +/- " << result.confidenceInterval << "ms" << (result.throttled ? ", throttled" : "") << std::endl;
+
+            modelSummary.setBenchmark(BenchmarkDictionary(result));
+            evaluations = result.runs;
+        } else {
+
+            // When resuming, restore this model's evaluations from the results file and skip them.
+            // Only the evaluations in this runner's shard are expected.
+
+            std::vector<std::string> units;
+            ResultsCheckpoint checkpoint;
+
+            if ( resumes ) {
+                uint64_t modelFingerprint = ResultsCheckpoint::ModelFingerprint(modelID, modelBundle->info().get("version", "").asString(), modelBundle->modelFilePath());
+
+                for ( size_t i = 0; i < inputs.size(); i++ ) {
+                    for ( unsigned iteration = 0; iteration < testBundle.iterations(); iteration++ ) {
+                        units.push_back(ResultsCheckpoint::UnitKey(modelFingerprint, inputs[i], iteration, optionsFingerprint));
+                        if ( shard.contains(modelID, testBundle.images()[i].path, iteration) ) {
+                            checkpoint.expect(units.back());
+                        }
+                    }
+                }
+
+                Json::CharReaderBuilder readerBuilder;
+                std::unique_ptr<Json::CharReader> reader(readerBuilder.newCharReader());
+                size_t discarded = 0;
+
+                bool read = ResultsCheckpoint::ReadResults(resultsPath, [&](const std::string &line) {
+                    Json::Value record;
+                    if ( !reader->parse(line.data(), line.data() + line.size(), &record, nullptr) || !record.isObject() ) {
+                        return;
+                    }
+                    if ( record.get(kEvaluatorResultsKeyError, false).asBool() || !checkpoint.complete(record.get(kEvaluatorResultsKeyUnit, "").asString()) ) {
+                        return;
+                    }
+
+                    const Json::Value &evaluation = record[kEvaluatorResultsKeyEvaluation];
+                    modelSummary.addMemory(evaluation[kEvaluatorResultsKeyMemory]);
+                    fold(record[kEvaluatorResultsKeyImage].asString(), evaluation[kEvaluatorResultsKeyPreprocessingLatency].asDouble(), evaluation[kEvaluatorResultsKeyInferenceLatency].asDouble(), evaluation[kEvaluatorResultsKeyInferenceResults]);
+                }, &discarded, error);
+
+                if ( !read ) {
+                    return false;
+                }
+                if ( discarded > 0 ) {
+                    std::cerr << "Test Bundle " << testBundleID << ": Discarded " << discarded << " bytes of a partial record from " << resultsPath << std::endl;
+                }
+
+                std::cerr << "Test Bundle " << testBundleID << ": Resuming model " << modelID << " with " << checkpoint.completedCount() << " of " << checkpoint.expectedCount() << " evaluations complete" << std::endl;
+            }
+
+            size_t index = 0;
+
+            for ( const TestBundle::Image &image : testBundle.images() ) {
+                for ( unsigned iteration = 0; iteration < testBundle.iterations(); iteration++, index++ ) {
+                    if ( !shard.contains(modelID, image.path, iteration) ) {
+                        continue;
+                    }
+
+                    evaluations += 1;
+
+                    const std::string unit = resumes ? units[index] : std::string();
+                    if ( !unit.empty() && checkpoint.isComplete(unit) ) {
+                        continue;
+                    }
+                    evaluate(image, true, nullptr, unit);
+                }
+            }
+        }
+
+        std::cerr << "Test Bundle " << testBundleID << ": Completed " << evaluations << " evaluations for model " << modelID << std::endl;
+
+        Json::Value summary = modelSummary.summary();
+        summary["test_bundle"] = testBundleID;
+        _summary.append(summary);
+
+        if ( !shard.isWhole() ) {
+            _partial["models"].append(modelSummary.partial());
+        }
+    }
+
+    results.flush();
+
+    if ( !results ) {
+        SetError(error, "Unable to write results file at " + resultsPath);
+        return false;
+    }
+
+    std::cerr << "Test Bundle " << testBundleID << ": Preprocessed input cache hits: " << cacheHits << ", misses: " << cacheMisses << std::endl;
+    std::cerr << "Test Bundle " << testBundleID << ": Evaluation errors: " << _errorCount << std::endl;
+
+    return true;
+}
+
+} // namespace cli
+} // namespace netrunner
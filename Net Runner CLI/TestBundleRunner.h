@@ -0,0 +1,123 @@
+//
+//  TestBundleRunner.h
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef TestBundleRunner_h
+#define TestBundleRunner_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <json/json.h>
+
+#include "EvaluationShard.h"
+#include "ModelBundle.h"
+#include "TestBundle.h"
+
+namespace netrunner {
+namespace cli {
+
+/**
+ * Runs a headless test bundle against its models the way the app's `HeadlessTestBundleRunner`
+ * does, producing the same result records and summary schema so that workstation runs may be
+ * compared with device runs.
+ *
+ * For each model and each image, image-major and iteration-minor, the runner decodes the image,
+ * crops and scales it to the model's input (the preprocessing stage, skipped on a cache hit),
+ * copies it into the input tensor and invokes the model (the inference stage), and packages the
+ * outputs and applies the test bundle's metric. Models are evaluated serially, so latencies are
+ * uncontended, and images are decoded outside of either measured stage, as on the device.
+ *
+ * A test bundle that resumes is checkpointed the way `EvaluationCheckpoint` checkpoints it in
+ * the app: each record carries its unit, and evaluations already in the results file are folded
+ * into the summary rather than run again, see ResultsCheckpoint.h.
+ *
+ * A runner may evaluate a single shard of the test bundle, see EvaluationShard.h, in which case
+ * it also produces a partial summary that `MergePartialSummaries` combines with the partial
+ * summaries of the other shards.
+ */
+
+class TestBundleRunner {
+public:
+
+    struct Options {
+
+        /**
+         * The number of threads used by each TensorFlow Lite interpreter.
+         */
+
+        int threads = 1;
+
+        /**
+         * The shard of the test bundle's evaluations to run, the whole bundle by default.
+         */
+
+        EvaluationShard shard;
+    };
+
+    /**
+     * @param testBundle The test bundle to run.
+     * @param modelBundles The available model bundles, from which the test bundle's models are
+     *  chosen by identifier.
+     */
+
+    TestBundleRunner(std::shared_ptr<const TestBundle> testBundle, std::vector<std::shared_ptr<const ModelBundle>> modelBundles, const Options &options);
+
+    /**
+     * Evaluates every model, appending one JSON record per evaluation to the JSON Lines file at
+     * resultsPath. The file is replaced unless the test bundle resumes. Only the evaluations in
+     * the runner's shard are run. Returns false and sets error only if the results file cannot
+     * be read or written; models that fail to load and images that fail to evaluate are logged
+     * and counted.
+     */
+
+    bool run(const std::string &resultsPath, std::string *error);
+
+    /**
+     * One dictionary per model with the same entries as the app's headless summary, including
+     * the test bundle's identifier under "test_bundle".
+     */
+
+    const Json::Value &summary() const { return _summary; }
+
+    /**
+     * The partial summary of a sharded run: the test bundle's identifier under "test_bundle", the
+     * one-based "shard" and the number of "shards", and one partial summary per model under
+     * "models". See ModelSummary.h.
+     */
+
+    const Json::Value &partial() const { return _partial; }
+
+    size_t errorCount() const { return _errorCount; }
+
+private:
+    std::shared_ptr<const TestBundle> _testBundle;
+    std::vector<std::shared_ptr<const ModelBundle>> _modelBundles;
+    Options _options;
+
+    Json::Value _summary;
+    Json::Value _partial;
+    size_t _errorCount = 0;
+};
+
+} // namespace cli
+} // namespace netrunner
+
+#endif /* TestBundleRunner_h */
@@ -0,0 +1,531 @@
+//
+//  main.cpp
+//  Net Runner CLI
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+#include <json/json.h>
+
+#include "EvaluationShard.h"
+#include "ModelBundle.h"
+#include "ModelSummary.h"
+#include "SummaryRegressionGate.h"
+#include "TestBundle.h"
+#include "TestBundleRunner.h"
+#include "Tracer.h"
+
+using namespace netrunner::cli;
+
+namespace {
+
+// Distinguishes a run whose summary failed the regression gate from one that failed to run
+
+const int kExitRegression = 2;
+
+void PrintUsage(const char *program) {
+    std::cerr
+        << "usage: " << program << " --models <dir> [options] <test bundle or directory>...\n"
+        << "       " << program << " --merge [--summary <file>] <partial summary>...\n"
+        << "\n"
+        << "Runs headless test bundles against TensorIO model bundles and writes the same results\n"
+        << "and summary as the app's headless mode.\n"
+        << "\n"
+        << "  --models <dir>      A directory of .tiobundle model bundles, may be repeated\n"
+        << "  --results <dir>     Where to write each test bundle's .jsonl results, defaults to headless-results\n"
+        << "  --summary <file>    Write the summary to a file rather than to standard output\n"
+        << "  --threads <n>       The number of threads each interpreter uses, defaults to 1\n"
+        << "  --shard <i/n>       Run only the i-th of n shards of each test bundle and write its partial summary\n"
+        << "  --jobs <n>          Run each test bundle as n shards in parallel processes and merge their summaries\n"
+        << "  --merge             Merge the partial summaries written by the shards of a run, e.g. on separate devices\n"
+        << "  --baseline <file>   Compare the summary with a baseline summary and exit with status 2 if it regressed\n"
+        << "  --thresholds <file> The regression thresholds, overall and per model, see the README\n"
+        << "  --verdict <file>    Write the comparison's verdict to a file rather than to standard error\n"
+        << "  --trace             Write a Chrome trace of each test bundle's evaluation stages next to its results\n";
+}
+
+bool IsDirectory(const std::string &path) {
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+bool HasSuffix(const std::string &string, const std::string &suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool MakeDirectory(const std::string &path) {
+    return mkdir(path.c_str(), 0755) == 0 || errno == EEXIST;
+}
+
+bool WriteJSONFile(const Json::Value &json, const std::string &path, std::ostream *fallback) {
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    std::string string = Json::writeString(builder, json);
+
+    if ( path.empty() ) {
+        *fallback << string << std::endl;
+        return true;
+    }
+
+    std::ofstream file(path);
+    file << string << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool WriteSummary(const Json::Value &summary, const std::string &path) {
+    Json::Value evaluation(Json::objectValue);
+    evaluation["summary"] = summary;
+
+    if ( !WriteJSONFile(evaluation, path, &std::cout) ) {
+        std::cerr << "Unable to write summary to " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// Compares a summary with a baseline summary, see RegressionGate.h, writing the machine readable
+// verdict and logging each regression. Returns false only if either summary is malformed.
+
+bool GateSummary(const Json::Value &summary, const Json::Value &baseline, const Json::Value &thresholds, const std::string &verdictPath, bool *passed) {
+    netrunner::RegressionGate gate;
+    std::vector<netrunner::RegressionGate::ModelSamples> before, after;
+    std::string error;
+
+    if ( !ReadRegressionGate(thresholds, &gate, &error)
+        || !ReadRegressionSamples(baseline, &before, &error)
+        || !ReadRegressionSamples(summary, &after, &error) ) {
+        std::cerr << error << std::endl;
+        return false;
+    }
+
+    netrunner::RegressionGate::Result result = gate.compare(before, after);
+
+    if ( !WriteJSONFile(RegressionVerdictDictionary(result), verdictPath, &std::cerr) ) {
+        std::cerr << "Unable to write verdict to " << verdictPath << std::endl;
+        return false;
+    }
+
+    for ( const netrunner::RegressionGate::ModelResult &model : result.models ) {
+        if ( model.verdict == netrunner::RegressionGate::Verdict::Missing ) {
+            std::cerr << "Model " << model.model << " is missing from the summary" << std::endl;
+        }
+        for ( const netrunner::RegressionGate::Check &check : model.checks ) {
+            if ( check.verdict == netrunner::RegressionGate::Verdict::Regression ) {
+                std::cerr << "Model " << model.model << ": " << check.name << " regressed from " << check.baseline
+                    << " to " << check.candidate << " (p = " << check.pValue << ")" << std::endl;
+            }
+        }
+    }
+
+    std::cerr << "Regression gate " << (result.passed ? "passed" : "failed") << " with " << result.regressions << " regressions" << std::endl;
+
+    *passed = *passed && result.passed;
+    return true;
+}
+
+std::string PartialSummaryPath(const std::string &resultsDirectory, const TestBundle &testBundle, const netrunner::EvaluationShard &shard) {
+    return JoinPath(resultsDirectory, testBundle.identifier() + "-" + shard.name() + ".partial.json");
+}
+
+// Re-runs this program once per shard, with the same arguments apart from --jobs and --summary,
+// and waits for every shard. Each shard's summary is discarded, the partial summaries it writes
+// to the results directory are merged afterwards.
+
+bool RunShards(int argc, const char * argv[], uint32_t jobs) {
+    std::vector<pid_t> children;
+
+    for ( uint32_t index = 0; index < jobs; index++ ) {
+        std::vector<std::string> arguments = {argv[0]};
+
+        for ( int i = 1; i < argc; i++ ) {
+            std::string argument = argv[i];
+            if ( (argument == "--jobs" || argument == "--summary") && i + 1 < argc ) {
+                i++;
+                continue;
+            }
+            arguments.push_back(argument);
+        }
+
+        arguments.push_back("--shard");
+        arguments.push_back(netrunner::EvaluationShard(index, jobs).description());
+
+        pid_t pid = fork();
+
+        if ( pid < 0 ) {
+            std::cerr << "Unable to start shard " << index + 1 << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+
+        if ( pid == 0 ) {
+            std::vector<char*> argumentPointers;
+            for ( std::string &argument : arguments ) {
+                argumentPointers.push_back(&argument[0]);
+            }
+            argumentPointers.push_back(nullptr);
+
+            int null = open("/dev/null", O_WRONLY);
+            if ( null >= 0 ) {
+                dup2(null, STDOUT_FILENO);
+                close(null);
+            }
+
+            execvp(argumentPointers[0], argumentPointers.data());
+            std::cerr << "Unable to start shard " << index + 1 << ": " << std::strerror(errno) << std::endl;
+            _exit(EXIT_FAILURE);
+        }
+
+        children.push_back(pid);
+    }
+
+    bool succeeded = children.size() == jobs;
+
+    for ( pid_t child : children ) {
+        int status = 0;
+        if ( waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS ) {
+            succeeded = false;
+        }
+    }
+
+    if ( !succeeded ) {
+        std::cerr << "One or more shards failed" << std::endl;
+    }
+
+    return succeeded;
+}
+
+// A path may be a .testbundle or a directory of them, like the app's headless folder
+
+std::vector<std::string> TestBundlePaths(const std::string &path) {
+    std::vector<std::string> paths;
+
+    if ( HasSuffix(path, ".testbundle") || !IsDirectory(path) ) {
+        paths.push_back(path);
+        return paths;
+    }
+
+    if ( DIR *dir = opendir(path.c_str()) ) {
+        while ( struct dirent *entry = readdir(dir) ) {
+            std::string name = entry->d_name;
+            if ( HasSuffix(name, ".testbundle") ) {
+                paths.push_back(JoinPath(path, name));
+            }
+        }
+        closedir(dir);
+    }
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+} // namespace
+
+int main(int argc, const char * argv[]) {
+    std::vector<std::string> modelDirectories;
+    std::vector<std::string> inputs;
+    std::string resultsDirectory = "headless-results";
+    std::string summaryPath;
+    TestBundleRunner::Options options;
+    std::string baselinePath;
+    std::string thresholdsPath;
+    std::string verdictPath;
+    uint32_t jobs = 1;
+    bool merges = false;
+    bool traces = false;
+
+    for ( int i = 1; i < argc; i++ ) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if ( argument == "--models" && hasValue ) {
+            modelDirectories.push_back(argv[++i]);
+        } else if ( argument == "--results" && hasValue ) {
+            resultsDirectory = argv[++i];
+        } else if ( argument == "--summary" && hasValue ) {
+            summaryPath = argv[++i];
+        } else if ( argument == "--threads" && hasValue ) {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        } else if ( argument == "--shard" && hasValue ) {
+            std::string error;
+            if ( !netrunner::EvaluationShard::Parse(argv[++i], &options.shard, &error) ) {
+                std::cerr << error << std::endl;
+                return EXIT_FAILURE;
+            }
+        } else if ( argument == "--jobs" && hasValue ) {
+            jobs = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+        } else if ( argument == "--merge" ) {
+            merges = true;
+        } else if ( argument == "--trace" ) {
+            traces = true;
+        } else if ( argument == "--baseline" && hasValue ) {
+            baselinePath = argv[++i];
+        } else if ( argument == "--thresholds" && hasValue ) {
+            thresholdsPath = argv[++i];
+        } else if ( argument == "--verdict" && hasValue ) {
+            verdictPath = argv[++i];
+        } else if ( argument == "--help" || argument == "-h" ) {
+            PrintUsage(argv[0]);
+            return EXIT_SUCCESS;
+        } else if ( argument.compare(0, 2, "--") == 0 ) {
+            std::cerr << "Unknown or incomplete option " << argument << std::endl;
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+
+    // Read the baseline up front so that a missing file does not waste a run
+
+    Json::Value baseline;
+    Json::Value thresholds;
+
+    for ( const auto &file : {std::make_pair(&baselinePath, &baseline), std::make_pair(&thresholdsPath, &thresholds)} ) {
+        std::string error;
+        if ( !file.first->empty() && !ReadJSONFile(*file.first, file.second, &error) ) {
+            std::cerr << error << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if ( !thresholdsPath.empty() ) {
+        netrunner::RegressionGate gate;
+        std::string error;
+        if ( !ReadRegressionGate(thresholds, &gate, &error) ) {
+            std::cerr << error << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Writes the summary and gates it on the baseline, if any
+
+    auto finish = [&](const Json::Value &summary, bool passed) -> int {
+        if ( !WriteSummary(summary, summaryPath) ) {
+            return EXIT_FAILURE;
+        }
+        if ( !baselinePath.empty() && !GateSummary(summary, baseline, thresholds, verdictPath, &passed) ) {
+            return EXIT_FAILURE;
+        }
+        return passed ? EXIT_SUCCESS : kExitRegression;
+    };
+
+    // Merge the partial summaries of shards that were run elsewhere
+
+    if ( merges ) {
+        std::vector<Json::Value> partials(inputs.size());
+        Json::Value summary;
+        std::string error;
+
+        for ( size_t i = 0; i < inputs.size(); i++ ) {
+            if ( !ReadJSONFile(inputs[i], &partials[i], &error) ) {
+                std::cerr << error << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+
+        if ( inputs.empty() || !MergePartialSummaries(partials, &summary, &error) ) {
+            std::cerr << (inputs.empty() ? "No partial summaries to merge" : error) << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return finish(summary, true);
+    }
+
+    if ( modelDirectories.empty() || inputs.empty() ) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if ( jobs > 1 && !options.shard.isWhole() ) {
+        std::cerr << "--jobs and --shard may not be used together" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Run shards in parallel processes, then merge their partial summaries as --merge would
+
+    if ( jobs > 1 ) {
+        std::vector<std::shared_ptr<const TestBundle>> testBundles;
+
+        for ( const std::string &input : inputs ) {
+            for ( const std::string &path : TestBundlePaths(input) ) {
+                std::string error;
+                std::shared_ptr<TestBundle> bundle = TestBundle::Load(path, &error);
+                if ( bundle == nullptr ) {
+                    std::cerr << error << std::endl;
+                    return EXIT_FAILURE;
+                }
+                testBundles.push_back(bundle);
+            }
+        }
+
+        if ( !MakeDirectory(resultsDirectory) || !RunShards(argc, argv, jobs) ) {
+            return EXIT_FAILURE;
+        }
+
+        std::vector<Json::Value> partials;
+        Json::Value summary;
+        std::string error;
+
+        for ( const std::shared_ptr<const TestBundle> &testBundle : testBundles ) {
+            for ( uint32_t index = 0; index < jobs; index++ ) {
+                partials.push_back(Json::Value());
+                if ( !ReadJSONFile(PartialSummaryPath(resultsDirectory, *testBundle, netrunner::EvaluationShard(index, jobs)), &partials.back(), &error) ) {
+                    std::cerr << error << std::endl;
+                    return EXIT_FAILURE;
+                }
+            }
+        }
+
+        if ( !MergePartialSummaries(partials, &summary, &error) ) {
+            std::cerr << error << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        return finish(summary, true);
+    }
+
+    // Load model bundles
+
+    std::vector<std::shared_ptr<const ModelBundle>> modelBundles;
+
+    for ( const std::string &directory : modelDirectories ) {
+        std::string error;
+        for ( const std::shared_ptr<ModelBundle> &bundle : ModelBundle::LoadAll(directory, &error) ) {
+            modelBundles.push_back(bundle);
+        }
+        if ( !error.empty() ) {
+            std::cerr << error << std::endl;
+        }
+    }
+
+    std::cerr << "Loaded " << modelBundles.size() << " model bundles" << std::endl;
+
+    // Load test bundles
+
+    std::vector<std::shared_ptr<const TestBundle>> testBundles;
+
+    for ( const std::string &input : inputs ) {
+        for ( const std::string &path : TestBundlePaths(input) ) {
+            std::string error;
+            std::shared_ptr<TestBundle> bundle = TestBundle::Load(path, &error);
+            if ( bundle == nullptr ) {
+                std::cerr << error << std::endl;
+                return EXIT_FAILURE;
+            }
+            testBundles.push_back(bundle);
+        }
+    }
+
+    std::cerr << "Loaded " << testBundles.size() << " test bundles" << std::endl;
+
+    if ( !MakeDirectory(resultsDirectory) ) {
+        std::cerr << "Unable to create results directory " << resultsDirectory << ": " << std::strerror(errno) << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Run them, collecting the summary as HeadlessViewController does
+
+    Json::Value summary(Json::arrayValue);
+    bool passed = true;
+    long long timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    for ( const std::shared_ptr<const TestBundle> &testBundle : testBundles ) {
+        std::string name = options.shard.isWhole() ? testBundle->identifier() : testBundle->identifier() + "-" + options.shard.name();
+        std::string resultsPath = testBundle->resumes()
+            ? JoinPath(resultsDirectory, name + ".jsonl")
+            : JoinPath(resultsDirectory, name + "-" + std::to_string(timestamp) + ".jsonl");
+        TestBundleRunner runner(testBundle, modelBundles, options);
+        netrunner::Tracer &tracer = netrunner::Tracer::Shared();
+        std::string error;
+
+        tracer.clear();
+        tracer.setEnabled(traces);
+
+        if ( !runner.run(resultsPath, &error) ) {
+            std::cerr << error << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        tracer.setEnabled(false);
+
+        std::cerr << "Test Bundle " << testBundle->identifier() << ": Wrote results to " << resultsPath << std::endl;
+
+        if ( traces ) {
+            std::string tracePath = resultsPath.substr(0, resultsPath.size() - 6) + ".trace.json";
+
+            if ( !tracer.write(tracePath, &error) ) {
+                std::cerr << error << std::endl;
+                return EXIT_FAILURE;
+            }
+            if ( tracer.dropped() > 0 ) {
+                std::cerr << "Test Bundle " << testBundle->identifier() << ": Trace dropped its " << tracer.dropped() << " oldest spans" << std::endl;
+            }
+
+            std::cerr << "Test Bundle " << testBundle->identifier() << ": Wrote trace to " << tracePath << std::endl;
+        }
+
+        if ( !options.shard.isWhole() ) {
+            std::string partialPath = PartialSummaryPath(resultsDirectory, *testBundle, options.shard);
+
+            if ( !WriteJSONFile(runner.partial(), partialPath, nullptr) ) {
+                std::cerr << "Unable to write partial summary to " << partialPath << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::cerr << "Test Bundle " << testBundle->identifier() << ": Wrote partial summary for shard " << options.shard.description() << " to " << partialPath << std::endl;
+        }
+
+        // A test bundle may carry its own baseline, as it does on the device. Shards are gated
+        // once merged.
+
+        const Json::Value &regression = testBundle->regressionOptions();
+
+        if ( regression.isObject() && options.shard.isWhole() ) {
+            std::string testBundleVerdictPath = resultsPath.substr(0, resultsPath.size() - 6) + ".verdict.json";
+            Json::Value testBundleBaseline;
+
+            if ( !ReadJSONFile(JoinPath(testBundle->path(), regression["baseline"].asString()), &testBundleBaseline, &error)
+                || !GateSummary(runner.summary(), testBundleBaseline, regression, testBundleVerdictPath, &passed) ) {
+                std::cerr << (error.empty() ? "" : error + "\n") << "Test Bundle " << testBundle->identifier() << ": Unable to check for regressions" << std::endl;
+                return EXIT_FAILURE;
+            }
+
+            std::cerr << "Test Bundle " << testBundle->identifier() << ": Wrote verdict to " << testBundleVerdictPath << std::endl;
+        }
+
+        for ( const Json::Value &model : runner.summary() ) {
+            summary.append(model);
+        }
+    }
+
+    return finish(summary, passed);
+}
@@ -76,7 +76,7 @@
     
     // Load models
     
-    if ( ![TIOModelBundleManager.sharedManager loadModelBundlesAtPath:modelsPath error:&error] ) {
+    if ( ![ModelManager.sharedManager loadModelBundlesAtPath:modelsPath error:&error] ) {
         NSLog(@"Unable to load model bundles at path %@", modelsPath);
     }
     
@@ -0,0 +1,311 @@
+//
+//  RegressionGate.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "RegressionGate.h"
+
+#include <algorithm>
+#include <cmath>
+#include <set>
+
+namespace netrunner {
+
+namespace {
+
+uint64_t Count(const LatencyHistogram::State &state) {
+    uint64_t count = 0;
+    for ( const auto &bucket : state.buckets ) {
+        count += bucket.second;
+    }
+    return count;
+}
+
+double Median(const LatencyHistogram::State &state) {
+    LatencyHistogram histogram;
+    histogram.merge(state);
+    return histogram.percentile(50);
+}
+
+double LogChoose(double n, double k) {
+    return std::lgamma(n + 1) - std::lgamma(k + 1) - std::lgamma(n - k + 1);
+}
+
+// Summaries of a single test bundle may omit it, in which case models match by id alone
+
+const RegressionGate::ModelSamples *FindModel(const std::vector<RegressionGate::ModelSamples> &models, const RegressionGate::ModelSamples &model, std::vector<bool> &matched) {
+    for ( size_t i = 0; i < models.size(); i++ ) {
+        const RegressionGate::ModelSamples &other = models[i];
+        if ( !matched[i] && other.model == model.model
+            && (other.testBundle == model.testBundle || other.testBundle.empty() || model.testBundle.empty()) ) {
+            matched[i] = true;
+            return &other;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+const T *FindSample(const std::vector<std::pair<std::string, T>> &samples, const std::string &name) {
+    for ( const auto &sample : samples ) {
+        if ( sample.first == name ) {
+            return &sample.second;
+        }
+    }
+    return nullptr;
+}
+
+// Change is positive for the worse
+
+RegressionGate::Verdict CheckVerdict(bool conclusive, bool significant, double change, double threshold) {
+    if ( !conclusive ) {
+        return RegressionGate::Verdict::Inconclusive;
+    } else if ( significant && change > threshold ) {
+        return RegressionGate::Verdict::Regression;
+    } else if ( significant && change < -threshold ) {
+        return RegressionGate::Verdict::Improvement;
+    }
+    return RegressionGate::Verdict::Pass;
+}
+
+} // namespace
+
+RegressionGate::RegressionGate() : _defaults(Thresholds()) {}
+
+RegressionGate::RegressionGate(const Thresholds &thresholds) : _defaults(thresholds) {}
+
+void RegressionGate::setThresholds(const std::string &model, const Thresholds &thresholds) {
+    _thresholds[model] = thresholds;
+}
+
+const RegressionGate::Thresholds &RegressionGate::thresholds(const std::string &model) const {
+    auto entry = _thresholds.find(model);
+    return entry != _thresholds.end() ? entry->second : _defaults;
+}
+
+RegressionGate::Result RegressionGate::compare(const std::vector<ModelSamples> &baseline, const std::vector<ModelSamples> &candidate) const {
+    Result result;
+    std::vector<bool> matched(candidate.size(), false);
+    std::set<std::string> testBundles;
+
+    for ( const ModelSamples &after : candidate ) {
+        if ( !after.testBundle.empty() ) {
+            testBundles.insert(after.testBundle);
+        }
+    }
+
+    for ( const ModelSamples &before : baseline ) {
+        if ( !before.testBundle.empty() && !testBundles.empty() && testBundles.count(before.testBundle) == 0 ) {
+            continue;
+        }
+
+        ModelResult model;
+        model.testBundle = before.testBundle;
+        model.model = before.model;
+
+        const ModelSamples *after = FindModel(candidate, before, matched);
+
+        if ( after == nullptr ) {
+            model.verdict = Verdict::Missing;
+            result.passed = false;
+            result.models.push_back(model);
+            continue;
+        }
+
+        const Thresholds &modelThresholds = thresholds(before.model);
+
+        for ( const auto &latency : before.latencies ) {
+            if ( const LatencyHistogram::State *state = FindSample(after->latencies, latency.first) ) {
+                model.checks.push_back(compareLatencies(latency.first, latency.second, *state, modelThresholds));
+            }
+        }
+
+        for ( const auto &accuracy : before.accuracies ) {
+            if ( const Proportion *proportion = FindSample(after->accuracies, accuracy.first) ) {
+                model.checks.push_back(compareAccuracies(accuracy.first, accuracy.second, *proportion, modelThresholds));
+            }
+        }
+
+        // A regression anywhere outweighs an improvement elsewhere, and a model is only
+        // inconclusive if none of its checks were
+
+        model.verdict = Verdict::Inconclusive;
+
+        for ( const Check &check : model.checks ) {
+            if ( check.verdict == Verdict::Regression ) {
+                model.verdict = Verdict::Regression;
+                result.regressions += 1;
+                result.passed = false;
+            } else if ( check.verdict == Verdict::Improvement && model.verdict != Verdict::Regression ) {
+                model.verdict = Verdict::Improvement;
+            } else if ( check.verdict == Verdict::Pass && model.verdict == Verdict::Inconclusive ) {
+                model.verdict = Verdict::Pass;
+            }
+        }
+
+        result.models.push_back(model);
+    }
+
+    for ( size_t i = 0; i < candidate.size(); i++ ) {
+        if ( !matched[i] ) {
+            ModelResult model;
+            model.testBundle = candidate[i].testBundle;
+            model.model = candidate[i].model;
+            model.verdict = Verdict::New;
+            result.models.push_back(model);
+        }
+    }
+
+    return result;
+}
+
+// The test picks its direction from the change in median, so the p-value is that of the change
+// being reported
+
+RegressionGate::Check RegressionGate::compareLatencies(const std::string &name, const LatencyHistogram::State &baseline, const LatencyHistogram::State &candidate, const Thresholds &thresholds) const {
+    Check check;
+    check.name = name;
+    check.kind = Kind::Latency;
+    check.threshold = thresholds.latencyIncrease;
+    check.baselineCount = Count(baseline);
+    check.candidateCount = Count(candidate);
+    check.baseline = Median(baseline);
+    check.candidate = Median(candidate);
+    check.change = check.baseline > 0 ? check.candidate / check.baseline - 1 : 0;
+    check.pValue = MannWhitneyPValue(baseline, candidate, check.change >= 0);
+
+    bool conclusive = std::min(check.baselineCount, check.candidateCount) >= std::max<uint64_t>(thresholds.minimumSamples, 1);
+    check.verdict = CheckVerdict(conclusive, check.pValue < thresholds.alpha, check.change, check.threshold);
+
+    return check;
+}
+
+// A decrease in accuracy is a regression, so the change is negated before it is compared with
+// the threshold
+
+RegressionGate::Check RegressionGate::compareAccuracies(const std::string &name, const Proportion &baseline, const Proportion &candidate, const Thresholds &thresholds) const {
+    Check check;
+    check.name = name;
+    check.kind = Kind::Accuracy;
+    check.threshold = thresholds.accuracyDecrease;
+    check.baselineCount = baseline.count;
+    check.candidateCount = candidate.count;
+    check.baseline = baseline.count > 0 ? static_cast<double>(baseline.correct) / static_cast<double>(baseline.count) : 0;
+    check.candidate = candidate.count > 0 ? static_cast<double>(candidate.correct) / static_cast<double>(candidate.count) : 0;
+    check.change = check.candidate - check.baseline;
+    check.pValue = FisherExactPValue(baseline, candidate, check.change <= 0);
+
+    bool conclusive = std::min(check.baselineCount, check.candidateCount) >= std::max<uint64_t>(thresholds.minimumSamples, 1);
+    check.verdict = CheckVerdict(conclusive, check.pValue < thresholds.alpha, -check.change, check.threshold);
+
+    return check;
+}
+
+// MARK: - Statistics
+
+// Each bucket is a group of tied values. Walking the buckets of both histograms in order assigns
+// every group its mid-rank, from which the candidate's rank sum and U statistic follow without
+// expanding the histograms into individual values.
+
+double RegressionGate::MannWhitneyPValue(const LatencyHistogram::State &baseline, const LatencyHistogram::State &candidate, bool larger) {
+    std::map<uint32_t, std::pair<double, double>> buckets;
+
+    for ( const auto &bucket : baseline.buckets ) {
+        buckets[bucket.first].first += static_cast<double>(bucket.second);
+    }
+    for ( const auto &bucket : candidate.buckets ) {
+        buckets[bucket.first].second += static_cast<double>(bucket.second);
+    }
+
+    double n1 = static_cast<double>(Count(baseline));
+    double n2 = static_cast<double>(Count(candidate));
+
+    if ( n1 == 0 || n2 == 0 ) {
+        return 1;
+    }
+
+    double below = 0;
+    double rankSum = 0;
+    double ties = 0;
+
+    for ( const auto &bucket : buckets ) {
+        double tied = bucket.second.first + bucket.second.second;
+        rankSum += bucket.second.second * (below + (tied + 1) / 2);
+        ties += tied * tied * tied - tied;
+        below += tied;
+    }
+
+    double n = n1 + n2;
+    double u = rankSum - n2 * (n2 + 1) / 2;
+    double mean = n1 * n2 / 2;
+    double variance = n1 * n2 / 12 * ((n + 1) - ties / (n * (n - 1)));
+
+    if ( variance <= 0 ) {
+        return 1;
+    }
+
+    double z = ((larger ? u - mean : mean - u) - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+// Conditioned on both runs' counts and the total number correct, the candidate's number correct
+// is hypergeometric. Sums the tail in log space, terms too small to represent vanish.
+
+double RegressionGate::FisherExactPValue(const Proportion &baseline, const Proportion &candidate, bool lower) {
+    if ( baseline.count == 0 || candidate.count == 0 ) {
+        return 1;
+    }
+
+    double n = static_cast<double>(baseline.count + candidate.count);
+    double correct = static_cast<double>(std::min(baseline.correct, baseline.count) + std::min(candidate.correct, candidate.count));
+    double drawn = static_cast<double>(candidate.count);
+    double observed = static_cast<double>(std::min(candidate.correct, candidate.count));
+
+    double first = std::max(0.0, drawn - (n - correct));
+    double last = std::min(drawn, correct);
+    double total = LogChoose(n, drawn);
+    double pValue = 0;
+
+    for ( double x = lower ? first : observed; x <= (lower ? observed : last); x += 1 ) {
+        pValue += std::exp(LogChoose(correct, x) + LogChoose(n - correct, drawn - x) - total);
+    }
+
+    return std::min(pValue, 1.0);
+}
+
+std::string RegressionGate::VerdictName(Verdict verdict) {
+    switch ( verdict ) {
+    case Verdict::Pass: return "pass";
+    case Verdict::Improvement: return "improvement";
+    case Verdict::Inconclusive: return "inconclusive";
+    case Verdict::Regression: return "regression";
+    case Verdict::Missing: return "missing";
+    case Verdict::New: return "new";
+    }
+    return "unknown";
+}
+
+std::string RegressionGate::KindName(Kind kind) {
+    switch ( kind ) {
+    case Kind::Latency: return "latency";
+    case Kind::Accuracy: return "accuracy";
+    }
+    return "unknown";
+}
+
+} // namespace netrunner
@@ -0,0 +1,233 @@
+//
+//  RegressionGate.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef RegressionGate_h
+#define RegressionGate_h
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+namespace netrunner {
+
+/**
+ * Compares the summary of a run with the summary of a baseline run and decides whether any model
+ * has regressed in latency or accuracy.
+ *
+ * Latency distributions are compared with a one-sided Mann-Whitney U test on the latency
+ * histograms, which are kept in summaries for this purpose. The test makes no assumption about
+ * the shape of the distributions, so long tails and the multiple modes of a thermally throttled
+ * device are handled. Values in the same histogram bucket, within about 1.6% of one another,
+ * count as ties. The size of a change is the relative change in median latency.
+ *
+ * Accuracies are compared with a one-sided Fisher exact test on the number of correct
+ * predictions of either run, and the size of a change is the absolute change in accuracy.
+ *
+ * A check fails only when a change is both statistically significant at `alpha` and larger than
+ * its threshold, so that a significant but negligible change in a large run, or a large but
+ * noisy change in a small one, does not fail the gate. Runs with fewer than `minimumSamples`
+ * measurements are inconclusive rather than failing. Significant changes for the better beyond
+ * the threshold are reported as improvements.
+ *
+ * The gate has no platform dependencies. The app and the command line runner read summaries into
+ * `ModelSamples` and write the `Result` in their own dictionary types.
+ */
+
+class RegressionGate {
+public:
+
+    /**
+     * The thresholds applied to a model's checks.
+     */
+
+    struct Thresholds {
+
+        /**
+         * The significance level of each one-sided test.
+         */
+
+        double alpha = 0.01;
+
+        /**
+         * The largest tolerated increase in median latency, relative to the baseline.
+         */
+
+        double latencyIncrease = 0.05;
+
+        /**
+         * The largest tolerated decrease in accuracy, as a difference of fractions.
+         */
+
+        double accuracyDecrease = 0.01;
+
+        /**
+         * The smallest number of measurements in either run for a check to be conclusive.
+         */
+
+        uint64_t minimumSamples = 30;
+    };
+
+    enum class Verdict {
+        Pass,
+        Improvement,
+        Inconclusive,
+        Regression,
+        Missing,
+        New
+    };
+
+    enum class Kind {
+        Latency,
+        Accuracy
+    };
+
+    /**
+     * The number of correct predictions out of a number of labeled predictions.
+     */
+
+    struct Proportion {
+        uint64_t correct = 0;
+        uint64_t count = 0;
+    };
+
+    /**
+     * The measurements of one model in one run. Models are matched by test bundle and model id,
+     * and checks by name, such as "inference_latency" or "accuracy_top1". The test bundle may be
+     * empty when a summary covers a single test bundle.
+     */
+
+    struct ModelSamples {
+        std::string testBundle;
+        std::string model;
+        std::vector<std::pair<std::string, LatencyHistogram::State>> latencies;
+        std::vector<std::pair<std::string, Proportion>> accuracies;
+    };
+
+    /**
+     * The outcome of comparing one latency distribution or accuracy. Latencies are medians in
+     * milliseconds and their change is relative, accuracies are fractions and their change is
+     * their difference. The p-value is that of the one-sided test in the direction of the change.
+     */
+
+    struct Check {
+        std::string name;
+        Kind kind = Kind::Latency;
+        Verdict verdict = Verdict::Pass;
+        double baseline = 0;
+        double candidate = 0;
+        double change = 0;
+        double pValue = 1;
+        double threshold = 0;
+        uint64_t baselineCount = 0;
+        uint64_t candidateCount = 0;
+    };
+
+    struct ModelResult {
+        std::string testBundle;
+        std::string model;
+        Verdict verdict = Verdict::Pass;
+        std::vector<Check> checks;
+    };
+
+    /**
+     * The gate fails if any model regressed or any model in the baseline is missing from the
+     * candidate run. Models new to the candidate run are reported but do not fail the gate.
+     */
+
+    struct Result {
+        bool passed = true;
+        uint64_t regressions = 0;
+        std::vector<ModelResult> models;
+    };
+
+    /**
+     * A gate with the default thresholds.
+     */
+
+    RegressionGate();
+
+    /**
+     * A gate with the given default thresholds.
+     */
+
+    explicit RegressionGate(const Thresholds &thresholds);
+
+    /**
+     * The thresholds applied to models without thresholds of their own.
+     */
+
+    const Thresholds &defaultThresholds() const { return _defaults; }
+
+    /**
+     * Overrides the thresholds applied to a model.
+     */
+
+    void setThresholds(const std::string &model, const Thresholds &thresholds);
+
+    /**
+     * The thresholds applied to a model.
+     */
+
+    const Thresholds &thresholds(const std::string &model) const;
+
+    /**
+     * Compares every model of a candidate run with the same model of a baseline run, in the
+     * order of the baseline followed by any new models. Baseline models of test bundles the
+     * candidate run did not include are skipped, so one baseline may gate a run of any of its
+     * test bundles.
+     */
+
+    Result compare(const std::vector<ModelSamples> &baseline, const std::vector<ModelSamples> &candidate) const;
+
+    static std::string VerdictName(Verdict verdict);
+    static std::string KindName(Kind kind);
+
+    // Statistics, exposed for testing
+
+    /**
+     * The one-sided p-value of the Mann-Whitney U test that candidate latencies tend to be
+     * larger than baseline latencies, or smaller when `larger` is false, using the normal
+     * approximation with tie and continuity corrections. Returns 1 if either histogram is empty.
+     */
+
+    static double MannWhitneyPValue(const LatencyHistogram::State &baseline, const LatencyHistogram::State &candidate, bool larger);
+
+    /**
+     * The one-sided p-value of Fisher's exact test that the candidate's accuracy is lower than
+     * the baseline's, or higher when `lower` is false. Returns 1 if either count is zero.
+     */
+
+    static double FisherExactPValue(const Proportion &baseline, const Proportion &candidate, bool lower);
+
+private:
+    Check compareLatencies(const std::string &name, const LatencyHistogram::State &baseline, const LatencyHistogram::State &candidate, const Thresholds &thresholds) const;
+    Check compareAccuracies(const std::string &name, const Proportion &baseline, const Proportion &candidate, const Thresholds &thresholds) const;
+
+    Thresholds _defaults;
+    std::map<std::string, Thresholds> _thresholds;
+};
+
+} // namespace netrunner
+
+#endif /* RegressionGate_h */
@@ -0,0 +1,291 @@
+//
+//  SteadyStateBenchmark.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "SteadyStateBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+namespace netrunner {
+
+namespace {
+
+// Acklam's rational approximation of the inverse of the standard normal CDF, accurate to about
+// 1e-9, which is plenty for confidence intervals
+
+double NormalQuantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00};
+
+    const double low = 0.02425;
+
+    if ( p < low ) {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5]) / ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+    }
+
+    if ( p > 1 - low ) {
+        double q = std::sqrt(-2 * std::log(1 - p));
+        return -(((((c[0]*q+c[1])*q+c[2])*q+c[3])*q+c[4])*q+c[5]) / ((((d[0]*q+d[1])*q+d[2])*q+d[3])*q+1);
+    }
+
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0]*r+a[1])*r+a[2])*r+a[3])*r+a[4])*r+a[5])*q / (((((b[0]*r+b[1])*r+b[2])*r+b[3])*r+b[4])*r+1);
+}
+
+double Median(std::vector<double> values) {
+    if ( values.empty() ) {
+        return 0;
+    }
+
+    size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    double median = values[middle];
+
+    if ( values.size() % 2 == 0 ) {
+        median = (median + *std::max_element(values.begin(), values.begin() + middle)) / 2;
+    }
+
+    return median;
+}
+
+// Mean and confidence interval half-width of the trailing window
+
+void Convergence(const std::vector<double> &latencies, unsigned window, double confidence, double *mean, double *halfWidth) {
+    size_t n = latencies.size();
+    size_t m = window == 0 ? n : std::min<size_t>(window, n);
+
+    *mean = 0;
+    *halfWidth = 0;
+
+    if ( m == 0 ) {
+        return;
+    }
+
+    double sum = 0;
+    for ( size_t i = n - m; i < n; i++ ) {
+        sum += latencies[i];
+    }
+    *mean = sum / m;
+
+    if ( m < 2 ) {
+        return;
+    }
+
+    double squares = 0;
+    for ( size_t i = n - m; i < n; i++ ) {
+        squares += (latencies[i] - *mean) * (latencies[i] - *mean);
+    }
+
+    double stddev = std::sqrt(squares / (m - 1));
+    *halfWidth = SteadyStateBenchmark::StudentT(confidence, static_cast<unsigned>(m - 1)) * stddev / std::sqrt(static_cast<double>(m));
+}
+
+} // namespace
+
+// MARK: - SystemBenchmarkClock
+
+double SystemBenchmarkClock::now() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SystemBenchmarkClock::sleep(double milliseconds) {
+    if ( milliseconds > 0 ) {
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(milliseconds));
+    }
+}
+
+// MARK: - SteadyStateBenchmark
+
+SteadyStateBenchmark::SteadyStateBenchmark(const Options &options, BenchmarkClock *clock)
+    : _options(options), _clock(clock != nullptr ? clock : &_systemClock) {}
+
+SteadyStateBenchmark::Result SteadyStateBenchmark::run(const Measurement &measurement) {
+    Result result;
+    double latency;
+
+    // Warm up, without measuring
+
+    for ( unsigned i = 0; i < _options.warmupRuns; i++ ) {
+        measurement(&latency);
+        result.warmupRuns += 1;
+        _clock->sleep(_options.cooldown);
+        waitForThermalState(&result);
+    }
+
+    // Measure until the mean converges or a limit is reached
+
+    const double start = _clock->now();
+    unsigned consecutiveFailures = 0;
+
+    while ( true ) {
+        if ( result.runs >= _options.maxRuns ) {
+            result.stopReason = StopReason::MaxRuns;
+            break;
+        }
+
+        if ( _options.maxDuration > 0 && _clock->now() - start >= _options.maxDuration ) {
+            result.stopReason = StopReason::MaxDuration;
+            break;
+        }
+
+        if ( !measurement(&latency) ) {
+            result.failedRuns += 1;
+            if ( ++consecutiveFailures >= kMaxConsecutiveFailures ) {
+                result.stopReason = StopReason::Failed;
+                break;
+            }
+            continue;
+        }
+
+        consecutiveFailures = 0;
+        result.runs += 1;
+        result.latencies.push_back(latency);
+        result.timestamps.push_back(_clock->now() - start);
+
+        if ( result.runs >= std::max(2u, _options.minRuns) ) {
+            double mean, halfWidth;
+            Convergence(result.latencies, _options.window, _options.confidence, &mean, &halfWidth);
+
+            if ( mean > 0 && halfWidth / mean <= _options.relativeError ) {
+                result.stopReason = StopReason::Converged;
+                break;
+            }
+        }
+
+        _clock->sleep(_options.cooldown);
+        waitForThermalState(&result);
+    }
+
+    result.duration = _clock->now() - start;
+    analyze(&result);
+
+    return result;
+}
+
+void SteadyStateBenchmark::waitForThermalState(Result *result) {
+    if ( !_options.thermalState ) {
+        return;
+    }
+
+    int state = _options.thermalState();
+    result->maxThermalState = std::max(result->maxThermalState, state);
+
+    while ( state >= _options.thermalCooldownState && result->thermalWait < _options.maxThermalWait ) {
+        _clock->sleep(_options.thermalCooldownStep);
+        result->thermalWait += _options.thermalCooldownStep;
+        state = _options.thermalState();
+        result->maxThermalState = std::max(result->maxThermalState, state);
+    }
+}
+
+void SteadyStateBenchmark::analyze(Result *result) const {
+    const std::vector<double> &latencies = result->latencies;
+    const std::vector<double> &timestamps = result->timestamps;
+    const size_t n = latencies.size();
+
+    Convergence(latencies, _options.window, _options.confidence, &result->steadyStateLatency, &result->confidenceInterval);
+    result->relativeError = result->steadyStateLatency > 0 ? result->confidenceInterval / result->steadyStateLatency : 0;
+
+    // Least squares slope of latency against time in seconds
+
+    result->trend = 0;
+
+    if ( n >= 3 ) {
+        double meanTime = 0, meanLatency = 0;
+        for ( size_t i = 0; i < n; i++ ) {
+            meanTime += timestamps[i] / 1000.0;
+            meanLatency += latencies[i];
+        }
+        meanTime /= n;
+        meanLatency /= n;
+
+        double covariance = 0, variance = 0;
+        for ( size_t i = 0; i < n; i++ ) {
+            double t = timestamps[i] / 1000.0 - meanTime;
+            covariance += t * (latencies[i] - meanLatency);
+            variance += t * t;
+        }
+
+        result->trend = variance > 0 ? covariance / variance : 0;
+    }
+
+    // Compare the first and last quarters
+
+    result->throttlingRatio = 1;
+
+    if ( n >= 8 ) {
+        size_t quarter = n / 4;
+        double first = Median(std::vector<double>(latencies.begin(), latencies.begin() + quarter));
+        double last = Median(std::vector<double>(latencies.end() - quarter, latencies.end()));
+        result->throttlingRatio = first > 0 ? last / first : 1;
+    }
+
+    bool risingLatency = result->throttlingRatio >= 1 + _options.throttleThreshold && result->trend > 0;
+    bool hotDevice = _options.thermalState && result->maxThermalState >= _options.thermalCooldownState;
+
+    result->throttled = risingLatency || hotDevice;
+}
+
+double SteadyStateBenchmark::StudentT(double confidence, unsigned degreesOfFreedom) {
+    const double p = 1 - (1 - confidence) / 2;
+    const double v = degreesOfFreedom;
+
+    if ( degreesOfFreedom == 0 ) {
+        return INFINITY;
+    }
+
+    if ( degreesOfFreedom == 1 ) {
+        return std::tan(M_PI * (p - 0.5));
+    }
+
+    if ( degreesOfFreedom == 2 ) {
+        return (2 * p - 1) / std::sqrt(2 * p * (1 - p));
+    }
+
+    // Cornish-Fisher expansion around the normal quantile
+
+    const double z = NormalQuantile(p);
+    const double z2 = z * z;
+
+    const double g1 = (z2 + 1) * z / 4;
+    const double g2 = ((5 * z2 + 16) * z2 + 3) * z / 96;
+    const double g3 = (((3 * z2 + 19) * z2 + 17) * z2 - 15) * z / 384;
+    const double g4 = ((((79 * z2 + 776) * z2 + 1482) * z2 - 1920) * z2 - 945) * z / 92160;
+
+    return z + g1 / v + g2 / (v * v) + g3 / (v * v * v) + g4 / (v * v * v * v);
+}
+
+std::string SteadyStateBenchmark::StopReasonName(StopReason reason) {
+    switch ( reason ) {
+    case StopReason::Converged: return "converged";
+    case StopReason::MaxRuns: return "max_runs";
+    case StopReason::MaxDuration: return "max_duration";
+    case StopReason::Failed: return "failed";
+    }
+    return "unknown";
+}
+
+} // namespace netrunner
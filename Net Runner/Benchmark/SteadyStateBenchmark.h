@@ -0,0 +1,259 @@
+//
+//  SteadyStateBenchmark.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef SteadyStateBenchmark_h
+#define SteadyStateBenchmark_h
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * The source of time for a benchmark. Inject a manual clock to exercise a benchmark with a
+ * synthetic model without waiting on real time.
+ */
+
+class BenchmarkClock {
+public:
+    virtual ~BenchmarkClock() = default;
+
+    /**
+     * Monotonic time in milliseconds.
+     */
+
+    virtual double now() = 0;
+
+    /**
+     * Blocks for the given number of milliseconds.
+     */
+
+    virtual void sleep(double milliseconds) = 0;
+};
+
+/**
+ * A `BenchmarkClock` backed by `std::chrono::steady_clock`.
+ */
+
+class SystemBenchmarkClock : public BenchmarkClock {
+public:
+    double now() override;
+    void sleep(double milliseconds) override;
+};
+
+/**
+ * Runs a measurement repeatedly until its latency reaches a steady state.
+ *
+ * After discarding a number of warm-up runs, the benchmark measures until the confidence interval
+ * of the mean latency over the trailing window is within a relative error of the mean, or until
+ * a run or time limit is reached. An optional cooldown separates runs, and when a thermal state
+ * provider is supplied the benchmark also waits for the device to cool before continuing.
+ *
+ * Thermal throttling shows up as latency that rises over time. The benchmark fits a trend line
+ * to latency against time and compares the median of the first and last quarters of the runs,
+ * and flags the result as throttled when latency has risen by more than a threshold.
+ *
+ * Usage:
+ *
+ * @code
+ * SteadyStateBenchmark benchmark(options);
+ * SteadyStateBenchmark::Result result = benchmark.run([&](double *latency) {
+ *     *latency = RunModelOnce();
+ *     return true;
+ * });
+ * @endcode
+ */
+
+class SteadyStateBenchmark {
+public:
+
+    struct Options {
+
+        /**
+         * Runs discarded before measuring begins, to exclude model load and first-inference costs.
+         */
+
+        unsigned warmupRuns = 5;
+
+        /**
+         * The minimum and maximum number of measured runs.
+         */
+
+        unsigned minRuns = 10;
+        unsigned maxRuns = 1000;
+
+        /**
+         * The maximum time spent measuring in milliseconds, excluding warm-up, or 0 for no limit.
+         */
+
+        double maxDuration = 60000;
+
+        /**
+         * Time to wait after each run in milliseconds.
+         */
+
+        double cooldown = 0;
+
+        /**
+         * The benchmark has converged when the half-width of the `confidence` interval of the
+         * mean is within `relativeError` of the mean.
+         */
+
+        double confidence = 0.95;
+        double relativeError = 0.02;
+
+        /**
+         * The number of most recent runs over which convergence is measured, or 0 to use every
+         * measured run. A trailing window lets the estimate settle after latency shifts.
+         */
+
+        unsigned window = 30;
+
+        /**
+         * The relative rise in latency from the first to the last quarter of the runs above which
+         * the result is flagged as throttled.
+         */
+
+        double throttleThreshold = 0.1;
+
+        /**
+         * Optional. Returns the device's current thermal state, where larger values are hotter,
+         * e.g. `NSProcessInfoThermalState`. While the state is at or above `thermalCooldownState`
+         * the benchmark waits in steps of `thermalCooldownStep` milliseconds, for up to
+         * `maxThermalWait` milliseconds in total.
+         */
+
+        std::function<int()> thermalState;
+        int thermalCooldownState = 2;
+        double thermalCooldownStep = 1000;
+        double maxThermalWait = 60000;
+    };
+
+    enum class StopReason {
+        Converged,
+        MaxRuns,
+        MaxDuration,
+        Failed
+    };
+
+    struct Result {
+        StopReason stopReason = StopReason::Failed;
+        unsigned warmupRuns = 0;
+        unsigned runs = 0;
+        unsigned failedRuns = 0;
+
+        /**
+         * The mean latency over the trailing window and the half-width of its confidence interval,
+         * in milliseconds, and the half-width relative to the mean.
+         */
+
+        double steadyStateLatency = 0;
+        double confidenceInterval = 0;
+        double relativeError = 0;
+
+        /**
+         * The slope of the least squares fit of latency against time, in milliseconds of latency
+         * per second of benchmarking.
+         */
+
+        double trend = 0;
+
+        /**
+         * The median latency of the last quarter of the runs over that of the first quarter.
+         */
+
+        double throttlingRatio = 1;
+        bool throttled = false;
+
+        int maxThermalState = 0;
+        double thermalWait = 0;
+
+        /**
+         * Measured time in milliseconds, excluding warm-up.
+         */
+
+        double duration = 0;
+
+        /**
+         * Every measured latency and the time at which it completed, relative to the start of
+         * measurement, in milliseconds.
+         */
+
+        std::vector<double> latencies;
+        std::vector<double> timestamps;
+
+        bool converged() const { return stopReason == StopReason::Converged; }
+    };
+
+    /**
+     * Performs one run, setting latency in milliseconds. Returns false if the run failed, in
+     * which case it is not measured.
+     */
+
+    using Measurement = std::function<bool(double *latency)>;
+
+    /**
+     * @param options The benchmark options.
+     * @param clock The clock used for durations, timestamps and waits. Uses a
+     *  `SystemBenchmarkClock` if null. Not owned, and must outlive the benchmark.
+     */
+
+    explicit SteadyStateBenchmark(const Options &options, BenchmarkClock *clock = nullptr);
+
+    /**
+     * Runs the measurement until it converges or a limit is reached. Gives up after
+     * `kMaxConsecutiveFailures` failed runs in a row.
+     */
+
+    Result run(const Measurement &measurement);
+
+    const Options &options() const { return _options; }
+
+    static const unsigned kMaxConsecutiveFailures = 10;
+
+    static std::string StopReasonName(StopReason reason);
+
+    // Statistics, exposed for testing
+
+    /**
+     * The two-sided critical value of Student's t distribution for a confidence level and
+     * degrees of freedom.
+     */
+
+    static double StudentT(double confidence, unsigned degreesOfFreedom);
+
+    /**
+     * Updates the convergence and throttling fields of result from its latencies and timestamps.
+     */
+
+    void analyze(Result *result) const;
+
+private:
+    void waitForThermalState(Result *result);
+
+    Options _options;
+    SystemBenchmarkClock _systemClock;
+    BenchmarkClock *_clock;
+};
+
+} // namespace netrunner
+
+#endif /* SteadyStateBenchmark_h */
@@ -23,6 +23,8 @@
 #import "ModelDetailsTableViewController.h"
 #import "EvaluateSelectAlbumsTableViewController.h"
 #import "EvaluateModelTableViewCell.h"
+#import "ModelManager.h"
+#import "ModelBundleHeader.h"
 
 @import TensorIO;
 
@@ -41,15 +43,31 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 // TODO: revisit how "data" payload is passed across controllers
 // ^^^^: This may involve a refactoring of the Evaluate and Collect code to make it simpler to share across them.
 
+- (BOOL)shouldPerformSegueWithIdentifier:(NSString *)identifier sender:(id)sender {
+    if ( [identifier isEqualToString:@"SelectAlbumsSegue"] ) {
+        NSIndexPath *indexPath = [self.tableView indexPathForCell:sender];
+        ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
+        
+        if ( header.bundle == nil ) {
+            [self.tableView deselectRowAtIndexPath:indexPath animated:YES];
+            [self showUnavailableModelAlert:header];
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
 - (void)prepareForSegue:(UIStoryboardSegue *)segue sender:(id)sender {
     if ( [segue.identifier isEqualToString:@"ModelDetailsSegue"] ) {
         ModelDetailsTableViewController *destination = (ModelDetailsTableViewController*)segue.destinationViewController;
-        destination.bundle = TIOModelBundleManager.sharedManager.modelBundles[((NSIndexPath*)sender).row];
+        destination.bundle = ModelManager.sharedManager.modelHeaders[((NSIndexPath*)sender).row].bundle;
         destination.actions = (ModelDetailsActionClearLabels|ModelDetailsActionShareLabels);
     
     } else if ( [segue.identifier isEqualToString:@"SelectAlbumsSegue"] ) {
         EvaluateSelectAlbumsTableViewController *destination = (EvaluateSelectAlbumsTableViewController*)segue.destinationViewController;
-        TIOModelBundle *bundle = TIOModelBundleManager.sharedManager.modelBundles[self.tableView.indexPathForSelectedRow.row];
+        NSIndexPath *indexPath = [self.tableView indexPathForCell:sender];
+        TIOModelBundle *bundle = ModelManager.sharedManager.modelHeaders[indexPath.row].bundle;
         
         destination.data = @{
             @"bundles": @[bundle]
@@ -64,7 +82,7 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-    return TIOModelBundleManager.sharedManager.modelBundles.count;
+    return ModelManager.sharedManager.modelHeaders.count;
 }
 
 - (NSString*)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
@@ -82,12 +100,12 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
     EvaluateModelTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:kModelCellIdentifier forIndexPath:indexPath];
-    TIOModelBundle *bundle = TIOModelBundleManager.sharedManager.modelBundles[indexPath.row];
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
     
     cell.titleLabel.font = [UIFont systemFontOfSize:[UIFont systemFontSize]];
     cell.accessoryType = UITableViewCellAccessoryDetailButton;
     
-    cell.bundle = bundle;
+    cell.header = header;
     
     return cell;
 }
@@ -97,7 +115,32 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 }
 
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath {
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
+    
+    if ( header.bundle == nil ) {
+        [self showUnavailableModelAlert:header];
+        return;
+    }
+    
     [self performSegueWithIdentifier:@"ModelDetailsSegue" sender:indexPath];
 }
 
+// MARK: - Alerts
+
+// A header is listed from the manifest, but its bundle may no longer be readable
+
+- (void)showUnavailableModelAlert:(ModelBundleHeader*)header {
+    UIAlertController *alert = [UIAlertController
+        alertControllerWithTitle:NSLocalizedString(@"Unable to load model", @"Failed to load model alert title")
+        message:[NSString stringWithFormat:NSLocalizedString(@"The model bundle for %@ could not be read. Ensure it exists and is valid.", @"Failed to read model bundle alert message"), header.name]
+        preferredStyle:UIAlertControllerStyleAlert];
+    
+    [alert addAction:[UIAlertAction
+        actionWithTitle:NSLocalizedString(@"Dismiss", @"Alert dismiss action")
+        style:UIAlertActionStyleDefault
+        handler:nil]];
+    
+    [self presentViewController:alert animated:YES completion:nil];
+}
+
 @end
@@ -25,6 +25,8 @@
 #import "EvaluateIterationsTableViewCell.h"
 #import "EvaluateResultsTableViewController.h"
 #import "UserDefaults.h"
+#import "ModelManager.h"
+#import "ModelBundleHeader.h"
 
 @import TensorIO;
 
@@ -53,6 +55,8 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
         
         NSMutableDictionary *data = [self.data mutableCopy];
         data[@"iterations"] = self.iterations;
+        data[@"parallel"] = @([NSUserDefaults.standardUserDefaults boolForKey:kPrefsEvaluateModelsInParallel]);
+        data[@"resume"] = @([NSUserDefaults.standardUserDefaults boolForKey:kPrefsEvaluateResumesInterrupted]);
         
         destination.data = [data copy];
     }
@@ -101,7 +105,7 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
         cell.titleLabel.font = [UIFont systemFontOfSize:[UIFont systemFontSize]];
 
         cell.selectedSwitch.hidden = YES;
-        cell.bundle = bundle;
+        cell.header = [ModelManager.sharedManager headerWithId:bundle.identifier];
         
         return cell;
     }
@@ -24,10 +24,13 @@
 #import "Evaluator.h"
 #import "ImageEvaluator.h"
 #import "EvaluateResultsModelTableViewCell.h"
-#import "EvaluationResultsActivityItemProvider.h"
 #import "EvaluateResultsByModelCollectionViewController.h"
-#import "PHFetchResult+Extensions.h"
 #import "EvaluatorConstants.h"
+#import "EvaluationEngine.h"
+#import "EvaluationResultsSink.h"
+#import "EvaluationCheckpoint.h"
+#import "EvaluationUnits.h"
+#import "EvaluationSummaryAccumulator.h"
 
 @import TensorIO;
 
@@ -49,11 +52,18 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
 
 @implementation EvaluateResultsTableViewController {
     dispatch_queue_t _evaluatorQueue;
+    EvaluationEngine *_engine;
     
     NSMutableDictionary *_progress;
-    NSMutableDictionary *_results;
+    NSMutableDictionary *_latencies;
     NSMutableDictionary *_state;
     
+    // Results are streamed to a file and read back for one model at a time
+    
+    NSURL *_resultsURL;
+    NSDictionary<NSString*,id<TIOModel>> *_models;
+    EvaluationUnits *_units;
+    
     BOOL _cancelledEvaluation;
     BOOL _completedEvaluation;
 }
@@ -68,11 +78,11 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     // State initialization: keep track of progress, results, and cell state
     
     _progress = [[NSMutableDictionary alloc] init];
-    _results = [[NSMutableDictionary alloc] init];
+    _latencies = [[NSMutableDictionary alloc] init];
     _state = [[NSMutableDictionary alloc] init];
     
     for ( TIOModelBundle *bundle in self.bundles ) {
-        // Do not initialize _results values to anything
+        // Do not initialize _latencies values to anything
         _state[bundle.identifier] = @(EvaluateResultsStateShowProgress);
         _progress[bundle.identifier] = @(0);
     }
@@ -136,7 +146,7 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     if ( [segue.identifier isEqualToString:@"ShowResultsForModel"] ) {
         EvaluateResultsByModelCollectionViewController *destination = (EvaluateResultsByModelCollectionViewController*)segue.destinationViewController;
         TIOModelBundle *modelBundle = self.bundles[[self.tableView.indexPathForSelectedRow row]];
-        destination.results = _results[modelBundle.identifier];
+        destination.results = [self resultsForBundle:modelBundle];
         destination.imageManager = self.imageManager;
         destination.modelBundle = modelBundle;
     }
@@ -163,7 +173,7 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
 
 // MARK: - Evaluation
 
-- (NSArray<PHAsset*>*)assetsForCollection:(PHAssetCollection*)collection {
+- (PHFetchResult<PHAsset*>*)fetchResultForCollection:(PHAssetCollection*)collection {
     NSPredicate *fetchPredicate = [NSPredicate predicateWithFormat:@"(mediaType = %d)", PHAssetMediaTypeImage ];
     NSArray<NSSortDescriptor*> *sortDescriptors = @[[NSSortDescriptor sortDescriptorWithKey:@"creationDate" ascending:YES]];
     
@@ -173,21 +183,45 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     fetchOptions.includeAllBurstAssets = NO;
     fetchOptions.includeHiddenAssets = NO;
     
-    PHFetchResult *fetchResult = [PHAsset fetchAssetsInAssetCollection:collection options:fetchOptions];
-    return fetchResult.allAssets;
+    return [PHAsset fetchAssetsInAssetCollection:collection options:fetchOptions];
 }
 
-// Future optimization might run each model on its own operation queue
-// See HeadlessTestBundleRunner
+// Each model is evaluated on its own lane of an EvaluationEngine. Lanes run concurrently only
+// when parallel evaluation is enabled, since latencies are then contended.
 
 - (void)evaluateAlbums {
-    dispatch_async(_evaluatorQueue, ^{
+    EvaluationEngineMode mode = [_data[@"parallel"] boolValue]
+        ? EvaluationEngineModeParallel
+        : EvaluationEngineModeSerial;
     
-        // For each model, album, asset, iteration: build an evaluator
+    EvaluationEngine *engine = [[EvaluationEngine alloc] initWithMode:mode];
+    _engine = engine;
     
-        NSMutableArray<AlbumPhotoEvaluator*> *evaluators = [[NSMutableArray<AlbumPhotoEvaluator*> alloc] init];
+    dispatch_async(_evaluatorQueue, ^{
+    
+        // Fetch results are lazy, so assets are only materialized as evaluators reach them, or
+        // once up front to identify each photo when resuming
+        
+        NSMutableArray<PHFetchResult<PHAsset*>*> *fetchResults = [[NSMutableArray alloc] init];
+        NSMutableArray<NSNumber*> *albumOffsets = [[NSMutableArray alloc] init];
         NSUInteger numberOfPhotos = 0;
-        NSUInteger numberOfModels = 0;
+        
+        for ( PHAssetCollection *album in self.albums ) {
+            PHFetchResult<PHAsset*> *fetchResult = [self fetchResultForCollection:album];
+            [fetchResults addObject:fetchResult];
+            [albumOffsets addObject:@(numberOfPhotos)];
+            numberOfPhotos += fetchResult.count;
+        }
+        
+        NSArray<PHAssetCollection*> *albums = self.albums;
+        NSUInteger iterations = self.iterations.unsignedIntegerValue;
+        BOOL resumes = [self->_data[@"resume"] boolValue];
+        
+        // Instantiate the models
+        
+        NSMutableArray<id<TIOModel>> *models = [[NSMutableArray alloc] init];
+        NSMutableDictionary<NSString*,id<TIOModel>> *modelsByID = [[NSMutableDictionary alloc] init];
+        NSMutableDictionary<NSString*,TIOModelBundle*> *bundlesByModel = [[NSMutableDictionary alloc] init];
     
         for ( TIOModelBundle *modelBundle in self.bundles ) {
         
@@ -198,66 +232,135 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
                 continue;
             }
             
-            numberOfModels++;
+            bundlesByModel[model.identifier] = modelBundle;
+            modelsByID[model.identifier] = model;
+            [models addObject:model];
+        }
+        
+        // Results are streamed to disk as they complete so that partial results survive
+        // interruption and memory does not grow with the albums, and only each model's average
+        // latency is kept. A resumable evaluation of the same albums appends to the same file and
+        // restores the evaluations already in it, by model, photo and iteration
+        
+        NSURL *documents = [NSFileManager.defaultManager URLsForDirectory:NSDocumentDirectory inDomains:NSUserDomainMask].firstObject;
+        NSString *filename = resumes
+            ? [NSString stringWithFormat:@"evaluation-%016llx.jsonl", [self albumsFingerprint]]
+            : [NSString stringWithFormat:@"evaluation-%.0f.jsonl", NSDate.date.timeIntervalSince1970];
+        NSURL *resultsURL = [[documents URLByAppendingPathComponent:@"evaluations" isDirectory:YES] URLByAppendingPathComponent:filename];
+        
+        EvaluationSummaryAccumulator *accumulator = [[EvaluationSummaryAccumulator alloc] initWithMetric:nil labels:nil warmup:0];
+        EvaluationCheckpoint *checkpoint = nil;
+        EvaluationUnits *units = nil;
+        
+        if ( resumes ) {
+            units = [self unitsForModels:models fetchResults:fetchResults iterations:iterations];
+            checkpoint = [[EvaluationCheckpoint alloc] initWithURL:resultsURL];
             
-            for ( PHAssetCollection *album in self.albums ) {
-                NSArray<PHAsset*> *assets = [self assetsForCollection:album];
-                for ( PHAsset *photo in assets ) {
-                    for ( NSUInteger iter = 0; iter < self.iterations.integerValue; iter++ ) {
-                        AlbumPhotoEvaluator *evaluator = [[AlbumPhotoEvaluator alloc]
-                            initWithModel:model
-                            photo:photo
-                            album:album
-                            imageManager:self.imageManager];
-                        
-                        [evaluators addObject:evaluator];
-                        numberOfPhotos++;
-                    }
-                }
+            for ( id<TIOModel> model in models ) {
+                [units enumerateUnitsForModel:model.identifier usingBlock:^(NSString * _Nonnull unit, NSUInteger index) {
+                    [checkpoint expectUnit:unit];
+                }];
             }
+            
+            NSError *resumeError;
+            
+            if ( ![checkpoint resumeWithModels:models recordHandler:^(NSDictionary<NSString*,id> * _Nonnull record) {
+                [accumulator addResult:record];
+            } error:&resumeError] ) {
+                NSLog(@"Unable to resume evaluation, error: %@", resumeError);
+            }
+            
+            NSLog(@"Resuming evaluation with %tu of %tu evaluations complete", checkpoint.completedCount, checkpoint.expectedCount);
         }
         
-        numberOfPhotos = numberOfPhotos / numberOfModels;
+        dispatch_async(dispatch_get_main_queue(), ^{
+            self->_resultsURL = resultsURL;
+            self->_models = modelsByID.copy;
+            self->_units = units;
+        });
         
-        // Execute the evaluators and collect the results
+        // For each model add a lane whose evaluators are built on demand: album, asset, iteration
         
-        NSMutableArray<NSDictionary*> *results = [[NSMutableArray<NSDictionary*> alloc] init];
+        for ( id<TIOModel> model in models ) {
+            
+            NSString *modelID = model.identifier;
+            
+            EvaluationEngineSkipBlock skip = checkpoint == nil ? nil : ^BOOL(NSUInteger index) {
+                return [checkpoint isUnitComplete:[units unitForModel:modelID index:index]];
+            };
+            
+            [engine addModel:model.identifier count:numberOfPhotos * iterations skipping:skip generator:^id<Evaluator> _Nullable(NSUInteger index) {
+                NSUInteger photoIndex = index / iterations;
+                NSUInteger albumIndex = 0;
+                
+                while ( albumIndex + 1 < albumOffsets.count && albumOffsets[albumIndex+1].unsignedIntegerValue <= photoIndex ) {
+                    albumIndex++;
+                }
+                
+                PHAsset *photo = fetchResults[albumIndex][photoIndex - albumOffsets[albumIndex].unsignedIntegerValue];
+                
+                return [[AlbumPhotoEvaluator alloc]
+                    initWithModel:model
+                    photo:photo
+                    album:albums[albumIndex]
+                    imageManager:self.imageManager];
+            }];
+        }
         
-        for ( id<Evaluator> evaluator in evaluators ) {
+        // Execute the evaluators, reporting progress and results for each model as it completes
+        
+        engine.progressHandler = ^(NSString * _Nonnull modelID, NSUInteger completed, NSUInteger total) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                self->_progress[modelID] = @(completed);
+                
+                if ( completed != total ) {
+                    [self updateProgressForBundle:bundlesByModel[modelID] completed:completed totalCount:total];
+                }
+            });
+        };
+        
+        engine.modelCompletionHandler = ^(NSString * _Nonnull modelID, NSArray<NSDictionary<NSString*,id>*> * _Nonnull modelResults) {
+            NSNumber *latency = @(0);
             
-            if ( self->_cancelledEvaluation ) {
-                break;
+            for ( NSDictionary<NSString*,id> *modelSummary in accumulator.summary ) {
+                if ( [modelSummary[kEvaluatorResultsKeyModel] isEqualToString:modelID] ) {
+                    latency = modelSummary[@"latency"];
+                }
             }
             
-            @autoreleasepool {
-                [evaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
-                    id<TIOModel> model = evaluator.model;
-                    NSString *modelID = result[kEvaluatorResultsKeyModel];
-                    NSUInteger completedCount = [self->_progress[modelID] integerValue] + 1;
-                    
-                    self->_progress[modelID] = @(completedCount);
-                    [results addObject:result];
-                    
-                    if ( completedCount != numberOfPhotos ) {
-                        dispatch_async(dispatch_get_main_queue(), ^{
-                            [self updateProgressForBundle:model.bundle completed:completedCount totalCount:numberOfPhotos];
-                        });
-                    } else {
-                        NSArray *modelResults =
-                            [results
-                            filter:^BOOL(NSDictionary * _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
-                                return [obj[kEvaluatorResultsKeyModel] isEqualToString:model.identifier];
-                            }];
-                        
-                        dispatch_async(dispatch_get_main_queue(), ^{
-                            [self completedEvaluation:modelResults forBundle:model.bundle];
-                        });
-                    }
-                    
-                }];
-            } // autorelease pool
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [self completedEvaluationWithLatency:latency forBundle:bundlesByModel[modelID]];
+            });
+        };
+        
+        NSError *sinkError;
+        EvaluationResultsSink *sink = [[EvaluationResultsSink alloc] initWithURL:resultsURL error:&sinkError];
+        
+        if ( sink == nil ) {
+            NSLog(@"Unable to open evaluation results file, error: %@", sinkError);
         }
         
+        engine.collectsResults = NO;
+        engine.resultHandler = ^(NSString * _Nonnull modelID, NSUInteger index, NSDictionary<NSString*,id> * _Nonnull result) {
+            NSDictionary<NSString*,id> *record = result;
+            
+            if ( NSString *unit = [units unitForModel:modelID index:index] ) {
+                NSMutableDictionary *unitResult = [result mutableCopy];
+                unitResult[kEvaluatorResultsKeyUnit] = unit;
+                record = unitResult.copy;
+            }
+            
+            [accumulator addResult:record];
+            
+            NSError *appendError;
+            if ( sink != nil && ![sink appendResult:record error:&appendError] ) {
+                NSLog(@"Unable to write evaluation result, error: %@", appendError);
+            }
+        };
+        
+        [engine run];
+        [sink close:nil];
+        
         dispatch_async(dispatch_get_main_queue(), ^{
             self->_completedEvaluation = YES;
             [self completedEvaluation];
@@ -266,6 +369,80 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     }); // dispatch
 }
 
+// MARK: - Results
+
+// Reads a model's results back from the results file. When resuming, the file also holds the
+// records of earlier runs, so only the first record of each of this run's units is read
+
+- (NSArray<NSDictionary*>*)resultsForBundle:(TIOModelBundle*)bundle {
+    id<TIOModel> model = _models[bundle.identifier];
+    
+    if ( model == nil || _resultsURL == nil ) {
+        return @[];
+    }
+    
+    NSMutableArray<NSDictionary*> *results = [[NSMutableArray alloc] init];
+    NSError *error;
+    BOOL success;
+    
+    if ( _units != nil ) {
+        EvaluationCheckpoint *checkpoint = [[EvaluationCheckpoint alloc] initWithURL:_resultsURL];
+        
+        [_units enumerateUnitsForModel:model.identifier usingBlock:^(NSString * _Nonnull unit, NSUInteger index) {
+            [checkpoint expectUnit:unit];
+        }];
+        
+        success = [checkpoint resumeWithModels:@[model] recordHandler:^(NSDictionary<NSString*,id> * _Nonnull record) {
+            [results addObject:record];
+        } error:&error];
+    } else {
+        success = [EvaluationCheckpoint readResultsAtURL:_resultsURL model:model recordHandler:^(NSDictionary<NSString*,id> * _Nonnull record) {
+            [results addObject:record];
+        } error:&error];
+    }
+    
+    if ( !success ) {
+        NSLog(@"Unable to read evaluation results, error: %@", error);
+    }
+    
+    return results.copy;
+}
+
+// MARK: - Checkpoints
+
+// Identifies the selected albums, so that evaluating the same albums again resumes from the same file
+
+- (uint64_t)albumsFingerprint {
+    NSArray<NSString*> *identifiers = [[self.albums valueForKey:@"localIdentifier"] sortedArrayUsingSelector:@selector(compare:)];
+    return [EvaluationCheckpoint contentHashForString:[identifiers componentsJoinedByString:@"\n"]];
+}
+
+// The units of the models' evaluations, in engine order: photo-major, iteration-minor. Photos
+// are identified by their asset and modification date, which changes when a photo is edited
+
+- (EvaluationUnits*)unitsForModels:(NSArray<id<TIOModel>>*)models fetchResults:(NSArray<PHFetchResult<PHAsset*>*>*)fetchResults iterations:(NSUInteger)iterations {
+    uint64_t optionsFingerprint = [EvaluationCheckpoint fingerprintForOptions:@{
+        @"parallel": @([_data[@"parallel"] boolValue])
+    }];
+    
+    EvaluationUnits *units = [[EvaluationUnits alloc] initWithIterations:iterations options:optionsFingerprint];
+    
+    for ( PHFetchResult<PHAsset*> *fetchResult in fetchResults ) {
+        [fetchResult enumerateObjectsUsingBlock:^(PHAsset * _Nonnull asset, NSUInteger idx, BOOL * _Nonnull stop) {
+            NSString *identity = [NSString stringWithFormat:@"%@@%.3f", asset.localIdentifier, asset.modificationDate.timeIntervalSince1970];
+            [units addInput:[EvaluationCheckpoint contentHashForString:identity]];
+        }];
+    }
+    
+    for ( id<TIOModel> model in models ) {
+        [units addModel:model];
+    }
+    
+    return units;
+}
+
+// MARK: - Progress
+
 - (void)updateProgressForBundle:(TIOModelBundle*)bundle completed:(NSUInteger)completed totalCount:(NSUInteger)totalCount {
     NSUInteger index = [self.bundles indexOfObject:bundle];
     NSIndexPath *indexPath = [NSIndexPath indexPathForRow:index inSection:0];
@@ -279,9 +456,9 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     [cell.progressView setProgress:(float)completed/(float)totalCount animated:YES];
 }
 
-- (void)completedEvaluation:(NSArray<NSDictionary*>*)results forBundle:(TIOModelBundle*)bundle {
+- (void)completedEvaluationWithLatency:(NSNumber*)latency forBundle:(TIOModelBundle*)bundle {
     _state[bundle.identifier] = @(EvaluateResultsStateShowResults);
-    _results[bundle.identifier] = results;
+    _latencies[bundle.identifier] = latency;
     
     NSUInteger index = [self.bundles indexOfObject:bundle];
     NSIndexPath *indexPath = [NSIndexPath indexPathForRow:index inSection:0];
@@ -307,32 +484,7 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
 }
 
 - (double)averageLatencyForModel:(TIOModelBundle*)bundle {
-    NSArray *results = _results[bundle.identifier];
-    
-    if ( results == nil || results.count == 0) {
-        return 0;
-    }
-    
-    NSArray<NSDictionary*> *goodResults =
-        [results
-        filter:^BOOL(NSDictionary * _Nonnull result, NSUInteger idx, BOOL * _Nonnull stop) {
-            return ![result[kEvaluatorResultsKeyError] boolValue];
-        }];
-    
-    NSInteger goodCount = goodResults.count;
-    
-    double totalLatency =
-        [[[goodResults
-        map:^id _Nonnull(NSDictionary * _Nonnull obj) {
-            return obj[kEvaluatorResultsKeyEvaluation][kEvaluatorResultsKeyInferenceLatency];
-        }]
-        reduce:@((double)0.0) combine:^id _Nonnull(NSNumber * _Nonnull accumulator, NSNumber * _Nonnull item) {
-            return @(accumulator.doubleValue + item.doubleValue);
-        }]
-        doubleValue
-        ];
-    
-    return totalLatency / goodCount;
+    return [_latencies[bundle.identifier] doubleValue];
 }
 
 #pragma mark - Table view data source
@@ -379,6 +531,7 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
     
     UIAlertAction *stopEvaluation = [UIAlertAction actionWithTitle:@"Stop Evaluation" style:UIAlertActionStyleDestructive handler:^(UIAlertAction * _Nonnull action) {
         self->_cancelledEvaluation = YES;
+        [self->_engine cancel];
         
         dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.3 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
             [self dismissViewControllerAnimated:YES completion:nil];
@@ -398,21 +551,14 @@ static NSString * const kModelResultsCellIdentifier = @"ModelResultsCell";
 }
 
 - (void)shareEvaluation:(id)sender {
-
-    // Convert results dictionary to array
-
-    NSMutableArray<NSDictionary*> *results = [[NSMutableArray alloc] init];
     
-    for ( NSString *model in _results ) {
-        [results addObjectsFromArray:_results[model]];
+    // Share the results file, which holds one JSON record per line
+
+    if ( _resultsURL == nil ) {
+        return;
     }
     
-    NSDictionary *evaluation = @{
-        @"results": results
-    };
-    
-    EvaluationResultsActivityItemProvider *provider = [[EvaluationResultsActivityItemProvider alloc] initWithResults:evaluation];
-    UIActivityViewController *vc = [[UIActivityViewController alloc] initWithActivityItems:@[provider] applicationActivities:nil];
+    UIActivityViewController *vc = [[UIActivityViewController alloc] initWithActivityItems:@[_resultsURL] applicationActivities:nil];
     
     [self presentViewController:vc animated:YES completion:nil];
 }
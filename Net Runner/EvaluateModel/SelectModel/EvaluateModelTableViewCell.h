@@ -22,11 +22,11 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@class TIOModelBundle;
+@class ModelBundleHeader;
 
 @protocol EvaluateModelTableViewCellActionTarget <NSObject>
 
-- (void)didSwitchBundle:(TIOModelBundle*)bundle toSelected:(BOOL)selected;
+- (void)didSwitchHeader:(ModelBundleHeader*)header toSelected:(BOOL)selected;
 
 @end
 
@@ -38,7 +38,7 @@ NS_ASSUME_NONNULL_BEGIN
 @property (weak) IBOutlet UISwitch *selectedSwitch;
 
 @property (weak) id<EvaluateModelTableViewCellActionTarget>actionTarget;
-@property (nonatomic) TIOModelBundle *bundle;
+@property (nonatomic) ModelBundleHeader *header;
 
 - (IBAction)selectedSwitchAction:(UISwitch*)sender;
 
@@ -20,7 +20,7 @@
 
 #import "EvaluateModelTableViewCell.h"
 
-@import TensorIO;
+#import "ModelBundleHeader.h"
 
 @implementation EvaluateModelTableViewCell
 
@@ -34,19 +34,19 @@
 }
 
 - (IBAction)selectedSwitchAction:(UISwitch*)sender {
-    [self.actionTarget didSwitchBundle:self.bundle toSelected:sender.on];
+    [self.actionTarget didSwitchHeader:self.header toSelected:sender.on];
 }
 
-- (void)setBundle:(TIOModelBundle *)bundle {
-    if ( _bundle != bundle ) {
-        [self displayBundle:bundle];
+- (void)setHeader:(ModelBundleHeader *)header {
+    if ( _header != header ) {
+        [self displayHeader:header];
     }
     
-    _bundle = bundle;
+    _header = header;
 }
 
-- (void)displayBundle:(TIOModelBundle*)bundle {
-    self.titleLabel.text = bundle.name;
+- (void)displayHeader:(ModelBundleHeader*)header {
+    self.titleLabel.text = header.name;
 }
 
 @end
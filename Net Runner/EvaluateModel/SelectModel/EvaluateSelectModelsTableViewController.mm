@@ -23,6 +23,8 @@
 #import "EvaluateModelTableViewCell.h"
 #import "EvaluateSelectAlbumsTableViewController.h"
 #import "ModelDetailsTableViewController.h"
+#import "ModelManager.h"
+#import "ModelBundleHeader.h"
 
 @import TensorIO;
 
@@ -30,7 +32,7 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 
 @interface EvaluateSelectModelsTableViewController () <EvaluateModelTableViewCellActionTarget>
 
-@property (nonatomic) NSSet<TIOModelBundle*> *selectedBundles;
+@property (nonatomic) NSSet<ModelBundleHeader*> *selectedHeaders;
 @property (readonly) UIBarButtonItem *nextButton;
 
 @end
@@ -42,27 +44,48 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 - (void)viewDidLoad {
     [super viewDidLoad];
     
-    self.selectedBundles = [[NSSet<TIOModelBundle*> alloc] init];
+    self.selectedHeaders = [[NSSet<ModelBundleHeader*> alloc] init];
+}
+
+- (BOOL)shouldPerformSegueWithIdentifier:(NSString *)identifier sender:(id)sender {
+    if ( [identifier isEqualToString:@"SelectAlbumsSegue"] ) {
+        for ( ModelBundleHeader *header in self.selectedHeaders ) {
+            if ( header.bundle == nil ) {
+                [self showUnavailableModelAlert:header];
+                return NO;
+            }
+        }
+    }
+    
+    return YES;
 }
 
 - (void)prepareForSegue:(UIStoryboardSegue *)segue sender:(id)sender {
     if ( [segue.identifier isEqualToString:@"ModelDetailsSegue"] ) {
         ModelDetailsTableViewController *destination = (ModelDetailsTableViewController*)segue.destinationViewController;
-        destination.bundle = TIOModelBundleManager.sharedManager.modelBundles[self.tableView.indexPathForSelectedRow.row];
+        destination.bundle = ModelManager.sharedManager.modelHeaders[((NSIndexPath*)sender).row].bundle;
         destination.actions = ModelDetailsActionNone;
     }
     else if ( [segue.identifier isEqualToString:@"SelectAlbumsSegue"] ) {
         EvaluateSelectAlbumsTableViewController *destination = (EvaluateSelectAlbumsTableViewController*)segue.destinationViewController;
+        NSMutableArray<TIOModelBundle*> *bundles = [[NSMutableArray alloc] init];
+        
+        for ( ModelBundleHeader *header in self.selectedHeaders ) {
+            if ( TIOModelBundle *bundle = header.bundle ) {
+                [bundles addObject:bundle];
+            }
+        }
+        
         destination.data = @{
-            @"bundles": self.selectedBundles.allObjects
+            @"bundles": bundles.copy
         };
     }
 }
 
-- (void)setSelectedBundles:(NSSet<TIOModelBundle *> *)selectedBundles {
-    _selectedBundles = selectedBundles;
+- (void)setSelectedHeaders:(NSSet<ModelBundleHeader *> *)selectedHeaders {
+    _selectedHeaders = selectedHeaders;
     
-    self.nextButton.enabled = _selectedBundles.count > 0;
+    self.nextButton.enabled = _selectedHeaders.count > 0;
 }
 
 - (UIBarButtonItem*)nextButton {
@@ -76,7 +99,7 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-    return TIOModelBundleManager.sharedManager.modelBundles.count;
+    return ModelManager.sharedManager.modelHeaders.count;
 }
 
 - (NSString*)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
@@ -94,11 +117,11 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
     EvaluateModelTableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:kModelCellIdentifier forIndexPath:indexPath];
-    TIOModelBundle *bundle = TIOModelBundleManager.sharedManager.modelBundles[indexPath.row];
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
     
     cell.titleLabel.font = [UIFont systemFontOfSize:[UIFont systemFontSize]];
     cell.actionTarget = self;
-    cell.bundle = bundle;
+    cell.header = header;
     
     return cell;
 }
@@ -108,17 +131,42 @@ static NSString * const kModelCellIdentifier = @"ModelCell";
 }
 
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath {
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
+    
+    if ( header.bundle == nil ) {
+        [self showUnavailableModelAlert:header];
+        return;
+    }
+    
     [self performSegueWithIdentifier:@"ModelDetailsSegue" sender:indexPath];
 }
 
 // MARK: -
 
-- (void)didSwitchBundle:(TIOModelBundle*)bundle toSelected:(BOOL)selected {
-    if ( [self.selectedBundles containsObject:bundle] ) {
-        [[self mutableSetValueForKey:@"selectedBundles"] removeObject:bundle];
+- (void)didSwitchHeader:(ModelBundleHeader*)header toSelected:(BOOL)selected {
+    if ( [self.selectedHeaders containsObject:header] ) {
+        [[self mutableSetValueForKey:@"selectedHeaders"] removeObject:header];
     } else {
-        [[self mutableSetValueForKey:@"selectedBundles"] addObject:bundle];
+        [[self mutableSetValueForKey:@"selectedHeaders"] addObject:header];
     }
 }
 
+// MARK: - Alerts
+
+// A header is listed from the manifest, but its bundle may no longer be readable
+
+- (void)showUnavailableModelAlert:(ModelBundleHeader*)header {
+    UIAlertController *alert = [UIAlertController
+        alertControllerWithTitle:NSLocalizedString(@"Unable to load model", @"Failed to load model alert title")
+        message:[NSString stringWithFormat:NSLocalizedString(@"The model bundle for %@ could not be read. Ensure it exists and is valid.", @"Failed to read model bundle alert message"), header.name]
+        preferredStyle:UIAlertControllerStyleAlert];
+    
+    [alert addAction:[UIAlertAction
+        actionWithTitle:NSLocalizedString(@"Dismiss", @"Alert dismiss action")
+        style:UIAlertActionStyleDefault
+        handler:nil]];
+    
+    [self presentViewController:alert animated:YES completion:nil];
+}
+
 @end
@@ -23,6 +23,8 @@
 #import "EvaluatorConstants.h"
 #import "ImageEvaluator.h"
 #import "Utilities.h"
+#import "CVPixelBufferEvaluator.h"
+#import "PreprocessedInputCache.h"
 
 @import TensorIO;
 
@@ -73,9 +75,31 @@
     return self;
 }
 
+/**
+ * Identifies the photo's content by its local identifier and modification date, so that an
+ * edited photo is not served a stale cache entry.
+ */
+
+- (NSString*)sourceIdentifier {
+    return [NSString stringWithFormat:@"photos:%@:%.0f",
+        self.photo.localIdentifier,
+        self.photo.modificationDate.timeIntervalSince1970];
+}
+
 - (void)evaluateWithCompletionHandler:(nullable EvaluatorCompletionBlock)completionHandler {
     dispatch_once(&_once, ^{
     
+    // Skip the image request entirely when the preprocessed input is already cached
+    
+    PreprocessedInputCache *cache = PreprocessedInputCache.sharedCache;
+    TIOPixelBufferLayerDescription *description = [CVPixelBufferEvaluator pixelBufferDescriptionForModel:self.model];
+    NSString *sourceIdentifier = [self sourceIdentifier];
+    
+    if ( cache.isEnabled && description != nil && [cache containsSource:sourceIdentifier description:description] ) {
+        [self evaluateCachedWithSourceIdentifier:sourceIdentifier completionHandler:completionHandler];
+        return;
+    }
+    
     CGSize targetSize = PHImageManagerMaximumSize;
     PHImageContentMode contentMode = PHImageContentModeAspectFill;
     
@@ -113,7 +137,9 @@
                 return;
             }
             
-            ImageEvaluator *imageEvaluator = [[ImageEvaluator alloc] initWithModel:self.model image:result];
+            ImageEvaluator *imageEvaluator = cache.isEnabled
+                ? [[ImageEvaluator alloc] initWithModel:self.model sourceIdentifier:sourceIdentifier imageProvider:^UIImage * _Nullable{ return result; }]
+                : [[ImageEvaluator alloc] initWithModel:self.model image:result];
             
             [imageEvaluator evaluateWithCompletionHandler:^(NSDictionary *results, CVPixelBufferRef _Nullable inputPixelBuffer) {
                 NSDictionary *evaluatorResults = @{
@@ -132,4 +158,54 @@
     }); // dispatch_once
 }
 
+/**
+ * Evaluates from the cache. Should the entry be evicted before it is read, the image is
+ * requested synchronously instead.
+ */
+
+- (void)evaluateCachedWithSourceIdentifier:(NSString*)sourceIdentifier completionHandler:(nullable EvaluatorCompletionBlock)completionHandler {
+    @autoreleasepool {
+    
+        tio_defer_block {
+            self.model = nil;
+        };
+        
+        PHImageRequestOptions *options = [[AlbumPhotoEvaluator imageRequestOptions] copy];
+        options.synchronous = YES;
+        
+        CGSize targetSize = PHImageManagerMaximumSize;
+        PHImageContentMode contentMode = PHImageContentModeAspectFill;
+        
+        if ( @available(iOS 13.0, *) ) {
+            targetSize = CGSizeMake(self.photo.pixelWidth, self.photo.pixelHeight);
+            contentMode = PHImageContentModeDefault;
+        }
+        
+        ImageEvaluator *imageEvaluator = [[ImageEvaluator alloc] initWithModel:self.model sourceIdentifier:sourceIdentifier imageProvider:^UIImage * _Nullable{
+            __block UIImage *image;
+            [self.imageManager
+                requestImageForAsset:self.photo
+                targetSize:targetSize
+                contentMode:contentMode
+                options:options
+                resultHandler:^(UIImage * _Nullable result, NSDictionary * _Nullable info) {
+                image = result;
+            }];
+            return image;
+        }];
+        
+        [imageEvaluator evaluateWithCompletionHandler:^(NSDictionary *results, CVPixelBufferRef _Nullable inputPixelBuffer) {
+            NSDictionary *evaluatorResults = @{
+                kEvaluatorResultsKeySourceType          : kEvaluatorResultsKeySourceTypeAlbumPhoto,
+                kEvaluatorResultsKeyAlbum               : self.album.localIdentifier,
+                kEvaluatorResultsKeyImage               : self.photo.localIdentifier,
+                kEvaluatorResultsKeyModel               : self.model.identifier,
+                kEvaluatorResultsKeyError               : @(NO),
+                kEvaluatorResultsKeyEvaluation          : results
+            };
+            safe_block(completionHandler, evaluatorResults, inputPixelBuffer);
+        }];
+    }
+}
+
 @end
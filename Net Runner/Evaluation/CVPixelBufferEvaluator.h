@@ -20,14 +20,25 @@
 
 @import UIKit;
 @import AVFoundation;
+@import TensorIO;
 
 #import "Evaluator.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Lazily provides the pixel buffer on which inference is run, or `NULL` if it cannot be acquired.
+ * The evaluator does not take ownership of the returned buffer.
+ */
+
+typedef CVPixelBufferRef _Nullable (^CVPixelBufferEvaluatorPixelBufferProvider)(void);
+
 /**
  * Runs inference on a single `CVPixelBufferRef`, applying any required transformations to the input.
  * Appropriate for models with a single input layer that expects a pixel buffer.
+ *
+ * When the evaluator is given a source identifier it consults the `PreprocessedInputCache`
+ * before transforming its input, and only acquires the input from its provider on a miss.
  */
 
 @interface CVPixelBufferEvaluator : NSObject <Evaluator>
@@ -52,6 +63,13 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (readonly) CGImagePropertyOrientation orientation;
 
+/**
+ * Uniquely identifies the content of the source image for the `PreprocessedInputCache`, or `nil`
+ * if the input should not be cached.
+ */
+
+@property (nullable, readonly) NSString *sourceIdentifier;
+
 /**
  * Designated initializer.
  *
@@ -62,12 +80,30 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithModel:(id<TIOModel>)model pixelBuffer:(CVPixelBufferRef)pixelBuffer orientation:(CGImagePropertyOrientation)orientation NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Designated initializer for cached evaluation. The provider is only called if the preprocessed
+ * input is not already in the `PreprocessedInputCache` or the cache is disabled.
+ *
+ * @param model The `TIOModel` object on which inference is being run.
+ * @param sourceIdentifier Uniquely identifies the content of the source image.
+ * @param orientation The `CGImagePropertyOrientation` of the provided pixel buffer.
+ * @param provider Acquires the pixel buffer on which inference is being run.
+ */
+
+- (instancetype)initWithModel:(id<TIOModel>)model sourceIdentifier:(NSString*)sourceIdentifier orientation:(CGImagePropertyOrientation)orientation pixelBufferProvider:(CVPixelBufferEvaluatorPixelBufferProvider)provider NS_DESIGNATED_INITIALIZER;
+
 /**
  * Use the designated initializer.
  */
 
 - (instancetype)init NS_UNAVAILABLE;
 
+/**
+ * The description of the model's first input if it is a pixel buffer, otherwise `nil`.
+ */
+
++ (nullable TIOPixelBufferLayerDescription*)pixelBufferDescriptionForModel:(id<TIOModel>)model;
+
 /**
  * Runs inference on the input after transforming it to the format expected by the model.
  * Stores the results of inference in the `results` property and passes that value to the completion handler.
@@ -24,14 +24,23 @@
 #import "Utilities.h"
 #import "ModelOutput.h"
 #import "ModelOutputManager.h"
+#import "PreprocessedInputCache.h"
+
+#include "MemorySampler.h"
+#include "Tracer.h"
 
 @import TensorIO;
 
+using netrunner::MemorySampler;
+using netrunner::Tracer;
+
 @interface CVPixelBufferEvaluator ()
 
 @property (readwrite) id<TIOModel> model;
 @property (nonatomic, readwrite) CVPixelBufferRef pixelBuffer;
 @property (readwrite) CGImagePropertyOrientation orientation;
+@property (nullable, readwrite) NSString *sourceIdentifier;
+@property (nullable, copy) CVPixelBufferEvaluatorPixelBufferProvider pixelBufferProvider;
 
 @end
 
@@ -50,6 +59,18 @@
     return self;
 }
 
+- (instancetype)initWithModel:(id<TIOModel>)model sourceIdentifier:(NSString*)sourceIdentifier orientation:(CGImagePropertyOrientation)orientation pixelBufferProvider:(CVPixelBufferEvaluatorPixelBufferProvider)provider {
+    if (self = [super init]) {
+        _model = model;
+        _orientation = orientation;
+        _sourceIdentifier = sourceIdentifier;
+        _pixelBufferProvider = provider;
+        _pixelBuffer = NULL;
+    }
+    
+    return self;
+}
+
 - (void)dealloc {
     CVPixelBufferRelease(_pixelBuffer);
     _pixelBuffer = NULL;
@@ -61,22 +82,50 @@
     CVPixelBufferRetain(_pixelBuffer);
 }
 
++ (nullable TIOPixelBufferLayerDescription*)pixelBufferDescriptionForModel:(id<TIOModel>)model {
+    __block TIOPixelBufferLayerDescription *description = nil;
+    
+    [model.io.inputs[0] matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+        description = pixelBufferDescription;
+    } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+        ;
+    } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+        ;
+    }];
+    
+    return description;
+}
+
 - (void)evaluateWithCompletionHandler:(nullable EvaluatorCompletionBlock)completionHandler {
     dispatch_once(&_once, ^{
     
     tio_defer_block {
         self.model = nil;
         self.pixelBuffer = NULL;
+        self.pixelBufferProvider = nil;
     };
     
     double imageProcessingLatency;
     double inferenceLatency;
     
-    // Ensure the model is loaded
+    NSMutableDictionary<NSString*,NSNumber*> *memory = [[NSMutableDictionary alloc] init];
+    
+    // Ensure the model is loaded, noting the memory it takes if this evaluation loads it
     
     NSError *modelError;
+    BOOL loadsModel = !self.model.loaded;
+    
+    MemorySampler::Scope loadScope;
+    Tracer::Scope loadSpan("load model", "model");
+    BOOL loaded = [self.model load:&modelError];
+    loadSpan.finish();
+    loadScope.finish();
+    
+    if ( loadsModel && loaded ) {
+        memory[kEvaluatorResultsKeyMemoryModelLoad] = @((int64_t)loadScope.end() - (int64_t)loadScope.start());
+    }
     
-    if ( ![self.model load:&modelError] ) {
+    if ( !loaded ) {
         NSLog(@"Unable to load model, error: %@", modelError);
         NSDictionary *results = @{
             kEvaluatorResultsKeyPreprocessingError: @"Unable to load model"
@@ -85,17 +134,15 @@
         return;
     }
     
-    // Transform the image to the required format
+    // Post-processing is compiled with the model rather than with its first results
     
-    __block TIOPixelBufferLayerDescription *description = nil;
+    if ( loadsModel ) {
+        [[ModelOutputManager sharedManager] prepareForModel:self.model];
+    }
     
-    [self.model.io.inputs[0] matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
-        description = pixelBufferDescription;
-    } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
-        ;
-    } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
-        ;
-    }];
+    // Find the image input
+    
+    TIOPixelBufferLayerDescription *description = [CVPixelBufferEvaluator pixelBufferDescriptionForModel:self.model];
     
     if ( description == nil ) {
         NSLog(@"Model does not contain an image input at index 0");
@@ -106,20 +153,67 @@
         return;
     }
     
-    TIOVisionPipeline *pipeline = [[TIOVisionPipeline alloc] initWithTIOPixelBufferDescription:description];
+    // Consult the cache, only counting the lookup as preprocessing on a hit
+    
+    PreprocessedInputCache *cache = PreprocessedInputCache.sharedCache;
+    BOOL usesCache = self.sourceIdentifier != nil && cache.isEnabled;
+    
     __block CVPixelBufferRef transformedPixelBuffer = NULL;
     
-    measuring_latency(&imageProcessingLatency, ^{
-        transformedPixelBuffer = [pipeline transform:self.pixelBuffer orientation:self.orientation];
-    });
+    if ( usesCache ) {
+        measuring_latency(&imageProcessingLatency, ^{
+            Tracer::Scope span("cache lookup", "preprocessing");
+            CVPixelBufferRef cachedPixelBuffer = [cache copyPixelBufferForSource:self.sourceIdentifier description:description];
+            if ( cachedPixelBuffer != NULL ) {
+                transformedPixelBuffer = (CVPixelBufferRef)CFAutorelease(cachedPixelBuffer);
+            }
+        });
+    }
     
-    if (transformedPixelBuffer == NULL) {
-        NSLog(@"Unable to transform pixel buffer for model processing");
-        NSDictionary *results = @{
-            kEvaluatorResultsKeyPreprocessingError: @"TIOVisionPipeline returned NULL CVPixelBuffer"
-        };
-        safe_block(completionHandler, results, NULL);
-        return;
+    BOOL cacheHit = transformedPixelBuffer != NULL;
+    
+    if ( !cacheHit ) {
+    
+        if ( self.pixelBuffer == NULL && self.pixelBufferProvider != nil ) {
+            Tracer::Scope span("acquire pixel buffer", "preprocessing");
+            self.pixelBuffer = self.pixelBufferProvider();
+        }
+        
+        if ( self.pixelBuffer == NULL ) {
+            NSLog(@"Unable to acquire pixel buffer for model processing");
+            NSDictionary *results = @{
+                kEvaluatorResultsKeyPreprocessingError: @"Unable to acquire CVPixelBuffer for input"
+            };
+            safe_block(completionHandler, results, NULL);
+            return;
+        }
+    
+        // Transform the image to the required format: scale and crop, rotate and convert
+        
+        TIOVisionPipeline *pipeline = [[TIOVisionPipeline alloc] initWithTIOPixelBufferDescription:description];
+        MemorySampler::Scope preprocessingScope;
+        
+        measuring_latency(&imageProcessingLatency, ^{
+            Tracer::Scope span("vision pipeline", "preprocessing");
+            transformedPixelBuffer = [pipeline transform:self.pixelBuffer orientation:self.orientation];
+        });
+        
+        preprocessingScope.finish();
+        memory[kEvaluatorResultsKeyMemoryPreprocessingFootprint] = @(preprocessingScope.end());
+        
+        if (transformedPixelBuffer == NULL) {
+            NSLog(@"Unable to transform pixel buffer for model processing");
+            NSDictionary *results = @{
+                kEvaluatorResultsKeyPreprocessingError: @"TIOVisionPipeline returned NULL CVPixelBuffer"
+            };
+            safe_block(completionHandler, results, NULL);
+            return;
+        }
+        
+        if ( usesCache ) {
+            Tracer::Scope span("cache store", "preprocessing");
+            [cache setPixelBuffer:transformedPixelBuffer forSource:self.sourceIdentifier description:description];
+        }
     }
     
     // Make prediction
@@ -127,11 +221,25 @@
     __block NSDictionary *results;
     TIOPixelBuffer *pixelBufferWrapper = [[TIOPixelBuffer alloc] initWithPixelBuffer:transformedPixelBuffer orientation:kCGImagePropertyOrientationUp];
     
+    // Memory is only sampled before and after inference, never while it is being timed
+    
+    MemorySampler::Scope inferenceScope;
+    
     measuring_latency(&inferenceLatency, ^{
+        Tracer::Scope span("run model", "inference");
         results = (NSDictionary*)[self.model runOn:pixelBufferWrapper error:nil];
     });
     
-    id<ModelOutput> modelOutput = [[[[ModelOutputManager sharedManager] classForTypes:@[self.model.type, self.model.options.outputFormat]] alloc] initWithDictionary:results];
+    inferenceScope.finish();
+    memory[kEvaluatorResultsKeyMemoryInferenceFootprint] = @(inferenceScope.end());
+    
+    if ( loadsModel ) {
+        memory[kEvaluatorResultsKeyMemoryArena] = @(inferenceScope.growth());
+    }
+    
+    Tracer::Scope outputSpan("model output", "inference");
+    id<ModelOutput> modelOutput = [[ModelOutputManager sharedManager] outputForModel:self.model results:results];
+    outputSpan.finish();
     
     if (modelOutput == nil) {
         NSLog(@"Running the model produced null results");
@@ -144,8 +252,10 @@
     
     NSDictionary *evaluatorResults = @{
         kEvaluatorResultsKeyPreprocessingLatency: @(imageProcessingLatency),
+        kEvaluatorResultsKeyPreprocessingCacheHit: @(cacheHit),
         kEvaluatorResultsKeyInferenceLatency: @(inferenceLatency),
-        kEvaluatorResultsKeyInferenceResults: modelOutput
+        kEvaluatorResultsKeyInferenceResults: modelOutput,
+        kEvaluatorResultsKeyMemory: memory.copy
     };
     
     safe_block(completionHandler, evaluatorResults, transformedPixelBuffer);
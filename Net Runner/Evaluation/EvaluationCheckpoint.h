@@ -0,0 +1,148 @@
+//
+//  EvaluationCheckpoint.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+@protocol TIOModel;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Lets an interrupted evaluation resume from its results file, skipping the evaluations that
+ * already completed and folding their results back in. Wraps `netrunner::ResultsCheckpoint`,
+ * see ResultsCheckpoint.h.
+ *
+ * Each evaluation is a unit whose key combines the model's fingerprint, the content hash of the
+ * input, the iteration and a fingerprint of the options that affect results. Runners record the
+ * key of each result under `kEvaluatorResultsKeyUnit` and append results to a stable file rather
+ * than a new one for each run. To resume, a runner declares its units, calls
+ * `resumeWithModels:recordHandler:error:` to replay the completed ones, and then only evaluates
+ * the units that are not complete.
+ *
+ * Because a model's fingerprint includes the contents of its model file, changing one model
+ * re-evaluates only that model's units.
+ *
+ * Units must be declared and results replayed before the run begins. `isUnitComplete:` is then
+ * safe to call from any thread.
+ */
+
+@interface EvaluationCheckpoint : NSObject
+
+/**
+ * The results file the checkpoint reads.
+ */
+
+@property (readonly) NSURL *URL;
+
+/**
+ * The number of units declared and the number of those found in the results file.
+ */
+
+@property (readonly) NSUInteger expectedCount;
+@property (readonly) NSUInteger completedCount;
+
+/**
+ * Identifies a model by its identifier, its bundle's version and the contents of its model file.
+ */
+
++ (uint64_t)fingerprintForModel:(id<TIOModel>)model;
+
+/**
+ * Identifies a set of options by the hash of their canonical JSON representation, with sorted
+ * keys. Returns the hash of an empty dictionary if the options are `nil`.
+ */
+
++ (uint64_t)fingerprintForOptions:(nullable NSDictionary<NSString*,id>*)options;
+
+/**
+ * The content hash of the file at URL. Returns `NO` and sets error if the file cannot be read.
+ */
+
++ (BOOL)contentHashForFileAtURL:(NSURL*)URL hash:(uint64_t*)hash error:(NSError**)error;
+
+/**
+ * The content hash of a string, for inputs whose contents are identified by name, such as a
+ * remote URL or a photo asset and its modification date.
+ */
+
++ (uint64_t)contentHashForString:(NSString*)string;
+
+/**
+ * The key of a single evaluation.
+ */
+
++ (NSString*)unitForModel:(uint64_t)model input:(uint64_t)input iteration:(NSUInteger)iteration options:(uint64_t)options;
+
+/**
+ * Reads every record of a model from a results file, in the order they were written, and calls
+ * the handler on the calling thread with each. Inference results are restored as they are by
+ * `resumeWithModels:recordHandler:error:`. For showing the results of a run that streamed them
+ * to the file rather than keeping them in memory. The file should no longer be appended to.
+ *
+ * @return BOOL `YES` if the file was read or does not exist, `NO` otherwise.
+ */
+
++ (BOOL)readResultsAtURL:(NSURL*)URL model:(id<TIOModel>)model recordHandler:(void(^)(NSDictionary<NSString*,id> *record))handler error:(NSError**)error;
+
+/**
+ * Designated initializer. The file need not exist.
+ *
+ * @param URL The results file of the run being resumed.
+ */
+
+- (instancetype)initWithURL:(NSURL*)URL NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Declares a unit of the current run.
+ */
+
+- (void)expectUnit:(NSString*)unit;
+
+/**
+ * `YES` if the unit's result was replayed from the results file.
+ */
+
+- (BOOL)isUnitComplete:(NSString*)unit;
+
+/**
+ * Reads the results file, truncating a record torn by the interruption, and calls the handler
+ * on the calling thread with the first record of each declared unit. Inference results are
+ * restored as `ModelOutput` objects of the kind the model produces, so replayed records may be
+ * used wherever fresh results are. Records of undeclared units are skipped, as are records
+ * with an error, so that failed evaluations are tried again.
+ *
+ * @param models The models of the current run, used to restore their outputs.
+ * @param handler Called with each replayed record.
+ * @param error Set if the results file cannot be read.
+ *
+ * @return BOOL `YES` if the file was read or does not exist, `NO` otherwise.
+ */
+
+- (BOOL)resumeWithModels:(NSArray<id<TIOModel>>*)models recordHandler:(void(^)(NSDictionary<NSString*,id> *record))handler error:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,206 @@
+//
+//  EvaluationCheckpoint.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationCheckpoint.h"
+
+#import "EvaluatorConstants.h"
+#import "ModelOutput.h"
+#import "ModelOutputManager.h"
+
+#include <string>
+
+#include "ContentHash.h"
+#include "ResultsCheckpoint.h"
+
+@import TensorIO;
+
+using netrunner::ContentHash;
+using netrunner::ResultsCheckpoint;
+
+// MARK: - Errors
+
+static NSString * const NetRunnerEvaluationCheckpointErrorDomain = @"ai.doc.net-runner.evaluation-checkpoint";
+
+static const NSInteger NetRunnerEvaluationCheckpointReadErrorCode = 101;
+
+NSError * NetRunnerEvaluationCheckpointReadError(NSURL *URL, NSString *description);
+
+// MARK: -
+
+@implementation EvaluationCheckpoint {
+    ResultsCheckpoint _checkpoint;
+}
+
++ (uint64_t)fingerprintForModel:(id<TIOModel>)model {
+    TIOModelBundle *bundle = model.bundle;
+    std::string modelPath = bundle.modelFilepath != nil ? bundle.modelFilepath.UTF8String : "";
+    
+    return ResultsCheckpoint::ModelFingerprint(model.identifier.UTF8String, bundle.version != nil ? bundle.version.UTF8String : "", modelPath);
+}
+
++ (uint64_t)fingerprintForOptions:(nullable NSDictionary<NSString*,id>*)options {
+    NSData *JSON = [NSJSONSerialization dataWithJSONObject:options ?: @{} options:NSJSONWritingSortedKeys error:nil];
+    return ContentHash().update(JSON.bytes, JSON.length).value();
+}
+
++ (BOOL)contentHashForFileAtURL:(NSURL*)URL hash:(uint64_t*)hash error:(NSError**)error {
+    std::string hashError;
+    
+    if ( !ContentHash::File(URL.fileSystemRepresentation, hash, &hashError) ) {
+        if (error) {
+            *error = NetRunnerEvaluationCheckpointReadError(URL, [NSString stringWithUTF8String:hashError.c_str()]);
+        }
+        return NO;
+    }
+    
+    return YES;
+}
+
++ (uint64_t)contentHashForString:(NSString*)string {
+    return ContentHash().update(std::string(string.UTF8String)).value();
+}
+
++ (NSString*)unitForModel:(uint64_t)model input:(uint64_t)input iteration:(NSUInteger)iteration options:(uint64_t)options {
+    return [NSString stringWithUTF8String:ResultsCheckpoint::UnitKey(model, input, iteration, options).c_str()];
+}
+
++ (BOOL)readResultsAtURL:(NSURL*)URL model:(id<TIOModel>)model recordHandler:(void(^)(NSDictionary<NSString*,id> *record))handler error:(NSError**)error {
+    Class outputClass = [[ModelOutputManager sharedManager] classForModel:model];
+    NSString *modelID = model.identifier;
+    std::string readError;
+    
+    bool success = ResultsCheckpoint::ReadResults(URL.fileSystemRepresentation, [&](const std::string &line) {
+        @autoreleasepool {
+            NSData *data = [NSData dataWithBytesNoCopy:(void*)line.data() length:line.size() freeWhenDone:NO];
+            NSDictionary *record = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+            
+            if ( ![record isKindOfClass:NSDictionary.class] || ![record[kEvaluatorResultsKeyModel] isEqual:modelID] ) {
+                return;
+            }
+            
+            handler([self restoreRecord:record outputClass:outputClass]);
+        }
+    }, nullptr, &readError);
+    
+    if ( !success ) {
+        if (error) {
+            *error = NetRunnerEvaluationCheckpointReadError(URL, [NSString stringWithUTF8String:readError.c_str()]);
+        }
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (instancetype)initWithURL:(NSURL*)URL {
+    if ((self=[super init])) {
+        _URL = URL;
+    }
+    return self;
+}
+
+- (NSUInteger)expectedCount {
+    return _checkpoint.expectedCount();
+}
+
+- (NSUInteger)completedCount {
+    return _checkpoint.completedCount();
+}
+
+- (void)expectUnit:(NSString*)unit {
+    _checkpoint.expect(unit.UTF8String);
+}
+
+- (BOOL)isUnitComplete:(NSString*)unit {
+    return _checkpoint.isComplete(unit.UTF8String);
+}
+
+- (BOOL)resumeWithModels:(NSArray<id<TIOModel>>*)models recordHandler:(void(^)(NSDictionary<NSString*,id> *record))handler error:(NSError**)error {
+    NSMutableDictionary<NSString*,Class> *outputClasses = [[NSMutableDictionary alloc] init];
+    
+    for ( id<TIOModel> model in models ) {
+        outputClasses[model.identifier] = [[ModelOutputManager sharedManager] classForModel:model];
+    }
+    
+    size_t discarded = 0;
+    std::string readError;
+    
+    bool success = ResultsCheckpoint::ReadResults(self.URL.fileSystemRepresentation, [&](const std::string &line) {
+        @autoreleasepool {
+            NSData *data = [NSData dataWithBytesNoCopy:(void*)line.data() length:line.size() freeWhenDone:NO];
+            NSDictionary *record = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+            
+            if ( ![record isKindOfClass:NSDictionary.class] || ![record[kEvaluatorResultsKeyUnit] isKindOfClass:NSString.class] ) {
+                return;
+            }
+            if ( [record[kEvaluatorResultsKeyError] boolValue] ) {
+                return;
+            }
+            if ( !self->_checkpoint.complete([record[kEvaluatorResultsKeyUnit] UTF8String]) ) {
+                return;
+            }
+            
+            handler([self.class restoreRecord:record outputClass:outputClasses[record[kEvaluatorResultsKeyModel]]]);
+        }
+    }, &discarded, &readError);
+    
+    if ( !success ) {
+        NSLog(@"Unable to resume from results file at %@, error: %s", self.URL, readError.c_str());
+        if (error) {
+            *error = NetRunnerEvaluationCheckpointReadError(self.URL, [NSString stringWithUTF8String:readError.c_str()]);
+        }
+        return NO;
+    }
+    
+    if ( discarded > 0 ) {
+        NSLog(@"Discarded %zu bytes of a partial record from results file at %@", discarded, self.URL);
+    }
+    
+    return YES;
+}
+
+// Records hold the output's property list, which is the dictionary its class is initialized with
+
++ (NSDictionary<NSString*,id>*)restoreRecord:(NSDictionary<NSString*,id>*)record outputClass:(nullable Class)outputClass {
+    NSDictionary *evaluation = record[kEvaluatorResultsKeyEvaluation];
+    
+    if ( outputClass == nil || ![evaluation isKindOfClass:NSDictionary.class] || ![evaluation[kEvaluatorResultsKeyInferenceResults] isKindOfClass:NSDictionary.class] ) {
+        return record;
+    }
+    
+    NSMutableDictionary *restoredEvaluation = [evaluation mutableCopy];
+    restoredEvaluation[kEvaluatorResultsKeyInferenceResults] = [[outputClass alloc] initWithDictionary:evaluation[kEvaluatorResultsKeyInferenceResults]];
+    
+    NSMutableDictionary *restoredRecord = [record mutableCopy];
+    restoredRecord[kEvaluatorResultsKeyEvaluation] = restoredEvaluation.copy;
+    
+    return restoredRecord.copy;
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerEvaluationCheckpointReadError(NSURL *URL, NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerEvaluationCheckpointErrorDomain code:NetRunnerEvaluationCheckpointReadErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"There was a problem reading %@: %@", URL.path, description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure the file exists and is readable, or start the evaluation over."
+    }];
+}
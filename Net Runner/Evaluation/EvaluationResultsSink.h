@@ -0,0 +1,115 @@
+//
+//  EvaluationResultsSink.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Appends evaluation results to a JSON Lines file as they complete, one compact record per line.
+ *
+ * Records are buffered in memory and written once `bufferSize` bytes have accumulated, and the
+ * file is synced to storage every `syncInterval` records or after `syncDelay` seconds, whichever
+ * comes first. At most one batch of results is lost if the process is interrupted, and a
+ * truncated final line may be skipped by readers.
+ *
+ * The sink is safe to use from multiple threads.
+ */
+
+@interface EvaluationResultsSink : NSObject
+
+/**
+ * The file results are appended to.
+ */
+
+@property (readonly) NSURL *URL;
+
+/**
+ * The number of buffered bytes that triggers a write. Defaults to 64KB.
+ */
+
+@property NSUInteger bufferSize;
+
+/**
+ * The number of records between syncs to storage. Defaults to 256.
+ */
+
+@property NSUInteger syncInterval;
+
+/**
+ * The longest time between syncs to storage while records are being appended, in seconds.
+ * Defaults to 1 second.
+ */
+
+@property NSTimeInterval syncDelay;
+
+/**
+ * The number of records appended.
+ */
+
+@property (readonly) NSUInteger count;
+
+/**
+ * Converts an evaluator result into a JSON serializable record, replacing `ModelOutput` objects
+ * with their property list representations.
+ */
+
++ (id)recordForResult:(NSDictionary<NSString*,id>*)result;
+
+/**
+ * Designated initializer. Opens the file for appending, creating it and any intermediate
+ * directories if needed.
+ *
+ * @param URL A file URL.
+ * @param error Set if the file cannot be opened.
+ *
+ * @return instancetype A sink or `nil` if the file could not be opened.
+ */
+
+- (nullable instancetype)initWithURL:(NSURL*)URL error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Appends a result. Returns `NO` and sets error if the record could not be serialized or
+ * written, or if the sink is closed.
+ */
+
+- (BOOL)appendResult:(NSDictionary<NSString*,id>*)result error:(NSError**)error;
+
+/**
+ * Writes any buffered records and syncs the file to storage.
+ */
+
+- (BOOL)flush:(NSError**)error;
+
+/**
+ * Flushes and closes the file. Called automatically when the sink is deallocated.
+ */
+
+- (BOOL)close:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
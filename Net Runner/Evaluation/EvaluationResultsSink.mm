@@ -0,0 +1,244 @@
+//
+//  EvaluationResultsSink.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationResultsSink.h"
+
+#import "ModelOutput.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// MARK: - Errors
+
+static NSString * const NetRunnerEvaluationResultsSinkErrorDomain = @"ai.doc.net-runner.evaluation-results-sink";
+
+static const NSInteger NetRunnerEvaluationResultsSinkOpenErrorCode = 101;
+static const NSInteger NetRunnerEvaluationResultsSinkWriteErrorCode = 102;
+static const NSInteger NetRunnerEvaluationResultsSinkClosedErrorCode = 103;
+
+NSError * NetRunnerEvaluationResultsSinkOpenError(NSURL *URL, int code);
+NSError * NetRunnerEvaluationResultsSinkWriteError(NSURL *URL, int code);
+NSError * NetRunnerEvaluationResultsSinkClosedError(NSURL *URL);
+
+// MARK: -
+
+@interface EvaluationResultsSink ()
+
+@property (readwrite) NSUInteger count;
+
+@end
+
+@implementation EvaluationResultsSink {
+    int _fd;
+    NSMutableData *_buffer;
+    NSUInteger _unsyncedCount;
+    CFAbsoluteTime _lastSync;
+}
+
++ (id)recordForResult:(NSDictionary<NSString*,id>*)result {
+    return [self JSONObjectForObject:result];
+}
+
++ (id)JSONObjectForObject:(id)object {
+    if ( [object conformsToProtocol:@protocol(ModelOutput)] ) {
+        return ((id<ModelOutput>)object).propertyList;
+    }
+    
+    if ( [object isKindOfClass:NSDictionary.class] ) {
+        NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] initWithCapacity:((NSDictionary*)object).count];
+        [(NSDictionary*)object enumerateKeysAndObjectsUsingBlock:^(id  _Nonnull key, id  _Nonnull obj, BOOL * _Nonnull stop) {
+            dictionary[[key description]] = [self JSONObjectForObject:obj];
+        }];
+        return dictionary;
+    }
+    
+    if ( [object isKindOfClass:NSArray.class] ) {
+        NSMutableArray *array = [[NSMutableArray alloc] initWithCapacity:((NSArray*)object).count];
+        for ( id obj in (NSArray*)object ) {
+            [array addObject:[self JSONObjectForObject:obj]];
+        }
+        return array;
+    }
+    
+    if ( [object isKindOfClass:NSString.class] || [object isKindOfClass:NSNumber.class] || [object isKindOfClass:NSNull.class] ) {
+        return object;
+    }
+    
+    return [object description];
+}
+
+- (nullable instancetype)initWithURL:(NSURL*)URL error:(NSError**)error {
+    if ((self=[super init])) {
+        _fd = -1;
+        
+        NSURL *directory = URL.URLByDeletingLastPathComponent;
+        
+        if ( ![NSFileManager.defaultManager createDirectoryAtURL:directory withIntermediateDirectories:YES attributes:nil error:error] ) {
+            NSLog(@"Unable to create directory for results at %@", directory);
+            return nil;
+        }
+        
+        _fd = open(URL.fileSystemRepresentation, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        
+        if ( _fd < 0 ) {
+            NSLog(@"Unable to open results file at %@, errno: %d", URL, errno);
+            if (error) {
+                *error = NetRunnerEvaluationResultsSinkOpenError(URL, errno);
+            }
+            return nil;
+        }
+        
+        _URL = URL;
+        _bufferSize = 64 * 1024;
+        _syncInterval = 256;
+        _syncDelay = 1.0;
+        _buffer = [[NSMutableData alloc] initWithCapacity:_bufferSize];
+        _lastSync = CFAbsoluteTimeGetCurrent();
+    }
+    return self;
+}
+
+- (void)dealloc {
+    [self close:nil];
+}
+
+- (BOOL)appendResult:(NSDictionary<NSString*,id>*)result error:(NSError**)error {
+    NSData *line = [NSJSONSerialization dataWithJSONObject:[EvaluationResultsSink recordForResult:result] options:0 error:error];
+    
+    if ( line == nil ) {
+        NSLog(@"Unable to serialize evaluation result");
+        return NO;
+    }
+    
+    @synchronized (self) {
+        if ( _fd < 0 ) {
+            if (error) {
+                *error = NetRunnerEvaluationResultsSinkClosedError(self.URL);
+            }
+            return NO;
+        }
+        
+        [_buffer appendData:line];
+        [_buffer appendBytes:"\n" length:1];
+        
+        self.count += 1;
+        _unsyncedCount += 1;
+        
+        BOOL shouldSync = _unsyncedCount >= self.syncInterval
+            || CFAbsoluteTimeGetCurrent() - _lastSync >= self.syncDelay;
+        
+        if ( shouldSync ) {
+            return [self writeBufferSyncing:YES error:error];
+        } else if ( _buffer.length >= self.bufferSize ) {
+            return [self writeBufferSyncing:NO error:error];
+        }
+        
+        return YES;
+    }
+}
+
+- (BOOL)flush:(NSError**)error {
+    @synchronized (self) {
+        if ( _fd < 0 ) {
+            return YES;
+        }
+        return [self writeBufferSyncing:YES error:error];
+    }
+}
+
+- (BOOL)close:(NSError**)error {
+    @synchronized (self) {
+        if ( _fd < 0 ) {
+            return YES;
+        }
+        
+        BOOL success = [self writeBufferSyncing:YES error:error];
+        
+        ::close(_fd);
+        _fd = -1;
+        
+        return success;
+    }
+}
+
+// Requires the lock
+
+- (BOOL)writeBufferSyncing:(BOOL)sync error:(NSError**)error {
+    const uint8_t *bytes = (const uint8_t*)_buffer.bytes;
+    size_t remaining = _buffer.length;
+    
+    while ( remaining > 0 ) {
+        ssize_t written = write(_fd, bytes, remaining);
+        
+        if ( written < 0 ) {
+            if ( errno == EINTR ) {
+                continue;
+            }
+            NSLog(@"Unable to write results to %@, errno: %d", self.URL, errno);
+            if (error) {
+                *error = NetRunnerEvaluationResultsSinkWriteError(self.URL, errno);
+            }
+            return NO;
+        }
+        
+        bytes += written;
+        remaining -= (size_t)written;
+    }
+    
+    _buffer.length = 0;
+    
+    if ( sync ) {
+        if ( fsync(_fd) != 0 ) {
+            NSLog(@"Unable to sync results to %@, errno: %d", self.URL, errno);
+            if (error) {
+                *error = NetRunnerEvaluationResultsSinkWriteError(self.URL, errno);
+            }
+            return NO;
+        }
+        _unsyncedCount = 0;
+        _lastSync = CFAbsoluteTimeGetCurrent();
+    }
+    
+    return YES;
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerEvaluationResultsSinkOpenError(NSURL *URL, int code) {
+    return [[NSError alloc] initWithDomain:NetRunnerEvaluationResultsSinkErrorDomain code:NetRunnerEvaluationResultsSinkOpenErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Unable to open results file at %@", URL.path],
+        NSUnderlyingErrorKey: [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil]
+    }];
+}
+
+NSError * NetRunnerEvaluationResultsSinkWriteError(NSURL *URL, int code) {
+    return [[NSError alloc] initWithDomain:NetRunnerEvaluationResultsSinkErrorDomain code:NetRunnerEvaluationResultsSinkWriteErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Unable to write to results file at %@", URL.path],
+        NSUnderlyingErrorKey: [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:nil]
+    }];
+}
+
+NSError * NetRunnerEvaluationResultsSinkClosedError(NSURL *URL) {
+    return [[NSError alloc] initWithDomain:NetRunnerEvaluationResultsSinkErrorDomain code:NetRunnerEvaluationResultsSinkClosedErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"The results file at %@ has been closed", URL.path]
+    }];
+}
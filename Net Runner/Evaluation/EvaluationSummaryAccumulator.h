@@ -0,0 +1,148 @@
+//
+//  EvaluationSummaryAccumulator.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+@protocol EvaluationMetric;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Computes per model summary statistics incrementally as evaluation results arrive, so that the
+ * results themselves need not be retained.
+ *
+ * Only latency histograms, running totals and the metric's running state, see
+ * `EvaluationMetricAccumulator`, are kept. Results with an error are counted but excluded from
+ * latency and metric statistics.
+ */
+
+@interface EvaluationSummaryAccumulator : NSObject
+
+/**
+ * The metric applied to each result, if any.
+ */
+
+@property (nullable, readonly) id<EvaluationMetric> metric;
+
+/**
+ * The expected outputs keyed by image identifier, against which the metric is evaluated.
+ */
+
+@property (nullable, readonly) NSDictionary<NSString*,id> *labels;
+
+/**
+ * The number of initial successful results for each model excluded from the latency statistics.
+ */
+
+@property (readonly) NSUInteger warmup;
+
+/**
+ * The names of the classification metrics computed for each model, see ClassificationMetrics.h.
+ */
+
+@property (readonly) NSArray<NSString*> *classificationMetrics;
+
+/**
+ * Designated initializer.
+ *
+ * @param metric The metric applied to each result, may be `nil`.
+ * @param labels The expected outputs keyed by image identifier, may be `nil` if there are no metrics.
+ * @param warmup The number of initial results for each model excluded from the latency statistics.
+ * @param classificationMetrics The names of the classification metrics to compute, may be empty.
+ */
+
+- (instancetype)initWithMetric:(nullable id<EvaluationMetric>)metric labels:(nullable NSDictionary<NSString*,id>*)labels warmup:(NSUInteger)warmup classificationMetrics:(NSArray<NSString*>*)classificationMetrics NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Initializes an accumulator without classification metrics.
+ */
+
+- (instancetype)initWithMetric:(nullable id<EvaluationMetric>)metric labels:(nullable NSDictionary<NSString*,id>*)labels warmup:(NSUInteger)warmup;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Sets the class vocabulary of a model's classification output, which fixes the index of each
+ * class for the classification metrics. Classification metrics are only computed for models
+ * whose classes are set before their first result arrives.
+ */
+
+- (void)setClasses:(NSArray<NSString*>*)classes forModel:(NSString*)modelID;
+
+/**
+ * Folds a single evaluator result into the statistics. Safe to call from any thread.
+ */
+
+- (void)addResult:(NSDictionary<NSString*,id>*)result;
+
+/**
+ * The number of results with and without an error.
+ */
+
+@property (readonly) NSUInteger errorCount;
+@property (readonly) NSUInteger successCount;
+
+/**
+ * The summary statistics so far, one dictionary per model with the model's id under
+ * `kEvaluatorResultsKeyModel`, the average inference latency under "latency", the largest
+ * number of concurrently evaluated models under `kEvaluatorResultsKeyConcurrentModels`, and
+ * the reduced metric values.
+ *
+ * The preprocessing, inference and total latency distributions are reported under
+ * `kEvaluatorResultsKeyPreprocessingLatency`, `kEvaluatorResultsKeyInferenceLatency` and
+ * "total_latency", each with count, mean, stddev, min, p50, p90, p99 and max entries in
+ * milliseconds, and the latency histogram's state under "histogram".
+ *
+ * Classification metrics add their values, such as "accuracy_top1", dictionaries of per-class
+ * values keyed by class name, such as "precision", and the non-zero cells of the confusion
+ * matrix as [label, predicted, count] arrays under "confusion_matrix".
+ *
+ * The correct and total counts behind each accuracy, whether a classification metric or a
+ * metric value that is 0 or 1 for every result, are reported under "accuracy_counts". With the
+ * histograms they let a later run be tested for regressions against this one, see
+ * RegressionGate.h.
+ *
+ * Memory is reported under `kEvaluatorResultsKeyMemory` with the model load and arena sizes
+ * from the evaluation that loaded the model and the largest process footprints after
+ * preprocessing and inference, in bytes.
+ */
+
+- (NSArray<NSDictionary<NSString*,id>*> *)summary;
+
+/**
+ * The partial summary so far, one dictionary per model, from which the command line runner
+ * computes the summary of a test bundle whose shards were run on separate devices or in
+ * separate processes, see EvaluationShard.h.
+ *
+ * Rather than statistics, a partial summary keeps what is needed to merge them: latency
+ * histogram states, the metric accumulator's state, the classification metrics' counters, the
+ * counts of evaluations and errors and the memory measurements. The metric is identified by its
+ * class name. The schema is the one written by the command line runner's ModelSummary.
+ */
+
+- (NSArray<NSDictionary<NSString*,id>*> *)partialSummary;
+
+@end
+
+NS_ASSUME_NONNULL_END
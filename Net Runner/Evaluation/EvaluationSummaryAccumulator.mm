@@ -0,0 +1,431 @@
+//
+//  EvaluationSummaryAccumulator.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationSummaryAccumulator.h"
+
+#import "EvaluationMetric.h"
+#import "EvaluatorConstants.h"
+#import "LatencyCounter.h"
+#import "ModelOutput.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ClassificationMetrics.h"
+
+using namespace netrunner::metrics;
+
+static NSString * const kClassificationOutputKey = @"classification";
+static NSString * const kSummaryKeyAccuracyCounts = @"accuracy_counts";
+
+@interface EvaluationSummaryModelTotals : NSObject
+
+@property LatencyCounter *latencyCounter;
+@property NSUInteger maxConcurrentModels;
+@property NSUInteger evaluations;
+@property (nullable) id<EvaluationMetricAccumulator> metricAccumulator;
+@property NSMutableDictionary<NSString*,NSNumber*> *memory;
+@property NSArray<NSString*> *classes;
+@property NSDictionary<NSString*,NSNumber*> *classIndexes;
+
+@end
+
+@implementation EvaluationSummaryModelTotals {
+    @public
+    std::unique_ptr<ClassificationMetricSet> _classificationMetrics;
+    std::vector<float> _scores;
+}
+@end
+
+// MARK: -
+
+@interface EvaluationSummaryAccumulator ()
+
+@property (readwrite) NSUInteger errorCount;
+@property (readwrite) NSUInteger successCount;
+
+@end
+
+@implementation EvaluationSummaryAccumulator {
+    NSMutableDictionary<NSString*,EvaluationSummaryModelTotals*> *_totals;
+    NSMutableDictionary<NSString*,NSArray<NSString*>*> *_classes;
+    NSMutableArray<NSString*> *_modelOrder;
+    NSMutableDictionary<NSString*,NSNumber*> *_errorCounts;
+}
+
+- (instancetype)initWithMetric:(nullable id<EvaluationMetric>)metric labels:(nullable NSDictionary<NSString*,id>*)labels warmup:(NSUInteger)warmup classificationMetrics:(NSArray<NSString*>*)classificationMetrics {
+    if ((self=[super init])) {
+        _metric = metric;
+        _labels = labels;
+        _warmup = warmup;
+        _classificationMetrics = classificationMetrics.copy;
+        _totals = [[NSMutableDictionary alloc] init];
+        _classes = [[NSMutableDictionary alloc] init];
+        _modelOrder = [[NSMutableArray alloc] init];
+        _errorCounts = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (instancetype)initWithMetric:(nullable id<EvaluationMetric>)metric labels:(nullable NSDictionary<NSString*,id>*)labels warmup:(NSUInteger)warmup {
+    return [self initWithMetric:metric labels:labels warmup:warmup classificationMetrics:@[]];
+}
+
+- (void)setClasses:(NSArray<NSString*>*)classes forModel:(NSString*)modelID {
+    @synchronized (self) {
+        _classes[modelID] = classes.copy;
+    }
+}
+
+- (void)addResult:(NSDictionary<NSString*,id>*)result {
+    if ( [result[kEvaluatorResultsKeyError] boolValue] ) {
+        @synchronized (self) {
+            self.errorCount += 1;
+            
+            if ( NSString *modelID = result[kEvaluatorResultsKeyModel] ) {
+                _errorCounts[modelID] = @(_errorCounts[modelID].unsignedIntegerValue + 1);
+            }
+        }
+        return;
+    }
+    
+    NSString *modelID = result[kEvaluatorResultsKeyModel];
+    NSDictionary *evaluation = result[kEvaluatorResultsKeyEvaluation];
+    double preprocessingLatency = [evaluation[kEvaluatorResultsKeyPreprocessingLatency] doubleValue];
+    double inferenceLatency = [evaluation[kEvaluatorResultsKeyInferenceLatency] doubleValue];
+    NSUInteger concurrentModels = [result[kEvaluatorResultsKeyConcurrentModels] unsignedIntegerValue];
+    NSDictionary<NSString*,NSNumber*> *memory = evaluation[kEvaluatorResultsKeyMemory];
+    
+    // Evaluate the metric outside the lock, it is the expensive part
+    
+    NSDictionary<NSString*,NSNumber*> *metricResult = nil;
+    id y = nil, yhat = nil;
+    
+    if ( self.metric != nil || self.classificationMetrics.count > 0 ) {
+        NSString *identifier = result[kEvaluatorResultsKeyImage];
+        yhat = ((id<ModelOutput>)evaluation[kEvaluatorResultsKeyInferenceResults]).value;
+        y = self.labels[identifier];
+    }
+    
+    if ( self.metric != nil ) {
+        metricResult = [self.metric evaluate:y yhat:yhat];
+    }
+    
+    EvaluationSummaryModelTotals *totals;
+    
+    @synchronized (self) {
+        totals = _totals[modelID];
+        
+        if ( totals == nil ) {
+            totals = [[EvaluationSummaryModelTotals alloc] init];
+            totals.latencyCounter = [[LatencyCounter alloc] initWithWarmup:self.warmup];
+            totals.metricAccumulator = [self.metric accumulator];
+            totals.memory = [[NSMutableDictionary alloc] init];
+            totals.maxConcurrentModels = 1;
+            [self prepareClassificationMetrics:totals classes:_classes[modelID] model:modelID];
+            _totals[modelID] = totals;
+            [_modelOrder addObject:modelID];
+        }
+        
+        totals.maxConcurrentModels = MAX(totals.maxConcurrentModels, concurrentModels);
+        totals.evaluations += 1;
+        
+        if ( metricResult != nil ) {
+            [totals.metricAccumulator add:metricResult];
+        }
+        
+        [self foldMemory:memory into:totals.memory];
+        
+        if ( totals->_classificationMetrics != nullptr ) {
+            [self addClassificationWithY:y yhat:yhat to:totals];
+        }
+        
+        self.successCount += 1;
+    }
+    
+    // Recording latencies is lock-free
+    
+    [totals.latencyCounter recordImageProcessingLatency:preprocessingLatency inferenceLatency:inferenceLatency];
+}
+
+// MARK: - Classification Metrics
+
+// Requires the lock
+
+- (void)prepareClassificationMetrics:(EvaluationSummaryModelTotals*)totals classes:(nullable NSArray<NSString*>*)classes model:(NSString*)modelID {
+    if ( self.classificationMetrics.count == 0 ) {
+        return;
+    }
+    
+    if ( classes.count == 0 ) {
+        NSLog(@"Model %@ has no classes, skipping classification metrics", modelID);
+        return;
+    }
+    
+    std::vector<std::string> names;
+    std::vector<std::string> unknown;
+    
+    for ( NSString *name in self.classificationMetrics ) {
+        names.push_back(name.UTF8String);
+    }
+    
+    totals->_classificationMetrics.reset(new ClassificationMetricSet(classes.count, names, &unknown));
+    totals->_scores.resize(classes.count);
+    
+    for ( const std::string &name : unknown ) {
+        NSLog(@"Unknown classification metric %s", name.c_str());
+    }
+    
+    NSMutableDictionary<NSString*,NSNumber*> *indexes = [[NSMutableDictionary alloc] initWithCapacity:classes.count];
+    
+    [classes enumerateObjectsUsingBlock:^(NSString * _Nonnull name, NSUInteger index, BOOL * _Nonnull stop) {
+        indexes[name] = @(index);
+    }];
+    
+    totals.classes = classes;
+    totals.classIndexes = indexes.copy;
+}
+
+// Requires the lock. Scatters the classification output into a dense row of scores. Classes the
+// model output omitted, such as those below an ImageNet output's threshold, score zero.
+
+- (void)addClassificationWithY:(nullable id)y yhat:(nullable id)yhat to:(EvaluationSummaryModelTotals*)totals {
+    NSDictionary<NSString*,NSNumber*> *expected = [y isKindOfClass:NSDictionary.class] ? y[kClassificationOutputKey] : nil;
+    NSDictionary<NSString*,NSNumber*> *classifications = [yhat isKindOfClass:NSDictionary.class] ? yhat[kClassificationOutputKey] : nil;
+    NSDictionary<NSString*,NSNumber*> *indexes = totals.classIndexes;
+    
+    NSString *expectedClass = expected.allKeys.firstObject;
+    NSNumber *label = expectedClass != nil ? indexes[expectedClass] : nil;
+    
+    std::vector<float> &scores = totals->_scores;
+    std::fill(scores.begin(), scores.end(), 0.0f);
+    
+    for ( NSString *name in classifications ) {
+        NSNumber *index = indexes[name];
+        if ( index != nil ) {
+            scores[index.unsignedIntegerValue] = classifications[name].floatValue;
+        }
+    }
+    
+    totals->_classificationMetrics->add(label != nil ? label.intValue : -1, scores.data());
+}
+
+// Scalar values at the top level, per-class values keyed by class name with undefined values
+// omitted, and the non-zero cells of the confusion matrix
+
+- (void)addReport:(const MetricReport&)report classes:(NSArray<NSString*>*)classes to:(NSMutableDictionary<NSString*,id>*)summary {
+    for ( const auto &value : report.values ) {
+        summary[@(value.first.c_str())] = std::isnan(value.second) ? (id)NSNull.null : @(value.second);
+    }
+    
+    for ( const auto &values : report.perClass ) {
+        NSMutableDictionary<NSString*,NSNumber*> *dictionary = [[NSMutableDictionary alloc] init];
+        
+        for ( size_t c = 0; c < values.second.size(); c++ ) {
+            if ( !std::isnan(values.second[c]) ) {
+                dictionary[classes[c]] = @(values.second[c]);
+            }
+        }
+        
+        summary[@(values.first.c_str())] = dictionary.copy;
+    }
+    
+    if ( !report.confusion.empty() ) {
+        NSMutableArray<NSArray*> *matrix = [[NSMutableArray alloc] initWithCapacity:report.confusion.size()];
+        
+        for ( const ConfusionEntry &entry : report.confusion ) {
+            [matrix addObject:@[classes[entry.label], classes[entry.predicted], @(entry.count)]];
+        }
+        
+        summary[@"confusion_matrix"] = matrix.copy;
+    }
+    
+    for ( const AccuracyCount &accuracy : report.accuracies ) {
+        [self addAccuracyCount:@(accuracy.name.c_str()) correct:accuracy.correct count:accuracy.count to:summary];
+    }
+}
+
+// MARK: - Regression Testing
+
+// The histogram state lets a later run's latencies be tested against these, see RegressionGate.h
+
+- (NSDictionary<NSString*,id>*)latencyDictionary:(LatencyStatistics*)statistics histogram:(NSDictionary<NSString*,id>*)state {
+    NSMutableDictionary<NSString*,id> *dictionary = [statistics.dictionaryRepresentation mutableCopy];
+    dictionary[@"histogram"] = state;
+    return dictionary.copy;
+}
+
+// A metric value that is 0 or 1 for every result is an accuracy. Its accumulator's counts are
+// reported alongside it, as they are for the classification metrics' accuracies.
+
+- (void)addAccuracyCountsOf:(id<EvaluationMetricAccumulator>)accumulator to:(NSMutableDictionary<NSString*,id>*)summary {
+    if ( ![accumulator respondsToSelector:@selector(accuracyCounts)] ) {
+        return;
+    }
+    
+    NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *counts = accumulator.accuracyCounts;
+    
+    for ( NSString *name in counts ) {
+        [self addAccuracyCount:name correct:counts[name][@"correct"].unsignedLongLongValue count:counts[name][@"count"].unsignedLongLongValue to:summary];
+    }
+}
+
+- (void)addAccuracyCount:(NSString*)name correct:(uint64_t)correct count:(uint64_t)count to:(NSMutableDictionary<NSString*,id>*)summary {
+    NSMutableDictionary<NSString*,id> *counts = [summary[kSummaryKeyAccuracyCounts] mutableCopy] ?: [[NSMutableDictionary alloc] init];
+    counts[name] = @{
+        @"correct": @(correct),
+        @"count": @(count)
+    };
+    summary[kSummaryKeyAccuracyCounts] = counts.copy;
+}
+
+// MARK: -
+
+// Requires the lock. Keeps the most recent load measurements and the largest footprints
+
+- (void)foldMemory:(nullable NSDictionary<NSString*,NSNumber*>*)memory into:(NSMutableDictionary<NSString*,NSNumber*>*)totals {
+    for ( NSString *key in @[kEvaluatorResultsKeyMemoryModelLoad, kEvaluatorResultsKeyMemoryArena] ) {
+        if ( memory[key] != nil ) {
+            totals[key] = memory[key];
+        }
+    }
+    
+    for ( NSString *key in @[kEvaluatorResultsKeyMemoryPreprocessingFootprint, kEvaluatorResultsKeyMemoryInferenceFootprint] ) {
+        if ( memory[key] != nil && memory[key].unsignedLongLongValue > totals[key].unsignedLongLongValue ) {
+            totals[key] = memory[key];
+        }
+    }
+}
+
+- (NSArray<NSDictionary<NSString*,id>*> *)summary {
+    NSMutableArray<NSDictionary<NSString*,id>*> *summary = [[NSMutableArray alloc] init];
+    
+    @synchronized (self) {
+        for ( NSString *modelID in _modelOrder ) {
+            EvaluationSummaryModelTotals *totals = _totals[modelID];
+            NSMutableDictionary<NSString*,id> *modelSummary = [[NSMutableDictionary alloc] init];
+            
+            LatencyCounter *latencyCounter = totals.latencyCounter;
+            
+            modelSummary[kEvaluatorResultsKeyModel] = modelID;
+            modelSummary[@"latency"] = @(latencyCounter.averageInferenceLatency);
+            modelSummary[kEvaluatorResultsKeyPreprocessingLatency] = [self latencyDictionary:latencyCounter.imageProcessingStatistics histogram:latencyCounter.imageProcessingState];
+            modelSummary[kEvaluatorResultsKeyInferenceLatency] = [self latencyDictionary:latencyCounter.inferenceStatistics histogram:latencyCounter.inferenceState];
+            modelSummary[@"total_latency"] = [self latencyDictionary:latencyCounter.totalStatistics histogram:latencyCounter.totalState];
+            modelSummary[kEvaluatorResultsKeyConcurrentModels] = @(totals.maxConcurrentModels);
+            
+            if ( totals->_classificationMetrics != nullptr ) {
+                [self addReport:totals->_classificationMetrics->report() classes:totals.classes to:modelSummary];
+            }
+            
+            if ( totals.memory.count > 0 ) {
+                modelSummary[kEvaluatorResultsKeyMemory] = totals.memory.copy;
+            }
+            
+            if ( totals.metricAccumulator != nil && totals.evaluations > 0 ) {
+                [modelSummary addEntriesFromDictionary:[totals.metricAccumulator reduce]];
+                [self addAccuracyCountsOf:totals.metricAccumulator to:modelSummary];
+            }
+            
+            [summary addObject:modelSummary.copy];
+        }
+    }
+    
+    return summary.copy;
+}
+
+// MARK: - Partial Summaries
+
+- (NSArray<NSDictionary<NSString*,id>*> *)partialSummary {
+    NSMutableArray<NSDictionary<NSString*,id>*> *partialSummary = [[NSMutableArray alloc] init];
+    
+    @synchronized (self) {
+        for ( NSString *modelID in _modelOrder ) {
+            EvaluationSummaryModelTotals *totals = _totals[modelID];
+            NSMutableDictionary<NSString*,id> *partial = [[NSMutableDictionary alloc] init];
+            
+            LatencyCounter *latencyCounter = totals.latencyCounter;
+            
+            partial[kEvaluatorResultsKeyModel] = modelID;
+            partial[@"metric"] = self.metric != nil ? NSStringFromClass(((NSObject*)self.metric).class) : @"";
+            partial[@"evaluations"] = @(totals.evaluations);
+            partial[@"errors"] = _errorCounts[modelID] ?: @(0);
+            partial[kEvaluatorResultsKeyConcurrentModels] = @(totals.maxConcurrentModels);
+            partial[kEvaluatorResultsKeyMemory] = totals.memory.copy;
+            partial[kEvaluatorResultsKeyPreprocessingLatency] = latencyCounter.imageProcessingState;
+            partial[kEvaluatorResultsKeyInferenceLatency] = latencyCounter.inferenceState;
+            partial[@"total_latency"] = latencyCounter.totalState;
+            
+            if ( totals.metricAccumulator != nil ) {
+                partial[@"metric_state"] = [totals.metricAccumulator state];
+            }
+            
+            if ( totals->_classificationMetrics != nullptr ) {
+                [self addStatesOf:*totals->_classificationMetrics classes:totals.classes to:partial];
+            }
+            
+            [partialSummary addObject:partial.copy];
+        }
+    }
+    
+    return partialSummary.copy;
+}
+
+// Requires the lock. Non-zero counters are written as [index, value] pairs, since confusion
+// matrices and average precision histograms are mostly empty
+
+- (void)addStatesOf:(ClassificationMetricSet&)metrics classes:(NSArray<NSString*>*)classes to:(NSMutableDictionary<NSString*,id>*)partial {
+    NSMutableArray<NSString*> *names = [[NSMutableArray alloc] init];
+    NSMutableArray<NSDictionary*> *states = [[NSMutableArray alloc] init];
+    
+    for ( const std::string &name : metrics.names() ) {
+        [names addObject:@(name.c_str())];
+    }
+    
+    for ( const MetricState &state : metrics.states() ) {
+        NSMutableArray<NSArray<NSNumber*>*> *counters = [[NSMutableArray alloc] init];
+        NSMutableArray<NSNumber*> *reals = [[NSMutableArray alloc] initWithCapacity:state.reals.size()];
+        
+        for ( size_t i = 0; i < state.counters.size(); i++ ) {
+            if ( state.counters[i] != 0 ) {
+                [counters addObject:@[@(i), @(state.counters[i])]];
+            }
+        }
+        
+        for ( double real : state.reals ) {
+            [reals addObject:@(real)];
+        }
+        
+        [states addObject:@{
+            @"count": @(state.count),
+            @"size": @(state.counters.size()),
+            @"counters": counters.copy,
+            @"reals": reals.copy
+        }];
+    }
+    
+    partial[@"metrics"] = names.copy;
+    partial[@"classes"] = classes;
+    partial[@"classification_metrics"] = states.copy;
+}
+
+@end
@@ -0,0 +1,92 @@
+//
+//  EvaluationUnits.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+@protocol TIOModel;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The checkpoint units of an evaluation run, see EvaluationCheckpoint.h. Keys are derived on
+ * demand from a fingerprint per model and a content hash per input rather than built up front,
+ * so that a resumable run holds no more than that however many evaluations it makes.
+ *
+ * Units are indexed in engine order: input-major, iteration-minor. Add inputs and models before
+ * reading units, which is then safe to do from any thread.
+ */
+
+@interface EvaluationUnits : NSObject
+
+/**
+ * The number of iterations of each input.
+ */
+
+@property (readonly) NSUInteger iterations;
+
+/**
+ * The number of units of each model, the number of inputs times the number of iterations.
+ */
+
+@property (readonly) NSUInteger count;
+
+/**
+ * Designated initializer.
+ *
+ * @param iterations The number of iterations of each input.
+ * @param options The fingerprint of the options that affect results, see `EvaluationCheckpoint`.
+ */
+
+- (instancetype)initWithIterations:(NSUInteger)iterations options:(uint64_t)options NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Adds the next input by its content hash.
+ */
+
+- (void)addInput:(uint64_t)input;
+
+/**
+ * Adds a model, identified by its fingerprint.
+ */
+
+- (void)addModel:(id<TIOModel>)model;
+
+/**
+ * The unit of a model's evaluation at index, or `nil` if the model was not added or the index is
+ * out of range.
+ */
+
+- (nullable NSString*)unitForModel:(NSString*)modelID index:(NSUInteger)index;
+
+/**
+ * Calls the block with each of a model's units in order. Each unit is released after its call.
+ */
+
+- (void)enumerateUnitsForModel:(NSString*)modelID usingBlock:(void(^)(NSString *unit, NSUInteger index))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
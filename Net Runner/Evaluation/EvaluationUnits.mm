@@ -0,0 +1,77 @@
+//
+//  EvaluationUnits.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationUnits.h"
+#import "EvaluationCheckpoint.h"
+
+#include <vector>
+
+@import TensorIO;
+
+@implementation EvaluationUnits {
+    uint64_t _options;
+    std::vector<uint64_t> _inputs;
+    NSMutableDictionary<NSString*,NSNumber*> *_models;
+}
+
+- (instancetype)initWithIterations:(NSUInteger)iterations options:(uint64_t)options {
+    if ((self=[super init])) {
+        _iterations = iterations;
+        _options = options;
+        _models = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _inputs.size() * _iterations;
+}
+
+- (void)addInput:(uint64_t)input {
+    _inputs.push_back(input);
+}
+
+- (void)addModel:(id<TIOModel>)model {
+    _models[model.identifier] = @([EvaluationCheckpoint fingerprintForModel:model]);
+}
+
+- (nullable NSString*)unitForModel:(NSString*)modelID index:(NSUInteger)index {
+    NSNumber *model = _models[modelID];
+    
+    if ( model == nil || index >= self.count ) {
+        return nil;
+    }
+    
+    return [EvaluationCheckpoint unitForModel:model.unsignedLongLongValue input:_inputs[index / _iterations] iteration:index % _iterations options:_options];
+}
+
+- (void)enumerateUnitsForModel:(NSString*)modelID usingBlock:(void(^)(NSString *unit, NSUInteger index))block {
+    if ( _models[modelID] == nil ) {
+        return;
+    }
+    
+    for ( NSUInteger index = 0; index < self.count; index++ ) {
+        @autoreleasepool {
+            block([self unitForModel:modelID index:index], index);
+        }
+    }
+}
+
+@end
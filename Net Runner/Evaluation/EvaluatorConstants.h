@@ -101,6 +101,13 @@ extern NSString * const kEvaluatorResultsKeySourceTypeURL;
 
 extern NSString * const kEvaluatorResultsKeyPreprocessingLatency;
 
+/**
+ * A boolean value indicating if the preprocessed input was served by the `PreprocessedInputCache`,
+ * in which case the preprocessing latency is the time taken by the cache lookup.
+ */
+
+extern NSString * const kEvaluatorResultsKeyPreprocessingCacheHit;
+
 /**
  * Time it takes in milliseconds, double value, to run inference with the model and input.
  */
@@ -125,4 +132,93 @@ extern NSString * const kEvaluatorResultsKeyPreprocessingError;
 
 extern NSString * const kEvaluatorResultsKeyInferenceError;
 
+// MARK: - Memory keys, produced by CVPixelBufferEvaluator
+
+/**
+ * A dictionary of memory measurements in bytes, see the keys below. Memory is the whole process's
+ * footprint as reported by `netrunner::MemorySampler`, so it is only attributable to a single
+ * evaluation when models are evaluated serially. It is read before and after each stage and never
+ * while a stage is being timed, so transient peaks within a stage are not seen.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMemory;
+
+/**
+ * The change in footprint across loading the model, integer value. Only present in the results
+ * of the evaluation that loaded the model.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMemoryModelLoad;
+
+/**
+ * The rise in footprint across the first inference after the model is loaded, integer value.
+ * The interpreter's tensor arena is allocated when the model is loaded but its pages are only
+ * made resident when inference first touches them, so this is an estimate of the arena's size,
+ * along with any model parameters that are paged in on first use. Only present with the model
+ * load.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMemoryArena;
+
+/**
+ * The process's footprint after preprocessing the input, integer value. Absent on a cache hit.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMemoryPreprocessingFootprint;
+
+/**
+ * The process's footprint after running inference, integer value.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMemoryInferenceFootprint;
+
+// MARK: - Scheduling keys, produced by EvaluationEngine
+
+/**
+ * The number of models being evaluated concurrently when this result was produced, integer
+ * value. Latency measurements are only uncontended when this value is 1.
+ */
+
+extern NSString * const kEvaluatorResultsKeyConcurrentModels;
+
+// MARK: - Live frame keys, produced by LiveFrameScheduler
+
+/**
+ * Time in milliseconds, double value, from when a camera frame was captured until its result
+ * was ready, including the time it waited for the scheduler's workers.
+ */
+
+extern NSString * const kEvaluatorResultsKeyEndToEndLatency;
+
+/**
+ * Boolean value, `YES` when the motion gate found the frame unchanged from the last frame that
+ * was run and the model was not run. The inference results are then those of the last frame.
+ */
+
+extern NSString * const kEvaluatorResultsKeyInferenceSkipped;
+
+/**
+ * Time in milliseconds, double value, the inference latency of the last frame that was run,
+ * which a skipped frame saved. Only present when the inference was skipped.
+ */
+
+extern NSString * const kEvaluatorResultsKeySavedInferenceLatency;
+
+/**
+ * The change of the frame from the last frame that was run, double value in [0,1], as measured
+ * by the motion gate. Only present when the scheduler has a motion gate. See MotionGate.h.
+ */
+
+extern NSString * const kEvaluatorResultsKeyMotionChange;
+
+// MARK: - Checkpoint keys, see EvaluationCheckpoint
+
+/**
+ * The key of the unit of work that produced this result, a string of 16 hexadecimal digits
+ * derived from the model, the content of the input, the iteration and the run's options. Only
+ * present in the results of runs that may be resumed.
+ */
+
+extern NSString * const kEvaluatorResultsKeyUnit;
+
 NS_ASSUME_NONNULL_END
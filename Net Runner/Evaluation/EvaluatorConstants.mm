@@ -42,7 +42,31 @@ NSString * const kEvaluatorResultsKeySourceTypeURL = @"url";
 // MARK: - Final evaluation results, produced by CVPixelBufferEvaluator
 
 NSString * const kEvaluatorResultsKeyPreprocessingLatency = @"preprocessor_latency";
+NSString * const kEvaluatorResultsKeyPreprocessingCacheHit = @"preprocessor_cache_hit";
 NSString * const kEvaluatorResultsKeyInferenceLatency = @"inference_latency";
 NSString * const kEvaluatorResultsKeyInferenceResults = @"inference_results";
 NSString * const kEvaluatorResultsKeyPreprocessingError = @"preprocessor_error";
 NSString * const kEvaluatorResultsKeyInferenceError = @"inference_error";
+
+// MARK: - Memory keys, produced by CVPixelBufferEvaluator
+
+NSString * const kEvaluatorResultsKeyMemory = @"process_memory";
+NSString * const kEvaluatorResultsKeyMemoryModelLoad = @"model_load";
+NSString * const kEvaluatorResultsKeyMemoryArena = @"arena";
+NSString * const kEvaluatorResultsKeyMemoryPreprocessingFootprint = @"preprocessing_footprint";
+NSString * const kEvaluatorResultsKeyMemoryInferenceFootprint = @"inference_footprint";
+
+// MARK: - Scheduling keys, produced by EvaluationEngine
+
+NSString * const kEvaluatorResultsKeyConcurrentModels = @"concurrent_models";
+
+// MARK: - Live frame keys, produced by LiveFrameScheduler
+
+NSString * const kEvaluatorResultsKeyEndToEndLatency = @"end_to_end_latency";
+NSString * const kEvaluatorResultsKeyInferenceSkipped = @"inference_skipped";
+NSString * const kEvaluatorResultsKeySavedInferenceLatency = @"saved_inference_latency";
+NSString * const kEvaluatorResultsKeyMotionChange = @"motion_change";
+
+// MARK: - Checkpoint keys
+
+NSString * const kEvaluatorResultsKeyUnit = @"unit";
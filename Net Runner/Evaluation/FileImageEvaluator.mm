@@ -23,9 +23,14 @@
 #import "EvaluatorConstants.h"
 #import "ImageEvaluator.h"
 #import "Utilities.h"
+#import "PreprocessedInputCache.h"
+
+#include "Tracer.h"
 
 @import TensorIO;
 
+using netrunner::Tracer;
+
 @interface FileImageEvaluator ()
 
 @property (readwrite) NSDictionary *results;
@@ -49,20 +54,75 @@
     return self;
 }
 
+/**
+ * Identifies the file's content by its path, size and modification date, so that an edited file
+ * is not served a stale cache entry.
+ */
+
+- (nullable NSString*)sourceIdentifier {
+    NSDictionary<NSFileAttributeKey,id> *attributes = [NSFileManager.defaultManager attributesOfItemAtPath:self.fileURL.path error:nil];
+    
+    if ( attributes == nil ) {
+        return nil;
+    }
+    
+    return [NSString stringWithFormat:@"file:%@:%llu:%.0f",
+        self.fileURL.path,
+        attributes.fileSize,
+        attributes.fileModificationDate.timeIntervalSince1970];
+}
+
 - (void)evaluateWithCompletionHandler:(nullable EvaluatorCompletionBlock)completionHandler {
     dispatch_once(&_once, ^{
      
     NSString *path = self.fileURL.path;
-    NSData *data = [[NSData alloc] initWithContentsOfFile:path];
-    UIImage *image = [[UIImage alloc] initWithData:data];
     
     @autoreleasepool {
     
         tio_defer_block {
             self.model = nil;
         };
+        
+        // The whole evaluation is traced under the model's name, with its stages nested in it
+        
+        Tracer &tracer = Tracer::Shared();
+        Tracer::Scope span(tracer, tracer.enabled() ? tracer.intern(self.model.identifier.UTF8String) : "", "evaluation");
+        
+        // The image is only decoded if its preprocessed input is not already cached
+        
+        __block BOOL loadedImage = YES;
+        
+        ImageEvaluatorImageProvider imageProvider = ^UIImage * _Nullable{
+            Tracer::Scope readSpan("read image", "preprocessing");
+            NSData *data = [[NSData alloc] initWithContentsOfFile:path];
+            UIImage *image = [[UIImage alloc] initWithData:data];
+            loadedImage = image != nil;
+            return image;
+        };
+        
+        ImageEvaluator *imageEvaluator;
+        NSString *sourceIdentifier = [self sourceIdentifier];
+        
+        if ( sourceIdentifier != nil && PreprocessedInputCache.sharedCache.isEnabled ) {
+            imageEvaluator = [[ImageEvaluator alloc] initWithModel:self.model sourceIdentifier:sourceIdentifier imageProvider:imageProvider];
+        } else {
+            UIImage *image = imageProvider();
+            if ( image != nil ) {
+                imageEvaluator = [[ImageEvaluator alloc] initWithModel:self.model image:image];
+            }
+        }
+        
+        __block NSDictionary *imageResults;
+        __block CVPixelBufferRef imageInputPixelBuffer = NULL;
+        
+        [imageEvaluator evaluateWithCompletionHandler:^(NSDictionary *results, CVPixelBufferRef _Nullable inputPixelBuffer) {
+            imageResults = results;
+            imageInputPixelBuffer = inputPixelBuffer;
+        }];
+        
+        span.finish();
     
-        if (image == nil) {
+        if ( !loadedImage ) {
             NSString *errorDescription = [NSString stringWithFormat:@"Error loading image at %@", path];
             NSLog(@"%@", errorDescription);
             NSDictionary *evaluatorResults = @{
@@ -77,18 +137,14 @@
             return;
         }
         
-        ImageEvaluator *imageEvaluator = [[ImageEvaluator alloc] initWithModel:self.model image:image ];
-        
-        [imageEvaluator evaluateWithCompletionHandler:^(NSDictionary *results, CVPixelBufferRef _Nullable inputPixelBuffer) {
-            NSDictionary *evaluatorResults = @{
-                kEvaluatorResultsKeySourceType          : kEvaluatorResultsKeySourceTypeFile,
-                kEvaluatorResultsKeyImage               : self.name,
-                kEvaluatorResultsKeyModel               : self.model.identifier,
-                kEvaluatorResultsKeyError               : @(NO),
-                kEvaluatorResultsKeyEvaluation          : results
-            };
-            safe_block(completionHandler, evaluatorResults, inputPixelBuffer);
-        }];
+        NSDictionary *evaluatorResults = @{
+            kEvaluatorResultsKeySourceType          : kEvaluatorResultsKeySourceTypeFile,
+            kEvaluatorResultsKeyImage               : self.name,
+            kEvaluatorResultsKeyModel               : self.model.identifier,
+            kEvaluatorResultsKeyError               : @(NO),
+            kEvaluatorResultsKeyEvaluation          : imageResults
+        };
+        safe_block(completionHandler, evaluatorResults, imageInputPixelBuffer);
     }
     
     }); // dispatch_once
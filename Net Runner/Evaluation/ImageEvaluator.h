@@ -25,6 +25,12 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * Lazily provides the image on which inference is run, or `nil` if it cannot be loaded.
+ */
+
+typedef UIImage * _Nullable (^ImageEvaluatorImageProvider)(void);
+
 /**
  * Runs inference on a `UIImage`. Appropriate for models with a single input node that expects a pixel buffer.
  *
@@ -43,7 +49,13 @@ NS_ASSUME_NONNULL_BEGIN
  * The image on which inference is being run.
  */
 
-@property (readonly) UIImage *image;
+@property (nullable, readonly) UIImage *image;
+
+/**
+ * Uniquely identifies the content of the image for the `PreprocessedInputCache`, or `nil`.
+ */
+
+@property (nullable, readonly) NSString *sourceIdentifier;
 
 /**
  * Designated initializer.
@@ -54,6 +66,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithModel:(id<TIOModel>)model image:(UIImage*)image NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Designated initializer for cached evaluation. The image is only loaded if the preprocessed
+ * input is not already in the `PreprocessedInputCache`, so decoding is skipped on a hit.
+ *
+ * @param model The `TIOModel` object on which inference is being run.
+ * @param sourceIdentifier Uniquely identifies the content of the image.
+ * @param provider Loads the `UIImage` on which inference is being run.
+ */
+
+- (instancetype)initWithModel:(id<TIOModel>)model sourceIdentifier:(NSString*)sourceIdentifier imageProvider:(ImageEvaluatorImageProvider)provider NS_DESIGNATED_INITIALIZER;
+
 /**
  * Use the designated initializer.
  */
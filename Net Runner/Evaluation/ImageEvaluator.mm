@@ -23,13 +23,19 @@
 #import "CVPixelBufferEvaluator.h"
 #import "Utilities.h"
 
+#include "Tracer.h"
+
 @import TensorIO;
 
+using netrunner::Tracer;
+
 @interface ImageEvaluator ()
 
 @property (readwrite) NSDictionary *results;
 @property (readwrite) id<TIOModel> model;
-@property (readwrite) UIImage *image;
+@property (nullable, readwrite) UIImage *image;
+@property (nullable, readwrite) NSString *sourceIdentifier;
+@property (nullable, copy) ImageEvaluatorImageProvider imageProvider;
 
 @end
 
@@ -46,17 +52,40 @@
     return self;
 }
 
+- (instancetype)initWithModel:(id<TIOModel>)model sourceIdentifier:(NSString*)sourceIdentifier imageProvider:(ImageEvaluatorImageProvider)provider {
+    if (self = [super init]) {
+        _model = model;
+        _sourceIdentifier = sourceIdentifier;
+        _imageProvider = provider;
+    }
+    
+    return self;
+}
+
 - (void)evaluateWithCompletionHandler:(nullable EvaluatorCompletionBlock)completionHandler {
     dispatch_once(&_once, ^{
     
     tio_defer_block {
         self.model = nil;
         self.image = nil;
+        self.imageProvider = nil;
     };
     
-    CVPixelBufferRef pixelBuffer = self.image.pixelBuffer; // Returns ARGB
+    CVPixelBufferEvaluator *pixelBufferEvaluator;
     
-    CVPixelBufferEvaluator *pixelBufferEvaluator = [[CVPixelBufferEvaluator alloc] initWithModel:self.model pixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationUp];
+    if ( self.sourceIdentifier != nil ) {
+        ImageEvaluatorImageProvider imageProvider = self.imageProvider;
+        pixelBufferEvaluator = [[CVPixelBufferEvaluator alloc] initWithModel:self.model sourceIdentifier:self.sourceIdentifier orientation:kCGImagePropertyOrientationUp pixelBufferProvider:^CVPixelBufferRef _Nullable{
+            UIImage *image = imageProvider();
+            Tracer::Scope span("render pixel buffer", "preprocessing");
+            return image.pixelBuffer; // Returns ARGB
+        }];
+    } else {
+        Tracer::Scope span("render pixel buffer", "preprocessing");
+        CVPixelBufferRef pixelBuffer = self.image.pixelBuffer; // Returns ARGB
+        span.finish();
+        pixelBufferEvaluator = [[CVPixelBufferEvaluator alloc] initWithModel:self.model pixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationUp];
+    }
     
     [pixelBufferEvaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
         safe_block(completionHandler, result, inputPixelBuffer);
@@ -0,0 +1,128 @@
+//
+//  PreprocessedInputCache.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import CoreVideo;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A content addressed cache of preprocessed model inputs, shared across evaluation iterations and
+ * across models with identical input specifications.
+ *
+ * Entries are the pixel buffers produced by `TIOVisionPipeline`, keyed by an identifier for the
+ * source image and a canonical key for the model's `TIOPixelBufferLayerDescription`. The cached
+ * buffer is the input before normalization and quantization, which are applied by the model when
+ * the buffer is copied into its input tensor, so models that differ only in those respects share
+ * entries.
+ *
+ * The cache evicts least recently used entries once `memoryCapacity` is exceeded. When
+ * `spillsToDisk` is set, evicted entries are written to `diskDirectory` and are read back in
+ * on a later lookup.
+ *
+ * Evaluators report cache hits under `kEvaluatorResultsKeyPreprocessingCacheHit`. Disable the
+ * cache to measure cold preprocessing latency.
+ */
+
+@interface PreprocessedInputCache : NSObject
+
+/**
+ * The shared cache consulted by evaluators.
+ */
+
++ (instancetype)sharedCache;
+
+/**
+ * A canonical key for the parts of a pixel buffer description that affect the output of the
+ * vision pipeline: the pixel format and the image volume.
+ */
+
++ (NSString*)keyForDescription:(TIOPixelBufferLayerDescription*)description;
+
+/**
+ * Whether evaluators should consult the cache. Defaults to `YES`.
+ */
+
+@property (getter=isEnabled) BOOL enabled;
+
+/**
+ * The maximum number of bytes of pixel data held in memory. Defaults to 256MB.
+ */
+
+@property NSUInteger memoryCapacity;
+
+/**
+ * When `YES`, entries evicted from memory are written to disk. Defaults to `NO`.
+ */
+
+@property BOOL spillsToDisk;
+
+/**
+ * The directory to which entries are spilled, by default a directory in the caches directory.
+ * The directory's contents belong to the cache and are removed by `removeAllObjects`.
+ */
+
+@property (nonatomic) NSURL *diskDirectory;
+
+/**
+ * The number of bytes of pixel data currently held in memory.
+ */
+
+@property (readonly) NSUInteger memoryUsage;
+
+/**
+ * The number of lookups served from memory, from disk, and not served at all.
+ */
+
+@property (readonly) NSUInteger hits;
+@property (readonly) NSUInteger diskHits;
+@property (readonly) NSUInteger misses;
+
+/**
+ * Returns `YES` if an entry for the source and description is held in memory or on disk,
+ * without counting as a lookup.
+ */
+
+- (BOOL)containsSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description;
+
+/**
+ * Returns the cached pixel buffer for a source and description, or `NULL`. The caller owns the
+ * returned buffer and must release it. Buffers vended by the cache must not be modified.
+ */
+
+- (nullable CVPixelBufferRef)copyPixelBufferForSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description CF_RETURNS_RETAINED;
+
+/**
+ * Caches a preprocessed pixel buffer for a source and description. The buffer is retained and
+ * must not be modified afterwards.
+ */
+
+- (void)setPixelBuffer:(CVPixelBufferRef)pixelBuffer forSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description;
+
+/**
+ * Removes every entry from memory and disk and resets the counters.
+ */
+
+- (void)removeAllObjects;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,316 @@
+//
+//  PreprocessedInputCache.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "PreprocessedInputCache.h"
+
+#import <CommonCrypto/CommonDigest.h>
+
+static const NSUInteger kDefaultMemoryCapacity = 256 * 1024 * 1024;
+
+/**
+ * Spilled entries are a small header followed by the buffer's rows.
+ */
+
+typedef struct PreprocessedInputSpillHeader {
+    uint32_t width;
+    uint32_t height;
+    uint32_t pixelFormat;
+    uint32_t bytesPerRow;
+} PreprocessedInputSpillHeader;
+
+// MARK: -
+
+@interface PreprocessedInputCacheEntry : NSObject
+
+@property (nonatomic, readonly) CVPixelBufferRef pixelBuffer;
+@property (readonly) NSUInteger cost;
+
+- (instancetype)initWithPixelBuffer:(CVPixelBufferRef)pixelBuffer;
+
+@end
+
+@implementation PreprocessedInputCacheEntry
+
+- (instancetype)initWithPixelBuffer:(CVPixelBufferRef)pixelBuffer {
+    if ((self=[super init])) {
+        _pixelBuffer = pixelBuffer;
+        _cost = CVPixelBufferGetDataSize(pixelBuffer);
+        CVPixelBufferRetain(_pixelBuffer);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    CVPixelBufferRelease(_pixelBuffer);
+}
+
+@end
+
+// MARK: -
+
+@interface PreprocessedInputCache ()
+
+@property (readwrite) NSUInteger memoryUsage;
+@property (readwrite) NSUInteger hits;
+@property (readwrite) NSUInteger diskHits;
+@property (readwrite) NSUInteger misses;
+
+@end
+
+@implementation PreprocessedInputCache {
+    NSMutableDictionary<NSString*,PreprocessedInputCacheEntry*> *_entries;
+    NSMutableOrderedSet<NSString*> *_recency; // least recently used first
+    NSMutableSet<NSString*> *_spilled;
+}
+
++ (instancetype)sharedCache {
+    static PreprocessedInputCache *sharedCache = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedCache = [[PreprocessedInputCache alloc] init];
+    });
+    return sharedCache;
+}
+
++ (NSString*)keyForDescription:(TIOPixelBufferLayerDescription*)description {
+    TIOImageVolume volume = description.imageVolume;
+    OSType format = description.pixelFormat;
+    
+    return [NSString stringWithFormat:@"%c%c%c%c-%dx%dx%d",
+        (char)(format >> 24), (char)(format >> 16), (char)(format >> 8), (char)format,
+        volume.width, volume.height, volume.channels];
+}
+
+- (instancetype)init {
+    if ((self=[super init])) {
+        _enabled = YES;
+        _memoryCapacity = kDefaultMemoryCapacity;
+        _spillsToDisk = NO;
+        _entries = [[NSMutableDictionary alloc] init];
+        _recency = [[NSMutableOrderedSet alloc] init];
+        _spilled = [[NSMutableSet alloc] init];
+        
+        NSURL *caches = [NSFileManager.defaultManager URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask].firstObject;
+        _diskDirectory = [caches URLByAppendingPathComponent:@"preprocessed-inputs" isDirectory:YES];
+    }
+    return self;
+}
+
+- (void)setDiskDirectory:(NSURL *)diskDirectory {
+    @synchronized (self) {
+        _diskDirectory = diskDirectory;
+        [_spilled removeAllObjects];
+    }
+}
+
+- (NSURL*)diskDirectory {
+    @synchronized (self) {
+        return _diskDirectory;
+    }
+}
+
+// MARK: - Lookup
+
+- (NSString*)keyForSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description {
+    return [NSString stringWithFormat:@"%@|%@", [PreprocessedInputCache keyForDescription:description], source];
+}
+
+- (BOOL)containsSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description {
+    NSString *key = [self keyForSource:source description:description];
+    
+    @synchronized (self) {
+        return _entries[key] != nil || [_spilled containsObject:key];
+    }
+}
+
+- (nullable CVPixelBufferRef)copyPixelBufferForSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description {
+    NSString *key = [self keyForSource:source description:description];
+    
+    @synchronized (self) {
+        if ( PreprocessedInputCacheEntry *entry = _entries[key] ) {
+            [_recency removeObject:key];
+            [_recency addObject:key];
+            self.hits += 1;
+            return CVPixelBufferRetain(entry.pixelBuffer);
+        }
+        
+        if ( [_spilled containsObject:key] ) {
+            CVPixelBufferRef pixelBuffer = [self readSpilledPixelBufferForKey:key];
+            
+            if ( pixelBuffer != NULL ) {
+                [self insertPixelBuffer:pixelBuffer forKey:key];
+                self.diskHits += 1;
+                return pixelBuffer;
+            }
+        }
+        
+        self.misses += 1;
+        return NULL;
+    }
+}
+
+- (void)setPixelBuffer:(CVPixelBufferRef)pixelBuffer forSource:(NSString*)source description:(TIOPixelBufferLayerDescription*)description {
+    NSString *key = [self keyForSource:source description:description];
+    
+    @synchronized (self) {
+        [self insertPixelBuffer:pixelBuffer forKey:key];
+    }
+}
+
+- (void)removeAllObjects {
+    @synchronized (self) {
+        [_entries removeAllObjects];
+        [_recency removeAllObjects];
+        
+        if ( _spilled.count > 0 ) {
+            [NSFileManager.defaultManager removeItemAtURL:_diskDirectory error:nil];
+            [_spilled removeAllObjects];
+        }
+        
+        self.memoryUsage = 0;
+        self.hits = 0;
+        self.diskHits = 0;
+        self.misses = 0;
+    }
+}
+
+// MARK: - Eviction
+
+// The following methods require the lock
+
+- (void)insertPixelBuffer:(CVPixelBufferRef)pixelBuffer forKey:(NSString*)key {
+    PreprocessedInputCacheEntry *entry = [[PreprocessedInputCacheEntry alloc] initWithPixelBuffer:pixelBuffer];
+    
+    if ( PreprocessedInputCacheEntry *existing = _entries[key] ) {
+        self.memoryUsage -= existing.cost;
+        [_recency removeObject:key];
+    }
+    
+    _entries[key] = entry;
+    [_recency addObject:key];
+    self.memoryUsage += entry.cost;
+    
+    while ( self.memoryUsage > self.memoryCapacity && _recency.count > 1 ) {
+        NSString *evictedKey = _recency.firstObject;
+        PreprocessedInputCacheEntry *evicted = _entries[evictedKey];
+        
+        if ( self.spillsToDisk && ![_spilled containsObject:evictedKey] ) {
+            if ( [self spillPixelBuffer:evicted.pixelBuffer forKey:evictedKey] ) {
+                [_spilled addObject:evictedKey];
+            }
+        }
+        
+        self.memoryUsage -= evicted.cost;
+        [_entries removeObjectForKey:evictedKey];
+        [_recency removeObjectAtIndex:0];
+    }
+}
+
+// MARK: - Disk Spill
+
+- (NSURL*)spillURLForKey:(NSString*)key {
+    NSData *keyData = [key dataUsingEncoding:NSUTF8StringEncoding];
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(keyData.bytes, (CC_LONG)keyData.length, digest);
+    
+    NSMutableString *filename = [[NSMutableString alloc] initWithCapacity:CC_SHA1_DIGEST_LENGTH*2];
+    for ( int i = 0; i < CC_SHA1_DIGEST_LENGTH; i++ ) {
+        [filename appendFormat:@"%02x", digest[i]];
+    }
+    
+    return [_diskDirectory URLByAppendingPathComponent:filename];
+}
+
+- (BOOL)spillPixelBuffer:(CVPixelBufferRef)pixelBuffer forKey:(NSString*)key {
+    if ( CVPixelBufferIsPlanar(pixelBuffer) ) {
+        return NO;
+    }
+    
+    NSError *error;
+    
+    if ( ![NSFileManager.defaultManager createDirectoryAtURL:_diskDirectory withIntermediateDirectories:YES attributes:nil error:&error] ) {
+        NSLog(@"Unable to create preprocessed input cache directory at %@, error: %@", _diskDirectory, error);
+        return NO;
+    }
+    
+    CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+    
+    PreprocessedInputSpillHeader header = {
+        (uint32_t)CVPixelBufferGetWidth(pixelBuffer),
+        (uint32_t)CVPixelBufferGetHeight(pixelBuffer),
+        (uint32_t)CVPixelBufferGetPixelFormatType(pixelBuffer),
+        (uint32_t)CVPixelBufferGetBytesPerRow(pixelBuffer)
+    };
+    
+    NSMutableData *data = [[NSMutableData alloc] initWithCapacity:sizeof(header) + header.height * header.bytesPerRow];
+    [data appendBytes:&header length:sizeof(header)];
+    [data appendBytes:CVPixelBufferGetBaseAddress(pixelBuffer) length:header.height * header.bytesPerRow];
+    
+    CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+    
+    if ( ![data writeToURL:[self spillURLForKey:key] options:0 error:&error] ) {
+        NSLog(@"Unable to spill preprocessed input to disk, error: %@", error);
+        return NO;
+    }
+    
+    return YES;
+}
+
+- (nullable CVPixelBufferRef)readSpilledPixelBufferForKey:(NSString*)key CF_RETURNS_RETAINED {
+    NSData *data = [NSData dataWithContentsOfURL:[self spillURLForKey:key] options:NSDataReadingMappedIfSafe error:nil];
+    PreprocessedInputSpillHeader header;
+    
+    if ( data.length < sizeof(header) ) {
+        [_spilled removeObject:key];
+        return NULL;
+    }
+    
+    [data getBytes:&header length:sizeof(header)];
+    
+    if ( data.length != sizeof(header) + header.height * header.bytesPerRow ) {
+        [_spilled removeObject:key];
+        return NULL;
+    }
+    
+    CVPixelBufferRef pixelBuffer = NULL;
+    CVReturn status = CVPixelBufferCreate(kCFAllocatorDefault, header.width, header.height, header.pixelFormat, NULL, &pixelBuffer);
+    
+    if ( status != kCVReturnSuccess ) {
+        NSLog(@"Unable to allocate pixel buffer for spilled preprocessed input, status: %d", status);
+        return NULL;
+    }
+    
+    CVPixelBufferLockBaseAddress(pixelBuffer, kNilOptions);
+    
+    uint8_t *destination = (uint8_t*)CVPixelBufferGetBaseAddress(pixelBuffer);
+    const uint8_t *source = (const uint8_t*)data.bytes + sizeof(header);
+    size_t destinationBytesPerRow = CVPixelBufferGetBytesPerRow(pixelBuffer);
+    size_t rowLength = MIN(destinationBytesPerRow, (size_t)header.bytesPerRow);
+    
+    for ( uint32_t row = 0; row < header.height; row++ ) {
+        memcpy(destination + row * destinationBytesPerRow, source + row * header.bytesPerRow, rowLength);
+    }
+    
+    CVPixelBufferUnlockBaseAddress(pixelBuffer, kNilOptions);
+    
+    return pixelBuffer;
+}
+
+@end
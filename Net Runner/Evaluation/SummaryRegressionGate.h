@@ -0,0 +1,85 @@
+//
+//  SummaryRegressionGate.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Compares the summaries produced by `EvaluationSummaryAccumulator` with a baseline summary and
+ * produces a machine readable verdict. Wraps `netrunner::RegressionGate`, see RegressionGate.h,
+ * and reads summaries and thresholds, and writes verdicts, in the schema the command line
+ * runner uses.
+ *
+ * Thresholds are a dictionary with optional "alpha", "latency_increase", "accuracy_decrease" and
+ * "minimum_samples" entries and a "models" dictionary overriding any of them for individual
+ * models by model id. Other entries, such as a test bundle's "baseline", are ignored.
+ */
+
+@interface SummaryRegressionGate : NSObject
+
+/**
+ * The baseline summary, one dictionary per model.
+ */
+
+@property (readonly) NSArray<NSDictionary<NSString*,id>*> *baseline;
+
+/**
+ * Designated initializer.
+ *
+ * @param baseline The baseline summary, one dictionary per model.
+ * @param thresholds The regression thresholds, `nil` for the defaults.
+ * @param error Set if the baseline summary or the thresholds are malformed.
+ *
+ * @return instancetype A gate or `nil` if the baseline or thresholds could not be read.
+ */
+
+- (nullable instancetype)initWithBaseline:(NSArray<NSDictionary<NSString*,id>*>*)baseline thresholds:(nullable NSDictionary<NSString*,id>*)thresholds error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Reads the baseline summary from a JSON file, either an array of model summaries or a
+ * dictionary with one under "summary", as the app shares and the command line runner writes.
+ */
+
+- (nullable instancetype)initWithBaselineURL:(NSURL*)URL thresholds:(nullable NSDictionary<NSString*,id>*)thresholds error:(NSError**)error;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Compares a summary with the baseline.
+ *
+ * @param summary The summary of the run, one dictionary per model.
+ * @param testBundle The identifier of the test bundle the summary covers, which selects its
+ *  models from a baseline of several test bundles, or `nil`.
+ * @param error Set if the summary is malformed.
+ *
+ * @return NSDictionary The verdict, with "passed", the number of "regressions" and the
+ *  comparison of each model under "models", or `nil` if the summary could not be read.
+ */
+
+- (nullable NSDictionary<NSString*,id>*)verdictForSummary:(NSArray<NSDictionary<NSString*,id>*>*)summary testBundle:(nullable NSString*)testBundle error:(NSError**)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
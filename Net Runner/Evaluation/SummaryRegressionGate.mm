@@ -0,0 +1,323 @@
+//
+//  SummaryRegressionGate.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "SummaryRegressionGate.h"
+
+#import "EvaluatorConstants.h"
+
+#include <string>
+#include <vector>
+
+#include "RegressionGate.h"
+
+using namespace netrunner;
+
+static NSString * const kSummaryKeyTestBundle = @"test_bundle";
+static NSString * const kSummaryKeyHistogram = @"histogram";
+static NSString * const kSummaryKeyAccuracyCounts = @"accuracy_counts";
+
+static BOOL ReadThresholds(NSDictionary<NSString*,id> *dictionary, RegressionGate::Thresholds *thresholds);
+static BOOL ReadSamples(NSArray<NSDictionary<NSString*,id>*> *summary, NSString *testBundle, std::vector<RegressionGate::ModelSamples> *models);
+static NSDictionary<NSString*,id> *VerdictDictionary(const RegressionGate::Result &result);
+
+// MARK: - Errors
+
+static NSString * const NetRunnerSummaryRegressionGateErrorDomain = @"ai.doc.net-runner.summary-regression-gate";
+
+static const NSInteger NetRunnerSummaryRegressionGateBaselineErrorCode = 101;
+static const NSInteger NetRunnerSummaryRegressionGateThresholdsErrorCode = 102;
+static const NSInteger NetRunnerSummaryRegressionGateSummaryErrorCode = 103;
+
+NSError * NetRunnerSummaryRegressionGateBaselineError(NSString *description);
+NSError * NetRunnerSummaryRegressionGateThresholdsError(void);
+NSError * NetRunnerSummaryRegressionGateSummaryError(void);
+
+// MARK: -
+
+@interface SummaryRegressionGate ()
+
+@property (readwrite) NSArray<NSDictionary<NSString*,id>*> *baseline;
+
+@end
+
+@implementation SummaryRegressionGate {
+    RegressionGate _gate;
+    std::vector<RegressionGate::ModelSamples> _baselineSamples;
+}
+
+- (nullable instancetype)initWithBaseline:(NSArray<NSDictionary<NSString*,id>*>*)baseline thresholds:(nullable NSDictionary<NSString*,id>*)thresholds error:(NSError**)error {
+    if ((self=[super init])) {
+        RegressionGate::Thresholds defaults;
+        NSDictionary<NSString*,NSDictionary*> *models = [thresholds isKindOfClass:NSDictionary.class] ? thresholds[@"models"] : nil;
+        
+        if ( (thresholds != nil && !ReadThresholds(thresholds, &defaults))
+            || (models != nil && ![models isKindOfClass:NSDictionary.class]) ) {
+            NSLog(@"Regression thresholds are malformed: %@", thresholds);
+            if (error) {
+                *error = NetRunnerSummaryRegressionGateThresholdsError();
+            }
+            return nil;
+        }
+        
+        _gate = RegressionGate(defaults);
+        
+        for ( NSString *model in models ) {
+            RegressionGate::Thresholds overrides = defaults;
+            
+            if ( !ReadThresholds(models[model], &overrides) ) {
+                NSLog(@"Regression thresholds for model %@ are malformed: %@", model, models[model]);
+                if (error) {
+                    *error = NetRunnerSummaryRegressionGateThresholdsError();
+                }
+                return nil;
+            }
+            
+            _gate.setThresholds(model.UTF8String, overrides);
+        }
+        
+        if ( !ReadSamples(baseline, nil, &_baselineSamples) ) {
+            NSLog(@"Baseline summary is malformed");
+            if (error) {
+                *error = NetRunnerSummaryRegressionGateBaselineError(@"The baseline is not a summary.");
+            }
+            return nil;
+        }
+        
+        _baseline = baseline.copy;
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithBaselineURL:(NSURL*)URL thresholds:(nullable NSDictionary<NSString*,id>*)thresholds error:(NSError**)error {
+    NSData *data = [NSData dataWithContentsOfURL:URL options:0 error:error];
+    id JSON = data != nil ? [NSJSONSerialization JSONObjectWithData:data options:0 error:error] : nil;
+    
+    if ( JSON == nil ) {
+        NSLog(@"Unable to read baseline summary at %@", URL.path);
+        return nil;
+    }
+    
+    id baseline = [JSON isKindOfClass:NSDictionary.class] ? JSON[@"summary"] : JSON;
+    
+    if ( ![baseline isKindOfClass:NSArray.class] ) {
+        NSLog(@"Baseline at %@ is not a summary", URL.path);
+        if (error) {
+            *error = NetRunnerSummaryRegressionGateBaselineError([NSString stringWithFormat:@"%@ is not a summary.", URL.lastPathComponent]);
+        }
+        return nil;
+    }
+    
+    return [self initWithBaseline:baseline thresholds:thresholds error:error];
+}
+
+- (nullable NSDictionary<NSString*,id>*)verdictForSummary:(NSArray<NSDictionary<NSString*,id>*>*)summary testBundle:(nullable NSString*)testBundle error:(NSError**)error {
+    std::vector<RegressionGate::ModelSamples> samples;
+    
+    if ( !ReadSamples(summary, testBundle, &samples) ) {
+        NSLog(@"Summary is malformed, unable to compare it with the baseline");
+        if (error) {
+            *error = NetRunnerSummaryRegressionGateSummaryError();
+        }
+        return nil;
+    }
+    
+    return VerdictDictionary(_gate.compare(_baselineSamples, samples));
+}
+
+@end
+
+// MARK: - Summaries
+
+static BOOL IsNumber(id value) {
+    return [value isKindOfClass:NSNumber.class];
+}
+
+static BOOL ReadThresholds(NSDictionary<NSString*,id> *dictionary, RegressionGate::Thresholds *thresholds) {
+    if ( ![dictionary isKindOfClass:NSDictionary.class] ) {
+        return NO;
+    }
+    
+    for ( NSString *key in @[@"alpha", @"latency_increase", @"accuracy_decrease", @"minimum_samples"] ) {
+        if ( dictionary[key] != nil && (!IsNumber(dictionary[key]) || [dictionary[key] doubleValue] < 0) ) {
+            return NO;
+        }
+    }
+    
+    if ( dictionary[@"alpha"] != nil ) {
+        thresholds->alpha = [dictionary[@"alpha"] doubleValue];
+    }
+    if ( dictionary[@"latency_increase"] != nil ) {
+        thresholds->latencyIncrease = [dictionary[@"latency_increase"] doubleValue];
+    }
+    if ( dictionary[@"accuracy_decrease"] != nil ) {
+        thresholds->accuracyDecrease = [dictionary[@"accuracy_decrease"] doubleValue];
+    }
+    if ( dictionary[@"minimum_samples"] != nil ) {
+        thresholds->minimumSamples = [dictionary[@"minimum_samples"] unsignedLongLongValue];
+    }
+    
+    return YES;
+}
+
+static BOOL ReadHistogram(NSDictionary<NSString*,id> *dictionary, LatencyHistogram::State *state) {
+    if ( ![dictionary isKindOfClass:NSDictionary.class] || ![dictionary[@"buckets"] isKindOfClass:NSArray.class] ) {
+        return NO;
+    }
+    
+    state->minMicros = [dictionary[@"min"] unsignedLongLongValue];
+    state->maxMicros = [dictionary[@"max"] unsignedLongLongValue];
+    state->sum = [dictionary[@"sum"] doubleValue];
+    state->sumOfSquares = [dictionary[@"sum_of_squares"] doubleValue];
+    
+    for ( NSArray<NSNumber*> *pair in dictionary[@"buckets"] ) {
+        if ( ![pair isKindOfClass:NSArray.class] || pair.count != 2 || !IsNumber(pair[0]) || !IsNumber(pair[1])
+            || pair[0].unsignedIntegerValue >= LatencyHistogram::kBucketCount ) {
+            return NO;
+        }
+        state->buckets.push_back({pair[0].unsignedIntValue, pair[1].unsignedLongLongValue});
+    }
+    
+    return YES;
+}
+
+// Latencies are the entries with a histogram, accuracies those with counts. A summary produced
+// by a single test bundle's runner lacks the test bundle, which is then taken from the caller.
+
+static BOOL ReadSamples(NSArray<NSDictionary<NSString*,id>*> *summary, NSString *testBundle, std::vector<RegressionGate::ModelSamples> *models) {
+    if ( ![summary isKindOfClass:NSArray.class] ) {
+        return NO;
+    }
+    
+    for ( NSDictionary<NSString*,id> *entry in summary ) {
+        if ( ![entry isKindOfClass:NSDictionary.class] || ![entry[kEvaluatorResultsKeyModel] isKindOfClass:NSString.class] ) {
+            return NO;
+        }
+        
+        RegressionGate::ModelSamples model;
+        model.model = [entry[kEvaluatorResultsKeyModel] UTF8String];
+        
+        if ( NSString *identifier = entry[kSummaryKeyTestBundle] ?: testBundle ) {
+            model.testBundle = identifier.UTF8String;
+        }
+        
+        for ( NSString *name in entry ) {
+            NSDictionary *value = entry[name];
+            
+            if ( ![value isKindOfClass:NSDictionary.class] || value[kSummaryKeyHistogram] == nil ) {
+                continue;
+            }
+            
+            LatencyHistogram::State state;
+            
+            if ( !ReadHistogram(value[kSummaryKeyHistogram], &state) ) {
+                return NO;
+            }
+            
+            model.latencies.push_back({name.UTF8String, state});
+        }
+        
+        NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *accuracies = entry[kSummaryKeyAccuracyCounts];
+        
+        if ( accuracies != nil && ![accuracies isKindOfClass:NSDictionary.class] ) {
+            return NO;
+        }
+        
+        for ( NSString *name in accuracies ) {
+            NSDictionary<NSString*,NSNumber*> *counts = accuracies[name];
+            
+            if ( ![counts isKindOfClass:NSDictionary.class] || !IsNumber(counts[@"correct"]) || !IsNumber(counts[@"count"]) ) {
+                return NO;
+            }
+            
+            RegressionGate::Proportion proportion;
+            proportion.correct = counts[@"correct"].unsignedLongLongValue;
+            proportion.count = counts[@"count"].unsignedLongLongValue;
+            model.accuracies.push_back({name.UTF8String, proportion});
+        }
+        
+        models->push_back(model);
+    }
+    
+    return YES;
+}
+
+static NSDictionary<NSString*,id> *VerdictDictionary(const RegressionGate::Result &result) {
+    NSMutableArray<NSDictionary<NSString*,id>*> *models = [[NSMutableArray alloc] init];
+    
+    for ( const RegressionGate::ModelResult &model : result.models ) {
+        NSMutableArray<NSDictionary<NSString*,id>*> *checks = [[NSMutableArray alloc] init];
+        
+        for ( const RegressionGate::Check &check : model.checks ) {
+            [checks addObject:@{
+                @"name": @(check.name.c_str()),
+                @"kind": @(RegressionGate::KindName(check.kind).c_str()),
+                @"verdict": @(RegressionGate::VerdictName(check.verdict).c_str()),
+                @"baseline": @(check.baseline),
+                @"candidate": @(check.candidate),
+                @"change": @(check.change),
+                @"p_value": @(check.pValue),
+                @"threshold": @(check.threshold),
+                @"baseline_count": @(check.baselineCount),
+                @"candidate_count": @(check.candidateCount)
+            }];
+        }
+        
+        NSMutableDictionary<NSString*,id> *dictionary = [[NSMutableDictionary alloc] init];
+        
+        if ( !model.testBundle.empty() ) {
+            dictionary[kSummaryKeyTestBundle] = @(model.testBundle.c_str());
+        }
+        
+        dictionary[kEvaluatorResultsKeyModel] = @(model.model.c_str());
+        dictionary[@"verdict"] = @(RegressionGate::VerdictName(model.verdict).c_str());
+        dictionary[@"checks"] = checks.copy;
+        
+        [models addObject:dictionary.copy];
+    }
+    
+    return @{
+        @"passed": @(result.passed),
+        @"regressions": @(result.regressions),
+        @"models": models.copy
+    };
+}
+
+// MARK: - Errors
+
+NSError * NetRunnerSummaryRegressionGateBaselineError(NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerSummaryRegressionGateErrorDomain code:NetRunnerSummaryRegressionGateBaselineErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"There was a problem reading the baseline summary: %@", description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure the baseline is a summary shared by the app or written by the command line runner."
+    }];
+}
+
+NSError * NetRunnerSummaryRegressionGateThresholdsError(void) {
+    return [[NSError alloc] initWithDomain:NetRunnerSummaryRegressionGateErrorDomain code:NetRunnerSummaryRegressionGateThresholdsErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: @"The regression thresholds are malformed.",
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure every threshold is a non-negative number and that per model thresholds are keyed by model id."
+    }];
+}
+
+NSError * NetRunnerSummaryRegressionGateSummaryError(void) {
+    return [[NSError alloc] initWithDomain:NetRunnerSummaryRegressionGateErrorDomain code:NetRunnerSummaryRegressionGateSummaryErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: @"The summary could not be compared with the baseline because it is malformed.",
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure the summary was produced by an EvaluationSummaryAccumulator."
+    }];
+}
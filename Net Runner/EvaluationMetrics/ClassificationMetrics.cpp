@@ -0,0 +1,769 @@
+//
+//  ClassificationMetrics.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ClassificationMetrics.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <limits>
+#include <map>
+#include <mutex>
+
+namespace netrunner {
+namespace metrics {
+
+namespace {
+
+const double kUndefined = std::numeric_limits<double>::quiet_NaN();
+
+bool IsLabeled(int32_t label, size_t classes) {
+    return label >= 0 && static_cast<size_t>(label) < classes;
+}
+
+// The index of the highest score, the lowest index among ties. The maximum is found first with
+// independent lanes the compiler can vectorize, and then its index
+
+size_t Argmax(const float *row, size_t classes) {
+    const size_t kLanes = 8;
+    float best = row[0];
+    size_t j = 0;
+
+    if ( classes >= kLanes ) {
+        float lanes[kLanes];
+
+        for ( size_t l = 0; l < kLanes; l++ ) {
+            lanes[l] = row[l];
+        }
+        for ( j = kLanes; j + kLanes <= classes; j += kLanes ) {
+            for ( size_t l = 0; l < kLanes; l++ ) {
+                lanes[l] = row[j + l] > lanes[l] ? row[j + l] : lanes[l];
+            }
+        }
+        for ( size_t l = 0; l < kLanes; l++ ) {
+            best = lanes[l] > best ? lanes[l] : best;
+        }
+    }
+
+    for ( ; j < classes; j++ ) {
+        best = row[j] > best ? row[j] : best;
+    }
+
+    size_t index = 0;
+    while ( index < classes && !(row[index] == best) ) {
+        index++;
+    }
+
+    return index < classes ? index : 0;
+}
+
+size_t Predicted(const PredictionBatch &batch, size_t row) {
+    return batch.predicted != nullptr
+        ? static_cast<size_t>(batch.predicted[row])
+        : Argmax(batch.scores + row * batch.classes, batch.classes);
+}
+
+// Maps a probability to one of bins equal-width bins, clamping out of range values and NaN
+
+size_t BinForScore(float score, size_t bins) {
+    if ( !(score > 0) ) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(score * static_cast<float>(bins)), bins - 1);
+}
+
+double Ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator == 0 ? kUndefined : static_cast<double>(numerator) / static_cast<double>(denominator);
+}
+
+double MeanOfDefined(const std::vector<double> &values) {
+    double sum = 0;
+    size_t count = 0;
+
+    for ( double value : values ) {
+        if ( !std::isnan(value) ) {
+            sum += value;
+            count += 1;
+        }
+    }
+
+    return count == 0 ? kUndefined : sum / static_cast<double>(count);
+}
+
+void AddCounts(std::vector<uint64_t> &counts, const std::vector<uint64_t> &other) {
+    for ( size_t i = 0; i < counts.size(); i++ ) {
+        counts[i] += other[i];
+    }
+}
+
+// Splits a state's counters into consecutive runs of the given sizes
+
+bool SplitCounters(const MetricState &state, std::initializer_list<std::vector<uint64_t>*> runs) {
+    size_t total = 0;
+
+    for ( const std::vector<uint64_t> *run : runs ) {
+        total += run->size();
+    }
+
+    if ( state.counters.size() != total ) {
+        return false;
+    }
+
+    auto begin = state.counters.begin();
+
+    for ( std::vector<uint64_t> *run : runs ) {
+        std::copy(begin, begin + run->size(), run->begin());
+        begin += run->size();
+    }
+
+    return true;
+}
+
+} // namespace
+
+// MARK: - ClassificationMetric
+
+// Loads the state into an empty accumulator first, so that a mismatched state leaves this one
+// untouched and each metric's merge stays the only place its counters are combined
+
+bool ClassificationMetric::mergeState(const MetricState &state) {
+    std::unique_ptr<ClassificationMetric> other = empty();
+    return other->load(state) && merge(*other);
+}
+
+// MARK: - TopKAccuracy
+
+TopKAccuracy::TopKAccuracy(size_t classes, size_t k) : ClassificationMetric(classes), _k(k) {
+    assert(k > 0);
+}
+
+void TopKAccuracy::add(const PredictionBatch &batch) {
+    assert(batch.classes == _classes);
+
+    for ( size_t r = 0; r < batch.count; r++ ) {
+        const int32_t label = batch.labels[r];
+
+        if ( !IsLabeled(label, _classes) ) {
+            continue;
+        }
+
+        // The label's rank is the number of scores that beat it
+
+        const float *row = batch.scores + r * _classes;
+        const float score = row[label];
+        size_t rank = 0;
+
+        for ( size_t j = 0; j < static_cast<size_t>(label); j++ ) {
+            rank += row[j] >= score;
+        }
+        for ( size_t j = static_cast<size_t>(label) + 1; j < _classes; j++ ) {
+            rank += row[j] > score;
+        }
+
+        _correct += rank < _k;
+        _count += 1;
+    }
+}
+
+bool TopKAccuracy::merge(const ClassificationMetric &other) {
+    const TopKAccuracy *accuracy = dynamic_cast<const TopKAccuracy*>(&other);
+
+    if ( accuracy == nullptr || accuracy->_classes != _classes || accuracy->_k != _k ) {
+        return false;
+    }
+
+    _correct += accuracy->_correct;
+    _count += accuracy->_count;
+
+    return true;
+}
+
+std::unique_ptr<ClassificationMetric> TopKAccuracy::empty() const {
+    return std::unique_ptr<ClassificationMetric>(new TopKAccuracy(_classes, _k));
+}
+
+void TopKAccuracy::report(MetricReport *report) const {
+    const std::string name = "accuracy_top" + std::to_string(_k);
+    report->values.push_back({name, Ratio(_correct, _count)});
+    report->accuracies.push_back({name, _correct, _count});
+}
+
+MetricState TopKAccuracy::state() const {
+    MetricState state;
+    state.count = _count;
+    state.counters.push_back(_correct);
+    return state;
+}
+
+bool TopKAccuracy::load(const MetricState &state) {
+    if ( state.counters.size() != 1 || !state.reals.empty() ) {
+        return false;
+    }
+
+    _correct = state.counters[0];
+    _count = state.count;
+
+    return true;
+}
+
+// MARK: - ConfusionMatrix
+
+ConfusionMatrix::ConfusionMatrix(size_t classes) : ClassificationMetric(classes), _counts(classes * classes, 0) {}
+
+void ConfusionMatrix::add(const PredictionBatch &batch) {
+    assert(batch.classes == _classes);
+
+    for ( size_t r = 0; r < batch.count; r++ ) {
+        const int32_t label = batch.labels[r];
+
+        if ( !IsLabeled(label, _classes) ) {
+            continue;
+        }
+
+        const size_t predicted = Predicted(batch, r);
+        _counts[static_cast<size_t>(label) * _classes + predicted] += 1;
+        _count += 1;
+    }
+}
+
+bool ConfusionMatrix::merge(const ClassificationMetric &other) {
+    const ConfusionMatrix *matrix = dynamic_cast<const ConfusionMatrix*>(&other);
+
+    if ( matrix == nullptr || matrix->_classes != _classes ) {
+        return false;
+    }
+
+    AddCounts(_counts, matrix->_counts);
+    _count += matrix->_count;
+
+    return true;
+}
+
+std::unique_ptr<ClassificationMetric> ConfusionMatrix::empty() const {
+    return std::unique_ptr<ClassificationMetric>(new ConfusionMatrix(_classes));
+}
+
+void ConfusionMatrix::report(MetricReport *report) const {
+    std::vector<uint64_t> support(_classes, 0);
+    std::vector<uint64_t> predictions(_classes, 0);
+
+    for ( size_t label = 0; label < _classes; label++ ) {
+        for ( size_t predicted = 0; predicted < _classes; predicted++ ) {
+            const uint64_t count = at(label, predicted);
+
+            if ( count == 0 ) {
+                continue;
+            }
+
+            support[label] += count;
+            predictions[predicted] += count;
+            report->confusion.push_back({label, predicted, count});
+        }
+    }
+
+    std::vector<double> precision(_classes), recall(_classes);
+
+    for ( size_t c = 0; c < _classes; c++ ) {
+        precision[c] = Ratio(at(c, c), predictions[c]);
+        recall[c] = Ratio(at(c, c), support[c]);
+    }
+
+    report->values.push_back({"macro_precision", MeanOfDefined(precision)});
+    report->values.push_back({"macro_recall", MeanOfDefined(recall)});
+    report->perClass.push_back({"precision", std::move(precision)});
+    report->perClass.push_back({"recall", std::move(recall)});
+}
+
+MetricState ConfusionMatrix::state() const {
+    MetricState state;
+    state.count = _count;
+    state.counters = _counts;
+    return state;
+}
+
+bool ConfusionMatrix::load(const MetricState &state) {
+    if ( !state.reals.empty() || !SplitCounters(state, {&_counts}) ) {
+        return false;
+    }
+
+    _count = state.count;
+
+    return true;
+}
+
+// MARK: - CalibrationError
+
+CalibrationError::CalibrationError(size_t classes, size_t bins)
+    : ClassificationMetric(classes), _binCounts(bins, 0), _binCorrect(bins, 0), _binConfidence(bins, 0) {
+    assert(bins > 0);
+}
+
+void CalibrationError::add(const PredictionBatch &batch) {
+    assert(batch.classes == _classes);
+
+    const size_t bins = _binCounts.size();
+
+    for ( size_t r = 0; r < batch.count; r++ ) {
+        const int32_t label = batch.labels[r];
+
+        if ( !IsLabeled(label, _classes) ) {
+            continue;
+        }
+
+        const float *row = batch.scores + r * _classes;
+        const size_t predicted = Predicted(batch, r);
+        const float confidence = std::min(std::max(row[predicted], 0.0f), 1.0f);
+        const size_t bin = BinForScore(confidence, bins);
+
+        _binCounts[bin] += 1;
+        _binCorrect[bin] += predicted == static_cast<size_t>(label);
+        _binConfidence[bin] += confidence;
+        _count += 1;
+    }
+}
+
+bool CalibrationError::merge(const ClassificationMetric &other) {
+    const CalibrationError *error = dynamic_cast<const CalibrationError*>(&other);
+
+    if ( error == nullptr || error->_classes != _classes || error->bins() != bins() ) {
+        return false;
+    }
+
+    AddCounts(_binCounts, error->_binCounts);
+    AddCounts(_binCorrect, error->_binCorrect);
+
+    for ( size_t b = 0; b < _binConfidence.size(); b++ ) {
+        _binConfidence[b] += error->_binConfidence[b];
+    }
+
+    _count += error->_count;
+
+    return true;
+}
+
+std::unique_ptr<ClassificationMetric> CalibrationError::empty() const {
+    return std::unique_ptr<ClassificationMetric>(new CalibrationError(_classes, bins()));
+}
+
+void CalibrationError::report(MetricReport *report) const {
+    double expected = 0;
+    double maximum = 0;
+
+    for ( size_t b = 0; b < _binCounts.size(); b++ ) {
+        if ( _binCounts[b] == 0 ) {
+            continue;
+        }
+
+        const double n = static_cast<double>(_binCounts[b]);
+        const double gap = std::abs(static_cast<double>(_binCorrect[b]) / n - _binConfidence[b] / n);
+
+        expected += gap * n / static_cast<double>(_count);
+        maximum = std::max(maximum, gap);
+    }
+
+    report->values.push_back({"expected_calibration_error", _count == 0 ? kUndefined : expected});
+    report->values.push_back({"max_calibration_error", _count == 0 ? kUndefined : maximum});
+}
+
+// Counters are the bin counts followed by the correct counts, reals the summed confidences
+
+MetricState CalibrationError::state() const {
+    MetricState state;
+    state.count = _count;
+    state.counters = _binCounts;
+    state.counters.insert(state.counters.end(), _binCorrect.begin(), _binCorrect.end());
+    state.reals = _binConfidence;
+    return state;
+}
+
+bool CalibrationError::load(const MetricState &state) {
+    if ( state.reals.size() != bins() || !SplitCounters(state, {&_binCounts, &_binCorrect}) ) {
+        return false;
+    }
+
+    _binConfidence = state.reals;
+    _count = state.count;
+
+    return true;
+}
+
+// MARK: - MeanAveragePrecision
+
+MeanAveragePrecision::MeanAveragePrecision(size_t classes, size_t bins)
+    : ClassificationMetric(classes), _bins(bins), _positives(classes * bins, 0), _negatives(classes * bins, 0) {
+    assert(bins > 0);
+}
+
+void MeanAveragePrecision::add(const PredictionBatch &batch) {
+    assert(batch.classes == _classes);
+
+    for ( size_t r = 0; r < batch.count; r++ ) {
+        const int32_t label = batch.labels[r];
+
+        if ( !IsLabeled(label, _classes) ) {
+            continue;
+        }
+
+        // Count every score as a negative, then move the label's score to the positives
+
+        const float *row = batch.scores + r * _classes;
+
+        for ( size_t j = 0; j < _classes; j++ ) {
+            _negatives[j * _bins + BinForScore(row[j], _bins)] += 1;
+        }
+
+        const size_t cell = static_cast<size_t>(label) * _bins + BinForScore(row[label], _bins);
+        _negatives[cell] -= 1;
+        _positives[cell] += 1;
+        _count += 1;
+    }
+}
+
+bool MeanAveragePrecision::merge(const ClassificationMetric &other) {
+    const MeanAveragePrecision *precision = dynamic_cast<const MeanAveragePrecision*>(&other);
+
+    if ( precision == nullptr || precision->_classes != _classes || precision->_bins != _bins ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < _positives.size(); i++ ) {
+        _positives[i] += precision->_positives[i];
+        _negatives[i] += precision->_negatives[i];
+    }
+
+    _count += precision->_count;
+
+    return true;
+}
+
+std::unique_ptr<ClassificationMetric> MeanAveragePrecision::empty() const {
+    return std::unique_ptr<ClassificationMetric>(new MeanAveragePrecision(_classes, _bins));
+}
+
+// Counters are the positive histograms followed by the negative histograms
+
+MetricState MeanAveragePrecision::state() const {
+    MetricState state;
+    state.count = _count;
+    state.counters.reserve(_positives.size() + _negatives.size());
+    state.counters.insert(state.counters.end(), _positives.begin(), _positives.end());
+    state.counters.insert(state.counters.end(), _negatives.begin(), _negatives.end());
+    return state;
+}
+
+bool MeanAveragePrecision::load(const MetricState &state) {
+    if ( !state.reals.empty() || state.counters.size() != _positives.size() + _negatives.size() ) {
+        return false;
+    }
+
+    const size_t cells = _positives.size();
+
+    for ( size_t i = 0; i < cells; i++ ) {
+        _positives[i] = static_cast<uint32_t>(state.counters[i]);
+        _negatives[i] = static_cast<uint32_t>(state.counters[cells + i]);
+    }
+
+    _count = state.count;
+
+    return true;
+}
+
+// Sweeps the threshold down from the highest bin, adding precision at each bin that contains a
+// positive, weighted by the share of positives it recalls
+
+double MeanAveragePrecision::averagePrecision(size_t label) const {
+    const uint32_t *positives = _positives.data() + label * _bins;
+    const uint32_t *negatives = _negatives.data() + label * _bins;
+
+    uint64_t total = 0;
+    for ( size_t b = 0; b < _bins; b++ ) {
+        total += positives[b];
+    }
+
+    if ( total == 0 ) {
+        return kUndefined;
+    }
+
+    uint64_t truePositives = 0, falsePositives = 0;
+    double precision = 0;
+
+    for ( size_t b = _bins; b-- > 0; ) {
+        truePositives += positives[b];
+        falsePositives += negatives[b];
+
+        if ( positives[b] > 0 ) {
+            precision += static_cast<double>(positives[b]) / static_cast<double>(total)
+                * static_cast<double>(truePositives) / static_cast<double>(truePositives + falsePositives);
+        }
+    }
+
+    return precision;
+}
+
+void MeanAveragePrecision::report(MetricReport *report) const {
+    std::vector<double> precision(_classes);
+
+    for ( size_t c = 0; c < _classes; c++ ) {
+        precision[c] = averagePrecision(c);
+    }
+
+    report->values.push_back({"mean_average_precision", MeanOfDefined(precision)});
+    report->perClass.push_back({"average_precision", std::move(precision)});
+}
+
+// MARK: - Registry
+
+namespace {
+
+struct Registry {
+    std::mutex mutex;
+    std::map<std::string, ClassificationMetricFactory> factories;
+};
+
+Registry &SharedRegistry() {
+    static Registry *registry = [] {
+        Registry *registry = new Registry();
+
+        registry->factories["accuracy_top1"] = [](size_t classes) {
+            return std::unique_ptr<ClassificationMetric>(new TopKAccuracy(classes, 1));
+        };
+        registry->factories["accuracy_top5"] = [](size_t classes) {
+            return std::unique_ptr<ClassificationMetric>(new TopKAccuracy(classes, 5));
+        };
+        registry->factories["confusion_matrix"] = [](size_t classes) {
+            return std::unique_ptr<ClassificationMetric>(new ConfusionMatrix(classes));
+        };
+        registry->factories["calibration_error"] = [](size_t classes) {
+            return std::unique_ptr<ClassificationMetric>(new CalibrationError(classes));
+        };
+        registry->factories["mean_average_precision"] = [](size_t classes) {
+            return std::unique_ptr<ClassificationMetric>(new MeanAveragePrecision(classes));
+        };
+
+        return registry;
+    }();
+
+    return *registry;
+}
+
+// Parses "accuracy_top<k>" for any positive k, returning 0 if name is not of that form
+
+size_t TopKForName(const std::string &name) {
+    const std::string prefix = "accuracy_top";
+
+    if ( name.compare(0, prefix.size(), prefix) != 0 || name.size() == prefix.size() ) {
+        return 0;
+    }
+
+    const std::string digits = name.substr(prefix.size());
+
+    if ( digits.find_first_not_of("0123456789") != std::string::npos || digits.size() > 6 ) {
+        return 0;
+    }
+
+    return static_cast<size_t>(std::strtoul(digits.c_str(), nullptr, 10));
+}
+
+} // namespace
+
+void RegisterClassificationMetric(const std::string &name, ClassificationMetricFactory factory) {
+    Registry &registry = SharedRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.factories[name] = std::move(factory);
+}
+
+std::unique_ptr<ClassificationMetric> ClassificationMetricForName(const std::string &name, size_t classes) {
+    Registry &registry = SharedRegistry();
+    ClassificationMetricFactory factory;
+
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto entry = registry.factories.find(name);
+        if ( entry != registry.factories.end() ) {
+            factory = entry->second;
+        }
+    }
+
+    if ( factory ) {
+        return factory(classes);
+    }
+
+    if ( size_t k = TopKForName(name) ) {
+        return std::unique_ptr<ClassificationMetric>(new TopKAccuracy(classes, k));
+    }
+
+    return nullptr;
+}
+
+std::vector<std::string> ClassificationMetricNames() {
+    Registry &registry = SharedRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<std::string> names;
+
+    for ( const auto &entry : registry.factories ) {
+        names.push_back(entry.first);
+    }
+
+    return names;
+}
+
+// MARK: - ClassificationMetricSet
+
+ClassificationMetricSet::ClassificationMetricSet(size_t classes, const std::vector<std::string> &names, std::vector<std::string> *unknown)
+    : _classes(classes) {
+    for ( const std::string &name : names ) {
+        std::unique_ptr<ClassificationMetric> metric = ClassificationMetricForName(name, classes);
+
+        if ( metric == nullptr ) {
+            if ( unknown ) {
+                unknown->push_back(name);
+            }
+            continue;
+        }
+
+        _names.push_back(name);
+        _metrics.push_back(std::move(metric));
+    }
+
+    _labels.reserve(kBatchSize);
+    _scores.reserve(kBatchSize * classes);
+}
+
+void ClassificationMetricSet::add(int32_t label, const float *scores) {
+    _labels.push_back(label);
+    _scores.insert(_scores.end(), scores, scores + _classes);
+
+    if ( _labels.size() == kBatchSize ) {
+        flush();
+    }
+}
+
+void ClassificationMetricSet::add(const PredictionBatch &batch) {
+    assert(batch.classes == _classes);
+    flush();
+    dispatch(batch);
+}
+
+void ClassificationMetricSet::flush() {
+    if ( _labels.empty() ) {
+        return;
+    }
+
+    PredictionBatch batch;
+    batch.labels = _labels.data();
+    batch.scores = _scores.data();
+    batch.count = _labels.size();
+    batch.classes = _classes;
+
+    dispatch(batch);
+
+    _labels.clear();
+    _scores.clear();
+}
+
+// Finds each row's highest scoring class once for every metric that needs it
+
+void ClassificationMetricSet::dispatch(PredictionBatch batch) {
+    if ( batch.predicted == nullptr ) {
+        _predicted.resize(batch.count);
+
+        for ( size_t r = 0; r < batch.count; r++ ) {
+            _predicted[r] = static_cast<int32_t>(Argmax(batch.scores + r * _classes, _classes));
+        }
+
+        batch.predicted = _predicted.data();
+    }
+
+    for ( const std::unique_ptr<ClassificationMetric> &metric : _metrics ) {
+        metric->add(batch);
+    }
+}
+
+bool ClassificationMetricSet::merge(ClassificationMetricSet &other) {
+    if ( other._classes != _classes || other._names != _names ) {
+        return false;
+    }
+
+    flush();
+    other.flush();
+
+    for ( size_t i = 0; i < _metrics.size(); i++ ) {
+        if ( !_metrics[i]->merge(*other._metrics[i]) ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::vector<MetricState> ClassificationMetricSet::states() {
+    flush();
+
+    std::vector<MetricState> states;
+    states.reserve(_metrics.size());
+
+    for ( const std::unique_ptr<ClassificationMetric> &metric : _metrics ) {
+        states.push_back(metric->state());
+    }
+
+    return states;
+}
+
+// Every state is checked before any is merged, so that a mismatch leaves the set unchanged
+
+bool ClassificationMetricSet::mergeStates(const std::vector<MetricState> &states) {
+    if ( states.size() != _metrics.size() ) {
+        return false;
+    }
+
+    std::vector<std::unique_ptr<ClassificationMetric>> others;
+
+    for ( size_t i = 0; i < _metrics.size(); i++ ) {
+        others.push_back(_metrics[i]->empty());
+        if ( !others.back()->mergeState(states[i]) ) {
+            return false;
+        }
+    }
+
+    flush();
+
+    for ( size_t i = 0; i < _metrics.size(); i++ ) {
+        _metrics[i]->merge(*others[i]);
+    }
+
+    return true;
+}
+
+MetricReport ClassificationMetricSet::report() {
+    flush();
+
+    MetricReport report;
+
+    for ( const std::unique_ptr<ClassificationMetric> &metric : _metrics ) {
+        metric->report(&report);
+    }
+
+    return report;
+}
+
+} // namespace metrics
+} // namespace netrunner
@@ -0,0 +1,412 @@
+//
+//  ClassificationMetrics.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ClassificationMetrics_h
+#define ClassificationMetrics_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace netrunner {
+namespace metrics {
+
+/**
+ * A batch of classification predictions in columnar form: one class index per prediction in
+ * `labels` and a row of `classes` scores per prediction in `scores`, row-major.
+ *
+ * A label of -1, or any label out of range, marks an unlabeled prediction, which metrics skip.
+ * Scores are expected to be probabilities in [0,1], although only the calibration error and mean
+ * average precision depend on it.
+ *
+ * `predicted` optionally holds each row's highest scoring class, the lowest index among ties,
+ * so that metrics which need it share a single pass over the scores.
+ */
+
+struct PredictionBatch {
+    const int32_t *labels = nullptr;
+    const float *scores = nullptr;
+    const int32_t *predicted = nullptr;
+    size_t count = 0;
+    size_t classes = 0;
+};
+
+/**
+ * A cell of a confusion matrix: the number of predictions of class `predicted` whose true class
+ * was `label`.
+ */
+
+struct ConfusionEntry {
+    size_t label;
+    size_t predicted;
+    uint64_t count;
+};
+
+/**
+ * The counts behind an accuracy: the number of correct predictions out of `count`.
+ */
+
+struct AccuracyCount {
+    std::string name;
+    uint64_t correct;
+    uint64_t count;
+};
+
+/**
+ * The values computed by a metric.
+ *
+ * `values` are scalar results such as an accuracy. `perClass` are arrays with one entry per
+ * class, NaN where a value is undefined, such as the precision of a class that was never
+ * predicted. `confusion` holds the non-zero cells of a confusion matrix. `accuracies` holds the
+ * counts behind any accuracy in `values`, under the same name, which a regression test needs
+ * rather than their ratio, see RegressionGate.h.
+ */
+
+struct MetricReport {
+    std::vector<std::pair<std::string, double>> values;
+    std::vector<std::pair<std::string, std::vector<double>>> perClass;
+    std::vector<ConfusionEntry> confusion;
+    std::vector<AccuracyCount> accuracies;
+};
+
+/**
+ * A metric's counters in a plain form that may be written out by one process and merged into an
+ * accumulator in another. The layout of `counters` and `reals` is private to each metric, so a
+ * state is only understood by an accumulator of the same metric and class count.
+ */
+
+struct MetricState {
+    uint64_t count = 0;
+    std::vector<uint64_t> counters;
+    std::vector<double> reals;
+};
+
+/**
+ * A streaming classification metric.
+ *
+ * Predictions are added in columnar batches and folded into fixed-size counters, so memory does
+ * not grow with the number of predictions. Accumulators of the same metric and class count may
+ * be merged, letting shards of a dataset be evaluated independently, on separate threads or in
+ * separate processes, and combined afterwards. Accumulators are not thread-safe.
+ */
+
+class ClassificationMetric {
+public:
+    explicit ClassificationMetric(size_t classes) : _classes(classes) {}
+    virtual ~ClassificationMetric() = default;
+
+    size_t classes() const { return _classes; }
+
+    /**
+     * The number of labeled predictions added.
+     */
+
+    uint64_t count() const { return _count; }
+
+    /**
+     * Folds a batch of predictions into the accumulator. The batch's class count must match.
+     */
+
+    virtual void add(const PredictionBatch &batch) = 0;
+
+    /**
+     * Adds another accumulator's counts to this one. Returns false, leaving this accumulator
+     * unchanged, if the other accumulator is a different metric or has a different class count.
+     */
+
+    virtual bool merge(const ClassificationMetric &other) = 0;
+
+    /**
+     * A new, empty accumulator for the same metric and class count.
+     */
+
+    virtual std::unique_ptr<ClassificationMetric> empty() const = 0;
+
+    /**
+     * Appends this metric's values to the report.
+     */
+
+    virtual void report(MetricReport *report) const = 0;
+
+    /**
+     * The accumulator's counters, see MetricState.
+     */
+
+    virtual MetricState state() const = 0;
+
+    /**
+     * Adds an exported state to this accumulator, as merge does. Returns false, leaving this
+     * accumulator unchanged, if the state's layout does not match this metric's.
+     */
+
+    bool mergeState(const MetricState &state);
+
+protected:
+
+    /**
+     * Replaces the counters of an empty accumulator with those of a state. Returns false if the
+     * state's layout does not match.
+     */
+
+    virtual bool load(const MetricState &state) = 0;
+
+    const size_t _classes;
+    uint64_t _count = 0;
+};
+
+/**
+ * The fraction of predictions whose true class is among the `k` highest scores. Ties are broken
+ * in favor of the lower class index. Reported as "accuracy_top<k>".
+ *
+ * Finding a label's rank only compares its score with every other score in the row, which is
+ * a branch-free loop the compiler vectorizes, so no row is sorted.
+ */
+
+class TopKAccuracy : public ClassificationMetric {
+public:
+    TopKAccuracy(size_t classes, size_t k);
+
+    size_t k() const { return _k; }
+    uint64_t correct() const { return _correct; }
+
+    void add(const PredictionBatch &batch) override;
+    bool merge(const ClassificationMetric &other) override;
+    std::unique_ptr<ClassificationMetric> empty() const override;
+    void report(MetricReport *report) const override;
+    MetricState state() const override;
+
+protected:
+    bool load(const MetricState &state) override;
+
+private:
+    const size_t _k;
+    uint64_t _correct = 0;
+};
+
+/**
+ * A confusion matrix of true class against the highest scoring class, with per-class precision
+ * and recall and their macro averages over the classes for which they are defined. Reported as
+ * "precision" and "recall" per class, "macro_precision", "macro_recall" and the matrix itself.
+ *
+ * The matrix is dense, so it takes classes² counters: 8 MB for a thousand classes.
+ */
+
+class ConfusionMatrix : public ClassificationMetric {
+public:
+    explicit ConfusionMatrix(size_t classes);
+
+    uint64_t at(size_t label, size_t predicted) const { return _counts[label * _classes + predicted]; }
+
+    void add(const PredictionBatch &batch) override;
+    bool merge(const ClassificationMetric &other) override;
+    std::unique_ptr<ClassificationMetric> empty() const override;
+    void report(MetricReport *report) const override;
+    MetricState state() const override;
+
+protected:
+    bool load(const MetricState &state) override;
+
+private:
+    std::vector<uint64_t> _counts;
+};
+
+/**
+ * The expected calibration error of the top-1 prediction: predictions are binned by their
+ * highest score, and the gap between each bin's accuracy and mean confidence is averaged,
+ * weighted by the bin's share of predictions. Reported as "expected_calibration_error" along
+ * with "max_calibration_error", the largest gap of any non-empty bin.
+ */
+
+class CalibrationError : public ClassificationMetric {
+public:
+    CalibrationError(size_t classes, size_t bins = 15);
+
+    size_t bins() const { return _binCounts.size(); }
+
+    void add(const PredictionBatch &batch) override;
+    bool merge(const ClassificationMetric &other) override;
+    std::unique_ptr<ClassificationMetric> empty() const override;
+    void report(MetricReport *report) const override;
+    MetricState state() const override;
+
+protected:
+    bool load(const MetricState &state) override;
+
+private:
+    std::vector<uint64_t> _binCounts;
+    std::vector<uint64_t> _binCorrect;
+    std::vector<double> _binConfidence;
+};
+
+/**
+ * One-vs-rest average precision for each class and their mean over the classes that occur.
+ * Reported as "average_precision" per class and "mean_average_precision".
+ *
+ * Exact average precision requires every score to be kept and sorted. Instead each class keeps
+ * a histogram of the scores of its positive and negative predictions, and precision is read at
+ * each bin boundary, so memory is fixed and accumulators merge by addition. With the default
+ * 256 bins scores are resolved to within 0.004, and predictions whose scores share a bin are
+ * treated as tied.
+ */
+
+class MeanAveragePrecision : public ClassificationMetric {
+public:
+    MeanAveragePrecision(size_t classes, size_t bins = 256);
+
+    size_t bins() const { return _bins; }
+
+    /**
+     * The average precision of a single class, NaN if the class never occurred.
+     */
+
+    double averagePrecision(size_t label) const;
+
+    void add(const PredictionBatch &batch) override;
+    bool merge(const ClassificationMetric &other) override;
+    std::unique_ptr<ClassificationMetric> empty() const override;
+    void report(MetricReport *report) const override;
+    MetricState state() const override;
+
+protected:
+    bool load(const MetricState &state) override;
+
+private:
+    const size_t _bins;
+
+    // classes x bins, row-major by class
+
+    std::vector<uint32_t> _positives;
+    std::vector<uint32_t> _negatives;
+};
+
+// MARK: - Registry
+
+using ClassificationMetricFactory = std::function<std::unique_ptr<ClassificationMetric>(size_t classes)>;
+
+/**
+ * Registers a metric under a name, replacing any metric already registered under that name.
+ *
+ * The built-in metrics are "accuracy_top1", "accuracy_top5", "confusion_matrix",
+ * "calibration_error" and "mean_average_precision". Any "accuracy_top<k>" is also understood.
+ */
+
+void RegisterClassificationMetric(const std::string &name, ClassificationMetricFactory factory);
+
+/**
+ * A new accumulator for the metric registered under name, or nullptr for an unknown name.
+ */
+
+std::unique_ptr<ClassificationMetric> ClassificationMetricForName(const std::string &name, size_t classes);
+
+/**
+ * The names of the registered metrics, sorted.
+ */
+
+std::vector<std::string> ClassificationMetricNames();
+
+// MARK: - Metric Set
+
+/**
+ * A set of named metrics fed from a single stream of predictions.
+ *
+ * Predictions may be added one at a time; they are staged in columnar buffers and handed to
+ * the metrics a batch at a time, so each metric runs its inner loops over many rows at once.
+ */
+
+class ClassificationMetricSet {
+public:
+    static const size_t kBatchSize = 256;
+
+    /**
+     * Creates the named metrics. Unknown names are skipped and, if `unknown` is given, appended
+     * to it.
+     */
+
+    ClassificationMetricSet(size_t classes, const std::vector<std::string> &names, std::vector<std::string> *unknown = nullptr);
+
+    ClassificationMetricSet(const ClassificationMetricSet&) = delete;
+    ClassificationMetricSet& operator=(const ClassificationMetricSet&) = delete;
+
+    size_t classes() const { return _classes; }
+    const std::vector<std::string> &names() const { return _names; }
+
+    /**
+     * Stages a single prediction. `scores` must hold `classes()` values.
+     */
+
+    void add(int32_t label, const float *scores);
+
+    /**
+     * Flushes staged predictions and hands a batch directly to every metric.
+     */
+
+    void add(const PredictionBatch &batch);
+
+    /**
+     * Merges another set with the same metrics and class count. Returns false otherwise.
+     */
+
+    bool merge(ClassificationMetricSet &other);
+
+    /**
+     * Flushes staged predictions and exports every metric's state, in the order they were named.
+     */
+
+    std::vector<MetricState> states();
+
+    /**
+     * Merges the states exported by a set with the same metrics and class count. Returns false,
+     * leaving every metric unchanged, if the number or layout of the states does not match.
+     */
+
+    bool mergeStates(const std::vector<MetricState> &states);
+
+    /**
+     * Flushes staged predictions and reports every metric, in the order they were named.
+     */
+
+    MetricReport report();
+
+    /**
+     * Hands any staged predictions to the metrics.
+     */
+
+    void flush();
+
+private:
+    void dispatch(PredictionBatch batch);
+
+    const size_t _classes;
+    std::vector<std::string> _names;
+    std::vector<std::unique_ptr<ClassificationMetric>> _metrics;
+
+    std::vector<int32_t> _labels;
+    std::vector<float> _scores;
+    std::vector<int32_t> _predicted;
+};
+
+} // namespace metrics
+} // namespace netrunner
+
+#endif /* ClassificationMetrics_h */
@@ -0,0 +1,195 @@
+//
+//  DetectionMetrics.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DetectionMetrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace netrunner {
+namespace metrics {
+
+namespace {
+
+constexpr double kUndefined = std::numeric_limits<double>::quiet_NaN();
+
+double IntersectionOverUnion(const float *a, const float *b) {
+    const double areaA = (a[2] - a[0]) * (a[3] - a[1]);
+    const double areaB = (b[2] - b[0]) * (b[3] - b[1]);
+
+    if ( areaA <= 0 || areaB <= 0 ) {
+        return 0;
+    }
+
+    const double height = std::max(0.0f, std::min(a[2], b[2]) - std::max(a[0], b[0]));
+    const double width = std::max(0.0f, std::min(a[3], b[3]) - std::max(a[1], b[1]));
+    const double intersection = height * width;
+
+    return intersection / (areaA + areaB - intersection);
+}
+
+} // namespace
+
+void MatchDetections(const std::vector<LabeledBox> &truth, const std::vector<LabeledBox> &detections, float iouThreshold, std::vector<bool> *matched) {
+    std::vector<size_t> order(detections.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return detections[a].score > detections[b].score;
+    });
+
+    std::vector<bool> taken(truth.size(), false);
+    matched->assign(detections.size(), false);
+
+    for ( size_t i : order ) {
+        const LabeledBox &detection = detections[i];
+        double best = iouThreshold;
+        size_t match = truth.size();
+
+        for ( size_t j = 0; j < truth.size(); j++ ) {
+            if ( taken[j] || truth[j].label != detection.label ) {
+                continue;
+            }
+            double iou = IntersectionOverUnion(truth[j].box, detection.box);
+            if ( iou >= best ) {
+                best = iou;
+                match = j;
+            }
+        }
+
+        if ( match < truth.size() ) {
+            taken[match] = true;
+            (*matched)[i] = true;
+        }
+    }
+}
+
+void DetectionAveragePrecision::add(const std::vector<LabeledBox> &truth, const std::vector<LabeledBox> &detections, float iouThreshold) {
+    std::vector<bool> matched;
+    MatchDetections(truth, detections, iouThreshold, &matched);
+
+    for ( const LabeledBox &box : truth ) {
+        addTruth(box.label, 1);
+    }
+    for ( size_t i = 0; i < detections.size(); i++ ) {
+        addDetection(detections[i].label, detections[i].score, matched[i]);
+    }
+}
+
+void DetectionAveragePrecision::addDetection(const std::string &label, float score, bool matched) {
+    Count &count = _classes[label].scores[score];
+    count.detections += 1;
+    count.matches += matched ? 1 : 0;
+}
+
+void DetectionAveragePrecision::addTruth(const std::string &label, uint64_t count) {
+    _classes[label].truth += count;
+}
+
+std::vector<DetectionAveragePrecision::ClassState> DetectionAveragePrecision::states() const {
+    std::vector<ClassState> states;
+    states.reserve(_classes.size());
+
+    for ( const auto &entry : _classes ) {
+        ClassState state;
+        state.label = entry.first;
+        state.truth = entry.second.truth;
+        state.scores.reserve(entry.second.scores.size());
+
+        for ( const auto &score : entry.second.scores ) {
+            state.scores.push_back({score.first, score.second.detections, score.second.matches});
+        }
+
+        states.push_back(std::move(state));
+    }
+
+    return states;
+}
+
+bool DetectionAveragePrecision::mergeStates(const std::vector<ClassState> &states) {
+    for ( const ClassState &state : states ) {
+        for ( const ScoreCount &score : state.scores ) {
+            if ( score.matches > score.detections || std::isnan(score.score) ) {
+                return false;
+            }
+        }
+    }
+
+    for ( const ClassState &state : states ) {
+        Class &entry = _classes[state.label];
+        entry.truth += state.truth;
+
+        for ( const ScoreCount &score : state.scores ) {
+            Count &count = entry.scores[score.score];
+            count.detections += score.detections;
+            count.matches += score.matches;
+        }
+    }
+
+    return true;
+}
+
+double DetectionAveragePrecision::averagePrecision(const std::string &label) const {
+    auto entry = _classes.find(label);
+
+    if ( entry == _classes.end() || entry->second.truth == 0 ) {
+        return kUndefined;
+    }
+
+    const double truth = static_cast<double>(entry->second.truth);
+    uint64_t truePositives = 0, falsePositives = 0;
+    double precision = 0;
+
+    // Scores are kept in descending order, and each score's tied detections are one step of the
+    // precision-recall curve
+
+    for ( const auto &score : entry->second.scores ) {
+        const uint64_t matches = score.second.matches;
+
+        truePositives += matches;
+        falsePositives += score.second.detections - matches;
+
+        if ( matches > 0 ) {
+            precision += static_cast<double>(matches) / truth
+                * static_cast<double>(truePositives) / static_cast<double>(truePositives + falsePositives);
+        }
+    }
+
+    return precision;
+}
+
+double DetectionAveragePrecision::meanAveragePrecision() const {
+    double sum = 0;
+    size_t count = 0;
+
+    for ( const auto &entry : _classes ) {
+        double precision = averagePrecision(entry.first);
+        if ( !std::isnan(precision) ) {
+            sum += precision;
+            count += 1;
+        }
+    }
+
+    return count == 0 ? kUndefined : sum / static_cast<double>(count);
+}
+
+} // namespace metrics
+} // namespace netrunner
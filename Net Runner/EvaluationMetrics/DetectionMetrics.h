@@ -0,0 +1,153 @@
+//
+//  DetectionMetrics.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DetectionMetrics_h
+#define DetectionMetrics_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace netrunner {
+namespace metrics {
+
+/**
+ * A ground truth or detected box: its class, its score, which is ignored for ground truth, and
+ * its corners ordered ymin, xmin, ymax, xmax.
+ */
+
+struct LabeledBox {
+    std::string label;
+    float score;
+    float box[4];
+};
+
+/**
+ * Matches an image's detections to its ground truth boxes the way PASCAL VOC does. Detections are
+ * visited in descending score order and each is matched to the unmatched ground truth box of its
+ * class with which it has the greatest intersection over union, if that is at least the
+ * threshold. Sets one flag per detection, in the order given, true for a match.
+ */
+
+void MatchDetections(const std::vector<LabeledBox> &truth, const std::vector<LabeledBox> &detections, float iouThreshold, std::vector<bool> *matched);
+
+/**
+ * The average precision of each class's detections and their mean over the classes that have
+ * ground truth boxes. Reported as "mean_average_precision".
+ *
+ * Unlike the classification metric of the same name, detections are counted at their exact
+ * scores, so average precision is exact: the precision at each true positive, in descending
+ * score order, averaged over the class's ground truth boxes. Detections that share a score are
+ * treated as tied, which is why counting them together loses nothing. Ground truth boxes that
+ * are never detected count against recall.
+ *
+ * The counts are exported as one state per class, which merges into another instance, so that
+ * the shards of a test bundle may be evaluated separately, see EvaluationShard.h.
+ */
+
+class DetectionAveragePrecision {
+public:
+
+    /**
+     * The detections and true positives at a score.
+     */
+
+    struct ScoreCount {
+        float score;
+        uint64_t detections;
+        uint64_t matches;
+    };
+
+    /**
+     * A class's ground truth boxes and its detections, in descending score order.
+     */
+
+    struct ClassState {
+        std::string label;
+        uint64_t truth;
+        std::vector<ScoreCount> scores;
+    };
+
+    /**
+     * Adds an image's ground truth and detections, matched at the given threshold.
+     */
+
+    void add(const std::vector<LabeledBox> &truth, const std::vector<LabeledBox> &detections, float iouThreshold);
+
+    /**
+     * Adds a detection that has already been matched.
+     */
+
+    void addDetection(const std::string &label, float score, bool matched);
+
+    /**
+     * Adds ground truth boxes of a class.
+     */
+
+    void addTruth(const std::string &label, uint64_t count);
+
+    /**
+     * The state of every class with ground truth boxes or detections, ordered by label.
+     */
+
+    std::vector<ClassState> states() const;
+
+    /**
+     * Adds the counts of another instance's class states. Returns false and merges nothing if
+     * a state counts more true positives than detections at a score.
+     */
+
+    bool mergeStates(const std::vector<ClassState> &states);
+
+    /**
+     * The average precision of a class, NaN if it has no ground truth boxes.
+     */
+
+    double averagePrecision(const std::string &label) const;
+
+    /**
+     * The mean of the average precisions of the classes with ground truth boxes, NaN if there
+     * are none.
+     */
+
+    double meanAveragePrecision() const;
+
+private:
+    struct Count {
+        uint64_t detections = 0;
+        uint64_t matches = 0;
+    };
+
+    struct Class {
+        std::map<float, Count, std::greater<float>> scores;
+        uint64_t truth = 0;
+    };
+
+    std::map<std::string, Class> _classes;
+};
+
+} // namespace metrics
+} // namespace netrunner
+
+#endif /* DetectionMetrics_h */
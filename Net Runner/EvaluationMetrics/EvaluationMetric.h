@@ -22,40 +22,82 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
-@protocol EvaluationMetric <NSObject>
+/**
+ * The running state of a metric's values over a model's results, which an
+ * `EvaluationSummaryAccumulator` keeps in place of the results themselves.
+ *
+ * The state is written to partial summaries, from which the command line runner merges the
+ * shards of a test bundle, so it must be a JSON object that the command line runner's
+ * `MetricAccumulator` for the same metric reads, see ModelSummary.h.
+ */
+
+@protocol EvaluationMetricAccumulator <NSObject>
 
 /**
- * Produce a set of evaluation metrics given the known output y and the predicted output yhat.
- * The metrics may consist of and be organized by whatever scheme is appropriate.
- * It is up to you how you would like to use these metrics
+ * Folds the metrics returned by `evaluate:yhat:` for a single result into the state.
+ */
+
+- (void)add:(NSDictionary<NSString*,id>*)metrics;
+
+/**
+ * The state, as a partial summary keeps it.
+ */
+
+- (NSDictionary<NSString*,id>*)state;
+
+/**
+ * Reduces the state to the aggregate metrics.
  *
- * For example, for an RMSE error, this function could return the individual error term for this example:
+ * For example, for an RMSE error, an accumulator could keep the sum of the individual squared
+ * error terms and their count, and divide one by the other, taking the square root for the final
+ * value:
  *
  * @code
  * @{
- *   @"RMSE: (yhat-y)^2
+ *   @"RMSE: sqrt(sum/count)
  * }
  * @endcode
  *
  */
 
-- (NSDictionary<NSString*,NSNumber*>*)evaluate:(NSDictionary<NSString*,id>*)y yhat:(NSDictionary<NSString*,id>*)yhat;
+- (NSDictionary<NSString*,NSNumber*>*)reduce;
+
+@optional
+
+/**
+ * The correct and total counts behind each aggregate metric that is an accuracy, as
+ * @{ name: @{ @"correct": correct, @"count": count } }.
+ */
+
+- (NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*>*)accuracyCounts;
+
+@end
+
+@protocol EvaluationMetric <NSObject>
 
 /**
- * Given a set of individual evaluation metrics, return the aggregate metrics.
+ * Produce a set of evaluation metrics given the known output y and the predicted output yhat.
+ * The metrics may consist of and be organized by whatever scheme is appropriate.
+ * It is up to you how you would like to use these metrics
  *
- * For example, for an RMSE error, this function could sum the individual squared error terms
- * and then divide by the number of terms, taking the square root for the final value:
+ * For example, for an RMSE error, this function could return the individual error term for this example:
  *
  * @code
  * @{
- *   @"RMSE: sqrt(sum(individual_rmse)/count)
+ *   @"RMSE: (yhat-y)^2
  * }
  * @endcode
  *
  */
 
-- (NSDictionary<NSString*,NSNumber*>*)reduce:(NSArray<NSDictionary<NSString*,NSNumber*>*>*)metrics;
+- (NSDictionary<NSString*,NSNumber*>*)evaluate:(NSDictionary<NSString*,id>*)y yhat:(NSDictionary<NSString*,id>*)yhat;
+
+/**
+ * An empty accumulator, into which the metrics of a model's results are folded and from which
+ * the aggregate metrics are reduced.
+ */
+
+- (id<EvaluationMetricAccumulator>)accumulator;
 
 @end
 
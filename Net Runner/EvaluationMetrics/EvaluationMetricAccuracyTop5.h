@@ -27,7 +27,8 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * The Top5 Accuracy metric returns 1 if the expected classification y is contained in
  * the top five hypothesized classifications yhat, and 0 otherwise. The reduced value
- * is the percentage of correct classifications.
+ * is the percentage of correct classifications, which its `EvaluationMetricMeanAccumulator`
+ * computes from running counts.
  */
 
 @interface EvaluationMetricAccuracyTop5 : NSObject <EvaluationMetric>
@@ -44,14 +45,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (NSDictionary<NSString*,NSNumber*>*)evaluate:(NSDictionary<NSString*,id>*)y yhat:(NSDictionary<NSString*,id>*)yhat;
 
 /**
- * The percentage of correct classifications
- *
- * @param metrics An array of results from calling `evaluate:yhat:`
- *
- * @return `NSDictionary` with a single `@"accuracy"` key whose value is the percentage of correct classifications.
+ * An accumulator whose reduced `@"classification_accuracy"` is the percentage of correct
+ * classifications, with its correct and total counts.
  */
 
-- (NSDictionary<NSString*,NSNumber*>*)reduce:(NSArray<NSDictionary<NSString*,NSNumber*>*>*)metrics;
+- (id<EvaluationMetricAccumulator>)accumulator;
 
 @end
 
@@ -20,6 +20,8 @@
 
 #import "EvaluationMetricAccuracyTop5.h"
 
+#import "EvaluationMetricMeanAccumulator.h"
+
 @import TensorIO;
 
 static NSString * const kClassificationOutputKey = @"classification";
@@ -43,19 +45,8 @@ static NSString * const kClassificationOutputKey = @"classification";
     return 0;
 }
 
-- (NSDictionary<NSString*,NSNumber*>*)reduce:(NSArray<NSDictionary<NSString*,NSNumber*>*>*)metrics {
-    NSNumber *total =
-        [[metrics
-        map:^id _Nonnull(NSDictionary * _Nonnull obj) {
-            return obj[@"classification_accuracy"];
-        }]
-        reduce:@(0) combine:^id _Nonnull(NSNumber * _Nonnull accumulator, NSNumber * _Nonnull item) {
-            return @(accumulator.integerValue + item.integerValue);
-        }];
-    
-    return @{
-        @"classification_accuracy": @((float)total.integerValue / (float)metrics.count)
-    };
+- (id<EvaluationMetricAccumulator>)accumulator {
+    return [[EvaluationMetricMeanAccumulator alloc] init];
 }
 
 @end
@@ -0,0 +1,41 @@
+//
+//  EvaluationMetricMeanAccumulator.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+#import "EvaluationMetric.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * An accumulator for metrics whose aggregate is the mean of their per-result values. It keeps the
+ * count and sum of every numeric value, and reduces each to its mean. A value that is 0 or 1 for
+ * every result is an accuracy, whose correct count is kept and reported as well. See
+ * MetricTotals.h.
+ *
+ * The state is a dictionary of @{ @"count", @"sum", @"correct" } totals keyed by value name,
+ * without @"correct" once a value was other than 0 or 1.
+ */
+
+@interface EvaluationMetricMeanAccumulator : NSObject <EvaluationMetricAccumulator>
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,81 @@
+//
+//  EvaluationMetricMeanAccumulator.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationMetricMeanAccumulator.h"
+
+#include "MetricTotals.h"
+
+using namespace netrunner::metrics;
+
+@implementation EvaluationMetricMeanAccumulator {
+    MetricTotals _totals;
+}
+
+- (void)add:(NSDictionary<NSString*,id>*)metrics {
+    for ( NSString *name in metrics ) {
+        id value = metrics[name];
+        if ( [value isKindOfClass:NSNumber.class] ) {
+            _totals.add(name.UTF8String, [value doubleValue]);
+        }
+    }
+}
+
+- (NSDictionary<NSString*,id>*)state {
+    NSMutableDictionary<NSString*,id> *state = [[NSMutableDictionary alloc] init];
+    
+    for ( const auto &entry : _totals.totals() ) {
+        NSMutableDictionary<NSString*,NSNumber*> *total = [[NSMutableDictionary alloc] init];
+        total[@"count"] = @(entry.second.count);
+        total[@"sum"] = @(entry.second.sum);
+        if ( entry.second.binary ) {
+            total[@"correct"] = @(entry.second.correct);
+        }
+        state[@(entry.first.c_str())] = total.copy;
+    }
+    
+    return state.copy;
+}
+
+- (NSDictionary<NSString*,NSNumber*>*)reduce {
+    NSMutableDictionary<NSString*,NSNumber*> *reduced = [[NSMutableDictionary alloc] init];
+    
+    for ( const auto &entry : _totals.totals() ) {
+        reduced[@(entry.first.c_str())] = @((float)_totals.mean(entry.first));
+    }
+    
+    return reduced.copy;
+}
+
+- (NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*>*)accuracyCounts {
+    NSMutableDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *counts = [[NSMutableDictionary alloc] init];
+    
+    for ( const auto &entry : _totals.totals() ) {
+        if ( entry.second.binary ) {
+            counts[@(entry.first.c_str())] = @{
+                @"correct": @(entry.second.correct),
+                @"count": @(entry.second.count)
+            };
+        }
+    }
+    
+    return counts.copy;
+}
+
+@end
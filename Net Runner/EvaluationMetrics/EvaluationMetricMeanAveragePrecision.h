@@ -0,0 +1,64 @@
+//
+//  EvaluationMetricMeanAveragePrecision.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+#import "EvaluationMetric.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The Mean Average Precision metric for detection models. Detections are matched to the expected
+ * boxes of their class at an intersection over union of 0.5, and the reduced value is the mean
+ * of each class's average precision over every image. See DetectionMetrics.h.
+ *
+ * Expected and produced outputs list their boxes under a "detections" key, as a
+ * `PostProcessedModelOutput` does, with boxes ordered ymin, xmin, ymax, xmax:
+ *
+ * @code
+ * { "detections": [ { "class": "dog", "score": 0.87, "box": [0.1, 0.2, 0.5, 0.6] }, ... ] }
+ * @endcode
+ */
+
+@interface EvaluationMetricMeanAveragePrecision : NSObject <EvaluationMetric>
+
+/**
+ * Matches the detections in yhat to the expected boxes in y.
+ *
+ * @param y The expected detections, whose scores are ignored.
+ * @param yhat The produced detections.
+ *
+ * @return `NSDictionary` with a `@"detections"` key listing each detection's class, score and
+ * whether it matched, and a `@"ground_truth"` key counting the expected boxes of each class.
+ */
+
+- (NSDictionary<NSString*,id>*)evaluate:(NSDictionary<NSString*,id>*)y yhat:(NSDictionary<NSString*,id>*)yhat;
+
+/**
+ * An accumulator that counts detections and true positives at each score of every class, whose
+ * reduced `@"mean_average_precision"` is the mean average precision over every image, 0 if no
+ * boxes were expected.
+ */
+
+- (id<EvaluationMetricAccumulator>)accumulator;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,177 @@
+//
+//  EvaluationMetricMeanAveragePrecision.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationMetricMeanAveragePrecision.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "DetectionMetrics.h"
+
+using namespace netrunner::metrics;
+
+static NSString * const kDetectionsOutputKey = @"detections";
+static NSString * const kGroundTruthKey = @"ground_truth";
+static NSString * const kMeanAveragePrecisionKey = @"mean_average_precision";
+
+static const float kIntersectionOverUnionThreshold = 0.5f;
+
+// Classes are labels, or indexes when the model's stages do not apply labels
+
+static std::string Label(id value) {
+    if ( [value isKindOfClass:NSString.class] ) {
+        return [value UTF8String];
+    }
+    if ( [value isKindOfClass:NSNumber.class] ) {
+        return [value stringValue].UTF8String;
+    }
+    return "";
+}
+
+static std::vector<LabeledBox> Boxes(NSArray *list) {
+    std::vector<LabeledBox> boxes;
+    
+    if ( ![list isKindOfClass:NSArray.class] ) {
+        return boxes;
+    }
+    
+    for ( NSDictionary *entry in list ) {
+        if ( ![entry isKindOfClass:NSDictionary.class] ) {
+            continue;
+        }
+        
+        NSArray<NSNumber*> *box = entry[@"box"];
+        
+        if ( ![box isKindOfClass:NSArray.class] || box.count != 4 ) {
+            continue;
+        }
+        
+        LabeledBox labeled;
+        labeled.label = Label(entry[@"class"]);
+        labeled.score = [entry[@"score"] floatValue];
+        for ( NSUInteger i = 0; i < 4; i++ ) {
+            labeled.box[i] = box[i].floatValue;
+        }
+        boxes.push_back(labeled);
+    }
+    
+    return boxes;
+}
+
+// MARK: -
+
+/**
+ * Counts detections and true positives at each score of every class. The state lists the classes
+ * under "classes", each with its "label", "ground_truth" count and [score, detections, matches]
+ * "scores" in descending score order.
+ */
+
+@interface EvaluationMetricMeanAveragePrecisionAccumulator : NSObject <EvaluationMetricAccumulator>
+
+@end
+
+@implementation EvaluationMetricMeanAveragePrecisionAccumulator {
+    DetectionAveragePrecision _precision;
+}
+
+- (void)add:(NSDictionary<NSString*,id>*)metrics {
+    for ( NSArray *detection in metrics[kDetectionsOutputKey] ) {
+        _precision.addDetection(Label(detection[0]), [detection[1] floatValue], [detection[2] boolValue]);
+    }
+    
+    NSDictionary<NSString*,NSNumber*> *groundTruth = metrics[kGroundTruthKey];
+    
+    for ( NSString *label in groundTruth ) {
+        _precision.addTruth(label.UTF8String, groundTruth[label].unsignedLongLongValue);
+    }
+}
+
+- (NSDictionary<NSString*,id>*)state {
+    std::vector<DetectionAveragePrecision::ClassState> states = _precision.states();
+    NSMutableArray<NSDictionary*> *classes = [[NSMutableArray alloc] initWithCapacity:states.size()];
+    
+    for ( const DetectionAveragePrecision::ClassState &state : states ) {
+        NSMutableArray<NSArray<NSNumber*>*> *scores = [[NSMutableArray alloc] initWithCapacity:state.scores.size()];
+        
+        for ( const DetectionAveragePrecision::ScoreCount &score : state.scores ) {
+            [scores addObject:@[@(score.score), @(score.detections), @(score.matches)]];
+        }
+        
+        [classes addObject:@{
+            @"label": @(state.label.c_str()),
+            kGroundTruthKey: @(state.truth),
+            @"scores": scores.copy
+        }];
+    }
+    
+    return @{
+        @"classes": classes.copy
+    };
+}
+
+- (NSDictionary<NSString*,NSNumber*>*)reduce {
+    double mean = _precision.meanAveragePrecision();
+    
+    return @{
+        kMeanAveragePrecisionKey: @(std::isnan(mean) ? 0 : mean)
+    };
+}
+
+@end
+
+// MARK: -
+
+@implementation EvaluationMetricMeanAveragePrecision
+
+- (NSDictionary<NSString*,id>*)evaluate:(NSDictionary<NSString*,id>*)y yhat:(NSDictionary<NSString*,id>*)yhat {
+    std::vector<LabeledBox> truth = Boxes(y[kDetectionsOutputKey]);
+    std::vector<LabeledBox> detections = Boxes(yhat[kDetectionsOutputKey]);
+    std::vector<bool> matched;
+    
+    MatchDetections(truth, detections, kIntersectionOverUnionThreshold, &matched);
+    
+    NSMutableArray *matches = [[NSMutableArray alloc] initWithCapacity:detections.size()];
+    NSMutableDictionary<NSString*,NSNumber*> *groundTruth = [[NSMutableDictionary alloc] init];
+    
+    for ( size_t i = 0; i < detections.size(); i++ ) {
+        [matches addObject:@[
+            [NSString stringWithUTF8String:detections[i].label.c_str()],
+            @(detections[i].score),
+            @(matched[i] ? 1 : 0)
+        ]];
+    }
+    
+    for ( const LabeledBox &box : truth ) {
+        NSString *label = [NSString stringWithUTF8String:box.label.c_str()];
+        groundTruth[label] = @(groundTruth[label].integerValue + 1);
+    }
+    
+    return @{
+        kDetectionsOutputKey: matches.copy,
+        kGroundTruthKey: groundTruth.copy
+    };
+}
+
+- (id<EvaluationMetricAccumulator>)accumulator {
+    return [[EvaluationMetricMeanAveragePrecisionAccumulator alloc] init];
+}
+
+@end
@@ -0,0 +1,61 @@
+//
+//  MetricTotals.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "MetricTotals.h"
+
+namespace netrunner {
+namespace metrics {
+
+void MetricTotals::add(const std::string &name, double value) {
+    Total &total = _totals[name];
+
+    total.count += 1;
+    total.sum += value;
+    total.binary = total.binary && (value == 0 || value == 1);
+    total.correct = total.binary ? total.correct + (value == 1 ? 1 : 0) : 0;
+}
+
+bool MetricTotals::merge(const std::string &name, const Total &total) {
+    if ( total.binary && total.correct > total.count ) {
+        return false;
+    }
+
+    Total &into = _totals[name];
+
+    into.count += total.count;
+    into.sum += total.sum;
+    into.binary = into.binary && total.binary;
+    into.correct = into.binary ? into.correct + total.correct : 0;
+
+    return true;
+}
+
+double MetricTotals::mean(const std::string &name) const {
+    auto entry = _totals.find(name);
+
+    if ( entry == _totals.end() || entry->second.count == 0 ) {
+        return 0;
+    }
+
+    return entry->second.sum / static_cast<double>(entry->second.count);
+}
+
+} // namespace metrics
+} // namespace netrunner
@@ -0,0 +1,86 @@
+//
+//  MetricTotals.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef MetricTotals_h
+#define MetricTotals_h
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace netrunner {
+namespace metrics {
+
+/**
+ * Running totals of the named values an evaluation metric returns for each result, from which
+ * their means are reduced, as `EvaluationMetricAccuracyTop5` does.
+ *
+ * A value that is 0 or 1 for every result is an accuracy, whose correct count is kept as well so
+ * that summaries may report it under "accuracy_counts". Totals merge, so that the shards of a
+ * test bundle may be evaluated separately, see EvaluationShard.h.
+ */
+
+class MetricTotals {
+public:
+
+    /**
+     * The totals of one value. Correct counts the results whose value was 1 while binary is true.
+     */
+
+    struct Total {
+        uint64_t count = 0;
+        double sum = 0;
+        bool binary = true;
+        uint64_t correct = 0;
+    };
+
+    /**
+     * Adds one result's value.
+     */
+
+    void add(const std::string &name, double value);
+
+    /**
+     * Adds the totals of another instance's value. Returns false and merges nothing if the
+     * totals are inconsistent.
+     */
+
+    bool merge(const std::string &name, const Total &total);
+
+    /**
+     * The mean of a value over the results that returned it, 0 if none did.
+     */
+
+    double mean(const std::string &name) const;
+
+    /**
+     * The totals of every value, ordered by name.
+     */
+
+    const std::map<std::string, Total> &totals() const { return _totals; }
+
+private:
+    std::map<std::string, Total> _totals;
+};
+
+} // namespace metrics
+} // namespace netrunner
+
+#endif /* MetricTotals_h */
@@ -30,11 +30,27 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern NSString * const NRModelManagerDidDeleteModelNotification;
 
+/**
+ * Notification posted when the model bundles have been loaded, including each time they are
+ * reloaded. State cached for a model, such as its compiled post-processing, may be stale after it.
+ */
+
+extern NSString * const NRModelManagerDidLoadModelsNotification;
+
 @class TIOModelBundle;
+@class ModelBundleHeader;
 
 /**
- * Wraps the `TIOModelBundleManager` to provide application specific functionality
- * such as model location and deleting models.
+ * Loads the model bundles in the models directory and provides application specific
+ * functionality such as model location and deleting models.
+ *
+ * Bundles are discovered in parallel, and a manifest of every bundle's fingerprint is kept
+ * between launches so that only bundles that are new or have changed are parsed to validate
+ * them. Bundles already loaded are reused when the directory is reloaded, e.g. after a model is
+ * imported or deleted. See BundleManifest.h.
+ *
+ * Models are listed by their headers, which come from the manifest. A bundle's layer descriptions
+ * and labels are only loaded when the bundle itself is requested. See ModelBundleHeader.h.
  */
 
 @interface ModelManager : NSObject
@@ -69,6 +85,49 @@ extern NSString * const NRModelManagerDidDeleteModelNotification;
 
 - (NSString*)modelsPath;
 
+// MARK: - Model Bundles
+
+/**
+ * Headers for the valid model bundles in the models directory, sorted by name. Use these to list
+ * models and access a header's `bundle` once a model has been chosen.
+ *
+ * You must call `loadModelBundlesAtPath:error:` before accessing this property.
+ */
+
+@property (readonly) NSArray<ModelBundleHeader*> *modelHeaders;
+
+/**
+ * Loads the model bundles at path, which replace any bundles already loaded. Bundles that are
+ * unchanged since they were last loaded are not parsed again.
+ *
+ * @param path The directory containing .tiobundle folders
+ * @param error Set if the directory cannot be read or contains no valid bundles
+ *
+ * @return BOOL `YES` if at least one bundle is loaded, `NO` otherwise
+ */
+
+- (BOOL)loadModelBundlesAtPath:(NSString*)path error:(NSError**)error;
+
+/**
+ * Returns the header for the bundle with the specified identifier, or `nil`. Constant time.
+ */
+
+- (nullable ModelBundleHeader*)headerWithId:(NSString*)modelId;
+
+/**
+ * Returns the bundle with the specified identifier, or `nil`. The bundle is parsed the first time
+ * it is requested.
+ */
+
+- (nullable TIOModelBundle*)bundleWithId:(NSString*)modelId;
+
+/**
+ * Returns the bundles with the specified identifiers, in the order of the identifiers.
+ * Identifiers without a bundle are skipped.
+ */
+
+- (NSArray<TIOModelBundle*>*)bundlesWithIds:(NSArray<NSString*>*)modelIds;
+
 /**
  * Deletes the specified model, removing it from the file system
  *
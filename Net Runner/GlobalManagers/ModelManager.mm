@@ -21,10 +21,84 @@
 #import "ModelManager.h"
 
 #import "UserDefaults.h"
+#import "ModelBundleHeader.h"
+
+#include <string>
+#include <vector>
+
+#include "BundleManifest.h"
 
 @import TensorIO;
 
+using namespace netrunner::bundles;
+
 NSString * const NRModelManagerDidDeleteModelNotification = @"NRModelManagerDidDeleteModelNotification";
+NSString * const NRModelManagerDidLoadModelsNotification = @"NRModelManagerDidLoadModelsNotification";
+
+static NSString * const kBundleManifestFilename = @"model-bundles.manifest";
+
+// MARK: - Errors
+
+static NSString * const NetRunnerModelManagerErrorDomain = @"ai.doc.net-runner.model-manager";
+
+static const NSInteger NetRunnerModelManagerReadErrorCode = 101;
+static const NSInteger NetRunnerModelManagerNoValidModelBundlesErrorCode = 102;
+
+NSError * NetRunnerModelManagerReadError(NSString *path, NSString *description);
+NSError * NetRunnerModelManagerNoValidModelBundlesError(NSString *path);
+
+// MARK: -
+
+/**
+ * Identifies a loaded header by its bundle's path and fingerprint, so that it, and the bundle it
+ * may have materialized, are only reused while the bundle on disk is unchanged.
+ */
+
+static NSString * BundleCacheKey(const BundleRecord &record) {
+    return [NSString stringWithFormat:@"%s:%lld:%llu", record.path.c_str(), (long long)record.modified, (unsigned long long)record.fingerprint];
+}
+
+/**
+ * Describes a bundle's inputs for its header from their descriptions in model.json, e.g.
+ * "image 224x224x3", reading image shapes as TensorIO does, with an optional batch dimension.
+ */
+
+static NSString * InputSummary(id inputs) {
+    NSMutableArray<NSString*> *summaries = [[NSMutableArray alloc] init];
+    
+    for ( NSDictionary *input in ([inputs isKindOfClass:NSArray.class] ? inputs : @[]) ) {
+        if ( ![input isKindOfClass:NSDictionary.class] ) {
+            continue;
+        }
+        
+        NSString *type = [input[@"type"] isKindOfClass:NSString.class] ? input[@"type"] : nil;
+        NSArray *shape = [input[@"shape"] isKindOfClass:NSArray.class] ? input[@"shape"] : @[];
+        
+        if ( [type isEqualToString:@"image"] ) {
+            NSArray *volume = shape;
+            if ( shape.count == 4 && [shape.firstObject integerValue] == -1 ) {
+                volume = [shape subarrayWithRange:NSMakeRange(1, 3)];
+            } else if ( shape.count == 4 && [shape.lastObject integerValue] == -1 ) {
+                volume = [shape subarrayWithRange:NSMakeRange(0, 3)];
+            }
+            [summaries addObject:[NSString stringWithFormat:@"image %@", [volume componentsJoinedByString:@"x"]]];
+        } else if ( [type isEqualToString:@"array"] ) {
+            [summaries addObject:[NSString stringWithFormat:@"vector %@", [shape componentsJoinedByString:@"x"]]];
+        } else if ( [type isEqualToString:@"string"] ) {
+            [summaries addObject:@"string"];
+        }
+    }
+    
+    return [summaries componentsJoinedByString:@", "];
+}
+
+@interface ModelManager ()
+
+@property (readwrite) NSArray<ModelBundleHeader*> *modelHeaders;
+@property NSDictionary<NSString*,ModelBundleHeader*> *headersById;
+@property NSDictionary<NSString*,ModelBundleHeader*> *headersByCacheKey;
+
+@end
 
 @implementation ModelManager
 
@@ -62,6 +136,164 @@ NSString * const NRModelManagerDidDeleteModelNotification = @"NRModelManagerDidD
     return modelsPath;
 }
 
+- (NSString*)bundleManifestPath {
+    NSURL *cachesDirectoryURL = [[NSFileManager defaultManager] URLsForDirectory:NSCachesDirectory inDomains:NSUserDomainMask][0];
+    return [cachesDirectoryURL.path stringByAppendingPathComponent:kBundleManifestFilename];
+}
+
+// MARK: - Model Bundles
+
+- (BOOL)loadModelBundlesAtPath:(NSString*)path error:(NSError**)error {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    
+    NSString *manifestPath = self.bundleManifestPath;
+    BundleManifest manifest = BundleManifest::Load(manifestPath.fileSystemRepresentation);
+    
+    // Find the bundles and read the headers of those that are new or have changed from their
+    // model.json files in parallel. Bundles are not constructed here: TensorIO only builds and
+    // validates a bundle, its layers and its labels, when the bundle is first used, and a header
+    // whose bundle it rejects then has no bundle
+    
+    size_t workers = NSProcessInfo.processInfo.activeProcessorCount;
+    std::string scanError;
+    ScanResult result;
+    
+    bool scanned = ScanBundles(path.fileSystemRepresentation, manifest, workers, [](const std::string &bundlePath, BundleRecord *record) -> bool {
+        @autoreleasepool {
+            NSData *data = [NSData dataWithContentsOfFile:[@(bundlePath.c_str()) stringByAppendingPathComponent:@"model.json"]];
+            NSDictionary *info = data == nil ? nil : [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+            
+            if ( ![info isKindOfClass:NSDictionary.class] || ![info[@"id"] isKindOfClass:NSString.class] ) {
+                NSLog(@"Unable to read model bundle description at path %s", bundlePath.c_str());
+                return false;
+            }
+            
+            NSDictionary *model = [info[@"model"] isKindOfClass:NSDictionary.class] ? info[@"model"] : nil;
+            
+            record->identifier = [info[@"id"] UTF8String];
+            record->name = [info[@"name"] isKindOfClass:NSString.class] ? [info[@"name"] UTF8String] : "";
+            record->version = [info[@"version"] isKindOfClass:NSString.class] ? [info[@"version"] UTF8String] : "";
+            record->quantized = [model[@"quantized"] respondsToSelector:@selector(boolValue)] && [model[@"quantized"] boolValue];
+            record->backend = [model[@"backend"] isKindOfClass:NSString.class] ? [model[@"backend"] UTF8String] : "";
+            record->inputs = InputSummary(info[@"inputs"]).UTF8String;
+            
+            for ( NSDictionary *output in ([info[@"outputs"] isKindOfClass:NSArray.class] ? info[@"outputs"] : @[]) ) {
+                NSString *name = [output isKindOfClass:NSDictionary.class] ? output[@"name"] : nil;
+                NSString *labels = [output isKindOfClass:NSDictionary.class] ? output[@"labels"] : nil;
+                if ( [name isKindOfClass:NSString.class] && [labels isKindOfClass:NSString.class] ) {
+                    record->labels.emplace_back(name.UTF8String, labels.UTF8String);
+                }
+            }
+            
+            return true;
+        }
+    }, &result, &scanError);
+    
+    if ( !scanned ) {
+        NSLog(@"Unable to read model bundles at path %@, error: %s", path, scanError.c_str());
+        if (error) {
+            *error = NetRunnerModelManagerReadError(path, @(scanError.c_str()));
+        }
+        return NO;
+    }
+    
+    // Headers for unchanged bundles are reused if they are already loaded, along with any bundle
+    // they have materialized, and are otherwise created from the records without reading the
+    // bundles. Invalid bundles are skipped
+    
+    NSDictionary<NSString*,ModelBundleHeader*> *loaded = self.headersByCacheKey;
+    NSMutableArray<ModelBundleHeader*> *modelHeaders = [[NSMutableArray alloc] init];
+    NSMutableDictionary<NSString*,ModelBundleHeader*> *headersByCacheKey = [[NSMutableDictionary alloc] init];
+    
+    for ( const BundleRecord &record : result.records ) {
+        if ( !record.valid ) {
+            continue;
+        }
+        
+        NSString *cacheKey = BundleCacheKey(record);
+        ModelBundleHeader *header = loaded[cacheKey];
+        
+        if ( header == nil ) {
+            NSMutableDictionary<NSString*,NSString*> *labels = [[NSMutableDictionary alloc] init];
+            for ( const auto &output : record.labels ) {
+                labels[@(output.first.c_str())] = @(output.second.c_str());
+            }
+            
+            header = [[ModelBundleHeader alloc]
+                initWithPath:[path stringByAppendingPathComponent:@(record.path.c_str())]
+                identifier:@(record.identifier.c_str())
+                name:@(record.name.c_str())
+                version:@(record.version.c_str())
+                backend:@(record.backend.c_str())
+                quantized:record.quantized
+                inputSummary:@(record.inputs.c_str())
+                labels:labels];
+        }
+        
+        [modelHeaders addObject:header];
+        headersByCacheKey[cacheKey] = header;
+    }
+    
+    // Sort and index the headers
+    
+    [modelHeaders sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"name" ascending:YES selector:@selector(caseInsensitiveCompare:)]]];
+    
+    NSMutableDictionary<NSString*,ModelBundleHeader*> *headersById = [[NSMutableDictionary alloc] init];
+    
+    for ( ModelBundleHeader *header in modelHeaders ) {
+        if ( headersById[header.identifier] == nil ) {
+            headersById[header.identifier] = header;
+        }
+    }
+    
+    // Remember every bundle for the next launch
+    
+    std::string manifestError;
+    manifest.assign(std::move(result.records));
+    
+    if ( !manifest.save(manifestPath.fileSystemRepresentation, &manifestError) ) {
+        NSLog(@"Unable to save model bundle manifest, error: %s", manifestError.c_str());
+    }
+    
+    NSLog(@"Loaded %tu model bundles in %.1fms, parsed %zu and reused %zu", modelHeaders.count, (CFAbsoluteTimeGetCurrent() - start) * 1000, result.parsed, result.reused);
+    
+    if ( modelHeaders.count == 0 ) {
+        if (error) {
+            *error = NetRunnerModelManagerNoValidModelBundlesError(path);
+        }
+        return NO;
+    }
+    
+    self.headersByCacheKey = headersByCacheKey;
+    self.headersById = headersById;
+    self.modelHeaders = modelHeaders.copy;
+    
+    [NSNotificationCenter.defaultCenter postNotificationName:NRModelManagerDidLoadModelsNotification object:self];
+    
+    return YES;
+}
+
+- (nullable ModelBundleHeader*)headerWithId:(NSString*)modelId {
+    return self.headersById[modelId];
+}
+
+- (nullable TIOModelBundle*)bundleWithId:(NSString*)modelId {
+    return self.headersById[modelId].bundle;
+}
+
+- (NSArray<TIOModelBundle*>*)bundlesWithIds:(NSArray<NSString*>*)modelIds {
+    NSDictionary<NSString*,ModelBundleHeader*> *headersById = self.headersById;
+    NSMutableArray<TIOModelBundle*> *bundles = [[NSMutableArray alloc] init];
+    
+    for ( NSString *modelId in modelIds ) {
+        if ( TIOModelBundle *bundle = headersById[modelId].bundle ) {
+            [bundles addObject:bundle];
+        }
+    }
+    
+    return bundles.copy;
+}
+
 // MARK: - Activity
 
 - (BOOL)deleteModel:(TIOModelBundle*)modelBundle error:(NSError**)error {
@@ -76,7 +308,7 @@ NSString * const NRModelManagerDidDeleteModelNotification = @"NRModelManagerDidD
     
     // Reload models
     
-    if ( ![TIOModelBundleManager.sharedManager loadModelBundlesAtPath:self.modelsPath error:error] ) {
+    if ( ![self loadModelBundlesAtPath:self.modelsPath error:error] ) {
         NSLog(@"Unable to load model bundles at path %@, error: %@", self.modelsPath, *error);
         return NO;
     }
@@ -91,3 +323,19 @@ NSString * const NRModelManagerDidDeleteModelNotification = @"NRModelManagerDidD
 }
 
 @end
+
+// MARK: - Errors
+
+NSError * NetRunnerModelManagerReadError(NSString *path, NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerModelManagerErrorDomain code:NetRunnerModelManagerReadErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Unable to read the model bundles at path %@: %@", path, description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Ensure this path exists and is a directory"
+    }];
+}
+
+NSError * NetRunnerModelManagerNoValidModelBundlesError(NSString *path) {
+    return [[NSError alloc] initWithDomain:NetRunnerModelManagerErrorDomain code:NetRunnerModelManagerNoValidModelBundlesErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"No valid model bundles found at path %@", path],
+        NSLocalizedRecoverySuggestionErrorKey: @"Ensure this path contains one or more correctly formated .tiobundle folders"
+    }];
+}
@@ -36,6 +36,12 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSString*)labelDatabasesDirectory;
 
+/**
+ * Returns the path to the directory of preprocessed training shards, creating it if necessary.
+ */
+
+- (NSString*)trainingShardsDirectory;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -47,4 +47,18 @@
     return labelsPath;
 }
 
+- (NSString*)trainingShardsDirectory {
+    NSFileManager *fm = NSFileManager.defaultManager;
+    NSURL *documentDirectoryURL = [[NSFileManager defaultManager] URLsForDirectory:NSDocumentDirectory inDomains:NSUserDomainMask][0];
+    NSString *documentDirectoryPath = [documentDirectoryURL path];
+    NSString *trainingPath = [documentDirectoryPath stringByAppendingPathComponent:@"training"];
+    NSError *fileError;
+    
+    if (![fm fileExistsAtPath:trainingPath] && ![fm createDirectoryAtPath:trainingPath withIntermediateDirectories:NO attributes:nil error:&fileError]) {
+        NSLog(@"Unable to create training shards directory at path %@, error: %@", trainingPath, fileError);
+    }
+    
+    return trainingPath;
+}
+
 @end
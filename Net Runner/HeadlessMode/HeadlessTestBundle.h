@@ -87,12 +87,75 @@ NS_ASSUME_NONNULL_BEGIN
 
 @property (readonly) NSUInteger iterations;
 
+/**
+ * `YES` if models should be evaluated in parallel. Latency measurements taken in parallel are
+ * contended and are flagged in the results. Defaults to `NO`.
+ */
+
+@property (readonly) BOOL evaluatesModelsInParallel;
+
+/**
+ * The maximum number of models evaluated at once when evaluating in parallel, or 0 to use the
+ * number of active processors.
+ */
+
+@property (readonly) NSUInteger maxConcurrentModels;
+
+/**
+ * `YES` if preprocessed inputs are cached across iterations and across models with the same
+ * input specification. Set the "cache_inputs" option to `false` to measure cold preprocessing
+ * latency on every iteration. Defaults to `YES`.
+ */
+
+@property (readonly) BOOL cachesPreprocessedInputs;
+
+/**
+ * The number of initial evaluations of each model excluded from the latency statistics in the
+ * summary. Set with the "warmup" option. Defaults to 0.
+ */
+
+@property (readonly) NSUInteger warmup;
+
+/**
+ * When set, each model is benchmarked serially until its inference latency reaches a steady
+ * state rather than being evaluated a fixed number of iterations. Set with the "benchmark"
+ * option, see SteadyStateBenchmark.h and the README for its keys. `nil` by default.
+ */
+
+@property (readonly, nullable) NSDictionary<NSString*,id> *benchmarkOptions;
+
+/**
+ * `YES` if an interrupted run picks up where it left off. Results are then appended to the same
+ * file on every run and evaluations already in it are restored rather than repeated, see
+ * EvaluationCheckpoint.h. Set with the "resume" option. Defaults to `NO`, and ignored when
+ * benchmarking.
+ */
+
+@property (readonly) BOOL resumes;
+
+/**
+ * When set, each run's summary is compared with a baseline summary and a verdict is produced,
+ * see RegressionGate.h. Set with the "regression" option, which holds the path to the baseline
+ * summary relative to the test bundle under "baseline" and any regression thresholds, see the
+ * README. `nil` by default.
+ */
+
+@property (readonly, nullable) NSDictionary<NSString*,id> *regressionOptions;
+
 /**
  * The `EvaluationMetric` to use.
  */
 
 @property (readonly) id<EvaluationMetric> metric;
 
+/**
+ * The names of the classification metrics to compute from each model's class scores, such as
+ * "accuracy_top1", "confusion_matrix" or "mean_average_precision". Set with the "metrics"
+ * option, see ClassificationMetrics.h for the available metrics. May be empty.
+ */
+
+@property (readonly) NSArray<NSString*> *classificationMetrics;
+
 // MARK: -
 
 /**
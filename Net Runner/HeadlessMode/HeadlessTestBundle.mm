@@ -40,7 +40,15 @@
 @property (readwrite) NSDictionary<NSString*,id> *options;
 
 @property (readwrite) NSUInteger iterations;
+@property (readwrite) BOOL evaluatesModelsInParallel;
+@property (readwrite) NSUInteger maxConcurrentModels;
+@property (readwrite) BOOL cachesPreprocessedInputs;
+@property (readwrite) NSUInteger warmup;
+@property (readwrite, nullable) NSDictionary<NSString*,id> *benchmarkOptions;
+@property (readwrite) BOOL resumes;
+@property (readwrite, nullable) NSDictionary<NSString*,id> *regressionOptions;
 @property (readwrite) id<EvaluationMetric> metric;
+@property (readwrite) NSArray<NSString*> *classificationMetrics;
 
 @end
 
@@ -88,6 +96,22 @@
         // Options
         
         _iterations = [_options[@"iterations"] unsignedIntegerValue];
+        _evaluatesModelsInParallel = [_options[@"parallel"] boolValue];
+        _maxConcurrentModels = [_options[@"max_concurrent_models"] unsignedIntegerValue];
+        _cachesPreprocessedInputs = _options[@"cache_inputs"] != nil ? [_options[@"cache_inputs"] boolValue] : YES;
+        _warmup = [_options[@"warmup"] unsignedIntegerValue];
+        
+        if ( [_options[@"benchmark"] isKindOfClass:NSDictionary.class] ) {
+            _benchmarkOptions = _options[@"benchmark"];
+        }
+        
+        _resumes = [_options[@"resume"] boolValue] && _benchmarkOptions == nil;
+        
+        if ( [_options[@"regression"] isKindOfClass:NSDictionary.class] ) {
+            _regressionOptions = _options[@"regression"];
+        }
+        
+        _classificationMetrics = [_options[@"metrics"] isKindOfClass:NSArray.class] ? _options[@"metrics"] : @[];
         
         if ( NSString *metricName = _options[@"metric"] ) {
             _metric = [EvaluationMetricFactory.sharedInstance evaluationMetricForName:metricName];
@@ -33,27 +33,121 @@ NS_ASSUME_NONNULL_BEGIN
 @property (readonly) HeadlessTestBundle *testBundle;
 
 /**
- * All the evaluation results from running the test.
+ * The JSON Lines file to which evaluation results are appended as they complete, one record
+ * per line. Results are not held in memory, and partial results survive an interrupted run.
+ * When the test bundle resumes, a run restores the results already in the file and only
+ * evaluates what is missing from it.
  */
 
-@property (readonly) NSArray<NSDictionary<NSString*, id>*> *results;
+@property (readonly) NSURL *resultsURL;
 
 /**
- * The summary statistics from running the test.
+ * The summary statistics from running the test, computed incrementally as results complete.
  */
 
 @property (readonly) NSArray<NSDictionary<NSString*, id>*> *summary;
 
 /**
- * Instantiates a test bundle runner with the provided test bundle. Call `evaluate` to actually
- * run the tests.
+ * The shard of the test bundle's evaluations this runner evaluates, written "index/count" with
+ * a one-based index, e.g. "2/4", or `nil` for the whole test bundle. See EvaluationShard.h.
+ */
+
+@property (nullable, readonly) NSString *shard;
+
+/**
+ * The partial summary of a sharded run, which the command line runner's `--merge` option
+ * combines with the partial summaries of the other shards into the summary of a single run.
+ * `nil` unless the runner evaluates a shard. See EvaluationSummaryAccumulator.h.
+ */
+
+@property (nullable, readonly) NSDictionary<NSString*,id> *partialSummary;
+
+/**
+ * The JSON file the partial summary is written to, next to the results file, or `nil` unless
+ * the runner evaluates a shard.
+ */
+
+@property (nullable, readonly) NSURL *partialSummaryURL;
+
+/**
+ * The verdict of comparing the summary with the test bundle's baseline summary: whether it
+ * "passed", the number of "regressions" and the comparison of each model under "models". See
+ * SummaryRegressionGate.h. `nil` unless the test bundle has a "regression" option and the
+ * runner evaluates the whole bundle, or if the baseline could not be read.
+ */
+
+@property (nullable, readonly) NSDictionary<NSString*,id> *verdict;
+
+/**
+ * The JSON file the verdict is written to, next to the results file, or `nil` unless the test
+ * bundle has a "regression" option and the runner evaluates the whole bundle.
+ */
+
+@property (nullable, readonly) NSURL *verdictURL;
+
+/**
+ * When `YES` the stages of every evaluation are traced and written to `traceURL` as a Chrome
+ * Trace Event JSON file, which chrome://tracing and Perfetto open. See Tracer.h. Tracing costs
+ * little but is off by default. Set before calling `evaluate`.
+ */
+
+@property BOOL traces;
+
+/**
+ * The JSON file the trace is written to, next to the results file, or `nil` unless the runner
+ * traces its evaluations.
+ */
+
+@property (nullable, readonly) NSURL *traceURL;
+
+/**
+ * Instantiates a test bundle runner with the provided test bundle that writes its results to a
+ * file in the documents directory, named for the test bundle and, unless the test bundle
+ * resumes, the current time. Call `evaluate` to actually run the tests.
+ *
+ * @param testBundle The test bundle that will be run.
+ *
+ * @return HeadlessTestBundleRunner
+ */
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle;
+
+/**
+ * Instantiates a test bundle runner that evaluates a single shard of the test bundle and writes
+ * its results to a file in the documents directory, named for the test bundle and the shard.
+ *
+ * @param testBundle The test bundle that will be run.
+ * @param shard The shard to evaluate, written "index/count", or `nil` for the whole bundle. An
+ *  invalid shard is logged and the whole bundle is evaluated.
+ *
+ * @return HeadlessTestBundleRunner
+ */
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle shard:(nullable NSString*)shard;
+
+/**
+ * Instantiates a test bundle runner that writes its results to the provided file.
+ *
+ * @param testBundle The test bundle that will be run.
+ * @param resultsURL The JSON Lines file results are appended to.
+ *
+ * @return HeadlessTestBundleRunner
+ */
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle resultsURL:(NSURL*)resultsURL;
+
+/**
+ * Instantiates a test bundle runner that evaluates a single shard of the test bundle and writes
+ * its results to the provided file.
  *
  * @param testBundle The test bundle that will be run.
+ * @param resultsURL The JSON Lines file results are appended to.
+ * @param shard The shard to evaluate, written "index/count", or `nil` for the whole bundle.
  *
  * @return HeadlessTestBundleRunner
  */
 
-- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle NS_DESIGNATED_INITIALIZER;
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle resultsURL:(NSURL*)resultsURL shard:(nullable NSString*)shard NS_DESIGNATED_INITIALIZER;
 
 /**
  * Use the designated initializer.
@@ -64,7 +158,7 @@ NS_ASSUME_NONNULL_BEGIN
 /**
  * Actually runs the test and evaluation metrics on the provided test bundle.
  *
- * After evaluation is completed you may inspect `results` and `summary`.
+ * After evaluation is completed you may inspect `summary` and read the results at `resultsURL`.
  */
 
 - (void)evaluate;
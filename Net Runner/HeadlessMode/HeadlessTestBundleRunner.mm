@@ -24,54 +24,132 @@
 #import "FileImageEvaluator.h"
 #import "URLImageEvaluator.h"
 #import "Evaluator.h"
-#import "EvaluationMetric.h"
-#import "ModelOutput.h"
 #import "EvaluatorConstants.h"
+#import "EvaluationEngine.h"
+#import "PreprocessedInputCache.h"
+#import "EvaluationResultsSink.h"
+#import "EvaluationSummaryAccumulator.h"
+#import "EvaluationCheckpoint.h"
+#import "EvaluationUnits.h"
+#import "SummaryRegressionGate.h"
+#import "TIOTFLiteModel+Tracing.h"
+#import "ModelManager.h"
+
+#include "EvaluationShard.h"
+#include "SteadyStateBenchmark.h"
+#include "Tracer.h"
 
 @import TensorIO;
 
+using netrunner::EvaluationShard;
+using netrunner::SteadyStateBenchmark;
+using netrunner::Tracer;
+
+typedef void (^HeadlessTestBundleResultHandler)(NSDictionary<NSString*,id> *result);
+
+static SteadyStateBenchmark::Options BenchmarkOptionsForDictionary(NSDictionary<NSString*,id> *dictionary);
+static NSDictionary<NSString*,id> *BenchmarkSummaryForResult(const SteadyStateBenchmark::Result &result);
+
 @interface HeadlessTestBundleRunner ()
 
 @property (readwrite) HeadlessTestBundle *testBundle;
-@property (readwrite) NSArray<NSDictionary<NSString*,id>*> *results;
+@property (readwrite) NSURL *resultsURL;
 @property (readwrite) NSArray<NSDictionary<NSString*,id>*> *summary;
+@property (nullable, readwrite) NSDictionary<NSString*,id> *partialSummary;
+@property (nullable, readwrite) NSDictionary<NSString*,id> *verdict;
 
 @end
 
-@implementation HeadlessTestBundleRunner
+@implementation HeadlessTestBundleRunner {
+    EvaluationShard _evaluationShard;
+}
 
 - (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle {
+    return [self initWithTestBundle:testBundle shard:nil];
+}
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle shard:(nullable NSString*)shard {
+    NSURL *documents = [NSFileManager.defaultManager URLsForDirectory:NSDocumentDirectory inDomains:NSUserDomainMask].firstObject;
+    
+    // A resumable run appends to the same file each time it is started. Each shard has its own.
+    
+    EvaluationShard parsed;
+    NSString *name = testBundle.identifier;
+    
+    if ( shard != nil && EvaluationShard::Parse(shard.UTF8String, &parsed, nullptr) && !parsed.isWhole() ) {
+        name = [NSString stringWithFormat:@"%@-%s", name, parsed.name().c_str()];
+    }
+    
+    NSString *filename = testBundle.resumes
+        ? [NSString stringWithFormat:@"%@.jsonl", name]
+        : [NSString stringWithFormat:@"%@-%.0f.jsonl", name, NSDate.date.timeIntervalSince1970];
+    NSURL *resultsURL = [[documents URLByAppendingPathComponent:@"headless-results" isDirectory:YES] URLByAppendingPathComponent:filename];
+    
+    return [self initWithTestBundle:testBundle resultsURL:resultsURL shard:shard];
+}
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle resultsURL:(NSURL*)resultsURL {
+    return [self initWithTestBundle:testBundle resultsURL:resultsURL shard:nil];
+}
+
+- (instancetype)initWithTestBundle:(HeadlessTestBundle*)testBundle resultsURL:(NSURL*)resultsURL shard:(nullable NSString*)shard {
     if (self = [super init]) {
         _testBundle = testBundle;
+        _resultsURL = resultsURL;
+        
+        std::string shardError;
+        
+        if ( shard != nil && !EvaluationShard::Parse(shard.UTF8String, &_evaluationShard, &shardError) ) {
+            NSLog(@"Test Bundle %@: Evaluating the whole bundle, %s", testBundle.identifier, shardError.c_str());
+        }
+        
+        if ( !_evaluationShard.isWhole() ) {
+            NSString *filename = [NSString stringWithFormat:@"%@-%s.partial.json", testBundle.identifier, _evaluationShard.name().c_str()];
+            _shard = @(_evaluationShard.description().c_str());
+            _partialSummaryURL = [resultsURL.URLByDeletingLastPathComponent URLByAppendingPathComponent:filename];
+        }
+        
+        // A shard's summary is gated once merged
+        
+        if ( testBundle.regressionOptions != nil && _evaluationShard.isWhole() ) {
+            _verdictURL = [resultsURL.URLByDeletingPathExtension URLByAppendingPathExtension:@"verdict.json"];
+        }
     }
     
     return self;
 }
 
-// Future optimization might run each model on its own operation queue
-// Use a queue, not an array to manage the evaluators
-// See EvaluateResultsTableViewController
+- (nullable NSURL*)traceURL {
+    return self.traces
+        ? [self.resultsURL.URLByDeletingPathExtension URLByAppendingPathExtension:@"trace.json"]
+        : nil;
+}
 
 - (void)evaluate {
     
+    // Trace this run's evaluations, including the stages of a TensorFlow Lite model's inference
+    
+    Tracer &tracer = Tracer::Shared();
+    
+    if ( self.traces ) {
+        [TIOTFLiteModel installTracing];
+        tracer.clear();
+        tracer.setEnabled(true);
+    }
+    
     // Convert model ids to bundles
     
-    NSArray<TIOModelBundle*> *modelBundles = [TIOModelBundleManager.sharedManager bundlesWithIds:self.testBundle.modelIds];
+    NSArray<TIOModelBundle*> *modelBundles = [ModelManager.sharedManager bundlesWithIds:self.testBundle.modelIds];
     
     if ( modelBundles.count != self.testBundle.modelIds.count ) {
         NSLog(@"Test Bundle %@: Didn't load all models", self.testBundle.identifier);
     }
     
-    // For each model, image, iteration: build an evaluator
-    
-    NSMutableArray<id<Evaluator>> *evaluators = [[NSMutableArray<id<Evaluator>> alloc] init];
+    // Instantiate the models, which are loaded lazily by their first evaluation
     
-    NSUInteger iterations = self.testBundle.iterations;
-    NSUInteger numberOfPhotos = 0;
-    NSUInteger numberOfModels = 0;
+    NSMutableArray<id<TIOModel>> *models = [[NSMutableArray alloc] init];
     
     for ( TIOModelBundle *modelBundle in modelBundles ) {
-        
         id<TIOModel> model = [modelBundle newModel];
         
         if ( model == nil ) {
@@ -79,137 +157,507 @@
             continue;
         }
         
-        numberOfModels++;
-        
-        for ( NSDictionary *image in self.testBundle.images ) {
-            NSString *imageType = image[@"type"];
-            NSString *name = image[@"path"];
-            
-            assert([imageType isEqualToString:@"file"] || [imageType isEqualToString:@"url"]);
-            
-            for ( NSUInteger iter = 0; iter < iterations; iter++ ) {
-            
-                id<Evaluator> evaluator;
-            
-                if ( [imageType isEqualToString:@"file"] ) {
-                    NSURL *imageURL = [NSURL fileURLWithPath:[self.testBundle filePathForImageInfo:image]];
-                    evaluator = [[FileImageEvaluator alloc] initWithModel:model fileURL:imageURL name:name];
-                } else if ( [imageType isEqualToString:@"url"] ) {
-                    NSURL *imageURL = [NSURL URLWithString:image[@"url"]];
-                    evaluator = [[URLImageEvaluator alloc] initWithModel:model URL:imageURL name:name];
+        [models addObject:model];
+    }
+    
+    EvaluationSummaryAccumulator *accumulator = [[EvaluationSummaryAccumulator alloc] initWithMetric:self.testBundle.metric labels:self.testBundle.labels warmup:self.testBundle.warmup classificationMetrics:self.testBundle.classificationMetrics];
+    NSString *testBundleID = self.testBundle.identifier;
+    
+    for ( id<TIOModel> model in models ) {
+        [accumulator setClasses:[self classesForModel:model] forModel:model.identifier];
+    }
+    
+    // Fold the evaluations completed by an earlier, interrupted run back into the summary. Only
+    // the evaluations in this runner's shard are expected.
+    
+    EvaluationCheckpoint *checkpoint = nil;
+    EvaluationUnits *units = nil;
+    
+    if ( self.testBundle.resumes ) {
+        units = [self unitsForModels:models];
+        checkpoint = [[EvaluationCheckpoint alloc] initWithURL:self.resultsURL];
+        
+        for ( id<TIOModel> model in models ) {
+            [units enumerateUnitsForModel:model.identifier usingBlock:^(NSString * _Nonnull unit, NSUInteger index) {
+                if ( [self shardContainsModel:model.identifier index:index] ) {
+                    [checkpoint expectUnit:unit];
                 }
-                
-                [evaluators addObject:evaluator];
-                numberOfPhotos++;
-            }
+            }];
         }
+        
+        NSError *resumeError;
+        
+        if ( ![checkpoint resumeWithModels:models recordHandler:^(NSDictionary<NSString*,id> * _Nonnull record) {
+            [accumulator addResult:record];
+        } error:&resumeError] ) {
+            NSLog(@"Test Bundle %@: Unable to resume, error: %@", self.testBundle.identifier, resumeError);
+        }
+        
+        NSLog(@"Test Bundle %@: Resuming with %tu of %tu evaluations complete", self.testBundle.identifier, checkpoint.completedCount, checkpoint.expectedCount);
+    }
+    
+    // Stream results to the results file and fold them into the summary as they complete,
+    // rather than holding them in memory
+    
+    NSError *sinkError;
+    EvaluationResultsSink *sink = [[EvaluationResultsSink alloc] initWithURL:self.resultsURL error:&sinkError];
+    
+    if ( sink == nil ) {
+        NSLog(@"Test Bundle %@: Unable to open results file, error: %@", self.testBundle.identifier, sinkError);
     }
     
-    numberOfPhotos = numberOfPhotos / numberOfModels;
+    HeadlessTestBundleResultHandler resultHandler = ^(NSDictionary<NSString*,id> *result) {
+        [accumulator addResult:result];
+        
+        NSMutableDictionary *resultCopy = [result mutableCopy];
+        resultCopy[@"test_bundle"] = testBundleID;
+        
+        NSError *appendError;
+        if ( sink != nil && ![sink appendResult:resultCopy error:&appendError] ) {
+            NSLog(@"Test Bundle %@: Unable to write result, error: %@", testBundleID, appendError);
+        }
+    };
     
-    // Execute the evaluators and collect the results
+    PreprocessedInputCache *inputCache = PreprocessedInputCache.sharedCache;
+    inputCache.enabled = self.testBundle.cachesPreprocessedInputs;
     
-    NSLog(@"Test Bundle %@: Running %tu evaluators", self.testBundle.identifier, evaluators.count);
+    NSDictionary<NSString*,NSDictionary*> *benchmarks = nil;
     
-    NSMutableArray<NSDictionary<NSString*,id>*> *results = [[NSMutableArray<NSDictionary<NSString*,id>*> alloc] init];
+    // A benchmark measures latency rather than covering the images, so it is not split: the
+    // first shard runs it whole and the others skip it
     
-    for ( id<Evaluator> evaluator in evaluators ) {
-
-         @autoreleasepool {
-            [evaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
-                NSMutableDictionary *resultCopy = [result mutableCopy];
-                resultCopy[@"test_bundle"] = self.testBundle.identifier;
-                [results addObject:[resultCopy copy]];
-            }];
-         }
+    if ( self.testBundle.benchmarkOptions != nil && _evaluationShard.index() != 0 ) {
+        NSLog(@"Test Bundle %@: Benchmarks run in the first shard, skipping in shard %@", self.testBundle.identifier, self.shard);
+    } else if ( self.testBundle.benchmarkOptions != nil ) {
+        benchmarks = [self benchmarkModels:models resultHandler:resultHandler];
+    } else {
+        [self evaluateModels:models checkpoint:checkpoint units:units resultHandler:resultHandler];
     }
     
-    // Save all the results: do with this whatever you want, e.g. push it to a server
+    NSLog(@"Test Bundle %@: Preprocessed input cache hits: %tu, disk hits: %tu, misses: %tu", self.testBundle.identifier, inputCache.hits, inputCache.diskHits, inputCache.misses);
     
-    self.results = results;
+    [inputCache removeAllObjects];
+    inputCache.enabled = YES;
     
-    // Filter out results with an error for computing summary statistics
+    if ( sink != nil && ![sink close:&sinkError] ) {
+        NSLog(@"Test Bundle %@: Unable to close results file, error: %@", self.testBundle.identifier, sinkError);
+    }
     
-    NSDictionary<NSNumber*,id> *resultsByError = [results groupBy:kEvaluatorResultsKeyError];
-    NSArray<NSDictionary<NSString*,id>*> *resultsWithoutError = resultsByError[@(NO)];
-    NSArray<NSDictionary<NSString*,id>*> *resultsWithError = resultsByError[@(YES)];
+    NSLog(@"Test Bundle %@: Wrote %tu results to %@", self.testBundle.identifier, sink.count, self.resultsURL.path);
     
-    NSLog(@"Test Bundle: %@, Evaluation errors: %tu", self.testBundle.identifier, resultsWithError.count );
+    if ( self.traces ) {
+        tracer.setEnabled(false);
+        [self writeTrace];
+    }
+    
+    NSLog(@"Test Bundle: %@, Evaluation errors: %tu", self.testBundle.identifier, accumulator.errorCount);
+    
+    // Add each model's benchmark statistics to its summary
     
-    // Group results by model
+    NSMutableArray<NSDictionary<NSString*,id>*> *summary = [[NSMutableArray alloc] init];
     
-    NSDictionary<NSString*,id> *resultsByModel = [resultsWithoutError groupBy:kEvaluatorResultsKeyModel];
+    for ( NSDictionary<NSString*,id> *modelSummary in accumulator.summary ) {
+        NSDictionary *benchmark = benchmarks[modelSummary[kEvaluatorResultsKeyModel]];
+        
+        if ( benchmark == nil ) {
+            [summary addObject:modelSummary];
+        } else {
+            NSMutableDictionary *copy = [modelSummary mutableCopy];
+            copy[@"benchmark"] = benchmark;
+            [summary addObject:copy.copy];
+        }
+    }
     
-    // Prepare to collect summary statistics
+    self.summary = summary.copy;
     
-    NSMutableDictionary<NSString*,id> *summaryStatistics = [[NSMutableDictionary<NSString*,id> alloc] init];
+    NSLog(@"Test Bundle %@: Summary statistics:\n%@", self.testBundle.identifier, self.summary);
+    
+    if ( !_evaluationShard.isWhole() ) {
+        [self writePartialSummary:accumulator.partialSummary benchmarks:benchmarks];
+    } else if ( self.verdictURL != nil ) {
+        [self checkForRegressions];
+    }
+}
+
+// MARK: - Tracing
+
+- (void)writeTrace {
+    Tracer &tracer = Tracer::Shared();
+    std::string error;
     
-    for ( NSString *modelID in resultsByModel ) {
-        summaryStatistics[modelID] = [[NSMutableDictionary<NSString*,id> alloc] init];
+    if ( !tracer.write(self.traceURL.path.UTF8String, &error) ) {
+        NSLog(@"Test Bundle %@: Unable to write trace, %s", self.testBundle.identifier, error.c_str());
+        return;
+    }
+    
+    if ( tracer.dropped() > 0 ) {
+        NSLog(@"Test Bundle %@: Trace dropped its %llu oldest spans, a thread recorded more than %zu", self.testBundle.identifier, tracer.dropped(), tracer.capacity());
+    }
+    
+    NSLog(@"Test Bundle %@: Wrote trace to %@", self.testBundle.identifier, self.traceURL.path);
+    
+    tracer.clear();
+}
+
+// MARK: - Regressions
+
+// The baseline is a summary in the test bundle, from an earlier run on the same kind of device
+
+- (void)checkForRegressions {
+    NSDictionary<NSString*,id> *options = self.testBundle.regressionOptions;
+    NSString *baselinePath = [options[@"baseline"] isKindOfClass:NSString.class] ? [self.testBundle.path stringByAppendingPathComponent:options[@"baseline"]] : nil;
+    NSError *error;
+    
+    SummaryRegressionGate *gate = baselinePath == nil ? nil : [[SummaryRegressionGate alloc] initWithBaselineURL:[NSURL fileURLWithPath:baselinePath] thresholds:options error:&error];
+    self.verdict = [gate verdictForSummary:self.summary testBundle:self.testBundle.identifier error:&error];
+    
+    if ( self.verdict == nil ) {
+        NSLog(@"Test Bundle %@: Unable to check for regressions against baseline %@, error: %@", self.testBundle.identifier, options[@"baseline"], error);
+        return;
+    }
+    
+    for ( NSDictionary<NSString*,id> *model in self.verdict[@"models"] ) {
+        for ( NSDictionary<NSString*,id> *check in model[@"checks"] ) {
+            if ( [check[@"verdict"] isEqualToString:@"regression"] ) {
+                NSLog(@"Test Bundle %@: Model %@: %@ regressed from %@ to %@ (p = %@)", self.testBundle.identifier, model[kEvaluatorResultsKeyModel], check[@"name"], check[@"baseline"], check[@"candidate"], check[@"p_value"]);
+            }
+        }
+    }
+    
+    NSLog(@"Test Bundle %@: Regression gate %@ with %@ regressions", self.testBundle.identifier, [self.verdict[@"passed"] boolValue] ? @"passed" : @"failed", self.verdict[@"regressions"]);
+    
+    NSData *data = [NSJSONSerialization dataWithJSONObject:self.verdict options:NSJSONWritingPrettyPrinted error:&error];
+    
+    if ( data == nil || ![data writeToURL:self.verdictURL options:NSDataWritingAtomic error:&error] ) {
+        NSLog(@"Test Bundle %@: Unable to write verdict to %@, error: %@", self.testBundle.identifier, self.verdictURL.path, error);
+    }
+}
+
+// MARK: - Shards
+
+// Evaluations are indexed in engine order: image-major, iteration-minor. Images are identified
+// by their path in the test bundle, as the command line runner identifies them.
+
+- (BOOL)shardContainsModel:(NSString*)modelID index:(NSUInteger)index {
+    if ( _evaluationShard.isWhole() ) {
+        return YES;
     }
     
-    // Calculate average latency, by model
+    NSUInteger iterations = self.testBundle.iterations;
+    NSDictionary *image = self.testBundle.images[index / iterations];
+    NSString *input = image[@"path"] ?: image[@"url"];
+    
+    return _evaluationShard.contains(modelID.UTF8String, input.UTF8String, index % iterations);
+}
+
+- (void)writePartialSummary:(NSArray<NSDictionary<NSString*,id>*>*)modelPartials benchmarks:(nullable NSDictionary<NSString*,NSDictionary*>*)benchmarks {
+    NSMutableArray<NSDictionary<NSString*,id>*> *models = [[NSMutableArray alloc] init];
     
-    for ( NSString *modelID in resultsByModel ) {
-        NSArray *modelResults = resultsByModel[modelID];
+    for ( NSDictionary<NSString*,id> *partial in modelPartials ) {
+        NSDictionary *benchmark = benchmarks[partial[kEvaluatorResultsKeyModel]];
         
-        double totalLatency =
-            [[[modelResults
-            map:^NSDictionary * _Nonnull(id  _Nonnull obj) {
-                return obj[kEvaluatorResultsKeyEvaluation][kEvaluatorResultsKeyInferenceLatency];
-            }]
-            reduce:@(0.0) combine:^id _Nonnull(NSNumber * _Nonnull accumulator, NSNumber * _Nonnull item) {
-                return @(accumulator.doubleValue + item.doubleValue);
-            }]
-            doubleValue
-            ];
+        if ( benchmark == nil ) {
+            [models addObject:partial];
+        } else {
+            NSMutableDictionary *copy = [partial mutableCopy];
+            copy[@"benchmark"] = benchmark;
+            [models addObject:copy.copy];
+        }
+    }
+    
+    self.partialSummary = @{
+        @"test_bundle": self.testBundle.identifier,
+        @"shard": @(_evaluationShard.index() + 1),
+        @"shards": @(_evaluationShard.count()),
+        @"models": models.copy
+    };
+    
+    NSError *error;
+    NSData *data = [NSJSONSerialization dataWithJSONObject:self.partialSummary options:NSJSONWritingPrettyPrinted error:&error];
+    
+    if ( data == nil || ![data writeToURL:self.partialSummaryURL options:NSDataWritingAtomic error:&error] ) {
+        NSLog(@"Test Bundle %@: Unable to write partial summary to %@, error: %@", self.testBundle.identifier, self.partialSummaryURL.path, error);
+        return;
+    }
+    
+    NSLog(@"Test Bundle %@: Wrote partial summary for shard %@ to %@", self.testBundle.identifier, self.shard, self.partialSummaryURL.path);
+}
+
+// Each model is evaluated on its own lane of an EvaluationEngine. Lanes run concurrently only
+// when the test bundle opts into parallel evaluation, since latencies are then contended. When
+// resuming, units restored from the checkpoint are skipped and new results record their unit.
+// Evaluations outside of the runner's shard are skipped.
+
+- (void)evaluateModels:(NSArray<id<TIOModel>>*)models checkpoint:(nullable EvaluationCheckpoint*)checkpoint units:(nullable EvaluationUnits*)units resultHandler:(HeadlessTestBundleResultHandler)resultHandler {
+    EvaluationEngineMode mode = self.testBundle.evaluatesModelsInParallel
+        ? EvaluationEngineModeParallel
+        : EvaluationEngineModeSerial;
+    
+    EvaluationEngine *engine = [[EvaluationEngine alloc] initWithMode:mode];
+    
+    if ( self.testBundle.maxConcurrentModels > 0 ) {
+        engine.maxConcurrentModels = self.testBundle.maxConcurrentModels;
+    }
+    
+    // For each model add a lane whose evaluators are built on demand: image-major, iteration-minor
+    
+    NSUInteger iterations = self.testBundle.iterations;
+    NSArray<NSDictionary*> *images = self.testBundle.images;
+    NSUInteger numberOfEvaluators = 0;
+    
+    for ( id<TIOModel> model in models ) {
         
-        double averageLatency = totalLatency / modelResults.count;
+        NSUInteger count = images.count * iterations;
+        NSString *modelID = model.identifier;
         
-        NSDictionary<NSString*,NSNumber*> *latencySummary = @{
-            @"latency": @(averageLatency)
+        EvaluationEngineSkipBlock skip = checkpoint == nil && _evaluationShard.isWhole() ? nil : ^BOOL(NSUInteger index) {
+            return ![self shardContainsModel:modelID index:index] || [checkpoint isUnitComplete:[units unitForModel:modelID index:index]];
         };
         
-        [summaryStatistics[modelID] addEntriesFromDictionary:latencySummary];
+        [engine addModel:model.identifier count:count skipping:skip generator:^id<Evaluator> _Nullable(NSUInteger index) {
+            return [self evaluatorForModel:model image:images[index / iterations]];
+        }];
+        
+        numberOfEvaluators += count;
     }
     
-    // Execute the evaluation metric if one is available, by model
+    engine.progressHandler = ^(NSString * _Nonnull modelID, NSUInteger completed, NSUInteger total) {
+        if ( completed == total ) {
+            NSLog(@"Test Bundle %@: Completed %tu evaluations for model %@", self.testBundle.identifier, total, modelID);
+        }
+    };
     
-    if ( id<EvaluationMetric> metric = self.testBundle.metric ) {
+    engine.collectsResults = NO;
+    engine.resultHandler = ^(NSString * _Nonnull modelID, NSUInteger index, NSDictionary<NSString*,id> * _Nonnull result) {
+        NSString *unit = [units unitForModel:modelID index:index];
+        
+        if ( unit == nil ) {
+            resultHandler(result);
+            return;
+        }
         
-        for ( NSString *modelID in resultsByModel ) {
-            NSArray *modelResults = resultsByModel[modelID];
-            
-            NSMutableArray<NSDictionary<NSString*,id>*> *metricResults = [[NSMutableArray<NSDictionary<NSString*,id>*> alloc] init];
+        NSMutableDictionary *unitResult = [result mutableCopy];
+        unitResult[kEvaluatorResultsKeyUnit] = unit;
+        resultHandler(unitResult.copy);
+    };
+    
+    NSLog(@"Test Bundle %@: Running %tu evaluators %@", self.testBundle.identifier, numberOfEvaluators, mode == EvaluationEngineModeParallel ? @"in parallel" : @"serially");
+    
+    [engine run];
+}
+
+// In benchmark mode each model is run serially, cycling through the images, until its inference
+// latency converges. Warm-up results are discarded and only measured results are reported.
+
+- (NSDictionary<NSString*,NSDictionary*>*)benchmarkModels:(NSArray<id<TIOModel>>*)models resultHandler:(HeadlessTestBundleResultHandler)resultHandler {
+    SteadyStateBenchmark::Options options = BenchmarkOptionsForDictionary(self.testBundle.benchmarkOptions);
+    NSMutableDictionary<NSString*,NSDictionary*> *benchmarks = [[NSMutableDictionary alloc] init];
+    NSArray<NSDictionary*> *images = self.testBundle.images;
+    
+    if ( images.count == 0 ) {
+        return benchmarks.copy;
+    }
+    
+    for ( id<TIOModel> model in models ) {
         
-            for ( NSDictionary *result in modelResults ) {
+        NSUInteger index = 0;
+        NSUInteger warmupRuns = options.warmupRuns;
+        
+        SteadyStateBenchmark benchmark(options);
+        SteadyStateBenchmark::Result result = benchmark.run([&](double *latency) -> bool {
+            @autoreleasepool {
+                id<Evaluator> evaluator = [self evaluatorForModel:model image:images[index++ % images.count]];
+                NSDictionary<NSString*,id> *evaluatorResult = [self evaluateSynchronously:evaluator];
+                
+                if ( warmupRuns > 0 ) {
+                    warmupRuns -= 1;
+                    return true;
+                }
+                
+                if ( evaluatorResult == nil ) {
+                    return false;
+                }
+                
+                NSMutableDictionary *measuredResult = [evaluatorResult mutableCopy];
+                measuredResult[kEvaluatorResultsKeyConcurrentModels] = @(1);
+                resultHandler(measuredResult);
                 
-                NSString *identifier = result[kEvaluatorResultsKeyImage];
-                id yhat = ((id<ModelOutput>)result[kEvaluatorResultsKeyEvaluation][kEvaluatorResultsKeyInferenceResults]).value;
-                id y = self.testBundle.labels[identifier];
+                id evaluation = evaluatorResult[kEvaluatorResultsKeyEvaluation];
                 
-                NSDictionary<NSString*,NSNumber*> *metricResult = [metric evaluate:y yhat:yhat];
-                [metricResults addObject:metricResult];
+                if ( [evaluatorResult[kEvaluatorResultsKeyError] boolValue] || ![evaluation isKindOfClass:NSDictionary.class] || evaluation[kEvaluatorResultsKeyInferenceLatency] == nil ) {
+                    return false;
+                }
+                
+                *latency = [evaluation[kEvaluatorResultsKeyInferenceLatency] doubleValue];
+                return true;
             }
-            
-            NSDictionary<NSString*,NSNumber*> *metricResultsSummary = [metric reduce:metricResults];
-            [summaryStatistics[modelID] addEntriesFromDictionary:metricResultsSummary];
+        });
+        
+        NSLog(@"Test Bundle %@: Benchmark for model %@ stopped (%s) after %u runs, steady state latency %.2fms ± %.2fms%@", self.testBundle.identifier, model.identifier, SteadyStateBenchmark::StopReasonName(result.stopReason).c_str(), result.runs, result.steadyStateLatency, result.confidenceInterval, result.throttled ? @", throttled" : @"");
+        
+        benchmarks[model.identifier] = BenchmarkSummaryForResult(result);
+    }
+    
+    return benchmarks.copy;
+}
+
+// MARK: - Checkpoints
+
+// The units of the models' evaluations, in engine order: image-major, iteration-minor. Options
+// that only affect the summary are left out of the fingerprint, so that changing the metrics or
+// adding iterations reuses the evaluations already made.
+
+- (EvaluationUnits*)unitsForModels:(NSArray<id<TIOModel>>*)models {
+    NSMutableDictionary<NSString*,id> *options = [self.testBundle.options mutableCopy];
+    [options removeObjectsForKeys:@[@"resume", @"iterations", @"warmup", @"metric", @"metrics", @"regression"]];
+    
+    EvaluationUnits *units = [[EvaluationUnits alloc] initWithIterations:self.testBundle.iterations options:[EvaluationCheckpoint fingerprintForOptions:options]];
+    
+    // Files are identified by their contents and remote images by their URLs
+    
+    for ( NSDictionary *image in self.testBundle.images ) {
+        uint64_t input = 0;
+        
+        if ( [image[@"type"] isEqualToString:@"file"] ) {
+            NSURL *imageURL = [NSURL fileURLWithPath:[self.testBundle filePathForImageInfo:image]];
+            if ( ![EvaluationCheckpoint contentHashForFileAtURL:imageURL hash:&input error:nil] ) {
+                input = [EvaluationCheckpoint contentHashForString:imageURL.path];
+            }
+        } else {
+            input = [EvaluationCheckpoint contentHashForString:image[@"url"] ?: image[@"path"]];
         }
+        
+        [units addInput:input];
     }
     
-    // Convert summary statistics to an array
+    for ( id<TIOModel> model in models ) {
+        [units addModel:model];
+    }
     
-    NSMutableArray *summary = [[NSMutableArray alloc] init];
+    return units;
+}
+
+// MARK: - Evaluators
+
+// The labels of the classification output, or of the first output with labels
+
+- (NSArray<NSString*>*)classesForModel:(id<TIOModel>)model {
+    __block NSArray<NSString*> *classes = nil;
+    
+    for ( TIOLayerInterface *output in model.io.outputs ) {
+        [output matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+            ;
+        } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+            if ( vectorDescription.isLabeled && (classes == nil || [output.name isEqualToString:@"classification"]) ) {
+                classes = vectorDescription.labels;
+            }
+        } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+            ;
+        }];
+    }
     
-    for ( NSString *model in summaryStatistics ) {
-        NSMutableDictionary<NSString*,id> *results = [summaryStatistics[model] mutableCopy];
-        results[kEvaluatorResultsKeyModel] = model;
-        [summary addObject:results];
+    return classes ?: @[];
+}
+
+- (nullable id<Evaluator>)evaluatorForModel:(id<TIOModel>)model image:(NSDictionary*)image {
+    NSString *imageType = image[@"type"];
+    NSString *name = image[@"path"];
+    
+    assert([imageType isEqualToString:@"file"] || [imageType isEqualToString:@"url"]);
+    
+    if ( [imageType isEqualToString:@"file"] ) {
+        NSURL *imageURL = [NSURL fileURLWithPath:[self.testBundle filePathForImageInfo:image]];
+        return [[FileImageEvaluator alloc] initWithModel:model fileURL:imageURL name:name];
+    } else if ( [imageType isEqualToString:@"url"] ) {
+        NSURL *imageURL = [NSURL URLWithString:image[@"url"]];
+        return [[URLImageEvaluator alloc] initWithModel:model URL:imageURL name:name];
+    } else {
+        return nil;
     }
+}
+
+// Evaluators may complete on another thread, as the EvaluationEngine also accounts for
+
+- (nullable NSDictionary<NSString*,id>*)evaluateSynchronously:(nullable id<Evaluator>)evaluator {
+    if ( evaluator == nil ) {
+        return nil;
+    }
+    
+    __block NSDictionary<NSString*,id> *evaluatorResult = nil;
+    dispatch_semaphore_t completed = dispatch_semaphore_create(0);
+    
+    [evaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
+        evaluatorResult = result;
+        dispatch_semaphore_signal(completed);
+    }];
     
-    self.summary = summary;
+    dispatch_semaphore_wait(completed, DISPATCH_TIME_FOREVER);
     
-    NSLog(@"Test Bundle %@: Summary statistics:\n%@", self.testBundle.identifier, summaryStatistics);
+    return evaluatorResult;
 }
 
 @end
+
+// MARK: - Benchmark Options
+
+// Durations in test.json are in seconds
+
+static SteadyStateBenchmark::Options BenchmarkOptionsForDictionary(NSDictionary<NSString*,id> *dictionary) {
+    SteadyStateBenchmark::Options options;
+    
+    if ( NSNumber *warmup = dictionary[@"warmup"] ) {
+        options.warmupRuns = warmup.unsignedIntValue;
+    }
+    if ( NSNumber *minRuns = dictionary[@"min_runs"] ) {
+        options.minRuns = minRuns.unsignedIntValue;
+    }
+    if ( NSNumber *maxRuns = dictionary[@"max_runs"] ) {
+        options.maxRuns = maxRuns.unsignedIntValue;
+    }
+    if ( NSNumber *maxDuration = dictionary[@"max_duration"] ) {
+        options.maxDuration = maxDuration.doubleValue * 1000;
+    }
+    if ( NSNumber *cooldown = dictionary[@"cooldown"] ) {
+        options.cooldown = cooldown.doubleValue * 1000;
+    }
+    if ( NSNumber *confidence = dictionary[@"confidence"] ) {
+        options.confidence = confidence.doubleValue;
+    }
+    if ( NSNumber *relativeError = dictionary[@"relative_error"] ) {
+        options.relativeError = relativeError.doubleValue;
+    }
+    if ( NSNumber *window = dictionary[@"window"] ) {
+        options.window = window.unsignedIntValue;
+    }
+    if ( NSNumber *throttleThreshold = dictionary[@"throttle_threshold"] ) {
+        options.throttleThreshold = throttleThreshold.doubleValue;
+    }
+    
+    // Wait for the device to cool down when it reports a serious thermal state
+    
+    options.thermalState = [] {
+        return (int)NSProcessInfo.processInfo.thermalState;
+    };
+    options.thermalCooldownState = (int)NSProcessInfoThermalStateSerious;
+    
+    return options;
+}
+
+static NSDictionary<NSString*,id> *BenchmarkSummaryForResult(const SteadyStateBenchmark::Result &result) {
+    return @{
+        @"stop_reason": [NSString stringWithUTF8String:SteadyStateBenchmark::StopReasonName(result.stopReason).c_str()],
+        @"converged": @(result.converged()),
+        @"runs": @(result.runs),
+        @"warmup_runs": @(result.warmupRuns),
+        @"failed_runs": @(result.failedRuns),
+        @"steady_state_latency": @(result.steadyStateLatency),
+        @"confidence_interval": @(result.confidenceInterval),
+        @"relative_error": @(result.relativeError),
+        @"trend": @(result.trend),
+        @"throttling_ratio": @(result.throttlingRatio),
+        @"throttled": @(result.throttled),
+        @"max_thermal_state": @(result.maxThermalState),
+        @"thermal_wait": @(result.thermalWait / 1000),
+        @"duration": @(result.duration / 1000)
+    };
+}
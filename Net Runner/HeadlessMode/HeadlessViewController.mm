@@ -24,6 +24,7 @@
 #import "HeadlessTestBundleManager.h"
 #import "HeadlessTestBundle.h"
 #import "EvaluationResultsActivityItemProvider.h"
+#import "UserDefaults.h"
 
 @import TensorIO;
 
@@ -32,7 +33,7 @@
 @property (readonly) UIBarButtonItem *shareButton;
 
 @property NSArray<HeadlessTestBundle*> *testBundles;
-@property NSArray<NSDictionary*> *results;
+@property NSArray<NSURL*> *resultsURLs;
 @property NSArray<NSDictionary*> *summary;
 
 @end
@@ -73,15 +74,37 @@
 - (void)evaluateTestBundles {
     dispatch_async(_evaluatorQueue, ^{
         
-        NSMutableArray<NSDictionary*> *results = [[NSMutableArray<NSDictionary*> alloc] init];
+        NSMutableArray<NSURL*> *resultsURLs = [[NSMutableArray<NSURL*> alloc] init];
         NSMutableArray<NSDictionary*> *summary = [[NSMutableArray<NSDictionary*> alloc] init];
         
+        // A device may run one shard of every test bundle, e.g. when launched with the arguments
+        // -app.headless.shard 2/4, and share its partial summaries for merging
+        
+        NSString *shard = [NSUserDefaults.standardUserDefaults stringForKey:kPrefsHeadlessShard];
+        
+        // Evaluations may also be traced stage by stage with -app.headless.trace YES
+        
+        BOOL traces = [NSUserDefaults.standardUserDefaults boolForKey:kPrefsHeadlessTrace];
+        
         for ( HeadlessTestBundle *testBundle in self.testBundles ) {
             @autoreleasepool {
-                HeadlessTestBundleRunner *runner = [[HeadlessTestBundleRunner alloc] initWithTestBundle:testBundle];
+                HeadlessTestBundleRunner *runner = [[HeadlessTestBundleRunner alloc] initWithTestBundle:testBundle shard:shard];
+                runner.traces = traces;
                 [runner evaluate];
                 
-                [results addObjectsFromArray:runner.results];
+                [resultsURLs addObject:runner.resultsURL];
+                
+                if ( runner.partialSummary != nil ) {
+                    [resultsURLs addObject:runner.partialSummaryURL];
+                }
+                
+                if ( runner.verdict != nil ) {
+                    [resultsURLs addObject:runner.verdictURL];
+                }
+                
+                if ( runner.traces && [NSFileManager.defaultManager fileExistsAtPath:runner.traceURL.path] ) {
+                    [resultsURLs addObject:runner.traceURL];
+                }
                 
                 for ( NSDictionary *model in runner.summary ) {
                     NSMutableDictionary *copy = [model mutableCopy];
@@ -93,10 +116,10 @@
             }
         }
         
-        self.results = results;
+        self.resultsURLs = resultsURLs;
         self.summary = summary;
         
-        NSLog(@"Completed running test bundles, %tu total results", results.count);
+        NSLog(@"Completed running test bundles, results written to %@", [resultsURLs valueForKey:@"path"]);
         
         // Do something with results and summary statistics, e.g. upload them to a server
         
@@ -118,12 +141,14 @@
 
 - (IBAction)shareResults:(id)sender {
     NSDictionary *evaluation = @{
-        @"summary": self.summary,
-        @"results": self.results
+        @"summary": self.summary
     };
     
+    // Results are shared as the JSON Lines files they were streamed to
+    
     EvaluationResultsActivityItemProvider *provider = [[EvaluationResultsActivityItemProvider alloc] initWithResults:evaluation];
-    UIActivityViewController *vc = [[UIActivityViewController alloc] initWithActivityItems:@[provider] applicationActivities:nil];
+    NSArray *items = [@[provider] arrayByAddingObjectsFromArray:self.resultsURLs];
+    UIActivityViewController *vc = [[UIActivityViewController alloc] initWithActivityItems:items applicationActivities:nil];
     
     [self presentViewController:vc animated:YES completion:nil];
 }
@@ -0,0 +1,411 @@
+//
+//  BundleManifest.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "BundleManifest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+
+#include "ContentHash.h"
+
+namespace netrunner {
+namespace bundles {
+
+namespace {
+
+const char * const kManifestMagic = "net-runner-bundle-manifest";
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+bool HasSuffix(const std::string &string, const std::string &suffix) {
+    return string.size() >= suffix.size() && string.compare(string.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+int64_t ModifiedNanoseconds(const struct stat &st) {
+#if defined(__APPLE__)
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000 + st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+
+// Fields may not contain tabs or newlines, and names and identifiers come from model.json
+
+std::string Escape(const std::string &field) {
+    std::string escaped;
+    escaped.reserve(field.size());
+
+    for ( char c : field ) {
+        switch ( c ) {
+        case '\\': escaped += "\\\\"; break;
+        case '\t': escaped += "\\t"; break;
+        case '\n': escaped += "\\n"; break;
+        default: escaped += c;
+        }
+    }
+
+    return escaped;
+}
+
+std::string Unescape(const std::string &field) {
+    std::string unescaped;
+    unescaped.reserve(field.size());
+
+    for ( size_t i = 0; i < field.size(); i++ ) {
+        if ( field[i] != '\\' || i + 1 == field.size() ) {
+            unescaped += field[i];
+            continue;
+        }
+
+        char c = field[++i];
+        unescaped += c == 't' ? '\t' : c == 'n' ? '\n' : c;
+    }
+
+    return unescaped;
+}
+
+std::vector<std::string> Split(const std::string &line, char separator) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+
+    while ( true ) {
+        size_t end = line.find(separator, start);
+        fields.push_back(line.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        if ( end == std::string::npos ) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return fields;
+}
+
+// Labels are written as one field, with a tab between an output's escaped name and filename and a
+// newline between outputs, and the whole is escaped again as a field
+
+std::string JoinLabels(const std::vector<std::pair<std::string, std::string>> &labels) {
+    std::string joined;
+
+    for ( size_t i = 0; i < labels.size(); i++ ) {
+        joined += (i == 0 ? "" : "\n") + Escape(labels[i].first) + "\t" + Escape(labels[i].second);
+    }
+
+    return joined;
+}
+
+bool SplitLabels(const std::string &field, std::vector<std::pair<std::string, std::string>> *labels) {
+    if ( field.empty() ) {
+        return true;
+    }
+
+    for ( const std::string &entry : Split(field, '\n') ) {
+        std::vector<std::string> pair = Split(entry, '\t');
+        if ( pair.size() != 2 ) {
+            return false;
+        }
+        labels->emplace_back(Unescape(pair[0]), Unescape(pair[1]));
+    }
+
+    return true;
+}
+
+bool ParseRecord(const std::string &line, BundleRecord *record) {
+    std::vector<std::string> fields = Split(line, '\t');
+
+    if ( fields.size() != 11 || (fields[3] != "0" && fields[3] != "1") || (fields[8] != "0" && fields[8] != "1") ) {
+        return false;
+    }
+
+    char *end = nullptr;
+
+    record->path = Unescape(fields[0]);
+    record->modified = std::strtoll(fields[1].c_str(), &end, 10);
+    if ( fields[1].empty() || *end != '\0' ) {
+        return false;
+    }
+    record->fingerprint = std::strtoull(fields[2].c_str(), &end, 10);
+    if ( fields[2].empty() || *end != '\0' ) {
+        return false;
+    }
+    record->valid = fields[3] == "1";
+    record->identifier = Unescape(fields[4]);
+    record->name = Unescape(fields[5]);
+    record->version = Unescape(fields[6]);
+    record->backend = Unescape(fields[7]);
+    record->quantized = fields[8] == "1";
+    record->inputs = Unescape(fields[9]);
+
+    return SplitLabels(Unescape(fields[10]), &record->labels);
+}
+
+/**
+ * Hashes the relative path, size and modification time of every entry in a bundle's directory
+ * and its subdirectories, in sorted order so that the hash does not depend on the order in which
+ * the file system lists them, and keeps the latest modification time. Symbolic links are not
+ * followed.
+ */
+
+void FingerprintDirectory(const std::string &path, const std::string &relativePath, netrunner::ContentHash *hash, int64_t *modified) {
+    DIR *dir = opendir(path.c_str());
+
+    if ( dir == nullptr ) {
+        return;
+    }
+
+    std::vector<std::string> names;
+
+    while ( struct dirent *entry = readdir(dir) ) {
+        std::string name = entry->d_name;
+        if ( name != "." && name != ".." ) {
+            names.push_back(name);
+        }
+    }
+
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    for ( const std::string &name : names ) {
+        std::string entryPath = path + "/" + name;
+        std::string entryRelativePath = relativePath.empty() ? name : relativePath + "/" + name;
+        struct stat st;
+
+        if ( ::lstat(entryPath.c_str(), &st) != 0 ) {
+            continue;
+        }
+
+        int64_t entryModified = ModifiedNanoseconds(st);
+        *modified = std::max(*modified, entryModified);
+
+        hash->update(entryRelativePath)
+            .update(static_cast<uint64_t>(st.st_size))
+            .update(static_cast<uint64_t>(entryModified));
+
+        if ( S_ISDIR(st.st_mode) ) {
+            FingerprintDirectory(entryPath, entryRelativePath, hash, modified);
+        }
+    }
+}
+
+/**
+ * The path and fingerprint of a bundle. A bundle without a model.json will fail to parse.
+ */
+
+BundleRecord Fingerprint(const std::string &directory, const std::string &name) {
+    std::string path = directory + "/" + name;
+    BundleRecord record;
+    record.path = name;
+
+    struct stat st;
+
+    if ( ::stat(path.c_str(), &st) == 0 ) {
+        record.modified = ModifiedNanoseconds(st);
+    }
+
+    netrunner::ContentHash hash;
+    FingerprintDirectory(path, "", &hash, &record.modified);
+    record.fingerprint = hash.value();
+
+    return record;
+}
+
+} // namespace
+
+// MARK: - Manifest
+
+BundleManifest BundleManifest::Load(const std::string &path) {
+    BundleManifest manifest;
+    std::ifstream file(path);
+    std::string line;
+
+    if ( !file || !std::getline(file, line) || line != std::string(kManifestMagic) + "\t" + std::to_string(kVersion) ) {
+        return manifest;
+    }
+
+    std::vector<BundleRecord> records;
+
+    while ( std::getline(file, line) ) {
+        BundleRecord record;
+        if ( !ParseRecord(line, &record) ) {
+            return manifest;
+        }
+        records.push_back(std::move(record));
+    }
+
+    manifest.assign(std::move(records));
+    return manifest;
+}
+
+bool BundleManifest::save(const std::string &path, std::string *error) const {
+    std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::trunc);
+
+    file << kManifestMagic << '\t' << kVersion << '\n';
+
+    for ( const BundleRecord &record : _records ) {
+        file << Escape(record.path) << '\t'
+            << record.modified << '\t'
+            << record.fingerprint << '\t'
+            << (record.valid ? 1 : 0) << '\t'
+            << Escape(record.identifier) << '\t'
+            << Escape(record.name) << '\t'
+            << Escape(record.version) << '\t'
+            << Escape(record.backend) << '\t'
+            << (record.quantized ? 1 : 0) << '\t'
+            << Escape(record.inputs) << '\t'
+            << Escape(JoinLabels(record.labels)) << '\n';
+    }
+
+    file.close();
+
+    if ( !file ) {
+        std::remove(temporaryPath.c_str());
+        SetError(error, "Unable to write bundle manifest at " + temporaryPath);
+        return false;
+    }
+
+    if ( std::rename(temporaryPath.c_str(), path.c_str()) != 0 ) {
+        SetError(error, "Unable to replace bundle manifest at " + path + ": " + std::strerror(errno));
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+const BundleRecord *BundleManifest::find(const std::string &path) const {
+    auto found = _index.find(path);
+    return found == _index.end() ? nullptr : &_records[found->second];
+}
+
+void BundleManifest::assign(std::vector<BundleRecord> records) {
+    _records = std::move(records);
+    _index.clear();
+    _index.reserve(_records.size());
+
+    for ( size_t i = 0; i < _records.size(); i++ ) {
+        _index[_records[i].path] = i;
+    }
+}
+
+bool BundleManifest::operator==(const BundleManifest &other) const {
+    if ( _records.size() != other._records.size() ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < _records.size(); i++ ) {
+        const BundleRecord &a = _records[i];
+        const BundleRecord &b = other._records[i];
+        if ( !a.matches(b) || a.valid != b.valid || a.identifier != b.identifier || a.name != b.name
+            || a.version != b.version || a.backend != b.backend || a.quantized != b.quantized
+            || a.inputs != b.inputs || a.labels != b.labels ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// MARK: - Scanning
+
+bool ScanBundles(const std::string &directory, const BundleManifest &manifest, size_t workers, const ParseBundle &parse, ScanResult *result, std::string *error) {
+    std::vector<std::string> names;
+    DIR *dir = opendir(directory.c_str());
+
+    if ( dir == nullptr ) {
+        SetError(error, "Unable to read models directory " + directory + ": " + std::strerror(errno));
+        return false;
+    }
+
+    while ( struct dirent *entry = readdir(dir) ) {
+        std::string name = entry->d_name;
+        if ( HasSuffix(name, ".tiobundle") || HasSuffix(name, ".tfbundle") ) {
+            names.push_back(name);
+        }
+    }
+
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+
+    // Each worker claims the next bundle, fingerprints it and parses it if the manifest's record
+    // is missing or stale. Records are written to their own slots, so no lock is needed
+
+    std::vector<BundleRecord> records(names.size());
+    std::vector<char> parsedFlags(names.size(), 0);
+    std::atomic<size_t> next(0);
+
+    auto work = [&]() {
+        for ( size_t i = next++; i < names.size(); i = next++ ) {
+            BundleRecord record = Fingerprint(directory, names[i]);
+            const BundleRecord *cached = manifest.find(record.path);
+
+            if ( cached != nullptr && cached->matches(record) ) {
+                records[i] = *cached;
+                continue;
+            }
+
+            record.valid = parse(directory + "/" + names[i], &record);
+            records[i] = std::move(record);
+            parsedFlags[i] = 1;
+        }
+    };
+
+    size_t threads = std::min(std::max<size_t>(1, workers), names.size());
+    std::vector<std::thread> pool;
+
+    for ( size_t i = 1; i < threads; i++ ) {
+        pool.emplace_back(work);
+    }
+
+    work();
+
+    for ( std::thread &thread : pool ) {
+        thread.join();
+    }
+
+    result->records = std::move(records);
+    result->parsedRecords.clear();
+
+    for ( size_t i = 0; i < parsedFlags.size(); i++ ) {
+        if ( parsedFlags[i] ) {
+            result->parsedRecords.push_back(i);
+        }
+    }
+
+    result->parsed = result->parsedRecords.size();
+    result->reused = names.size() - result->parsed;
+
+    return true;
+}
+
+} // namespace bundles
+} // namespace netrunner
@@ -0,0 +1,174 @@
+//
+//  BundleManifest.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef BundleManifest_h
+#define BundleManifest_h
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace netrunner {
+namespace bundles {
+
+/**
+ * What the manifest remembers about a model bundle between launches.
+ *
+ * A bundle is identified by its path relative to the models directory, which survives the app's
+ * container moving when it is updated, and is fingerprinted by a hash of the relative path, size
+ * and modification time of every file and directory in it, at any depth, along with the latest
+ * of those modification times in nanoseconds. Replacing the bundle or adding, removing, replacing
+ * or editing any of its files, e.g. its model file or a labels file in assets, changes the
+ * fingerprint. A scan stats every file of every bundle but reads none of them.
+ *
+ * Valid records also carry a bundle's header, the metadata needed to list and choose a model,
+ * so that listing bundles reads neither model.json nor any labels file.
+ */
+
+struct BundleRecord {
+    std::string path;
+    int64_t modified = 0;
+    uint64_t fingerprint = 0;
+
+    /**
+     * False if the bundle could not be parsed. Invalid bundles are remembered so that they are
+     * not parsed again until they change.
+     */
+
+    bool valid = false;
+
+    std::string identifier;
+    std::string name;
+    std::string version;
+    std::string backend;
+    bool quantized = false;
+
+    /**
+     * A short description of the model's inputs, e.g. "image 224x224x3".
+     */
+
+    std::string inputs;
+
+    /**
+     * The name of each labeled output and the filename of its labels in the bundle's assets.
+     */
+
+    std::vector<std::pair<std::string, std::string>> labels;
+
+    bool matches(const BundleRecord &other) const {
+        return path == other.path && modified == other.modified && fingerprint == other.fingerprint;
+    }
+};
+
+/**
+ * A persistent index of the model bundles in a directory, written after each scan so that the
+ * next scan only parses bundles that are new or have changed.
+ *
+ * The manifest is a versioned text file with one tab separated record per line. A missing,
+ * corrupt or outdated manifest loads as empty and every bundle is parsed again.
+ */
+
+class BundleManifest {
+public:
+    static const int kVersion = 3;
+
+    BundleManifest() {}
+
+    /**
+     * Reads the manifest at path. Never fails: anything that cannot be read is treated as empty.
+     */
+
+    static BundleManifest Load(const std::string &path);
+
+    /**
+     * Writes the manifest to a temporary file and renames it over path, so that an interrupted
+     * write leaves the previous manifest in place.
+     */
+
+    bool save(const std::string &path, std::string *error) const;
+
+    /**
+     * The record for the bundle at a path relative to the models directory, or nullptr if there
+     * is none.
+     */
+
+    const BundleRecord *find(const std::string &path) const;
+
+    /**
+     * Replaces every record in the manifest.
+     */
+
+    void assign(std::vector<BundleRecord> records);
+
+    const std::vector<BundleRecord> &records() const { return _records; }
+
+    bool operator==(const BundleManifest &other) const;
+
+private:
+    std::vector<BundleRecord> _records;
+    std::unordered_map<std::string, size_t> _index;
+};
+
+/**
+ * Called on a worker thread with the full path of each bundle that is new or has changed since
+ * the manifest was written. The record's path and fingerprint are set. Fills in the remaining
+ * fields and returns false if the bundle is not valid.
+ */
+
+using ParseBundle = std::function<bool(const std::string &path, BundleRecord *record)>;
+
+struct ScanResult {
+
+    /**
+     * A record for every bundle in the directory, valid or not, sorted by path.
+     */
+
+    std::vector<BundleRecord> records;
+
+    /**
+     * The number of bundles passed to the parse function, and the number whose records were
+     * taken from the manifest.
+     */
+
+    size_t parsed = 0;
+    size_t reused = 0;
+
+    /**
+     * The indexes in records of the bundles passed to the parse function, in ascending order.
+     */
+
+    std::vector<size_t> parsedRecords;
+};
+
+/**
+ * Finds every .tiobundle and .tfbundle directly inside directory, fingerprints them and parses
+ * those whose records in the manifest are missing or out of date, on up to `workers` threads.
+ * Returns false and sets error if the directory cannot be read.
+ */
+
+bool ScanBundles(const std::string &directory, const BundleManifest &manifest, size_t workers, const ParseBundle &parse, ScanResult *result, std::string *error);
+
+} // namespace bundles
+} // namespace netrunner
+
+#endif /* BundleManifest_h */
@@ -0,0 +1,150 @@
+//
+//  LabelTable.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "LabelTable.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace netrunner {
+namespace bundles {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+std::shared_ptr<LabelTable> LabelTable::Open(const std::string &path, std::string *error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if ( fd < 0 ) {
+        SetError(error, "Unable to open labels at " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat st;
+
+    if ( fstat(fd, &st) != 0 ) {
+        ::close(fd);
+        SetError(error, "Unable to stat labels at " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(st.st_size);
+
+    if ( static_cast<uint64_t>(length) >= std::numeric_limits<uint32_t>::max() ) {
+        ::close(fd);
+        SetError(error, "Labels at " + path + " are too large");
+        return nullptr;
+    }
+
+    std::shared_ptr<LabelTable> table(new LabelTable());
+
+    // An empty file cannot be mapped and has no labels
+
+    if ( length > 0 ) {
+        void *mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+
+        if ( mapping == MAP_FAILED ) {
+            ::close(fd);
+            SetError(error, "Unable to map labels at " + path + ": " + std::strerror(errno));
+            return nullptr;
+        }
+
+        table->_bytes = static_cast<const char*>(mapping);
+        table->_length = length;
+    }
+
+    ::close(fd);
+
+    // Index the start of every line. Each newline starts another line, so a trailing newline
+    // introduces an empty last label and an empty file has one empty label, as in TensorIO
+
+    const char *bytes = table->_bytes;
+    const char *end = bytes + length;
+    std::vector<uint32_t> &offsets = table->_offsets;
+
+    offsets.push_back(0);
+
+    for ( const char *line = bytes; line < end; ) {
+        const char *newline = static_cast<const char*>(std::memchr(line, '\n', static_cast<size_t>(end - line)));
+        if ( newline == nullptr ) {
+            break;
+        }
+        offsets.push_back(static_cast<uint32_t>(newline + 1 - bytes));
+        line = newline + 1;
+    }
+
+    offsets.push_back(static_cast<uint32_t>(length));
+
+    offsets.shrink_to_fit();
+
+    return table;
+}
+
+LabelTable::~LabelTable() {
+    if ( _bytes != nullptr ) {
+        munmap(const_cast<char*>(_bytes), _length);
+    }
+}
+
+LabelView LabelTable::at(size_t index) const {
+    assert(index < size());
+
+    LabelView view;
+    view.data = _bytes == nullptr ? "" : _bytes + _offsets[index];
+
+    // Each line but the last ends at a newline, which is not part of the label. A carriage
+    // return before it is, as it is in TensorIO's labels
+
+    size_t end = _offsets[index + 1];
+    if ( index + 1 < size() ) {
+        end -= 1;
+    }
+
+    view.length = end - _offsets[index];
+    return view;
+}
+
+int64_t LabelTable::indexOf(const std::string &label) const {
+    std::call_once(_hashed, [this]() {
+        _indexes.reserve(size());
+        for ( size_t i = 0; i < size(); i++ ) {
+            _indexes.emplace(at(i).str(), static_cast<int64_t>(i));
+        }
+    });
+
+    auto found = _indexes.find(label);
+    return found == _indexes.end() ? -1 : found->second;
+}
+
+} // namespace bundles
+} // namespace netrunner
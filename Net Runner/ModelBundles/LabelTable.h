@@ -0,0 +1,107 @@
+//
+//  LabelTable.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef LabelTable_h
+#define LabelTable_h
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netrunner {
+namespace bundles {
+
+/**
+ * A non-owning view of a label's bytes inside a mapped labels file.
+ */
+
+struct LabelView {
+    const char *data = nullptr;
+    size_t length = 0;
+
+    std::string str() const { return std::string(data, length); }
+};
+
+/**
+ * A model's label vocabulary, read from a labels file with one label per line, without loading
+ * the labels into memory.
+ *
+ * The file is memory mapped, and opening it builds an index of the offset of each line, four
+ * bytes per label, in a single pass over the bytes. A label is resolved by index in constant
+ * time and is only faulted in when it is read. A 20,000 label vocabulary costs 80KB of index
+ * rather than 20,000 heap allocated strings.
+ *
+ * Lines are split as TensorIO splits a labels file, at every newline and keeping carriage
+ * returns, so that indexes match those of the output's labels. A trailing newline introduces an
+ * empty last label. The table is safe to use from multiple threads once opened.
+ */
+
+class LabelTable {
+public:
+
+    /**
+     * Maps the labels file at path and indexes its lines. Returns nullptr and sets error if the
+     * file cannot be read.
+     */
+
+    static std::shared_ptr<LabelTable> Open(const std::string &path, std::string *error);
+
+    ~LabelTable();
+
+    LabelTable(const LabelTable&) = delete;
+    LabelTable& operator=(const LabelTable&) = delete;
+
+    size_t size() const { return _offsets.size() - 1; }
+
+    /**
+     * The label at index, which must be in range.
+     */
+
+    LabelView at(size_t index) const;
+
+    /**
+     * The index of a label, or -1 if it is not in the table. The first call hashes every label;
+     * use it for reverse lookups, not to resolve a label.
+     */
+
+    int64_t indexOf(const std::string &label) const;
+
+private:
+    LabelTable() = default;
+
+    const char *_bytes = nullptr;
+    size_t _length = 0;
+
+    // The offset of each label's first byte, followed by one past the end of the last label's
+    // line. Each label runs to its successor's offset less the newline
+
+    std::vector<uint32_t> _offsets;
+
+    mutable std::once_flag _hashed;
+    mutable std::unordered_map<std::string, int64_t> _indexes;
+};
+
+} // namespace bundles
+} // namespace netrunner
+
+#endif /* LabelTable_h */
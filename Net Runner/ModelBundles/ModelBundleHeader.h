@@ -0,0 +1,105 @@
+//
+//  ModelBundleHeader.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TIOModelBundle;
+
+/**
+ * The metadata needed to list and choose a model bundle, without its layer descriptions.
+ *
+ * Headers are vended by the `ModelManager` from the bundle manifest, so creating one reads
+ * nothing from disk. The full `TIOModelBundle`, whose construction parses every input and output
+ * and loads every labels file into memory, is only materialized when `bundle` is first accessed,
+ * e.g. when a model is run or its details are shown.
+ *
+ * Labels may be resolved by index without materializing the bundle or its vocabulary. Each labels
+ * file is memory mapped and indexed on first use. See LabelTable.h.
+ *
+ * Headers are safe to use from multiple threads.
+ */
+
+@interface ModelBundleHeader : NSObject
+
+/**
+ * The full path to the model bundle.
+ */
+
+@property (readonly) NSString *path;
+
+@property (readonly) NSString *identifier;
+@property (readonly) NSString *name;
+@property (readonly) NSString *version;
+@property (readonly) NSString *backend;
+@property (readonly) BOOL quantized;
+
+/**
+ * A short description of the model's inputs, e.g. "image 224x224x3".
+ */
+
+@property (readonly) NSString *inputSummary;
+
+/**
+ * The names of the outputs that have labels.
+ */
+
+@property (readonly) NSArray<NSString*> *labeledOutputs;
+
+/**
+ * The model bundle, which is parsed the first time it is accessed and `nil` if the bundle can no
+ * longer be loaded.
+ */
+
+@property (nullable, readonly) TIOModelBundle *bundle;
+
+/**
+ * Designated initializer.
+ *
+ * @param path The full path to the model bundle.
+ * @param labels Maps the name of each labeled output to the filename of its labels in the
+ *  bundle's assets.
+ */
+
+- (instancetype)initWithPath:(NSString*)path identifier:(NSString*)identifier name:(NSString*)name version:(NSString*)version backend:(NSString*)backend quantized:(BOOL)quantized inputSummary:(NSString*)inputSummary labels:(NSDictionary<NSString*,NSString*>*)labels NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * The number of labels for an output, or 0 if it has none or they cannot be read.
+ */
+
+- (NSUInteger)numberOfLabelsForOutput:(NSString*)output;
+
+/**
+ * The label at an index for an output, or `nil` if the output has no labels or the index is out
+ * of range. Only the requested label is copied out of the labels file.
+ */
+
+- (nullable NSString*)labelAtIndex:(NSUInteger)index forOutput:(NSString*)output;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,118 @@
+//
+//  ModelBundleHeader.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "ModelBundleHeader.h"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "LabelTable.h"
+
+@import TensorIO;
+
+using namespace netrunner::bundles;
+
+@implementation ModelBundleHeader {
+    NSDictionary<NSString*,NSString*> *_labels;
+    TIOModelBundle *_bundle;
+    BOOL _materialized;
+
+    // Opened label tables by output name. A table that failed to open is stored as nullptr so
+    // that it is not tried again
+
+    std::unordered_map<std::string, std::shared_ptr<LabelTable>> _tables;
+}
+
+- (instancetype)initWithPath:(NSString*)path identifier:(NSString*)identifier name:(NSString*)name version:(NSString*)version backend:(NSString*)backend quantized:(BOOL)quantized inputSummary:(NSString*)inputSummary labels:(NSDictionary<NSString*,NSString*>*)labels {
+    if ((self=[super init])) {
+        _path = path;
+        _identifier = identifier;
+        _name = name;
+        _version = version;
+        _backend = backend;
+        _quantized = quantized;
+        _inputSummary = inputSummary;
+        _labels = labels.copy;
+        _labeledOutputs = [labels.allKeys sortedArrayUsingSelector:@selector(compare:)];
+    }
+    return self;
+}
+
+- (nullable TIOModelBundle*)bundle {
+    @synchronized (self) {
+        if ( !_materialized ) {
+            _bundle = [[TIOModelBundle alloc] initWithPath:self.path];
+            _materialized = YES;
+
+            if ( _bundle == nil ) {
+                NSLog(@"Unable to load model bundle at path %@", self.path);
+            }
+        }
+        return _bundle;
+    }
+}
+
+// MARK: - Labels
+
+- (std::shared_ptr<LabelTable>)tableForOutput:(NSString*)output {
+    @synchronized (self) {
+        std::string key = output.UTF8String;
+        auto found = _tables.find(key);
+
+        if ( found != _tables.end() ) {
+            return found->second;
+        }
+
+        std::shared_ptr<LabelTable> table;
+        NSString *filename = _labels[output];
+
+        if ( filename != nil ) {
+            NSString *labelsPath = [[self.path stringByAppendingPathComponent:TIOModelAssetsDirectory] stringByAppendingPathComponent:filename];
+            std::string error;
+            table = LabelTable::Open(labelsPath.fileSystemRepresentation, &error);
+
+            if ( table == nullptr ) {
+                NSLog(@"Unable to open labels for output %@ of model %@, error: %s", output, self.identifier, error.c_str());
+            }
+        }
+
+        _tables[key] = table;
+        return table;
+    }
+}
+
+- (NSUInteger)numberOfLabelsForOutput:(NSString*)output {
+    std::shared_ptr<LabelTable> table = [self tableForOutput:output];
+    return table == nullptr ? 0 : table->size();
+}
+
+- (nullable NSString*)labelAtIndex:(NSUInteger)index forOutput:(NSString*)output {
+    std::shared_ptr<LabelTable> table = [self tableForOutput:output];
+
+    if ( table == nullptr || index >= table->size() ) {
+        return nil;
+    }
+
+    LabelView label = table->at(index);
+    return [[NSString alloc] initWithBytes:label.data length:label.length encoding:NSUTF8StringEncoding];
+}
+
+@end
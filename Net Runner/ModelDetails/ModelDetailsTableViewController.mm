@@ -23,6 +23,7 @@
 #import "ModelDetailsJSONViewController.h"
 #import "ImageModelLabelsDatabase.h"
 #import "ImageModelLabelsExportActivityItemProvider.h"
+#import "ImageModelLabelsShardExporter.h"
 #import "ModelManager.h"
 #import "NRFileManager.h"
 
@@ -192,6 +193,28 @@
 }
 
 - (IBAction)shareLabels:(id)sender {
+    
+    UIAlertController *alert = [UIAlertController
+        alertControllerWithTitle:nil
+        message:nil
+        preferredStyle:UIAlertControllerStyleActionSheet];
+    
+    alert.popoverPresentationController.barButtonItem = self.navigationItem.rightBarButtonItem;
+    
+    [alert addAction:[UIAlertAction actionWithTitle:NSLocalizedString(@"Export Images and Labels", @"Share labels alert export button") style:UIAlertActionStyleDefault handler:^(UIAlertAction * _Nonnull action) {
+        [self exportLabels];
+    }]];
+    
+    [alert addAction:[UIAlertAction actionWithTitle:NSLocalizedString(@"Prepare Training Shards", @"Share labels alert training shards button") style:UIAlertActionStyleDefault handler:^(UIAlertAction * _Nonnull action) {
+        [self prepareTrainingShards];
+    }]];
+    
+    [alert addAction:[UIAlertAction actionWithTitle:NSLocalizedString(@"Cancel", @"Share labels alert cancel button") style:UIAlertActionStyleCancel handler:nil]];
+    
+    [self presentViewController:alert animated:YES completion:nil];
+}
+
+- (void)exportLabels {
     ImageModelLabelsDatabase *database = [[ImageModelLabelsDatabase alloc] initWithModel:self.bundle.newModel basepath:NRFileManager.sharedManager.labelDatabasesDirectory];
     
     ImageModelLabelsExportActivityItemProvider *provider = [[ImageModelLabelsExportActivityItemProvider alloc] initWithDatabase:database identifier:self.bundle.identifier];
@@ -201,4 +224,31 @@
     [self presentViewController:vc animated:YES completion:nil];
 }
 
+/**
+ * Writes the labeled images, preprocessed for this model, to shards that a `RecordBatchDataSource`
+ * can train on. Replaces any shards previously prepared for the model.
+ */
+
+- (void)prepareTrainingShards {
+    ImageModelLabelsDatabase *database = [[ImageModelLabelsDatabase alloc] initWithModel:self.bundle.newModel basepath:NRFileManager.sharedManager.labelDatabasesDirectory];
+    NSString *directory = [NRFileManager.sharedManager.trainingShardsDirectory stringByAppendingPathComponent:self.bundle.identifier];
+    
+    ImageModelLabelsShardExporter *exporter = [[ImageModelLabelsShardExporter alloc] initWithDatabase:database];
+    
+    [SVProgressHUD showWithStatus:@"Preparing training shards"];
+    
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        NSError *error;
+        BOOL success = [exporter exportTo:directory error:&error];
+        
+        dispatch_async(dispatch_get_main_queue(), ^{
+            if ( success ) {
+                [SVProgressHUD showSuccessWithStatus:[NSString stringWithFormat:@"Prepared %tu images", exporter.exportedImageCount]];
+            } else {
+                [SVProgressHUD showErrorWithStatus:error.localizedDescription];
+            }
+        });
+    });
+}
+
 @end
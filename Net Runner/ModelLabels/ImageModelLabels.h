@@ -77,16 +77,20 @@ NS_ASSUME_NONNULL_BEGIN
  *
  * Key-value pairs are model and application specific.  The key corresponds to the name of an
  * output layer as they are described in the model.json file. Setting a label for an output that
- * does not exist results in an exception. Values must be serializable to JSON.
+ * does not exist results in an exception.
  *
- * Label types are not currently enforced, so it is up to you to ensure that you associate a label
- * of the correct type with a particular key.
+ * Values must match the output's label type: a string for text labels, an array of numbers for
+ * numeric labels and data for image labels. Types are not enforced here, but labels of the wrong
+ * type will fail to save.
  */
 
 - (void)setLabel:(id)value forKey:(NSString*)key;
 
 /**
  * Saves the values to the database, creating a new row if necessary.
+ *
+ * Each call is its own transaction. When saving many sets of labels, use the database's
+ * `saveLabels:` instead.
  */
 
 - (BOOL)save;
@@ -74,37 +74,7 @@
 }
 
 - (BOOL)save {
-    NSError *JSONError;
-    NSData *data = [NSJSONSerialization dataWithJSONObject:self.labels options:0 error:&JSONError];
-    
-    if (data == nil || JSONError != nil) {
-        NSLog(@"Unable to serialize model labels to JSON for object with identifier %@, error: %@",
-            self.identifier, JSONError);
-        return NO;
-    }
-    
-    if (self.created) {
-        // Perform update
-        NSString *query = @"UPDATE labels SET labels = ? WHERE id = ?";
-        
-        if (![self.database.db executeUpdate:query, data, self.identifier]) {
-            NSLog(@"Unable to save changes to model labels for object with identifier %@, error: %@",
-                self.identifier, self.database.db.lastErrorMessage);
-            return NO;
-        }
-    } else {
-        // Perform create
-        NSString *query = @"INSERT INTO labels (id, labels) VALUES (?, ?)";
-        
-        if (![self.database.db executeUpdate:query, self.identifier, data]) {
-            NSLog(@"Unable to create model labels for object with identifier %@, error: %@",
-                self.identifier, self.database.db.lastErrorMessage);
-            return NO;
-        }
-    }
-    
-    _created = YES;
-    return YES;
+    return [self.database saveLabels:@[self]];
 }
 
 - (BOOL)remove {
@@ -43,7 +43,7 @@ NS_ASSUME_NONNULL_BEGIN
  * A handle to the underlying FMDB resource.
  *
  * Do not make database calls to this resource directly. It is exposed to allow instances of
- * `ImageModelLabels` to manage their own saving and deleting.
+ * `ImageModelLabels` to manage their own deleting.
  */
 
 @property (readonly) FMDatabase *db;
@@ -56,9 +56,13 @@ NS_ASSUME_NONNULL_BEGIN
  * automatically when this object is released.
  *
  * The on-disk database stores label data according to the format specifed in the outputs field
- * of your model's JSON description. Updates to a model that use the same model identifier must
- * not change their output fields. As a matter of practice, updates to a model should not change
- * the input and output fields, only model weights or internal structure.
+ * of your model's JSON description, with a typed column per output layer. See LabelEncoding.h.
+ * Updates to a model that use the same model identifier must not change their output fields,
+ * although new outputs may be added. As a matter of practice, updates to a model should not
+ * change the input and output fields, only model weights or internal structure.
+ *
+ * Databases written by earlier versions of Net Runner, which stored labels as JSON, are migrated
+ * the first time they are opened. Labels that cannot be migrated are kept in a labels_json table.
  */
 
 - (instancetype)initWithModel:(id<TIOModel>)model basepath:(NSString*)basepath NS_DESIGNATED_INITIALIZER;
@@ -102,6 +106,14 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (NSArray<ImageModelLabels*>*)allLabels;
 
+/**
+ * Saves a batch of labels in a single transaction, creating rows as necessary. Either every set
+ * of labels is saved or none are. Returns `NO` if a label does not match its output's type or
+ * the transaction could not be committed.
+ */
+
+- (BOOL)saveLabels:(NSArray<ImageModelLabels*>*)labels;
+
 /**
  * Closes the connection to the database and frees up the underlying mysql resources.
  *
@@ -21,56 +21,180 @@
 #import "ImageModelLabelsDatabase.h"
 #import "ImageModelLabels.h"
 
+#include <vector>
+
+#include "LabelEncoding.h"
+
 @import TensorIO;
 @import FMDB;
 
+using namespace netrunner::labels;
+
+/**
+ * The database marks labels as created once they have been saved.
+ */
+
+@interface ImageModelLabels (Database)
+
+- (void)setCreated:(BOOL)created;
+
+@end
+
 NSString * _Nonnull  ImageModelLabelsDatabasePath(NSString * _Nonnull  basepath, TIOModelBundle * _Nonnull model) {
     return [basepath stringByAppendingPathComponent:model.identifier];
 }
 
-NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
-    NSMutableDictionary *placeholders = [[NSMutableDictionary alloc] init];
+/**
+ * One typed column per output layer, in the order the model describes them.
+ */
+
+static std::vector<Column> LabelColumnsForModel(id<TIOModel> _Nonnull model) {
+    std::vector<Column> columns;
     
     for ( TIOLayerInterface *layer in model.io.outputs.all) {
+        __block LabelType type = LabelType::Text;
+        
         [layer matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
-                // Image buffer: currently unsupported
-                placeholders[layer.name] = [NSData data];
+            // Image buffer: currently unsupported
+            type = LabelType::Data;
         } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
-            if ( vectorDescription.labels == nil ) {
-                // Float values
-                placeholders[layer.name] = @[];
-            } else {
-                // Text label
-                placeholders[layer.name] = @"";
-            }
+            // Float values or text label
+            type = vectorDescription.labels == nil ? LabelType::Floats : LabelType::Text;
         } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
             // Text label
-            placeholders[layer.name] = @"";
+            type = LabelType::Text;
         }];
+        
+        columns.push_back({layer.name.UTF8String, type});
+    }
+    
+    return columns;
+}
+
+static id _Nonnull PlaceholderLabelForType(LabelType type) {
+    switch ( type ) {
+    case LabelType::Text:
+        return @"";
+    case LabelType::Floats:
+        return @[];
+    case LabelType::Data:
+        return [NSData data];
+    }
+}
+
+NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
+    NSMutableDictionary *placeholders = [[NSMutableDictionary alloc] init];
+    
+    for ( const Column &column : LabelColumnsForModel(model) ) {
+        placeholders[@(column.name.c_str())] = PlaceholderLabelForType(column.type);
     }
     
     return placeholders;
 }
 
+/**
+ * Encodes a label for its column: text as is, numbers as packed little-endian float32 values
+ * (see `EncodeFloats`) and data as is. Returns nil if the value does not match the column's type.
+ */
+
+static id _Nullable EncodedLabel(id _Nullable value, LabelType type) {
+    if ( value == nil ) {
+        return NSNull.null;
+    }
+    
+    switch ( type ) {
+    case LabelType::Text:
+        return [value isKindOfClass:NSString.class] ? value : nil;
+    
+    case LabelType::Data:
+        return [value isKindOfClass:NSData.class] ? value : nil;
+    
+    case LabelType::Floats: {
+        if ( ![value isKindOfClass:NSArray.class] ) {
+            return nil;
+        }
+        
+        NSArray *numbers = (NSArray*)value;
+        NSMutableData *data = [[NSMutableData alloc] initWithLength:numbers.count * sizeof(float)];
+        float *floats = (float*)data.mutableBytes;
+        
+        for ( NSUInteger i = 0; i < numbers.count; i++ ) {
+            if ( ![numbers[i] isKindOfClass:NSNumber.class] ) {
+                return nil;
+            }
+            floats[i] = [numbers[i] floatValue];
+        }
+        
+        return data;
+    }
+    }
+}
+
+/**
+ * Decodes the label in a result column, or returns nil if it is corrupt. NULL columns, which
+ * belong to outputs added after a row was written, decode to placeholders.
+ */
+
+static id _Nullable DecodedLabel(FMResultSet * _Nonnull results, int index, LabelType type, std::vector<float> &floats) {
+    if ( [results columnIndexIsNull:index] ) {
+        return PlaceholderLabelForType(type);
+    }
+    
+    switch ( type ) {
+    case LabelType::Text:
+        return [results stringForColumnIndex:index];
+    
+    case LabelType::Data:
+        return [results dataForColumnIndex:index];
+    
+    case LabelType::Floats: {
+        NSData *data = [results dataNoCopyForColumnIndex:index];
+        
+        if ( !DecodeFloats(data.bytes, data.length, &floats) ) {
+            return nil;
+        }
+        
+        NSMutableArray<NSNumber*> *numbers = [[NSMutableArray alloc] initWithCapacity:floats.size()];
+        for ( float value : floats ) {
+            [numbers addObject:@(value)];
+        }
+        
+        return numbers;
+    }
+    }
+}
+
 @interface ImageModelLabelsDatabase()
 
 @property (readwrite) FMDatabase *db;
 
 @end
 
-@implementation ImageModelLabelsDatabase
+@implementation ImageModelLabelsDatabase {
+    std::vector<Column> _columns;
+    NSArray<NSString*> *_keys;
+    NSString *_upsertQuery;
+    NSString *_selectQuery;
+    NSString *_selectAllQuery;
+}
 
 + (BOOL)removeDatabaseForModel:(TIOModelBundle*)model basepath:(NSString*)basepath {
     NSString *path = ImageModelLabelsDatabasePath(basepath, model);
-    NSError *error;
     
-    if (![NSFileManager.defaultManager fileExistsAtPath:path]) {
-        return YES;
-    }
+    // Remove the write-ahead log and its index along with the database
     
-    if (![NSFileManager.defaultManager removeItemAtPath:path error:&error]) {
-        NSLog(@"Unable to remove the database at path %@, error: %@", path, error);
-        return NO;
+    for ( NSString *suffix in @[@"", @"-wal", @"-shm"] ) {
+        NSString *filepath = [path stringByAppendingString:suffix];
+        NSError *error;
+        
+        if (![NSFileManager.defaultManager fileExistsAtPath:filepath]) {
+            continue;
+        }
+        
+        if (![NSFileManager.defaultManager removeItemAtPath:filepath error:&error]) {
+            NSLog(@"Unable to remove the database at path %@, error: %@", filepath, error);
+            return NO;
+        }
     }
     
     return YES;
@@ -90,6 +214,17 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
 - (instancetype)initWithModel:(id<TIOModel>)model basepath:(NSString*)basepath {
     if ((self=[super init])) {
         _model = model;
+        _columns = LabelColumnsForModel(model);
+        
+        NSMutableArray<NSString*> *keys = [[NSMutableArray alloc] initWithCapacity:_columns.size()];
+        for ( const Column &column : _columns ) {
+            [keys addObject:@(column.name.c_str())];
+        }
+        
+        _keys = keys.copy;
+        _upsertQuery = @(UpsertStatement(_columns).c_str());
+        _selectQuery = @(SelectStatement(_columns, true).c_str());
+        _selectAllQuery = @(SelectStatement(_columns, false).c_str());
         
         NSString *path = ImageModelLabelsDatabasePath(basepath, model.bundle);
         
@@ -107,7 +242,13 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
     return self;
 }
 
-- (nullable FMDatabase*)openDatabase:(NSString*)path model:(id<TIOModel>)model {
+/**
+ * Opens the database in write-ahead logging mode, so that readers do not block a writer and a
+ * commit appends to the log rather than rewriting pages in place, and caches prepared statements.
+ * A sync at each checkpoint rather than each commit is durable enough for labels.
+ */
+
+- (nullable FMDatabase*)connectDatabase:(NSString*)path {
     FMDatabase *database = [[FMDatabase alloc] initWithPath:path];
     
     if (![database open]) {
@@ -115,25 +256,53 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
         return nil;
     }
     
+    if (![database executeStatements:@"PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;"]) {
+        NSLog(@"Unable to configure database at path %@, error: %@", path, database.lastErrorMessage);
+        [database close];
+        return nil;
+    }
+    
+    database.shouldCacheStatements = YES;
+    
     return database;
 }
 
-- (nullable FMDatabase*)createDatabase:(NSString*)path model:(id<TIOModel>)model {
-    FMDatabase *database = [[FMDatabase alloc] initWithPath:path];
+- (nullable FMDatabase*)openDatabase:(NSString*)path model:(id<TIOModel>)model {
+    FMDatabase *database = [self connectDatabase:path];
     
-    if (![database open]) {
-        NSLog(@"Unable to open database at path %@, error: %@", path, database.lastErrorMessage);
+    if (!database) {
+        return nil;
+    }
+    
+    if ( database.userVersion == kSchemaVersion ) {
+        if (![self addMissingColumnsToDatabase:database]) {
+            NSLog(@"Unable to add label columns to database at path %@, error: %@", path, database.lastErrorMessage);
+            [database close];
+            return nil;
+        }
+    } else if ( [database tableExists:@(kTableName)] ) {
+        if (![self migrateJSONLabelsInDatabase:database]) {
+            NSLog(@"Unable to migrate labels in database at path %@, error: %@", path, database.lastErrorMessage);
+            [database close];
+            return nil;
+        }
+    } else if (![self createLabelsTableInDatabase:database]) {
+        NSLog(@"Unable to create labels table for database at path %@, error: %@", path, database.lastErrorMessage);
+        [database close];
         return nil;
     }
     
-    // Create Labels Table
+    return database;
+}
+
+- (nullable FMDatabase*)createDatabase:(NSString*)path model:(id<TIOModel>)model {
+    FMDatabase *database = [self connectDatabase:path];
     
-    NSString *createLabelsQuery =
-        @"CREATE TABLE labels ("
-         "id TEXT PRIMARY KEY, "
-         "labels BLOB NOT NULL )";
+    if (!database) {
+        return nil;
+    }
     
-    if (![database executeUpdate:createLabelsQuery]) {
+    if (![self createLabelsTableInDatabase:database]) {
         NSLog(@"Unable to create labels table for database at path %@, error: %@", path, database.lastErrorMessage);
         [database close];
         return nil;
@@ -142,9 +311,153 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
     return database;
 }
 
+- (BOOL)createLabelsTableInDatabase:(FMDatabase*)database {
+    if (![database executeUpdate:@(CreateTableStatement(_columns).c_str())]) {
+        return NO;
+    }
+    
+    database.userVersion = kSchemaVersion;
+    return YES;
+}
+
+/**
+ * Outputs may be added to a model without changing its identifier. Rows written before then
+ * read placeholders for the new outputs.
+ */
+
+- (BOOL)addMissingColumnsToDatabase:(FMDatabase*)database {
+    for ( const Column &column : _columns ) {
+        if ( [database columnExists:@(ColumnName(column.name).c_str()) inTableWithName:@(kTableName)] ) {
+            continue;
+        }
+        if (![database executeUpdate:@(AddColumnStatement(column).c_str())]) {
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
+/**
+ * Moves labels from the original schema, which stored each image's labels as a JSON blob, into
+ * typed columns. The migration runs in a single transaction and leaves the database untouched
+ * if it fails. Rows that cannot be decoded or do not match the model's outputs are kept in the
+ * labels_json table rather than dropped, which is only removed once every row has moved.
+ */
+
+- (BOOL)migrateJSONLabelsInDatabase:(FMDatabase*)database {
+    if (![database beginTransaction]) {
+        return NO;
+    }
+    
+    BOOL migrated = [database executeUpdate:@"ALTER TABLE labels RENAME TO labels_json"]
+        && [self createLabelsTableInDatabase:database]
+        && [self copyJSONLabelsInDatabase:database]
+        && [database executeUpdate:@"DELETE FROM labels_json WHERE id IN (SELECT id FROM labels)"];
+    
+    if (!migrated) {
+        [database rollback];
+        return NO;
+    }
+    
+    FMResultSet *results = [database executeQuery:@"SELECT COUNT(*) FROM labels_json"];
+    
+    if (results == nil || !results.next) {
+        [results close];
+        [database rollback];
+        return NO;
+    }
+    
+    int unmigrated = [results intForColumnIndex:0];
+    [results close];
+    
+    if ( unmigrated == 0 && ![database executeUpdate:@"DROP TABLE labels_json"] ) {
+        [database rollback];
+        return NO;
+    }
+    
+    if ( unmigrated != 0 ) {
+        NSLog(@"Kept %d labels that could not be migrated in the labels_json table", unmigrated);
+    }
+    
+    return [database commit];
+}
+
+- (BOOL)copyJSONLabelsInDatabase:(FMDatabase*)database {
+    FMResultSet *results = [database executeQuery:@"SELECT id, labels FROM labels_json"];
+    
+    if (results == nil) {
+        return NO;
+    }
+    
+    NSDictionary *placeholders = PlaceholderLabelsForModel(self.model);
+    NSMutableArray *arguments = [[NSMutableArray alloc] initWithCapacity:_columns.size() + 1];
+    
+    while (results.next) {
+        NSString *identifier = [results stringForColumnIndex:0];
+        NSData *data = [results dataForColumnIndex:1];
+        NSError *JSONError;
+        
+        NSDictionary *dictionary = data == nil ? nil : [NSJSONSerialization JSONObjectWithData:data options:0 error:&JSONError];
+        
+        if ( ![dictionary isKindOfClass:NSDictionary.class] ) {
+            NSLog(@"Unable to deserialize labels while migrating object with identifier %@, error: %@, keeping it unmigrated",
+                identifier, JSONError);
+            continue;
+        }
+        
+        NSMutableDictionary *labels = placeholders.mutableCopy;
+        [labels addEntriesFromDictionary:dictionary];
+        
+        [arguments removeAllObjects];
+        
+        if (![self appendArgumentsForLabels:labels identifier:identifier to:arguments]) {
+            NSLog(@"Labels for object with identifier %@ do not match the model's outputs, keeping it unmigrated", identifier);
+            continue;
+        }
+        
+        if (![database executeUpdate:_upsertQuery withArgumentsInArray:arguments]) {
+            [results close];
+            return NO;
+        }
+    }
+    
+    [results close];
+    return YES;
+}
+
+// MARK: - Reading and Writing
+
+- (BOOL)appendArgumentsForLabels:(NSDictionary*)labels identifier:(NSString*)identifier to:(NSMutableArray*)arguments {
+    [arguments addObject:identifier];
+    
+    for ( NSUInteger i = 0; i < _keys.count; i++ ) {
+        id value = EncodedLabel(labels[_keys[i]], _columns[i].type);
+        if ( value == nil ) {
+            return NO;
+        }
+        [arguments addObject:value];
+    }
+    
+    return YES;
+}
+
+- (nullable NSDictionary*)labelsFromResults:(FMResultSet*)results floats:(std::vector<float>&)floats {
+    NSMutableDictionary *labels = [[NSMutableDictionary alloc] initWithCapacity:_keys.count];
+    
+    for ( NSUInteger i = 0; i < _keys.count; i++ ) {
+        id value = DecodedLabel(results, (int)i + 1, _columns[i].type, floats);
+        if ( value == nil ) {
+            return nil;
+        }
+        labels[_keys[i]] = value;
+    }
+    
+    return labels;
+}
+
 - (ImageModelLabels*)labelsForImageWithID:(NSString*)identifier {
-    NSString *query = @"SELECT * FROM labels WHERE id = ?";
-    FMResultSet *results = [self.db executeQuery:query, identifier];
+    FMResultSet *results = [self.db executeQuery:_selectQuery, identifier];
     
     if (results == nil) {
         NSLog(@"Error executing labels select query, error: %@", self.db.lastErrorMessage);
@@ -153,27 +466,20 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
     
     if (!results.next) {
         // No results, return a placeholder object
+        [results close];
         NSDictionary *placeholders = PlaceholderLabelsForModel(self.model);
         ImageModelLabels *labels = [[ImageModelLabels alloc] initWithDatabase:self identifier:identifier labels:placeholders isCreated:NO];
         return labels;
     }
     
-    // Read labels from result, deserialize, and return an instance
-    
-    NSData *data = [results objectForColumn:@"labels"];
-    
-    if (data == nil) {
-        NSLog(@"Unable to read labels from select results for object with identifier %@, error: %@",
-            identifier, self.db.lastErrorMessage);
-        return nil;
-    }
+    // Read labels from result, decode, and return an instance
     
-    NSError *JSONError;
-    NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:data options:0 error:&JSONError];
+    std::vector<float> floats;
+    NSDictionary *dictionary = [self labelsFromResults:results floats:floats];
+    [results close];
     
     if (dictionary == nil) {
-        NSLog(@"Unable to deserialize labels from select results for object with identifier %@, error: %@",
-            identifier, JSONError);
+        NSLog(@"Unable to decode labels from select results for object with identifier %@", identifier);
         return nil;
     }
     
@@ -182,8 +488,7 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
 }
 
 - (NSArray<ImageModelLabels*>*)allLabels {
-    NSString *query = @"SELECT * FROM labels";
-    FMResultSet *results = [self.db executeQuery:query];
+    FMResultSet *results = [self.db executeQuery:_selectAllQuery];
     
     if (results == nil) {
         NSLog(@"Error executing labels select query, error: %@", self.db.lastErrorMessage);
@@ -191,23 +496,14 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
     }
     
     NSMutableArray<ImageModelLabels*> *allLabels = [[NSMutableArray alloc] init];
+    std::vector<float> floats;
     
     while (results.next) {
-        NSString *identifier = [results objectForColumn:@"id"];
-        NSData *data = [results objectForColumn:@"labels"];
-        
-        if (data == nil) {
-            NSLog(@"Unable to read labels from select results for object with identifier %@, error: %@",
-                identifier, self.db.lastErrorMessage);
-            continue;
-        }
-        
-        NSError *JSONError;
-        NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:data options:0 error:&JSONError];
+        NSString *identifier = [results stringForColumnIndex:0];
+        NSDictionary *dictionary = [self labelsFromResults:results floats:floats];
         
         if (dictionary == nil) {
-            NSLog(@"Unable to deserialize labels from select results for object with identifier %@, error: %@",
-                identifier, JSONError);
+            NSLog(@"Unable to decode labels from select results for object with identifier %@", identifier);
             continue;
         }
         
@@ -219,6 +515,45 @@ NSDictionary * _Nonnull PlaceholderLabelsForModel(id<TIOModel> _Nonnull model) {
     return allLabels.copy;
 }
 
+- (BOOL)saveLabels:(NSArray<ImageModelLabels*>*)labels {
+    if (![self.db beginTransaction]) {
+        NSLog(@"Unable to begin transaction to save model labels, error: %@", self.db.lastErrorMessage);
+        return NO;
+    }
+    
+    NSMutableArray *arguments = [[NSMutableArray alloc] initWithCapacity:_columns.size() + 1];
+    
+    for ( ImageModelLabels *label in labels ) {
+        [arguments removeAllObjects];
+        
+        if (![self appendArgumentsForLabels:label.labels identifier:label.identifier to:arguments]) {
+            NSLog(@"Unable to encode model labels for object with identifier %@, a label does not match its output's type",
+                label.identifier);
+            [self.db rollback];
+            return NO;
+        }
+        
+        if (![self.db executeUpdate:_upsertQuery withArgumentsInArray:arguments]) {
+            NSLog(@"Unable to save model labels for object with identifier %@, error: %@",
+                label.identifier, self.db.lastErrorMessage);
+            [self.db rollback];
+            return NO;
+        }
+    }
+    
+    if (![self.db commit]) {
+        NSLog(@"Unable to commit model labels, error: %@", self.db.lastErrorMessage);
+        [self.db rollback];
+        return NO;
+    }
+    
+    for ( ImageModelLabels *label in labels ) {
+        [label setCreated:YES];
+    }
+    
+    return YES;
+}
+
 - (void)close {
     [_db close];
 }
@@ -21,7 +21,6 @@
 @import Foundation;
 @import Photos;
 
-@import SSZipArchive;
 @import TensorIO;
 
 NS_ASSUME_NONNULL_BEGIN
@@ -49,11 +48,33 @@ NS_ASSUME_NONNULL_BEGIN
 - (id)init NS_UNAVAILABLE;
 
 /**
- * Exports the contents of the database to the designated location.
+ * Exports the contents of the database to a zip archive at the designated location.
+ *
+ * Images are fetched and encoded on a pool of worker threads and streamed straight into the
+ * archive in the order of their labels, so that the archive is the only file written. Images are
+ * stored without further compression, and the labels.json entry is compressed as it is built.
  */
 
 - (BOOL)exportTo:(NSString*)path;
 
+/**
+ * The number of images written by the last export.
+ */
+
+@property (readonly) NSUInteger exportedImageCount;
+
+/**
+ * The time the last export took, in seconds.
+ */
+
+@property (readonly) NSTimeInterval exportDuration;
+
+/**
+ * The size of the last export's archive in bytes, which is also the most disk space it used.
+ */
+
+@property (readonly) unsigned long long exportSize;
+
 @end
 
 NS_ASSUME_NONNULL_END
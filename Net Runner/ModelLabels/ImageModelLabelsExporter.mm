@@ -22,6 +22,14 @@
 #import "ImageModelLabelsDatabase.h"
 #import "ImageModelLabels.h"
 
+#include <algorithm>
+#include <string>
+
+#include "OrderedPipeline.h"
+#include "ZipWriter.h"
+
+using namespace netrunner;
+
 #define IMAGE_SIZE 512
 
 NSString * PathSafeString(NSString * string) {
@@ -30,8 +38,22 @@ NSString * PathSafeString(NSString * string) {
         stringByReplacingOccurrencesOfString:@":" withString:@"-"];
 }
 
+/**
+ * An encoded image on its way from a worker to the archive. The jpeg is nil if the image could
+ * not be fetched or encoded.
+ */
+
+struct ExportedImage {
+    NSString *identifier;
+    NSData *jpeg;
+};
+
 @interface ImageModelLabelsExporter()
 
+@property (readwrite) NSUInteger exportedImageCount;
+@property (readwrite) NSTimeInterval exportDuration;
+@property (readwrite) unsigned long long exportSize;
+
 @end
 
 @implementation ImageModelLabelsExporter
@@ -76,99 +98,121 @@ NSString * PathSafeString(NSString * string) {
 }
 
 - (BOOL)exportTo:(NSString*)path {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    
     NSArray<ImageModelLabels*> *labels = self.database.allLabels;
     NSMutableArray<NSString*> *identifiers = [[NSMutableArray alloc] init];
     NSMutableDictionary<NSString*,ImageModelLabels*> *labelsByIdentifier = [[NSMutableDictionary alloc] init];
     
-    NSMutableArray<NSDictionary*> *labelDictionaries = [[NSMutableArray alloc] init];
-    
-    // Prepare a temporary directory to hold our contents
-    
-    NSError *fileError;
-    NSURL *tmpDirectory = [NSURL fileURLWithPath:NSTemporaryDirectory() isDirectory:YES];
-    tmpDirectory = [tmpDirectory URLByAppendingPathComponent:NSProcessInfo.processInfo.globallyUniqueString];
-    
-    if (![NSFileManager.defaultManager createDirectoryAtURL:tmpDirectory withIntermediateDirectories:YES attributes:nil error:&fileError]) {
-        NSLog(@"Unable to create temporary destination directory for export at path %@, error: %@", tmpDirectory, fileError);
-        return NO;
-    }
-    
     // Iterate through each set of labels, noting the identifiers and mapping from identifier to labels
     
     // The identifiers array will be used to request image assets. Because the photo library may
     // return fewer image assets than we have identifiers for (in case an image has been deleted),
-    // only include labels for the available images in the final labelDictionaries dict that is
-    // converted to JSON.
+    // only include labels for the available images in the labels.json entry.
     
     for (ImageModelLabels *label in labels) {
         [identifiers addObject:label.identifier];
         labelsByIdentifier[label.identifier] = label;
     }
     
-    // Acquire the image assets and write them out
+    PHFetchResult<PHAsset *> *fetchResult = [PHAsset fetchAssetsWithLocalIdentifiers:identifiers options:ImageModelLabelsExporter.fetchOptions];
+    NSArray<PHAsset*> *assets = [fetchResult objectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, fetchResult.count)]];
+    
+    // Stream the images and labels into the archive
+    
+    std::string zipError;
+    std::unique_ptr<ZipWriter> writer = ZipWriter::Create(path.fileSystemRepresentation, &zipError);
+    
+    if (writer == nullptr) {
+        NSLog(@"Could not create zip file at path %@, error: %s", path, zipError.c_str());
+        return NO;
+    }
     
-    PHFetchResult<PHAsset *> *assets = [PHAsset fetchAssetsWithLocalIdentifiers:identifiers options:ImageModelLabelsExporter.fetchOptions];
+    DeflatedEntry labelsJSON;
+    labelsJSON.append("[");
     
     PHImageRequestOptions *imageRequestOptions = ImageModelLabelsExporter.imageRequestOptions;
     CGSize size = CGSizeMake(IMAGE_SIZE, IMAGE_SIZE); // PHImageManagerMaximumSize
     PHImageContentMode contentMode = PHImageContentModeAspectFit; // PHImageContentModeAspectFill
     
-    [assets enumerateObjectsUsingBlock:^(PHAsset * _Nonnull asset, NSUInteger idx, BOOL * _Nonnull stop) {
-        [[PHImageManager defaultManager]
-            requestImageForAsset:asset
-            targetSize:size
-            contentMode:contentMode
-            options:imageRequestOptions
-            resultHandler:^(UIImage *result, NSDictionary *info) {
+    // Fetching and encoding are mostly CPU bound, keep a few images in flight per worker so that
+    // a slow fetch, e.g. of an image in iCloud, does not stall the others
+    
+    size_t workers = std::max<size_t>(2, NSProcessInfo.processInfo.activeProcessorCount);
+    OrderedPipeline<ExportedImage> pipeline({workers, workers * 2});
+    NSUInteger written = 0;
+    
+    bool completed = pipeline.run(assets.count, [&](size_t index) -> ExportedImage {
+        @autoreleasepool {
+            PHAsset *asset = assets[index];
+            __block NSData *jpeg = nil;
+            
+            // The request is synchronous, the handler is called before it returns
             
-                // Write the image
-                
-                NSString *imageFilename = [NSString stringWithFormat:@"%@.jpg", PathSafeString(asset.localIdentifier)];
-                NSURL *imageFilepath = [tmpDirectory URLByAppendingPathComponent:imageFilename];
-                NSData *imageData = UIImageJPEGRepresentation(result, 1.0);
-                NSError *imageError;
-                
-                if (![imageData writeToURL:imageFilepath options:NSDataWritingAtomic error:&imageError]) {
-                    NSLog(@"Could not write image with identifier %@ to file, error: %@", asset.localIdentifier, imageData);
-                } else {
-                    // Prepare the JSON entry for the final labelDictionaries dict
-                    ImageModelLabels *label = labelsByIdentifier[asset.localIdentifier];
-                    NSMutableDictionary *l = label.labels.mutableCopy;
-                    l[@"id"] = PathSafeString(label.identifier);
-                    [labelDictionaries addObject:l.copy];
+            [[PHImageManager defaultManager]
+                requestImageForAsset:asset
+                targetSize:size
+                contentMode:contentMode
+                options:imageRequestOptions
+                resultHandler:^(UIImage *result, NSDictionary *info) {
+                    jpeg = result == nil ? nil : UIImageJPEGRepresentation(result, 1.0);
                 }
+            ];
+            
+            return {asset.localIdentifier, jpeg};
+        }
+    }, [&](size_t index, ExportedImage &image) -> bool {
+        @autoreleasepool {
+            if (image.jpeg == nil) {
+                NSLog(@"Could not fetch or encode image with identifier %@, skipping", image.identifier);
+                return true;
             }
-        ];
-    }];
-    
-    // Write the JSON entry (labelDictionaries)
-    
-    NSError *JSONError;
-    NSData *JSON = [NSJSONSerialization dataWithJSONObject:labelDictionaries options:NSJSONWritingPrettyPrinted error:&JSONError];
-    
-    if (JSONError) {
-        NSLog(@"Could not serialize labels to JSON, error: %@", JSONError);
-        return NO;
-    }
-    
-    NSURL *JSONFilepath = [tmpDirectory URLByAppendingPathComponent:@"labels.json"];
-    NSError *writeError;
+            
+            // Write the image
+            
+            std::string imageFilename = [NSString stringWithFormat:@"%@.jpg", PathSafeString(image.identifier)].UTF8String;
+            
+            if (!writer->add(imageFilename, image.jpeg.bytes, image.jpeg.length, &zipError)) {
+                NSLog(@"Could not write image with identifier %@ to zip file, error: %s", image.identifier, zipError.c_str());
+                return false;
+            }
+            
+            // Append its entry to labels.json
+            
+            ImageModelLabels *label = labelsByIdentifier[image.identifier];
+            NSMutableDictionary *l = label.labels.mutableCopy;
+            l[@"id"] = PathSafeString(label.identifier);
+            
+            NSError *JSONError;
+            NSData *JSON = [NSJSONSerialization dataWithJSONObject:l options:0 error:&JSONError];
+            
+            if (JSON == nil) {
+                NSLog(@"Could not serialize labels to JSON, error: %@", JSONError);
+                return false;
+            }
+            
+            labelsJSON.append(written == 0 ? "\n" : ",\n");
+            labelsJSON.append(JSON.bytes, JSON.length);
+            written += 1;
+            
+            return true;
+        }
+    });
     
-    [JSON writeToURL:JSONFilepath options:NSDataWritingAtomic error:&writeError];
+    labelsJSON.append(written == 0 ? "]\n" : "\n]\n");
     
-    if (writeError) {
-        NSLog(@"Could not write JSON to file, error: %@", writeError);
+    if (!completed || !writer->add("labels.json", labelsJSON, &zipError) || !writer->close(&zipError)) {
+        NSLog(@"Could not create zip file at path %@, error: %s", path, zipError.c_str());
+        writer.reset();
+        [NSFileManager.defaultManager removeItemAtPath:path error:nil];
         return NO;
     }
     
-    // Zip the contents of the directory
-    
-    BOOL zipped = [SSZipArchive createZipFileAtPath:path withContentsOfDirectory:tmpDirectory.path];
+    self.exportedImageCount = written;
+    self.exportDuration = CFAbsoluteTimeGetCurrent() - start;
+    self.exportSize = writer->size();
     
-    if (!zipped) {
-        NSLog(@"Could not create zip file of contents at path %@ to %@", tmpDirectory.path, path);
-        return NO;
-    }
+    NSLog(@"Exported %tu labeled images in %.2fs, %.1f MB on disk", written, self.exportDuration, self.exportSize / 1e6);
     
     return YES;
 }
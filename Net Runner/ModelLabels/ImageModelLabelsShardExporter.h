@@ -0,0 +1,109 @@
+//
+//  ImageModelLabelsShardExporter.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class ImageModelLabelsDatabase;
+
+/**
+ * Exports the contents of a labels database as training shards that are already preprocessed
+ * for the database's model.
+ *
+ * Each labeled image is run once through the model's input pipeline, resized, converted to the
+ * input's pixel format, normalized and, for quantized models, quantized, and written as a tensor
+ * to a directory of record file shards along with its labels. See RecordShards.h. Open the
+ * directory with a `RecordBatchDataSource` to train on the shards without decoding or resizing
+ * images on every epoch.
+ *
+ * Each record has a field for the model's image input, a field for each output, named after the
+ * layers, and an "id" field with the image's identifier:
+ *
+ * - Labeled vector outputs are stored as one-hot float32 tensors
+ * - Unlabeled vector outputs are stored as float32 tensors
+ * - String outputs are stored as utf8 blobs
+ * - Image outputs are not exported
+ *
+ * Images whose labels are incomplete or do not match the model's outputs are skipped.
+ */
+
+@interface ImageModelLabelsShardExporter : NSObject
+
+/**
+ * The database that is being exported.
+ */
+
+@property (readonly) ImageModelLabelsDatabase *database;
+
+/**
+ * The size in bytes at which a new shard is started. Defaults to 64 MB.
+ */
+
+@property unsigned long long maxShardSize;
+
+/**
+ * Designated initializer.
+ */
+
+- (instancetype)initWithDatabase:(ImageModelLabelsDatabase*)database NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Exports the contents of the database to a directory of shards, replacing any shards already
+ * in it. The database's model must have exactly one image input.
+ *
+ * Images are fetched and preprocessed on a pool of worker threads and written in the order of
+ * their labels.
+ *
+ * @param directory The directory the shards are written to, created if necessary.
+ * @param error Set if the model is not supported or the shards could not be written.
+ *
+ * @return BOOL `YES` if the export succeeded, `NO` otherwise.
+ */
+
+- (BOOL)exportTo:(NSString*)directory error:(NSError**)error;
+
+/**
+ * The number of images written by the last export.
+ */
+
+@property (readonly) NSUInteger exportedImageCount;
+
+/**
+ * The time the last export took, in seconds.
+ */
+
+@property (readonly) NSTimeInterval exportDuration;
+
+/**
+ * The size of the last export's shards in bytes.
+ */
+
+@property (readonly) unsigned long long exportSize;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,350 @@
+//
+//  ImageModelLabelsShardExporter.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "ImageModelLabelsShardExporter.h"
+#import "ImageModelLabelsDatabase.h"
+#import "ImageModelLabels.h"
+#import "RecordTensor.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "OrderedPipeline.h"
+#include "RecordShards.h"
+
+@import Photos;
+@import TensorIO;
+@import UIKit;
+
+using namespace netrunner;
+using namespace netrunner::records;
+
+// MARK: - Errors
+
+static NSString * const NetRunnerImageModelLabelsShardExporterErrorDomain = @"ai.doc.net-runner.image-model-labels-shard-exporter";
+
+static const NSInteger NetRunnerImageModelLabelsShardExporterUnsupportedModelErrorCode = 101;
+static const NSInteger NetRunnerImageModelLabelsShardExporterWriteErrorCode = 102;
+
+NSError * NetRunnerImageModelLabelsShardExporterUnsupportedModelError(NSString *identifier);
+NSError * NetRunnerImageModelLabelsShardExporterWriteError(NSString *path, NSString *description);
+
+// MARK: -
+
+/**
+ * How the labels for one of the model's outputs are written to its field.
+ */
+
+enum class ShardOutputEncoding {
+    OneHot,
+    Floats,
+    Text
+};
+
+struct ShardOutput {
+    NSString *name;
+    ShardOutputEncoding encoding;
+    NSArray<NSString*> *labels;
+    NSUInteger length;
+};
+
+/**
+ * A preprocessed image on its way from a worker to the shards. The tensor is nil if the image
+ * could not be fetched or preprocessed.
+ */
+
+struct PreprocessedImage {
+    NSString *identifier;
+    NSData *tensor;
+};
+
+/**
+ * Encodes a label for its output's field, or returns nil if the label is missing or does not
+ * match the output, e.g. a class name that is not one of the output's labels.
+ */
+
+static NSData * _Nullable EncodedShardLabel(id _Nullable value, const ShardOutput &output) {
+    switch ( output.encoding ) {
+    case ShardOutputEncoding::OneHot: {
+        NSUInteger index = [value isKindOfClass:NSString.class] ? [output.labels indexOfObject:value] : NSNotFound;
+        
+        if ( index == NSNotFound || index >= output.length ) {
+            return nil;
+        }
+        
+        NSMutableData *data = [[NSMutableData alloc] initWithLength:output.length * sizeof(float_t)];
+        ((float_t*)data.mutableBytes)[index] = 1;
+        return data;
+    }
+    
+    case ShardOutputEncoding::Floats: {
+        if ( ![value isKindOfClass:NSArray.class] || ((NSArray*)value).count != output.length ) {
+            return nil;
+        }
+        
+        NSArray *numbers = (NSArray*)value;
+        NSMutableData *data = [[NSMutableData alloc] initWithLength:output.length * sizeof(float_t)];
+        float_t *floats = (float_t*)data.mutableBytes;
+        
+        for ( NSUInteger i = 0; i < numbers.count; i++ ) {
+            if ( ![numbers[i] isKindOfClass:NSNumber.class] ) {
+                return nil;
+            }
+            floats[i] = [numbers[i] floatValue];
+        }
+        
+        return data;
+    }
+    
+    case ShardOutputEncoding::Text:
+        return [value isKindOfClass:NSString.class] ? [value dataUsingEncoding:NSUTF8StringEncoding] : nil;
+    }
+}
+
+@interface ImageModelLabelsShardExporter()
+
+@property (readwrite) NSUInteger exportedImageCount;
+@property (readwrite) NSTimeInterval exportDuration;
+@property (readwrite) unsigned long long exportSize;
+
+@end
+
+@implementation ImageModelLabelsShardExporter
+
++ (PHImageRequestOptions*)imageRequestOptions {
+    static PHImageRequestOptions *options = nil;
+    static dispatch_once_t once;
+    
+    dispatch_once(&once, ^{
+        options = [[PHImageRequestOptions alloc] init];
+        options.deliveryMode = PHImageRequestOptionsDeliveryModeHighQualityFormat;
+        options.resizeMode = PHImageRequestOptionsResizeModeExact;
+        options.networkAccessAllowed = YES;
+        options.synchronous = YES;
+    });
+    
+    return options;
+}
+
+- (instancetype)initWithDatabase:(ImageModelLabelsDatabase*)database {
+    if ((self=[super init])) {
+        _database = database;
+        _maxShardSize = ShardedRecordWriter::Options().maxBytes;
+    }
+    return self;
+}
+
+- (BOOL)exportTo:(NSString*)directory error:(NSError**)error {
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    id<TIOModel> model = self.database.model;
+    
+    // The model must take a single image, which is preprocessed to its input description
+    
+    NSArray<TIOLayerInterface*> *inputs = model.io.inputs.all;
+    __block TIOPixelBufferLayerDescription *inputDescription = nil;
+    
+    if ( inputs.count == 1 ) {
+        [inputs[0] matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+            inputDescription = pixelBufferDescription;
+        } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+            // Unsupported
+        } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+            // Unsupported
+        }];
+    }
+    
+    if ( inputDescription == nil ) {
+        NSLog(@"Unable to export training shards, model %@ does not take a single image input", model.identifier);
+        if (error) {
+            *error = NetRunnerImageModelLabelsShardExporterUnsupportedModelError(model.identifier);
+        }
+        return NO;
+    }
+    
+    // Build the schema: the preprocessed input, a field per output and the image identifier
+    
+    TIOPixelBufferLayerDescription *description = inputDescription;
+    TIOImageVolume volume = description.imageVolume;
+    NSUInteger inputLength = [RecordTensor byteSizeForDescription:description];
+    
+    __block Schema schema;
+    schema.fields.push_back(FieldSpec::Tensor(inputs[0].name.UTF8String, description.isQuantized ? DType::UInt8 : DType::Float32, {volume.height, volume.width, volume.channels}));
+    schema.fields.back().encoding = kPreprocessedEncoding;
+    
+    __block std::vector<ShardOutput> outputs;
+    
+    for ( TIOLayerInterface *layer in model.io.outputs.all ) {
+        [layer matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+            // Image labels: not exported
+        } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+            ShardOutputEncoding encoding = vectorDescription.labels == nil ? ShardOutputEncoding::Floats : ShardOutputEncoding::OneHot;
+            outputs.push_back({layer.name, encoding, vectorDescription.labels, vectorDescription.length});
+            schema.fields.push_back(FieldSpec::Tensor(layer.name.UTF8String, DType::Float32, {(int32_t)vectorDescription.length}));
+        } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+            outputs.push_back({layer.name, ShardOutputEncoding::Text, nil, 0});
+            schema.fields.push_back(FieldSpec::Blob(layer.name.UTF8String, "utf8"));
+        }];
+    }
+    
+    schema.fields.push_back(FieldSpec::Blob("id", "utf8"));
+    
+    // Fetch the assets for the labeled images, some of which may have been deleted
+    
+    NSArray<ImageModelLabels*> *labels = self.database.allLabels;
+    NSMutableArray<NSString*> *identifiers = [[NSMutableArray alloc] init];
+    NSMutableDictionary<NSString*,ImageModelLabels*> *labelsByIdentifier = [[NSMutableDictionary alloc] init];
+    
+    for (ImageModelLabels *label in labels) {
+        [identifiers addObject:label.identifier];
+        labelsByIdentifier[label.identifier] = label;
+    }
+    
+    PHFetchResult<PHAsset *> *fetchResult = [PHAsset fetchAssetsWithLocalIdentifiers:identifiers options:nil];
+    NSArray<PHAsset*> *assets = [fetchResult objectsAtIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, fetchResult.count)]];
+    
+    // Stream the preprocessed images and labels into the shards
+    
+    std::string shardError;
+    std::unique_ptr<ShardedRecordWriter> writer = ShardedRecordWriter::Create(directory.fileSystemRepresentation, schema, {self.maxShardSize, 0}, &shardError);
+    
+    if (writer == nullptr) {
+        NSLog(@"Could not create training shards at path %@, error: %s", directory, shardError.c_str());
+        if (error) {
+            *error = NetRunnerImageModelLabelsShardExporterWriteError(directory, @(shardError.c_str()));
+        }
+        return NO;
+    }
+    
+    // Request images at the input's size so the vision pipeline only needs to crop and convert them
+    
+    PHImageRequestOptions *imageRequestOptions = ImageModelLabelsShardExporter.imageRequestOptions;
+    CGSize size = CGSizeMake(volume.width, volume.height);
+    
+    size_t workers = std::max<size_t>(2, NSProcessInfo.processInfo.activeProcessorCount);
+    OrderedPipeline<PreprocessedImage> pipeline({workers, workers * 2});
+    NSUInteger written = 0;
+    
+    bool completed = pipeline.run(assets.count, [&](size_t index) -> PreprocessedImage {
+        @autoreleasepool {
+            PHAsset *asset = assets[index];
+            __block UIImage *image = nil;
+            
+            // The request is synchronous, the handler is called before it returns
+            
+            [[PHImageManager defaultManager]
+                requestImageForAsset:asset
+                targetSize:size
+                contentMode:PHImageContentModeAspectFill
+                options:imageRequestOptions
+                resultHandler:^(UIImage *result, NSDictionary *info) {
+                    image = result;
+                }
+            ];
+            
+            CVPixelBufferRef pixelBuffer = image.pixelBuffer; // Returns ARGB
+            
+            if (pixelBuffer == NULL) {
+                return {asset.localIdentifier, nil};
+            }
+            
+            // The same pipeline that prepares the image for inference: resize, format, normalize
+            // and quantize
+            
+            TIOPixelBuffer *input = [[TIOPixelBuffer alloc] initWithPixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationUp];
+            NSMutableData *tensor = [[NSMutableData alloc] initWithLength:inputLength];
+            [input getBytes:tensor.mutableBytes description:description];
+            
+            return {asset.localIdentifier, tensor};
+        }
+    }, [&](size_t index, PreprocessedImage &image) -> bool {
+        @autoreleasepool {
+            if (image.tensor == nil) {
+                NSLog(@"Could not fetch or preprocess image with identifier %@, skipping", image.identifier);
+                return true;
+            }
+            
+            ImageModelLabels *label = labelsByIdentifier[image.identifier];
+            NSMutableArray<NSData*> *encoded = [[NSMutableArray alloc] init];
+            
+            for ( const ShardOutput &output : outputs ) {
+                NSData *data = EncodedShardLabel(label.labels[output.name], output);
+                if (data == nil) {
+                    NSLog(@"Missing or invalid %@ label for image with identifier %@, skipping", output.name, image.identifier);
+                    return true;
+                }
+                [encoded addObject:data];
+            }
+            
+            NSData *identifier = [image.identifier dataUsingEncoding:NSUTF8StringEncoding];
+            std::vector<FieldView> fields;
+            
+            fields.emplace_back(image.tensor.bytes, image.tensor.length);
+            for (NSData *data in encoded) {
+                fields.emplace_back(data.bytes, data.length);
+            }
+            fields.emplace_back(identifier.bytes, identifier.length);
+            
+            if (!writer->write(fields, &shardError)) {
+                NSLog(@"Could not write image with identifier %@ to training shards, error: %s", image.identifier, shardError.c_str());
+                return false;
+            }
+            
+            written += 1;
+            return true;
+        }
+    });
+    
+    if (!completed || !writer->close(&shardError)) {
+        NSLog(@"Could not write training shards at path %@, error: %s", directory, shardError.c_str());
+        writer.reset();
+        [NSFileManager.defaultManager removeItemAtPath:directory error:nil];
+        if (error) {
+            *error = NetRunnerImageModelLabelsShardExporterWriteError(directory, @(shardError.c_str()));
+        }
+        return NO;
+    }
+    
+    self.exportedImageCount = written;
+    self.exportDuration = CFAbsoluteTimeGetCurrent() - start;
+    self.exportSize = writer->size();
+    
+    NSLog(@"Exported %tu preprocessed images to %zu shards in %.2fs, %.1f MB on disk", written, writer->shardCount(), self.exportDuration, self.exportSize / 1e6);
+    
+    return YES;
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerImageModelLabelsShardExporterUnsupportedModelError(NSString *identifier) {
+    return [[NSError alloc] initWithDomain:NetRunnerImageModelLabelsShardExporterErrorDomain code:NetRunnerImageModelLabelsShardExporterUnsupportedModelErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Training shards cannot be prepared for the model %@", identifier],
+        NSLocalizedRecoverySuggestionErrorKey: @"Training shards may only be prepared for models that take a single image input."
+    }];
+}
+
+NSError * NetRunnerImageModelLabelsShardExporterWriteError(NSString *path, NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerImageModelLabelsShardExporterErrorDomain code:NetRunnerImageModelLabelsShardExporterWriteErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"There was a problem writing training shards to %@: %@", path, description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure there is enough free space on the device and try again."
+    }];
+}
@@ -0,0 +1,121 @@
+//
+//  LabelEncoding.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "LabelEncoding.h"
+
+#include <cstring>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#error "Label encoding assumes a little-endian host"
+#endif
+
+static_assert(sizeof(float) == 4, "Labels are encoded as float32");
+
+namespace netrunner {
+namespace labels {
+
+namespace {
+
+std::string QuoteIdentifier(const std::string &identifier) {
+    std::string quoted = "\"";
+    for ( char c : identifier ) {
+        quoted += c;
+        if ( c == '"' ) {
+            quoted += c;
+        }
+    }
+    quoted += "\"";
+    return quoted;
+}
+
+std::string ColumnList(const std::vector<Column> &columns) {
+    std::string list = kIdentifierColumn;
+    for ( const Column &column : columns ) {
+        list += ", " + QuoteIdentifier(ColumnName(column.name));
+    }
+    return list;
+}
+
+} // namespace
+
+std::string ColumnName(const std::string &layer) {
+    return "label_" + layer;
+}
+
+const char *ColumnType(LabelType type) {
+    switch ( type ) {
+    case LabelType::Text:
+        return "TEXT";
+    case LabelType::Floats:
+    case LabelType::Data:
+        return "BLOB";
+    }
+    return "BLOB";
+}
+
+std::string CreateTableStatement(const std::vector<Column> &columns) {
+    std::string statement = std::string("CREATE TABLE ") + kTableName + " (" + kIdentifierColumn + " TEXT PRIMARY KEY NOT NULL";
+    for ( const Column &column : columns ) {
+        statement += ", " + QuoteIdentifier(ColumnName(column.name)) + " " + ColumnType(column.type);
+    }
+    statement += ") WITHOUT ROWID";
+    return statement;
+}
+
+std::string AddColumnStatement(const Column &column) {
+    return std::string("ALTER TABLE ") + kTableName + " ADD COLUMN " + QuoteIdentifier(ColumnName(column.name)) + " " + ColumnType(column.type);
+}
+
+std::string UpsertStatement(const std::vector<Column> &columns) {
+    std::string placeholders = "?";
+    for ( size_t i = 0; i < columns.size(); i++ ) {
+        placeholders += ", ?";
+    }
+    return std::string("INSERT OR REPLACE INTO ") + kTableName + " (" + ColumnList(columns) + ") VALUES (" + placeholders + ")";
+}
+
+std::string SelectStatement(const std::vector<Column> &columns, bool byIdentifier) {
+    std::string statement = "SELECT " + ColumnList(columns) + " FROM " + kTableName;
+    if ( byIdentifier ) {
+        statement += std::string(" WHERE ") + kIdentifierColumn + " = ?";
+    }
+    return statement;
+}
+
+void EncodeFloats(const float *values, size_t count, std::vector<uint8_t> *bytes) {
+    bytes->resize(count * sizeof(float));
+    if ( count > 0 ) {
+        std::memcpy(bytes->data(), values, count * sizeof(float));
+    }
+}
+
+bool DecodeFloats(const void *bytes, size_t length, std::vector<float> *values) {
+    if ( length % sizeof(float) != 0 ) {
+        return false;
+    }
+    values->resize(length / sizeof(float));
+    if ( length > 0 ) {
+        std::memcpy(values->data(), bytes, length);
+    }
+    return true;
+}
+
+} // namespace labels
+} // namespace netrunner
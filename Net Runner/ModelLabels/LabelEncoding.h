@@ -0,0 +1,121 @@
+//
+//  LabelEncoding.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef LabelEncoding_h
+#define LabelEncoding_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netrunner {
+namespace labels {
+
+/**
+ * The schema and value encoding of the labels database.
+ *
+ * Each of a model's output layers is stored in its own typed column of a single `labels` table,
+ * keyed by image identifier. Text labels are stored as TEXT, numeric labels as a BLOB of packed
+ * little-endian float32 values, and image labels as an opaque BLOB. The statements are shared by
+ * the app and the Linux labels benchmark so that both exercise the same schema.
+ */
+
+enum class LabelType {
+    Text,
+    Floats,
+    Data
+};
+
+struct Column {
+    std::string name;
+    LabelType type;
+};
+
+/**
+ * The value of `PRAGMA user_version` for databases in this format. Databases at version 0 store
+ * each image's labels as a single JSON blob and are migrated when they are opened.
+ */
+
+static const int kSchemaVersion = 1;
+
+/**
+ * The name of the table, and of its identifier column.
+ */
+
+static const char * const kTableName = "labels";
+static const char * const kIdentifierColumn = "id";
+
+/**
+ * The column name for an output layer. Layer columns are prefixed so that a layer may be named
+ * anything, including "id". Names are quoted by the statements below.
+ */
+
+std::string ColumnName(const std::string &layer);
+
+/**
+ * The SQLite type of a label column.
+ */
+
+const char *ColumnType(LabelType type);
+
+/**
+ * Creates the labels table. The table is keyed by identifier without a separate rowid, so each
+ * row is stored once in the primary key's b-tree.
+ */
+
+std::string CreateTableStatement(const std::vector<Column> &columns);
+
+/**
+ * Adds a column for an output layer to an existing labels table.
+ */
+
+std::string AddColumnStatement(const Column &column);
+
+/**
+ * Inserts or replaces a row. Binds the identifier followed by one value per column, in order.
+ */
+
+std::string UpsertStatement(const std::vector<Column> &columns);
+
+/**
+ * Selects the identifier followed by one value per column, in order, optionally for a single
+ * identifier.
+ */
+
+std::string SelectStatement(const std::vector<Column> &columns, bool byIdentifier);
+
+/**
+ * Packs count floats into bytes as little-endian float32 values, replacing its contents.
+ */
+
+void EncodeFloats(const float *values, size_t count, std::vector<uint8_t> *bytes);
+
+/**
+ * Unpacks little-endian float32 values, replacing the contents of values. Returns false if
+ * length is not a multiple of four bytes.
+ */
+
+bool DecodeFloats(const void *bytes, size_t length, std::vector<float> *values);
+
+} // namespace labels
+} // namespace netrunner
+
+#endif /* LabelEncoding_h */
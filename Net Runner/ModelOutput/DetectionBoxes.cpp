@@ -0,0 +1,209 @@
+//
+//  DetectionBoxes.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "DetectionBoxes.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NETRUNNER_DETECTION_BOXES_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NETRUNNER_DETECTION_BOXES_SSE 1
+#endif
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+// The centers are linear in the encodings and the sizes exponential. A box's four values fill a
+// vector, so the centers and half sizes are computed together and only the exp is scalar.
+
+void DecodeBoxes(const float *encodings, const float *anchors, size_t count, const BoxScales &scales, float *boxes) {
+    const float inverse[4] = {1.0f / scales.y, 1.0f / scales.x, 1.0f / scales.height, 1.0f / scales.width};
+
+#if NETRUNNER_DETECTION_BOXES_NEON
+    const float32x4_t scale = vld1q_f32(inverse);
+
+    for ( size_t i = 0; i < count; i++ ) {
+        float32x4_t t = vmulq_f32(vld1q_f32(encodings + i * 4), scale);
+        float32x4_t a = vld1q_f32(anchors + i * 4);
+        float32x2_t size = vget_high_f32(a);
+        float32x2_t center = vmla_f32(vget_low_f32(a), vget_low_f32(t), size);
+        float32x2_t exponent = vget_high_f32(t);
+        float half[2] = {std::exp(vget_lane_f32(exponent, 0)), std::exp(vget_lane_f32(exponent, 1))};
+        float32x2_t extent = vmul_n_f32(vmul_f32(vld1_f32(half), size), 0.5f);
+        vst1q_f32(boxes + i * 4, vcombine_f32(vsub_f32(center, extent), vadd_f32(center, extent)));
+    }
+#elif NETRUNNER_DETECTION_BOXES_SSE
+    const __m128 scale = _mm_loadu_ps(inverse);
+
+    for ( size_t i = 0; i < count; i++ ) {
+        __m128 t = _mm_mul_ps(_mm_loadu_ps(encodings + i * 4), scale);
+        __m128 a = _mm_loadu_ps(anchors + i * 4);
+        __m128 size = _mm_movehl_ps(a, a);
+        __m128 center = _mm_add_ps(a, _mm_mul_ps(t, size));
+        float exponent[4];
+        _mm_storeu_ps(exponent, t);
+        __m128 growth = _mm_setr_ps(std::exp(exponent[2]), std::exp(exponent[3]), 0, 0);
+        __m128 extent = _mm_mul_ps(_mm_mul_ps(growth, size), _mm_set1_ps(0.5f));
+        _mm_storeu_ps(boxes + i * 4, _mm_movelh_ps(_mm_sub_ps(center, extent), _mm_add_ps(center, extent)));
+    }
+#else
+    for ( size_t i = 0; i < count; i++ ) {
+        const float *t = encodings + i * 4;
+        const float *a = anchors + i * 4;
+        const float cy = t[0] * inverse[0] * a[2] + a[0];
+        const float cx = t[1] * inverse[1] * a[3] + a[1];
+        const float h = std::exp(t[2] * inverse[2]) * a[2] * 0.5f;
+        const float w = std::exp(t[3] * inverse[3]) * a[3] * 0.5f;
+        float *box = boxes + i * 4;
+        box[0] = cy - h; box[1] = cx - w; box[2] = cy + h; box[3] = cx + w;
+    }
+#endif
+}
+
+bool ReadAnchors(const std::string &path, std::vector<float> *anchors, std::string *error) {
+    std::ifstream file(path);
+
+    if ( !file ) {
+        SetError(error, "Unable to read anchors at " + path);
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string text = contents.str();
+
+    for ( char &c : text ) {
+        if ( c == ',' ) {
+            c = ' ';
+        }
+    }
+
+    std::istringstream stream(text);
+    anchors->clear();
+    float value;
+
+    while ( stream >> value ) {
+        anchors->push_back(value);
+    }
+
+    if ( !stream.eof() || anchors->empty() || anchors->size() % 4 != 0 ) {
+        SetError(error, "Anchors at " + path + " must be four numbers per anchor");
+        return false;
+    }
+
+    return true;
+}
+
+// MARK: - Box Sets
+
+void BoxSet::clear() {
+    _ymin.clear();
+    _xmin.clear();
+    _ymax.clear();
+    _xmax.clear();
+    _area.clear();
+}
+
+// A box without area intersects nothing, so PostProcessor::IntersectionOverUnion gives it an
+// overlap of 0 with every box. Such boxes are kept with an area of 0: their intersection is then
+// 0 and the union the other box's area, and the comparison gives the same answer as 0 > threshold
+
+void BoxSet::add(const float *box) {
+    const float area = (box[2] - box[0]) * (box[3] - box[1]);
+
+    _ymin.push_back(box[0]);
+    _xmin.push_back(box[1]);
+    _ymax.push_back(box[2]);
+    _xmax.push_back(box[3]);
+    _area.push_back(area > 0 ? area : 0);
+}
+
+bool BoxSet::overlaps(const float *box, float threshold) const {
+    const float area = (box[2] - box[0]) * (box[3] - box[1]);
+
+    if ( !(area > 0) ) {
+        return threshold < 0 && !_ymin.empty();
+    }
+
+    const size_t count = _ymin.size();
+    size_t i = 0;
+
+#if NETRUNNER_DETECTION_BOXES_NEON
+    const float32x4_t zero = vdupq_n_f32(0);
+    const float32x4_t y0 = vdupq_n_f32(box[0]), x0 = vdupq_n_f32(box[1]);
+    const float32x4_t y1 = vdupq_n_f32(box[2]), x1 = vdupq_n_f32(box[3]);
+    const float32x4_t a = vdupq_n_f32(area), t = vdupq_n_f32(threshold);
+
+    for ( ; i + 4 <= count; i += 4 ) {
+        float32x4_t h = vmaxq_f32(zero, vsubq_f32(vminq_f32(vld1q_f32(&_ymax[i]), y1), vmaxq_f32(vld1q_f32(&_ymin[i]), y0)));
+        float32x4_t w = vmaxq_f32(zero, vsubq_f32(vminq_f32(vld1q_f32(&_xmax[i]), x1), vmaxq_f32(vld1q_f32(&_xmin[i]), x0)));
+        float32x4_t intersection = vmulq_f32(h, w);
+        float32x4_t both = vsubq_f32(vaddq_f32(vld1q_f32(&_area[i]), a), intersection);
+        uint32x4_t over = vcgtq_f32(intersection, vmulq_f32(t, both));
+        uint32x2_t any = vorr_u32(vget_low_u32(over), vget_high_u32(over));
+        if ( (vget_lane_u32(any, 0) | vget_lane_u32(any, 1)) != 0 ) {
+            return true;
+        }
+    }
+#elif NETRUNNER_DETECTION_BOXES_SSE
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 y0 = _mm_set1_ps(box[0]), x0 = _mm_set1_ps(box[1]);
+    const __m128 y1 = _mm_set1_ps(box[2]), x1 = _mm_set1_ps(box[3]);
+    const __m128 a = _mm_set1_ps(area), t = _mm_set1_ps(threshold);
+
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 h = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(_mm_loadu_ps(&_ymax[i]), y1), _mm_max_ps(_mm_loadu_ps(&_ymin[i]), y0)));
+        __m128 w = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(_mm_loadu_ps(&_xmax[i]), x1), _mm_max_ps(_mm_loadu_ps(&_xmin[i]), x0)));
+        __m128 intersection = _mm_mul_ps(h, w);
+        __m128 both = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(&_area[i]), a), intersection);
+        if ( _mm_movemask_ps(_mm_cmpgt_ps(intersection, _mm_mul_ps(t, both))) != 0 ) {
+            return true;
+        }
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        const float h = std::max(0.0f, std::min(_ymax[i], box[2]) - std::max(_ymin[i], box[0]));
+        const float w = std::max(0.0f, std::min(_xmax[i], box[3]) - std::max(_xmin[i], box[1]));
+        const float intersection = h * w;
+        if ( intersection > threshold * (_area[i] + area - intersection) ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace netrunner
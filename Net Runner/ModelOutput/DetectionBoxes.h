@@ -0,0 +1,100 @@
+//
+//  DetectionBoxes.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef DetectionBoxes_h
+#define DetectionBoxes_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * The scale factors an SSD box coder divides its encodings by. The defaults are those of the
+ * TensorFlow Object Detection API's faster_rcnn_box_coder, which SSD models use.
+ */
+
+struct BoxScales {
+    float y = 10;
+    float x = 10;
+    float height = 5;
+    float width = 5;
+};
+
+/**
+ * Decodes SSD box encodings relative to their anchors into corner form boxes.
+ *
+ * Encodings are four values per box ordered ty, tx, th, tw. Anchors are four values per box in
+ * center form ordered cy, cx, h, w. Boxes are written four values per box ordered ymin, xmin,
+ * ymax, xmax, and may alias the encodings.
+ */
+
+void DecodeBoxes(const float *encodings, const float *anchors, size_t count, const BoxScales &scales, float *boxes);
+
+/**
+ * Reads anchors from a text file of four numbers per anchor, cy, cx, h and w, separated by
+ * whitespace or commas. Returns false and sets error if the file cannot be read or does not
+ * hold a whole number of anchors.
+ */
+
+bool ReadAnchors(const std::string &path, std::vector<float> *anchors, std::string *error);
+
+/**
+ * A set of corner form boxes stored column-wise, against which a box's overlap is tested four
+ * boxes at a time. Non-maximum suppression keeps one set per class of the boxes it has kept.
+ */
+
+class BoxSet {
+public:
+
+    /**
+     * Empties the set, keeping its storage.
+     */
+
+    void clear();
+
+    size_t size() const { return _ymin.size(); }
+
+    /**
+     * Adds a box. Boxes without area are added too, and overlap others by 0 as they do in
+     * PostProcessor::IntersectionOverUnion, so suppression matches the pairwise comparison.
+     */
+
+    void add(const float *box);
+
+    /**
+     * Whether the intersection over union of the box and any box in the set is above the
+     * threshold, compared as intersection > threshold * union so that no division is needed.
+     */
+
+    bool overlaps(const float *box, float threshold) const;
+
+private:
+    std::vector<float> _ymin;
+    std::vector<float> _xmin;
+    std::vector<float> _ymax;
+    std::vector<float> _xmax;
+    std::vector<float> _area;
+};
+
+} // namespace netrunner
+
+#endif /* DetectionBoxes_h */
@@ -47,6 +47,19 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (instancetype)initWithDictionary:(NSDictionary*)dictionary NS_DESIGNATED_INITIALIZER;
 
+/**
+ * Initializes the output with the results of a model that has just run, and also copies the
+ * scores of every class from the model's "classification" output tensor, so that smoothing reads
+ * them by index rather than from the dictionary of boxed scores. Call before the model runs again.
+ * Falls back to the dictionary when the tensor cannot be read, for example because the model is
+ * not a TensorFlow Lite model.
+ *
+ * @param dictionary the results of performing inference with a model.
+ * @param model the model that just produced the results.
+ */
+
+- (instancetype)initWithDictionary:(NSDictionary*)dictionary model:(id<TIOModel>)model;
+
 /**
  * Use the designated initializer.
  */
@@ -86,14 +99,19 @@ NS_ASSUME_NONNULL_BEGIN
 - (BOOL)isEqual:(id)anObject;
 
 /**
- * Applies an exponential decay to the model output using the previous results
- * and returns the combination.
+ * Smooths the model output with the previous results and returns the combination.
  *
  * Returns `self` if the `previousOutput` is nil.
  *
+ * Smoothing is done on the scores of every class rather than on the top results, by a
+ * `ScoreSmoother` whose state is carried from one decayed output to the next and updated in
+ * place. Decay each output into a new one only once, as the live camera view does. The kind of
+ * smoothing is read from the `app.live.smoothing` user default: "exponential", "window" or
+ * "hysteresis". See ScoreSmoother.h.
+ *
  * @param previousOutput The previous output produced by the model
  *
- * @return An exponentially weighted decay of the current and previous outputs, or `self` if `previousOutput` is `nil`.
+ * @return A smoothed combination of the current and previous outputs, or `self` if `previousOutput` is `nil`.
  */
 
 - (id<ModelOutput>)decayedOutput:(nullable id<ModelOutput>)previousOutput;
@@ -20,23 +20,211 @@
 
 #import "ImageNetClassificationModelOutput.h"
 
+@import TensorIO;
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "ScoreSmoother.h"
+
 #import "NSArray+TIOExtensions.h"
 #import "NSDictionary+TIOExtensions.h"
+#import "UserDefaults.h"
+
+using netrunner::ScoreSmoother;
 
 static NSString * const kClassificationOutputKey = @"classification";
 
+static const NSUInteger kTopCount = 5;
+static const float kTopThreshold = 0.1f;
+
+/**
+ * TensorIO does not publish its output tensors. The method is checked for before it is called.
+ */
+
+@interface TIOTFLiteModel (OutputTensors)
+
+- (void *)outputTensorAtIndex:(NSUInteger)index;
+
+@end
+
+namespace {
+
+// The smoothing state carried along a chain of decayed outputs. Labels are in the order of the
+// classification layer's labels, or of the first frame's classifications when the output tensor
+// could not be read, which fixes the order of the dense score vectors. Indexes by label are only
+// built for frames without scores.
+
+struct ClassificationSmoothing {
+    NSArray<NSString*> *labels;
+    NSDictionary<NSString*,NSNumber*> *indexes;
+    std::unique_ptr<ScoreSmoother> smoother;
+    std::vector<float> scores;
+    std::vector<ScoreSmoother::Entry> top;
+};
+
+ScoreSmoother::Options SmoothingOptions() {
+    NSString *mode = [NSUserDefaults.standardUserDefaults stringForKey:kPrefsLiveSmoothing];
+    ScoreSmoother::Options options;
+    
+    if ( [mode isEqualToString:@"window"] ) {
+        options.mode = ScoreSmoother::Mode::WindowedMean;
+    } else if ( [mode isEqualToString:@"hysteresis"] ) {
+        options.mode = ScoreSmoother::Mode::Hysteresis;
+        options.enterThreshold = kTopThreshold;
+        options.exitThreshold = kTopThreshold / 2;
+    }
+    
+    return options;
+}
+
+std::shared_ptr<ClassificationSmoothing> NewSmoothing(NSArray<NSString*> *labels) {
+    auto smoothing = std::make_shared<ClassificationSmoothing>();
+    
+    smoothing->labels = labels;
+    smoothing->smoother.reset(new ScoreSmoother(labels.count, SmoothingOptions()));
+    smoothing->scores.assign(labels.count, 0);
+    
+    return smoothing;
+}
+
+// Copies the classification output tensor of a model that has just run into scores, in the order
+// of the layer's labels, and returns the labels. Returns nil if the model is not a TensorFlow Lite
+// model or the output is not a labeled vector.
+
+NSArray<NSString*> *CopyOutputScores(id<TIOModel> model, std::vector<float> &scores) {
+    if ( ![model isKindOfClass:TIOTFLiteModel.class] || ![model respondsToSelector:@selector(outputTensorAtIndex:)] ) {
+        return nil;
+    }
+    
+    NSNumber *index = [model.io.outputs indexForName:kClassificationOutputKey];
+    __block TIOVectorLayerDescription *layer;
+    
+    if ( index == nil ) {
+        return nil;
+    }
+    
+    [model.io.outputs[index.integerValue] matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+    } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+        layer = vectorDescription;
+    } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+    }];
+    
+    if ( layer == nil || !layer.isLabeled || layer.labels.count != layer.length ) {
+        return nil;
+    }
+    
+    const void *tensor = [(TIOTFLiteModel*)model outputTensorAtIndex:index.unsignedIntegerValue];
+    const NSUInteger length = layer.length;
+    
+    if ( tensor == NULL ) {
+        return nil;
+    }
+    
+    scores.resize(length);
+    
+    if ( layer.isQuantized ) {
+    
+        // Dequantizing through a table calls the dequantizer once per byte value rather than
+        // once per class
+        
+        TIODataDequantizer dequantizer = layer.dequantizer;
+        const uint8_t *bytes = static_cast<const uint8_t*>(tensor);
+        float table[256];
+        
+        for ( int value = 0; value < 256; value++ ) {
+            table[value] = dequantizer != nil ? dequantizer(static_cast<uint8_t>(value)) : value;
+        }
+        for ( NSUInteger i = 0; i < length; i++ ) {
+            scores[i] = table[bytes[i]];
+        }
+    } else {
+        std::memcpy(scores.data(), tensor, length * sizeof(float));
+    }
+    
+    return layer.labels;
+}
+
+// Copies a frame's scores into the dense score vector, from the output tensor's scores when the
+// frame has them and its classifications otherwise. Returns false if the frame's labels are not
+// the ones being smoothed, for example after the model changes.
+
+bool FillScores(ClassificationSmoothing &smoothing, NSArray<NSString*> *labels, const std::vector<float> &frameScores, NSDictionary<NSString*,NSNumber*> *classifications) {
+    if ( labels != nil ) {
+        if ( labels != smoothing.labels && ![labels isEqualToArray:smoothing.labels] ) {
+            return false;
+        }
+        std::copy(frameScores.begin(), frameScores.end(), smoothing.scores.begin());
+        return true;
+    }
+    
+    if ( smoothing.indexes == nil ) {
+        NSMutableDictionary<NSString*,NSNumber*> *indexes = [[NSMutableDictionary alloc] initWithCapacity:smoothing.labels.count];
+        for ( NSUInteger i = 0; i < smoothing.labels.count; i++ ) {
+            indexes[smoothing.labels[i]] = @(i);
+        }
+        smoothing.indexes = indexes.copy;
+    }
+    
+    std::fill(smoothing.scores.begin(), smoothing.scores.end(), 0.0f);
+    
+    float *scores = smoothing.scores.data();
+    NSDictionary<NSString*,NSNumber*> *indexes = smoothing.indexes;
+    __block bool known = true;
+    
+    [classifications enumerateKeysAndObjectsUsingBlock:^(NSString * _Nonnull label, NSNumber * _Nonnull score, BOOL * _Nonnull stop) {
+        NSNumber *index = indexes[label];
+        if ( index == nil ) {
+            known = false;
+            *stop = YES;
+            return;
+        }
+        scores[index.unsignedIntegerValue] = score.floatValue;
+    }];
+    
+    return known;
+}
+
+} // namespace
+
 @interface ImageNetClassificationModelOutput ()
 
 @property (readwrite) NSDictionary *output;
 
 @end
 
-@implementation ImageNetClassificationModelOutput
+@implementation ImageNetClassificationModelOutput {
+    NSDictionary<NSString*,NSNumber*> *_classifications;
+    NSArray<NSString*> *_labels;
+    std::vector<float> _scores;
+    std::shared_ptr<ClassificationSmoothing> _smoothing;
+}
 
 - (instancetype)initWithDictionary:(NSDictionary*)dictionary {
     if (self = [super init]) {
+        _classifications = dictionary[kClassificationOutputKey];
+        _output = @{
+            kClassificationOutputKey: [dictionary[kClassificationOutputKey] topN:kTopCount threshold:kTopThreshold]
+        };
+    }
+    return self;
+}
+
+- (instancetype)initWithDictionary:(NSDictionary*)dictionary model:(id<TIOModel>)model {
+    if (self = [self initWithDictionary:dictionary]) {
+        _labels = CopyOutputScores(model, _scores);
+    }
+    return self;
+}
+
+- (instancetype)initWithTopClassifications:(NSDictionary<NSString*,NSNumber*>*)classifications smoothing:(std::shared_ptr<ClassificationSmoothing>)smoothing {
+    if (self = [super init]) {
+        _classifications = classifications;
+        _smoothing = smoothing;
         _output = @{
-            kClassificationOutputKey: [dictionary[kClassificationOutputKey] topN:5 threshold:0.1]
+            kClassificationOutputKey: classifications
         };
     }
     return self;
@@ -95,35 +283,36 @@ static NSString * const kClassificationOutputKey = @"classification";
     
     NSAssert([previousOutput isKindOfClass:self.class], @"previousOutput is not same class as self: %@, %@", previousOutput.class, self.class);
     
-    const float decayValue = 0.70f;
-    const float updateValue = 0.30f;
-    const float thresholdValue = 0.01f;
+    ImageNetClassificationModelOutput *previous = (ImageNetClassificationModelOutput*)previousOutput;
+    std::shared_ptr<ClassificationSmoothing> smoothing = previous->_smoothing;
     
-    NSMutableDictionary<NSString*,NSNumber*> *decayedInference = [NSMutableDictionary dictionary];
-    NSDictionary<NSString*,NSNumber*> *previousInference = previousOutput.value[kClassificationOutputKey];
-    NSDictionary<NSString*,NSNumber*> *newInference = self.value[kClassificationOutputKey];
+    // The first decay starts the smoothing from the previous frame
     
-    for ( NSString *key in previousInference ) {
-        decayedInference[key] = @(previousInference[key].floatValue * decayValue);
+    if ( smoothing == nullptr && previous->_classifications != nil ) {
+        smoothing = NewSmoothing(previous->_labels ?: previous->_classifications.allKeys);
+        FillScores(*smoothing, previous->_labels, previous->_scores, previous->_classifications);
+        smoothing->smoother->update(smoothing->scores.data());
     }
     
-    for ( NSString *key in newInference ) {
-        if ( decayedInference[key] == nil ) {
-            decayedInference[key] = @(0.0f);
-        }
-        
-        decayedInference[key] = @(decayedInference[key].floatValue + (newInference[key].floatValue * updateValue));
+    // Start over from this frame if its labels are not the ones being smoothed
+    
+    if ( smoothing == nullptr || !FillScores(*smoothing, _labels, _scores, _classifications) ) {
+        smoothing = NewSmoothing(_labels ?: _classifications.allKeys);
+        FillScores(*smoothing, _labels, _scores, _classifications);
     }
     
-    for ( NSString *key in decayedInference ) {
-        if ( decayedInference[key].floatValue < thresholdValue ) {
-            [decayedInference removeObjectForKey:key];
-        }
+    smoothing->smoother->update(smoothing->scores.data());
+    smoothing->smoother->top(kTopCount, kTopThreshold, &smoothing->top);
+    
+    // Only the top classes are mapped back to their labels
+    
+    NSMutableDictionary<NSString*,NSNumber*> *top = [[NSMutableDictionary alloc] initWithCapacity:smoothing->top.size()];
+    
+    for ( const ScoreSmoother::Entry &entry : smoothing->top ) {
+        top[smoothing->labels[entry.index]] = @(entry.score);
     }
     
-    return [[ImageNetClassificationModelOutput alloc] initWithDictionary:@{
-        kClassificationOutputKey: decayedInference
-    }];
+    return [[ImageNetClassificationModelOutput alloc] initWithTopClassifications:top.copy smoothing:smoothing];
 }
 
 @end
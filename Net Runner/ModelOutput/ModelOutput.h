@@ -22,6 +22,8 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+@protocol TIOModel;
+
 /**
  * A wrapper around a model's output.
  *
@@ -81,6 +83,19 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (id<ModelOutput>)decayedOutput:(nullable id<ModelOutput>)previousOutput;
 
+@optional
+
+/**
+ * Initializes the output from the model that produced the results as well as the results, for
+ * outputs that read the model's output tensors directly. The `ModelOutputManager` prefers this
+ * initializer when it is implemented, and calls it before the model runs again.
+ *
+ * @param dictionary the results of performing inference with a model.
+ * @param model the model that just produced the results.
+ */
+
+- (instancetype)initWithDictionary:(NSDictionary*)dictionary model:(id<TIOModel>)model;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -19,6 +19,9 @@
 //
 
 @import Foundation;
+@import TensorIO;
+
+#import "ModelOutput.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -28,6 +31,33 @@ NS_ASSUME_NONNULL_BEGIN
 
 - (Class)classForTypes:(NSArray<NSString*>*)types;
 
+/**
+ * The output class for a model. Models that declare post-processing in their model.json use
+ * `PostProcessedModelOutput`, otherwise the class is chosen by the model's type and output format.
+ */
+
+- (Class)classForModel:(id<TIOModel>)model;
+
+/**
+ * Compiles the post-processing the model declares, if it has not been compiled yet. Call when a
+ * model is loaded so that its first results do not pay for compiling. Compiled post-processing is
+ * compiled again from the reloaded bundles whenever the `ModelManager` loads its bundles.
+ */
+
+- (void)prepareForModel:(id<TIOModel>)model;
+
+/**
+ * Wraps the results of running a model in its output class, first applying the post-processing
+ * the model declares, which is compiled here if the model was not prepared. If it cannot be
+ * compiled, or the results cannot be processed, the raw results are wrapped in a
+ * `DefaultModelOutput` instead.
+ *
+ * Output classes may read the model's output tensors, so call this right after running the
+ * model and before running it again.
+ */
+
+- (nullable id<ModelOutput>)outputForModel:(id<TIOModel>)model results:(nullable NSDictionary*)results;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -22,11 +22,24 @@
 
 #import "ImageNetClassificationModelOutput.h"
 #import "DefaultModelOutput.h"
+#import "ModelManager.h"
+#import "ModelPostProcessor.h"
+#import "PostProcessedModelOutput.h"
 
 @interface ModelOutputManager ()
 
 @property NSDictionary<NSString*,Class> *classes;
 
+/**
+ * Compiled post-processors by model identifier, or `NSNull` if a model's declaration could not
+ * be compiled. Recompiled whenever the model manager loads bundles, since a bundle with the same
+ * identifier may have been replaced. Access requires synchronizing on the receiver.
+ */
+
+@property NSMutableDictionary<NSString*,id> *processors;
+
+@property id<NSObject> modelsObserver;
+
 @end
 
 @implementation ModelOutputManager
@@ -44,10 +57,20 @@
 - (instancetype)initWithClasses:(NSDictionary*)classes {
     if (self = [super init]) {
         _classes = classes;
+        _processors = [[NSMutableDictionary alloc] init];
+        
+        __weak typeof(self) weakself = self;
+        _modelsObserver = [NSNotificationCenter.defaultCenter addObserverForName:NRModelManagerDidLoadModelsNotification object:nil queue:nil usingBlock:^(NSNotification * _Nonnull note) {
+            [weakself recompileProcessors];
+        }];
     }
     return self;
 }
 
+- (void)dealloc {
+    [NSNotificationCenter.defaultCenter removeObserver:_modelsObserver];
+}
+
 + (NSDictionary<NSString*,Class>*)classes {
     NSMutableDictionary<NSString*,Class> *classes = [[NSMutableDictionary alloc] init];
     
@@ -72,4 +95,87 @@
     return DefaultModelOutput.class;
 }
 
+// MARK: - Post-Processing
+
+- (Class)classForModel:(id<TIOModel>)model {
+    if ( [ModelPostProcessor modelDeclaresPostProcessing:model] ) {
+        return PostProcessedModelOutput.class;
+    }
+    
+    return [self classForTypes:@[model.type, model.options.outputFormat]];
+}
+
+- (nullable id<ModelOutput>)outputForModel:(id<TIOModel>)model results:(nullable NSDictionary*)results {
+    if ( results == nil ) {
+        return nil;
+    }
+    
+    if ( ![ModelPostProcessor modelDeclaresPostProcessing:model] ) {
+        Class class = [self classForTypes:@[model.type, model.options.outputFormat]];
+        
+        if ( [class instancesRespondToSelector:@selector(initWithDictionary:model:)] ) {
+            return [[class alloc] initWithDictionary:results model:model];
+        }
+        
+        return [[class alloc] initWithDictionary:results];
+    }
+    
+    ModelPostProcessor *processor = [self processorForModel:model];
+    NSDictionary *processed = [processor processResults:results model:model];
+    
+    if ( processed == nil ) {
+        return [[DefaultModelOutput alloc] initWithDictionary:results];
+    }
+    
+    return [[PostProcessedModelOutput alloc] initWithDictionary:processed];
+}
+
+- (void)prepareForModel:(id<TIOModel>)model {
+    if ( [ModelPostProcessor modelDeclaresPostProcessing:model] ) {
+        [self processorForModel:model];
+    }
+}
+
+- (nullable ModelPostProcessor*)processorForModel:(id<TIOModel>)model {
+    @synchronized (self) {
+        id processor = self.processors[model.identifier];
+        
+        if ( processor == nil ) {
+            processor = [self compileProcessorForBundle:model.bundle];
+            self.processors[model.identifier] = processor;
+        }
+        
+        return processor == NSNull.null ? nil : processor;
+    }
+}
+
+- (id)compileProcessorForBundle:(TIOModelBundle*)bundle {
+    NSError *error;
+    ModelPostProcessor *processor = [[ModelPostProcessor alloc] initWithBundle:bundle error:&error];
+    
+    if ( processor == nil ) {
+        NSLog(@"Unable to compile post-processing for model %@, error: %@", bundle.identifier, error);
+        return NSNull.null;
+    }
+    
+    return processor;
+}
+
+// Models whose processors were compiled are recompiled from their reloaded bundles, so that a
+// model in use does not compile its processor on its next run. Removed models are dropped
+
+- (void)recompileProcessors {
+    @synchronized (self) {
+        NSArray<NSString*> *identifiers = self.processors.allKeys;
+        [self.processors removeAllObjects];
+        
+        for ( NSString *identifier in identifiers ) {
+            TIOModelBundle *bundle = [ModelManager.sharedManager bundleWithId:identifier];
+            if ( bundle != nil && [ModelPostProcessor bundleDeclaresPostProcessing:bundle] ) {
+                self.processors[identifier] = [self compileProcessorForBundle:bundle];
+            }
+        }
+    }
+}
+
 @end
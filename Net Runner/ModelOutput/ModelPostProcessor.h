@@ -0,0 +1,98 @@
+//
+//  ModelPostProcessor.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Compiles the post-processing a model declares in the `options.post_processing` field of its
+ * model.json and runs it on the model's results. See PostProcessor.h for the declaration.
+ *
+ * The processed results have one of two forms. Classifications are keyed by the name of the
+ * scores layer and map labels to scores, or are a list of index and score pairs when the stages
+ * do not include labels:
+ *
+ * @code
+ * { "classification": { "label": 0.87, ... } }
+ * { "classification": [ { "index": 12, "score": 0.87 }, ... ] }
+ * @endcode
+ *
+ * Detections are listed under the "detections" key, with boxes ordered ymin, xmin, ymax, xmax:
+ *
+ * @code
+ * { "detections": [ { "class": "label", "score": 0.87, "box": [0.1, 0.2, 0.5, 0.6] }, ... ] }
+ * @endcode
+ *
+ * Scores are read straight from the output tensors of a TensorFlow Lite model that has just run,
+ * and from the boxed results TensorIO returns for other models.
+ *
+ * A processor is safe to use from multiple threads.
+ */
+
+@interface ModelPostProcessor : NSObject
+
+/**
+ * `YES` if the model's bundle declares post-processing, `NO` otherwise.
+ */
+
++ (BOOL)modelDeclaresPostProcessing:(id<TIOModel>)model;
+
+/**
+ * `YES` if the bundle declares post-processing, `NO` otherwise.
+ */
+
++ (BOOL)bundleDeclaresPostProcessing:(TIOModelBundle*)bundle;
+
+/**
+ * Designated initializer. Compiles the bundle's post-processing against its output layers.
+ *
+ * @param bundle The bundle of the models whose results will be processed.
+ * @param error Set if the bundle declares no post-processing or the declaration is invalid.
+ *
+ * @return instancetype A processor or `nil` if the declaration could not be compiled.
+ */
+
+- (nullable instancetype)initWithBundle:(TIOModelBundle*)bundle error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Compiles the post-processing of the model's bundle.
+ */
+
+- (nullable instancetype)initWithModel:(id<TIOModel>)model error:(NSError**)error;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Processes the results of running the model, returning `nil` if they do not match the model's
+ * output layers. The model's output tensors are read in place of the results when it is a
+ * TensorFlow Lite model, so call this right after running the model and before running it again.
+ */
+
+- (nullable NSDictionary<NSString*,id>*)processResults:(NSDictionary<NSString*,id>*)results model:(nullable id<TIOModel>)model;
+
+@end
+
+NS_ASSUME_NONNULL_END
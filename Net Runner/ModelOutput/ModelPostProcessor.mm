@@ -0,0 +1,423 @@
+//
+//  ModelPostProcessor.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "ModelPostProcessor.h"
+
+#import "ModelBundleHeader.h"
+#import "ModelManager.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DetectionBoxes.h"
+#include "PostProcessor.h"
+
+using netrunner::PostProcessor;
+
+// MARK: - Errors
+
+static NSString * const NetRunnerModelPostProcessorErrorDomain = @"ai.doc.net-runner.model-post-processor";
+
+static const NSInteger NetRunnerModelPostProcessorDeclarationErrorCode = 101;
+static const NSInteger NetRunnerModelPostProcessorCompileErrorCode = 102;
+
+NSError * NetRunnerModelPostProcessorDeclarationError(NSString *description);
+NSError * NetRunnerModelPostProcessorCompileError(NSString *description);
+
+/**
+ * TensorIO does not publish its output tensors. The method is checked for before it is called.
+ */
+
+@interface TIOTFLiteModel (OutputTensors)
+
+- (void *)outputTensorAtIndex:(NSUInteger)index;
+
+@end
+
+// MARK: -
+
+static NSDictionary * PostProcessingDeclaration(TIOModelBundle *bundle) {
+    NSDictionary *options = bundle.info[@"options"];
+    
+    if ( ![options isKindOfClass:NSDictionary.class] ) {
+        return nil;
+    }
+    
+    return options[@"post_processing"];
+}
+
+@implementation ModelPostProcessor {
+    std::unique_ptr<PostProcessor> _processor;
+    NSArray<NSString*> *_names;
+    NSArray<NSArray<NSString*>*> *_labels;
+    std::vector<size_t> _sizes;
+    
+    // For each output layer whose tensor holds bytes, the value of each byte dequantized, and
+    // empty for float tensors, which are read in place
+    
+    std::vector<std::vector<float>> _dequantized;
+    
+    // Resolves the labels of reported classes from the memory mapped labels of the scores layer
+    
+    ModelBundleHeader *_header;
+    NSString *_scoresName;
+}
+
++ (BOOL)modelDeclaresPostProcessing:(id<TIOModel>)model {
+    return [self bundleDeclaresPostProcessing:model.bundle];
+}
+
++ (BOOL)bundleDeclaresPostProcessing:(TIOModelBundle*)bundle {
+    return PostProcessingDeclaration(bundle) != nil;
+}
+
+- (nullable instancetype)initWithModel:(id<TIOModel>)model error:(NSError**)error {
+    return [self initWithBundle:model.bundle error:error];
+}
+
+- (nullable instancetype)initWithBundle:(TIOModelBundle*)bundle error:(NSError**)error {
+    if ((self=[super init])) {
+        NSDictionary *declaration = PostProcessingDeclaration(bundle);
+        NSArray *stages = [declaration isKindOfClass:NSDictionary.class] ? declaration[@"stages"] : nil;
+        NSString *scores = [declaration isKindOfClass:NSDictionary.class] ? declaration[@"scores"] : nil;
+        
+        if ( ![stages isKindOfClass:NSArray.class] || (scores != nil && ![scores isKindOfClass:NSString.class]) ) {
+            if (error) {
+                *error = NetRunnerModelPostProcessorDeclarationError(@"Expected a list of stages and an optional scores layer name");
+            }
+            return nil;
+        }
+        
+        // Stages
+        
+        std::vector<PostProcessor::Stage> compiledStages;
+        
+        for ( NSDictionary *stage in stages ) {
+            if ( ![stage isKindOfClass:NSDictionary.class] || ![stage[@"stage"] isKindOfClass:NSString.class] ) {
+                if (error) {
+                    *error = NetRunnerModelPostProcessorDeclarationError(@"Each stage must be an object with a stage name");
+                }
+                return nil;
+            }
+            
+            PostProcessor::Stage compiledStage;
+            compiledStage.name = [stage[@"stage"] UTF8String];
+            
+            for ( NSString *key in stage ) {
+                id value = stage[key];
+                if ( [value isKindOfClass:NSNumber.class] ) {
+                    compiledStage.numbers[key.UTF8String] = [value doubleValue];
+                } else if ( [value isKindOfClass:NSString.class] ) {
+                    compiledStage.strings[key.UTF8String] = [value UTF8String];
+                } else if ( [value isKindOfClass:NSArray.class] ) {
+                    std::vector<float> &array = compiledStage.arrays[key.UTF8String];
+                    for ( NSNumber *number in value ) {
+                        array.push_back([number isKindOfClass:NSNumber.class] ? number.floatValue : NAN);
+                    }
+                }
+            }
+            
+            // Anchors may be listed inline or named as an asset
+            
+            if ( [stage[@"anchors"] isKindOfClass:NSString.class] ) {
+                NSString *path = [bundle pathToAsset:stage[@"anchors"]];
+                std::string anchorsError;
+                
+                if ( !netrunner::ReadAnchors(path.UTF8String, &compiledStage.arrays["anchors"], &anchorsError) ) {
+                    if (error) {
+                        *error = NetRunnerModelPostProcessorDeclarationError([NSString stringWithUTF8String:anchorsError.c_str()]);
+                    }
+                    return nil;
+                }
+            }
+            
+            compiledStages.push_back(compiledStage);
+        }
+        
+        // Output layers, with non-vector layers reported as empty
+        
+        std::vector<PostProcessor::Layer> layers;
+        NSMutableArray<NSString*> *names = [[NSMutableArray alloc] init];
+        NSMutableArray<NSArray<NSString*>*> *labels = [[NSMutableArray alloc] init];
+        
+        for ( TIOLayerInterface *interface in bundle.io.outputs.all ) {
+            __block PostProcessor::Layer layer{interface.name.UTF8String, {0}, {}};
+            __block NSArray<NSString*> *layerLabels = @[];
+            __block std::vector<float> dequantized;
+            
+            [interface matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
+                // Pixel buffer outputs cannot be post-processed
+            } caseVector:^(TIOVectorLayerDescription * _Nonnull vectorDescription) {
+                layer.shape.clear();
+                for ( NSNumber *dimension in vectorDescription.shape ) {
+                    layer.shape.push_back(dimension.intValue);
+                }
+                for ( NSString *label in vectorDescription.labels ) {
+                    layer.labels.push_back(label.UTF8String);
+                }
+                if ( vectorDescription.labels != nil ) {
+                    layerLabels = vectorDescription.labels;
+                }
+                if ( vectorDescription.isQuantized ) {
+                    TIODataDequantizer dequantizer = vectorDescription.dequantizer;
+                    for ( int value = 0; value < 256; value++ ) {
+                        dequantized.push_back(dequantizer != nil ? dequantizer(static_cast<uint8_t>(value)) : value);
+                    }
+                }
+            } caseString:^(TIOStringLayerDescription * _Nonnull stringDescription) {
+                // String outputs cannot be post-processed
+            }];
+            
+            layers.push_back(layer);
+            _dequantized.push_back(dequantized);
+            [names addObject:interface.name];
+            [labels addObject:layerLabels];
+        }
+        
+        std::string compileError;
+        _processor = PostProcessor::Compile(layers, scores != nil ? scores.UTF8String : "", compiledStages, &compileError);
+        
+        if ( _processor == nullptr ) {
+            if (error) {
+                *error = NetRunnerModelPostProcessorCompileError([NSString stringWithUTF8String:compileError.c_str()]);
+            }
+            return nil;
+        }
+        
+        for ( const PostProcessor::Layer &layer : layers ) {
+            size_t size = 1;
+            for ( int dimension : layer.shape ) {
+                size *= static_cast<size_t>(std::abs(dimension));
+            }
+            _sizes.push_back(size);
+        }
+        
+        _names = names.copy;
+        _labels = labels.copy;
+        
+        // The header's label table is only used if it indexes the labels TensorIO loaded
+        
+        NSString *scoresName = [NSString stringWithUTF8String:_processor->scoresLayer().name.c_str()];
+        ModelBundleHeader *header = [ModelManager.sharedManager headerWithId:bundle.identifier];
+        
+        if ( _processor->labeled() && [header.path isEqualToString:bundle.path] && [header numberOfLabelsForOutput:scoresName] == _processor->labels().size() ) {
+            _header = header;
+            _scoresName = scoresName;
+        }
+    }
+    return self;
+}
+
+- (nullable NSDictionary<NSString*,id>*)processResults:(NSDictionary<NSString*,id>*)results model:(nullable id<TIOModel>)model {
+    std::vector<float> values;
+    std::vector<PostProcessor::Tensor> tensors;
+    
+    // The boxed results are only walked when the model's tensors cannot be read
+    
+    if ( ![self readTensors:&tensors values:&values model:model] && ![self readTensors:&tensors values:&values results:results] ) {
+        return nil;
+    }
+    
+    PostProcessor::Result result;
+    std::string error;
+    
+    if ( !_processor->run(tensors, &result, &error) ) {
+        NSLog(@"Unable to post-process results, error: %s", error.c_str());
+        return nil;
+    }
+    
+    return [self packageResult:result];
+}
+
+// MARK: - Reading Outputs
+
+/**
+ * Reads the output tensors of a TensorFlow Lite model that has just run. Float tensors are used
+ * in place and byte tensors dequantized into values. Returns false if the model's tensors cannot
+ * be read.
+ */
+
+- (BOOL)readTensors:(std::vector<PostProcessor::Tensor>*)tensors values:(std::vector<float>*)values model:(nullable id<TIOModel>)model {
+    if ( ![model isKindOfClass:TIOTFLiteModel.class] || ![model respondsToSelector:@selector(outputTensorAtIndex:)] || model.io.outputs.count != _names.count ) {
+        return NO;
+    }
+    
+    // Reserve the dequantized values up front so that tensors can point into them
+    
+    size_t quantizedSize = 0;
+    
+    for ( size_t i = 0; i < _sizes.size(); i++ ) {
+        quantizedSize += _dequantized[i].empty() ? 0 : _sizes[i];
+    }
+    
+    values->clear();
+    values->reserve(quantizedSize);
+    tensors->clear();
+    
+    for ( NSUInteger i = 0; i < _names.count; i++ ) {
+        if ( _sizes[i] == 0 ) {
+            tensors->push_back({nullptr, 0});
+            continue;
+        }
+        
+        const void *tensor = [(TIOTFLiteModel*)model outputTensorAtIndex:i];
+        
+        if ( tensor == NULL ) {
+            return NO;
+        }
+        
+        if ( _dequantized[i].empty() ) {
+            tensors->push_back({static_cast<const float*>(tensor), _sizes[i]});
+            continue;
+        }
+        
+        const uint8_t *bytes = static_cast<const uint8_t*>(tensor);
+        const float *table = _dequantized[i].data();
+        const size_t offset = values->size();
+        
+        for ( size_t j = 0; j < _sizes[i]; j++ ) {
+            values->push_back(table[bytes[j]]);
+        }
+        
+        tensors->push_back({values->data() + offset, _sizes[i]});
+    }
+    
+    return YES;
+}
+
+/**
+ * Flattens TensorIO's boxed results into values, in layer order and in label order for labeled
+ * layers, for models whose tensors cannot be read. Returns false if an output has the wrong
+ * number of values.
+ */
+
+- (BOOL)readTensors:(std::vector<PostProcessor::Tensor>*)tensors values:(std::vector<float>*)values results:(NSDictionary<NSString*,id>*)results {
+    std::vector<size_t> offsets;
+    
+    values->clear();
+    tensors->clear();
+    
+    for ( NSUInteger i = 0; i < _names.count; i++ ) {
+        id result = results[_names[i]];
+        offsets.push_back(values->size());
+        
+        if ( [result isKindOfClass:NSDictionary.class] ) {
+            for ( NSString *label in _labels[i] ) {
+                values->push_back([result[label] floatValue]);
+            }
+        } else if ( [result isKindOfClass:NSArray.class] ) {
+            for ( NSNumber *value in result ) {
+                values->push_back(value.floatValue);
+            }
+        } else if ( [result isKindOfClass:NSNumber.class] ) {
+            values->push_back([result floatValue]);
+        }
+        
+        if ( values->size() - offsets.back() != _sizes[i] ) {
+            NSLog(@"Unable to post-process results, the %@ output has the wrong number of values", _names[i]);
+            return NO;
+        }
+    }
+    
+    for ( NSUInteger i = 0; i < _names.count; i++ ) {
+        tensors->push_back({values->data() + offsets[i], _sizes[i]});
+    }
+    
+    return YES;
+}
+
+// MARK: - Packaging Results
+
+- (NSDictionary<NSString*,id>*)packageResult:(const PostProcessor::Result&)result {
+    const std::vector<std::string> &labels = _processor->labels();
+    const bool labeled = _processor->labeled();
+    
+    ModelBundleHeader *header = _header;
+    NSString *labelsOutput = _scoresName;
+    
+    auto Name = ^id (uint32_t index) {
+        if ( !labeled ) {
+            return (id)@(index);
+        }
+        return (id)([header labelAtIndex:index forOutput:labelsOutput] ?: [NSString stringWithUTF8String:labels[index].c_str()]);
+    };
+    
+    if ( _processor->detects() ) {
+        NSMutableArray *detections = [[NSMutableArray alloc] initWithCapacity:result.detections.size()];
+        
+        for ( const PostProcessor::Detection &detection : result.detections ) {
+            [detections addObject:@{
+                @"class": Name(detection.index),
+                @"score": @(detection.score),
+                @"box": @[@(detection.box[0]), @(detection.box[1]), @(detection.box[2]), @(detection.box[3])]
+            }];
+        }
+        
+        return @{
+            @"detections": detections.copy
+        };
+    }
+    
+    NSString *scoresName = [NSString stringWithUTF8String:_processor->scoresLayer().name.c_str()];
+    
+    if ( labeled ) {
+        NSMutableDictionary<NSString*,NSNumber*> *classifications = [[NSMutableDictionary alloc] initWithCapacity:result.classifications.size()];
+        for ( const PostProcessor::Classification &classification : result.classifications ) {
+            classifications[Name(classification.index)] = @(classification.score);
+        }
+        return @{
+            scoresName: classifications.copy
+        };
+    }
+    
+    NSMutableArray *classifications = [[NSMutableArray alloc] initWithCapacity:result.classifications.size()];
+    
+    for ( const PostProcessor::Classification &classification : result.classifications ) {
+        [classifications addObject:@{
+            @"index": @(classification.index),
+            @"score": @(classification.score)
+        }];
+    }
+    
+    return @{
+        scoresName: classifications.copy
+    };
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerModelPostProcessorDeclarationError(NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerModelPostProcessorErrorDomain code:NetRunnerModelPostProcessorDeclarationErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"The model's post_processing option is malformed: %@", description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Check the options.post_processing field in the model's model.json file."
+    }];
+}
+
+NSError * NetRunnerModelPostProcessorCompileError(NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerModelPostProcessorErrorDomain code:NetRunnerModelPostProcessorCompileErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"The model's post-processing stages could not be compiled: %@", description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure the stages are known, in order, and refer to output layers of the right shape."
+    }];
+}
@@ -0,0 +1,93 @@
+//
+//  PostProcessedModelOutput.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+#import "ModelOutput.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * The output of a model whose results have been processed by the stages declared in its
+ * model.json. See ModelPostProcessor.h for the form of the processed results. Smoothing, if any,
+ * is a matter for the declaration, so no decay is applied.
+ */
+
+@interface PostProcessedModelOutput : NSObject <ModelOutput>
+
+/**
+ * The processed results of the model.
+ */
+
+@property (readonly) NSDictionary<NSString*,id> *output;
+
+/**
+ * Designated initializer.
+ *
+ * @param dictionary Processed results, as produced by a `ModelPostProcessor`.
+ */
+
+- (instancetype)initWithDictionary:(NSDictionary<NSString*,id>*)dictionary NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+// Model Output Conformance
+
+/**
+ * An instance of `NSDictionary`, the same as output
+ */
+
+@property (readonly) id value;
+
+/**
+ * An instance of `NSDictionary`, the same as output
+ */
+
+@property (readonly) id propertyList;
+
+/**
+ * The classifications or detections with their scores in human readable format, highest first
+ */
+
+@property (readonly) NSString *localizedDescription;
+
+/**
+ * Determines if two outputs are equal or not. Compares the `output` dictionaries of the two models.
+ *
+ * @param anObject The object to compare equality against.
+ *
+ * @return `YES` if the two outputs dictionaries are equal, `NO` otherwise.
+ */
+
+- (BOOL)isEqual:(id)anObject;
+
+/**
+ * Return self, ignoring the previous output
+ */
+
+- (id<ModelOutput>)decayedOutput:(nullable id<ModelOutput>)previousOutput;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,93 @@
+//
+//  PostProcessedModelOutput.m
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "PostProcessedModelOutput.h"
+#import "NSArray+TIOExtensions.h"
+
+@interface PostProcessedModelOutput ()
+
+@property (readwrite) NSDictionary *output;
+
+@end
+
+@implementation PostProcessedModelOutput
+
+- (instancetype)initWithDictionary:(NSDictionary<NSString*,id>*)dictionary {
+    if (self = [super init]) {
+        _output = dictionary;
+    }
+    return self;
+}
+
+// MARK: -
+
+- (id)value {
+    return self.output;
+}
+
+- (id)propertyList {
+    return self.output;
+}
+
+- (NSString*)description {
+    return [self.output.description stringByReplacingOccurrencesOfString:@"\n" withString:@"\r"];
+}
+
+- (NSString*)localizedDescription {
+    NSMutableString *description = [NSMutableString string];
+    
+    // Detections and unlabeled classifications are already ordered by score
+    
+    for ( id results in self.output.allValues ) {
+        if ( [results isKindOfClass:NSDictionary.class] ) {
+            NSDictionary<NSString*,NSNumber*> *classifications = results;
+            for ( NSString *key in [classifications keysSortedByValueUsingSelector:@selector(compare:)].reversed ) {
+                [description appendFormat:@"(%.2f) %@\n", classifications[key].floatValue, key];
+            }
+        } else if ( [results isKindOfClass:NSArray.class] ) {
+            for ( NSDictionary *entry in results ) {
+                id name = entry[@"class"] != nil ? entry[@"class"] : entry[@"index"];
+                [description appendFormat:@"(%.2f) %@\n", [entry[@"score"] floatValue], name];
+            }
+        }
+    }
+    
+    if ( description.length > 0 ) {
+        [description deleteCharactersInRange:NSMakeRange(description.length-1, 1)];
+    }
+    
+    return description;
+}
+
+- (BOOL)isEqual:(id)anObject {
+    if ( ![anObject isKindOfClass:self.class] ) {
+        return NO;
+    }
+    
+    return [self.output isEqual:[anObject output]];
+}
+
+// MARK: -
+
+- (id<ModelOutput>)decayedOutput:(nullable id<ModelOutput>)previousOutput {
+    return self;
+}
+
+@end
@@ -0,0 +1,580 @@
+//
+//  PostProcessor.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "PostProcessor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NETRUNNER_POST_PROCESSOR_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NETRUNNER_POST_PROCESSOR_SSE 1
+#endif
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+// Batch dimensions of -1 count as one
+
+size_t ElementCount(const std::vector<int> &shape) {
+    size_t count = 1;
+    for ( int dimension : shape ) {
+        count *= static_cast<size_t>(std::abs(dimension));
+    }
+    return count;
+}
+
+size_t LastDimension(const std::vector<int> &shape) {
+    return shape.empty() ? 1 : static_cast<size_t>(std::max(std::abs(shape.back()), 1));
+}
+
+bool Number(const PostProcessor::Stage &stage, const std::string &key, double *value) {
+    auto number = stage.numbers.find(key);
+    if ( number == stage.numbers.end() ) {
+        return false;
+    }
+    *value = number->second;
+    return true;
+}
+
+double Number(const PostProcessor::Stage &stage, const std::string &key, double defaultValue) {
+    double value = defaultValue;
+    Number(stage, key, &value);
+    return value;
+}
+
+// Orders by descending score, ties by index
+
+bool HigherScore(const PostProcessor::Classification &a, const PostProcessor::Classification &b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+// The k highest of count scores, highest first, using a min-heap of the best seen so far
+
+void SelectTop(const float *scores, size_t count, size_t k, std::vector<PostProcessor::Classification> *top) {
+    top->clear();
+
+    for ( size_t i = 0; i < count; i++ ) {
+        PostProcessor::Classification entry{static_cast<uint32_t>(i), scores[i]};
+
+        if ( top->size() < k ) {
+            top->push_back(entry);
+            std::push_heap(top->begin(), top->end(), HigherScore);
+        } else if ( HigherScore(entry, top->front()) ) {
+            std::pop_heap(top->begin(), top->end(), HigherScore);
+            top->back() = entry;
+            std::push_heap(top->begin(), top->end(), HigherScore);
+        }
+    }
+
+    std::sort_heap(top->begin(), top->end(), HigherScore);
+}
+
+// The layer named by a stage's boxes parameter, if any
+
+const PostProcessor::Layer *BoxesLayer(const PostProcessor::Stage &stage, const std::vector<PostProcessor::Layer> &outputs) {
+    auto name = stage.strings.find("boxes");
+
+    if ( name == stage.strings.end() ) {
+        return nullptr;
+    }
+
+    for ( const PostProcessor::Layer &layer : outputs ) {
+        if ( layer.name == name->second ) {
+            return &layer;
+        }
+    }
+
+    return nullptr;
+}
+
+// Whether the stage at index is followed by nms with nothing but box decoding in between, in
+// which case a sigmoid is applied only to the scores nms selects rather than to every score
+
+bool FeedsSuppression(const std::vector<PostProcessor::Stage> &stages, size_t index) {
+    for ( size_t i = index + 1; i < stages.size(); i++ ) {
+        if ( stages[i].name != "ssd" ) {
+            return stages[i].name == "nms";
+        }
+    }
+    return false;
+}
+
+// The scores a stage reads, those transformed in the result or those of the model
+
+const float *Scores(const std::vector<PostProcessor::Tensor> &tensors, const PostProcessor::Result &result, size_t scoresIndex, bool transformed) {
+    return transformed ? result.scores.data() : tensors[scoresIndex].data;
+}
+
+// What the stages compiled so far leave in a result
+
+enum class Phase {
+    Scores,
+    Classifications,
+    Detections
+};
+
+} // namespace
+
+std::unique_ptr<PostProcessor> PostProcessor::Compile(const std::vector<Layer> &outputs, const std::string &scores, const std::vector<Stage> &stages, std::string *error) {
+    std::unique_ptr<PostProcessor> processor(new PostProcessor());
+    processor->_outputs = outputs;
+
+    for ( const Layer &layer : outputs ) {
+        processor->_sizes.push_back(ElementCount(layer.shape));
+    }
+
+    // The scores layer
+
+    auto scoresLayer = std::find_if(outputs.begin(), outputs.end(), [&](const Layer &layer) {
+        return scores.empty() || layer.name == scores;
+    });
+
+    if ( scoresLayer == outputs.end() ) {
+        SetError(error, scores.empty() ? "The model has no outputs" : "The model has no output named " + scores);
+        return nullptr;
+    }
+
+    const size_t scoresIndex = static_cast<size_t>(scoresLayer - outputs.begin());
+    const size_t count = processor->_sizes[scoresIndex];
+    const size_t classes = LastDimension(scoresLayer->shape);
+
+    processor->_scoresIndex = scoresIndex;
+
+    std::vector<Kernel> &kernels = processor->_kernels;
+
+    Phase phase = Phase::Scores;
+    bool transformsScores = false;
+    bool decodesBoxes = false;
+    bool fusedSigmoid = false;
+
+    for ( const Stage &stage : stages ) {
+        const std::string &name = stage.name;
+
+        if ( name == "softmax" || name == "sigmoid" ) {
+            if ( phase != Phase::Scores ) {
+                SetError(error, "The " + name + " stage must come before any stage that selects classes");
+                return nullptr;
+            }
+            if ( name == "softmax" ) {
+                kernels.push_back([count, classes](const std::vector<Tensor>&, Result &result) {
+                    Softmax(result.scores.data(), count, classes);
+                });
+                transformsScores = true;
+            } else if ( FeedsSuppression(stages, static_cast<size_t>(&stage - stages.data())) ) {
+                fusedSigmoid = true;
+            } else {
+                kernels.push_back([count](const std::vector<Tensor>&, Result &result) {
+                    Sigmoid(result.scores.data(), count);
+                });
+                transformsScores = true;
+            }
+        }
+
+        else if ( name == "argmax" ) {
+            if ( phase == Phase::Detections ) {
+                SetError(error, "The argmax stage does not apply to detections, use top_k with a k of 1");
+                return nullptr;
+            }
+            if ( phase == Phase::Scores ) {
+                kernels.push_back([=](const std::vector<Tensor> &tensors, Result &result) {
+                    const float *scores = Scores(tensors, result, scoresIndex, transformsScores);
+                    uint32_t best = static_cast<uint32_t>(ArgMax(scores, count));
+                    result.classifications.assign(1, {best, scores[best]});
+                });
+            } else {
+                kernels.push_back([](const std::vector<Tensor>&, Result &result) {
+                    auto best = std::min_element(result.classifications.begin(), result.classifications.end(), HigherScore);
+                    if ( best != result.classifications.end() ) {
+                        Classification classification = *best;
+                        result.classifications.assign(1, classification);
+                    }
+                });
+            }
+            phase = Phase::Classifications;
+        }
+
+        else if ( name == "top_k" ) {
+            double k;
+            if ( !Number(stage, "k", &k) || k < 1 || k != std::floor(k) ) {
+                SetError(error, "The top_k stage requires a positive integer k");
+                return nullptr;
+            }
+            const size_t top = static_cast<size_t>(k);
+
+            if ( phase == Phase::Scores ) {
+                kernels.push_back([=](const std::vector<Tensor> &tensors, Result &result) {
+                    SelectTop(Scores(tensors, result, scoresIndex, transformsScores), count, top, &result.classifications);
+                });
+                phase = Phase::Classifications;
+            } else if ( phase == Phase::Classifications ) {
+                kernels.push_back([top](const std::vector<Tensor>&, Result &result) {
+                    std::vector<Classification> &classifications = result.classifications;
+                    size_t kept = std::min(top, classifications.size());
+                    std::partial_sort(classifications.begin(), classifications.begin() + kept, classifications.end(), HigherScore);
+                    classifications.resize(kept);
+                });
+            } else {
+                kernels.push_back([top](const std::vector<Tensor>&, Result &result) {
+                    result.detections.resize(std::min(top, result.detections.size()));
+                });
+            }
+        }
+
+        else if ( name == "threshold" ) {
+            double value;
+            if ( !Number(stage, "value", &value) ) {
+                SetError(error, "The threshold stage requires a value");
+                return nullptr;
+            }
+            const float threshold = static_cast<float>(value);
+
+            if ( phase == Phase::Scores ) {
+                kernels.push_back([=](const std::vector<Tensor> &tensors, Result &result) {
+                    const float *scores = Scores(tensors, result, scoresIndex, transformsScores);
+                    for ( size_t i = 0; i < count; i++ ) {
+                        if ( scores[i] > threshold ) {
+                            result.classifications.push_back({static_cast<uint32_t>(i), scores[i]});
+                        }
+                    }
+                });
+                phase = Phase::Classifications;
+            } else if ( phase == Phase::Classifications ) {
+                kernels.push_back([threshold](const std::vector<Tensor>&, Result &result) {
+                    auto &classifications = result.classifications;
+                    classifications.erase(std::remove_if(classifications.begin(), classifications.end(), [threshold](const Classification &classification) {
+                        return !(classification.score > threshold);
+                    }), classifications.end());
+                });
+            } else {
+                kernels.push_back([threshold](const std::vector<Tensor>&, Result &result) {
+                    auto &detections = result.detections;
+                    detections.erase(std::remove_if(detections.begin(), detections.end(), [threshold](const Detection &detection) {
+                        return !(detection.score > threshold);
+                    }), detections.end());
+                });
+            }
+        }
+
+        else if ( name == "labels" ) {
+            processor->_labeled = true;
+        }
+
+        else if ( name == "ssd" ) {
+            if ( phase != Phase::Scores || decodesBoxes ) {
+                SetError(error, "The ssd stage must come once, before any stage that selects classes");
+                return nullptr;
+            }
+
+            const Layer *boxesLayer = BoxesLayer(stage, outputs);
+            const size_t rows = count / classes;
+
+            if ( boxesLayer == nullptr ) {
+                SetError(error, "The ssd stage requires the name of an output layer of box encodings");
+                return nullptr;
+            }
+
+            const size_t boxesIndex = static_cast<size_t>(boxesLayer - outputs.data());
+            auto anchors = stage.arrays.find("anchors");
+
+            if ( processor->_sizes[boxesIndex] != rows * 4 ) {
+                SetError(error, "The " + boxesLayer->name + " layer must have four values for each row of scores");
+                return nullptr;
+            }
+            if ( anchors == stage.arrays.end() || anchors->second.size() != rows * 4 ) {
+                SetError(error, "The ssd stage requires four anchor values for each row of scores");
+                return nullptr;
+            }
+
+            BoxScales scales;
+            scales.y = static_cast<float>(Number(stage, "y_scale", 10.0));
+            scales.x = static_cast<float>(Number(stage, "x_scale", 10.0));
+            scales.height = static_cast<float>(Number(stage, "h_scale", 5.0));
+            scales.width = static_cast<float>(Number(stage, "w_scale", 5.0));
+
+            if ( !(scales.y > 0 && scales.x > 0 && scales.height > 0 && scales.width > 0) ) {
+                SetError(error, "The ssd stage's scales must be positive");
+                return nullptr;
+            }
+
+            std::vector<float> anchorValues = anchors->second;
+
+            kernels.push_back([boxesIndex, rows, scales, anchorValues](const std::vector<Tensor> &tensors, Result &result) {
+                result.boxes.resize(rows * 4);
+                DecodeBoxes(tensors[boxesIndex].data, anchorValues.data(), rows, scales, result.boxes.data());
+            });
+
+            decodesBoxes = true;
+        }
+
+        else if ( name == "nms" ) {
+            if ( phase != Phase::Scores ) {
+                SetError(error, "The nms stage must come before any stage that selects classes");
+                return nullptr;
+            }
+
+            const Layer *boxesLayer = BoxesLayer(stage, outputs);
+            const size_t rows = count / classes;
+
+            if ( boxesLayer == nullptr && (stage.strings.count("boxes") != 0 || !decodesBoxes) ) {
+                SetError(error, "The nms stage requires the name of an output layer of boxes or a preceding ssd stage");
+                return nullptr;
+            }
+
+            // Boxes come from the named layer, or from the ssd stage's decoded boxes
+
+            const size_t boxesIndex = boxesLayer != nullptr ? static_cast<size_t>(boxesLayer - outputs.data()) : outputs.size();
+
+            if ( boxesLayer != nullptr && processor->_sizes[boxesIndex] != rows * 4 ) {
+                SetError(error, "The " + boxesLayer->name + " layer must have four values for each row of scores");
+                return nullptr;
+            }
+
+            const float iouThreshold = static_cast<float>(Number(stage, "iou_threshold", 0.5));
+            const float scoreThreshold = static_cast<float>(Number(stage, "score_threshold", 0.0));
+            const size_t maxDetections = static_cast<size_t>(std::max(Number(stage, "max_detections", 100.0), 0.0));
+            const bool classAgnostic = Number(stage, "class_agnostic", 0.0) != 0;
+            const bool logistic = fusedSigmoid;
+            const double background = Number(stage, "background", -1.0);
+            const size_t skipped = background >= 0 ? static_cast<size_t>(background) : classes;
+
+            kernels.push_back([=](const std::vector<Tensor> &tensors, Result &result) {
+                const float *boxes = boxesIndex < tensors.size() ? tensors[boxesIndex].data : result.boxes.data();
+                const float *scores = Scores(tensors, result, scoresIndex, transformsScores);
+                std::vector<Detection> &detections = result.detections;
+
+                // Each box's best class above the threshold is a candidate. The logistic function
+                // is monotonic, so a fused sigmoid is only applied to each box's best score.
+
+                for ( size_t row = 0; row < rows; row++ ) {
+                    const float *rowScores = scores + row * classes;
+                    size_t best = skipped == 0 ? 1 + ArgMax(rowScores + 1, classes - 1) : ArgMax(rowScores, std::min(skipped, classes));
+
+                    if ( skipped > 0 && skipped + 1 < classes ) {
+                        size_t after = skipped + 1 + ArgMax(rowScores + skipped + 1, classes - skipped - 1);
+                        if ( rowScores[after] > rowScores[best] ) {
+                            best = after;
+                        }
+                    }
+                    if ( best >= classes || best == skipped ) {
+                        continue;
+                    }
+
+                    float score = rowScores[best];
+                    if ( logistic ) {
+                        Sigmoid(&score, 1);
+                    }
+                    if ( !(score > scoreThreshold) ) {
+                        continue;
+                    }
+
+                    Detection detection{static_cast<uint32_t>(best), score, {0, 0, 0, 0}};
+                    std::copy(boxes + row * 4, boxes + row * 4 + 4, detection.box);
+                    detections.push_back(detection);
+                }
+
+                std::stable_sort(detections.begin(), detections.end(), [](const Detection &a, const Detection &b) {
+                    return a.score > b.score;
+                });
+
+                // Greedy suppression in score order, testing each candidate only against the kept
+                // boxes of its class, and keeping the survivors at the front
+
+                result.kept.resize(classAgnostic ? 1 : classes);
+
+                for ( BoxSet &set : result.kept ) {
+                    set.clear();
+                }
+
+                size_t kept = 0;
+
+                for ( size_t i = 0; i < detections.size() && kept < maxDetections; i++ ) {
+                    BoxSet &set = result.kept[classAgnostic ? 0 : detections[i].index];
+                    if ( !set.overlaps(detections[i].box, iouThreshold) ) {
+                        set.add(detections[i].box);
+                        detections[kept++] = detections[i];
+                    }
+                }
+
+                detections.resize(kept);
+            });
+
+            processor->_detects = true;
+            phase = Phase::Detections;
+        }
+
+        else {
+            SetError(error, "Unknown post-processing stage " + name);
+            return nullptr;
+        }
+    }
+
+    // Without a selecting stage every class is reported
+
+    if ( phase == Phase::Scores ) {
+        kernels.push_back([=](const std::vector<Tensor> &tensors, Result &result) {
+            const float *scores = Scores(tensors, result, scoresIndex, transformsScores);
+            for ( size_t i = 0; i < count; i++ ) {
+                result.classifications.push_back({static_cast<uint32_t>(i), scores[i]});
+            }
+        });
+    }
+
+    // Scores are only copied into the result when a stage transforms them in place
+
+    kernels.insert(kernels.begin(), [scoresIndex, transformsScores](const std::vector<Tensor> &tensors, Result &result) {
+        if ( transformsScores ) {
+            const Tensor &tensor = tensors[scoresIndex];
+            result.scores.assign(tensor.data, tensor.data + tensor.size);
+        } else {
+            result.scores.clear();
+        }
+        result.classifications.clear();
+        result.detections.clear();
+    });
+
+    if ( processor->_labeled ) {
+        const size_t expected = processor->_detects ? classes : count;
+        if ( scoresLayer->labels.size() != expected ) {
+            SetError(error, "The labels stage requires " + std::to_string(expected) + " labels on the " + scoresLayer->name + " layer");
+            return nullptr;
+        }
+    }
+
+    return processor;
+}
+
+bool PostProcessor::run(const std::vector<Tensor> &outputs, Result *result, std::string *error) const {
+    if ( outputs.size() != _sizes.size() ) {
+        SetError(error, "Expected " + std::to_string(_sizes.size()) + " output tensors, got " + std::to_string(outputs.size()));
+        return false;
+    }
+
+    for ( size_t i = 0; i < outputs.size(); i++ ) {
+        if ( outputs[i].size != _sizes[i] ) {
+            SetError(error, "The " + _outputs[i].name + " tensor has " + std::to_string(outputs[i].size) + " values, expected " + std::to_string(_sizes[i]));
+            return false;
+        }
+    }
+
+    for ( const Kernel &kernel : _kernels ) {
+        kernel(outputs, *result);
+    }
+
+    return true;
+}
+
+// MARK: - Kernels
+
+void PostProcessor::Softmax(float *values, size_t count, size_t classes) {
+    for ( size_t row = 0; row + classes <= count; row += classes ) {
+        float *x = values + row;
+        const float max = *std::max_element(x, x + classes);
+        float sum = 0;
+
+        for ( size_t i = 0; i < classes; i++ ) {
+            x[i] = std::exp(x[i] - max);
+            sum += x[i];
+        }
+
+        const float scale = 1.0f / sum;
+
+        for ( size_t i = 0; i < classes; i++ ) {
+            x[i] *= scale;
+        }
+    }
+}
+
+void PostProcessor::Sigmoid(float *values, size_t count) {
+    for ( size_t i = 0; i < count; i++ ) {
+        values[i] = 1.0f / (1.0f + std::exp(-values[i]));
+    }
+}
+
+size_t PostProcessor::ArgMax(const float *values, size_t count) {
+    if ( count == 0 ) {
+        return 0;
+    }
+
+    float best = values[0];
+    size_t i = 0;
+
+#if NETRUNNER_POST_PROCESSOR_NEON
+    if ( count >= 4 ) {
+        float32x4_t maximum = vld1q_f32(values);
+        for ( i = 4; i + 4 <= count; i += 4 ) {
+            maximum = vmaxq_f32(maximum, vld1q_f32(values + i));
+        }
+        float32x2_t pair = vpmax_f32(vget_low_f32(maximum), vget_high_f32(maximum));
+        best = vget_lane_f32(vpmax_f32(pair, pair), 0);
+    }
+#elif NETRUNNER_POST_PROCESSOR_SSE
+    if ( count >= 4 ) {
+        __m128 maximum = _mm_loadu_ps(values);
+        for ( i = 4; i + 4 <= count; i += 4 ) {
+            maximum = _mm_max_ps(maximum, _mm_loadu_ps(values + i));
+        }
+        maximum = _mm_max_ps(maximum, _mm_movehl_ps(maximum, maximum));
+        best = _mm_cvtss_f32(_mm_max_ss(maximum, _mm_shuffle_ps(maximum, maximum, 1)));
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        best = values[i] > best ? values[i] : best;
+    }
+
+    // The first index of the maximum, or of the first value if every value is NaN
+
+    for ( i = 0; i < count; i++ ) {
+        if ( values[i] == best ) {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+float PostProcessor::IntersectionOverUnion(const float *a, const float *b) {
+    const float areaA = (a[2] - a[0]) * (a[3] - a[1]);
+    const float areaB = (b[2] - b[0]) * (b[3] - b[1]);
+
+    if ( areaA <= 0 || areaB <= 0 ) {
+        return 0;
+    }
+
+    const float height = std::max(0.0f, std::min(a[2], b[2]) - std::max(a[0], b[0]));
+    const float width = std::max(0.0f, std::min(a[3], b[3]) - std::max(a[1], b[1]));
+    const float intersection = height * width;
+
+    return intersection / (areaA + areaB - intersection);
+}
+
+} // namespace netrunner
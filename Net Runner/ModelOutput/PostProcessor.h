@@ -0,0 +1,222 @@
+//
+//  PostProcessor.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef PostProcessor_h
+#define PostProcessor_h
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DetectionBoxes.h"
+
+namespace netrunner {
+
+/**
+ * A model's output post-processing, declared in model.json and compiled into a chain of kernels
+ * that run directly on the model's output tensors.
+ *
+ * The declaration names the output layer that holds the scores and lists the stages applied to
+ * them, in order:
+ *
+ * @code
+ * "options": {
+ *   "post_processing": {
+ *     "scores": "classification",
+ *     "stages": [
+ *       { "stage": "softmax" },
+ *       { "stage": "top_k", "k": 5 },
+ *       { "stage": "threshold", "value": 0.1 },
+ *       { "stage": "labels" }
+ *     ]
+ *   }
+ * }
+ * @endcode
+ *
+ * Stages:
+ *
+ * - softmax: normalizes the scores over the last dimension of the scores layer
+ * - sigmoid: applies the logistic function to each score
+ * - argmax: selects the class with the highest score
+ * - top_k: selects the `k` classes or detections with the highest scores
+ * - threshold: keeps classes or detections whose scores are above `value`
+ * - labels: reports classes by the scores layer's labels rather than by index
+ * - ssd: decodes the SSD box encodings of the `boxes` layer against the `anchors` read from the
+ *   model's assets, with the box coder's `y_scale`, `x_scale`, `h_scale` and `w_scale`, see
+ *   DetectionBoxes.h. The decoded boxes are used by a following nms stage.
+ * - nms: decodes detections from corner form boxes, those of the `boxes` layer, four values per
+ *   box ordered ymin, xmin, ymax, xmax, or those of a preceding ssd stage, and a row of class
+ *   scores per box, keeping each box's best class above `score_threshold` and skipping the
+ *   `background` class if one is given. Boxes that overlap a higher scoring box of the same
+ *   class by more than `iou_threshold` are suppressed, or of any class when `class_agnostic` is
+ *   set, up to `max_detections`.
+ *
+ * Softmax and sigmoid must come before any stage that selects classes. Without a selecting stage
+ * every class is reported, in index order. A sigmoid followed by nms is fused into it and applied
+ * only to each box's best score, since the logistic function preserves order.
+ *
+ * Compiling checks the stages against the model's output layers, so a model whose declaration
+ * is invalid is rejected when it is loaded rather than when it is run. A compiled processor is
+ * immutable and may be shared between threads, each with its own `Result`.
+ */
+
+class PostProcessor {
+public:
+
+    /**
+     * An output layer as described in model.json.
+     */
+
+    struct Layer {
+        std::string name;
+        std::vector<int> shape;
+        std::vector<std::string> labels;
+    };
+
+    /**
+     * A stage as declared in model.json, its name and its numeric, string and array parameters.
+     * Arrays hold lists of numbers, including anchors the loader has read from an asset.
+     */
+
+    struct Stage {
+        std::string name;
+        std::map<std::string, double> numbers;
+        std::map<std::string, std::string> strings;
+        std::map<std::string, std::vector<float>> arrays;
+    };
+
+    /**
+     * A view of an output tensor's values, dequantized to floats.
+     */
+
+    struct Tensor {
+        const float *data;
+        size_t size;
+    };
+
+    struct Classification {
+        uint32_t index;
+        float score;
+    };
+
+    struct Detection {
+        uint32_t index;
+        float score;
+        float box[4];
+    };
+
+    /**
+     * The output of a run: either the selected classes or the detections, and the scores after
+     * softmax or sigmoid, which are empty if neither stage applies. Reuse a result across runs to
+     * avoid reallocating its storage, including the decoded boxes and the boxes kept by
+     * suppression.
+     */
+
+    struct Result {
+        std::vector<float> scores;
+        std::vector<Classification> classifications;
+        std::vector<Detection> detections;
+        std::vector<float> boxes;
+        std::vector<BoxSet> kept;
+    };
+
+    /**
+     * Compiles the stages against the model's output layers. Returns nullptr and sets error if
+     * a stage is unknown, is out of order, or refers to a layer that is missing or has the wrong
+     * shape or labels.
+     *
+     * @param scores The name of the layer holding the scores, or empty for the first layer.
+     */
+
+    static std::unique_ptr<PostProcessor> Compile(const std::vector<Layer> &outputs, const std::string &scores, const std::vector<Stage> &stages, std::string *error);
+
+    PostProcessor(const PostProcessor&) = delete;
+    PostProcessor& operator=(const PostProcessor&) = delete;
+
+    /**
+     * Runs the stages on the output tensors, one per output layer in layer order. Returns false
+     * and sets error if a tensor does not have the size of its layer.
+     */
+
+    bool run(const std::vector<Tensor> &outputs, Result *result, std::string *error) const;
+
+    /**
+     * The layer holding the scores, whose name keys classification results.
+     */
+
+    const Layer &scoresLayer() const { return _outputs[_scoresIndex]; }
+
+    /**
+     * Whether results are detections rather than classifications.
+     */
+
+    bool detects() const { return _detects; }
+
+    /**
+     * Whether results should be reported by label, in which case indexes are into `labels()`.
+     */
+
+    bool labeled() const { return _labeled; }
+
+    const std::vector<std::string> &labels() const { return scoresLayer().labels; }
+
+    // MARK: - Kernels
+
+    /**
+     * Softmax of each consecutive run of `classes` values, in place.
+     */
+
+    static void Softmax(float *values, size_t count, size_t classes);
+
+    static void Sigmoid(float *values, size_t count);
+
+    /**
+     * The index of the first of the highest values, vectorized.
+     */
+
+    static size_t ArgMax(const float *values, size_t count);
+
+    /**
+     * The intersection over union of two corner form boxes.
+     */
+
+    static float IntersectionOverUnion(const float *a, const float *b);
+
+private:
+    using Kernel = std::function<void(const std::vector<Tensor>&, Result&)>;
+
+    PostProcessor() = default;
+
+    std::vector<Layer> _outputs;
+    std::vector<size_t> _sizes;
+    size_t _scoresIndex = 0;
+    bool _detects = false;
+    bool _labeled = false;
+
+    std::vector<Kernel> _kernels;
+};
+
+} // namespace netrunner
+
+#endif /* PostProcessor_h */
@@ -0,0 +1,237 @@
+//
+//  ScoreSmoother.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ScoreSmoother.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NETRUNNER_SCORE_SMOOTHER_NEON 1
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define NETRUNNER_SCORE_SMOOTHER_SSE 1
+#endif
+
+namespace netrunner {
+
+namespace {
+
+// The running sum of a window drifts from the sum of its frames as values are added and
+// subtracted, so it is recomputed from the window this often
+
+constexpr uint64_t kWindowResumInterval = 1024;
+
+// Orders entries by descending score, ties by index, so that a heap ordered by it keeps its
+// weakest entry at the front
+
+bool HigherScore(const ScoreSmoother::Entry &a, const ScoreSmoother::Entry &b) {
+    return a.score > b.score || (a.score == b.score && a.index < b.index);
+}
+
+} // namespace
+
+ScoreSmoother::ScoreSmoother(size_t count) : ScoreSmoother(count, Options()) {}
+
+ScoreSmoother::ScoreSmoother(size_t count, const Options &options)
+    : _count(count), _options(options), _state(count, 0) {
+    if ( _options.mode == Mode::WindowedMean ) {
+        assert(_options.window > 0);
+        _history.assign(std::max<size_t>(_options.window, 1) * count, 0);
+        _sum.assign(count, 0);
+    }
+    if ( _options.mode == Mode::Hysteresis ) {
+        _visible.assign(count, 0);
+    }
+}
+
+void ScoreSmoother::update(const float *scores) {
+    switch ( _options.mode ) {
+    case Mode::Exponential:
+    case Mode::Hysteresis:
+        if ( _frames == 0 ) {
+            std::memcpy(_state.data(), scores, _count * sizeof(float));
+        } else {
+            Blend(_state.data(), scores, _count, _options.decay);
+        }
+        if ( _options.mode == Mode::Hysteresis ) {
+            updateVisibility();
+        }
+        break;
+
+    case Mode::WindowedMean: {
+        const size_t window = _history.size() / std::max<size_t>(_count, 1);
+        float *slot = _history.data() + (_frames % window) * _count;
+        const size_t filled = static_cast<size_t>(std::min<uint64_t>(_frames + 1, window));
+
+        // The slot holds the frame leaving the window, or zeros while the window fills
+
+        Accumulate(_sum.data(), scores, slot, _count);
+        std::memcpy(slot, scores, _count * sizeof(float));
+
+        if ( (_frames + 1) % kWindowResumInterval == 0 ) {
+            std::fill(_sum.begin(), _sum.end(), 0.0f);
+            std::vector<float> zeros(_count, 0);
+            for ( size_t i = 0; i < filled; i++ ) {
+                Accumulate(_sum.data(), _history.data() + i * _count, zeros.data(), _count);
+            }
+        }
+
+        Scale(_state.data(), _sum.data(), _count, 1.0f / static_cast<float>(filled));
+        break;
+    }
+    }
+
+    _frames += 1;
+}
+
+void ScoreSmoother::reset() {
+    _frames = 0;
+    std::fill(_state.begin(), _state.end(), 0.0f);
+    std::fill(_history.begin(), _history.end(), 0.0f);
+    std::fill(_sum.begin(), _sum.end(), 0.0f);
+    std::fill(_visible.begin(), _visible.end(), 0);
+}
+
+void ScoreSmoother::updateVisibility() {
+    const float enter = _options.enterThreshold;
+    const float exit = _options.exitThreshold;
+
+    for ( size_t i = 0; i < _count; i++ ) {
+        _visible[i] = _state[i] >= (_visible[i] ? exit : enter);
+    }
+}
+
+bool ScoreSmoother::isVisible(size_t index, float threshold) const {
+    assert(index < _count);
+
+    if ( _options.mode == Mode::Hysteresis ) {
+        return _visible[index] != 0;
+    }
+    return _state[index] > threshold;
+}
+
+void ScoreSmoother::top(size_t k, float threshold, std::vector<Entry> *entries) const {
+    entries->clear();
+
+    if ( k == 0 || _frames == 0 ) {
+        return;
+    }
+
+    const bool hysteresis = _options.mode == Mode::Hysteresis;
+
+    // A min-heap of the best k entries seen so far, whose front is the weakest of them
+
+    for ( size_t i = 0; i < _count; i++ ) {
+        const float score = _state[i];
+
+        if ( hysteresis ? !_visible[i] : !(score > threshold) ) {
+            continue;
+        }
+
+        Entry entry{static_cast<uint32_t>(i), score};
+
+        if ( entries->size() < k ) {
+            entries->push_back(entry);
+            std::push_heap(entries->begin(), entries->end(), HigherScore);
+        } else if ( HigherScore(entry, entries->front()) ) {
+            std::pop_heap(entries->begin(), entries->end(), HigherScore);
+            entries->back() = entry;
+            std::push_heap(entries->begin(), entries->end(), HigherScore);
+        }
+    }
+
+    std::sort_heap(entries->begin(), entries->end(), HigherScore);
+}
+
+// MARK: - Kernels
+
+void ScoreSmoother::Blend(float *state, const float *scores, size_t count, float decay) {
+    const float update = 1.0f - decay;
+    size_t i = 0;
+
+#if NETRUNNER_SCORE_SMOOTHER_NEON
+    const float32x4_t decays = vdupq_n_f32(decay);
+    const float32x4_t updates = vdupq_n_f32(update);
+    for ( ; i + 4 <= count; i += 4 ) {
+        float32x4_t decayed = vmulq_f32(vld1q_f32(state + i), decays);
+#if defined(__aarch64__)
+        vst1q_f32(state + i, vfmaq_f32(decayed, vld1q_f32(scores + i), updates));
+#else
+        vst1q_f32(state + i, vmlaq_f32(decayed, vld1q_f32(scores + i), updates));
+#endif
+    }
+#elif NETRUNNER_SCORE_SMOOTHER_SSE
+    const __m128 decays = _mm_set1_ps(decay);
+    const __m128 updates = _mm_set1_ps(update);
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 decayed = _mm_mul_ps(_mm_loadu_ps(state + i), decays);
+        _mm_storeu_ps(state + i, _mm_add_ps(decayed, _mm_mul_ps(_mm_loadu_ps(scores + i), updates)));
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        state[i] = state[i] * decay + scores[i] * update;
+    }
+}
+
+void ScoreSmoother::Accumulate(float *sum, const float *add, const float *subtract, size_t count) {
+    size_t i = 0;
+
+#if NETRUNNER_SCORE_SMOOTHER_NEON
+    for ( ; i + 4 <= count; i += 4 ) {
+        float32x4_t difference = vsubq_f32(vld1q_f32(add + i), vld1q_f32(subtract + i));
+        vst1q_f32(sum + i, vaddq_f32(vld1q_f32(sum + i), difference));
+    }
+#elif NETRUNNER_SCORE_SMOOTHER_SSE
+    for ( ; i + 4 <= count; i += 4 ) {
+        __m128 difference = _mm_sub_ps(_mm_loadu_ps(add + i), _mm_loadu_ps(subtract + i));
+        _mm_storeu_ps(sum + i, _mm_add_ps(_mm_loadu_ps(sum + i), difference));
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        sum[i] += add[i] - subtract[i];
+    }
+}
+
+void ScoreSmoother::Scale(float *out, const float *in, size_t count, float scale) {
+    size_t i = 0;
+
+#if NETRUNNER_SCORE_SMOOTHER_NEON
+    const float32x4_t scales = vdupq_n_f32(scale);
+    for ( ; i + 4 <= count; i += 4 ) {
+        vst1q_f32(out + i, vmulq_f32(vld1q_f32(in + i), scales));
+    }
+#elif NETRUNNER_SCORE_SMOOTHER_SSE
+    const __m128 scales = _mm_set1_ps(scale);
+    for ( ; i + 4 <= count; i += 4 ) {
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), scales));
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        out[i] = in[i] * scale;
+    }
+}
+
+} // namespace netrunner
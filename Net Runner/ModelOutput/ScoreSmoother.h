@@ -0,0 +1,173 @@
+//
+//  ScoreSmoother.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ScoreSmoother_h
+#define ScoreSmoother_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * Smooths a classification model's scores over successive live frames.
+ *
+ * The smoother keeps a dense state vector indexed by output class, the same order as the
+ * model's labels, and updates it in place from each frame's scores. Three kinds of smoothing are
+ * supported:
+ *
+ * - Exponential: an exponential moving average, `state = decay * state + (1 - decay) * scores`
+ * - WindowedMean: the mean of the scores of the last `window` frames
+ * - Hysteresis: an exponential moving average in which a class becomes visible once its score
+ *   reaches `enterThreshold` and stays visible until it falls below `exitThreshold`, so that
+ *   classes near a single threshold do not flicker in and out
+ *
+ * The first frame initializes the state. The top classes are reported by index, and only the
+ * handful that are displayed need to be mapped back to labels.
+ *
+ * The update kernels use NEON fused multiply-adds on ARM and SSE on x86, with a scalar fallback.
+ * A smoother is not thread safe.
+ */
+
+class ScoreSmoother {
+public:
+
+    enum class Mode {
+        Exponential,
+        WindowedMean,
+        Hysteresis
+    };
+
+    struct Options {
+        Mode mode = Mode::Exponential;
+
+        /**
+         * The weight of the previous state, for exponential and hysteresis smoothing.
+         */
+
+        float decay = 0.7f;
+
+        /**
+         * The number of frames averaged, for windowed mean smoothing.
+         */
+
+        size_t window = 8;
+
+        /**
+         * The scores at which a class becomes visible and stops being visible, for hysteresis
+         * smoothing. The enter threshold should be above the exit threshold.
+         */
+
+        float enterThreshold = 0.1f;
+        float exitThreshold = 0.05f;
+    };
+
+    /**
+     * A class index and its smoothed score.
+     */
+
+    struct Entry {
+        uint32_t index;
+        float score;
+    };
+
+    explicit ScoreSmoother(size_t count);
+    ScoreSmoother(size_t count, const Options &options);
+
+    /**
+     * Folds a frame's scores into the state. `scores` must hold `count()` values.
+     */
+
+    void update(const float *scores);
+
+    /**
+     * Forgets every frame, so that the next frame initializes the state.
+     */
+
+    void reset();
+
+    size_t count() const { return _count; }
+    uint64_t frames() const { return _frames; }
+    const Options &options() const { return _options; }
+
+    /**
+     * The smoothed scores, `count()` values in class order.
+     */
+
+    const float *scores() const { return _state.data(); }
+
+    /**
+     * Whether a class is visible, which for hysteresis smoothing depends on the class's history
+     * and otherwise on whether its score is above the threshold.
+     */
+
+    bool isVisible(size_t index, float threshold) const;
+
+    /**
+     * The at most `k` visible classes with the highest smoothed scores, highest first, ties by
+     * index. Hysteresis smoothing ignores `threshold` in favor of its own thresholds. Runs in
+     * O(count log k) and reuses the storage of `entries`.
+     */
+
+    void top(size_t k, float threshold, std::vector<Entry> *entries) const;
+
+    // MARK: - Kernels
+
+    /**
+     * `state[i] = decay * state[i] + (1 - decay) * scores[i]`
+     */
+
+    static void Blend(float *state, const float *scores, size_t count, float decay);
+
+    /**
+     * `sum[i] += add[i] - subtract[i]`
+     */
+
+    static void Accumulate(float *sum, const float *add, const float *subtract, size_t count);
+
+    /**
+     * `out[i] = in[i] * scale`
+     */
+
+    static void Scale(float *out, const float *in, size_t count, float scale);
+
+private:
+    void updateVisibility();
+
+    const size_t _count;
+    const Options _options;
+    uint64_t _frames = 0;
+
+    std::vector<float> _state;
+
+    // The last `window` frames and their running sum, for windowed mean smoothing
+
+    std::vector<float> _history;
+    std::vector<float> _sum;
+
+    // Whether each class is visible, for hysteresis smoothing
+
+    std::vector<uint8_t> _visible;
+};
+
+} // namespace netrunner
+
+#endif /* ScoreSmoother_h */
@@ -0,0 +1,107 @@
+//
+//  RecordBatchDataSource.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A `TIOBatchDataSource` backed by a memory mapped record file, or by a directory of record file
+ * shards. See RecordFile.h and RecordShards.h for the formats.
+ *
+ * Unlike the `TIOInMemoryBatchDataSource`, the dataset is never loaded into memory. Tensor fields
+ * are vended as `NSData` objects that point directly into the mapped file, so the only copy made
+ * is the one into the model's input tensor. Pages are faulted in by the kernel as items are
+ * requested and may be evicted under memory pressure.
+ *
+ * Blob fields, such as compressed images, are vended as `NSData` unless `decodesImages` is set,
+ * in which case jpeg and png payloads are decoded into `TIOPixelBuffer` objects.
+ *
+ * Tensor fields marked as preprocessed, such as those written by `ImageModelLabelsShardExporter`,
+ * are vended as `RecordTensor` objects, which are copied into a model's input without running the
+ * vision pipeline. Training on them skips decoding and resizing images on every epoch.
+ */
+
+@interface RecordBatchDataSource : NSObject <TIOBatchDataSource>
+
+/**
+ * The path to the underlying record file or directory of shards.
+ */
+
+@property (readonly) NSString *path;
+
+/**
+ * The batch keys, corresponding to the names of the fields in the records.
+ */
+
+@property (readonly) NSArray<NSString*> *keys;
+
+/**
+ * When `YES`, blob fields with a "jpeg" or "png" encoding are decoded into `TIOPixelBuffer`
+ * objects. Defaults to `NO`.
+ */
+
+@property BOOL decodesImages;
+
+/**
+ * Designated initializer. Maps the record file, or every shard in the directory, at path.
+ *
+ * @param path The path to a closed record file or a directory of shards.
+ * @param error Set if a file cannot be mapped or is not a valid record file.
+ *
+ * @return instancetype A data source or `nil` if the file could not be opened.
+ */
+
+- (nullable instancetype)initWithPath:(NSString*)path error:(NSError**)error NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * The total number of records in the file or shards.
+ */
+
+- (NSUInteger)numberOfItems;
+
+/**
+ * The item at a given index, after applying the current shuffle. Constant time.
+ */
+
+- (TIOBatchItem *)itemAtIndex:(NSUInteger)index;
+
+/**
+ * Randomly permutes the order in which items are vended. Call once per epoch.
+ */
+
+- (void)shuffle;
+
+/**
+ * Restores the on-disk order of items.
+ */
+
+- (void)unshuffle;
+
+@end
+
+NS_ASSUME_NONNULL_END
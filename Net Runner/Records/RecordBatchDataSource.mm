@@ -0,0 +1,165 @@
+//
+//  RecordBatchDataSource.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "RecordBatchDataSource.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "RecordShards.h"
+
+#import "RecordTensor.h"
+
+@import UIKit;
+
+using namespace netrunner::records;
+
+// MARK: - Errors
+
+static NSString * const NetRunnerRecordBatchDataSourceErrorDomain = @"ai.doc.net-runner.record-batch-data-source";
+
+static const NSInteger NetRunnerRecordBatchDataSourceOpenErrorCode = 101;
+
+NSError * NetRunnerRecordBatchDataSourceOpenError(NSString *description);
+
+// MARK: -
+
+@interface RecordBatchDataSource ()
+
+@property (readwrite) NSString *path;
+@property (readwrite) NSArray<NSString*> *keys;
+
+@end
+
+@implementation RecordBatchDataSource {
+    std::shared_ptr<ShardedRecordReader> _reader;
+    std::vector<uint32_t> _order;
+    BOOL _shuffled;
+}
+
+- (nullable instancetype)initWithPath:(NSString*)path error:(NSError**)error {
+    if ((self=[super init])) {
+        std::string readerError;
+        _reader = ShardedRecordReader::Open(path.UTF8String, &readerError);
+
+        if ( _reader == nullptr ) {
+            NSString *description = [NSString stringWithUTF8String:readerError.c_str()];
+            NSLog(@"Unable to open record file or shards at path %@, error: %@", path, description);
+            if (error) {
+                *error = NetRunnerRecordBatchDataSourceOpenError(description);
+            }
+            return nil;
+        }
+
+        NSMutableArray<NSString*> *keys = [[NSMutableArray alloc] init];
+        for ( const FieldSpec &field : _reader->schema().fields ) {
+            [keys addObject:[NSString stringWithUTF8String:field.name.c_str()]];
+        }
+
+        _path = path;
+        _keys = keys.copy;
+        _shuffled = NO;
+    }
+    return self;
+}
+
+- (NSUInteger)numberOfItems {
+    return _reader->count();
+}
+
+- (TIOBatchItem *)itemAtIndex:(NSUInteger)index {
+    assert(index < _reader->count());
+
+    size_t record = _shuffled ? _order[index] : index;
+    NSMutableDictionary<NSString*,id<TIOData>> *item = [[NSMutableDictionary alloc] initWithCapacity:self.keys.count];
+
+    for ( NSUInteger i = 0; i < self.keys.count; i++ ) {
+        const FieldSpec &spec = _reader->schema().fields[i];
+        FieldView view = _reader->field(record, i);
+
+        if ( spec.kind == FieldKind::Blob && self.decodesImages && (spec.encoding == "jpeg" || spec.encoding == "png") ) {
+            item[self.keys[i]] = [self pixelBufferForView:view];
+        } else if ( spec.kind == FieldKind::Tensor && spec.encoding == kPreprocessedEncoding ) {
+            item[self.keys[i]] = [[RecordTensor alloc] initWithData:[self dataForView:view]];
+        } else {
+            item[self.keys[i]] = [self dataForView:view];
+        }
+    }
+
+    return item.copy;
+}
+
+/**
+ * Wraps the mapped bytes without copying them. The deallocator retains the reader so that the
+ * mapping outlives any data handed to a model, even if this data source is released first.
+ */
+
+- (NSData*)dataForView:(FieldView)view {
+    std::shared_ptr<ShardedRecordReader> reader = _reader;
+
+    return [[NSData alloc] initWithBytesNoCopy:(void*)view.data length:view.length deallocator:^(void * _Nonnull bytes, NSUInteger length) {
+        (void)reader;
+    }];
+}
+
+- (id<TIOData>)pixelBufferForView:(FieldView)view {
+    NSData *data = [self dataForView:view];
+    UIImage *image = [[UIImage alloc] initWithData:data];
+    CVPixelBufferRef pixelBuffer = image.pixelBuffer;
+
+    if ( pixelBuffer == NULL ) {
+        NSLog(@"Unable to decode image payload in record file at path %@", self.path);
+        return data;
+    }
+
+    return [[TIOPixelBuffer alloc] initWithPixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationUp];
+}
+
+// MARK: - Shuffling
+
+- (void)shuffle {
+    if ( _order.size() != _reader->count() ) {
+        _order.resize(_reader->count());
+        std::iota(_order.begin(), _order.end(), 0);
+    }
+
+    std::random_device seed;
+    std::mt19937 generator(seed());
+    std::shuffle(_order.begin(), _order.end(), generator);
+
+    _shuffled = YES;
+}
+
+- (void)unshuffle {
+    _shuffled = NO;
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerRecordBatchDataSourceOpenError(NSString *description) {
+    return [[NSError alloc] initWithDomain:NetRunnerRecordBatchDataSourceErrorDomain code:NetRunnerRecordBatchDataSourceOpenErrorCode userInfo:@{
+        NSLocalizedDescriptionKey: [NSString stringWithFormat:@"There was a problem opening the record file: %@", description],
+        NSLocalizedRecoverySuggestionErrorKey: @"Make sure the file or shards exist and were closed after they were written."
+    }];
+}
@@ -0,0 +1,218 @@
+//
+//  RecordFile.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "RecordFile.h"
+
+#include <cstring>
+
+namespace netrunner {
+namespace records {
+
+size_t DTypeSize(DType dtype) {
+    switch (dtype) {
+    case DType::UInt8:   return 1;
+    case DType::Float32: return 4;
+    case DType::Int32:   return 4;
+    case DType::Int64:   return 8;
+    }
+    return 0;
+}
+
+// MARK: - FieldSpec
+
+size_t FieldSpec::byteSize() const {
+    if ( kind != FieldKind::Tensor ) {
+        return 0;
+    }
+
+    size_t count = 1;
+    for ( int32_t dim : shape ) {
+        count *= static_cast<size_t>(dim > 0 ? dim : 0);
+    }
+
+    return count * DTypeSize(dtype);
+}
+
+FieldSpec FieldSpec::Tensor(const std::string &name, DType dtype, const std::vector<int32_t> &shape) {
+    FieldSpec spec;
+    spec.name = name;
+    spec.kind = FieldKind::Tensor;
+    spec.dtype = dtype;
+    spec.shape = shape;
+    return spec;
+}
+
+FieldSpec FieldSpec::Blob(const std::string &name, const std::string &encoding) {
+    FieldSpec spec;
+    spec.name = name;
+    spec.kind = FieldKind::Blob;
+    spec.dtype = DType::UInt8;
+    spec.encoding = encoding;
+    return spec;
+}
+
+// MARK: - Schema
+
+int Schema::indexOf(const std::string &name) const {
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        if ( fields[i].name == name ) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool Schema::operator==(const Schema &other) const {
+    if ( fields.size() != other.fields.size() ) {
+        return false;
+    }
+
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        const FieldSpec &a = fields[i];
+        const FieldSpec &b = other.fields[i];
+
+        if ( a.name != b.name || a.kind != b.kind || a.dtype != b.dtype
+            || a.shape != b.shape || a.encoding != b.encoding ) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// MARK: - Schema Encoding
+
+namespace format {
+
+namespace {
+
+template <typename T>
+void Put(std::vector<uint8_t> &out, T value) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void PutString(std::vector<uint8_t> &out, const std::string &value) {
+    Put<uint16_t>(out, static_cast<uint16_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+class Cursor {
+public:
+    Cursor(const uint8_t *bytes, size_t length) : _bytes(bytes), _length(length), _offset(0) {}
+
+    template <typename T>
+    bool get(T *value) {
+        if ( _offset + sizeof(T) > _length ) {
+            return false;
+        }
+        std::memcpy(value, _bytes + _offset, sizeof(T));
+        _offset += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string *value) {
+        uint16_t length;
+        if ( !get(&length) || _offset + length > _length ) {
+            return false;
+        }
+        value->assign(reinterpret_cast<const char*>(_bytes + _offset), length);
+        _offset += length;
+        return true;
+    }
+
+private:
+    const uint8_t *_bytes;
+    size_t _length;
+    size_t _offset;
+};
+
+} // namespace
+
+std::vector<uint8_t> EncodeSchema(const Schema &schema) {
+    std::vector<uint8_t> out;
+
+    Put<uint32_t>(out, static_cast<uint32_t>(schema.fields.size()));
+
+    for ( const FieldSpec &field : schema.fields ) {
+        Put<uint8_t>(out, static_cast<uint8_t>(field.kind));
+        Put<uint8_t>(out, static_cast<uint8_t>(field.dtype));
+        PutString(out, field.name);
+        PutString(out, field.encoding);
+        Put<uint32_t>(out, static_cast<uint32_t>(field.shape.size()));
+        for ( int32_t dim : field.shape ) {
+            Put<int32_t>(out, dim);
+        }
+    }
+
+    return out;
+}
+
+bool DecodeSchema(const uint8_t *bytes, size_t length, Schema *schema) {
+    Cursor cursor(bytes, length);
+    uint32_t count;
+
+    if ( !cursor.get(&count) ) {
+        return false;
+    }
+
+    Schema decoded;
+
+    for ( uint32_t i = 0; i < count; i++ ) {
+        FieldSpec field;
+        uint8_t kind, dtype;
+        uint32_t rank;
+
+        if ( !cursor.get(&kind) || !cursor.get(&dtype)
+            || !cursor.getString(&field.name) || !cursor.getString(&field.encoding)
+            || !cursor.get(&rank) ) {
+            return false;
+        }
+
+        if ( kind != static_cast<uint8_t>(FieldKind::Tensor) && kind != static_cast<uint8_t>(FieldKind::Blob) ) {
+            return false;
+        }
+
+        field.kind = static_cast<FieldKind>(kind);
+        field.dtype = static_cast<DType>(dtype);
+
+        if ( DTypeSize(field.dtype) == 0 ) {
+            return false;
+        }
+
+        for ( uint32_t d = 0; d < rank; d++ ) {
+            int32_t dim;
+            if ( !cursor.get(&dim) ) {
+                return false;
+            }
+            field.shape.push_back(dim);
+        }
+
+        decoded.fields.push_back(field);
+    }
+
+    *schema = decoded;
+    return true;
+}
+
+} // namespace format
+
+} // namespace records
+} // namespace netrunner
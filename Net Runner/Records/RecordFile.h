@@ -0,0 +1,178 @@
+//
+//  RecordFile.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef RecordFile_h
+#define RecordFile_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * A record file is an append-only container of fixed-schema records, designed to be memory
+ * mapped and read without copying.
+ *
+ * Every record contains the same fields in the same order. A field is either a tensor with a
+ * fixed dtype and shape, whose bytes are stored contiguously, or a blob of variable length such
+ * as a compressed JPEG or PNG image. An offset index at the end of the file allows any record to
+ * be located in constant time, so a reader may shuffle freely.
+ *
+ * Layout, little endian:
+ *
+ * @code
+ * header   : magic "NRRECORD", uint32 version, uint32 schema length, schema, padding
+ * records  : each field 16 byte aligned, blobs prefixed by a uint64 length
+ * index    : uint64 offset per record
+ * footer   : uint64 index offset, uint64 record count, magic "NRRECIDX"
+ * @endcode
+ */
+
+namespace netrunner {
+namespace records {
+
+/**
+ * Element types supported by tensor fields.
+ */
+
+enum class DType : uint8_t {
+    UInt8   = 1,
+    Float32 = 2,
+    Int32   = 3,
+    Int64   = 4
+};
+
+/**
+ * Size in bytes of a single element of the dtype.
+ */
+
+size_t DTypeSize(DType dtype);
+
+/**
+ * Tensor fields have a fixed size, blob fields are variable length.
+ */
+
+enum class FieldKind : uint8_t {
+    Tensor = 1,
+    Blob   = 2
+};
+
+/**
+ * The encoding of tensor fields that were resized, formatted, normalized and, for quantized
+ * models, quantized when they were written, and may be copied straight into a model's input.
+ */
+
+static const char * const kPreprocessedEncoding = "preprocessed";
+
+/**
+ * Describes a single field of every record in the file.
+ */
+
+struct FieldSpec {
+    std::string name;
+    FieldKind kind = FieldKind::Tensor;
+
+    /**
+     * Tensor fields only: the element type and shape of the tensor.
+     */
+
+    DType dtype = DType::Float32;
+    std::vector<int32_t> shape;
+
+    /**
+     * A free form description of the payload, e.g. "jpeg" or "png" for blobs. Tensors whose bytes
+     * are already in the format of a model's input are marked `kPreprocessedEncoding`.
+     */
+
+    std::string encoding;
+
+    /**
+     * The number of bytes occupied by a tensor field, zero for blobs.
+     */
+
+    size_t byteSize() const;
+
+    static FieldSpec Tensor(const std::string &name, DType dtype, const std::vector<int32_t> &shape);
+    static FieldSpec Blob(const std::string &name, const std::string &encoding);
+};
+
+/**
+ * The ordered fields of every record in a file.
+ */
+
+struct Schema {
+    std::vector<FieldSpec> fields;
+
+    /**
+     * Index of the named field or -1 if it does not exist.
+     */
+
+    int indexOf(const std::string &name) const;
+
+    bool operator==(const Schema &other) const;
+    bool operator!=(const Schema &other) const { return !(*this == other); }
+};
+
+/**
+ * A non-owning view of a field's bytes, either inside a mapped file or in caller memory.
+ */
+
+struct FieldView {
+    const uint8_t *data = nullptr;
+    size_t length = 0;
+
+    FieldView() = default;
+    FieldView(const void *data, size_t length) : data(static_cast<const uint8_t*>(data)), length(length) {}
+};
+
+// MARK: - Format
+
+namespace format {
+
+static const char kHeaderMagic[8] = {'N','R','R','E','C','O','R','D'};
+static const char kFooterMagic[8] = {'N','R','R','E','C','I','D','X'};
+static const uint32_t kVersion = 1;
+
+static const size_t kFieldAlignment = 16;
+static const size_t kHeaderAlignment = 64;
+static const size_t kFooterSize = 24;
+
+inline uint64_t Align(uint64_t offset, uint64_t alignment) {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/**
+ * Serializes the schema into the header representation.
+ */
+
+std::vector<uint8_t> EncodeSchema(const Schema &schema);
+
+/**
+ * Parses a schema from its header representation, returning false if the bytes are malformed.
+ */
+
+bool DecodeSchema(const uint8_t *bytes, size_t length, Schema *schema);
+
+} // namespace format
+
+} // namespace records
+} // namespace netrunner
+
+#endif /* RecordFile_h */
@@ -0,0 +1,243 @@
+//
+//  RecordFileReader.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "RecordFileReader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace netrunner {
+namespace records {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+std::shared_ptr<RecordFileReader> RecordFileReader::Open(const std::string &path, std::string *error, Access access) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if ( fd < 0 ) {
+        SetError(error, "Unable to open record file at " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    struct stat st;
+
+    if ( fstat(fd, &st) != 0 ) {
+        ::close(fd);
+        SetError(error, "Unable to stat record file at " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    size_t length = static_cast<size_t>(st.st_size);
+    size_t minimumLength = sizeof(format::kHeaderMagic) + 2 * sizeof(uint32_t) + format::kFooterSize;
+
+    if ( length < minimumLength ) {
+        ::close(fd);
+        SetError(error, "File at " + path + " is too small to be a record file");
+        return nullptr;
+    }
+
+    void *mapping = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+
+    if ( mapping == MAP_FAILED ) {
+        SetError(error, "Unable to map record file at " + path + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    madvise(mapping, length, access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+
+    std::shared_ptr<RecordFileReader> reader(new RecordFileReader());
+    reader->_bytes = static_cast<const uint8_t*>(mapping);
+    reader->_length = length;
+
+    const uint8_t *bytes = reader->_bytes;
+
+    // Header
+
+    uint32_t version, schemaLength;
+    std::memcpy(&version, bytes + 8, sizeof(version));
+    std::memcpy(&schemaLength, bytes + 12, sizeof(schemaLength));
+
+    if ( std::memcmp(bytes, format::kHeaderMagic, sizeof(format::kHeaderMagic)) != 0 || version != format::kVersion ) {
+        SetError(error, "Not a record file or unsupported version at " + path);
+        return nullptr;
+    }
+
+    if ( 16 + static_cast<uint64_t>(schemaLength) > length
+        || !format::DecodeSchema(bytes + 16, schemaLength, &reader->_schema) ) {
+        SetError(error, "Unable to read record file schema at " + path);
+        return nullptr;
+    }
+
+    // Footer and index
+
+    const uint8_t *footer = bytes + length - format::kFooterSize;
+    uint64_t indexOffset, count;
+    std::memcpy(&indexOffset, footer, sizeof(indexOffset));
+    std::memcpy(&count, footer + 8, sizeof(count));
+
+    if ( std::memcmp(footer + 16, format::kFooterMagic, sizeof(format::kFooterMagic)) != 0 ) {
+        SetError(error, "Record file at " + path + " was not closed, the index is missing");
+        return nullptr;
+    }
+
+    // Bound count by the space left for the index before multiplying, so that a crafted count
+    // cannot wrap the index size around and pass the length check
+
+    uint64_t indexLength = length - format::kFooterSize;
+
+    if ( indexOffset % sizeof(uint64_t) != 0
+        || indexOffset > indexLength
+        || count > (indexLength - indexOffset) / sizeof(uint64_t)
+        || indexOffset + count * sizeof(uint64_t) != indexLength ) {
+        SetError(error, "Record file index is corrupt at " + path);
+        return nullptr;
+    }
+
+    reader->_index = reinterpret_cast<const uint64_t*>(bytes + indexOffset);
+    reader->_count = static_cast<size_t>(count);
+
+    // Records are written in order after the header, so each record extends to the start of the
+    // next one, and the last to the index. Every field must lie inside its record's extent, so
+    // that a truncated or corrupt file is rejected here rather than read out of bounds later.
+    // Only blob lengths are read, tensor-only records are checked against the index alone
+
+    uint64_t recordsOffset = format::Align(16 + static_cast<uint64_t>(schemaLength), format::kHeaderAlignment);
+
+    for ( size_t i = 0; i < reader->_count; i++ ) {
+        uint64_t start = reader->_index[i];
+        uint64_t end = i + 1 < reader->_count ? reader->_index[i + 1] : indexOffset;
+
+        if ( start < recordsOffset || start > end || end > indexOffset ) {
+            SetError(error, "Record file index points outside the records at " + path);
+            return nullptr;
+        }
+
+        if ( !reader->validateRecord(start, end - start) ) {
+            SetError(error, "Record " + std::to_string(i) + " is truncated or corrupt at " + path);
+            return nullptr;
+        }
+    }
+
+    // Precompute field offsets for the leading run of tensor fields
+
+    int64_t offset = 0;
+
+    for ( const FieldSpec &spec : reader->_schema.fields ) {
+        reader->_fixedOffsets.push_back(spec.kind == FieldKind::Tensor ? offset : -1);
+        if ( offset >= 0 && spec.kind == FieldKind::Tensor ) {
+            offset = static_cast<int64_t>(format::Align(offset + spec.byteSize(), format::kFieldAlignment));
+        } else {
+            offset = -1;
+        }
+    }
+
+    return reader;
+}
+
+bool RecordFileReader::validateRecord(uint64_t start, uint64_t extent) const {
+    const uint8_t *base = _bytes + start;
+    uint64_t offset = 0;
+
+    for ( const FieldSpec &spec : _schema.fields ) {
+        uint64_t length = spec.byteSize();
+
+        if ( spec.kind == FieldKind::Blob ) {
+            if ( extent - offset < format::kFieldAlignment ) {
+                return false;
+            }
+            std::memcpy(&length, base + offset, sizeof(length));
+            offset += format::kFieldAlignment;
+        }
+
+        if ( length > extent - offset ) {
+            return false;
+        }
+
+        offset = std::min(extent, format::Align(offset + length, format::kFieldAlignment));
+    }
+
+    return true;
+}
+
+RecordFileReader::~RecordFileReader() {
+    if ( _bytes != nullptr ) {
+        munmap(const_cast<uint8_t*>(_bytes), _length);
+    }
+}
+
+FieldView RecordFileReader::field(size_t record, size_t field) const {
+    assert(record < _count);
+    assert(field < _schema.fields.size());
+
+    const uint8_t *base = _bytes + _index[record];
+
+    if ( _fixedOffsets[field] >= 0 ) {
+        return FieldView(base + _fixedOffsets[field], _schema.fields[field].byteSize());
+    }
+
+    uint64_t offset = 0;
+
+    for ( size_t i = 0; i <= field; i++ ) {
+        const FieldSpec &spec = _schema.fields[i];
+        uint64_t length = spec.byteSize();
+
+        if ( spec.kind == FieldKind::Blob ) {
+            std::memcpy(&length, base + offset, sizeof(length));
+            offset += format::kFieldAlignment;
+        }
+
+        if ( i == field ) {
+            return FieldView(base + offset, static_cast<size_t>(length));
+        }
+
+        offset = format::Align(offset + length, format::kFieldAlignment);
+    }
+
+    return FieldView();
+}
+
+std::vector<FieldView> RecordFileReader::record(size_t record) const {
+    std::vector<FieldView> fields;
+    fields.reserve(_schema.fields.size());
+
+    for ( size_t i = 0; i < _schema.fields.size(); i++ ) {
+        fields.push_back(field(record, i));
+    }
+
+    return fields;
+}
+
+} // namespace records
+} // namespace netrunner
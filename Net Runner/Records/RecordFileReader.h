@@ -0,0 +1,114 @@
+//
+//  RecordFileReader.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef RecordFileReader_h
+#define RecordFileReader_h
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RecordFile.h"
+
+namespace netrunner {
+namespace records {
+
+/**
+ * Memory maps a closed record file and vends views of its fields without copying.
+ *
+ * Field views point directly into the mapping and remain valid for the lifetime of the reader.
+ * Access to any record is constant time, and the reader is safe to use from multiple threads
+ * once opened.
+ */
+
+class RecordFileReader {
+public:
+
+    /**
+     * Access pattern hint passed to the kernel for the mapped region.
+     */
+
+    enum class Access {
+        Sequential,
+        Random
+    };
+
+    /**
+     * Maps the record file at path and validates its header, index and footer, and that every
+     * field of every record lies inside the file. Returns nullptr and sets error if the file
+     * cannot be mapped, is not a closed record file or is truncated or corrupt.
+     */
+
+    static std::shared_ptr<RecordFileReader> Open(const std::string &path, std::string *error, Access access = Access::Random);
+
+    ~RecordFileReader();
+
+    RecordFileReader(const RecordFileReader&) = delete;
+    RecordFileReader& operator=(const RecordFileReader&) = delete;
+
+    const Schema &schema() const { return _schema; }
+
+    /**
+     * The number of records in the file.
+     */
+
+    size_t count() const { return _count; }
+
+    /**
+     * The size of the mapped file in bytes.
+     */
+
+    size_t size() const { return _length; }
+
+    /**
+     * A view of a single field of a record. Indexes must be in range.
+     */
+
+    FieldView field(size_t record, size_t field) const;
+
+    /**
+     * Views of every field of a record, in schema order.
+     */
+
+    std::vector<FieldView> record(size_t record) const;
+
+private:
+    RecordFileReader() = default;
+
+    // Whether every field of the record at start fits in extent bytes
+
+    bool validateRecord(uint64_t start, uint64_t extent) const;
+
+    const uint8_t *_bytes = nullptr;
+    size_t _length = 0;
+    size_t _count = 0;
+    const uint64_t *_index = nullptr;
+    Schema _schema;
+
+    // Byte offset of each tensor field from the start of its record when every preceding field
+    // is a tensor, -1 otherwise. Lets fixed size records skip walking their blob fields.
+
+    std::vector<int64_t> _fixedOffsets;
+};
+
+} // namespace records
+} // namespace netrunner
+
+#endif /* RecordFileReader_h */
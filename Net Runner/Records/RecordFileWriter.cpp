@@ -0,0 +1,241 @@
+//
+//  RecordFileWriter.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "RecordFileWriter.h"
+
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+namespace netrunner {
+namespace records {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+std::string ErrnoDescription(const std::string &message) {
+    return message + ": " + std::strerror(errno);
+}
+
+} // namespace
+
+// MARK: - Creating
+
+std::unique_ptr<RecordFileWriter> RecordFileWriter::Create(const std::string &path, const Schema &schema, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+
+    if ( file == nullptr ) {
+        SetError(error, ErrnoDescription("Unable to create record file at " + path));
+        return nullptr;
+    }
+
+    std::unique_ptr<RecordFileWriter> writer(new RecordFileWriter(file, schema, 0, {}));
+    std::vector<uint8_t> encodedSchema = format::EncodeSchema(schema);
+    uint32_t schemaLength = static_cast<uint32_t>(encodedSchema.size());
+
+    if ( !writer->put(format::kHeaderMagic, sizeof(format::kHeaderMagic), error)
+        || !writer->put(&format::kVersion, sizeof(format::kVersion), error)
+        || !writer->put(&schemaLength, sizeof(schemaLength), error)
+        || !writer->put(encodedSchema.data(), encodedSchema.size(), error)
+        || !writer->pad(format::kHeaderAlignment, error) ) {
+        writer->abandon();
+        return nullptr;
+    }
+
+    return writer;
+}
+
+std::unique_ptr<RecordFileWriter> RecordFileWriter::Append(const std::string &path, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "r+b");
+
+    if ( file == nullptr ) {
+        SetError(error, ErrnoDescription("Unable to open record file at " + path));
+        return nullptr;
+    }
+
+    // Read the header and schema
+
+    char magic[8];
+    uint32_t version, schemaLength;
+
+    if ( std::fread(magic, sizeof(magic), 1, file) != 1
+        || std::memcmp(magic, format::kHeaderMagic, sizeof(magic)) != 0
+        || std::fread(&version, sizeof(version), 1, file) != 1
+        || version != format::kVersion
+        || std::fread(&schemaLength, sizeof(schemaLength), 1, file) != 1 ) {
+        std::fclose(file);
+        SetError(error, "Not a record file or unsupported version at " + path);
+        return nullptr;
+    }
+
+    std::vector<uint8_t> encodedSchema(schemaLength);
+    Schema schema;
+
+    if ( std::fread(encodedSchema.data(), 1, schemaLength, file) != schemaLength
+        || !format::DecodeSchema(encodedSchema.data(), encodedSchema.size(), &schema) ) {
+        std::fclose(file);
+        SetError(error, "Unable to read record file schema at " + path);
+        return nullptr;
+    }
+
+    // Read the footer and index
+
+    uint64_t indexOffset, count;
+    char footerMagic[8];
+
+    if ( fseeko(file, -static_cast<off_t>(format::kFooterSize), SEEK_END) != 0
+        || std::fread(&indexOffset, sizeof(indexOffset), 1, file) != 1
+        || std::fread(&count, sizeof(count), 1, file) != 1
+        || std::fread(footerMagic, sizeof(footerMagic), 1, file) != 1
+        || std::memcmp(footerMagic, format::kFooterMagic, sizeof(footerMagic)) != 0 ) {
+        std::fclose(file);
+        SetError(error, "Record file at " + path + " was not closed, the index is missing");
+        return nullptr;
+    }
+
+    std::vector<uint64_t> offsets(count);
+
+    if ( fseeko(file, static_cast<off_t>(indexOffset), SEEK_SET) != 0
+        || (count > 0 && std::fread(offsets.data(), sizeof(uint64_t), count, file) != count) ) {
+        std::fclose(file);
+        SetError(error, "Unable to read record file index at " + path);
+        return nullptr;
+    }
+
+    // Drop the index and footer, new records overwrite them
+
+    std::fflush(file);
+
+    if ( ftruncate(fileno(file), static_cast<off_t>(indexOffset)) != 0
+        || fseeko(file, static_cast<off_t>(indexOffset), SEEK_SET) != 0 ) {
+        std::fclose(file);
+        SetError(error, ErrnoDescription("Unable to truncate record file index at " + path));
+        return nullptr;
+    }
+
+    return std::unique_ptr<RecordFileWriter>(new RecordFileWriter(file, schema, indexOffset, offsets));
+}
+
+RecordFileWriter::RecordFileWriter(FILE *file, const Schema &schema, uint64_t offset, std::vector<uint64_t> offsets)
+    : _file(file), _schema(schema), _offset(offset), _offsets(std::move(offsets)) {}
+
+RecordFileWriter::~RecordFileWriter() {
+    if ( _file != nullptr ) {
+        close(nullptr);
+    }
+}
+
+void RecordFileWriter::abandon() {
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+// MARK: - Writing
+
+bool RecordFileWriter::put(const void *bytes, size_t length, std::string *error) {
+    if ( length == 0 ) {
+        return true;
+    }
+
+    if ( std::fwrite(bytes, 1, length, _file) != length ) {
+        SetError(error, ErrnoDescription("Unable to write to record file"));
+        return false;
+    }
+
+    _offset += length;
+    return true;
+}
+
+bool RecordFileWriter::pad(uint64_t alignment, std::string *error) {
+    static const uint8_t zeros[format::kHeaderAlignment] = {0};
+    uint64_t padding = format::Align(_offset, alignment) - _offset;
+    return put(zeros, static_cast<size_t>(padding), error);
+}
+
+bool RecordFileWriter::write(const std::vector<FieldView> &fields, std::string *error) {
+    if ( _file == nullptr ) {
+        SetError(error, "Record file has already been closed");
+        return false;
+    }
+
+    if ( fields.size() != _schema.fields.size() ) {
+        SetError(error, "Record does not contain the same number of fields as the schema");
+        return false;
+    }
+
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        const FieldSpec &spec = _schema.fields[i];
+        if ( spec.kind == FieldKind::Tensor && fields[i].length != spec.byteSize() ) {
+            SetError(error, "Tensor field " + spec.name + " does not match the size described by the schema");
+            return false;
+        }
+    }
+
+    uint64_t recordOffset = _offset;
+
+    for ( size_t i = 0; i < fields.size(); i++ ) {
+        const FieldSpec &spec = _schema.fields[i];
+
+        if ( spec.kind == FieldKind::Blob ) {
+            uint64_t length = fields[i].length;
+            if ( !put(&length, sizeof(length), error) || !pad(format::kFieldAlignment, error) ) {
+                return false;
+            }
+        }
+
+        if ( !put(fields[i].data, fields[i].length, error) || !pad(format::kFieldAlignment, error) ) {
+            return false;
+        }
+    }
+
+    _offsets.push_back(recordOffset);
+    return true;
+}
+
+bool RecordFileWriter::close(std::string *error) {
+    if ( _file == nullptr ) {
+        return true;
+    }
+
+    uint64_t indexOffset = format::Align(_offset, sizeof(uint64_t));
+    uint64_t count = _offsets.size();
+
+    bool success = pad(sizeof(uint64_t), error)
+        && put(_offsets.data(), _offsets.size() * sizeof(uint64_t), error)
+        && put(&indexOffset, sizeof(indexOffset), error)
+        && put(&count, sizeof(count), error)
+        && put(format::kFooterMagic, sizeof(format::kFooterMagic), error);
+
+    if ( std::fclose(_file) != 0 && success ) {
+        SetError(error, ErrnoDescription("Unable to close record file"));
+        success = false;
+    }
+
+    _file = nullptr;
+    return success;
+}
+
+} // namespace records
+} // namespace netrunner
@@ -0,0 +1,129 @@
+//
+//  RecordFileWriter.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef RecordFileWriter_h
+#define RecordFileWriter_h
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RecordFile.h"
+
+namespace netrunner {
+namespace records {
+
+/**
+ * Appends records to a record file and writes the offset index when it is closed.
+ *
+ * Records are buffered through stdio and are not visible to a reader until `close` writes the
+ * index and footer. Reopening a closed file with `Append` truncates the old index and continues
+ * where the file left off.
+ *
+ * Usage:
+ *
+ * @code
+ * Schema schema;
+ * schema.fields.push_back(FieldSpec::Tensor("image", DType::UInt8, {224,224,3}));
+ * schema.fields.push_back(FieldSpec::Tensor("label", DType::Int32, {1}));
+ *
+ * std::string error;
+ * auto writer = RecordFileWriter::Create(path, schema, &error);
+ * writer->write({ FieldView(pixels, 224*224*3), FieldView(&label, 4) }, &error);
+ * writer->close(&error);
+ * @endcode
+ */
+
+class RecordFileWriter {
+public:
+
+    /**
+     * Creates a new record file at path with the provided schema, replacing any existing file.
+     * Returns nullptr and sets error if the file cannot be created.
+     */
+
+    static std::unique_ptr<RecordFileWriter> Create(const std::string &path, const Schema &schema, std::string *error);
+
+    /**
+     * Opens a previously closed record file for appending. Returns nullptr and sets error if
+     * the file does not exist or its index is invalid.
+     */
+
+    static std::unique_ptr<RecordFileWriter> Append(const std::string &path, std::string *error);
+
+    /**
+     * Closes the file if it has not already been closed.
+     */
+
+    ~RecordFileWriter();
+
+    RecordFileWriter(const RecordFileWriter&) = delete;
+    RecordFileWriter& operator=(const RecordFileWriter&) = delete;
+
+    /**
+     * Appends a single record. Fields must be provided in schema order and tensor fields must
+     * be exactly the size described by the schema.
+     */
+
+    bool write(const std::vector<FieldView> &fields, std::string *error);
+
+    /**
+     * Writes the offset index and footer and closes the file. No further writes are permitted.
+     */
+
+    bool close(std::string *error);
+
+    /**
+     * The number of records in the file, including records written before an append.
+     */
+
+    size_t count() const { return _offsets.size(); }
+
+    /**
+     * The number of bytes written to the file so far, excluding the index.
+     */
+
+    uint64_t size() const { return _offset; }
+
+    const Schema &schema() const { return _schema; }
+
+private:
+    RecordFileWriter(FILE *file, const Schema &schema, uint64_t offset, std::vector<uint64_t> offsets);
+
+    bool pad(uint64_t alignment, std::string *error);
+
+    // Closes the file without writing an index or footer, e.g. when its header could not be
+    // written, so that the destructor does not complete an invalid file
+
+    void abandon();
+
+    bool put(const void *bytes, size_t length, std::string *error);
+
+    FILE *_file;
+    Schema _schema;
+    uint64_t _offset;
+    std::vector<uint64_t> _offsets;
+};
+
+} // namespace records
+} // namespace netrunner
+
+#endif /* RecordFileWriter_h */
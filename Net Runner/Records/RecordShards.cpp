@@ -0,0 +1,214 @@
+//
+//  RecordShards.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "RecordShards.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+
+namespace netrunner {
+namespace records {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+bool FileExists(const std::string &path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0;
+}
+
+bool IsDirectory(const std::string &path) {
+    struct stat st;
+    return ::stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+} // namespace
+
+std::string ShardPath(const std::string &directory, size_t shard) {
+    char filename[32];
+    std::snprintf(filename, sizeof(filename), "shard-%05zu.records", shard);
+    return directory + "/" + filename;
+}
+
+// MARK: - Writing
+
+std::unique_ptr<ShardedRecordWriter> ShardedRecordWriter::Create(const std::string &directory, const Schema &schema, const Options &options, std::string *error) {
+    if ( ::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST ) {
+        SetError(error, "Unable to create shard directory at " + directory + ": " + std::strerror(errno));
+        return nullptr;
+    }
+
+    // Shards from an earlier export would be read as part of this one
+
+    for ( size_t shard = 0; FileExists(ShardPath(directory, shard)); shard++ ) {
+        if ( std::remove(ShardPath(directory, shard).c_str()) != 0 ) {
+            SetError(error, "Unable to remove shard at " + ShardPath(directory, shard) + ": " + std::strerror(errno));
+            return nullptr;
+        }
+    }
+
+    std::unique_ptr<ShardedRecordWriter> writer(new ShardedRecordWriter(directory, schema, options));
+
+    if ( !writer->openShard(error) ) {
+        return nullptr;
+    }
+
+    return writer;
+}
+
+ShardedRecordWriter::ShardedRecordWriter(const std::string &directory, const Schema &schema, const Options &options)
+    : _directory(directory), _schema(schema), _options(options), _shards(0), _count(0), _closedSize(0) {}
+
+bool ShardedRecordWriter::openShard(std::string *error) {
+    _writer = RecordFileWriter::Create(ShardPath(_directory, _shards), _schema, error);
+
+    if ( _writer == nullptr ) {
+        return false;
+    }
+
+    _shards += 1;
+    return true;
+}
+
+bool ShardedRecordWriter::write(const std::vector<FieldView> &fields, std::string *error) {
+    if ( _writer == nullptr ) {
+        SetError(error, "Shards have already been closed");
+        return false;
+    }
+
+    // Roll over before the write so that no shard is left empty
+
+    bool full = (_options.maxBytes > 0 && _writer->size() >= _options.maxBytes)
+        || (_options.maxRecords > 0 && _writer->count() >= _options.maxRecords);
+
+    if ( full && _writer->count() > 0 ) {
+        uint64_t size = _writer->size();
+        if ( !_writer->close(error) ) {
+            return false;
+        }
+        _closedSize += size;
+        if ( !openShard(error) ) {
+            return false;
+        }
+    }
+
+    if ( !_writer->write(fields, error) ) {
+        return false;
+    }
+
+    _count += 1;
+    return true;
+}
+
+bool ShardedRecordWriter::close(std::string *error) {
+    if ( _writer == nullptr ) {
+        return true;
+    }
+
+    uint64_t size = _writer->size();
+    bool closed = _writer->close(error);
+
+    _closedSize += size;
+    _writer.reset();
+
+    return closed;
+}
+
+// MARK: - Reading
+
+std::shared_ptr<ShardedRecordReader> ShardedRecordReader::Open(const std::string &path, std::string *error, RecordFileReader::Access access) {
+    std::vector<std::string> paths;
+
+    if ( IsDirectory(path) ) {
+        for ( size_t shard = 0; FileExists(ShardPath(path, shard)); shard++ ) {
+            paths.push_back(ShardPath(path, shard));
+        }
+    } else {
+        paths.push_back(path);
+    }
+
+    if ( paths.empty() ) {
+        SetError(error, "No record shards in " + path);
+        return nullptr;
+    }
+
+    std::shared_ptr<ShardedRecordReader> reader(new ShardedRecordReader());
+    reader->_starts.push_back(0);
+
+    for ( const std::string &shardPath : paths ) {
+        std::shared_ptr<RecordFileReader> shard = RecordFileReader::Open(shardPath, error, access);
+
+        if ( shard == nullptr ) {
+            return nullptr;
+        }
+
+        if ( !reader->_shards.empty() && shard->schema() != reader->_shards.front()->schema() ) {
+            SetError(error, "The schema of " + shardPath + " does not match the other shards");
+            return nullptr;
+        }
+
+        reader->_shards.push_back(shard);
+        reader->_starts.push_back(reader->_starts.back() + shard->count());
+    }
+
+    return reader;
+}
+
+size_t ShardedRecordReader::size() const {
+    size_t size = 0;
+    for ( const auto &shard : _shards ) {
+        size += shard->size();
+    }
+    return size;
+}
+
+FieldView ShardedRecordReader::field(size_t record, size_t field) const {
+    assert(record < count());
+
+    if ( _shards.size() == 1 ) {
+        return _shards.front()->field(record, field);
+    }
+
+    size_t shard = static_cast<size_t>(std::upper_bound(_starts.begin(), _starts.end(), record) - _starts.begin()) - 1;
+    return _shards[shard]->field(record - _starts[shard], field);
+}
+
+std::vector<FieldView> ShardedRecordReader::record(size_t record) const {
+    std::vector<FieldView> fields;
+    fields.reserve(schema().fields.size());
+
+    for ( size_t i = 0; i < schema().fields.size(); i++ ) {
+        fields.push_back(field(record, i));
+    }
+
+    return fields;
+}
+
+} // namespace records
+} // namespace netrunner
@@ -0,0 +1,177 @@
+//
+//  RecordShards.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef RecordShards_h
+#define RecordShards_h
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "RecordFile.h"
+#include "RecordFileReader.h"
+#include "RecordFileWriter.h"
+
+namespace netrunner {
+namespace records {
+
+/**
+ * A dataset split across a directory of record files of the same schema, named shard-00000.records,
+ * shard-00001.records and so on. Each shard is an ordinary record file with its own offset index.
+ *
+ * Sharding bounds the size of each mapping, so a large dataset never needs one contiguous region
+ * of address space, and an interrupted export loses only the shard that was open.
+ */
+
+std::string ShardPath(const std::string &directory, size_t shard);
+
+/**
+ * Writes records to a directory of shards, starting a new shard when the current one reaches
+ * `maxBytes` or `maxRecords`.
+ */
+
+class ShardedRecordWriter {
+public:
+    struct Options {
+        uint64_t maxBytes = 64 << 20;
+
+        /**
+         * Zero for no limit.
+         */
+
+        size_t maxRecords = 0;
+
+        Options() {}
+        Options(uint64_t maxBytes, size_t maxRecords) : maxBytes(maxBytes), maxRecords(maxRecords) {}
+    };
+
+    /**
+     * Creates the directory if necessary and removes any shards already in it. Returns nullptr
+     * and sets error if the directory or first shard cannot be created.
+     */
+
+    static std::unique_ptr<ShardedRecordWriter> Create(const std::string &directory, const Schema &schema, const Options &options, std::string *error);
+
+    ShardedRecordWriter(const ShardedRecordWriter&) = delete;
+    ShardedRecordWriter& operator=(const ShardedRecordWriter&) = delete;
+
+    /**
+     * Appends a record to the current shard. See `RecordFileWriter::write`.
+     */
+
+    bool write(const std::vector<FieldView> &fields, std::string *error);
+
+    /**
+     * Closes the current shard. No further writes are permitted.
+     */
+
+    bool close(std::string *error);
+
+    /**
+     * The number of records written to every shard.
+     */
+
+    size_t count() const { return _count; }
+
+    /**
+     * The number of shards written, including the current one.
+     */
+
+    size_t shardCount() const { return _shards; }
+
+    /**
+     * The number of bytes written to every shard, excluding the current shard's index.
+     */
+
+    uint64_t size() const { return _closedSize + (_writer ? _writer->size() : 0); }
+
+private:
+    ShardedRecordWriter(const std::string &directory, const Schema &schema, const Options &options);
+
+    bool openShard(std::string *error);
+
+    std::string _directory;
+    Schema _schema;
+    Options _options;
+    std::unique_ptr<RecordFileWriter> _writer;
+    size_t _shards;
+    size_t _count;
+    uint64_t _closedSize;
+};
+
+/**
+ * Maps every shard in a directory and addresses their records as one sequence, in shard order.
+ * Locating a record is a binary search over the shards followed by the shard's constant time
+ * lookup. Like `RecordFileReader`, the reader is safe to use from multiple threads once opened.
+ */
+
+class ShardedRecordReader {
+public:
+
+    /**
+     * Opens a directory of shards, or a single record file. Returns nullptr and sets error if
+     * there are no shards, a shard cannot be opened, or the shards' schemas differ.
+     */
+
+    static std::shared_ptr<ShardedRecordReader> Open(const std::string &path, std::string *error, RecordFileReader::Access access = RecordFileReader::Access::Random);
+
+    const Schema &schema() const { return _shards.front()->schema(); }
+
+    /**
+     * The number of records in every shard.
+     */
+
+    size_t count() const { return _starts.back(); }
+
+    size_t shardCount() const { return _shards.size(); }
+
+    /**
+     * The total size of the mapped shards in bytes.
+     */
+
+    size_t size() const;
+
+    /**
+     * A view of a single field of a record. Indexes must be in range.
+     */
+
+    FieldView field(size_t record, size_t field) const;
+
+    /**
+     * Views of every field of a record, in schema order.
+     */
+
+    std::vector<FieldView> record(size_t record) const;
+
+private:
+    ShardedRecordReader() = default;
+
+    std::vector<std::shared_ptr<RecordFileReader>> _shards;
+
+    // The index of each shard's first record, followed by the total count
+
+    std::vector<size_t> _starts;
+};
+
+} // namespace records
+} // namespace netrunner
+
+#endif /* RecordShards_h */
@@ -0,0 +1,64 @@
+//
+//  RecordTensor.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * A tensor whose bytes are already in the format a model's input layer expects: resized, in the
+ * layer's pixel format, normalized and, for quantized models, quantized. Copying it into an input
+ * tensor is a single copy of its bytes. No vision pipeline, normalizer or quantizer is run.
+ *
+ * `RecordBatchDataSource` vends preprocessed record fields as `RecordTensor` objects. Use
+ * `+byteSizeForDescription:` to size the bytes when preprocessing an input.
+ */
+
+@interface RecordTensor : NSObject <TIOTFLiteData>
+
+/**
+ * The tensor's bytes.
+ */
+
+@property (readonly) NSData *data;
+
+/**
+ * The number of bytes a tensor for the layer occupies: one per element for quantized layers and
+ * four otherwise.
+ */
+
++ (NSUInteger)byteSizeForDescription:(id<TIOLayerDescription>)description;
+
+/**
+ * Designated initializer. The data is retained, not copied.
+ */
+
+- (instancetype)initWithData:(NSData*)data NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+@end
+
+NS_ASSUME_NONNULL_END
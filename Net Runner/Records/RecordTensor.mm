@@ -0,0 +1,61 @@
+//
+//  RecordTensor.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "RecordTensor.h"
+
+@implementation RecordTensor
+
++ (NSUInteger)byteSizeForDescription:(id<TIOLayerDescription>)description {
+    NSUInteger elementSize = description.isQuantized ? sizeof(uint8_t) : sizeof(float_t);
+    NSUInteger count = 0;
+    
+    if ( [description isKindOfClass:TIOPixelBufferLayerDescription.class] ) {
+        TIOImageVolume volume = ((TIOPixelBufferLayerDescription*)description).imageVolume;
+        count = (NSUInteger)volume.width * (NSUInteger)volume.height * (NSUInteger)volume.channels;
+    } else if ( [description isKindOfClass:TIOVectorLayerDescription.class] ) {
+        count = ((TIOVectorLayerDescription*)description).length;
+    } else if ( [description isKindOfClass:TIOStringLayerDescription.class] ) {
+        TIOStringLayerDescription *stringDescription = (TIOStringLayerDescription*)description;
+        count = stringDescription.length;
+        elementSize = stringDescription.dtype == TIODataTypeUInt8 ? sizeof(uint8_t) : sizeof(float_t);
+    }
+    
+    return count * elementSize;
+}
+
+- (instancetype)initWithData:(NSData*)data {
+    if ((self=[super init])) {
+        _data = data;
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithBytes:(const void *)bytes description:(id<TIOLayerDescription>)description {
+    NSData *data = [[NSData alloc] initWithBytes:bytes length:[RecordTensor byteSizeForDescription:description]];
+    return [self initWithData:data];
+}
+
+- (void)getBytes:(void *)buffer description:(id<TIOLayerDescription>)description {
+    assert(self.data.length == [RecordTensor byteSizeForDescription:description]);
+    
+    [self.data getBytes:buffer length:MIN(self.data.length, [RecordTensor byteSizeForDescription:description])];
+}
+
+@end
@@ -35,7 +35,9 @@
 #import "UserDefaults.h"
 #import "CVPixelBufferEvaluator.h"
 #import "EvaluatorConstants.h"
+#import "LiveFrameScheduler.h"
 #import "ModelOutput.h"
+#import "ModelOutputManager.h"
 
 @import TensorIO;
 
@@ -46,6 +48,13 @@ typedef enum : NSUInteger {
     CaptureModePhoto,
 } CaptureMode;
 
+/**
+ * The first inference after a model is loaded includes one-time setup costs and is excluded
+ * from the latency distribution.
+ */
+
+static const NSUInteger kLatencyWarmup = 1;
+
 @interface RunImageModelViewController ()
 
 @property (nonatomic) CaptureMode captureMode;
@@ -53,6 +62,7 @@ typedef enum : NSUInteger {
 
 @property id<TIOModel> model;
 @property id<ModelOutput> previousOutput;
+@property LiveFrameScheduler *frameScheduler;
 
 @property AVCaptureSession *session;
 @property AVCaptureDevicePosition devicePosition;
@@ -68,6 +78,7 @@ typedef enum : NSUInteger {
 
 - (void)dealloc {
   [self teardownAVCapture];
+  [self.frameScheduler stop];
 }
 
 - (void)viewDidLoad {
@@ -177,6 +188,8 @@ typedef enum : NSUInteger {
         return NO;
     }
     
+    [[ModelOutputManager sharedManager] prepareForModel:self.model];
+    
     __block TIOPixelBufferLayerDescription *description = nil;
     
     [self.model.io.inputs[0] matchCasePixelBuffer:^(TIOPixelBufferLayerDescription * _Nonnull pixelBufferDescription) {
@@ -199,7 +212,10 @@ typedef enum : NSUInteger {
     self.imageInputPreviewView.pixelFormat = description.pixelFormat;
 
     self.previousOutput = nil;
-    self.latencyCounter = [[LatencyCounter alloc] init];
+    self.latencyCounter = [[LatencyCounter alloc] initWithWarmup:kLatencyWarmup];
+    
+    [self.frameScheduler stop];
+    self.frameScheduler = [self frameSchedulerForModel:self.model];
     
     return YES;
 }
@@ -601,8 +617,20 @@ typedef enum : NSUInteger {
     return label;
 }
 
+/**
+ * Hands the frame to the frame scheduler and returns, so that inference never blocks capture.
+ * Video data output timestamps are on the host time clock, which gives the frame's age.
+ */
+
 - (void)captureOutput:(AVCaptureOutput*)captureOutput didOutputSampleBuffer:(CMSampleBufferRef)sampleBuffer fromConnection:(AVCaptureConnection*)connection {
-    [self runModelOnFrame:CMSampleBufferGetImageBuffer(sampleBuffer)];
+    CMTime presentationTime = CMSampleBufferGetPresentationTimeStamp(sampleBuffer);
+    NSTimeInterval age = 0;
+    
+    if ( CMTIME_IS_NUMERIC(presentationTime) ) {
+        age = CMTimeGetSeconds(CMTimeSubtract(CMClockGetTime(CMClockGetHostTimeClock()), presentationTime));
+    }
+    
+    [self runModelOnFrame:CMSampleBufferGetImageBuffer(sampleBuffer) age:age];
 }
 
 // MARK: - Photo Library & Camera
@@ -648,49 +676,70 @@ typedef enum : NSUInteger {
 // MARK: - Run Model
 
 /**
- * Incoming pixelBuffer is guaranteed to be in the BGRA format: `kCMPixelFormat_32BGRA` ( `kCVPixelFormatType_32BGRA` ),
- * as specified when setting up the AVCaptureDevice.
+ * Live frames are run by a `LiveFrameScheduler` on its own worker, latest frame wins. Set the
+ * `app.live.pipelines-preprocessing` user default to preprocess the next frame during inference.
+ * Frames that have not changed by the `app.live.motion-threshold` skip inference, a threshold
+ * of 0 runs every frame.
  */
 
-- (void)runModelOnFrame:(CVPixelBufferRef)pixelBuffer {
-    
-    auto const evaluator = [[CVPixelBufferEvaluator alloc] initWithModel:self.model pixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationRight];
+- (LiveFrameScheduler*)frameSchedulerForModel:(id<TIOModel>)model {
+    BOOL pipelined = [NSUserDefaults.standardUserDefaults boolForKey:kPrefsLivePipelinesPreprocessing];
+    double motionThreshold = [NSUserDefaults.standardUserDefaults doubleForKey:kPrefsLiveMotionThreshold];
+    NSTimeInterval refreshInterval = [NSUserDefaults.standardUserDefaults doubleForKey:kPrefsLiveMotionRefreshInterval];
+    __weak typeof(self) weakself = self;
     
-    [evaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
+    return [[LiveFrameScheduler alloc] initWithModel:model pipelined:pipelined motionThreshold:motionThreshold refreshInterval:refreshInterval resultHandler:^(NSDictionary<NSString*,id> * _Nonnull result, CVPixelBufferRef _Nullable inputPixelBuffer) {
         CVPixelBufferRetain(inputPixelBuffer); // No ARC bridging boo
         
         dispatch_async(dispatch_get_main_queue(), ^(void) {
-            
-            id<ModelOutput> inference = result[kEvaluatorResultsKeyInferenceResults];
-            const double inferenceLatency = [result[kEvaluatorResultsKeyInferenceLatency] doubleValue];
-            const double preprocessingLatency = [result[kEvaluatorResultsKeyPreprocessingLatency] doubleValue];
-            
-            // Show results and latency
-            
-            [self.latencyCounter increaseImageProcessingLatency:preprocessingLatency];
-            [self.latencyCounter increaseInferenceLatency:inferenceLatency];
-            [self.latencyCounter incrementCount];
-            
-            [self showModelOutput:inference withDecay:YES];
-            self.infoView.stats = [self modelStats:NO];
-            
-            // Visualize last pixel buffer used by model
-    
-            if ( [NSUserDefaults.standardUserDefaults boolForKey:kPrefsShowInputBuffers] ) {
-                self.imageInputPreviewView.pixelBuffer = inputPixelBuffer;
-            }
-
-            // Cleanup
-    
+            [weakself showFrameResult:result inputPixelBuffer:inputPixelBuffer];
             CVPixelBufferRelease(inputPixelBuffer);
-
-            #ifdef DEBUG
-            NSLog(@"%@",[self modelStats:YES]);
-            #endif
         });
     }];
 }
 
+/**
+ * Incoming pixelBuffer is guaranteed to be in the BGRA format: `kCMPixelFormat_32BGRA` ( `kCVPixelFormatType_32BGRA` ),
+ * as specified when setting up the AVCaptureDevice.
+ */
+
+- (void)runModelOnFrame:(CVPixelBufferRef)pixelBuffer age:(NSTimeInterval)age {
+    [self.frameScheduler submitPixelBuffer:pixelBuffer orientation:kCGImagePropertyOrientationRight age:age];
+}
+
+- (void)showFrameResult:(NSDictionary<NSString*,id>*)result inputPixelBuffer:(nullable CVPixelBufferRef)inputPixelBuffer {
+    id<ModelOutput> inference = result[kEvaluatorResultsKeyInferenceResults];
+    
+    if ( inference == nil ) {
+        NSLog(@"Unable to run model on frame, error: %@", result[kEvaluatorResultsKeyPreprocessingError] ?: result[kEvaluatorResultsKeyInferenceError]);
+        return;
+    }
+    
+    const double inferenceLatency = [result[kEvaluatorResultsKeyInferenceLatency] doubleValue];
+    const double preprocessingLatency = [result[kEvaluatorResultsKeyPreprocessingLatency] doubleValue];
+    
+    // Show results and latency, skipped frames are counted apart from the latency distributions
+    
+    if ( [result[kEvaluatorResultsKeyInferenceSkipped] boolValue] ) {
+        [self.latencyCounter recordSkippedInferenceSavingLatency:[result[kEvaluatorResultsKeySavedInferenceLatency] doubleValue]];
+    } else {
+        [self.latencyCounter recordImageProcessingLatency:preprocessingLatency inferenceLatency:inferenceLatency];
+    }
+    
+    [self showModelOutput:inference withDecay:YES];
+    self.infoView.stats = [self modelStats:NO];
+    
+    // Visualize last pixel buffer used by model
+    
+    if ( [NSUserDefaults.standardUserDefaults boolForKey:kPrefsShowInputBuffers] ) {
+        self.imageInputPreviewView.pixelBuffer = inputPixelBuffer;
+    }
+    
+    #ifdef DEBUG
+    NSLog(@"%@",[self modelStats:YES]);
+    #endif
+}
+
 /**
  * Run the model on an image.
  * Our utility image.pixelBuffer method returns the pixel format in ARGB: `kCVPixelFormatType_32ARGB`
@@ -711,9 +760,7 @@ typedef enum : NSUInteger {
             
             // Show results and latency
             
-            [self.latencyCounter increaseImageProcessingLatency:preprocessingLatency];
-            [self.latencyCounter increaseInferenceLatency:inferenceLatency];
-            [self.latencyCounter incrementCount];
+            [self.latencyCounter recordImageProcessingLatency:preprocessingLatency inferenceLatency:inferenceLatency];
             
             [self showModelOutput:inference withDecay:NO];
             self.infoView.stats = [self modelStats:NO];
@@ -740,21 +787,51 @@ typedef enum : NSUInteger {
 }
 
 - (NSString*)modelStats:(BOOL)verbose {
+    LatencyStatistics *inference = _latencyCounter.inferenceStatistics;
+    
     if (verbose) {
+        LatencyStatistics *imageProcessing = _latencyCounter.imageProcessingStatistics;
+        NSDictionary *live = self.frameScheduler.statistics;
         return [NSString stringWithFormat:
-            @"Image preprocessing latency: %.1lfms, Inference latency: %.1lfms, Avg image preprocessing latency: %.1lfms, Avg inference latency: %.1lfms, count: %d",
+            @"Image preprocessing latency: %.1lfms, Inference latency: %.1lfms, Image preprocessing p50/p90/p99: %.1lf/%.1lf/%.1lfms, Inference p50/p90/p99/max: %.1lf/%.1lf/%.1lf/%.1lfms, stddev: %.1lfms, count: %tu, Live frames dropped: %.1lf%%, end-to-end p50/p99: %.1lf/%.1lfms, Inference skipped: %.1lf%%, saved: %.0lfms",
                 _latencyCounter.lastImageProcessingLatency,
                 _latencyCounter.lastInferenceLatency,
-                _latencyCounter.averageImageProcessingLatency,
-                _latencyCounter.averageInferenceLatency,
-                _latencyCounter.count
+                imageProcessing.p50,
+                imageProcessing.p90,
+                imageProcessing.p99,
+                inference.p50,
+                inference.p90,
+                inference.p99,
+                inference.max,
+                inference.stddev,
+                inference.count,
+                [live[@"drop_rate"] doubleValue] * 100,
+                [live[@"end_to_end_latency"][@"p50"] doubleValue],
+                [live[@"end_to_end_latency"][@"p99"] doubleValue],
+                _latencyCounter.skipRate * 100,
+                _latencyCounter.savedInferenceLatency
+        ];
+    } else if (inference.count == 0) {
+        return [NSString stringWithFormat:
+            @"Latency:\n %.1lfms",
+                _latencyCounter.lastInferenceLatency
+        ];
+    } else if (_latencyCounter.skippedCount == 0) {
+        return [NSString stringWithFormat:
+            @"Latency:\n %.1lfms\n\n p50 / p99 (of %tu):\n %.1lf / %.1lfms",
+                _latencyCounter.lastInferenceLatency,
+                inference.count,
+                inference.p50,
+                inference.p99
         ];
     } else {
         return [NSString stringWithFormat:
-            @"Latency:\n %.1lfms\n\n Average (of %d):\n %.1lfms",
+            @"Latency:\n %.1lfms\n\n p50 / p99 (of %tu):\n %.1lf / %.1lfms\n\n Skipped:\n %.0lf%%",
                 _latencyCounter.lastInferenceLatency,
-                _latencyCounter.count,
-                _latencyCounter.averageInferenceLatency
+                inference.count,
+                inference.p50,
+                inference.p99,
+                _latencyCounter.skipRate * 100
         ];
     }
 }
@@ -219,7 +219,7 @@ NSError * NetRunnerReloadModelsError() {
     
     NSError *error;
     
-    if ( ![TIOModelBundleManager.sharedManager loadModelBundlesAtPath:ModelManager.sharedManager.modelsPath error:&error] ) {
+    if ( ![ModelManager.sharedManager loadModelBundlesAtPath:ModelManager.sharedManager.modelsPath error:&error] ) {
         NSLog(@"Unable to load model bundles at path %@", ModelManager.sharedManager.modelsPath);
         [self showError:NetRunnerReloadModelsError()];
         return;
@@ -23,6 +23,8 @@
 #import "RunImageModelViewController.h"
 #import "ModelDetailsTableViewController.h"
 #import "AddModelTableViewController.h"
+#import "ModelManager.h"
+#import "ModelBundleHeader.h"
 
 @import TensorIO;
 
@@ -37,10 +39,25 @@
     self.navigationItem.rightBarButtonItem = [[UIBarButtonItem alloc] initWithBarButtonSystemItem:UIBarButtonSystemItemAdd target:self action:@selector(addModel:)];
 }
 
+- (BOOL)shouldPerformSegueWithIdentifier:(NSString *)identifier sender:(id)sender {
+    if ( [identifier isEqualToString:@"RunImageModelSegue"] ) {
+        NSIndexPath *indexPath = [self.tableView indexPathForCell:sender];
+        ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
+        
+        if ( header.bundle == nil ) {
+            [self.tableView deselectRowAtIndexPath:indexPath animated:YES];
+            [self showUnavailableModelAlert:header];
+            return NO;
+        }
+    }
+    
+    return YES;
+}
+
 - (void)prepareForSegue:(UIStoryboardSegue *)segue sender:(id)sender {
     if ( [segue.identifier isEqualToString:@"ModelDetailsSegue"] ) {
         ModelDetailsTableViewController *destination = (ModelDetailsTableViewController*)segue.destinationViewController;
-        destination.bundle = TIOModelBundleManager.sharedManager.modelBundles[((NSIndexPath*)sender).row];
+        destination.bundle = ModelManager.sharedManager.modelHeaders[((NSIndexPath*)sender).row].bundle;
         destination.actions = ModelDetailsActionDeleteModel;
         destination.delegate = self;
     }
@@ -51,7 +68,7 @@
     else if ( [segue.identifier isEqualToString:@"RunImageModelSegue"] ) {
         RunImageModelViewController *destination = (RunImageModelViewController*)segue.destinationViewController;
         NSIndexPath *indexPath = self.tableView.indexPathForSelectedRow;
-        TIOModelBundle *modelBundle = [TIOModelBundleManager.sharedManager.modelBundles objectAtIndex:indexPath.row];
+        TIOModelBundle *modelBundle = ModelManager.sharedManager.modelHeaders[indexPath.row].bundle;
         
         destination.modelBundle = modelBundle;
     }
@@ -64,7 +81,7 @@
 }
 
 - (NSInteger)tableView:(UITableView *)tableView numberOfRowsInSection:(NSInteger)section {
-    return TIOModelBundleManager.sharedManager.modelBundles.count;
+    return ModelManager.sharedManager.modelHeaders.count;
 }
 
 - (NSString*)tableView:(UITableView *)tableView titleForHeaderInSection:(NSInteger)section {
@@ -78,12 +95,12 @@
 
 - (UITableViewCell *)tableView:(UITableView *)tableView cellForRowAtIndexPath:(NSIndexPath *)indexPath {
     UITableViewCell *cell = [tableView dequeueReusableCellWithIdentifier:@"ModelCell" forIndexPath:indexPath];
-    TIOModelBundle *bundle = [TIOModelBundleManager.sharedManager.modelBundles objectAtIndex:indexPath.row];
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
     
-    cell.textLabel.text = bundle.name;
+    cell.textLabel.text = header.name;
     cell.accessoryType = UITableViewCellAccessoryDetailButton;
     
-    cell.textLabel.font = [self.selectedBundle.identifier isEqualToString:bundle.identifier]
+    cell.textLabel.font = [self.selectedBundle.identifier isEqualToString:header.identifier]
         ? [UIFont boldSystemFontOfSize:[UIFont systemFontSize]]
         : [UIFont systemFontOfSize:[UIFont systemFontSize]];
 
@@ -91,6 +108,13 @@
 }
 
 - (void)tableView:(UITableView *)tableView accessoryButtonTappedForRowWithIndexPath:(NSIndexPath *)indexPath {
+    ModelBundleHeader *header = ModelManager.sharedManager.modelHeaders[indexPath.row];
+    
+    if ( header.bundle == nil ) {
+        [self showUnavailableModelAlert:header];
+        return;
+    }
+    
     [self performSegueWithIdentifier:@"ModelDetailsSegue" sender:indexPath];
 }
 
@@ -112,4 +136,22 @@
     [self performSegueWithIdentifier:@"AddModelSegue" sender:nil];
 }
 
+// MARK: - Alerts
+
+// A header is listed from the manifest, but its bundle may no longer be readable
+
+- (void)showUnavailableModelAlert:(ModelBundleHeader*)header {
+    UIAlertController *alert = [UIAlertController
+        alertControllerWithTitle:NSLocalizedString(@"Unable to load model", @"Failed to load model alert title")
+        message:[NSString stringWithFormat:NSLocalizedString(@"The model bundle for %@ could not be read. Ensure it exists and is valid.", @"Failed to read model bundle alert message"), header.name]
+        preferredStyle:UIAlertControllerStyleAlert];
+    
+    [alert addAction:[UIAlertAction
+        actionWithTitle:NSLocalizedString(@"Dismiss", @"Alert dismiss action")
+        style:UIAlertActionStyleDefault
+        handler:nil]];
+    
+    [self presentViewController:alert animated:YES completion:nil];
+}
+
 @end
@@ -0,0 +1,331 @@
+//
+//  BatchScheduler.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef BatchScheduler_h
+#define BatchScheduler_h
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LatencyHistogram.h"
+
+namespace netrunner {
+
+/**
+ * A dynamic micro-batching scheduler for a single model.
+ *
+ * Producers submit individual requests from any thread. A single worker thread coalesces queued
+ * requests into batches, hands each batch to the runner, and fans the results back out to each
+ * request's completion on the worker thread, in the order the requests were submitted.
+ *
+ * A batch is dispatched as soon as one of the following is true:
+ *
+ * - `maxBatchSize` requests are queued, a full batch
+ * - a queued request's deadline has been reached, a deadline flush. Every request's deadline is
+ *   at most `maxDelay` after it was submitted, and may be sooner
+ * - the scheduler is stopping, which drains the queue
+ *
+ * While the runner is busy, requests keep queueing, and the next batch is formed from them as
+ * soon as it returns. A request whose deadline passed while the runner was busy is counted as
+ * late: its deadline was missed because of the work ahead of it, not because its batch waited
+ * to fill.
+ *
+ * The scheduler keeps histograms of batch sizes and of the queue depth when each batch was
+ * formed, and a latency histogram of the time each request waited before its batch was
+ * dispatched. It is templated on its request and result types and has no platform
+ * dependencies, so it may be exercised with synthetic runners and load generators on any
+ * platform.
+ *
+ * Usage:
+ *
+ * @code
+ * BatchScheduler<int,int> scheduler({8, std::chrono::milliseconds(5)}, [](const std::vector<int> &batch) {
+ *     std::vector<int> results;
+ *     for (int x : batch) results.push_back(x*x);
+ *     return results;
+ * });
+ *
+ * scheduler.submit(3, [](const int &result) { ... });
+ * @endcode
+ */
+
+template <typename Request, typename Result>
+class BatchScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Runner = std::function<std::vector<Result>(const std::vector<Request>&)>;
+    using Completion = std::function<void(const Result&)>;
+
+    struct Options {
+
+        /**
+         * The most requests handed to the runner at once. A runner whose backend only accepts
+         * one input at a time may still take larger batches and invoke the backend for each of
+         * its requests in turn.
+         */
+
+        size_t maxBatchSize = 8;
+
+        /**
+         * The longest a request waits for its batch to fill.
+         */
+
+        Clock::duration maxDelay = std::chrono::milliseconds(5);
+
+        /**
+         * Queue depths at or above this value are counted in the final histogram bucket.
+         */
+
+        size_t queueDepthBuckets = 64;
+    };
+
+    /**
+     * A snapshot of the scheduler's counters. Histograms are indexed by size: `batchSizes[n]` is
+     * the number of batches that contained `n` requests, and `queueDepths[n]` the number of
+     * times `n` requests were waiting when a batch was formed. Every batch is counted once as
+     * full, flushed at a deadline or drained while stopping.
+     */
+
+    struct Statistics {
+        uint64_t requests = 0;
+        uint64_t batches = 0;
+        uint64_t fullBatches = 0;
+        uint64_t deadlineBatches = 0;
+        uint64_t drainedBatches = 0;
+        uint64_t lateRequests = 0;
+        size_t queueDepth = 0;
+        size_t maxQueueDepth = 0;
+        std::vector<uint64_t> batchSizes;
+        std::vector<uint64_t> queueDepths;
+        LatencyHistogram::Summary queueLatency;
+
+        double averageBatchSize() const {
+            return batches == 0 ? 0 : static_cast<double>(requests) / static_cast<double>(batches);
+        }
+    };
+
+    BatchScheduler(const Options &options, Runner runner)
+        : _options(options), _runner(std::move(runner)) {
+        assert(_options.maxBatchSize > 0);
+        _statistics.batchSizes.assign(_options.maxBatchSize + 1, 0);
+        _statistics.queueDepths.assign(_options.queueDepthBuckets + 1, 0);
+        _worker = std::thread([this] { run(); });
+    }
+
+    /**
+     * Drains any queued requests and stops the worker.
+     */
+
+    ~BatchScheduler() {
+        stop();
+    }
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /**
+     * Enqueues a request. The completion is called on the worker thread once the request's batch
+     * has run. The request waits at most `maxDelay` for its batch to fill.
+     */
+
+    void submit(Request request, Completion completion) {
+        submit(std::move(request), std::move(completion), Clock::now() + _options.maxDelay);
+    }
+
+    /**
+     * Enqueues a request with its own deadline, which is clamped to `maxDelay` from now.
+     * Submitting after `stop` has been called is a programmer error.
+     */
+
+    void submit(Request request, Completion completion, Clock::time_point deadline) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            assert(!_stopping);
+
+            Clock::time_point submitted = Clock::now();
+            _queue.push_back({std::move(request), std::move(completion), submitted, std::min(deadline, submitted + _options.maxDelay)});
+            _statistics.queueDepth = _queue.size();
+            _statistics.maxQueueDepth = std::max(_statistics.maxQueueDepth, _queue.size());
+        }
+        _condition.notify_one();
+    }
+
+    /**
+     * Runs every queued request and joins the worker. Safe to call more than once.
+     */
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_one();
+
+        if ( _worker.joinable() ) {
+            _worker.join();
+        }
+    }
+
+    /**
+     * The number of requests waiting to be batched.
+     */
+
+    size_t queueDepth() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    Statistics statistics() const {
+        Statistics statistics;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            statistics = _statistics;
+        }
+        statistics.queueLatency = _queueLatency.summary();
+        return statistics;
+    }
+
+    const Options &options() const { return _options; }
+
+private:
+    struct Pending {
+        Request request;
+        Completion completion;
+        Clock::time_point submitted;
+        Clock::time_point deadline;
+    };
+
+    static double Milliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    void run() {
+        std::vector<Pending> batch;
+        std::vector<Request> requests;
+
+        // When the runner last returned, a deadline that passed before then was missed while it
+        // was busy
+
+        Clock::time_point idle = Clock::time_point::min();
+
+        while ( true ) {
+            batch.clear();
+            requests.clear();
+
+            Clock::time_point dispatched;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                uint64_t *reason = nullptr;
+
+                while ( reason == nullptr ) {
+                    if ( _queue.empty() ) {
+                        if ( _stopping ) {
+                            return;
+                        }
+                        _condition.wait(lock);
+                        continue;
+                    }
+
+                    if ( _queue.size() >= _options.maxBatchSize ) {
+                        reason = &_statistics.fullBatches;
+                    } else if ( _stopping ) {
+                        reason = &_statistics.drainedBatches;
+                    } else if ( Clock::now() >= earliestDeadline() ) {
+                        reason = &_statistics.deadlineBatches;
+                    } else {
+                        _condition.wait_until(lock, earliestDeadline());
+                    }
+                }
+
+                dispatched = Clock::now();
+
+                size_t depth = _queue.size();
+                size_t count = std::min(depth, _options.maxBatchSize);
+
+                *reason += 1;
+                _statistics.queueDepths[std::min(depth, _options.queueDepthBuckets)] += 1;
+                _statistics.batchSizes[count] += 1;
+                _statistics.requests += count;
+                _statistics.batches += 1;
+
+                for ( size_t i = 0; i < count; i++ ) {
+                    _statistics.lateRequests += _queue.front().deadline < idle ? 1 : 0;
+                    batch.push_back(std::move(_queue.front()));
+                    _queue.pop_front();
+                }
+
+                _statistics.queueDepth = _queue.size();
+            }
+
+            for ( Pending &pending : batch ) {
+                _queueLatency.record(Milliseconds(dispatched - pending.submitted));
+                requests.push_back(std::move(pending.request));
+            }
+
+            std::vector<Result> results = _runner(requests);
+            assert(results.size() == batch.size());
+
+            for ( size_t i = 0; i < batch.size() && i < results.size(); i++ ) {
+                if ( batch[i].completion ) {
+                    batch[i].completion(results[i]);
+                }
+            }
+
+            idle = Clock::now();
+        }
+    }
+
+    // Requires the lock. Deadlines are clamped on submit, so the earliest one is usually at the
+    // front, but a request with a tighter deadline may have been queued behind it
+
+    Clock::time_point earliestDeadline() const {
+        Clock::time_point deadline = Clock::time_point::max();
+        for ( const Pending &pending : _queue ) {
+            deadline = std::min(deadline, pending.deadline);
+        }
+        return deadline;
+    }
+
+    const Options _options;
+    const Runner _runner;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<Pending> _queue;
+    Statistics _statistics;
+    LatencyHistogram _queueLatency;
+    bool _stopping = false;
+
+    std::thread _worker;
+};
+
+} // namespace netrunner
+
+#endif /* BatchScheduler_h */
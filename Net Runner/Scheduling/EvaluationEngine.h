@@ -0,0 +1,199 @@
+//
+//  EvaluationEngine.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+
+#import "Evaluator.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * How the evaluation engine schedules models relative to one another.
+ */
+
+typedef NS_ENUM(NSInteger, EvaluationEngineMode) {
+    
+    /**
+     * Models are evaluated one at a time. Latency measurements are uncontended and comparable
+     * across runs. Use this mode when latency matters.
+     */
+    
+    EvaluationEngineModeSerial,
+    
+    /**
+     * Up to `maxConcurrentModels` models are evaluated at once, each on its own lane. Inference
+     * results are identical to serial evaluation but latencies are measured under contention and
+     * are flagged as such. Use this mode when only accuracy matters.
+     */
+    
+    EvaluationEngineModeParallel
+};
+
+typedef id<Evaluator> _Nullable (^EvaluationEngineEvaluatorGenerator)(NSUInteger index);
+typedef BOOL (^EvaluationEngineSkipBlock)(NSUInteger index);
+typedef void (^EvaluationEngineResultBlock)(NSString *modelID, NSUInteger index, NSDictionary<NSString*,id> *result);
+typedef void (^EvaluationEngineProgressBlock)(NSString *modelID, NSUInteger completed, NSUInteger total);
+typedef void (^EvaluationEngineModelCompletionBlock)(NSString *modelID, NSArray<NSDictionary<NSString*,id>*> *results);
+
+/**
+ * Runs evaluators for one or more models, with one serial lane per model. Evaluators for a
+ * single model always run in order on that model's lane because a `TIOModel` is not safe to use
+ * from more than one thread at a time, while lanes for different models may run concurrently.
+ *
+ * Evaluators are produced lazily by a generator as each lane reaches them, so only one
+ * evaluator per lane is alive at a time regardless of the size of the dataset. Results may be
+ * streamed to a result handler through a bounded window rather than collected.
+ *
+ * Each result is annotated with `kEvaluatorResultsKeyConcurrentModels`, the number of lanes that
+ * were running when it was produced, so that contended latency measurements can be identified.
+ *
+ * Usage:
+ *
+ * @code
+ * EvaluationEngine *engine = [[EvaluationEngine alloc] initWithMode:EvaluationEngineModeParallel];
+ * [engine addModel:model.identifier count:images.count generator:^id<Evaluator>(NSUInteger index) {
+ *     return [[FileImageEvaluator alloc] initWithModel:model fileURL:images[index] name:names[index]];
+ * }];
+ * NSArray *results = [engine run];
+ * @endcode
+ */
+
+@interface EvaluationEngine : NSObject
+
+/**
+ * The scheduling mode.
+ */
+
+@property (readonly) EvaluationEngineMode mode;
+
+/**
+ * The maximum number of models evaluated at once in parallel mode. Defaults to the number of
+ * active processors. Ignored in serial mode.
+ */
+
+@property NSUInteger maxConcurrentModels;
+
+/**
+ * The maximum number of results waiting to be delivered to the `resultHandler`. When the window
+ * is full lanes block until the handler catches up. Defaults to 64.
+ */
+
+@property NSUInteger maxPendingResults;
+
+/**
+ * When `YES`, the default, results are retained and returned from `run` and passed to the
+ * `modelCompletionHandler`. Set to `NO` when consuming results from the `resultHandler` so that
+ * memory use does not grow with the dataset.
+ */
+
+@property BOOL collectsResults;
+
+/**
+ * Called on a serial delivery queue with each result, in evaluator order for each model. Results
+ * that have not been delivered when the engine is cancelled are dropped.
+ */
+
+@property (nullable, copy) EvaluationEngineResultBlock resultHandler;
+
+/**
+ * Called after each evaluator for a model completes, on a serial progress queue while the lane
+ * waits, so the handler is never called concurrently even when lanes run in parallel.
+ */
+
+@property (nullable, copy) EvaluationEngineProgressBlock progressHandler;
+
+/**
+ * Called on a lane's thread when every evaluator for a model has completed and its results have
+ * been delivered to the `resultHandler`, with that model's results in evaluator order, or an
+ * empty array if the engine does not collect results. Not called for a cancelled lane.
+ */
+
+@property (nullable, copy) EvaluationEngineModelCompletionBlock modelCompletionHandler;
+
+/**
+ * `YES` once `cancel` has been called.
+ */
+
+@property (readonly, getter=isCancelled) BOOL cancelled;
+
+/**
+ * Designated initializer.
+ *
+ * @param mode The scheduling mode.
+ */
+
+- (instancetype)initWithMode:(EvaluationEngineMode)mode NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Adds a lane for a model whose evaluators are produced on demand. The generator is called on the
+ * lane's thread with each index from 0 to count-1, immediately before that evaluator runs, and
+ * may return `nil` to skip an index. Every evaluator must run inference on the same model
+ * instance. Must be called before `run`.
+ */
+
+- (void)addModel:(NSString*)modelID count:(NSUInteger)count generator:(EvaluationEngineEvaluatorGenerator)generator;
+
+/**
+ * Adds a lane for a model that skips the indexes for which `skip` returns `YES`, for example
+ * because their results were restored from an earlier, interrupted run. Skipped indexes produce
+ * no evaluator and no result but are reported to the `progressHandler` as completed.
+ */
+
+- (void)addModel:(NSString*)modelID count:(NSUInteger)count skipping:(nullable EvaluationEngineSkipBlock)skip generator:(EvaluationEngineEvaluatorGenerator)generator;
+
+/**
+ * Adds a lane for a model with evaluators that have already been built.
+ */
+
+- (void)addModel:(NSString*)modelID evaluators:(NSArray<id<Evaluator>>*)evaluators;
+
+/**
+ * Runs every lane and blocks until they have completed or the engine is cancelled and every
+ * pending result has been delivered. Returns the collected results ordered by the order in which
+ * models were added and then by evaluator order, regardless of the order in which they completed.
+ */
+
+- (NSArray<NSDictionary<NSString*,id>*> *)run;
+
+/**
+ * Stops the engine. No further evaluators are generated, lanes blocked on the result window are
+ * released, and undelivered results are dropped. An evaluator that is already running finishes
+ * first. May be called from any thread.
+ */
+
+- (void)cancel;
+
+/**
+ * Contention statistics by model id, available after `run`. Each entry contains
+ * "max_concurrent_models", the largest number of lanes running alongside the model, and
+ * "contended_results", the number of its results produced while another lane was running.
+ */
+
+- (NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *)contention;
+
+@end
+
+NS_ASSUME_NONNULL_END
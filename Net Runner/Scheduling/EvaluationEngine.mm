@@ -0,0 +1,275 @@
+//
+//  EvaluationEngine.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "EvaluationEngine.h"
+
+#import "EvaluatorConstants.h"
+#import "Utilities.h"
+
+#include <algorithm>
+#include <atomic>
+
+@interface EvaluationEngineLane : NSObject
+
+@property NSString *modelID;
+@property NSUInteger count;
+@property (copy) EvaluationEngineEvaluatorGenerator generator;
+@property (nullable, copy) EvaluationEngineSkipBlock skip;
+@property NSMutableArray<NSDictionary<NSString*,id>*> *results;
+@property NSUInteger maxConcurrentModels;
+@property NSUInteger contendedResults;
+
+@end
+
+@implementation EvaluationEngineLane
+@end
+
+// MARK: -
+
+@implementation EvaluationEngine {
+    NSMutableArray<EvaluationEngineLane*> *_lanes;
+    NSOperationQueue *_queue;
+    dispatch_queue_t _deliveryQueue;
+    dispatch_queue_t _progressQueue;
+    dispatch_semaphore_t _deliveryWindow;
+    std::atomic<NSUInteger> _activeLanes;
+    std::atomic<bool> _cancelled;
+}
+
+- (instancetype)initWithMode:(EvaluationEngineMode)mode {
+    if ((self=[super init])) {
+        _mode = mode;
+        _maxConcurrentModels = NSProcessInfo.processInfo.activeProcessorCount;
+        _maxPendingResults = 64;
+        _collectsResults = YES;
+        _lanes = [[NSMutableArray alloc] init];
+        _queue = [[NSOperationQueue alloc] init];
+        _queue.name = @"ai.doc.net-runner.evaluation-engine";
+        _deliveryQueue = dispatch_queue_create("ai.doc.net-runner.evaluation-engine.delivery", DISPATCH_QUEUE_SERIAL);
+        _progressQueue = dispatch_queue_create("ai.doc.net-runner.evaluation-engine.progress", DISPATCH_QUEUE_SERIAL);
+        _activeLanes = 0;
+        _cancelled = false;
+    }
+    return self;
+}
+
+- (BOOL)isCancelled {
+    return _cancelled;
+}
+
+- (void)addModel:(NSString*)modelID evaluators:(NSArray<id<Evaluator>>*)evaluators {
+    [self addModel:modelID count:evaluators.count generator:^id<Evaluator> _Nullable(NSUInteger index) {
+        return evaluators[index];
+    }];
+}
+
+- (void)addModel:(NSString*)modelID count:(NSUInteger)count generator:(EvaluationEngineEvaluatorGenerator)generator {
+    [self addModel:modelID count:count skipping:nil generator:generator];
+}
+
+- (void)addModel:(NSString*)modelID count:(NSUInteger)count skipping:(nullable EvaluationEngineSkipBlock)skip generator:(EvaluationEngineEvaluatorGenerator)generator {
+    EvaluationEngineLane *lane = [[EvaluationEngineLane alloc] init];
+    lane.modelID = modelID;
+    lane.count = count;
+    lane.skip = skip;
+    lane.generator = generator;
+    
+    [_lanes addObject:lane];
+}
+
+- (NSArray<NSDictionary<NSString*,id>*> *)run {
+    _queue.maxConcurrentOperationCount = self.mode == EvaluationEngineModeSerial
+        ? 1
+        : (NSInteger)std::max<NSUInteger>(self.maxConcurrentModels, 1);
+    
+    _deliveryWindow = dispatch_semaphore_create((long)std::max<NSUInteger>(self.maxPendingResults, 1));
+    
+    for ( EvaluationEngineLane *lane in _lanes ) {
+        lane.results = self.collectsResults ? [[NSMutableArray alloc] init] : nil;
+        
+        __weak EvaluationEngine *weakSelf = self;
+        [_queue addOperationWithBlock:^{
+            [weakSelf runLane:lane];
+        }];
+    }
+    
+    [_queue waitUntilAllOperationsAreFinished];
+    
+    // Flush results still waiting to be delivered
+    
+    dispatch_sync(_deliveryQueue, ^{});
+    
+    NSMutableArray<NSDictionary<NSString*,id>*> *results = [[NSMutableArray alloc] init];
+    
+    for ( EvaluationEngineLane *lane in _lanes ) {
+        if ( lane.results != nil ) {
+            [results addObjectsFromArray:lane.results];
+        }
+    }
+    
+    return results.copy;
+}
+
+- (void)runLane:(EvaluationEngineLane*)lane {
+    if ( _cancelled ) {
+        return;
+    }
+    
+    NSUInteger total = lane.count;
+    _activeLanes += 1;
+    
+    for ( NSUInteger index = 0; index < total; index++ ) {
+        
+        if ( _cancelled ) {
+            break;
+        }
+        
+        // Only one evaluator per lane is alive at a time, it and its intermediates are released here
+        
+        @autoreleasepool {
+            
+            if ( lane.skip != nil && lane.skip(index) ) {
+                [self reportProgress:index+1 total:total lane:lane];
+                continue;
+            }
+            
+            id<Evaluator> evaluator = lane.generator(index);
+            
+            if ( evaluator == nil ) {
+                NSLog(@"Evaluation engine: no evaluator for model %@ at index %tu", lane.modelID, index);
+                [self reportProgress:index+1 total:total lane:lane];
+                continue;
+            }
+            
+            // Sample concurrency on either side of the evaluation, lanes may start or finish midway
+            
+            NSUInteger concurrentBefore = _activeLanes;
+            __block NSDictionary<NSString*,id> *result;
+            
+            // Evaluators may complete on another thread, e.g. asynchronous photo requests are
+            // delivered on the main queue, so wait for the completion handler
+            
+            dispatch_semaphore_t completed = dispatch_semaphore_create(0);
+            
+            [evaluator evaluateWithCompletionHandler:^(NSDictionary * _Nonnull evaluatorResult, CVPixelBufferRef _Nullable inputPixelBuffer) {
+                result = evaluatorResult;
+                dispatch_semaphore_signal(completed);
+            }];
+            
+            dispatch_semaphore_wait(completed, DISPATCH_TIME_FOREVER);
+            
+            NSUInteger concurrent = std::max<NSUInteger>(concurrentBefore, _activeLanes);
+            
+            lane.maxConcurrentModels = std::max(lane.maxConcurrentModels, concurrent);
+            if ( concurrent > 1 ) {
+                lane.contendedResults += 1;
+            }
+            
+            if ( result != nil ) {
+                NSMutableDictionary *annotatedResult = [result mutableCopy];
+                annotatedResult[kEvaluatorResultsKeyConcurrentModels] = @(concurrent);
+                
+                NSDictionary<NSString*,id> *finalResult = annotatedResult.copy;
+                
+                [lane.results addObject:finalResult];
+                [self deliverResult:finalResult index:index lane:lane];
+            }
+        }
+        
+        [self reportProgress:index+1 total:total lane:lane];
+    }
+    
+    _activeLanes -= 1;
+    
+    // Flush the lane's results to the result handler before reporting it complete
+    
+    if ( !_cancelled ) {
+        dispatch_sync(_deliveryQueue, ^{});
+        safe_block(self.modelCompletionHandler, lane.modelID, lane.results != nil ? lane.results.copy : @[]);
+    }
+}
+
+/**
+ * Calls the progress handler on the progress queue and waits for it, so that lanes never call it
+ * concurrently and each lane's progress is reported in order.
+ */
+
+- (void)reportProgress:(NSUInteger)completed total:(NSUInteger)total lane:(EvaluationEngineLane*)lane {
+    EvaluationEngineProgressBlock progressHandler = self.progressHandler;
+    
+    if ( progressHandler == nil ) {
+        return;
+    }
+    
+    dispatch_sync(_progressQueue, ^{
+        progressHandler(lane.modelID, completed, total);
+    });
+}
+
+/**
+ * Hands a result to the result handler on the delivery queue. Blocks the lane while
+ * `maxPendingResults` are already waiting, so a slow consumer slows evaluation rather than
+ * letting results pile up. Wakes periodically so that cancellation is never stuck behind it.
+ */
+
+- (void)deliverResult:(NSDictionary<NSString*,id>*)result index:(NSUInteger)index lane:(EvaluationEngineLane*)lane {
+    EvaluationEngineResultBlock resultHandler = self.resultHandler;
+    
+    if ( resultHandler == nil ) {
+        return;
+    }
+    
+    while ( dispatch_semaphore_wait(_deliveryWindow, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.05 * NSEC_PER_SEC))) != 0 ) {
+        if ( _cancelled ) {
+            return;
+        }
+    }
+    
+    NSString *modelID = lane.modelID;
+    dispatch_semaphore_t window = _deliveryWindow;
+    
+    __weak EvaluationEngine *weakSelf = self;
+    dispatch_async(_deliveryQueue, ^{
+        if ( !weakSelf.isCancelled ) {
+            resultHandler(modelID, index, result);
+        }
+        dispatch_semaphore_signal(window);
+    });
+}
+
+- (void)cancel {
+    _cancelled = true;
+    [_queue cancelAllOperations];
+}
+
+- (NSDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *)contention {
+    NSMutableDictionary<NSString*,NSDictionary<NSString*,NSNumber*>*> *contention = [[NSMutableDictionary alloc] init];
+    
+    for ( EvaluationEngineLane *lane in _lanes ) {
+        contention[lane.modelID] = @{
+            @"max_concurrent_models": @(lane.maxConcurrentModels),
+            @"contended_results": @(lane.contendedResults)
+        };
+    }
+    
+    return contention.copy;
+}
+
+@end
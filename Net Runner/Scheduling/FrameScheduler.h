@@ -0,0 +1,378 @@
+//
+//  FrameScheduler.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef FrameScheduler_h
+#define FrameScheduler_h
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "LatencyHistogram.h"
+
+namespace netrunner {
+
+/**
+ * A latest-frame-wins scheduler for live inference.
+ *
+ * A producer such as a camera submits frames from its own thread and never waits on inference.
+ * Frames are handed to a dedicated worker through a single-slot mailbox: a frame submitted while
+ * another is still waiting replaces it, and the replaced frame is counted as dropped. The worker
+ * always runs the freshest frame, and the age of the frame behind each result is bounded by one
+ * preprocessing and inference pass rather than by a queue.
+ *
+ * Each frame is preprocessed into an input and the input run to produce a result, which is
+ * handed to the completion on the worker thread along with the frame's timing. When `pipelined`
+ * is set, preprocessing runs on a second worker, so the next frame is preprocessed while the
+ * current one runs. The preprocessing worker only takes a new frame once the inference worker
+ * has taken its last input, so no preprocessed input is ever thrown away. Pipelining raises
+ * throughput when the model cannot keep up with the camera, but a preprocessed input may then
+ * wait for the inference worker, which adds to its end-to-end latency.
+ *
+ * The scheduler counts submitted, dropped and completed frames and keeps a histogram of the
+ * end-to-end latency from capture to result. It is templated on its frame, input and result
+ * types and has no platform dependencies, so it may be exercised with a synthetic frame source
+ * on any platform. Frames and inputs must be default constructible and movable.
+ *
+ * Usage:
+ *
+ * @code
+ * FrameScheduler<Frame,Tensor,Labels> scheduler(options, [](Frame &frame) {
+ *     return Resize(frame);
+ * }, [](Tensor &input) {
+ *     return Classify(input);
+ * }, [](Labels &result, const FrameScheduler<Frame,Tensor,Labels>::Timing &timing) {
+ *     Show(result, timing.endToEndLatency());
+ * });
+ *
+ * scheduler.submit(frame, captureTime);
+ * @endcode
+ */
+
+template <typename Frame, typename Input, typename Result>
+class FrameScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * When a frame was captured, when a worker took it, when it was preprocessed and when its
+     * result was ready.
+     */
+
+    struct Timing {
+        Clock::time_point captured;
+        Clock::time_point started;
+        Clock::time_point preprocessed;
+        Clock::time_point finished;
+
+        /**
+         * The time the frame waited for a worker, in milliseconds.
+         */
+
+        double waitLatency() const { return Milliseconds(started - captured); }
+        double preprocessingLatency() const { return Milliseconds(preprocessed - started); }
+        double inferenceLatency() const { return Milliseconds(finished - preprocessed); }
+
+        /**
+         * The age of the frame when its result was ready, in milliseconds.
+         */
+
+        double endToEndLatency() const { return Milliseconds(finished - captured); }
+    };
+
+    using Preprocessor = std::function<Input(Frame&)>;
+    using Runner = std::function<Result(Input&)>;
+    using Completion = std::function<void(Result&, const Timing&)>;
+
+    struct Options {
+        bool pipelined = false;
+
+        /**
+         * The number of initial results excluded from the end-to-end latency histogram, which
+         * include model load and first-inference costs.
+         */
+
+        uint64_t warmup = 1;
+    };
+
+    /**
+     * A snapshot of the scheduler's counters. A frame is dropped when a newer frame replaces it
+     * before a worker takes it, or when the scheduler stops before running it.
+     */
+
+    struct Statistics {
+        uint64_t frames = 0;
+        uint64_t dropped = 0;
+        uint64_t completed = 0;
+        LatencyHistogram::Summary endToEndLatency;
+
+        double dropRate() const {
+            return frames == 0 ? 0 : static_cast<double>(dropped) / static_cast<double>(frames);
+        }
+    };
+
+    FrameScheduler(const Options &options, Preprocessor preprocessor, Runner runner, Completion completion)
+        : _options(options),
+          _preprocessor(std::move(preprocessor)),
+          _runner(std::move(runner)),
+          _completion(std::move(completion)),
+          _endToEnd(options.warmup) {
+        if ( _options.pipelined ) {
+            _preprocessingWorker = std::thread([this] { preprocess(); });
+            _inferenceWorker = std::thread([this] { infer(); });
+        } else {
+            _inferenceWorker = std::thread([this] { run(); });
+        }
+    }
+
+    /**
+     * Discards any waiting frame and stops the workers.
+     */
+
+    ~FrameScheduler() {
+        stop();
+    }
+
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    /**
+     * Offers a frame to the workers, replacing any frame that is still waiting. Never blocks on
+     * preprocessing or inference. Frames submitted after `stop` are dropped.
+     *
+     * @param captured When the frame was captured, which may be earlier than when it is
+     *  submitted, on the scheduler's clock.
+     */
+
+    void submit(Frame frame, Clock::time_point captured = Clock::now()) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _statistics.frames += 1;
+
+            if ( _stopping ) {
+                _statistics.dropped += 1;
+                return;
+            }
+            if ( _hasFrame ) {
+                _statistics.dropped += 1;
+            }
+
+            _frame = std::move(frame);
+            _captured = captured;
+            _hasFrame = true;
+        }
+        _condition.notify_all();
+    }
+
+    /**
+     * Finishes the frames being preprocessed and run, discards any frame or input still waiting,
+     * and joins the workers.
+     * Safe to call more than once.
+     */
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _condition.notify_all();
+
+        if ( _preprocessingWorker.joinable() ) {
+            _preprocessingWorker.join();
+        }
+        if ( _inferenceWorker.joinable() ) {
+            _inferenceWorker.join();
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if ( _hasFrame ) {
+            _statistics.dropped += 1;
+            _hasFrame = false;
+            _frame = Frame();
+        }
+        if ( _hasInput ) {
+            _statistics.dropped += 1;
+            _hasInput = false;
+            _input = Input();
+        }
+    }
+
+    Statistics statistics() const {
+        Statistics statistics;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            statistics = _statistics;
+        }
+        statistics.endToEndLatency = _endToEnd.summary();
+        return statistics;
+    }
+
+    const Options &options() const { return _options; }
+
+private:
+    static double Milliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // Requires the lock
+
+    Frame takeFrame(Clock::time_point *captured) {
+        Frame frame = std::move(_frame);
+        _frame = Frame();
+        _hasFrame = false;
+        *captured = _captured;
+        return frame;
+    }
+
+    void complete(Result &result, const Timing &timing) {
+        _endToEnd.record(timing.endToEndLatency());
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _statistics.completed += 1;
+        }
+        if ( _completion ) {
+            _completion(result, timing);
+        }
+    }
+
+    // Unpipelined, a single worker preprocesses and runs each frame
+
+    void run() {
+        while ( true ) {
+            Timing timing;
+            Frame frame;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this] { return _hasFrame || _stopping; });
+
+                if ( _stopping ) {
+                    return;
+                }
+
+                frame = takeFrame(&timing.captured);
+            }
+
+            timing.started = Clock::now();
+            Input input = _preprocessor(frame);
+            timing.preprocessed = Clock::now();
+            Result result = _runner(input);
+            timing.finished = Clock::now();
+
+            complete(result, timing);
+        }
+    }
+
+    // Pipelined, the preprocessing worker fills a second single-slot mailbox that the inference
+    // worker empties, and waits for it to be emptied before taking the next frame
+
+    void preprocess() {
+        while ( true ) {
+            Timing timing;
+            Frame frame;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this] { return (_hasFrame && !_hasInput) || _stopping; });
+
+                if ( _stopping ) {
+                    return;
+                }
+
+                frame = takeFrame(&timing.captured);
+            }
+
+            timing.started = Clock::now();
+            Input input = _preprocessor(frame);
+            timing.preprocessed = Clock::now();
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _input = std::move(input);
+                _inputTiming = timing;
+                _hasInput = true;
+            }
+            _condition.notify_all();
+        }
+    }
+
+    void infer() {
+        while ( true ) {
+            Timing timing;
+            Input input;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _condition.wait(lock, [this] { return _hasInput || _stopping; });
+
+                if ( _stopping ) {
+                    return;
+                }
+
+                input = std::move(_input);
+                _input = Input();
+                _hasInput = false;
+                timing = _inputTiming;
+            }
+            _condition.notify_all();
+
+            Result result = _runner(input);
+            timing.finished = Clock::now();
+
+            complete(result, timing);
+        }
+    }
+
+    const Options _options;
+    const Preprocessor _preprocessor;
+    const Runner _runner;
+    const Completion _completion;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _stopping = false;
+
+    // The capture mailbox
+
+    Frame _frame;
+    Clock::time_point _captured;
+    bool _hasFrame = false;
+
+    // The preprocessed input mailbox, when pipelined
+
+    Input _input;
+    Timing _inputTiming;
+    bool _hasInput = false;
+
+    Statistics _statistics;
+    LatencyHistogram _endToEnd;
+
+    std::thread _preprocessingWorker;
+    std::thread _inferenceWorker;
+};
+
+} // namespace netrunner
+
+#endif /* FrameScheduler_h */
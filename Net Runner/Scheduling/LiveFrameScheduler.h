@@ -0,0 +1,134 @@
+//
+//  LiveFrameScheduler.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import CoreVideo;
+@import ImageIO;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Called on one of the scheduler's workers with the frame's result and the pixel buffer that
+ * was given to the model. The result has the keys of a `CVPixelBufferEvaluator`'s results,
+ * either the latencies and inference results or a preprocessing or inference error, along with
+ * the `kEvaluatorResultsKeyEndToEndLatency`, and the motion gate's keys when it is enabled.
+ * Retain the pixel buffer to use it asynchronously.
+ */
+
+typedef void (^LiveFrameSchedulerResultHandler)(NSDictionary<NSString*,id> *result, CVPixelBufferRef _Nullable inputPixelBuffer);
+
+/**
+ * Runs a model on live camera frames off of the capture queue. The camera hands each frame to
+ * the scheduler and returns immediately, and the scheduler's own worker runs the most recent
+ * frame, dropping any frame that is replaced before the worker is free.
+ *
+ * The vision pipeline that transforms frames for the model is created once and reused rather
+ * than per frame. When `pipelined`, the next frame is transformed on a second worker while the
+ * current frame runs.
+ *
+ * With a motion threshold, transformed frames that have barely changed since the last frame that
+ * was run skip inference and reuse its output, with `kEvaluatorResultsKeyInferenceSkipped` set.
+ * A frame is still run at least once per refresh interval.
+ *
+ * See FrameScheduler.h and MotionGate.h for the portable scheduler this class wraps.
+ */
+
+@interface LiveFrameScheduler : NSObject
+
+/**
+ * The model on which inference is run.
+ */
+
+@property (readonly) id<TIOModel> model;
+
+/**
+ * Whether preprocessing is pipelined with inference.
+ */
+
+@property (readonly) BOOL pipelined;
+
+/**
+ * The change below which a frame's inference is skipped, in [0,1], or 0 if every frame is run.
+ */
+
+@property (readonly) double motionThreshold;
+
+/**
+ * The longest time in seconds that frames are skipped after the last frame that was run.
+ */
+
+@property (readonly) NSTimeInterval refreshInterval;
+
+/**
+ * Designated initializer. The model is loaded by the first frame if it is not already loaded.
+ *
+ * @param model The model on which inference is run. Its first input must be an image.
+ * @param pipelined Whether to preprocess the next frame while the current frame runs.
+ * @param motionThreshold The change below which a frame's inference is skipped, or 0 to run
+ *  every frame.
+ * @param refreshInterval The longest time in seconds that frames may be skipped.
+ * @param resultHandler Called with the result of each frame that is run.
+ */
+
+- (instancetype)initWithModel:(id<TIOModel>)model pipelined:(BOOL)pipelined motionThreshold:(double)motionThreshold refreshInterval:(NSTimeInterval)refreshInterval resultHandler:(LiveFrameSchedulerResultHandler)resultHandler NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Initializes a scheduler that runs every frame.
+ */
+
+- (instancetype)initWithModel:(id<TIOModel>)model pipelined:(BOOL)pipelined resultHandler:(LiveFrameSchedulerResultHandler)resultHandler;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Offers a frame to the scheduler, replacing any frame that is still waiting. Never blocks on
+ * inference. The pixel buffer is retained until the frame is run or dropped.
+ *
+ * @param pixelBuffer The camera frame.
+ * @param orientation The orientation of the frame.
+ * @param age How long ago the frame was captured, in seconds, e.g. from its presentation
+ *  timestamp, or 0 if it was just captured.
+ */
+
+- (void)submitPixelBuffer:(CVPixelBufferRef)pixelBuffer orientation:(CGImagePropertyOrientation)orientation age:(NSTimeInterval)age;
+
+/**
+ * Finishes the frame being run, discards any waiting frame and stops the workers. Further
+ * frames are dropped.
+ */
+
+- (void)stop;
+
+/**
+ * A snapshot of the scheduler's counters with the keys "frames", "dropped", "completed" and
+ * "drop_rate", and the "end_to_end_latency" statistics in milliseconds: "count", "mean",
+ * "stddev", "min", "p50", "p90", "p99" and "max". The first result is excluded from the latency.
+ */
+
+- (NSDictionary<NSString*,id> *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
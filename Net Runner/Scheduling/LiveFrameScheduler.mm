@@ -0,0 +1,291 @@
+//
+//  LiveFrameScheduler.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "LiveFrameScheduler.h"
+
+#include <chrono>
+#include <memory>
+
+#include "FrameScheduler.h"
+#include "MotionGate.h"
+#include "Tracer.h"
+
+#import "CVPixelBufferEvaluator.h"
+#import "EvaluatorConstants.h"
+#import "ModelOutput.h"
+#import "ModelOutputManager.h"
+
+using netrunner::MotionGate;
+using netrunner::Tracer;
+
+namespace {
+
+// Pixel buffers are held as strong ids so that ARC retains and releases them as frames are
+// replaced in the scheduler's mailboxes
+
+struct LiveFrame {
+    id pixelBuffer;
+    CGImagePropertyOrientation orientation;
+};
+
+struct LiveInput {
+    id pixelBuffer;
+    NSString *error;
+    bool gated;
+    bool skipped;
+    double change;
+};
+
+struct LiveResult {
+    id<ModelOutput> output;
+    id inputPixelBuffer;
+    NSString *errorKey;
+    NSString *error;
+    bool gated;
+    bool skipped;
+    double change;
+    double savedInferenceLatency;
+};
+
+// The output and inference latency of the last frame that was run, which skipped frames reuse.
+// Only the inference worker touches it.
+
+struct LiveHistory {
+    id<ModelOutput> output;
+    double inferenceLatency;
+};
+
+using LiveScheduler = netrunner::FrameScheduler<LiveFrame, LiveInput, LiveResult>;
+
+/**
+ * Asks the gate whether a transformed, model sized, four byte pixel buffer should be run.
+ */
+
+bool ShouldRun(MotionGate &gate, CVPixelBufferRef pixelBuffer) {
+    if ( CVPixelBufferIsPlanar(pixelBuffer) || CVPixelBufferGetBytesPerRow(pixelBuffer) < CVPixelBufferGetWidth(pixelBuffer) * 4 ) {
+        return true;
+    }
+    
+    Tracer::Scope span("motion gate", "preprocessing");
+    
+    CVPixelBufferLockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+    bool shouldRun = gate.shouldRun(
+        (const uint8_t *)CVPixelBufferGetBaseAddress(pixelBuffer),
+        CVPixelBufferGetWidth(pixelBuffer),
+        CVPixelBufferGetHeight(pixelBuffer),
+        CVPixelBufferGetBytesPerRow(pixelBuffer));
+    CVPixelBufferUnlockBaseAddress(pixelBuffer, kCVPixelBufferLock_ReadOnly);
+    
+    return shouldRun;
+}
+
+LiveInput Preprocess(id<TIOModel> model, TIOVisionPipeline *pipeline, MotionGate *gate, LiveFrame &frame) {
+    @autoreleasepool {
+    
+    NSError *loadError;
+    
+    if ( ![model load:&loadError] ) {
+        NSLog(@"Unable to load model, error: %@", loadError);
+        return LiveInput{nil, @"Unable to load model", false, false, 0};
+    }
+    
+    if ( pipeline == nil ) {
+        return LiveInput{nil, @"Model does not contain an image input in the first layer", false, false, 0};
+    }
+    
+    CVPixelBufferRef transformedPixelBuffer;
+    
+    {
+        Tracer::Scope span("vision pipeline", "preprocessing");
+        transformedPixelBuffer = [pipeline transform:(__bridge CVPixelBufferRef)frame.pixelBuffer orientation:frame.orientation];
+    }
+    
+    if ( transformedPixelBuffer == NULL ) {
+        return LiveInput{nil, @"TIOVisionPipeline returned NULL CVPixelBuffer", false, false, 0};
+    }
+    
+    // The gate compares the frame the model would see, which the pipeline has already scaled down
+    
+    if ( gate == nullptr ) {
+        return LiveInput{(__bridge id)transformedPixelBuffer, nil, false, false, 0};
+    }
+    
+    bool skipped = !ShouldRun(*gate, transformedPixelBuffer);
+    return LiveInput{(__bridge id)transformedPixelBuffer, nil, true, skipped, gate->lastChange()};
+    
+    } // @autoreleasepool
+}
+
+LiveResult Run(id<TIOModel> model, LiveHistory &history, LiveInput &input) {
+    if ( input.pixelBuffer == nil ) {
+        return LiveResult{nil, nil, kEvaluatorResultsKeyPreprocessingError, input.error, false, false, 0, 0};
+    }
+    
+    // A skipped frame reuses the last output, unless there is none to reuse
+    
+    if ( input.skipped && history.output != nil ) {
+        return LiveResult{history.output, input.pixelBuffer, nil, nil, true, true, input.change, history.inferenceLatency};
+    }
+    
+    @autoreleasepool {
+    
+    TIOPixelBuffer *pixelBufferWrapper = [[TIOPixelBuffer alloc] initWithPixelBuffer:(__bridge CVPixelBufferRef)input.pixelBuffer orientation:kCGImagePropertyOrientationUp];
+    NSDictionary *results;
+    
+    const auto start = std::chrono::steady_clock::now();
+    
+    {
+        Tracer::Scope span("run model", "inference");
+        results = (NSDictionary*)[model runOn:pixelBufferWrapper error:nil];
+    }
+    
+    Tracer::Scope span("model output", "inference");
+    id<ModelOutput> modelOutput = [[ModelOutputManager sharedManager] outputForModel:model results:results];
+    
+    if ( modelOutput == nil ) {
+        NSLog(@"Running the model produced null results");
+        history.output = nil;
+        return LiveResult{nil, input.pixelBuffer, kEvaluatorResultsKeyInferenceError, @"Model returned nil results", input.gated, false, input.change, 0};
+    }
+    
+    history.output = modelOutput;
+    history.inferenceLatency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    
+    return LiveResult{modelOutput, input.pixelBuffer, nil, nil, input.gated, false, input.change, 0};
+    
+    } // @autoreleasepool
+}
+
+NSDictionary<NSString*,id> * ResultDictionary(const LiveResult &result, const LiveScheduler::Timing &timing) {
+    if ( result.output == nil ) {
+        return @{
+            result.errorKey: result.error,
+            kEvaluatorResultsKeyEndToEndLatency: @(timing.endToEndLatency())
+        };
+    }
+    
+    NSMutableDictionary<NSString*,id> *dictionary = [@{
+        kEvaluatorResultsKeyPreprocessingLatency: @(timing.preprocessingLatency()),
+        kEvaluatorResultsKeyPreprocessingCacheHit: @(NO),
+        kEvaluatorResultsKeyInferenceLatency: @(timing.inferenceLatency()),
+        kEvaluatorResultsKeyInferenceResults: result.output,
+        kEvaluatorResultsKeyEndToEndLatency: @(timing.endToEndLatency()),
+        kEvaluatorResultsKeyInferenceSkipped: @(result.skipped)
+    } mutableCopy];
+    
+    if ( result.gated ) {
+        dictionary[kEvaluatorResultsKeyMotionChange] = @(result.change);
+    }
+    if ( result.skipped ) {
+        dictionary[kEvaluatorResultsKeySavedInferenceLatency] = @(result.savedInferenceLatency);
+    }
+    
+    return dictionary.copy;
+}
+
+} // namespace
+
+@implementation LiveFrameScheduler {
+    std::unique_ptr<LiveScheduler> _scheduler;
+}
+
+- (instancetype)initWithModel:(id<TIOModel>)model pipelined:(BOOL)pipelined motionThreshold:(double)motionThreshold refreshInterval:(NSTimeInterval)refreshInterval resultHandler:(LiveFrameSchedulerResultHandler)resultHandler {
+    if ((self=[super init])) {
+        _model = model;
+        _pipelined = pipelined;
+        _motionThreshold = MAX(motionThreshold, 0);
+        _refreshInterval = MAX(refreshInterval, 0);
+        
+        // One vision pipeline is reused for every frame. Only the preprocessing worker uses it.
+        
+        TIOPixelBufferLayerDescription *description = [CVPixelBufferEvaluator pixelBufferDescriptionForModel:model];
+        TIOVisionPipeline *pipeline = description == nil ? nil : [[TIOVisionPipeline alloc] initWithTIOPixelBufferDescription:description];
+        
+        // The gate is only used by the preprocessing worker and the history by the inference worker
+        
+        std::shared_ptr<MotionGate> gate;
+        std::shared_ptr<LiveHistory> history = std::make_shared<LiveHistory>();
+        
+        if ( _motionThreshold > 0 ) {
+            MotionGate::Options gateOptions;
+            gateOptions.threshold = _motionThreshold;
+            gateOptions.refreshInterval = std::chrono::duration_cast<MotionGate::Clock::duration>(std::chrono::duration<double>(_refreshInterval));
+            gate = std::make_shared<MotionGate>(gateOptions);
+        }
+        
+        LiveScheduler::Options options;
+        options.pipelined = pipelined;
+        
+        // The workers only capture the model, pipeline and handler so that the scheduler does
+        // not retain self
+        
+        _scheduler.reset(new LiveScheduler(options, [model, pipeline, gate](LiveFrame &frame) {
+            return Preprocess(model, pipeline, gate.get(), frame);
+        }, [model, history](LiveInput &input) {
+            return Run(model, *history, input);
+        }, [resultHandler](LiveResult &result, const LiveScheduler::Timing &timing) {
+            @autoreleasepool {
+                resultHandler(ResultDictionary(result, timing), (__bridge CVPixelBufferRef)result.inputPixelBuffer);
+            }
+        }));
+    }
+    return self;
+}
+
+- (instancetype)initWithModel:(id<TIOModel>)model pipelined:(BOOL)pipelined resultHandler:(LiveFrameSchedulerResultHandler)resultHandler {
+    return [self initWithModel:model pipelined:pipelined motionThreshold:0 refreshInterval:0 resultHandler:resultHandler];
+}
+
+- (void)dealloc {
+    _scheduler->stop();
+}
+
+- (void)submitPixelBuffer:(CVPixelBufferRef)pixelBuffer orientation:(CGImagePropertyOrientation)orientation age:(NSTimeInterval)age {
+    auto captured = LiveScheduler::Clock::now() - std::chrono::duration_cast<LiveScheduler::Clock::duration>(std::chrono::duration<double>(MAX(age, 0)));
+    _scheduler->submit(LiveFrame{(__bridge id)pixelBuffer, orientation}, captured);
+}
+
+- (void)stop {
+    _scheduler->stop();
+}
+
+- (NSDictionary<NSString*,id> *)statistics {
+    LiveScheduler::Statistics statistics = _scheduler->statistics();
+    const netrunner::LatencyHistogram::Summary &latency = statistics.endToEndLatency;
+    
+    return @{
+        @"frames": @(statistics.frames),
+        @"dropped": @(statistics.dropped),
+        @"completed": @(statistics.completed),
+        @"drop_rate": @(statistics.dropRate()),
+        @"end_to_end_latency": @{
+            @"count": @(latency.count),
+            @"mean": @(latency.mean),
+            @"stddev": @(latency.stddev),
+            @"min": @(latency.min),
+            @"p50": @(latency.p50),
+            @"p90": @(latency.p90),
+            @"p99": @(latency.p99),
+            @"max": @(latency.max)
+        }
+    };
+}
+
+@end
@@ -0,0 +1,127 @@
+//
+//  ModelBatchScheduler.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef void (^ModelBatchSchedulerCompletionBlock)(id<TIOData> _Nullable output, NSError * _Nullable error);
+
+/**
+ * Sits in front of a single `TIOModel` and coalesces inference requests from many producers,
+ * such as concurrent evaluators, into micro-batches that are run together on one worker thread.
+ *
+ * A batch is run when `maxBatchSize` requests are waiting or when a request has waited until its
+ * deadline, at most `maxDelay` seconds, whichever comes first. Requests that arrive while a batch
+ * is running queue for the next one.
+ *
+ * The TensorFlow Lite backend only accepts a batch size of one, so the model is invoked once for
+ * each request of a batch, in turn, on the worker thread. A batch still loads the model once and
+ * keeps the interpreter on one thread, and it leaves a single place to issue a true batched
+ * invocation for backends that support it. With a `maxBatchSize` of one, requests are run in
+ * the order they arrive, one at a time, as soon as the model is free.
+ *
+ * See BatchScheduler.h for the portable scheduler this class wraps.
+ */
+
+@interface ModelBatchScheduler : NSObject
+
+/**
+ * The model on which inference is run.
+ */
+
+@property (readonly) id<TIOModel> model;
+
+/**
+ * The maximum number of requests coalesced into a single batch.
+ */
+
+@property (readonly) NSUInteger maxBatchSize;
+
+/**
+ * The longest a request will wait for a batch to fill before it is run, in seconds.
+ */
+
+@property (readonly) NSTimeInterval maxDelay;
+
+/**
+ * Designated initializer. The model is loaded on first use if it is not already loaded.
+ *
+ * @param model The model on which inference is run.
+ * @param maxBatchSize The maximum number of requests in a batch, must be greater than zero.
+ * @param maxDelay The longest a request will wait for a batch to fill, in seconds.
+ */
+
+- (instancetype)initWithModel:(id<TIOModel>)model maxBatchSize:(NSUInteger)maxBatchSize maxDelay:(NSTimeInterval)maxDelay NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Use the designated initializer.
+ */
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/**
+ * Queues the input for inference. The completion handler is called on the scheduler's worker
+ * thread with the model's output or an error.
+ */
+
+- (void)runOn:(id<TIOData>)input completionHandler:(ModelBatchSchedulerCompletionBlock)completionHandler;
+
+/**
+ * Queues the input for inference with a latency deadline in seconds from now. The deadline may
+ * be shorter than `maxDelay` but not longer.
+ */
+
+- (void)runOn:(id<TIOData>)input deadline:(NSTimeInterval)deadline completionHandler:(ModelBatchSchedulerCompletionBlock)completionHandler;
+
+/**
+ * Queues the input and blocks until its batch has run. A drop-in replacement for
+ * `-[TIOModel runOn:error:]` from evaluator threads. Do not call from the worker thread.
+ */
+
+- (nullable id<TIOData>)runOn:(id<TIOData>)input error:(NSError * _Nullable *)error;
+
+/**
+ * Runs any queued requests and stops the worker thread. Further requests are not permitted.
+ */
+
+- (void)stop;
+
+/**
+ * The number of requests currently waiting to be batched.
+ */
+
+- (NSUInteger)queueDepth;
+
+/**
+ * A snapshot of the scheduler's counters with the keys "requests", "batches", "full_batches",
+ * "deadline_batches", "drained_batches", "late_requests", "average_batch_size",
+ * "max_queue_depth", "batch_size_histogram", "queue_depth_histogram" and "queue_latency".
+ * Histograms are arrays indexed by size. The queue latency, how long requests waited before
+ * their batch was run, has count, mean, stddev, min, p50, p90, p99 and max entries in
+ * milliseconds. A request is late when its deadline passed while an earlier batch was running.
+ */
+
+- (NSDictionary<NSString*,id> *)statistics;
+
+@end
+
+NS_ASSUME_NONNULL_END
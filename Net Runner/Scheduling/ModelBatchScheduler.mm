@@ -0,0 +1,221 @@
+//
+//  ModelBatchScheduler.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "ModelBatchScheduler.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "BatchScheduler.h"
+
+// MARK: - Errors
+
+static NSString * const NetRunnerModelBatchSchedulerErrorDomain = @"ai.doc.net-runner.model-batch-scheduler";
+
+static const NSInteger NetRunnerModelBatchSchedulerLoadErrorCode = 101;
+static const NSInteger NetRunnerModelBatchSchedulerInferenceErrorCode = 102;
+
+NSError * NetRunnerModelBatchSchedulerLoadError(NSError * _Nullable underlyingError);
+NSError * NetRunnerModelBatchSchedulerInferenceError(NSError * _Nullable underlyingError);
+
+// MARK: -
+
+namespace {
+
+struct InferenceRequest {
+    id<TIOData> input;
+};
+
+struct InferenceResult {
+    id<TIOData> output;
+    NSError *error;
+};
+
+using InferenceScheduler = netrunner::BatchScheduler<InferenceRequest, InferenceResult>;
+
+NSArray<NSNumber*> * HistogramArray(const std::vector<uint64_t> &histogram) {
+    NSMutableArray<NSNumber*> *array = [[NSMutableArray alloc] initWithCapacity:histogram.size()];
+    for ( uint64_t count : histogram ) {
+        [array addObject:@(count)];
+    }
+    return array.copy;
+}
+
+std::vector<InferenceResult> RunBatch(id<TIOModel> model, const std::vector<InferenceRequest> &batch) {
+    std::vector<InferenceResult> results;
+    results.reserve(batch.size());
+    
+    @autoreleasepool {
+    
+    NSError *loadError;
+    
+    if ( ![model load:&loadError] ) {
+        NSLog(@"Unable to load model, error: %@", loadError);
+        NSError *error = NetRunnerModelBatchSchedulerLoadError(loadError);
+        results.assign(batch.size(), InferenceResult{nil, error});
+        return results;
+    }
+    
+    // TIOTFLiteModel asserts a batch size of one, so the model is invoked for each request in turn
+    
+    for ( const InferenceRequest &request : batch ) {
+        NSError *inferenceError;
+        id<TIOData> output = [model runOn:request.input error:&inferenceError];
+        
+        if ( output == nil ) {
+            results.push_back(InferenceResult{nil, NetRunnerModelBatchSchedulerInferenceError(inferenceError)});
+        } else {
+            results.push_back(InferenceResult{output, nil});
+        }
+    }
+    
+    } // @autoreleasepool
+    
+    return results;
+}
+
+} // namespace
+
+@implementation ModelBatchScheduler {
+    std::unique_ptr<InferenceScheduler> _scheduler;
+}
+
+- (instancetype)initWithModel:(id<TIOModel>)model maxBatchSize:(NSUInteger)maxBatchSize maxDelay:(NSTimeInterval)maxDelay {
+    assert(maxBatchSize > 0);
+    
+    if ((self=[super init])) {
+        _model = model;
+        _maxBatchSize = maxBatchSize;
+        _maxDelay = maxDelay;
+        
+        InferenceScheduler::Options options;
+        options.maxBatchSize = maxBatchSize;
+        options.maxDelay = std::chrono::duration_cast<InferenceScheduler::Clock::duration>(std::chrono::duration<double>(maxDelay));
+        
+        // The runner only captures the model so that the scheduler does not retain self
+        
+        _scheduler.reset(new InferenceScheduler(options, [model](const std::vector<InferenceRequest> &batch) {
+            return RunBatch(model, batch);
+        }));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    _scheduler->stop();
+}
+
+- (void)runOn:(id<TIOData>)input completionHandler:(ModelBatchSchedulerCompletionBlock)completionHandler {
+    [self runOn:input deadline:self.maxDelay completionHandler:completionHandler];
+}
+
+- (void)runOn:(id<TIOData>)input deadline:(NSTimeInterval)deadline completionHandler:(ModelBatchSchedulerCompletionBlock)completionHandler {
+    auto when = InferenceScheduler::Clock::now() + std::chrono::duration_cast<InferenceScheduler::Clock::duration>(std::chrono::duration<double>(deadline));
+    
+    _scheduler->submit(InferenceRequest{input}, [completionHandler](const InferenceResult &result) {
+        completionHandler(result.output, result.error);
+    }, when);
+}
+
+- (nullable id<TIOData>)runOn:(id<TIOData>)input error:(NSError * _Nullable *)error {
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    __block id<TIOData> output;
+    __block NSError *inferenceError;
+    
+    [self runOn:input completionHandler:^(id<TIOData> _Nullable result, NSError * _Nullable resultError) {
+        output = result;
+        inferenceError = resultError;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    
+    if ( output == nil && error ) {
+        *error = inferenceError;
+    }
+    
+    return output;
+}
+
+- (void)stop {
+    _scheduler->stop();
+}
+
+- (NSUInteger)queueDepth {
+    return _scheduler->queueDepth();
+}
+
+- (NSDictionary<NSString*,id> *)statistics {
+    InferenceScheduler::Statistics statistics = _scheduler->statistics();
+    
+    const netrunner::LatencyHistogram::Summary &latency = statistics.queueLatency;
+    
+    return @{
+        @"requests": @(statistics.requests),
+        @"batches": @(statistics.batches),
+        @"full_batches": @(statistics.fullBatches),
+        @"deadline_batches": @(statistics.deadlineBatches),
+        @"drained_batches": @(statistics.drainedBatches),
+        @"late_requests": @(statistics.lateRequests),
+        @"average_batch_size": @(statistics.averageBatchSize()),
+        @"max_queue_depth": @(statistics.maxQueueDepth),
+        @"batch_size_histogram": HistogramArray(statistics.batchSizes),
+        @"queue_depth_histogram": HistogramArray(statistics.queueDepths),
+        @"queue_latency": @{
+            @"count": @(latency.count),
+            @"mean": @(latency.mean),
+            @"stddev": @(latency.stddev),
+            @"min": @(latency.min),
+            @"p50": @(latency.p50),
+            @"p90": @(latency.p90),
+            @"p99": @(latency.p99),
+            @"max": @(latency.max)
+        }
+    };
+}
+
+@end
+
+// MARK: - Errors
+
+NSError * NetRunnerModelBatchSchedulerLoadError(NSError * _Nullable underlyingError) {
+    NSMutableDictionary *userInfo = [@{
+        NSLocalizedDescriptionKey: @"Unable to load the model before running a batch"
+    } mutableCopy];
+    
+    if ( underlyingError ) {
+        userInfo[NSUnderlyingErrorKey] = underlyingError;
+    }
+    
+    return [[NSError alloc] initWithDomain:NetRunnerModelBatchSchedulerErrorDomain code:NetRunnerModelBatchSchedulerLoadErrorCode userInfo:userInfo.copy];
+}
+
+NSError * NetRunnerModelBatchSchedulerInferenceError(NSError * _Nullable underlyingError) {
+    NSMutableDictionary *userInfo = [@{
+        NSLocalizedDescriptionKey: @"The model returned nil results"
+    } mutableCopy];
+    
+    if ( underlyingError ) {
+        userInfo[NSUnderlyingErrorKey] = underlyingError;
+    }
+    
+    return [[NSError alloc] initWithDomain:NetRunnerModelBatchSchedulerErrorDomain code:NetRunnerModelBatchSchedulerInferenceErrorCode userInfo:userInfo.copy];
+}
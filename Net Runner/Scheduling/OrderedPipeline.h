@@ -0,0 +1,205 @@
+//
+//  OrderedPipeline.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef OrderedPipeline_h
+#define OrderedPipeline_h
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * Produces outputs for a range of indexes on a pool of worker threads and hands them to a single
+ * consumer in index order.
+ *
+ * Workers claim indexes in order, but may finish out of order. Finished outputs wait in a reorder
+ * buffer until every earlier output has been consumed. The buffer is bounded by `window`: a worker
+ * does not start on an index until it is within `window` of the next index to be consumed, so at
+ * most `window` outputs are held in memory however slow the consumer is.
+ *
+ * The consumer runs on the thread that calls `run` and may stop the pipeline by returning false.
+ * Outputs must be default constructible and movable.
+ *
+ * Usage:
+ *
+ * @code
+ * OrderedPipeline<std::vector<uint8_t>> pipeline({4, 8});
+ * pipeline.run(count, [&](size_t index) {
+ *     return Encode(Fetch(index));
+ * }, [&](size_t index, std::vector<uint8_t> &bytes) {
+ *     return writer->add(Name(index), bytes.data(), bytes.size(), &error);
+ * });
+ * @endcode
+ */
+
+template <typename Output>
+class OrderedPipeline {
+public:
+    using Producer = std::function<Output(size_t index)>;
+    using Consumer = std::function<bool(size_t index, Output &output)>;
+
+    struct Options {
+        size_t workers = 4;
+        size_t window = 8;
+
+        Options() {}
+        Options(size_t workers, size_t window) : workers(workers), window(window) {}
+    };
+
+    struct Statistics {
+        size_t produced = 0;
+        size_t consumed = 0;
+
+        /**
+         * The most outputs that were waiting for the consumer at once.
+         */
+
+        size_t maxBuffered = 0;
+
+        /**
+         * The number of times a worker waited for the consumer to make room in the window.
+         */
+
+        size_t stalls = 0;
+    };
+
+    explicit OrderedPipeline(const Options &options)
+        : _workers(std::max<size_t>(1, options.workers)),
+          _window(std::max(std::max<size_t>(1, options.workers), options.window)) {}
+
+    /**
+     * Produces and consumes the indexes in [0, count). Returns false if the consumer stopped the
+     * pipeline, in which case outputs already in flight are produced and discarded.
+     */
+
+    bool run(size_t count, const Producer &producer, const Consumer &consumer) {
+        std::vector<Output> slots(_window);
+        std::vector<bool> ready(_window, false);
+        std::vector<std::thread> workers;
+
+        size_t claimed = 0;
+        size_t next = 0;
+        size_t buffered = 0;
+        bool stopping = false;
+
+        _statistics = Statistics();
+
+        for ( size_t w = 0; w < std::min(_workers, count); w++ ) {
+            workers.emplace_back([&] {
+                while ( true ) {
+                    size_t index;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+
+                        if ( !stopping && claimed < count && claimed >= next + _window ) {
+                            _statistics.stalls += 1;
+                            _consumed.wait(lock, [&] {
+                                return stopping || claimed >= count || claimed < next + _window;
+                            });
+                        }
+
+                        if ( stopping || claimed >= count ) {
+                            return;
+                        }
+
+                        index = claimed++;
+                    }
+
+                    Output output = producer(index);
+
+                    {
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        slots[index % _window] = std::move(output);
+                        ready[index % _window] = true;
+                        buffered += 1;
+                        _statistics.produced += 1;
+                        _statistics.maxBuffered = std::max(_statistics.maxBuffered, buffered);
+                    }
+                    _produced.notify_one();
+                }
+            });
+        }
+
+        bool completed = true;
+
+        for ( size_t index = 0; index < count; index++ ) {
+            Output output;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _produced.wait(lock, [&] { return ready[index % _window]; });
+
+                output = std::move(slots[index % _window]);
+                slots[index % _window] = Output();
+                ready[index % _window] = false;
+                buffered -= 1;
+                next = index + 1;
+            }
+            _consumed.notify_all();
+
+            if ( !consumer(index, output) ) {
+                completed = false;
+                break;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _statistics.consumed += 1;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            stopping = true;
+        }
+        _consumed.notify_all();
+
+        for ( std::thread &worker : workers ) {
+            worker.join();
+        }
+
+        return completed;
+    }
+
+    /**
+     * The statistics of the last run.
+     */
+
+    Statistics statistics() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _statistics;
+    }
+
+private:
+    const size_t _workers;
+    const size_t _window;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _produced;
+    std::condition_variable _consumed;
+    Statistics _statistics;
+};
+
+} // namespace netrunner
+
+#endif /* OrderedPipeline_h */
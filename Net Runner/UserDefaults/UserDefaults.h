@@ -25,7 +25,15 @@ NS_ASSUME_NONNULL_BEGIN
 
 extern NSString * const kPrefsShowInputBuffers;
 extern NSString * const kPrefsShowInputBufferAlpha;
+extern NSString * const kPrefsLivePipelinesPreprocessing;
+extern NSString * const kPrefsLiveMotionThreshold;
+extern NSString * const kPrefsLiveMotionRefreshInterval;
+extern NSString * const kPrefsLiveSmoothing;
 extern NSString * const kPrefsEvaluateIterations;
+extern NSString * const kPrefsEvaluateModelsInParallel;
+extern NSString * const kPrefsEvaluateResumesInterrupted;
+extern NSString * const kPrefsHeadlessShard;
+extern NSString * const kPrefsHeadlessTrace;
 extern NSString * const kPrefsBuild7CleanedModelsDir;
 extern NSString * const kPrefsVersionLast;
 
@@ -22,8 +22,16 @@
 
 #import "UserDefaults.h"
 
-NSString * const kPrefsShowInputBuffers         = @"app.ui.show-input-buffers";
-NSString * const kPrefsShowInputBufferAlpha     = @"app.ui.show-input-buffer-alpha";
-NSString * const kPrefsEvaluateIterations       = @"app.eval.number-of-iterations";
-NSString * const kPrefsBuild7CleanedModelsDir   = @"app.build7.cleaned-models-dir";
-NSString * const kPrefsVersionLast              = @"app.version.last";
+NSString * const kPrefsShowInputBuffers           = @"app.ui.show-input-buffers";
+NSString * const kPrefsShowInputBufferAlpha       = @"app.ui.show-input-buffer-alpha";
+NSString * const kPrefsLivePipelinesPreprocessing = @"app.live.pipelines-preprocessing";
+NSString * const kPrefsLiveMotionThreshold        = @"app.live.motion-threshold";
+NSString * const kPrefsLiveMotionRefreshInterval  = @"app.live.motion-refresh-interval";
+NSString * const kPrefsLiveSmoothing              = @"app.live.smoothing";
+NSString * const kPrefsEvaluateIterations         = @"app.eval.number-of-iterations";
+NSString * const kPrefsEvaluateModelsInParallel   = @"app.eval.models-in-parallel";
+NSString * const kPrefsEvaluateResumesInterrupted = @"app.eval.resume-interrupted";
+NSString * const kPrefsHeadlessShard              = @"app.headless.shard";
+NSString * const kPrefsHeadlessTrace              = @"app.headless.trace";
+NSString * const kPrefsBuild7CleanedModelsDir     = @"app.build7.cleaned-models-dir";
+NSString * const kPrefsVersionLast                = @"app.version.last";
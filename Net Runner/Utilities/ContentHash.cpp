@@ -0,0 +1,114 @@
+//
+//  ContentHash.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ContentHash.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+ContentHash& ContentHash::update(const void *bytes, size_t length) {
+    const uint8_t *data = static_cast<const uint8_t*>(bytes);
+    uint64_t value = _value;
+
+    for ( size_t i = 0; i < length; i++ ) {
+        value = (value ^ data[i]) * kPrime;
+    }
+
+    _value = value;
+    return *this;
+}
+
+ContentHash& ContentHash::update(const std::string &string) {
+    update(static_cast<uint64_t>(string.size()));
+    return update(string.data(), string.size());
+}
+
+// Little endian, so that the hash does not depend on the host's byte order
+
+ContentHash& ContentHash::update(uint64_t value) {
+    uint8_t bytes[sizeof(value)];
+
+    for ( size_t i = 0; i < sizeof(value); i++ ) {
+        bytes[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    return update(bytes, sizeof(bytes));
+}
+
+std::string ContentHash::Hex(uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16, '0');
+
+    for ( size_t i = 0; i < 16; i++ ) {
+        hex[15 - i] = digits[(value >> (4 * i)) & 0xf];
+    }
+
+    return hex;
+}
+
+bool ContentHash::File(const std::string &path, uint64_t *hash, std::string *error) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if ( fd < 0 ) {
+        SetError(error, "Unable to open " + path + ": " + std::strerror(errno));
+        return false;
+    }
+
+    ContentHash contentHash;
+    uint8_t buffer[64 * 1024];
+
+    while ( true ) {
+        ssize_t count = ::read(fd, buffer, sizeof(buffer));
+
+        if ( count < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( count < 0 ) {
+            SetError(error, "Unable to read " + path + ": " + std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+        if ( count == 0 ) {
+            break;
+        }
+
+        contentHash.update(buffer, static_cast<size_t>(count));
+    }
+
+    ::close(fd);
+    *hash = contentHash.value();
+    return true;
+}
+
+} // namespace netrunner
@@ -0,0 +1,77 @@
+//
+//  ContentHash.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ContentHash_h
+#define ContentHash_h
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace netrunner {
+
+/**
+ * An incremental 64-bit FNV-1a hash, used to identify the content of inputs and models so that
+ * evaluation results can be keyed by what was evaluated rather than by where it was found.
+ *
+ * The hash is stable across processes, platforms and releases, unlike `std::hash`, and is not
+ * cryptographic. Strings are hashed with their length so that consecutive fields cannot run
+ * into one another.
+ *
+ * Usage:
+ *
+ * @code
+ * uint64_t key = ContentHash().update(modelID).update(iteration).value();
+ * @endcode
+ */
+
+class ContentHash {
+public:
+    static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ULL;
+    static constexpr uint64_t kPrime = 0x100000001b3ULL;
+
+    ContentHash& update(const void *bytes, size_t length);
+    ContentHash& update(const std::string &string);
+    ContentHash& update(uint64_t value);
+
+    uint64_t value() const { return _value; }
+
+    /**
+     * The value as 16 lowercase hexadecimal digits.
+     */
+
+    std::string hex() const { return Hex(_value); }
+
+    static std::string Hex(uint64_t value);
+
+    /**
+     * Hashes the contents of the file at path. Returns false and sets error if the file cannot
+     * be read.
+     */
+
+    static bool File(const std::string &path, uint64_t *hash, std::string *error);
+
+private:
+    uint64_t _value = kOffsetBasis;
+};
+
+} // namespace netrunner
+
+#endif /* ContentHash_h */
@@ -0,0 +1,101 @@
+//
+//  EvaluationShard.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "EvaluationShard.h"
+
+#include <cassert>
+#include <cstdlib>
+
+#include "ContentHash.h"
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+// FNV-1a's low bits are weak, the lowest is only the parity of the bytes' lowest bits, so the
+// hash is finalized with MurmurHash3's mixer before it is reduced to a shard
+
+uint64_t Mix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+} // namespace
+
+EvaluationShard::EvaluationShard(uint32_t index, uint32_t count) : _index(index), _count(count) {
+    assert(count > 0 && index < count);
+}
+
+bool EvaluationShard::Parse(const std::string &description, EvaluationShard *shard, std::string *error) {
+    const char *begin = description.c_str();
+    char *slash = nullptr;
+    char *end = nullptr;
+
+    unsigned long index = std::strtoul(begin, &slash, 10);
+
+    if ( slash == begin || *slash != '/' ) {
+        SetError(error, "Expected a shard written index/count, e.g. 1/4, not " + description);
+        return false;
+    }
+
+    unsigned long count = std::strtoul(slash + 1, &end, 10);
+
+    if ( end == slash + 1 || *end != '\0' ) {
+        SetError(error, "Expected a shard written index/count, e.g. 1/4, not " + description);
+        return false;
+    }
+
+    if ( count == 0 || count > UINT32_MAX || index == 0 || index > count ) {
+        SetError(error, "Shard " + description + " is out of range, the index runs from 1 to the count");
+        return false;
+    }
+
+    *shard = EvaluationShard(static_cast<uint32_t>(index - 1), static_cast<uint32_t>(count));
+    return true;
+}
+
+std::string EvaluationShard::description() const {
+    return std::to_string(_index + 1) + "/" + std::to_string(_count);
+}
+
+std::string EvaluationShard::name() const {
+    return "shard-" + std::to_string(_index + 1) + "-of-" + std::to_string(_count);
+}
+
+bool EvaluationShard::contains(const std::string &modelID, const std::string &input, uint64_t iteration) const {
+    return _count == 1 || Assign(modelID, input, iteration, _count) == _index;
+}
+
+uint32_t EvaluationShard::Assign(const std::string &modelID, const std::string &input, uint64_t iteration, uint32_t count) {
+    uint64_t hash = ContentHash().update(modelID).update(input).update(iteration).value();
+    return static_cast<uint32_t>(Mix(hash) % count);
+}
+
+} // namespace netrunner
@@ -0,0 +1,102 @@
+//
+//  EvaluationShard.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef EvaluationShard_h
+#define EvaluationShard_h
+
+#include <cstdint>
+#include <string>
+
+namespace netrunner {
+
+/**
+ * One of `count` disjoint slices of a test bundle's evaluations, so that a bundle may be split
+ * across processes or devices and their partial summaries merged into the summary of a single
+ * run.
+ *
+ * Each evaluation, a model, an input and an iteration, is assigned to a shard by a stable hash of
+ * the model's identifier, the input's path in the test bundle and the iteration. Every process
+ * computes the same assignment without coordinating, and the assignment does not depend on the
+ * order in which a bundle lists its models or images. Shards are balanced in expectation rather
+ * than exactly.
+ *
+ * Shards are written "index/count" with a one-based index, e.g. "2/4" for the second of four.
+ */
+
+class EvaluationShard {
+public:
+
+    /**
+     * The whole run, the only shard of one.
+     */
+
+    EvaluationShard() = default;
+
+    /**
+     * @param index The zero-based index of the shard, less than count.
+     * @param count The number of shards, at least one.
+     */
+
+    EvaluationShard(uint32_t index, uint32_t count);
+
+    /**
+     * Parses a shard written "index/count". Returns false and sets error if the description is
+     * malformed or the index is out of range.
+     */
+
+    static bool Parse(const std::string &description, EvaluationShard *shard, std::string *error);
+
+    uint32_t index() const { return _index; }
+    uint32_t count() const { return _count; }
+
+    bool isWhole() const { return _count == 1; }
+
+    /**
+     * The shard written "index/count".
+     */
+
+    std::string description() const;
+
+    /**
+     * A suffix for files written by the shard, e.g. "shard-2-of-4".
+     */
+
+    std::string name() const;
+
+    /**
+     * True if the evaluation of an input by a model at an iteration belongs to this shard.
+     */
+
+    bool contains(const std::string &modelID, const std::string &input, uint64_t iteration) const;
+
+    /**
+     * The zero-based index of the shard an evaluation belongs to, out of count.
+     */
+
+    static uint32_t Assign(const std::string &modelID, const std::string &input, uint64_t iteration, uint32_t count);
+
+private:
+    uint32_t _index = 0;
+    uint32_t _count = 1;
+};
+
+} // namespace netrunner
+
+#endif /* EvaluationShard_h */
@@ -22,22 +22,127 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ * A snapshot of a latency distribution, in milliseconds.
+ */
+
+@interface LatencyStatistics : NSObject
+
+@property (readonly) NSUInteger count;
+@property (readonly) double mean;
+@property (readonly) double stddev;
+@property (readonly) double min;
+@property (readonly) double p50;
+@property (readonly) double p90;
+@property (readonly) double p99;
+@property (readonly) double max;
+
+/**
+ * The statistics keyed by property name, suitable for JSON serialization.
+ */
+
+- (NSDictionary<NSString*,NSNumber*>*)dictionaryRepresentation;
+
+@end
+
+// MARK: -
+
+/**
+ * Records image processing, inference and total latency into log-bucketed histograms and
+ * reports their distributions. See LatencyHistogram.h.
+ *
+ * Recording is lock-free and may be done from any thread. Counters may also be filled on
+ * separate threads and merged.
+ */
+
 @interface LatencyCounter : NSObject
 
+/**
+ * The number of initial measurements excluded from the distributions.
+ */
+
+@property (readonly) NSUInteger warmup;
+
 @property (readonly) double lastImageProcessingLatency;
 @property (readonly) double lastInferenceLatency;
 
-@property (readonly) double imageProcessingLatency;
-@property (readonly) double inferenceLatency;
-@property (readonly) int count;
+/**
+ * The number of measurements in the distributions, excluding warm-up measurements.
+ */
+
+@property (readonly) NSUInteger count;
 
 @property (readonly) double averageImageProcessingLatency;
 @property (readonly) double averageInferenceLatency;
 @property (readonly) double averageTotalLatency;
 
-- (void)increaseImageProcessingLatency:(double)value;
-- (void)increaseInferenceLatency:(double)value;
-- (void)incrementCount;
+/**
+ * The number of live frames whose inference was skipped because they had not changed, which are
+ * not included in the distributions, and the fraction of all frames they make up.
+ */
+
+@property (readonly) NSUInteger skippedCount;
+@property (readonly) double skipRate;
+
+/**
+ * The total inference time in milliseconds saved by skipped frames.
+ */
+
+@property (readonly) double savedInferenceLatency;
+
+@property (readonly) LatencyStatistics *imageProcessingStatistics;
+@property (readonly) LatencyStatistics *inferenceStatistics;
+@property (readonly) LatencyStatistics *totalStatistics;
+
+/**
+ * The recorded latencies as JSON serializable histogram states, which the command line runner
+ * merges with the states of other shards of a run. Extremes are in microseconds and sums in
+ * milliseconds, and only non-empty buckets are kept, as [index, count] pairs. See
+ * LatencyHistogram::State.
+ */
+
+@property (readonly) NSDictionary<NSString*,id> *imageProcessingState;
+@property (readonly) NSDictionary<NSString*,id> *inferenceState;
+@property (readonly) NSDictionary<NSString*,id> *totalState;
+
+/**
+ * Designated initializer.
+ *
+ * @param warmup The number of initial measurements to exclude, for example to discard the
+ *  latency of the first inference after a model is loaded.
+ */
+
+- (instancetype)initWithWarmup:(NSUInteger)warmup NS_DESIGNATED_INITIALIZER;
+
+/**
+ * Initializes a counter without a warm-up.
+ */
+
+- (instancetype)init;
+
+/**
+ * Records the latencies of a single evaluation. The total latency is their sum.
+ */
+
+- (void)recordImageProcessingLatency:(double)imageProcessingLatency inferenceLatency:(double)inferenceLatency;
+
+/**
+ * Records a frame whose inference was skipped, along with the inference latency it saved.
+ */
+
+- (void)recordSkippedInferenceSavingLatency:(double)inferenceLatency;
+
+/**
+ * Adds the measurements recorded by another counter to this one.
+ */
+
+- (void)mergeCounter:(LatencyCounter*)counter;
+
+/**
+ * Discards every measurement and restarts the warm-up.
+ */
+
+- (void)reset;
 
 @end
 
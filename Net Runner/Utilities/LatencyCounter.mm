@@ -0,0 +1,208 @@
+//
+//  LatencyCounter.mm
+//  Net Runner
+//
+//  Created by Philip Dow on 7/4/18.
+//  Copyright © 2018 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "LatencyCounter.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+#include "LatencyHistogram.h"
+
+using netrunner::LatencyHistogram;
+
+static NSDictionary<NSString*,id> *StateDictionary(const LatencyHistogram &histogram);
+
+@implementation LatencyStatistics
+
+- (instancetype)initWithSummary:(const LatencyHistogram::Summary &)summary {
+    if ((self=[super init])) {
+        _count = (NSUInteger)summary.count;
+        _mean = summary.mean;
+        _stddev = summary.stddev;
+        _min = summary.min;
+        _p50 = summary.p50;
+        _p90 = summary.p90;
+        _p99 = summary.p99;
+        _max = summary.max;
+    }
+    return self;
+}
+
+- (NSDictionary<NSString*,NSNumber*>*)dictionaryRepresentation {
+    return @{
+        @"count": @(self.count),
+        @"mean": @(self.mean),
+        @"stddev": @(self.stddev),
+        @"min": @(self.min),
+        @"p50": @(self.p50),
+        @"p90": @(self.p90),
+        @"p99": @(self.p99),
+        @"max": @(self.max)
+    };
+}
+
+- (NSString*)description {
+    return [NSString stringWithFormat:@"<%@: %p> %@", self.class, self, self.dictionaryRepresentation];
+}
+
+@end
+
+// MARK: -
+
+@implementation LatencyCounter {
+    std::unique_ptr<LatencyHistogram> _imageProcessing;
+    std::unique_ptr<LatencyHistogram> _inference;
+    std::unique_ptr<LatencyHistogram> _total;
+    std::atomic<uint64_t> _skipped;
+    std::atomic<uint64_t> _savedMicros;
+}
+
+- (instancetype)initWithWarmup:(NSUInteger)warmup {
+    if ((self=[super init])) {
+        _warmup = warmup;
+        _imageProcessing.reset(new LatencyHistogram(warmup));
+        _inference.reset(new LatencyHistogram(warmup));
+        _total.reset(new LatencyHistogram(warmup));
+        _skipped = 0;
+        _savedMicros = 0;
+    }
+    return self;
+}
+
+- (instancetype)init {
+    return [self initWithWarmup:0];
+}
+
+- (void)recordImageProcessingLatency:(double)imageProcessingLatency inferenceLatency:(double)inferenceLatency {
+    _imageProcessing->record(imageProcessingLatency);
+    _inference->record(inferenceLatency);
+    _total->record(imageProcessingLatency + inferenceLatency);
+}
+
+- (void)recordSkippedInferenceSavingLatency:(double)inferenceLatency {
+    _skipped.fetch_add(1, std::memory_order_relaxed);
+    _savedMicros.fetch_add((uint64_t)std::llround(MAX(inferenceLatency, 0) * 1000), std::memory_order_relaxed);
+}
+
+- (void)mergeCounter:(LatencyCounter*)counter {
+    _imageProcessing->merge(*counter->_imageProcessing);
+    _inference->merge(*counter->_inference);
+    _total->merge(*counter->_total);
+    _skipped.fetch_add(counter->_skipped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    _savedMicros.fetch_add(counter->_savedMicros.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+- (void)reset {
+    _imageProcessing->reset();
+    _inference->reset();
+    _total->reset();
+    _skipped = 0;
+    _savedMicros = 0;
+}
+
+// MARK: -
+
+- (double)lastImageProcessingLatency {
+    return _imageProcessing->last();
+}
+
+- (double)lastInferenceLatency {
+    return _inference->last();
+}
+
+- (NSUInteger)count {
+    return (NSUInteger)_total->count();
+}
+
+- (NSUInteger)skippedCount {
+    return (NSUInteger)_skipped.load(std::memory_order_relaxed);
+}
+
+- (double)skipRate {
+    const double skipped = (double)_skipped.load(std::memory_order_relaxed);
+    const double frames = skipped + (double)_total->count();
+    return frames == 0 ? 0 : skipped / frames;
+}
+
+- (double)savedInferenceLatency {
+    return (double)_savedMicros.load(std::memory_order_relaxed) / 1000;
+}
+
+- (double)averageImageProcessingLatency {
+    return _imageProcessing->mean();
+}
+
+- (double)averageInferenceLatency {
+    return _inference->mean();
+}
+
+- (double)averageTotalLatency {
+    return _total->mean();
+}
+
+- (LatencyStatistics*)imageProcessingStatistics {
+    return [[LatencyStatistics alloc] initWithSummary:_imageProcessing->summary()];
+}
+
+- (LatencyStatistics*)inferenceStatistics {
+    return [[LatencyStatistics alloc] initWithSummary:_inference->summary()];
+}
+
+- (LatencyStatistics*)totalStatistics {
+    return [[LatencyStatistics alloc] initWithSummary:_total->summary()];
+}
+
+// MARK: - States
+
+- (NSDictionary<NSString*,id>*)imageProcessingState {
+    return StateDictionary(*_imageProcessing);
+}
+
+- (NSDictionary<NSString*,id>*)inferenceState {
+    return StateDictionary(*_inference);
+}
+
+- (NSDictionary<NSString*,id>*)totalState {
+    return StateDictionary(*_total);
+}
+
+@end
+
+// MARK: - State Dictionaries
+
+// Matches the histogram states written by the command line runner's ModelSummary
+
+static NSDictionary<NSString*,id> *StateDictionary(const LatencyHistogram &histogram) {
+    LatencyHistogram::State state = histogram.state();
+    NSMutableArray<NSArray<NSNumber*>*> *buckets = [[NSMutableArray alloc] initWithCapacity:state.buckets.size()];
+    
+    for ( const auto &bucket : state.buckets ) {
+        [buckets addObject:@[@(bucket.first), @(bucket.second)]];
+    }
+    
+    return @{
+        @"min": @(state.minMicros),
+        @"max": @(state.maxMicros),
+        @"sum": @(state.sum),
+        @"sum_of_squares": @(state.sumOfSquares),
+        @"buckets": buckets.copy
+    };
+}
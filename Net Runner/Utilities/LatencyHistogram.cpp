@@ -0,0 +1,267 @@
+//
+//  LatencyHistogram.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace netrunner {
+
+namespace {
+
+const uint64_t kMaxMicros = (1ULL << LatencyHistogram::kMaxValueBits) - 1;
+
+void AtomicAdd(std::atomic<double> &target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while ( !target.compare_exchange_weak(current, current + value, std::memory_order_relaxed) ) {}
+}
+
+void AtomicMin(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while ( value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed) ) {}
+}
+
+void AtomicMax(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while ( value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed) ) {}
+}
+
+int HighestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+} // namespace
+
+LatencyHistogram::LatencyHistogram(uint64_t warmup) : _warmup(warmup) {
+    reset();
+}
+
+// Values below kSubBucketCount map one to one onto the first buckets. Above that, each power of
+// two range [2^n, 2^(n+1)) is split into kSubBucketHalfCount buckets of width 2^(n-kSubBucketBits+1).
+
+size_t LatencyHistogram::bucketIndex(uint64_t micros) {
+    micros = std::min(micros, kMaxMicros);
+
+    if ( micros < static_cast<uint64_t>(kSubBucketCount) ) {
+        return static_cast<size_t>(micros);
+    }
+
+    int shift = HighestBit(micros) - (kSubBucketBits - 1);
+    uint64_t subBucket = micros >> shift;
+
+    return kSubBucketCount + static_cast<size_t>(shift - 1) * kSubBucketHalfCount + static_cast<size_t>(subBucket - kSubBucketHalfCount);
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if ( index < static_cast<size_t>(kSubBucketCount) ) {
+        return index;
+    }
+
+    size_t offset = index - kSubBucketCount;
+    int shift = static_cast<int>(offset / kSubBucketHalfCount) + 1;
+    uint64_t subBucket = offset % kSubBucketHalfCount + kSubBucketHalfCount;
+
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(double milliseconds) {
+    uint64_t micros = milliseconds > 0 ? static_cast<uint64_t>(std::llround(std::min(milliseconds * 1000.0, static_cast<double>(kMaxMicros)))) : 0;
+
+    _lastMicros.store(micros, std::memory_order_relaxed);
+
+    if ( _seen.fetch_add(1, std::memory_order_relaxed) < _warmup ) {
+        return;
+    }
+
+    _counts[bucketIndex(micros)].fetch_add(1, std::memory_order_relaxed);
+    AtomicMin(_minMicros, micros);
+    AtomicMax(_maxMicros, micros);
+    AtomicAdd(_sum, milliseconds);
+    AtomicAdd(_sumOfSquares, milliseconds * milliseconds);
+    _count.fetch_add(1, std::memory_order_release);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    uint64_t count = other._count.load(std::memory_order_acquire);
+
+    if ( count == 0 ) {
+        return;
+    }
+
+    for ( size_t i = 0; i < kBucketCount; i++ ) {
+        uint64_t bucket = other._counts[i].load(std::memory_order_relaxed);
+        if ( bucket != 0 ) {
+            _counts[i].fetch_add(bucket, std::memory_order_relaxed);
+        }
+    }
+
+    AtomicMin(_minMicros, other._minMicros.load(std::memory_order_relaxed));
+    AtomicMax(_maxMicros, other._maxMicros.load(std::memory_order_relaxed));
+    AtomicAdd(_sum, other._sum.load(std::memory_order_relaxed));
+    AtomicAdd(_sumOfSquares, other._sumOfSquares.load(std::memory_order_relaxed));
+    _seen.fetch_add(count, std::memory_order_relaxed);
+    _count.fetch_add(count, std::memory_order_release);
+}
+
+bool LatencyHistogram::merge(const State &state) {
+    uint64_t count = 0;
+
+    for ( const auto &bucket : state.buckets ) {
+        if ( bucket.first >= kBucketCount ) {
+            return false;
+        }
+        count += bucket.second;
+    }
+
+    if ( count == 0 ) {
+        return true;
+    }
+
+    for ( const auto &bucket : state.buckets ) {
+        _counts[bucket.first].fetch_add(bucket.second, std::memory_order_relaxed);
+    }
+
+    AtomicMin(_minMicros, state.minMicros);
+    AtomicMax(_maxMicros, state.maxMicros);
+    AtomicAdd(_sum, state.sum);
+    AtomicAdd(_sumOfSquares, state.sumOfSquares);
+    _seen.fetch_add(count, std::memory_order_relaxed);
+    _count.fetch_add(count, std::memory_order_release);
+
+    return true;
+}
+
+LatencyHistogram::State LatencyHistogram::state() const {
+    State state;
+
+    if ( count() == 0 ) {
+        return state;
+    }
+
+    state.minMicros = _minMicros.load(std::memory_order_relaxed);
+    state.maxMicros = _maxMicros.load(std::memory_order_relaxed);
+    state.sum = _sum.load(std::memory_order_relaxed);
+    state.sumOfSquares = _sumOfSquares.load(std::memory_order_relaxed);
+
+    for ( size_t i = 0; i < kBucketCount; i++ ) {
+        uint64_t bucket = _counts[i].load(std::memory_order_relaxed);
+        if ( bucket != 0 ) {
+            state.buckets.push_back({static_cast<uint32_t>(i), bucket});
+        }
+    }
+
+    return state;
+}
+
+void LatencyHistogram::reset() {
+    for ( size_t i = 0; i < kBucketCount; i++ ) {
+        _counts[i].store(0, std::memory_order_relaxed);
+    }
+
+    _seen.store(0, std::memory_order_relaxed);
+    _minMicros.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    _maxMicros.store(0, std::memory_order_relaxed);
+    _lastMicros.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _sumOfSquares.store(0, std::memory_order_relaxed);
+    _count.store(0, std::memory_order_release);
+}
+
+uint64_t LatencyHistogram::count() const {
+    return _count.load(std::memory_order_acquire);
+}
+
+uint64_t LatencyHistogram::discarded() const {
+    return std::min(_seen.load(std::memory_order_relaxed), _warmup);
+}
+
+double LatencyHistogram::last() const {
+    return _lastMicros.load(std::memory_order_relaxed) / 1000.0;
+}
+
+double LatencyHistogram::min() const {
+    return count() == 0 ? 0 : _minMicros.load(std::memory_order_relaxed) / 1000.0;
+}
+
+double LatencyHistogram::max() const {
+    return _maxMicros.load(std::memory_order_relaxed) / 1000.0;
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t n = count();
+    return n == 0 ? 0 : _sum.load(std::memory_order_relaxed) / n;
+}
+
+double LatencyHistogram::stddev() const {
+    uint64_t n = count();
+
+    if ( n < 2 ) {
+        return 0;
+    }
+
+    double sum = _sum.load(std::memory_order_relaxed);
+    double sumOfSquares = _sumOfSquares.load(std::memory_order_relaxed);
+    double variance = (sumOfSquares - (sum * sum) / n) / (n - 1);
+
+    return variance > 0 ? std::sqrt(variance) : 0;
+}
+
+double LatencyHistogram::percentile(double percent) const {
+    uint64_t n = count();
+
+    if ( n == 0 ) {
+        return 0;
+    }
+
+    percent = std::max(0.0, std::min(100.0, percent));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percent / 100.0 * n)));
+    uint64_t cumulative = 0;
+
+    uint64_t minMicros = _minMicros.load(std::memory_order_relaxed);
+    uint64_t maxMicros = _maxMicros.load(std::memory_order_relaxed);
+
+    for ( size_t i = 0; i < kBucketCount; i++ ) {
+        cumulative += _counts[i].load(std::memory_order_relaxed);
+        if ( cumulative >= rank ) {
+            return std::max(minMicros, std::min(bucketUpperBound(i), maxMicros)) / 1000.0;
+        }
+    }
+
+    return maxMicros / 1000.0;
+}
+
+LatencyHistogram::Summary LatencyHistogram::summary() const {
+    Summary summary;
+
+    summary.count = count();
+    summary.mean = mean();
+    summary.stddev = stddev();
+    summary.min = min();
+    summary.p50 = percentile(50);
+    summary.p90 = percentile(90);
+    summary.p99 = percentile(99);
+    summary.max = max();
+
+    return summary;
+}
+
+} // namespace netrunner
@@ -0,0 +1,181 @@
+//
+//  LatencyHistogram.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef LatencyHistogram_h
+#define LatencyHistogram_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * A log-bucketed latency histogram in the style of HdrHistogram.
+ *
+ * Latencies are recorded in milliseconds and stored at microsecond resolution. Values are grouped
+ * into power-of-two ranges that are each split into 64 linear sub-buckets, so any reported
+ * percentile is within 1/64th (about 1.6%) of the recorded value, across a range of one
+ * microsecond to about twelve days, in a fixed 18 KB of counters.
+ *
+ * Recording is lock-free and wait-free apart from the running min, max and sums, which use
+ * compare-and-swap loops. Any number of threads may record into the same histogram, or each
+ * thread may record into its own and the histograms merged afterwards.
+ *
+ * The first `warmup` values recorded are counted but otherwise discarded, which excludes model
+ * load and first-inference effects from the distribution.
+ *
+ * Queries made while other threads are recording see a consistent-enough snapshot for display
+ * but may be off by the values recorded during the query.
+ */
+
+class LatencyHistogram {
+public:
+
+    /**
+     * The distribution at a point in time, in milliseconds.
+     */
+
+    struct Summary {
+        uint64_t count = 0;
+        double mean = 0;
+        double stddev = 0;
+        double min = 0;
+        double p50 = 0;
+        double p90 = 0;
+        double p99 = 0;
+        double max = 0;
+    };
+
+    /**
+     * The recorded values in a plain form that may be written out by one process and merged into
+     * a histogram in another. Only non-empty buckets are kept, as (index, count) pairs in index
+     * order. Extremes are in microseconds and sums in milliseconds, as they are recorded.
+     */
+
+    struct State {
+        uint64_t minMicros = 0;
+        uint64_t maxMicros = 0;
+        double sum = 0;
+        double sumOfSquares = 0;
+        std::vector<std::pair<uint32_t, uint64_t>> buckets;
+    };
+
+    explicit LatencyHistogram(uint64_t warmup = 0);
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * Records a latency in milliseconds. Negative values are recorded as zero.
+     */
+
+    void record(double milliseconds);
+
+    /**
+     * Adds the values recorded by another histogram to this one. The other histogram's warm-up
+     * values have already been discarded and are not counted again.
+     */
+
+    void merge(const LatencyHistogram &other);
+
+    /**
+     * Adds the values of an exported state to this histogram, as merging the histogram it was
+     * exported from would. Returns false, leaving this histogram unchanged, if a bucket index is
+     * out of range.
+     */
+
+    bool merge(const State &state);
+
+    /**
+     * The values recorded so far, see State.
+     */
+
+    State state() const;
+
+    /**
+     * Discards every recorded value and restarts the warm-up.
+     */
+
+    void reset();
+
+    /**
+     * The number of values in the distribution, excluding warm-up values.
+     */
+
+    uint64_t count() const;
+
+    /**
+     * The number of warm-up values that were discarded.
+     */
+
+    uint64_t discarded() const;
+
+    uint64_t warmup() const { return _warmup; }
+
+    /**
+     * The most recently recorded value, including warm-up values.
+     */
+
+    double last() const;
+
+    double min() const;
+    double max() const;
+    double mean() const;
+    double stddev() const;
+
+    /**
+     * The value at or below which the given percent of values fall, 0 through 100. Reports the
+     * upper bound of the bucket containing the percentile, clamped to the recorded range.
+     */
+
+    double percentile(double percent) const;
+
+    Summary summary() const;
+
+    // Bucket layout, exposed for testing
+
+    static const int kSubBucketBits = 7;
+    static const int kSubBucketCount = 1 << kSubBucketBits;
+    static const int kSubBucketHalfCount = kSubBucketCount / 2;
+    static const int kMaxValueBits = 40;
+    static const size_t kBucketCount = kSubBucketCount + (kMaxValueBits - kSubBucketBits) * kSubBucketHalfCount;
+
+    static size_t bucketIndex(uint64_t micros);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    const uint64_t _warmup;
+
+    std::atomic<uint64_t> _counts[kBucketCount];
+    std::atomic<uint64_t> _seen;
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _minMicros;
+    std::atomic<uint64_t> _maxMicros;
+    std::atomic<uint64_t> _lastMicros;
+    std::atomic<double> _sum;
+    std::atomic<double> _sumOfSquares;
+};
+
+} // namespace netrunner
+
+#endif /* LatencyHistogram_h */
@@ -0,0 +1,203 @@
+//
+//  MemorySampler.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "MemorySampler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+namespace netrunner {
+
+namespace {
+
+// Keeps the larger of the current and proposed values
+
+void StoreMax(std::atomic<uint64_t> &value, uint64_t proposed) {
+    uint64_t current = value.load(std::memory_order_relaxed);
+    while ( proposed > current && !value.compare_exchange_weak(current, proposed, std::memory_order_relaxed) ) {}
+}
+
+uint64_t CurrentFootprint() {
+    MemoryUsage usage;
+    return CurrentMemoryUsage(&usage) ? usage.footprint : 0;
+}
+
+} // namespace
+
+// MARK: - Backends
+
+#if defined(__APPLE__)
+
+bool CurrentMemoryUsage(MemoryUsage *usage) {
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+
+    if ( task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS ) {
+        return false;
+    }
+
+    usage->footprint = info.phys_footprint;
+    usage->resident = info.resident_size;
+    usage->peakResident = info.resident_size_peak;
+
+    return true;
+}
+
+#else
+
+bool CurrentMemoryUsage(MemoryUsage *usage) {
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+
+    if ( statm == nullptr ) {
+        return false;
+    }
+
+    unsigned long long size, resident, shared;
+    int fields = std::fscanf(statm, "%llu %llu %llu", &size, &resident, &shared);
+    std::fclose(statm);
+
+    if ( fields != 3 ) {
+        return false;
+    }
+
+    const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+    usage->resident = resident * pageSize;
+    usage->footprint = (resident - std::min(resident, shared)) * pageSize;
+
+    // ru_maxrss is in kilobytes on Linux
+
+    struct rusage rusage;
+
+    if ( getrusage(RUSAGE_SELF, &rusage) == 0 ) {
+        usage->peakResident = std::max(usage->resident, static_cast<uint64_t>(rusage.ru_maxrss) * 1024);
+    } else {
+        usage->peakResident = usage->resident;
+    }
+
+    return true;
+}
+
+#endif
+
+// MARK: - Scope
+
+MemorySampler::Scope::Scope() : _sampler(nullptr), _peak(0) {
+    _start = CurrentFootprint();
+    _peak.store(_start, std::memory_order_relaxed);
+}
+
+MemorySampler::Scope::Scope(MemorySampler &sampler) : _sampler(&sampler), _peak(0) {
+    _start = CurrentFootprint();
+    _peak.store(_start, std::memory_order_relaxed);
+    _sampler->add(this);
+}
+
+MemorySampler::Scope::~Scope() {
+    finish();
+}
+
+void MemorySampler::Scope::finish() {
+    if ( _finished ) {
+        return;
+    }
+
+    if ( _sampler != nullptr ) {
+        _sampler->remove(this);
+        _sampler = nullptr;
+    }
+
+    _finished = true;
+
+    _end = CurrentFootprint();
+    observe(_end);
+}
+
+void MemorySampler::Scope::observe(uint64_t footprint) {
+    StoreMax(_peak, footprint);
+}
+
+// MARK: - MemorySampler
+
+MemorySampler &MemorySampler::Shared() {
+    static MemorySampler *sampler = new MemorySampler();
+    return *sampler;
+}
+
+MemorySampler::MemorySampler(std::chrono::microseconds interval)
+    : _interval(interval), _samples(0), _stopping(false) {
+    _worker = std::thread([this] { run(); });
+}
+
+MemorySampler::~MemorySampler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        assert(_scopes.empty());
+        _stopping = true;
+    }
+    _condition.notify_one();
+    _worker.join();
+}
+
+void MemorySampler::add(Scope *scope) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _scopes.push_back(scope);
+    }
+    _condition.notify_one();
+}
+
+void MemorySampler::remove(Scope *scope) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _scopes.erase(std::remove(_scopes.begin(), _scopes.end(), scope), _scopes.end());
+}
+
+// Samples under the lock so that a scope cannot be removed, or see a sample taken before it was
+// added, while the sample is being distributed
+
+void MemorySampler::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while ( true ) {
+        _condition.wait(lock, [this] { return _stopping || !_scopes.empty(); });
+
+        if ( _stopping ) {
+            return;
+        }
+
+        uint64_t footprint = CurrentFootprint();
+        _samples.fetch_add(1, std::memory_order_relaxed);
+
+        for ( Scope *scope : _scopes ) {
+            scope->observe(footprint);
+        }
+
+        _condition.wait_for(lock, _interval, [this] { return _stopping; });
+    }
+}
+
+} // namespace netrunner
@@ -0,0 +1,184 @@
+//
+//  MemorySampler.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef MemorySampler_h
+#define MemorySampler_h
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * The process's memory use at a point in time, in bytes.
+ *
+ * `footprint` is the memory the system charges the process for: the physical footprint on Apple
+ * platforms, which is what iOS compares against an app's memory limit, and the private resident
+ * set on Linux, that is resident pages not shared with other processes. `resident` is the
+ * resident set size and `peakResident` its high water mark over the life of the process.
+ */
+
+struct MemoryUsage {
+    uint64_t footprint = 0;
+    uint64_t resident = 0;
+    uint64_t peakResident = 0;
+};
+
+/**
+ * Reads the process's current memory use, using Mach `task_info` on Apple platforms and
+ * `/proc/self/statm` with `getrusage` on Linux. Returns false if it cannot be read.
+ */
+
+bool CurrentMemoryUsage(MemoryUsage *usage);
+
+/**
+ * Samples the process's memory footprint on a background thread to find its peak over a region
+ * of code, such as preprocessing an input or running inference.
+ *
+ * A `MemorySampler::Scope` marks the region. The scope samples the footprint when it begins and
+ * ends, and the sampler samples it every `interval` in between, so allocations that are freed
+ * before the scope ends are still caught if they live at least as long as the interval. The
+ * sampler thread only runs while a scope is open.
+ *
+ * Sampling reads the footprint from another thread while the region runs, which perturbs code
+ * that is being timed. A scope made without a sampler only samples the footprint when it begins
+ * and ends, which costs nothing while it is open but misses transient peaks. Use these around
+ * timed regions, where the change in footprint across the region is what is wanted.
+ *
+ * The footprint is process wide. Scopes may overlap, across threads too, and each sees every
+ * sample taken while it is open, so the peak of a region is only attributable to that region
+ * when nothing else is running.
+ *
+ * Usage:
+ *
+ * @code
+ * MemorySampler::Scope scope(MemorySampler::Shared());
+ * DecodeImages();
+ * scope.finish();
+ * uint64_t growth = scope.peak() - scope.start();
+ * @endcode
+ */
+
+class MemorySampler {
+public:
+
+    class Scope {
+    public:
+
+        /**
+         * A scope that only samples the footprint when it begins and ends.
+         */
+
+        Scope();
+
+        explicit Scope(MemorySampler &sampler);
+
+        /**
+         * Finishes the scope if it has not been finished.
+         */
+
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * Takes a final sample and stops observing the sampler. Safe to call more than once.
+         */
+
+        void finish();
+
+        /**
+         * The footprint when the scope began and ended, and the largest footprint seen while it
+         * was open, in bytes. `end` is 0 until the scope is finished. Without a sampler the peak
+         * is the larger of the two.
+         */
+
+        uint64_t start() const { return _start; }
+        uint64_t end() const { return _end; }
+        uint64_t peak() const { return _peak.load(std::memory_order_relaxed); }
+
+        /**
+         * How far the footprint rose above its starting value while the scope was open.
+         */
+
+        uint64_t growth() const { return peak() > _start ? peak() - _start : 0; }
+
+    private:
+        friend class MemorySampler;
+
+        void observe(uint64_t footprint);
+
+        MemorySampler *_sampler;
+        bool _finished = false;
+        uint64_t _start = 0;
+        uint64_t _end = 0;
+        std::atomic<uint64_t> _peak;
+    };
+
+    /**
+     * A sampler shared by the app, sampling every millisecond.
+     */
+
+    static MemorySampler &Shared();
+
+    explicit MemorySampler(std::chrono::microseconds interval = std::chrono::milliseconds(1));
+
+    /**
+     * Stops and joins the sampler thread. Every scope must be finished first.
+     */
+
+    ~MemorySampler();
+
+    MemorySampler(const MemorySampler&) = delete;
+    MemorySampler& operator=(const MemorySampler&) = delete;
+
+    std::chrono::microseconds interval() const { return _interval; }
+
+    /**
+     * The number of samples taken by the sampler thread, excluding those taken by scopes.
+     */
+
+    uint64_t samples() const { return _samples.load(std::memory_order_relaxed); }
+
+private:
+    void add(Scope *scope);
+    void remove(Scope *scope);
+    void run();
+
+    const std::chrono::microseconds _interval;
+
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::vector<Scope*> _scopes;
+    std::atomic<uint64_t> _samples;
+    bool _stopping;
+
+    std::thread _worker;
+};
+
+} // namespace netrunner
+
+#endif /* MemorySampler_h */
@@ -0,0 +1,195 @@
+//
+//  MotionGate.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "MotionGate.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NETRUNNER_MOTION_GATE_NEON 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NETRUNNER_MOTION_GATE_SSE2 1
+#endif
+
+namespace netrunner {
+
+constexpr size_t MotionGate::kThumbnailSide;
+constexpr size_t MotionGate::kThumbnailSize;
+
+namespace {
+
+constexpr size_t kBytesPerPixel = 4;
+
+// A column accumulates one byte per row, so it may take this many rows before it must be folded
+// into the block sums to avoid overflowing
+
+constexpr size_t kMaxAccumulatedRows = 257;
+
+// columns[i] += row[i]
+
+void AccumulateRow(uint16_t *columns, const uint8_t *row, size_t count) {
+    size_t i = 0;
+
+#if NETRUNNER_MOTION_GATE_NEON
+    for ( ; i + 16 <= count; i += 16 ) {
+        uint8x16_t bytes = vld1q_u8(row + i);
+        vst1q_u16(columns + i, vaddw_u8(vld1q_u16(columns + i), vget_low_u8(bytes)));
+        vst1q_u16(columns + i + 8, vaddw_u8(vld1q_u16(columns + i + 8), vget_high_u8(bytes)));
+    }
+#elif NETRUNNER_MOTION_GATE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for ( ; i + 16 <= count; i += 16 ) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + i));
+        __m128i *low = reinterpret_cast<__m128i*>(columns + i);
+        __m128i *high = reinterpret_cast<__m128i*>(columns + i + 8);
+        _mm_storeu_si128(low, _mm_add_epi16(_mm_loadu_si128(low), _mm_unpacklo_epi8(bytes, zero)));
+        _mm_storeu_si128(high, _mm_add_epi16(_mm_loadu_si128(high), _mm_unpackhi_epi8(bytes, zero)));
+    }
+#endif
+
+    for ( ; i < count; i++ ) {
+        columns[i] += row[i];
+    }
+}
+
+// Adds each block's share of the column sums to its total and clears the columns
+
+void FoldColumns(uint16_t *columns, size_t width, uint32_t *sums) {
+    for ( size_t x = 0; x < MotionGate::kThumbnailSide; x++ ) {
+        size_t begin = x * width / MotionGate::kThumbnailSide * kBytesPerPixel;
+        size_t end = (x + 1) * width / MotionGate::kThumbnailSide * kBytesPerPixel;
+        uint32_t sum = 0;
+        for ( size_t i = begin; i < end; i++ ) {
+            sum += columns[i];
+        }
+        sums[x] += sum;
+    }
+    std::memset(columns, 0, width * kBytesPerPixel * sizeof(uint16_t));
+}
+
+} // namespace
+
+MotionGate::MotionGate() : MotionGate(Options()) {}
+
+MotionGate::MotionGate(const Options &options)
+    : _options(options), _thumbnail(kThumbnailSize), _reference(kThumbnailSize) {}
+
+bool MotionGate::shouldRun(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, Clock::time_point now) {
+    _statistics.frames += 1;
+
+    if ( width < kThumbnailSide || height < kThumbnailSide ) {
+        _lastChange = 1;
+        return true;
+    }
+
+    Thumbnail(pixels, width, height, bytesPerRow, _thumbnail.data());
+
+    if ( _hasReference ) {
+        uint64_t difference = SumOfAbsoluteDifferences(_thumbnail.data(), _reference.data(), kThumbnailSize);
+        _lastChange = static_cast<double>(difference) / (255.0 * kThumbnailSize);
+    } else {
+        _lastChange = 1;
+    }
+
+    if ( _hasReference && _lastChange < _options.threshold && now - _referenceTime < _options.refreshInterval ) {
+        _statistics.skipped += 1;
+        return false;
+    }
+
+    _reference.swap(_thumbnail);
+    _referenceTime = now;
+    _hasReference = true;
+    return true;
+}
+
+void MotionGate::reset() {
+    _hasReference = false;
+    _lastChange = 1;
+}
+
+// MARK: - Kernels
+
+void MotionGate::Thumbnail(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, uint8_t *thumbnail) {
+    assert(width >= kThumbnailSide && height >= kThumbnailSide);
+
+    const size_t rowBytes = width * kBytesPerPixel;
+    std::vector<uint16_t> columns(rowBytes, 0);
+    uint32_t sums[kThumbnailSide];
+
+    for ( size_t y = 0; y < kThumbnailSide; y++ ) {
+        size_t top = y * height / kThumbnailSide;
+        size_t bottom = (y + 1) * height / kThumbnailSide;
+        size_t accumulated = 0;
+
+        std::fill(sums, sums + kThumbnailSide, 0);
+
+        for ( size_t row = top; row < bottom; row++ ) {
+            AccumulateRow(columns.data(), pixels + row * bytesPerRow, rowBytes);
+            if ( ++accumulated == kMaxAccumulatedRows ) {
+                FoldColumns(columns.data(), width, sums);
+                accumulated = 0;
+            }
+        }
+
+        FoldColumns(columns.data(), width, sums);
+
+        for ( size_t x = 0; x < kThumbnailSide; x++ ) {
+            size_t blockWidth = (x + 1) * width / kThumbnailSide - x * width / kThumbnailSide;
+            size_t count = blockWidth * (bottom - top) * kBytesPerPixel;
+            thumbnail[y * kThumbnailSide + x] = static_cast<uint8_t>((sums[x] + count / 2) / count);
+        }
+    }
+}
+
+uint64_t MotionGate::SumOfAbsoluteDifferences(const uint8_t *a, const uint8_t *b, size_t count) {
+    uint64_t sum = 0;
+    size_t i = 0;
+
+#if NETRUNNER_MOTION_GATE_NEON
+    uint64x2_t accumulator = vdupq_n_u64(0);
+    for ( ; i + 16 <= count; i += 16 ) {
+        uint8x16_t difference = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        accumulator = vpadalq_u32(accumulator, vpaddlq_u16(vpaddlq_u8(difference)));
+    }
+    sum = vgetq_lane_u64(accumulator, 0) + vgetq_lane_u64(accumulator, 1);
+#elif NETRUNNER_MOTION_GATE_SSE2
+    __m128i accumulator = _mm_setzero_si128();
+    for ( ; i + 16 <= count; i += 16 ) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        accumulator = _mm_add_epi64(accumulator, _mm_sad_epu8(x, y));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), accumulator);
+    sum = lanes[0] + lanes[1];
+#endif
+
+    for ( ; i < count; i++ ) {
+        sum += a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+    }
+
+    return sum;
+}
+
+} // namespace netrunner
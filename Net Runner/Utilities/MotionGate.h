@@ -0,0 +1,140 @@
+//
+//  MotionGate.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef MotionGate_h
+#define MotionGate_h
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * A cheap change detector that decides whether a live frame differs enough from the last frame
+ * the model ran on to be worth running again.
+ *
+ * Each frame is reduced to a 32x32 thumbnail of block averages and compared to the thumbnail of
+ * the last frame that was run by their mean absolute difference, normalized to [0,1]. Frames
+ * whose change is below the threshold are skipped, and their results may reuse the last output.
+ * The reference is only replaced when a frame runs, so a slow drift still adds up to a change,
+ * and a frame is always run once the refresh interval has passed since the last one.
+ *
+ * Frames are four byte pixels, such as BGRA or ARGB, and every byte of a pixel is averaged into
+ * its block, including alpha. A constant alpha channel only scales the change by a fixed factor.
+ *
+ * The thumbnail and difference kernels use NEON on ARM and SSE2 on x86, with a scalar fallback,
+ * and are meant to be run on the model's already downscaled input rather than on camera frames.
+ *
+ * A gate is not thread safe and should be used from one thread.
+ */
+
+class MotionGate {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t kThumbnailSide = 32;
+    static constexpr size_t kThumbnailSize = kThumbnailSide * kThumbnailSide;
+
+    struct Options {
+
+        /**
+         * Frames whose change is below the threshold are skipped.
+         */
+
+        double threshold = 0.01;
+
+        /**
+         * The longest time a frame may be skipped after the last frame that ran.
+         */
+
+        Clock::duration refreshInterval = std::chrono::seconds(1);
+    };
+
+    struct Statistics {
+        uint64_t frames = 0;
+        uint64_t skipped = 0;
+
+        double skipRate() const {
+            return frames == 0 ? 0 : static_cast<double>(skipped) / static_cast<double>(frames);
+        }
+    };
+
+    MotionGate();
+    explicit MotionGate(const Options &options);
+
+    /**
+     * Returns true if the frame should be run, in which case it becomes the reference for later
+     * frames, or false if it may be skipped. Frames smaller than the thumbnail are always run.
+     *
+     * @param pixels The first row of four byte pixels.
+     * @param bytesPerRow The row stride, which may include padding.
+     * @param now The time of the frame, against which the refresh interval is measured.
+     */
+
+    bool shouldRun(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, Clock::time_point now = Clock::now());
+
+    /**
+     * The change of the last frame passed to `shouldRun`, 1 if it had no reference.
+     */
+
+    double lastChange() const { return _lastChange; }
+
+    Statistics statistics() const { return _statistics; }
+
+    const Options &options() const { return _options; }
+
+    /**
+     * Forgets the reference so that the next frame runs.
+     */
+
+    void reset();
+
+    // MARK: - Kernels
+
+    /**
+     * Reduces four byte pixels to a `kThumbnailSide` square thumbnail of block averages. Blocks
+     * cover the whole frame and differ in size by at most one pixel. The frame must be at least
+     * `kThumbnailSide` pixels on a side.
+     */
+
+    static void Thumbnail(const uint8_t *pixels, size_t width, size_t height, size_t bytesPerRow, uint8_t *thumbnail);
+
+    /**
+     * The sum of the absolute differences of two byte arrays.
+     */
+
+    static uint64_t SumOfAbsoluteDifferences(const uint8_t *a, const uint8_t *b, size_t count);
+
+private:
+    Options _options;
+    Statistics _statistics;
+
+    std::vector<uint8_t> _thumbnail;
+    std::vector<uint8_t> _reference;
+    Clock::time_point _referenceTime;
+    bool _hasReference = false;
+    double _lastChange = 1;
+};
+
+} // namespace netrunner
+
+#endif /* MotionGate_h */
@@ -0,0 +1,157 @@
+//
+//  ResultsCheckpoint.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ResultsCheckpoint.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "ContentHash.h"
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+} // namespace
+
+std::string ResultsCheckpoint::UnitKey(uint64_t model, uint64_t input, uint64_t iteration, uint64_t options) {
+    return ContentHash().update(model).update(input).update(iteration).update(options).hex();
+}
+
+uint64_t ResultsCheckpoint::ModelFingerprint(const std::string &identifier, const std::string &version, const std::string &modelPath) {
+    ContentHash hash;
+    hash.update(identifier).update(version);
+
+    uint64_t contents;
+
+    if ( !modelPath.empty() && ContentHash::File(modelPath, &contents, nullptr) ) {
+        hash.update(contents);
+    }
+
+    return hash.value();
+}
+
+bool ResultsCheckpoint::ReadResults(const std::string &path, const LineHandler &handler, size_t *discarded, std::string *error) {
+    if ( discarded ) {
+        *discarded = 0;
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR);
+
+    if ( fd < 0 && errno == ENOENT ) {
+        return true;
+    }
+    if ( fd < 0 ) {
+        SetError(error, "Unable to open results file at " + path + ": " + std::strerror(errno));
+        return false;
+    }
+
+    std::string line;
+    char buffer[64 * 1024];
+    off_t complete = 0;
+    off_t offset = 0;
+
+    while ( true ) {
+        ssize_t count = ::read(fd, buffer, sizeof(buffer));
+
+        if ( count < 0 && errno == EINTR ) {
+            continue;
+        }
+        if ( count < 0 ) {
+            SetError(error, "Unable to read results file at " + path + ": " + std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+        if ( count == 0 ) {
+            break;
+        }
+
+        const char *start = buffer;
+        const char *end = buffer + count;
+
+        while ( start < end ) {
+            const char *newline = static_cast<const char*>(std::memchr(start, '\n', static_cast<size_t>(end - start)));
+
+            if ( newline == nullptr ) {
+                line.append(start, end);
+                break;
+            }
+
+            line.append(start, newline);
+            complete = offset + (newline - buffer) + 1;
+
+            if ( !line.empty() ) {
+                handler(line);
+            }
+
+            line.clear();
+            start = newline + 1;
+        }
+
+        offset += count;
+    }
+
+    // Anything after the last newline is a partial record
+
+    if ( offset > complete ) {
+        if ( ftruncate(fd, complete) != 0 ) {
+            SetError(error, "Unable to truncate results file at " + path + ": " + std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+        if ( discarded ) {
+            *discarded = static_cast<size_t>(offset - complete);
+        }
+    }
+
+    ::close(fd);
+    return true;
+}
+
+void ResultsCheckpoint::expect(const std::string &unit) {
+    _units.emplace(unit, false);
+}
+
+bool ResultsCheckpoint::complete(const std::string &unit) {
+    auto entry = _units.find(unit);
+
+    if ( entry == _units.end() || entry->second ) {
+        return false;
+    }
+
+    entry->second = true;
+    _completed += 1;
+    return true;
+}
+
+bool ResultsCheckpoint::isComplete(const std::string &unit) const {
+    auto entry = _units.find(unit);
+    return entry != _units.end() && entry->second;
+}
+
+} // namespace netrunner
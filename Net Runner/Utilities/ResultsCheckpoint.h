@@ -0,0 +1,100 @@
+//
+//  ResultsCheckpoint.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ResultsCheckpoint_h
+#define ResultsCheckpoint_h
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace netrunner {
+
+/**
+ * Tracks which units of an evaluation run have already completed so that an interrupted run may
+ * be resumed from its JSON Lines results file rather than started over.
+ *
+ * A unit is a single evaluation, identified by a key derived from the model's fingerprint, the
+ * content hash of the input, the iteration and a fingerprint of the options that affect results.
+ * Each result record carries its unit key, so the results file is the checkpoint: nothing else
+ * needs to be written or kept in sync with it.
+ *
+ * To resume, the runner declares every unit it expects with `expect`, then reads the results file
+ * with `ReadResults` and calls `complete` with the unit of each record. `complete` returns true
+ * the first time an expected unit is seen, in which case the record should be folded back into
+ * the run's summary. Records for units that are no longer expected, because a model or an input
+ * changed, are ignored, so only the changed units are evaluated again.
+ */
+
+class ResultsCheckpoint {
+public:
+    using LineHandler = std::function<void(const std::string &line)>;
+
+    /**
+     * The key of a unit, 16 hexadecimal digits.
+     */
+
+    static std::string UnitKey(uint64_t model, uint64_t input, uint64_t iteration, uint64_t options);
+
+    /**
+     * Identifies a model by its identifier, version and the contents of its model file, so that
+     * a retrained model is evaluated again even if its version was not changed. The model file
+     * is skipped if it cannot be read, e.g. for placeholder models.
+     */
+
+    static uint64_t ModelFingerprint(const std::string &identifier, const std::string &version, const std::string &modelPath);
+
+    /**
+     * Reads the JSON Lines results file at path, calling handler with each complete line. A final
+     * line without a newline was torn by an interrupted write and is truncated from the file, so
+     * that subsequent appends begin on a new line. A missing file is empty, not an error.
+     *
+     * @param discarded Set to the number of bytes truncated, may be nullptr.
+     */
+
+    static bool ReadResults(const std::string &path, const LineHandler &handler, size_t *discarded, std::string *error);
+
+    /**
+     * Declares a unit of the current run.
+     */
+
+    void expect(const std::string &unit);
+
+    /**
+     * Marks an expected unit complete. Returns false if the unit is not expected or has already
+     * been completed.
+     */
+
+    bool complete(const std::string &unit);
+
+    bool isComplete(const std::string &unit) const;
+
+    size_t expectedCount() const { return _units.size(); }
+    size_t completedCount() const { return _completed; }
+
+private:
+    std::unordered_map<std::string, bool> _units;
+    size_t _completed = 0;
+};
+
+} // namespace netrunner
+
+#endif /* ResultsCheckpoint_h */
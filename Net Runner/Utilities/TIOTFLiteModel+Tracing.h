@@ -0,0 +1,46 @@
+//
+//  TIOTFLiteModel+Tracing.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+@import Foundation;
+@import TensorIO;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Splits a TensorFlow Lite model's `runOn:` into its stages in a trace: copying the input into
+ * the input tensor, invoking the interpreter and capturing the outputs. See Tracer.h.
+ *
+ * TensorIO is not instrumented itself, so its private stage methods are wrapped with trace
+ * scopes at runtime instead. The wrappers cost a relaxed atomic load per stage while tracing is
+ * off.
+ */
+
+@interface TIOTFLiteModel (Tracing)
+
+/**
+ * Wraps the stage methods. Safe to call more than once, only the first call has an effect.
+ * Logs and leaves a stage untraced if TensorIO no longer implements it.
+ */
+
++ (void)installTracing;
+
+@end
+
+NS_ASSUME_NONNULL_END
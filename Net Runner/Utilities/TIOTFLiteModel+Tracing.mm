@@ -0,0 +1,86 @@
+//
+//  TIOTFLiteModel+Tracing.mm
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#import "TIOTFLiteModel+Tracing.h"
+
+#include "Tracer.h"
+
+#import <objc/runtime.h>
+
+using netrunner::Tracer;
+
+@implementation TIOTFLiteModel (Tracing)
+
++ (void)installTracing {
+    static dispatch_once_t once;
+    dispatch_once(&once, ^{
+    
+    // Copying the input into the input tensor, including any normalization
+    
+    Method prepareInput = class_getInstanceMethod(self, NSSelectorFromString(@"_prepareInput:"));
+    
+    if ( prepareInput != NULL ) {
+        typedef void (*PrepareInputIMP)(id, SEL, id<TIOData>);
+        PrepareInputIMP original = (PrepareInputIMP)method_getImplementation(prepareInput);
+        SEL selector = method_getName(prepareInput);
+        method_setImplementation(prepareInput, imp_implementationWithBlock(^(id model, id<TIOData> input) {
+            Tracer::Scope scope("tensor copy", "inference");
+            original(model, selector, input);
+        }));
+    } else {
+        NSLog(@"Unable to trace TIOTFLiteModel input preparation, the method is missing");
+    }
+    
+    // Invoking the interpreter
+    
+    Method runInference = class_getInstanceMethod(self, NSSelectorFromString(@"_runInference"));
+    
+    if ( runInference != NULL ) {
+        typedef void (*RunInferenceIMP)(id, SEL);
+        RunInferenceIMP original = (RunInferenceIMP)method_getImplementation(runInference);
+        SEL selector = method_getName(runInference);
+        method_setImplementation(runInference, imp_implementationWithBlock(^(id model) {
+            Tracer::Scope scope("invoke", "inference");
+            original(model, selector);
+        }));
+    } else {
+        NSLog(@"Unable to trace TIOTFLiteModel inference, the method is missing");
+    }
+    
+    // Copying the output tensors into TIOData objects
+    
+    Method captureOutput = class_getInstanceMethod(self, NSSelectorFromString(@"_captureOutput"));
+    
+    if ( captureOutput != NULL ) {
+        typedef id (*CaptureOutputIMP)(id, SEL);
+        CaptureOutputIMP original = (CaptureOutputIMP)method_getImplementation(captureOutput);
+        SEL selector = method_getName(captureOutput);
+        method_setImplementation(captureOutput, imp_implementationWithBlock(^id(id model) {
+            Tracer::Scope scope("output capture", "inference");
+            return original(model, selector);
+        }));
+    } else {
+        NSLog(@"Unable to trace TIOTFLiteModel output capture, the method is missing");
+    }
+    
+    }); // dispatch_once
+}
+
+@end
@@ -0,0 +1,266 @@
+//
+//  Tracer.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "Tracer.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace netrunner {
+
+namespace {
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+// Distinguishes tracers in each thread's buffer cache, even one allocated at the address of a
+// tracer that has since been destroyed
+
+std::atomic<uint64_t> NextTracerIdentifier(1);
+
+void AppendEscaped(std::ostringstream &stream, const char *string) {
+    stream << '"';
+    for ( const char *c = string; *c != '\0'; c++ ) {
+        switch ( *c ) {
+        case '"': stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        case '\t': stream << "\\t"; break;
+        default:
+            if ( static_cast<unsigned char>(*c) < 0x20 ) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", *c);
+                stream << escaped;
+            } else {
+                stream << *c;
+            }
+        }
+    }
+    stream << '"';
+}
+
+// Chrome trace timestamps are in microseconds, fractions are allowed
+
+void AppendMicroseconds(std::ostringstream &stream, uint64_t nanoseconds) {
+    char string[32];
+    std::snprintf(string, sizeof(string), "%llu.%03llu", static_cast<unsigned long long>(nanoseconds / 1000), static_cast<unsigned long long>(nanoseconds % 1000));
+    stream << string;
+}
+
+} // namespace
+
+// MARK: - Scope
+
+Tracer::Scope::Scope(const char *name, const char *category)
+    : Scope(Tracer::Shared(), name, category) {}
+
+Tracer::Scope::Scope(Tracer &tracer, const char *name, const char *category)
+    : _tracer(tracer.enabled() ? &tracer : nullptr), _name(name), _category(category) {
+    if ( _tracer ) {
+        _start = _tracer->now();
+    }
+}
+
+void Tracer::Scope::finish() {
+    if ( _tracer == nullptr ) {
+        return;
+    }
+
+    _tracer->record(_name, _category, _start, _tracer->now());
+    _tracer = nullptr;
+}
+
+// MARK: - Tracer
+
+Tracer &Tracer::Shared() {
+    static Tracer *shared = new Tracer();
+    return *shared;
+}
+
+Tracer::Tracer(size_t capacity)
+    : _capacity(capacity > 0 ? capacity : 1),
+      _identifier(NextTracerIdentifier.fetch_add(1)),
+      _epoch(std::chrono::steady_clock::now()),
+      _enabled(false) {}
+
+uint64_t Tracer::now() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _epoch).count());
+}
+
+// Each thread caches its buffer for every tracer it has recorded into, usually just the shared
+// one, so only a thread's first span takes the tracer's lock
+
+Tracer::ThreadBuffer *Tracer::threadBuffer() {
+    thread_local std::vector<std::pair<uint64_t, ThreadBuffer*>> cache;
+
+    for ( const auto &entry : cache ) {
+        if ( entry.first == _identifier ) {
+            return entry.second;
+        }
+    }
+
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    buffer->events.resize(_capacity);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    buffer->index = _buffers.size();
+    buffer->name = "Thread " + std::to_string(buffer->index + 1);
+    _buffers.push_back(std::move(buffer));
+
+    cache.emplace_back(_identifier, _buffers.back().get());
+    return _buffers.back().get();
+}
+
+void Tracer::record(const char *name, const char *category, uint64_t start, uint64_t end) {
+    ThreadBuffer *buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+
+    Event &event = buffer->events[buffer->written % _capacity];
+    event.name = name;
+    event.category = category;
+    event.start = start;
+    event.duration = end > start ? end - start : 0;
+
+    buffer->written += 1;
+}
+
+void Tracer::setThreadName(const std::string &name) {
+    ThreadBuffer *buffer = threadBuffer();
+    std::lock_guard<std::mutex> lock(buffer->mutex);
+    buffer->name = name;
+}
+
+const char *Tracer::intern(const std::string &string) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _strings.insert(string).first->c_str();
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for ( const std::unique_ptr<ThreadBuffer> &buffer : _buffers ) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->written = 0;
+    }
+}
+
+std::vector<std::pair<size_t, Tracer::Event>> Tracer::events() const {
+    std::vector<std::pair<size_t, Event>> events;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for ( const std::unique_ptr<ThreadBuffer> &buffer : _buffers ) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        uint64_t first = buffer->written > _capacity ? buffer->written - _capacity : 0;
+
+        for ( uint64_t i = first; i < buffer->written; i++ ) {
+            events.emplace_back(buffer->index, buffer->events[i % _capacity]);
+        }
+    }
+
+    return events;
+}
+
+uint64_t Tracer::dropped() const {
+    uint64_t dropped = 0;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    for ( const std::unique_ptr<ThreadBuffer> &buffer : _buffers ) {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        dropped += buffer->written > _capacity ? buffer->written - _capacity : 0;
+    }
+
+    return dropped;
+}
+
+// MARK: - Export
+
+std::string Tracer::json() const {
+    std::vector<std::pair<size_t, Event>> events = this->events();
+    std::vector<std::string> names;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for ( const std::unique_ptr<ThreadBuffer> &buffer : _buffers ) {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            names.push_back(buffer->name);
+        }
+    }
+
+    const int pid = static_cast<int>(getpid());
+    std::ostringstream stream;
+
+    stream << "{\"traceEvents\":[\n";
+
+    // Thread names, as metadata events
+
+    for ( size_t index = 0; index < names.size(); index++ ) {
+        stream << (index == 0 ? "" : ",\n");
+        stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << index + 1 << ",\"args\":{\"name\":";
+        AppendEscaped(stream, names[index].c_str());
+        stream << "}}";
+    }
+
+    // Spans, as complete events
+
+    for ( const auto &entry : events ) {
+        const Event &event = entry.second;
+
+        stream << ",\n{\"name\":";
+        AppendEscaped(stream, event.name);
+        stream << ",\"cat\":";
+        AppendEscaped(stream, event.category);
+        stream << ",\"ph\":\"X\",\"ts\":";
+        AppendMicroseconds(stream, event.start);
+        stream << ",\"dur\":";
+        AppendMicroseconds(stream, event.duration);
+        stream << ",\"pid\":" << pid << ",\"tid\":" << entry.first + 1 << "}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped_events\":" << dropped() << "}}\n";
+
+    return stream.str();
+}
+
+bool Tracer::write(const std::string &path, std::string *error) const {
+    std::ofstream file(path);
+
+    if ( !file ) {
+        SetError(error, "Unable to open trace file at " + path + ": " + std::strerror(errno));
+        return false;
+    }
+
+    file << json();
+
+    if ( !file ) {
+        SetError(error, "Unable to write trace file at " + path);
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace netrunner
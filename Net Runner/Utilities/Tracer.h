@@ -0,0 +1,212 @@
+//
+//  Tracer.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef Tracer_h
+#define Tracer_h
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace netrunner {
+
+/**
+ * Records the stages of an evaluation as timed spans and exports them as a Chrome Trace Event
+ * JSON file, which chrome://tracing, Perfetto (ui.perfetto.dev) and Speedscope can open.
+ *
+ * Each thread records into its own fixed size ring buffer, so recording never allocates after a
+ * thread's first span and never contends with other threads. When a buffer is full its oldest
+ * spans are overwritten and counted as dropped. Buffers outlive their threads, so the spans of
+ * short lived dispatch threads are still exported.
+ *
+ * Tracing is off until enabled and may be switched on and off at runtime. A `Tracer::Scope`
+ * created while tracing is off costs a single relaxed atomic load and records nothing.
+ *
+ * Span names and categories are not copied and must outlive the tracer: string literals, or
+ * strings returned by `intern`.
+ *
+ * Usage:
+ *
+ * @code
+ * Tracer::Shared().setEnabled(true);
+ *
+ * {
+ *     Tracer::Scope scope("invoke", "inference");
+ *     interpreter->Invoke();
+ * }
+ *
+ * Tracer::Shared().write("evaluation.trace.json", &error);
+ * @endcode
+ */
+
+class Tracer {
+public:
+
+    /**
+     * A completed span. Times are in nanoseconds since the tracer was created.
+     */
+
+    struct Event {
+        const char *name = nullptr;
+        const char *category = nullptr;
+        uint64_t start = 0;
+        uint64_t duration = 0;
+    };
+
+    /**
+     * Records a span from its construction until it is finished or destroyed, on the thread
+     * that constructed it.
+     */
+
+    class Scope {
+    public:
+        Scope(const char *name, const char *category);
+        Scope(Tracer &tracer, const char *name, const char *category);
+
+        /**
+         * Finishes the scope if it has not been finished.
+         */
+
+        ~Scope() { finish(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * Records the span. Safe to call more than once.
+         */
+
+        void finish();
+
+    private:
+        Tracer *_tracer;
+        const char *_name;
+        const char *_category;
+        uint64_t _start = 0;
+    };
+
+    /**
+     * A tracer shared by the app, with room for 8192 spans per thread.
+     */
+
+    static Tracer &Shared();
+
+    explicit Tracer(size_t capacity = 8192);
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    bool enabled() const { return _enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+
+    /**
+     * The number of spans each thread's buffer holds.
+     */
+
+    size_t capacity() const { return _capacity; }
+
+    /**
+     * Nanoseconds since the tracer was created, on the steady clock.
+     */
+
+    uint64_t now() const;
+
+    /**
+     * Records a span on the calling thread. `Scope` is usually more convenient.
+     */
+
+    void record(const char *name, const char *category, uint64_t start, uint64_t end);
+
+    /**
+     * Names the calling thread in the exported trace, e.g. after the model it evaluates.
+     */
+
+    void setThreadName(const std::string &name);
+
+    /**
+     * Returns a copy of the string that lives as long as the tracer, for span names that are
+     * only known at runtime, such as a model's identifier. Takes the tracer's lock, so prefer
+     * interning a name once to interning it for every span.
+     */
+
+    const char *intern(const std::string &string);
+
+    /**
+     * Discards every recorded span, e.g. between runs. Thread names are kept.
+     */
+
+    void clear();
+
+    /**
+     * The spans recorded by every thread, oldest first within each thread, paired with the
+     * index of the thread that recorded them.
+     */
+
+    std::vector<std::pair<size_t, Event>> events() const;
+
+    /**
+     * The number of spans overwritten because a thread's buffer was full.
+     */
+
+    uint64_t dropped() const;
+
+    /**
+     * The recorded spans as a Chrome Trace Event JSON object of complete ("X") events, with
+     * thread name metadata and the number of dropped spans under "otherData".
+     */
+
+    std::string json() const;
+
+    /**
+     * Writes the JSON trace to a file. Returns false and sets error if it cannot be written.
+     */
+
+    bool write(const std::string &path, std::string *error) const;
+
+private:
+    struct ThreadBuffer {
+        size_t index = 0;
+        std::string name;
+        std::vector<Event> events;
+        uint64_t written = 0;
+        std::mutex mutex;
+    };
+
+    ThreadBuffer *threadBuffer();
+
+    const size_t _capacity;
+    const uint64_t _identifier;
+    const std::chrono::steady_clock::time_point _epoch;
+    std::atomic<bool> _enabled;
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+    std::unordered_set<std::string> _strings;
+};
+
+} // namespace netrunner
+
+#endif /* Tracer_h */
@@ -0,0 +1,356 @@
+//
+//  ZipWriter.cpp
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#include "ZipWriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <zlib.h>
+
+namespace netrunner {
+
+namespace {
+
+const uint32_t kLocalHeaderSignature = 0x04034b50;
+const uint32_t kCentralHeaderSignature = 0x02014b50;
+const uint32_t kEndSignature = 0x06054b50;
+const uint32_t kZip64EndSignature = 0x06064b50;
+const uint32_t kZip64LocatorSignature = 0x07064b50;
+
+const uint16_t kStored = 0;
+const uint16_t kDeflated = 8;
+const uint16_t kUTF8Flag = 0x0800;
+const uint16_t kVersion = 20;
+const uint16_t kZip64Version = 45;
+const uint16_t kMadeByUnix = 3 << 8;
+
+const uint32_t kMax32 = 0xFFFFFFFF;
+const uint16_t kMax16 = 0xFFFF;
+
+void SetError(std::string *error, const std::string &message) {
+    if ( error ) {
+        *error = message;
+    }
+}
+
+std::string ErrnoDescription(const std::string &message) {
+    return message + ": " + std::strerror(errno);
+}
+
+// Zip fields are little-endian regardless of the host
+
+void Put16(std::vector<uint8_t> &bytes, uint16_t value) {
+    bytes.push_back(static_cast<uint8_t>(value));
+    bytes.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void Put32(std::vector<uint8_t> &bytes, uint32_t value) {
+    Put16(bytes, static_cast<uint16_t>(value));
+    Put16(bytes, static_cast<uint16_t>(value >> 16));
+}
+
+void Put64(std::vector<uint8_t> &bytes, uint64_t value) {
+    Put32(bytes, static_cast<uint32_t>(value));
+    Put32(bytes, static_cast<uint32_t>(value >> 32));
+}
+
+uint32_t Crc(uint32_t crc, const void *data, size_t length) {
+    const Bytef *bytes = static_cast<const Bytef*>(data);
+
+    // zlib takes 32 bit lengths
+
+    while ( length > 0 ) {
+        uInt chunk = static_cast<uInt>(std::min<size_t>(length, 1u << 30));
+        crc = static_cast<uint32_t>(crc32(crc, bytes, chunk));
+        bytes += chunk;
+        length -= chunk;
+    }
+
+    return crc;
+}
+
+} // namespace
+
+// MARK: - Deflated Entries
+
+DeflatedEntry::DeflatedEntry(int level)
+    : _stream(new z_stream_s()), _crc(0), _uncompressedSize(0), _finished(false), _failed(false) {
+    // Raw deflate, without a zlib header, as zip expects
+
+    if ( deflateInit2(_stream.get(), level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK ) {
+        _finished = true;
+        _failed = true;
+    }
+}
+
+DeflatedEntry::~DeflatedEntry() {
+    deflateEnd(_stream.get());
+}
+
+bool DeflatedEntry::append(const void *data, size_t length) {
+    if ( _finished ) {
+        return false;
+    }
+
+    _crc = Crc(_crc, data, length);
+    _uncompressedSize += length;
+
+    _failed = !deflate(data, length, Z_NO_FLUSH);
+    _finished = _failed;
+
+    return !_failed;
+}
+
+bool DeflatedEntry::finish() {
+    if ( _finished ) {
+        return !_failed;
+    }
+
+    _finished = true;
+    _failed = !deflate(nullptr, 0, Z_FINISH);
+
+    return !_failed;
+}
+
+bool DeflatedEntry::deflate(const void *data, size_t length, int flush) {
+    z_stream_s *stream = _stream.get();
+    const Bytef *input = static_cast<const Bytef*>(data);
+
+    do {
+        uInt chunk = static_cast<uInt>(std::min<size_t>(length, 1u << 30));
+        stream->next_in = const_cast<Bytef*>(input);
+        stream->avail_in = chunk;
+        input += chunk;
+        length -= chunk;
+
+        int mode = length == 0 ? flush : Z_NO_FLUSH;
+        int status;
+
+        do {
+            size_t offset = _bytes.size();
+            size_t available = deflateBound(stream, stream->avail_in) + 64;
+            _bytes.resize(offset + available);
+
+            stream->next_out = _bytes.data() + offset;
+            stream->avail_out = static_cast<uInt>(available);
+
+            status = ::deflate(stream, mode);
+            _bytes.resize(offset + available - stream->avail_out);
+
+            if ( status == Z_STREAM_ERROR ) {
+                return false;
+            }
+        } while ( stream->avail_out == 0 || (mode == Z_FINISH && status != Z_STREAM_END) );
+    } while ( length > 0 );
+
+    return true;
+}
+
+// MARK: - Creating
+
+std::unique_ptr<ZipWriter> ZipWriter::Create(const std::string &path, std::string *error) {
+    FILE *file = std::fopen(path.c_str(), "wb");
+
+    if ( file == nullptr ) {
+        SetError(error, ErrnoDescription("Unable to create zip archive at " + path));
+        return nullptr;
+    }
+
+    return std::unique_ptr<ZipWriter>(new ZipWriter(file, path));
+}
+
+ZipWriter::ZipWriter(FILE *file, const std::string &path) : _file(file), _path(path), _offset(0) {
+    // Every entry is stamped with the time the archive was created, in MS-DOS format
+
+    std::time_t now = std::time(nullptr);
+    std::tm local = *std::localtime(&now);
+
+    _time = static_cast<uint16_t>((local.tm_hour << 11) | (local.tm_min << 5) | (local.tm_sec / 2));
+    _date = static_cast<uint16_t>((std::max(local.tm_year - 80, 0) << 9) | ((local.tm_mon + 1) << 5) | local.tm_mday);
+}
+
+ZipWriter::~ZipWriter() {
+    if ( _file != nullptr ) {
+        close(nullptr);
+    }
+}
+
+// MARK: - Writing
+
+bool ZipWriter::add(const std::string &name, const void *data, size_t length, std::string *error) {
+    return addEntry(name, kStored, Crc(0, data, length), data, length, length, error);
+}
+
+bool ZipWriter::add(const std::string &name, DeflatedEntry &entry, std::string *error) {
+    if ( !entry.finish() ) {
+        SetError(error, "Unable to compress zip entry " + name);
+        return false;
+    }
+
+    return addEntry(name, kDeflated, entry.crc(), entry.bytes().data(), entry.bytes().size(), entry.uncompressedSize(), error);
+}
+
+bool ZipWriter::addEntry(const std::string &name, uint16_t method, uint32_t crc, const void *data, uint64_t compressedSize, uint64_t uncompressedSize, std::string *error) {
+    if ( _file == nullptr ) {
+        SetError(error, "Unable to add " + name + ", the zip archive has been closed");
+        return false;
+    }
+
+    if ( compressedSize >= kMax32 || uncompressedSize >= kMax32 || name.size() > kMax16 ) {
+        SetError(error, "Unable to add " + name + ", entries larger than 4GB are not supported");
+        return false;
+    }
+
+    std::vector<uint8_t> header;
+    header.reserve(30 + name.size());
+
+    Put32(header, kLocalHeaderSignature);
+    Put16(header, kVersion);
+    Put16(header, kUTF8Flag);
+    Put16(header, method);
+    Put16(header, _time);
+    Put16(header, _date);
+    Put32(header, crc);
+    Put32(header, static_cast<uint32_t>(compressedSize));
+    Put32(header, static_cast<uint32_t>(uncompressedSize));
+    Put16(header, static_cast<uint16_t>(name.size()));
+    Put16(header, 0);
+    header.insert(header.end(), name.begin(), name.end());
+
+    uint64_t offset = _offset;
+
+    if ( !put(header.data(), header.size(), error) || !put(data, static_cast<size_t>(compressedSize), error) ) {
+        return false;
+    }
+
+    _entries.push_back({name, method, crc, compressedSize, uncompressedSize, offset});
+    return true;
+}
+
+bool ZipWriter::close(std::string *error) {
+    if ( _file == nullptr ) {
+        return true;
+    }
+
+    // Central directory. Only offsets may need zip64 extra fields, entries are smaller than 4GB
+
+    uint64_t directoryOffset = _offset;
+    std::vector<uint8_t> directory;
+    bool zip64 = _entries.size() >= kMax16;
+
+    for ( const Entry &entry : _entries ) {
+        bool largeOffset = entry.offset >= kMax32;
+        zip64 = zip64 || largeOffset;
+
+        Put32(directory, kCentralHeaderSignature);
+        Put16(directory, kMadeByUnix | (largeOffset ? kZip64Version : kVersion));
+        Put16(directory, largeOffset ? kZip64Version : kVersion);
+        Put16(directory, kUTF8Flag);
+        Put16(directory, entry.method);
+        Put16(directory, _time);
+        Put16(directory, _date);
+        Put32(directory, entry.crc);
+        Put32(directory, static_cast<uint32_t>(entry.compressedSize));
+        Put32(directory, static_cast<uint32_t>(entry.uncompressedSize));
+        Put16(directory, static_cast<uint16_t>(entry.name.size()));
+        Put16(directory, largeOffset ? 12 : 0);
+        Put16(directory, 0); // comment
+        Put16(directory, 0); // disk
+        Put16(directory, 0); // internal attributes
+        Put32(directory, 0100644u << 16);
+        Put32(directory, largeOffset ? kMax32 : static_cast<uint32_t>(entry.offset));
+        directory.insert(directory.end(), entry.name.begin(), entry.name.end());
+
+        if ( largeOffset ) {
+            Put16(directory, 0x0001);
+            Put16(directory, 8);
+            Put64(directory, entry.offset);
+        }
+
+        if ( directory.size() >= (1 << 20) ) {
+            if ( !put(directory.data(), directory.size(), error) ) {
+                return false;
+            }
+            directory.clear();
+        }
+    }
+
+    if ( !put(directory.data(), directory.size(), error) ) {
+        return false;
+    }
+
+    uint64_t directorySize = _offset - directoryOffset;
+    zip64 = zip64 || directoryOffset >= kMax32 || directorySize >= kMax32;
+
+    std::vector<uint8_t> end;
+
+    if ( zip64 ) {
+        uint64_t zip64EndOffset = _offset;
+
+        Put32(end, kZip64EndSignature);
+        Put64(end, 44);
+        Put16(end, kMadeByUnix | kZip64Version);
+        Put16(end, kZip64Version);
+        Put32(end, 0);
+        Put32(end, 0);
+        Put64(end, _entries.size());
+        Put64(end, _entries.size());
+        Put64(end, directorySize);
+        Put64(end, directoryOffset);
+
+        Put32(end, kZip64LocatorSignature);
+        Put32(end, 0);
+        Put64(end, zip64EndOffset);
+        Put32(end, 1);
+    }
+
+    Put32(end, kEndSignature);
+    Put16(end, 0);
+    Put16(end, 0);
+    Put16(end, static_cast<uint16_t>(std::min<size_t>(_entries.size(), kMax16)));
+    Put16(end, static_cast<uint16_t>(std::min<size_t>(_entries.size(), kMax16)));
+    Put32(end, static_cast<uint32_t>(std::min<uint64_t>(directorySize, kMax32)));
+    Put32(end, static_cast<uint32_t>(std::min<uint64_t>(directoryOffset, kMax32)));
+    Put16(end, 0);
+
+    bool written = put(end.data(), end.size(), error);
+
+    if ( std::fclose(_file) != 0 && written ) {
+        SetError(error, ErrnoDescription("Unable to close zip archive at " + _path));
+        written = false;
+    }
+
+    _file = nullptr;
+    return written;
+}
+
+bool ZipWriter::put(const void *bytes, size_t length, std::string *error) {
+    if ( length > 0 && std::fwrite(bytes, 1, length, _file) != length ) {
+        SetError(error, ErrnoDescription("Unable to write to zip archive at " + _path));
+        return false;
+    }
+
+    _offset += length;
+    return true;
+}
+
+} // namespace netrunner
@@ -0,0 +1,171 @@
+//
+//  ZipWriter.h
+//  Net Runner
+//
+//  Created by agent on 10/19/26.
+//  Copyright © 2026 doc.ai (http://doc.ai)
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+
+#ifndef ZipWriter_h
+#define ZipWriter_h
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct z_stream_s;
+
+namespace netrunner {
+
+/**
+ * Compresses a zip entry incrementally in memory, so that it may be built up while other entries
+ * are written to the archive and added once it is complete. Only the compressed bytes are kept.
+ */
+
+class DeflatedEntry {
+public:
+    explicit DeflatedEntry(int level = 6);
+    ~DeflatedEntry();
+
+    DeflatedEntry(const DeflatedEntry&) = delete;
+    DeflatedEntry& operator=(const DeflatedEntry&) = delete;
+
+    /**
+     * Compresses and appends bytes to the entry. Returns false if the entry has been finished.
+     */
+
+    bool append(const void *data, size_t length);
+    bool append(const std::string &string) { return append(string.data(), string.size()); }
+
+    /**
+     * Flushes the compressor. Called by `ZipWriter` when the entry is added.
+     */
+
+    bool finish();
+
+    const std::vector<uint8_t> &bytes() const { return _bytes; }
+    uint32_t crc() const { return _crc; }
+    uint64_t uncompressedSize() const { return _uncompressedSize; }
+
+private:
+    bool deflate(const void *data, size_t length, int flush);
+
+    std::unique_ptr<z_stream_s> _stream;
+    std::vector<uint8_t> _bytes;
+    uint32_t _crc;
+    uint64_t _uncompressedSize;
+    bool _finished;
+    bool _failed;
+};
+
+/**
+ * Writes a zip archive front to back, without temporary files or seeking.
+ *
+ * Entries are either stored, for data that is already compressed such as jpeg images, or
+ * deflated from a `DeflatedEntry`. Because an entry's data is complete when it is added, every
+ * local header carries its sizes and checksum. The central directory is written by `close`, and
+ * zip64 records are used once the archive has more than 65,535 entries or grows past 4GB.
+ *
+ * Usage:
+ *
+ * @code
+ * std::string error;
+ * auto writer = ZipWriter::Create(path, &error);
+ * writer->add("image.jpg", jpeg.data(), jpeg.size(), &error);
+ *
+ * DeflatedEntry labels;
+ * labels.append("[]");
+ * writer->add("labels.json", labels, &error);
+ * writer->close(&error);
+ * @endcode
+ */
+
+class ZipWriter {
+public:
+
+    /**
+     * Creates a new archive at path, replacing any existing file. Returns nullptr and sets error
+     * if the file cannot be created.
+     */
+
+    static std::unique_ptr<ZipWriter> Create(const std::string &path, std::string *error);
+
+    /**
+     * Closes the archive if it has not already been closed.
+     */
+
+    ~ZipWriter();
+
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    /**
+     * Adds a stored, uncompressed entry. Entries larger than 4GB are not supported.
+     */
+
+    bool add(const std::string &name, const void *data, size_t length, std::string *error);
+
+    /**
+     * Finishes a deflated entry and adds it.
+     */
+
+    bool add(const std::string &name, DeflatedEntry &entry, std::string *error);
+
+    /**
+     * Writes the central directory and closes the file. No further entries may be added.
+     */
+
+    bool close(std::string *error);
+
+    /**
+     * The number of entries in the archive.
+     */
+
+    size_t count() const { return _entries.size(); }
+
+    /**
+     * The number of bytes written to the archive so far.
+     */
+
+    uint64_t size() const { return _offset; }
+
+private:
+    struct Entry {
+        std::string name;
+        uint16_t method;
+        uint32_t crc;
+        uint64_t compressedSize;
+        uint64_t uncompressedSize;
+        uint64_t offset;
+    };
+
+    ZipWriter(FILE *file, const std::string &path);
+
+    bool addEntry(const std::string &name, uint16_t method, uint32_t crc, const void *data, uint64_t compressedSize, uint64_t uncompressedSize, std::string *error);
+    bool put(const void *bytes, size_t length, std::string *error);
+
+    FILE *_file;
+    std::string _path;
+    uint64_t _offset;
+    uint16_t _time;
+    uint16_t _date;
+    std::vector<Entry> _entries;
+};
+
+} // namespace netrunner
+
+#endif /* ZipWriter_h */